@@ -0,0 +1,364 @@
+
+/**
+ * @file ast.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__ast_h__
+#define __primec__include__primec__ast_h__
+
+#include <primec/token.h>
+#include <primec/lexer.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Index of a node (or of an extra data slot) inside of an ast arena.
+ * 
+ * @note Index 0 is reserved for the null node, so every optional child can be
+ * stored as a plain index.
+ */
+typedef uint32_t primec_ast_index_t;
+#define primec_ast_null ((primec_ast_index_t)0)
+
+typedef enum
+{
+	primec_ast_kind_null,
+
+	// Declarations
+	primec_ast_kind_module,				// lhs..rhs: extra range of declarations
+	primec_ast_kind_func_decl,			// token: name, lhs: extra proto record, rhs: body block (null for ext)
+	primec_ast_kind_param,				// token: name, lhs: type
+	primec_ast_kind_struct_decl,		// token: name, lhs..rhs: extra range of fields
+	primec_ast_kind_field,				// token: name, lhs: type
+	primec_ast_kind_enum_decl,			// token: name, lhs: underlying type (or null), rhs: extra range record of members
+	primec_ast_kind_enum_member,		// token: name, lhs: value expression (or null)
+	primec_ast_kind_use_decl,			// token: use, lhs: first path token, rhs: last path token
+	primec_ast_kind_alias_decl,			// token: name, lhs: type
+	primec_ast_kind_let_decl,			// token: name, lhs: type (or null), rhs: initializer (or null)
+
+	// Types
+	primec_ast_kind_type_name,			// token: primitive keyword or identifier
+	primec_ast_kind_type_mut,			// token: mut, lhs: inner type
+	primec_ast_kind_type_reference,		// token: &, lhs: pointee type, rhs: is mutable
+	primec_ast_kind_type_pointer,		// token: *, lhs: pointee type, rhs: is mutable
+	primec_ast_kind_type_array,			// token: [, lhs: element type, rhs: size expression
+	primec_ast_kind_type_slice,			// token: [, lhs: element type
+	primec_ast_kind_type_func,			// token: func, lhs: extra proto record
+
+	// Statements
+	primec_ast_kind_block,				// token: {, lhs..rhs: extra range of statements
+	primec_ast_kind_unsafe_block,		// token: unsafe, lhs: block
+	primec_ast_kind_expr_stmt,			// token: first token, lhs: expression
+	primec_ast_kind_if,					// token: if or elif, lhs: condition, rhs: extra if record
+	primec_ast_kind_while,				// token: while, lhs: condition, rhs: body block
+	primec_ast_kind_loop,				// token: loop, lhs: body block
+	primec_ast_kind_break,				// token: break
+	primec_ast_kind_continue,			// token: continue
+	primec_ast_kind_return,				// token: return, lhs: value (or null)
+
+	// Expressions
+	primec_ast_kind_int_literal,		// token: literal
+	primec_ast_kind_float_literal,		// token: literal
+	primec_ast_kind_rune_literal,		// token: literal
+	primec_ast_kind_string_literal,		// token: literal
+	primec_ast_kind_identifier,			// token: identifier
+	primec_ast_kind_scope,				// token: right identifier, lhs: left expression
+	primec_ast_kind_unary,				// token: operator, lhs: operand
+	primec_ast_kind_deref,				// token: *, lhs: operand
+	primec_ast_kind_address_of,			// token: &, lhs: operand, rhs: is mutable
+	primec_ast_kind_binary,				// token: operator, lhs: left operand, rhs: right operand
+	primec_ast_kind_assign,				// token: operator, lhs: target, rhs: value
+	primec_ast_kind_cast,				// token: as, lhs: operand, rhs: type
+	primec_ast_kind_call,				// token: (, lhs: callee, rhs: extra range record of arguments
+	primec_ast_kind_index,				// token: [, lhs: base, rhs: index
+	primec_ast_kind_slice,				// token: :, lhs: base, rhs: extra slice record
+	primec_ast_kind_member,				// token: field name, lhs: base
+	primec_ast_kind_lambda,				// token: func, lhs: extra proto record, rhs: body block
+
+	primec_ast_kinds_count
+} primec_ast_kind_e;
+
+/**
+ * @brief Stringify ast node kind.
+ */
+const char* primec_ast_kind_to_string(
+	const primec_ast_kind_e kind);
+
+/**
+ * @brief Flags of the function prototype record.
+ */
+typedef enum
+{
+	primec_ast_proto_flag_inl = 1 << 0,
+	primec_ast_proto_flag_ext = 1 << 1,
+	primec_ast_proto_flag_variadic = 1 << 2
+} primec_ast_proto_flag_e;
+
+/**
+ * @brief Ast node.
+ * 
+ * @note Every node is 16 bytes wide: the kind, the index of its main token and
+ * two children slots. The meaning of the slots depends on the kind (see the
+ * comments of the @ref primec_ast_kind_e enum). Nodes with more children keep
+ * them in the extra data array of the ast.
+ */
+typedef struct
+{
+	primec_ast_kind_e kind;
+	uint32_t token;
+	primec_ast_index_t lhs;
+	primec_ast_index_t rhs;
+} primec_ast_node_s;
+
+_Static_assert(sizeof(primec_ast_node_s) == 16, "primec_ast_node_s must stay 16 bytes wide!");
+
+/**
+ * @brief Contiguous range of node indices stored in the extra data array.
+ */
+typedef struct
+{
+	primec_ast_index_t start;
+	primec_ast_index_t end;
+} primec_ast_range_s;
+
+/**
+ * @brief Function prototype record (used by func declarations, func types and
+ * lambdas) stored in the extra data array.
+ */
+typedef struct
+{
+	primec_ast_range_s params;
+	primec_ast_index_t return_type;
+	uint32_t flags;
+} primec_ast_proto_s;
+
+/**
+ * @brief If statement record stored in the extra data array.
+ * 
+ * @note The else branch is either null, a block or another if node (elif).
+ */
+typedef struct
+{
+	primec_ast_index_t then_block;
+	primec_ast_index_t else_branch;
+} primec_ast_if_s;
+
+/**
+ * @brief Slice expression record stored in the extra data array.
+ */
+typedef struct
+{
+	primec_ast_index_t start;
+	primec_ast_index_t end;
+} primec_ast_slice_s;
+
+/**
+ * @brief Abstract syntax tree of a single source file.
+ * 
+ * @note The ast owns the tokens of the file, every node and every extra data
+ * slot in three flat arrays, and the values and texts of all tokens in the side
+ * table. Thus, it is freed in constant time, regardless of its size.
+ */
+typedef struct
+{
+	uint32_t file;
+
+	struct
+	{
+		primec_token_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} tokens;
+
+	struct
+	{
+		primec_ast_node_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} nodes;
+
+	struct
+	{
+		primec_ast_index_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} extra;
+
+	primec_token_literals_s literals;
+	primec_ast_index_t root;
+	bool is_part;
+} primec_ast_s;
+
+/**
+ * @brief Create an ast and fill its token array by lexing the whole file.
+ * 
+ * @note Comment tokens are dropped, and the last token is always eof. The side
+ * table of the token values is moved from the lexer to the ast.
+ */
+primec_ast_s primec_ast_from_lexer(
+	primec_lexer_s* const lexer);
+
+/**
+ * @brief Create an empty part of provided ast.
+ * 
+ * @note The part shares the tokens and their side table of the ast (read-only),
+ * but owns its nodes
+ * and extra data arrays, so several parts of the same ast can be filled by
+ * different threads and merged back later (see @ref primec_ast_merge_part()).
+ */
+primec_ast_s primec_ast_part_from_ast(
+	const primec_ast_s* const ast);
+
+/**
+ * @brief Destroy the ast and free all its resources.
+ * 
+ * @note Parts only free their own nodes and extra data.
+ */
+void primec_ast_destroy(
+	primec_ast_s* const ast);
+
+/**
+ * @brief Make sure the ast has room for provided numbers of additional nodes
+ * and extra data slots.
+ */
+void primec_ast_reserve(
+	primec_ast_s* const ast,
+	const uint32_t nodes_count,
+	const uint32_t extra_count);
+
+/**
+ * @brief Copy the nodes and extra data of the part into the ast, starting at
+ * provided node and extra data indices, and relocate all their references.
+ * 
+ * @note The node 0 of the part (null) is not copied, so the part occupies its
+ * nodes count minus one nodes. The destination ranges must be reserved and
+ * counted beforehand: merging parts into disjoint ranges is safe to perform
+ * from different threads simultaneously.
+ */
+void primec_ast_merge_part(
+	primec_ast_s* const ast,
+	const primec_ast_s* const part,
+	const primec_ast_index_t nodes_base,
+	const primec_ast_index_t extra_base);
+
+/**
+ * @brief Relocate a node index of the part to the index it has in the ast
+ * after being merged at provided nodes base.
+ */
+primec_ast_index_t primec_ast_relocate_node(
+	const primec_ast_index_t index,
+	const primec_ast_index_t nodes_base);
+
+/**
+ * @brief Append a node to the ast and return its index.
+ */
+primec_ast_index_t primec_ast_push_node(
+	primec_ast_s* const ast,
+	const primec_ast_kind_e kind,
+	const uint32_t token,
+	const primec_ast_index_t lhs,
+	const primec_ast_index_t rhs);
+
+/**
+ * @brief Append the values to the extra data array and return the index of the
+ * first one.
+ */
+primec_ast_index_t primec_ast_push_extra(
+	primec_ast_s* const ast,
+	const primec_ast_index_t* const values,
+	const uint32_t count);
+
+/**
+ * @brief Get node by its index.
+ */
+const primec_ast_node_s* primec_ast_get_node(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index);
+
+/**
+ * @brief Get token by its index.
+ */
+const primec_token_s* primec_ast_get_token(
+	const primec_ast_s* const ast,
+	const uint32_t index);
+
+/**
+ * @brief Get the value of a literal token by its index.
+ */
+const primec_token_value_s* primec_ast_get_token_value(
+	const primec_ast_s* const ast,
+	const uint32_t index);
+
+/**
+ * @brief Get the null terminated text of an identifier, string literal or
+ * invalid token by its index.
+ */
+const char* primec_ast_get_token_text(
+	const primec_ast_s* const ast,
+	const uint32_t index);
+
+/**
+ * @brief Get main token of a node.
+ */
+const primec_token_s* primec_ast_get_node_token(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index);
+
+/**
+ * @brief Get range record stored at provided extra data index.
+ */
+primec_ast_range_s primec_ast_get_range(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra);
+
+/**
+ * @brief Get function prototype record stored at provided extra data index.
+ */
+primec_ast_proto_s primec_ast_get_proto(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra);
+
+/**
+ * @brief Get if record stored at provided extra data index.
+ */
+primec_ast_if_s primec_ast_get_if(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra);
+
+/**
+ * @brief Get slice record stored at provided extra data index.
+ */
+primec_ast_slice_s primec_ast_get_slice(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra);
+
+/**
+ * @brief Get the children list of the node: module declarations, struct fields
+ * and block statements are stored directly as a range in lhs and rhs.
+ */
+primec_ast_range_s primec_ast_get_list(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index);
+
+/**
+ * @brief Get the node index stored at provided extra data index.
+ */
+primec_ast_index_t primec_ast_get_extra(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra);
+
+/**
+ * @brief Log the ast in a human readable tree form.
+ */
+void primec_ast_dump(
+	const primec_ast_s* const ast);
+
+#endif
@@ -0,0 +1,40 @@
+
+/**
+ * @file bounds.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__bounds_h__
+#define __primec__include__primec__bounds_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Remove the bounds checks, that cannot fail, from every function.
+ * 
+ * @note Checks of the unsafe blocks are removed unconditionally. The other
+ * ones are removed, if the ranges of their indices and lengths prove them
+ * (the constants, the induction variables of the loops, the conditions of the
+ * dominating branches and the dominating checks are taken into account).
+ * Slots should be promoted first, so the induction variables are values.
+ */
+void primec_bounds_run(
+	primec_ir_program_s* const program);
+
+/**
+ * @brief Remove only the bounds checks of the unsafe blocks from every
+ * function.
+ * 
+ * @note The unsafe blocks are unchecked by their definition, so their checks
+ * are removed even when nothing is optimized.
+ */
+void primec_bounds_remove_unsafe(
+	primec_ir_program_s* const program);
+
+#endif
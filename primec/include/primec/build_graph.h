@@ -0,0 +1,164 @@
+
+/**
+ * @file build_graph.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__build_graph_h__
+#define __primec__include__primec__build_graph_h__
+
+#include <primec/location.h>
+#include <primec/ast.h>
+#include <primec/thread_pool.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pthread.h>
+
+/**
+ * @brief Edge of the build graph - module imported by a `use` declaration.
+ * 
+ * @note The token is the index of the `use` keyword in the importing module.
+ */
+typedef struct
+{
+	uint32_t module;
+	uint32_t token;
+	primec_location_s location;
+} primec_module_import_s;
+
+typedef struct
+{
+	uint32_t file;
+	const char* path;
+	uint32_t index;
+	primec_ast_s ast;
+
+	struct
+	{
+		primec_module_import_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} imports;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} importers;
+
+	uint32_t pending;
+	struct primec_build_graph_s* graph;
+} primec_module_s;
+
+typedef void(*primec_build_graph_stage_f)(
+	primec_module_s* const module,
+	void* const context);
+
+typedef struct primec_build_graph_s
+{
+	pthread_mutex_t mutex;
+	primec_thread_pool_s* pool;
+	primec_thread_pool_group_s group;
+
+	struct
+	{
+		primec_module_s** data;
+		uint32_t capacity;
+		uint32_t count;
+	} modules;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t count;
+	} order;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+	} modules_by_file;
+
+	// NOTE: Index of the runtime module, imported by every other module, or
+	//       UINT32_MAX if the graph has no runtime.
+	uint32_t runtime;
+
+	primec_build_graph_stage_f stage;
+	void* context;
+} primec_build_graph_s;
+
+/**
+ * @brief Create an empty build graph, that schedules its work on provided pool.
+ * 
+ * @note The graph is returned by pointer, as its tasks refer to it, so it cannot
+ * be moved.
+ */
+primec_build_graph_s* primec_build_graph_create(
+	primec_thread_pool_s* const pool);
+
+/**
+ * @brief Destroy the build graph together with all its modules and their asts.
+ */
+void primec_build_graph_destroy(
+	primec_build_graph_s* const graph);
+
+/**
+ * @brief Add a root module (a file provided on the command line) to the graph.
+ * 
+ * @note If the file cannot be read, the error is logged and false is returned.
+ * The same file passed several times (or through different paths) is added
+ * only once.
+ */
+bool primec_build_graph_add_root(
+	primec_build_graph_s* const graph,
+	const char* const path);
+
+/**
+ * @brief Add the runtime module with provided text to the graph.
+ * 
+ * @note The runtime is imported by every other module without a `use`
+ * declaration, so it is checked before all of them, and its declarations are
+ * visible in all of them (unless they are shadowed). It must be added before
+ * the graph is loaded.
+ */
+void primec_build_graph_add_runtime(
+	primec_build_graph_s* const graph,
+	const char* const path,
+	const char* const text,
+	const uint32_t length);
+
+/**
+ * @brief Load all the modules reachable from the roots.
+ * 
+ * @note Every module is lexed, scanned for `use` declarations and parsed as a
+ * separate task, and the task of an imported module is submitted as soon as the
+ * `use` declaration is scanned, so reading of one module overlaps with parsing
+ * of the others. Once all modules are loaded, the graph is checked for import
+ * cycles (which are fatal errors) and the modules are put in topological order,
+ * so every module comes after all the modules it imports.
+ */
+void primec_build_graph_load(
+	primec_build_graph_s* const graph);
+
+/**
+ * @brief Run a stage for every module of the loaded graph.
+ * 
+ * @note The stage of a module is started as soon as the stages of all modules
+ * it imports are finished, thus independent modules are processed concurrently
+ * and the whole stage takes the time of the longest import chain.
+ */
+void primec_build_graph_schedule(
+	primec_build_graph_s* const graph,
+	const primec_build_graph_stage_f stage,
+	void* const context);
+
+#endif
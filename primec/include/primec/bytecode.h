@@ -0,0 +1,206 @@
+
+/**
+ * @file bytecode.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__bytecode_h__
+#define __primec__include__primec__bytecode_h__
+
+#include <primec/ir.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Operation of a bytecode instruction.
+ * 
+ * @note Instructions read and write the registers of their frames, with the
+ * destination in a. Integers are kept in the registers sign or zero extended
+ * to 64 bits (as their types are signed or not), so the integer results are
+ * normalized by the shift and the signedness of their instructions. Floats of
+ * 32 bits are kept in the low bits of their registers.
+ */
+typedef enum
+{
+	primec_bytecode_op_const,		// a = b | c << 32
+	primec_bytecode_op_move,		// a = b
+	primec_bytecode_op_frame,		// a = frame memory + b
+	primec_bytecode_op_addi,		// a = b + c
+	primec_bytecode_op_muli,		// a = b * c
+
+	primec_bytecode_op_load8,		// a = *b (extended by the signedness)
+	primec_bytecode_op_load16,
+	primec_bytecode_op_load32,
+	primec_bytecode_op_load64,
+	primec_bytecode_op_store8,		// *a = b
+	primec_bytecode_op_store16,
+	primec_bytecode_op_store32,
+	primec_bytecode_op_store64,
+	primec_bytecode_op_copy,		// copy c bytes from b to a
+	primec_bytecode_op_zero,		// clear c bytes at a
+
+	primec_bytecode_op_add,			// a = b op c (normalized)
+	primec_bytecode_op_sub,
+	primec_bytecode_op_mul,
+	primec_bytecode_op_sdiv,
+	primec_bytecode_op_udiv,
+	primec_bytecode_op_srem,
+	primec_bytecode_op_urem,
+	primec_bytecode_op_and,
+	primec_bytecode_op_or,
+	primec_bytecode_op_xor,
+	primec_bytecode_op_shl,
+	primec_bytecode_op_sshr,
+	primec_bytecode_op_ushr,
+	primec_bytecode_op_neg,			// a = op b (normalized)
+	primec_bytecode_op_not,
+	primec_bytecode_op_extend,		// a = b (normalized)
+
+	primec_bytecode_op_eq,			// a = b op c (0 or 1)
+	primec_bytecode_op_ne,
+	primec_bytecode_op_slt,
+	primec_bytecode_op_sle,
+	primec_bytecode_op_ult,
+	primec_bytecode_op_ule,
+
+	primec_bytecode_op_fadd32,		// a = b op c
+	primec_bytecode_op_fsub32,
+	primec_bytecode_op_fmul32,
+	primec_bytecode_op_fdiv32,
+	primec_bytecode_op_fneg32,
+	primec_bytecode_op_feq32,
+	primec_bytecode_op_fne32,
+	primec_bytecode_op_flt32,
+	primec_bytecode_op_fle32,
+	primec_bytecode_op_fadd64,
+	primec_bytecode_op_fsub64,
+	primec_bytecode_op_fmul64,
+	primec_bytecode_op_fdiv64,
+	primec_bytecode_op_fneg64,
+	primec_bytecode_op_feq64,
+	primec_bytecode_op_fne64,
+	primec_bytecode_op_flt64,
+	primec_bytecode_op_fle64,
+
+	primec_bytecode_op_s2f32,		// a = (to) b
+	primec_bytecode_op_u2f32,
+	primec_bytecode_op_s2f64,
+	primec_bytecode_op_u2f64,
+	primec_bytecode_op_f32s,		// a = (to) b (normalized)
+	primec_bytecode_op_f32u,
+	primec_bytecode_op_f64s,
+	primec_bytecode_op_f64u,
+	primec_bytecode_op_f32f64,
+	primec_bytecode_op_f64f32,
+
+	primec_bytecode_op_call,		// a = call of function b with the list c
+	primec_bytecode_op_call_indirect, // a = call of the address in b with the list c
+	primec_bytecode_op_tail_call,	// call, that reuses the frame of the caller, if the callee is not external
+	primec_bytecode_op_tail_call_indirect,
+	primec_bytecode_op_jump,		// jump to b
+	primec_bytecode_op_branch,		// jump to b if a, or to c
+	primec_bytecode_op_check,		// trap unless a < b (unsigned)
+	primec_bytecode_op_ret,			// return a
+	primec_bytecode_op_trap,
+	primec_bytecode_ops_count
+} primec_bytecode_op_e;
+
+typedef struct
+{
+	uint16_t op;
+	uint8_t shift;		// 64 minus the bits of the integer result
+	uint8_t is_signed;
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+} primec_bytecode_instruction_s;
+
+_Static_assert(sizeof(primec_bytecode_instruction_s) == 16, "primec_bytecode_instruction_s must stay 16 bytes");
+
+/**
+ * @brief Class of an argument, kept in the top bits of its register in the
+ * argument lists, so the external functions get their floats in the vector
+ * registers.
+ */
+typedef enum
+{
+	primec_bytecode_class_int,
+	primec_bytecode_class_f64,
+	primec_bytecode_class_f32,
+} primec_bytecode_class_e;
+
+#define primec_bytecode_class_shift 30
+#define primec_bytecode_register_mask ((UINT32_C(1) << primec_bytecode_class_shift) - 1)
+
+/**
+ * @brief Compiled function.
+ * 
+ * @note Every value of the ir function has its own register (the register 0
+ * is a scratch register for the unused results), followed by the temporaries
+ * of the parallel moves. Argument lists are the counts of the arguments,
+ * followed by their registers.
+ */
+typedef struct
+{
+	const char* name;
+	void* native;				// address of an external function, or NULL
+	uint32_t return_class;
+	uint32_t registers_count;
+	uint32_t frame_size;		// bytes of the frame memory, for the slots
+	uint32_t params_count;
+	uint32_t* params;			// registers of the parameters, by their abi indices
+
+	struct
+	{
+		primec_bytecode_instruction_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} code;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} lists;
+} primec_bytecode_func_s;
+
+/**
+ * @brief Compiled program, with the memory of its globals and strings.
+ */
+typedef struct
+{
+	const primec_ir_program_s* program;
+	primec_bytecode_func_s* funcs;
+	uint32_t funcs_count;
+	uint8_t* globals;
+	char* strings;
+} primec_bytecode_module_s;
+
+/**
+ * @brief Compile the program to the bytecode.
+ * 
+ * @note External functions are looked up in the current process, and their
+ * addresses are used as their values. The values of the other functions are
+ * the addresses of their compiled functions, so they can only be called by the
+ * bytecode.
+ * 
+ * @return Compiled module, or NULL if an external function was not found.
+ */
+primec_bytecode_module_s* primec_bytecode_compile(
+	const primec_ir_program_s* const program);
+
+/**
+ * @brief Destroy the compiled module.
+ */
+void primec_bytecode_destroy(
+	primec_bytecode_module_s* const module);
+
+#endif
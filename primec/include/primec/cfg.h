@@ -0,0 +1,78 @@
+
+/**
+ * @file cfg.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__cfg_h__
+#define __primec__include__primec__cfg_h__
+
+#include <primec/ir.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define primec_cfg_unreachable UINT32_MAX
+
+/**
+ * @brief Control flow graph of a function with its dominator tree.
+ * 
+ * @note Lists are kept in flat arrays, where the elements of the block b are
+ * the ones from starts[b] up to starts[b + 1]. Predecessors are listed once,
+ * even if both edges of a branch lead to the same block. Blocks, that cannot
+ * be reached from the entry, have no positions, no dominators, and are left
+ * out of the order.
+ */
+typedef struct
+{
+	uint32_t blocks_count;
+	primec_ir_block_t* order;		// reachable blocks in the reverse post order
+	uint32_t order_count;
+	uint32_t* positions;			// positions of the blocks in the order
+	primec_ir_block_t* idoms;		// immediate dominators (the entry is its own)
+
+	uint32_t* predecessors_starts;
+	primec_ir_block_t* predecessors;
+	uint32_t* children_starts;		// children of the blocks in the dominator tree
+	primec_ir_block_t* children;
+
+	uint32_t* preorder;				// preorder numbers and sizes of the subtrees of the dominator tree
+	uint32_t* sizes;
+} primec_cfg_s;
+
+/**
+ * @brief Build the control flow graph of the function.
+ */
+void primec_cfg_build(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func);
+
+/**
+ * @brief Destroy the control flow graph.
+ */
+void primec_cfg_destroy(
+	primec_cfg_s* const cfg);
+
+/**
+ * @brief Check if the block can be reached from the entry.
+ */
+bool primec_cfg_is_reachable(
+	const primec_cfg_s* const cfg,
+	const primec_ir_block_t block);
+
+/**
+ * @brief Check if the dominator block dominates the block (every block
+ * dominates itself).
+ */
+bool primec_cfg_dominates(
+	const primec_cfg_s* const cfg,
+	const primec_ir_block_t dominator,
+	const primec_ir_block_t block);
+
+#endif
@@ -0,0 +1,125 @@
+
+/**
+ * @file const_eval.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__const_eval_h__
+#define __primec__include__primec__const_eval_h__
+
+#include <primec/token.h>
+#include <primec/type_table.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Value of a compile-time constant.
+ * 
+ * @note Signed integers are kept in the ival, sign extended, unsigned integers,
+ * characters, booleans and enums in the uval, zero extended, and floats in the
+ * fval (values of f32 are rounded to f32 precision). Untyped integers are kept
+ * as i64, and untyped floats as f64.
+ */
+typedef struct
+{
+	union
+	{
+		int64_t ival;
+		uint64_t uval;
+		double fval;
+	};
+} primec_const_value_s;
+
+_Static_assert(sizeof(primec_const_value_s) == 8, "primec_const_value_s must stay 8 bytes");
+
+typedef enum
+{
+	primec_const_status_ok,
+	primec_const_status_overflow,
+	primec_const_status_division_by_zero,
+	primec_const_status_invalid_shift,
+	primec_const_statuses_count
+} primec_const_status_e;
+
+/**
+ * @brief Convert provided const status to a human readable string.
+ */
+const char* primec_const_status_to_string(
+	const primec_const_status_e status);
+
+/**
+ * @brief Get the value of a numeric or rune literal token, as the constant of
+ * provided type.
+ * 
+ * @note Literals are not checked against the range of their suffix type by the
+ * lexer, so out of range literals are reported here as overflows.
+ */
+primec_const_status_e primec_const_from_literal(
+	const primec_token_s* const token,
+	const primec_token_value_s* const value,
+	const primec_type_t type,
+	primec_const_value_s* const result);
+
+/**
+ * @brief Convert the constant of one scalar type to another one.
+ * 
+ * @note Implicit conversions (of untyped constants to the type of their context)
+ * must preserve the value, while explicit casts truncate integers as the target
+ * machine would do. Floats, that are out of range of the integer type, are
+ * overflows in both cases.
+ */
+primec_const_status_e primec_const_convert(
+	const primec_type_table_s* const table,
+	const primec_type_t from,
+	const primec_type_t to,
+	const primec_const_value_s value,
+	const bool is_explicit,
+	primec_const_value_s* const result);
+
+/**
+ * @brief Fold the unary operator applied to the constant of provided type.
+ * 
+ * @note The result of `!` is a boolean, other operators keep the type.
+ */
+primec_const_status_e primec_const_fold_unary(
+	const primec_type_table_s* const table,
+	const primec_token_type_e operator,
+	const primec_type_t type,
+	const primec_const_value_s value,
+	primec_const_value_s* const result);
+
+/**
+ * @brief Fold the binary operator applied to the constants of provided types.
+ * 
+ * @note The operands of all operators but the shifts and the logical ones have
+ * the same type. The results of comparisons and logical operators are booleans,
+ * the results of other operators have the type of the left operand.
+ */
+primec_const_status_e primec_const_fold_binary(
+	const primec_type_table_s* const table,
+	const primec_token_type_e operator,
+	const primec_type_t left_type,
+	const primec_const_value_s left,
+	const primec_type_t right_type,
+	const primec_const_value_s right,
+	primec_const_value_s* const result);
+
+/**
+ * @brief Format the constant of provided type into provided buffer, which is
+ * also returned.
+ */
+const char* primec_const_format(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	const primec_const_value_s value,
+	char* const buffer,
+	const uint64_t capacity);
+
+#endif
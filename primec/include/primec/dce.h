@@ -0,0 +1,30 @@
+
+/**
+ * @file dce.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__dce_h__
+#define __primec__include__primec__dce_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Remove the instructions, whose values are never used, from every
+ * function.
+ * 
+ * @note Instructions with effects (stores, calls, checks, trapping divisions
+ * and terminators) and the parameters are live, and so are the operands of
+ * the live instructions. The other instructions, including the cycles of the
+ * phis, that only feed each other, are removed.
+ */
+void primec_dce_run(
+	primec_ir_program_s* const program);
+
+#endif
@@ -0,0 +1,64 @@
+
+/**
+ * @file diagnostics.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__diagnostics_h__
+#define __primec__include__primec__diagnostics_h__
+
+#include <primec/location.h>
+
+#include <stdint.h>
+
+typedef struct
+{
+	primec_location_s location;
+	char* message;
+} primec_diagnostic_s;
+
+/**
+ * @brief List of the errors reported by a single task.
+ * 
+ * @note Every task of a parallel pass reports into its own list, so reporting
+ * needs no locking, and the lists are flushed in the order of the tasks once
+ * the pass is done, so the output does not depend on the scheduling.
+ */
+typedef struct
+{
+	primec_diagnostic_s* data;
+	uint32_t capacity;
+	uint32_t count;
+} primec_diagnostics_s;
+
+/**
+ * @brief Report an error at provided location.
+ */
+void primec_diagnostics_report(
+	primec_diagnostics_s* const diagnostics,
+	const primec_location_s location,
+	const char* const format,
+	...) __attribute__ ((format (printf, 3, 4)));
+
+/**
+ * @brief Log all the reported errors in the order of reporting, and clear the
+ * list.
+ * 
+ * @return Number of the logged errors.
+ */
+uint32_t primec_diagnostics_flush(
+	primec_diagnostics_s* const diagnostics);
+
+/**
+ * @brief Destroy the list and free all its messages.
+ */
+void primec_diagnostics_destroy(
+	primec_diagnostics_s* const diagnostics);
+
+#endif
@@ -0,0 +1,53 @@
+
+/**
+ * @file elf.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__elf_h__
+#define __primec__include__primec__elf_h__
+
+#include <primec/x86_64.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Write the encoded module as a relocatable ELF64 object.
+ * 
+ * @note If the entry is not UINT32_MAX, the object defines the _start symbol,
+ * which calls the entry function and exits the process with its result, by the
+ * exit function of the C library if the module calls the external functions
+ * (see @ref primec_x86_64_calls_externs()). Functions and globals are global symbols (the lambdas are
+ * local), and the external functions are left undefined.
+ * 
+ * @return True if the object was written.
+ */
+bool primec_elf_write_object(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const path);
+
+/**
+ * @brief Write the encoded module as an ELF64 executable.
+ * 
+ * @note The _start symbol calls the entry function and exits the process with
+ * its result by the system call. All references are resolved in place, except
+ * the calls of the external functions, whose modules are written as dynamic
+ * executables, that import them (and the exit function, which the _start calls
+ * instead) from the C library through the global offset table.
+ * 
+ * @return True if the executable was written.
+ */
+bool primec_elf_write_executable(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const path);
+
+#endif
@@ -0,0 +1,30 @@
+
+/**
+ * @file gvn.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__gvn_h__
+#define __primec__include__primec__gvn_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Replace the redundant computations of every function by the equal
+ * values, that dominate them.
+ * 
+ * @note The dominator tree is walked with a table of the available pure
+ * instructions (and divisions), keyed by their ops, types and operands, so the
+ * vector and the scalar computations never meet. The operands of commutative
+ * ops are matched in both orders.
+ */
+void primec_gvn_run(
+	primec_ir_program_s* const program);
+
+#endif
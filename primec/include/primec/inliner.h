@@ -0,0 +1,40 @@
+
+/**
+ * @file inliner.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__inliner_h__
+#define __primec__include__primec__inliner_h__
+
+#include <primec/ir.h>
+#include <primec/build_graph.h>
+
+/**
+ * @brief Inline the direct calls of the program.
+ * 
+ * @note Functions are processed bottom-up over the call graph, so the callees
+ * are inlined into before their callers. Calls of the `inl` functions are
+ * always inlined, and if the small functions are inlined too, the calls of
+ * the other functions are inlined when their callees are small and not
+ * recursive, while the callers stay under the size budget. Recursive `inl` functions are reported as errors, and the process
+ * exits after they are logged, as with the semantic analysis.
+ * 
+ * @note Indirect calls of the known functions (the named functions and the
+ * hoisted lambdas, whose addresses reach the calls after the inlining) become
+ * direct calls, that are inlined like the other ones. Taken addresses count as
+ * calls in the call graph, so the functions passed as callbacks are processed
+ * before the callees, that call them.
+ */
+void primec_inliner_run(
+	primec_ir_program_s* const program,
+	const primec_build_graph_s* const graph,
+	const bool is_inlining_small);
+
+#endif
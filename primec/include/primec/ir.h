@@ -0,0 +1,469 @@
+
+/**
+ * @file ir.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__ir_h__
+#define __primec__include__primec__ir_h__
+
+#include <primec/ast.h>
+#include <primec/const_eval.h>
+#include <primec/type_table.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pthread.h>
+
+/**
+ * @brief Index of an instruction (and of the value it defines) in its function.
+ * 
+ * @note The index 0 is reserved for the null value.
+ */
+typedef uint32_t primec_ir_value_t;
+
+/**
+ * @brief Index of a basic block in its function.
+ */
+typedef uint32_t primec_ir_block_t;
+
+#define primec_ir_null ((primec_ir_value_t)0)
+
+/**
+ * @brief Operation of an instruction.
+ * 
+ * @note The comments list the meaning of the operands a and b. Aggregates
+ * (structs, arrays, slices and references to slices) are never values, they
+ * are kept in memory and passed around by their addresses, so the value
+ * instructions operate on scalars only (and on the vectors, that only the
+ * vectorizer makes). The signedness of arithmetic, division,
+ * shifts and comparisons follows the type of the operands.
+ */
+typedef enum
+{
+	primec_ir_op_nop,
+
+	// Values
+	primec_ir_op_const,		// a..b: low and high 32 bits of the value (see primec_ir_get_const())
+	primec_ir_op_param,		// a: abi index of the parameter (the hidden result pointer comes first)
+	primec_ir_op_slot,		// frame memory for the element of the (pointer) type, result: its address
+	primec_ir_op_global,	// a: global index, result: its address
+	primec_ir_op_func,		// a: function index, result: its address
+	primec_ir_op_string,	// a: string index, result: address of its characters
+
+	// Memory
+	primec_ir_op_load,		// a: address
+	primec_ir_op_store,		// a: address, b: value
+	primec_ir_op_copy,		// a: destination, b: source, type: aggregate type to copy
+	primec_ir_op_zero,		// a: destination, type: aggregate type to clear
+	primec_ir_op_field,		// a: struct address, b: field index, result: field address
+	primec_ir_op_element,	// a: base address, b: index value, result: element address
+	primec_ir_op_offset,	// a: address, b: constant byte offset, result: address
+
+	// Arithmetic
+	primec_ir_op_add,
+	primec_ir_op_sub,
+	primec_ir_op_mul,
+	primec_ir_op_div,
+	primec_ir_op_rem,
+	primec_ir_op_neg,		// a: operand
+	primec_ir_op_and,
+	primec_ir_op_or,
+	primec_ir_op_xor,
+	primec_ir_op_not,		// a: operand (bitwise complement)
+	primec_ir_op_shl,
+	primec_ir_op_shr,
+
+	// Comparisons (result: bool)
+	primec_ir_op_eq,
+	primec_ir_op_ne,
+	primec_ir_op_lt,
+	primec_ir_op_le,
+	primec_ir_op_gt,
+	primec_ir_op_ge,
+
+	// Conversions
+	primec_ir_op_convert,	// a: operand, type: target scalar type (traps unless the float fits the integer)
+
+	// Vectors (made by the vectorizer, whose vector types are values too)
+	primec_ir_op_splat,		// a: scalar operand, type: vector type, result: the operand in every lane
+	primec_ir_op_reduce,	// a: vector operand, b: op (add, and, or or xor), type: lane type, result: the lanes combined by the op
+
+	// Calls
+	primec_ir_op_call,		// a: function index, b: extra list of arguments
+	primec_ir_op_call_indirect, // a: callee value, b: extra list of arguments
+	primec_ir_op_phi,		// a: extra list of incoming (block, value) pairs
+	primec_ir_op_check,		// a: index, b: length (traps unless index < length, unsigned)
+
+	// Terminators
+	primec_ir_op_jump,		// a: target block
+	primec_ir_op_branch,	// a: condition, b: extra list of the (then, else) blocks
+	primec_ir_op_ret,		// a: value (or null)
+	primec_ir_op_unreachable,
+	primec_ir_ops_count
+} primec_ir_op_e;
+
+/**
+ * @brief Convert provided ir op to a human readable string.
+ */
+const char* primec_ir_op_to_string(
+	const primec_ir_op_e op);
+
+/**
+ * @brief Instruction of a function.
+ * 
+ * @note The type is the type of the defined value, or the type, that the value
+ * free instruction (store, copy, zero) operates on. Lists of operands (calls,
+ * phis and branches) are kept in the extra array of the function, prefixed by
+ * their length.
+ */
+typedef struct
+{
+	uint8_t op;
+	uint8_t flags;
+	uint16_t reserved;
+	primec_type_t type;
+	uint32_t a;
+	uint32_t b;
+} primec_ir_instruction_s;
+
+_Static_assert(sizeof(primec_ir_instruction_s) == 16, "primec_ir_instruction_s must stay 16 bytes");
+
+typedef enum
+{
+	primec_ir_instruction_flag_unsafe = 1 << 0, // lowered from an unsafe block
+	primec_ir_instruction_flag_tail = 1 << 1, // call, whose result is returned right after it
+} primec_ir_instruction_flag_e;
+
+/**
+ * @brief Basic block - a list of instructions, ending with a terminator.
+ */
+typedef struct
+{
+	struct
+	{
+		primec_ir_value_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} instructions;
+} primec_ir_block_s;
+
+typedef enum
+{
+	primec_ir_func_flag_extern = 1 << 0,	// declared by an `ext` function, without a body
+	primec_ir_func_flag_inline = 1 << 1,	// declared by an `inl` function
+	primec_ir_func_flag_lambda = 1 << 2,	// hoisted lambda
+	primec_ir_func_flag_sret = 1 << 3,		// returns an aggregate through the hidden pointer
+} primec_ir_func_flag_e;
+
+typedef struct
+{
+	const char* name;
+	primec_type_t type;
+	uint32_t module;
+	primec_ast_index_t node;
+	uint32_t flags;
+
+	struct
+	{
+		primec_ir_instruction_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} instructions;
+
+	struct
+	{
+		primec_ir_block_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} blocks;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} extra;
+} primec_ir_func_s;
+
+typedef enum
+{
+	primec_ir_global_init_zero,
+	primec_ir_global_init_const,	// value: the constant
+	primec_ir_global_init_string,	// string: index of the string, the global is a slice of (or a pointer to) its characters
+} primec_ir_global_init_e;
+
+typedef struct
+{
+	const char* name;
+	primec_type_t type;
+	uint32_t module;
+	primec_ast_index_t node;
+	uint32_t init;
+	uint32_t string;
+	primec_const_value_s value;
+} primec_ir_global_s;
+
+typedef struct
+{
+	const char* data;
+	uint64_t length;
+	uint32_t hash;
+} primec_ir_string_s;
+
+/**
+ * @brief Program - all functions, globals and strings of the build.
+ * 
+ * @note Functions are allocated separately, so they are never moved, and can
+ * be built by several threads at once, while adding of new functions and
+ * strings is serialized by the mutex.
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+	primec_type_table_s* types;
+
+	struct
+	{
+		primec_ir_func_s** data;
+		uint32_t capacity;
+		uint32_t count;
+	} funcs;
+
+	struct
+	{
+		primec_ir_global_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} globals;
+
+	struct
+	{
+		primec_ir_string_s* data;
+		uint32_t capacity;
+		uint32_t count;
+
+		// NOTE: Open addressing table of the strings by their contents, holding
+		//       the index of the string plus one, or 0 for an empty bucket.
+		uint32_t* buckets;
+		uint32_t buckets_capacity;
+	} strings;
+
+	struct
+	{
+		char** data;
+		uint32_t capacity;
+		uint32_t count;
+	} names;
+
+	// NOTE: Functions of the runtime, that the backends refer to by themselves,
+	//       or UINT32_MAX if the program is built without the runtime.
+	uint32_t flush;
+	uint32_t syscall;
+} primec_ir_program_s;
+
+/**
+ * @brief Create an empty program over provided type table.
+ */
+primec_ir_program_s* primec_ir_program_create(
+	primec_type_table_s* const types);
+
+/**
+ * @brief Destroy the program with all its functions.
+ */
+void primec_ir_program_destroy(
+	primec_ir_program_s* const program);
+
+/**
+ * @brief Add a new empty function to the program (thread safe).
+ * 
+ * @return Index of the function.
+ */
+uint32_t primec_ir_program_add_func(
+	primec_ir_program_s* const program,
+	const char* const name,
+	const primec_type_t type,
+	const uint32_t flags);
+
+/**
+ * @brief Add a string to the program (thread safe).
+ * 
+ * @note The characters are not copied, so they must outlive the program. The
+ * strings with the same characters share a single index across the whole build.
+ * 
+ * @return Index of the string.
+ */
+uint32_t primec_ir_program_add_string(
+	primec_ir_program_s* const program,
+	const char* const data,
+	const uint64_t length);
+
+/**
+ * @brief Add a global to the program (thread safe).
+ *
+ * @return Index of the global.
+ */
+uint32_t primec_ir_program_add_global(
+	primec_ir_program_s* const program,
+	const primec_ir_global_s global);
+
+/**
+ * @brief Make a copy of a formatted name, owned by the program (thread safe).
+ */
+const char* primec_ir_program_add_name(
+	primec_ir_program_s* const program,
+	const char* const format,
+	...) __attribute__ ((format (printf, 2, 3)));
+
+/**
+ * @brief Get the function by its index.
+ */
+primec_ir_func_s* primec_ir_program_get_func(
+	const primec_ir_program_s* const program,
+	const uint32_t index);
+
+/**
+ * @brief Append a new empty block to the function.
+ */
+primec_ir_block_t primec_ir_func_add_block(
+	primec_ir_func_s* const func);
+
+/**
+ * @brief Append a new instruction to the block of the function.
+ * 
+ * @return Value defined by the instruction.
+ */
+primec_ir_value_t primec_ir_func_add(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const uint32_t a,
+	const uint32_t b);
+
+/**
+ * @brief Append a constant of provided type to the block.
+ */
+primec_ir_value_t primec_ir_func_add_const(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_type_t type,
+	const primec_const_value_s value);
+
+/**
+ * @brief Append a list of values to the extra array of the function.
+ * 
+ * @return Index of the list (its length is stored first).
+ */
+uint32_t primec_ir_func_add_list(
+	primec_ir_func_s* const func,
+	const uint32_t* const values,
+	const uint32_t count);
+
+/**
+ * @brief Get the instruction, that defines provided value.
+ */
+primec_ir_instruction_s* primec_ir_func_get(
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value);
+
+/**
+ * @brief Get the list stored at provided index of the extra array.
+ * 
+ * @note The length of the list is written to provided pointer.
+ */
+uint32_t* primec_ir_func_get_list(
+	const primec_ir_func_s* const func,
+	const uint32_t index,
+	uint32_t* const count);
+
+/**
+ * @brief Get the value of a const instruction.
+ */
+primec_const_value_s primec_ir_get_const(
+	const primec_ir_instruction_s* const instruction);
+
+/**
+ * @brief Check if the instruction is a terminator of its block.
+ */
+bool primec_ir_is_terminator(
+	const primec_ir_op_e op);
+
+/**
+ * @brief Check if the block ends with a terminator.
+ */
+bool primec_ir_block_is_terminated(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block);
+
+/**
+ * @brief Get the successors of the block (at most two).
+ * 
+ * @return Number of the successors.
+ */
+uint32_t primec_ir_block_get_successors(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	primec_ir_block_t* const successors);
+
+/**
+ * @brief Visitor of a value operand, that may replace the operand.
+ */
+typedef void (*primec_ir_operand_visitor_f)(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+/**
+ * @brief Visit every value operand of the instruction, including the values of
+ * its lists (the blocks of the phis and the branches are not visited).
+ * 
+ * @note Null operands (of the returns without values) are skipped.
+ */
+void primec_ir_func_visit_operands(
+	primec_ir_func_s* const func,
+	const primec_ir_value_t value,
+	const primec_ir_operand_visitor_f visitor,
+	void* const context);
+
+/**
+ * @brief Check if values of provided type are kept in memory.
+ */
+bool primec_ir_is_aggregate(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+/**
+ * @brief Check if the instruction only computes its value from its operands.
+ * 
+ * @note Pure instructions do not access memory and cannot trap, so they can be
+ * removed, when their values are unused, and moved to any place, where their
+ * operands are available. Integer divisions are pure only by the constant
+ * divisors, that are neither zero nor (signed) minus one, and the conversions
+ * of the floats to the integers are never pure.
+ */
+bool primec_ir_is_pure(
+	const primec_type_table_s* const types,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value);
+
+/**
+ * @brief Log the program in a human readable form.
+ */
+void primec_ir_dump(
+	const primec_ir_program_s* const program);
+
+/**
+ * @brief Log the function in a human readable form.
+ */
+void primec_ir_dump_func(
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const func);
+
+#endif
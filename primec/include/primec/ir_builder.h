@@ -0,0 +1,31 @@
+
+/**
+ * @file ir_builder.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__ir_builder_h__
+#define __primec__include__primec__ir_builder_h__
+
+#include <primec/ir.h>
+#include <primec/sema.h>
+
+/**
+ * @brief Lower the checked build to the ir.
+ * 
+ * @note The functions and globals of every module are declared first, in the
+ * order of the modules, then the body of every function is lowered as a
+ * separate task of the pool. Locals live in stack slots (which are promoted to
+ * ssa values by the optimizer), while the values of the short-circuit operators
+ * are merged by phis. Lambdas are hoisted into separate functions.
+ */
+primec_ir_program_s* primec_ir_build(
+	primec_sema_s* const sema);
+
+#endif
@@ -0,0 +1,38 @@
+
+/**
+ * @file jit.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__jit_h__
+#define __primec__include__primec__jit_h__
+
+#include <primec/x86_64.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Load the encoded module into the memory of the current process and
+ * call its entry function.
+ * 
+ * @note The code is written to writable pages, which are made executable (and
+ * read only) before the entry is called, so no page is writable and executable
+ * at once. External functions are looked up in the current process and called
+ * through the stubs, that jump to their absolute addresses. The result of the
+ * entry function (or 0, if it returns nothing) is written to provided status.
+ * 
+ * @return True if the entry function was called.
+ */
+bool primec_jit_run(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status);
+
+#endif
@@ -0,0 +1,71 @@
+
+/**
+ * @file layout.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__layout_h__
+#define __primec__include__primec__layout_h__
+
+#include <primec/type_table.h>
+#include <primec/ir.h>
+
+#include <stdint.h>
+
+/**
+ * @brief Size and alignment of a type in memory.
+ */
+typedef struct
+{
+	uint64_t size;
+	uint64_t alignment;
+} primec_layout_s;
+
+/**
+ * @brief Get the layout of provided type.
+ * 
+ * @note The layouts follow the System V x86-64 abi, so structs are laid out as
+ * by a C compiler, unless their fields are reordered. Slices, and references
+ * (or pointers) to slices, are pairs of the pointer to their first element and
+ * the count of their elements.
+ */
+primec_layout_s primec_layout_get(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+/**
+ * @brief Get the byte offset of the field at provided index of the struct.
+ */
+uint64_t primec_layout_get_field_offset(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint32_t index);
+
+/**
+ * @brief Reorder the fields of every struct by their alignments (the largest
+ * first), so they are padded as little as possible.
+ * 
+ * @note Only the offsets of the fields change, their indices stay the same.
+ * Structs, that the external functions can see through their parameters and
+ * results, keep their declared order, as the C code expects it.
+ */
+void primec_layout_reorder_structs(
+	primec_type_table_s* const types,
+	const primec_ir_program_s* const program);
+
+/**
+ * @brief Log the size, the alignment and the padding bytes of every struct.
+ * 
+ * @note Structs, that are laid out in their declared order, also report the
+ * padding, that reordering of their fields would leave.
+ */
+void primec_layout_report(
+	const primec_type_table_s* const types);
+
+#endif
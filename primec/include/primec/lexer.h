@@ -15,16 +15,17 @@
 
 #include <primec/utf8.h>
 #include <primec/token.h>
+#include <primec/source_manager.h>
 
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdio.h>
 
 typedef struct
 {
-	FILE* file;
+	primec_source_view_s source;
 	primec_location_s location;
 	primec_token_s token;
+	primec_token_literals_s literals;
 
 	struct
 	{
@@ -38,20 +39,20 @@ typedef struct
 } primec_lexer_s;
 
 /**
- * @brief Create a lexer with provided file and its path.
+ * @brief Create a lexer over provided view of a source file.
  */
 primec_lexer_s primec_lexer_from_parts(
-	const char* const file_path,
-	FILE* const file);
+	const primec_source_view_s source);
 
 /**
  * @brief Destroy the lexer.
  * 
- * This function deallocates the internal lexer's buffer and resets all its fields
- * to zero.
+ * This function deallocates the internal lexer's buffer and the side table of
+ * the token values (unless it was moved out of the lexer, see
+ * @ref primec_ast_from_lexer()) and resets all its fields to zero.
  * 
- * @warning This function does not close the file, used by lexer! It is left for the
- * user of the lexer to close the file after finishing with the lexer.
+ * @warning This function does not release the source, used by lexer! It is owned
+ * by the source manager.
  */
 void primec_lexer_destroy(
 	primec_lexer_s* const lexer);
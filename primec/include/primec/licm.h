@@ -0,0 +1,32 @@
+
+/**
+ * @file licm.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__licm_h__
+#define __primec__include__primec__licm_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Hoist the loop invariant computations of every function into the
+ * blocks in front of their loops.
+ * 
+ * @note Loops are found by the edges back to the blocks, that dominate them,
+ * and the inner loops are processed first, so their invariants can move on to
+ * the outer ones. Pure instructions, whose operands are defined outside the
+ * loop, are moved to the end of the only block, that jumps into the loop from
+ * the outside, and so are the loads of the loop headers, if the loop writes no
+ * memory and calls no functions.
+ */
+void primec_licm_run(
+	primec_ir_program_s* const program);
+
+#endif
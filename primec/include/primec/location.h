@@ -15,22 +15,18 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Location in the source code - file id and byte offset into the file.
+ * 
+ * @note The line and column are computed only when needed, i.e. when formatting
+ * diagnostics (see @ref primec_location_fmt in source_manager.h).
+ */
 typedef struct
 {
-	const char* file;
-	uint64_t line;
-	uint64_t column;
+	uint32_t file;
+	uint32_t offset;
 } primec_location_s;
 
-/**
- * @brief Location formatting macro for printf-like functions.
- */
-#define primec_location_fmt "%s:%lu:%lu"
-
-/**
- * @brief Location formatting argument macro for printf-like functions.
- */
-#define primec_location_arg(_location) \
-	(_location).file, (_location).line, (_location).column
+_Static_assert(sizeof(primec_location_s) == 8, "primec_location_s must stay 8 bytes");
 
 #endif
@@ -0,0 +1,45 @@
+
+/**
+ * @file optimizer.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__optimizer_h__
+#define __primec__include__primec__optimizer_h__
+
+#include <primec/ir.h>
+#include <primec/build_graph.h>
+
+#include <stdbool.h>
+
+typedef enum
+{
+	primec_optimizer_level_none,	// only the calls of the `inl` functions are inlined and the unsafe checks removed
+	primec_optimizer_level_scalar,	// the scalar optimizations
+	primec_optimizer_level_full,	// the scalar optimizations and the vectorizer
+	primec_optimizer_levels_count,
+} primec_optimizer_level_e;
+
+/**
+ * @brief Run the passes of provided optimization level over the program.
+ * 
+ * @note The passes run in a fixed order: the inliner, the promotion of the
+ * slots, the constant propagation, the value numbering, the dead code
+ * elimination, the removal of the bounds checks, the hoisting of the loop
+ * invariants and the vectorizer, with the dead code removed once more at the
+ * end. Every pass takes time about linear in the size of the functions. The
+ * vectorizer runs only if the program may be vectorized.
+ */
+void primec_optimizer_run(
+	primec_ir_program_s* const program,
+	const primec_build_graph_s* const graph,
+	const primec_optimizer_level_e level,
+	const bool is_vectorizing);
+
+#endif
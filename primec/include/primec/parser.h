@@ -0,0 +1,115 @@
+
+/**
+ * @file parser.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__parser_h__
+#define __primec__include__primec__parser_h__
+
+#include <primec/ast.h>
+#include <primec/thread_pool.h>
+
+#include <stdint.h>
+
+/**
+ * @brief Matching braces of a top-level block, found by the skeleton pass.
+ */
+typedef struct
+{
+	uint32_t open;
+	uint32_t close;
+} primec_parser_braces_s;
+
+/**
+ * @brief Function declaration whose body is parsed after the declarations.
+ */
+typedef struct
+{
+	primec_ast_index_t node;
+	primec_parser_braces_s braces;
+} primec_parser_body_s;
+
+typedef struct
+{
+	primec_ast_s* ast;
+	uint32_t cursor;
+	uint32_t depth;
+
+	struct
+	{
+		primec_parser_braces_s* data;
+		uint32_t capacity;
+		uint32_t count;
+		uint32_t next;
+	} skeleton;
+
+	struct
+	{
+		primec_parser_body_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} bodies;
+
+	struct
+	{
+		primec_ast_index_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} scratch;
+
+	struct
+	{
+		struct
+		{
+			uint32_t token;
+			uint8_t precedence;
+			uint8_t kind;
+			primec_ast_index_t flags;
+		}* data;
+		uint32_t capacity;
+		uint32_t count;
+	} operators;
+} primec_parser_s;
+
+/**
+ * @brief Create a parser over the tokens of provided ast.
+ * 
+ * @note The ast must already contain the tokens of the file (see
+ * @ref primec_ast_from_lexer()).
+ */
+primec_parser_s primec_parser_from_parts(
+	primec_ast_s* const ast);
+
+/**
+ * @brief Destroy the parser.
+ * 
+ * @warning This function does not destroy the ast, it is left for the user of
+ * the parser to destroy it.
+ */
+void primec_parser_destroy(
+	primec_parser_s* const parser);
+
+/**
+ * @brief Parse the whole token stream of the ast into a module node.
+ * 
+ * @note The parsing happens in two steps: first, the skeleton pass matches the
+ * braces of all top-level blocks and the declarations are parsed with the
+ * function bodies skipped. Then, the bodies are parsed in batches as separate
+ * tasks of provided pool (or serially, if the pool is NULL), each batch into
+ * its own ast part, and the parts are merged back into the ast.
+ * 
+ * @note The returned module node is also stored as the root of the ast. On any
+ * syntax error the parser logs the error and exits.
+ */
+primec_ast_index_t primec_parser_parse(
+	primec_parser_s* const parser,
+	primec_thread_pool_s* const pool);
+
+#endif
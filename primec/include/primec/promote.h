@@ -0,0 +1,28 @@
+
+/**
+ * @file promote.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__promote_h__
+#define __primec__include__primec__promote_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Promote the scalar slots of every function to ssa values.
+ * 
+ * @note Slots, whose addresses are only loaded from and stored to, are
+ * replaced by the stored values, with the phis placed at the dominance
+ * frontiers of the stores. Loads before any store see zeros.
+ */
+void primec_promote_run(
+	primec_ir_program_s* const program);
+
+#endif
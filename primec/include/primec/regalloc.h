@@ -0,0 +1,38 @@
+
+/**
+ * @file regalloc.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__regalloc_h__
+#define __primec__include__primec__regalloc_h__
+
+#include <primec/x86_64.h>
+
+/**
+ * @brief Replace the virtual registers of the function with the machine ones.
+ * 
+ * @note Every virtual register gets a live interval, from its first
+ * definition to its last use, extended over the blocks where it is live. The
+ * intervals are allocated by the linear scan in the order of their starts,
+ * while the machine registers used by the instructions themselves (arguments,
+ * results and clobbers of calls) block the intervals that overlap them. An
+ * interval, that fits into no free register as a whole, is split before the
+ * register gets blocked (at the block starts of the fewest loops, where
+ * possible), and the parts without a register wait in the slot of the virtual
+ * register until their next use. Definitions of the split registers are
+ * written through to their slots, and the registers are reloaded at the starts
+ * of their parts and at the block starts, where a predecessor had the value
+ * elsewhere. Spilled uses are rewritten through the scratch registers (r10,
+ * r11, xmm14 and xmm15), which are never allocated.
+ */
+void primec_regalloc_run(
+	primec_x86_64_func_s* const func);
+
+#endif
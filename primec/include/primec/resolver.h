@@ -0,0 +1,236 @@
+
+/**
+ * @file resolver.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__resolver_h__
+#define __primec__include__primec__resolver_h__
+
+#include <primec/ast.h>
+#include <primec/symbols.h>
+#include <primec/build_graph.h>
+#include <primec/diagnostics.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum
+{
+	primec_binding_kind_none,
+	primec_binding_kind_module,			// module: imported module, node: use declaration
+	primec_binding_kind_func,			// node: func declaration
+	primec_binding_kind_struct,			// node: struct declaration
+	primec_binding_kind_enum,			// node: enum declaration
+	primec_binding_kind_alias,			// node: alias declaration
+	primec_binding_kind_global,			// node: module-level let declaration
+	primec_binding_kind_param,			// node: param of the enclosing function
+	primec_binding_kind_local,			// node: let declaration in a block
+	primec_binding_kind_member,			// node: enum member (found through its enum)
+	primec_binding_kinds_count
+} primec_binding_kind_e;
+
+/**
+ * @brief Stringify binding kind.
+ */
+const char* primec_binding_kind_to_string(
+	const primec_binding_kind_e kind);
+
+/**
+ * @brief Declaration a symbol is bound to.
+ * 
+ * @note The module is the index of the declaring module in the build graph (or
+ * of the imported module, for module bindings).
+ */
+typedef struct
+{
+	primec_symbol_t symbol;
+	uint32_t kind;
+	uint32_t module;
+	primec_ast_index_t node;
+} primec_binding_s;
+
+_Static_assert(sizeof(primec_binding_s) == 16, "primec_binding_s must stay 16 bytes wide!");
+
+/**
+ * @brief Module-level symbol table.
+ * 
+ * @note The table is built once, right after the module is loaded, and it is
+ * frozen afterwards: it is only read, so any number of workers can resolve the
+ * names of the module without locking. Besides the declarations, the table
+ * keeps the symbol of every token of the module, so the workers never intern.
+ */
+typedef struct
+{
+	uint32_t module;
+	const primec_ast_s* ast;
+	primec_symbol_t* tokens;
+
+	// NOTE: Open addressing table of the declarations (the bindings with null
+	//       symbol are empty), its capacity is always a power of two.
+	struct
+	{
+		primec_binding_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} bindings;
+} primec_module_scope_s;
+
+/**
+ * @brief Build the frozen symbol table of the module.
+ * 
+ * @note All the module-level declarations and `use` imports (bound by the last
+ * component of their path) are declared. Declaring the same name twice is
+ * reported to provided diagnostics, and the later declaration is skipped.
+ */
+primec_module_scope_s primec_module_scope_from_module(
+	primec_symbols_s* const symbols,
+	const primec_module_s* const module,
+	primec_diagnostics_s* const diagnostics);
+
+/**
+ * @brief Destroy the module scope.
+ */
+void primec_module_scope_destroy(
+	primec_module_scope_s* const scope);
+
+/**
+ * @brief Find the module-level declaration of the symbol (or NULL).
+ */
+const primec_binding_s* primec_module_scope_find(
+	const primec_module_scope_s* const scope,
+	const primec_symbol_t symbol);
+
+/**
+ * @brief Slot of the open addressing table of a local scope.
+ */
+typedef struct
+{
+	primec_symbol_t symbol;
+	uint32_t binding;
+} primec_scope_slot_s;
+
+/**
+ * @brief Local scope, a table in the slots arena of the resolver.
+ */
+typedef struct
+{
+	uint32_t start;
+	uint32_t capacity;
+	uint32_t count;
+	uint32_t bindings;
+} primec_scope_s;
+
+/**
+ * @brief Resolver of the names used in the function bodies of a module.
+ * 
+ * @note The local scopes live on a flat stack: every scope owns a small open
+ * addressing table in the slots arena, and only the innermost one grows, as
+ * the names are declared in the innermost scope only. Thus, popping a scope
+ * just truncates the arenas, regardless of how many locals it has declared.
+ * Every worker uses its own resolver, while sharing the frozen module scopes.
+ */
+typedef struct
+{
+	const primec_module_scope_s* modules;
+	const primec_module_scope_s* module;
+	const primec_module_scope_s* runtime;
+
+	struct
+	{
+		primec_scope_slot_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} slots;
+
+	struct
+	{
+		primec_scope_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} scopes;
+
+	struct
+	{
+		primec_binding_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} bindings;
+} primec_resolver_s;
+
+/**
+ * @brief Create a resolver of the module at provided index.
+ * 
+ * @note The modules array holds the scopes of all the modules of the build
+ * graph, indexed by the module index, to resolve the names of the imports. The
+ * runtime is the index of the runtime module (or UINT32_MAX), which names are
+ * found after the ones of the module.
+ */
+primec_resolver_s primec_resolver_from_parts(
+	const primec_module_scope_s* const modules,
+	const uint32_t module,
+	const uint32_t runtime);
+
+/**
+ * @brief Destroy the resolver.
+ */
+void primec_resolver_destroy(
+	primec_resolver_s* const resolver);
+
+/**
+ * @brief Open a new innermost scope.
+ */
+void primec_resolver_push_scope(
+	primec_resolver_s* const resolver);
+
+/**
+ * @brief Close the innermost scope, dropping all the names it has declared.
+ */
+void primec_resolver_pop_scope(
+	primec_resolver_s* const resolver);
+
+/**
+ * @brief Declare the binding in the innermost scope.
+ * 
+ * @note If the name is already declared in the innermost scope, the previous
+ * binding is returned and nothing is declared, otherwise NULL is returned. The
+ * names of the outer scopes and the module are shadowed.
+ */
+const primec_binding_s* primec_resolver_declare(
+	primec_resolver_s* const resolver,
+	const primec_binding_s binding);
+
+/**
+ * @brief Find the binding of the symbol, from the innermost scope out to the
+ * module scope and then the runtime (or NULL).
+ */
+const primec_binding_s* primec_resolver_find(
+	const primec_resolver_s* const resolver,
+	const primec_symbol_t symbol);
+
+/**
+ * @brief Find the binding of the symbol declared in the imported module (or
+ * NULL).
+ * 
+ * @note Only the declarations of the module are visible, its own imports are
+ * not re-exported.
+ */
+const primec_binding_s* primec_resolver_find_in_module(
+	const primec_resolver_s* const resolver,
+	const uint32_t module,
+	const primec_symbol_t symbol);
+
+/**
+ * @brief Get the symbol of the token of the current module.
+ */
+primec_symbol_t primec_resolver_get_symbol(
+	const primec_resolver_s* const resolver,
+	const uint32_t token);
+
+#endif
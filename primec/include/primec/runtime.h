@@ -0,0 +1,47 @@
+
+/**
+ * @file runtime.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__runtime_h__
+#define __primec__include__primec__runtime_h__
+
+#include <primec/build_graph.h>
+
+/**
+ * @brief Path of the runtime module, it is shown by the diagnostics only.
+ */
+#define primec_runtime_path "<runtime>"
+
+/**
+ * @brief Name of the runtime function, that writes out the buffered output.
+ */
+#define primec_runtime_flush "flush"
+
+/**
+ * @brief Name of the external function of the runtime, that makes the system
+ * calls.
+ */
+#define primec_runtime_syscall "syscall"
+
+/**
+ * @brief Add the runtime module to the build graph.
+ * 
+ * @note The runtime is written in prime and built with every program, so the
+ * programs need no C library: it has the raw system calls (read, write, mmap
+ * and exit), the buffered standard output and the print functions, that format
+ * the numbers themselves. The only external function it declares is syscall,
+ * which the executables and the objects get as a stub of a few instructions,
+ * while the runs in the compiler process use the one of the C library.
+ */
+void primec_runtime_add(
+	primec_build_graph_s* const graph);
+
+#endif
@@ -0,0 +1,34 @@
+
+/**
+ * @file sccp.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__sccp_h__
+#define __primec__include__primec__sccp_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Propagate the constants of every function along its executable edges
+ * (sparse conditional constant propagation).
+ * 
+ * @note Values start undefined and are lowered to constants, or to unknown,
+ * only by the blocks, that can be executed, and the branches on the constant
+ * conditions make only one of their edges executable. Scalar arithmetic,
+ * comparisons and conversions are folded with the wrapping of their types,
+ * as the vm computes them, while the divisions, that would trap, are left to
+ * trap at runtime. The folded values become constants, the branches on the
+ * constants become jumps, the phis lose their entries of the edges, that are
+ * never taken, and the blocks, that are never executed, become unreachable.
+ */
+void primec_sccp_run(
+	primec_ir_program_s* const program);
+
+#endif
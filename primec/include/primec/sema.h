@@ -0,0 +1,145 @@
+
+/**
+ * @file sema.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__sema_h__
+#define __primec__include__primec__sema_h__
+
+#include <primec/ast.h>
+#include <primec/build_graph.h>
+#include <primec/const_eval.h>
+#include <primec/diagnostics.h>
+#include <primec/resolver.h>
+#include <primec/symbols.h>
+#include <primec/thread_pool.h>
+#include <primec/type_table.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Implicit conversion applied to the value of an expression.
+ * 
+ * @note Conversions that do not change the representation (a mutable reference
+ * used as an immutable one, or a reference used as a pointer) have no kind, but
+ * still change the target type of the node.
+ */
+typedef enum
+{
+	primec_sema_coercion_none,
+	primec_sema_coercion_deref,				// load the value the reference points to
+	primec_sema_coercion_array_to_slice,	// reference to an array into a slice reference
+	primec_sema_coercion_slice_to_pointer,	// slice reference into a pointer to its first element
+	primec_sema_coercion_bool_to_int,		// boolean into an integer (0 or 1)
+	primec_sema_coercions_count
+} primec_sema_coercion_e;
+
+typedef enum
+{
+	primec_sema_flag_place = 1 << 0,		// expression denotes a memory location
+	primec_sema_flag_mutable = 1 << 1,		// the location (or declared variable) is mutable
+	primec_sema_flag_returns = 1 << 2,		// statement never completes normally
+	primec_sema_flag_constant = 1 << 3,		// value is known at compile time (see the values of the module)
+} primec_sema_flag_e;
+
+/**
+ * @brief Semantic information of an ast node.
+ * 
+ * @note The type is the type of the node itself, while the target is the type
+ * of its value after the coercion. Identifier and scope nodes refer to their
+ * declaration by module and node, member nodes keep the index of the field in
+ * the node slot instead.
+ */
+typedef struct
+{
+	primec_type_t type;
+	primec_type_t target;
+	uint8_t coercion;
+	uint8_t binding;
+	uint8_t flags;
+	uint8_t reserved;
+	uint32_t module;
+	primec_ast_index_t node;
+} primec_sema_node_s;
+
+// NOTE: Member nodes of the builtin `count` member of arrays and slices keep
+//       this value instead of a field index.
+#define primec_sema_member_count ((primec_ast_index_t)-1)
+
+_Static_assert(sizeof(primec_sema_node_s) == 20, "primec_sema_node_s must stay 20 bytes wide!");
+
+typedef struct
+{
+	const primec_module_s* module;
+	primec_sema_node_s* nodes;
+	uint8_t* states;
+	primec_const_value_s* values;
+	primec_diagnostics_s diagnostics;
+} primec_sema_module_s;
+
+typedef struct
+{
+	primec_build_graph_s* graph;
+	primec_type_table_s* types;
+	primec_symbols_s* symbols;
+	primec_module_scope_s* scopes;
+	primec_sema_module_s* modules;
+} primec_sema_s;
+
+/**
+ * @brief Create the semantic analyzer of the loaded build graph.
+ * 
+ * @note The analyzer owns the type table and the symbols of the build. It is
+ * returned by pointer, as its tasks refer to it, so it cannot be moved.
+ */
+primec_sema_s* primec_sema_create(
+	primec_build_graph_s* const graph);
+
+/**
+ * @brief Destroy the analyzer with all its tables.
+ */
+void primec_sema_destroy(
+	primec_sema_s* const sema);
+
+/**
+ * @brief Check the whole build.
+ * 
+ * @note The check runs in two phases. First, the declarations of every module
+ * are collected and their signatures are resolved, as a build graph stage (so
+ * independent modules are processed in parallel). Then, the body of every
+ * function is checked as a separate task of the pool. The errors of every task
+ * are gathered separately and logged in the order of the modules and of the
+ * functions in them, regardless of the scheduling, and if there were any, the
+ * compiler exits after the phase.
+ */
+void primec_sema_check(
+	primec_sema_s* const sema);
+
+/**
+ * @brief Get the semantic information of the node of provided module.
+ */
+const primec_sema_node_s* primec_sema_get_node(
+	const primec_sema_s* const sema,
+	const uint32_t module,
+	const primec_ast_index_t node);
+
+/**
+ * @brief Get the folded value of the constant node of provided module.
+ * 
+ * @note The value has the type of the node (before its coercion), and it is
+ * valid only if the node is flagged as constant.
+ */
+primec_const_value_s primec_sema_get_value(
+	const primec_sema_s* const sema,
+	const uint32_t module,
+	const primec_ast_index_t node);
+
+#endif
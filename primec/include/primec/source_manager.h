@@ -0,0 +1,114 @@
+
+/**
+ * @file source_manager.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__source_manager_h__
+#define __primec__include__primec__source_manager_h__
+
+#include <primec/location.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Location formatting macro for printf-like functions.
+ */
+#define primec_location_fmt "%s:%u:%u"
+
+/**
+ * @brief Location formatting argument macro for printf-like functions.
+ */
+#define primec_location_arg(_location)                                         \
+	primec_source_manager_get_path((_location).file),                          \
+	primec_source_manager_get_line(_location),                                 \
+	primec_source_manager_get_column(_location)
+
+/**
+ * @brief Read-only view of the whole text of a loaded file.
+ * 
+ * @note The text is owned by the source manager and stays valid (and unchanged)
+ * until the source manager is destroyed, thus views can be shared by any number
+ * of threads. The text is always followed by a null symbol.
+ */
+typedef struct
+{
+	const char* data;
+	uint32_t length;
+	uint32_t file;
+} primec_source_view_s;
+
+/**
+ * @brief Register a source file and get its dense id.
+ * 
+ * @note Files are identified by their device and inode, so the same file passed
+ * several times or reached through different paths gets the same id (and the
+ * is_new flag is set only for the first one). If the file cannot be stat-ed or
+ * it is a directory, false is returned and errno is set accordingly.
+ * 
+ * @note The source manager is shared by the whole process and all its functions
+ * are thread-safe.
+ */
+bool primec_source_manager_add_file(
+	const char* const path,
+	uint32_t* const file,
+	bool* const is_new);
+
+/**
+ * @brief Register a file, that has no path on the disk, with provided text.
+ * 
+ * @note The text is copied, so it does not have to outlive the call. Such files
+ * are never deduplicated, and the path is used for the diagnostics only.
+ */
+uint32_t primec_source_manager_add_text(
+	const char* const path,
+	const char* const text,
+	const uint32_t length);
+
+/**
+ * @brief Get the view of the text of the file with provided id.
+ * 
+ * @note The file is read on the first request of its view, and every other
+ * request (from any thread) gets the same view, so every file is read once.
+ */
+primec_source_view_s primec_source_manager_get_view(
+	const uint32_t file);
+
+/**
+ * @brief Get the path of the file with provided id.
+ * 
+ * @note The path is the one the file was first registered with.
+ */
+const char* primec_source_manager_get_path(
+	const uint32_t file);
+
+/**
+ * @brief Get the line (starting from 1) of provided location.
+ * 
+ * @note The line starts of a file are computed on the first query and cached.
+ */
+uint32_t primec_source_manager_get_line(
+	const primec_location_s location);
+
+/**
+ * @brief Get the column (in utf-8 symbols, starting from 1) of provided location.
+ */
+uint32_t primec_source_manager_get_column(
+	const primec_location_s location);
+
+/**
+ * @brief Release all the files of the source manager.
+ * 
+ * @warning All the views and paths handed out before become invalid!
+ */
+void primec_source_manager_destroy(
+	void);
+
+#endif
@@ -0,0 +1,49 @@
+
+/**
+ * @file string_pool.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__string_pool_h__
+#define __primec__include__primec__string_pool_h__
+
+#include <primec/ir.h>
+
+#include <stdint.h>
+
+/**
+ * @brief String pool - the characters of all strings of a program, laid out
+ * as the single read only section, and the offset of every string in it.
+ */
+typedef struct
+{
+	char* data;
+	uint64_t size;
+	uint64_t* offsets;
+} primec_string_pool_s;
+
+/**
+ * @brief Lay out the strings of provided program.
+ * 
+ * @note Strings are terminated by zeros, so they can be passed to C. The
+ * program holds every string once already, and a string that is the suffix of
+ * another one is not stored at all, but points into the tail of the longer one
+ * instead, so "error" and "fatal error" take the room of the latter only. The
+ * characters need no alignment, so the strings are packed without any padding.
+ */
+primec_string_pool_s primec_string_pool_from_program(
+	const primec_ir_program_s* const program);
+
+/**
+ * @brief Destroy the pool.
+ */
+void primec_string_pool_destroy(
+	primec_string_pool_s* const pool);
+
+#endif
@@ -0,0 +1,116 @@
+
+/**
+ * @file symbols.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__symbols_h__
+#define __primec__include__primec__symbols_h__
+
+#include <primec/ast.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pthread.h>
+
+/**
+ * @brief Id of an interned identifier.
+ * 
+ * @note Every identifier text is interned exactly once, thus two identifiers
+ * are equal if and only if their ids are equal. Id 0 is reserved for the null
+ * symbol (no identifier).
+ */
+typedef uint32_t primec_symbol_t;
+#define primec_symbol_null ((primec_symbol_t)0)
+
+typedef struct
+{
+	const char* text;
+	uint32_t length;
+	uint32_t hash;
+} primec_symbol_entry_s;
+
+/**
+ * @brief Interner of the identifiers of all modules of the build.
+ * 
+ * @note The entries are stored in pages that are never moved, and the texts in
+ * chunks that are never freed before the interner itself, so the texts can be
+ * read without any locking, while interning is serialized by the mutex.
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+
+	struct
+	{
+		primec_symbol_entry_s** pages;
+		uint32_t count;
+	} entries;
+
+	struct
+	{
+		char** chunks;
+		uint32_t capacity;
+		uint32_t count;
+		uint64_t used;
+		uint64_t size;
+	} texts;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+	} buckets;
+} primec_symbols_s;
+
+/**
+ * @brief Create an empty interner.
+ * 
+ * @note The interner is returned by pointer, as it is shared by the threads, so
+ * it cannot be moved.
+ */
+primec_symbols_s* primec_symbols_create(
+	void);
+
+/**
+ * @brief Destroy the interner and free all the interned texts.
+ */
+void primec_symbols_destroy(
+	primec_symbols_s* const symbols);
+
+/**
+ * @brief Intern the text of provided length and return its symbol.
+ */
+primec_symbol_t primec_symbols_intern(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length);
+
+/**
+ * @brief Intern every identifier token of the ast at once.
+ * 
+ * @note The symbol of every token is written to the array at the index of the
+ * token (the tokens that are not identifiers get the null symbol), so the array
+ * must hold as many symbols as the ast has tokens. The lock is taken once for
+ * the whole ast, so the workers resolving the bodies later never intern.
+ */
+void primec_symbols_intern_ast(
+	primec_symbols_s* const symbols,
+	const primec_ast_s* const ast,
+	primec_symbol_t* const tokens);
+
+/**
+ * @brief Get the null terminated text of the symbol.
+ */
+const char* primec_symbols_get_text(
+	const primec_symbols_s* const symbols,
+	const primec_symbol_t symbol);
+
+#endif
@@ -0,0 +1,37 @@
+
+/**
+ * @file tailcall.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__tailcall_h__
+#define __primec__include__primec__tailcall_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Find the calls in the tail positions of every function, turn the
+ * self-recursive ones into loops, and mark the others as the sibling calls.
+ * 
+ * @note A call is in a tail position, if the block returns its result right
+ * after it. The returns of the join blocks, that only return their phis, are
+ * copied into the predecessors first, so the calls in the arms of the if
+ * expressions are found as well.
+ * 
+ * @note Self-recursive tail calls jump back to a new loop header, that has a
+ * phi for every parameter, so the recursion runs in constant stack space. The
+ * other tail calls are marked with primec_ir_instruction_flag_tail, so the
+ * native backend may replace them with the jumps, that reuse the frame of the
+ * caller. Functions with the slots are skipped, as the arguments may point to
+ * their frames, and so are the functions returning through the hidden pointer.
+ */
+void primec_tailcall_run(
+	primec_ir_program_s* const program);
+
+#endif
@@ -0,0 +1,105 @@
+
+/**
+ * @file thread_pool.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__thread_pool_h__
+#define __primec__include__primec__thread_pool_h__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pthread.h>
+
+typedef void(*primec_thread_pool_task_f)(
+	void* const context);
+
+/**
+ * @brief Group of tasks that can be waited on together.
+ */
+typedef struct
+{
+	uint64_t pending;
+} primec_thread_pool_group_s;
+
+typedef struct
+{
+	primec_thread_pool_task_f task;
+	void* context;
+	primec_thread_pool_group_s* group;
+} primec_thread_pool_entry_s;
+
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t task_available;
+	pthread_cond_t task_finished;
+
+	struct
+	{
+		pthread_t* data;
+		uint32_t count;
+	} workers;
+
+	struct
+	{
+		primec_thread_pool_entry_s* data;
+		uint64_t capacity;
+		uint64_t head;
+		uint64_t count;
+	} queue;
+
+	bool should_stop;
+} primec_thread_pool_s;
+
+/**
+ * @brief Get the number of online processors (at least 1).
+ */
+uint32_t primec_thread_pool_get_processors_count(
+	void);
+
+/**
+ * @brief Create a thread pool with provided number of worker threads.
+ * 
+ * @note The pool is returned by pointer, as the workers refer to it, so it
+ * cannot be moved. A pool with 0 workers executes all tasks on the threads
+ * that wait for them.
+ */
+primec_thread_pool_s* primec_thread_pool_create(
+	const uint32_t workers_count);
+
+/**
+ * @brief Stop all workers and destroy the thread pool.
+ * 
+ * @warning All the groups must be waited on before destroying the pool!
+ */
+void primec_thread_pool_destroy(
+	primec_thread_pool_s* const pool);
+
+/**
+ * @brief Submit a task to the pool as part of provided group.
+ */
+void primec_thread_pool_submit(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_group_s* const group,
+	const primec_thread_pool_task_f task,
+	void* const context);
+
+/**
+ * @brief Wait until all tasks of the group are finished.
+ * 
+ * @note The waiting thread executes queued tasks while it waits, thus tasks
+ * can submit and wait on nested groups without starving the pool.
+ */
+void primec_thread_pool_wait(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_group_s* const group);
+
+#endif
@@ -151,41 +151,75 @@ primec_token_type_e primec_token_type_from_string(
 const char* primec_token_type_to_string(
 	const primec_token_type_e type);
 
+_Static_assert(primec_token_type_none <= UINT8_MAX, "token types must fit into a byte");
+
+typedef enum
+{
+	primec_token_flag_untyped = 1 << 0, // numeric literal without a suffix
+} primec_token_flag_e;
+
+/**
+ * @brief Lexed token.
+ * 
+ * @note The token is kept compact, so buffered token streams stay small: the
+ * type is stored as a byte and the values of literals, identifiers and other
+ * texts are kept in a side table (see @ref primec_token_literals_s) with the
+ * payload being the index of the value in it.
+ */
 typedef struct
 {
-	primec_token_type_e type;
+	uint8_t type;
+	uint8_t flags;
+	uint16_t reserved;
+	uint32_t payload;
 	primec_location_s location;
+} primec_token_s;
+
+_Static_assert(sizeof(primec_token_s) == 16, "primec_token_s must stay 16 bytes");
 
+/**
+ * @brief Value of a literal token, or the location of its text in the strings.
+ */
+typedef struct
+{
 	union
 	{
-		struct
-		{
-			char* data;
-			uint64_t length;
-		} comment;
-
-		utf8char_t rune;
 		int64_t ival;
 		uint64_t uval;
 		long double fval;
+		utf8char_t rune;
 
 		struct
 		{
-			char* data;
+			uint64_t offset;
 			uint64_t length;
-		} str;
-		struct
-		{
-			char* data;
-			uint64_t length;
-		} ident;
-		struct
-		{
-			char* data;
-			uint64_t length;
-		} invalid;
+		} text;
 	};
-} primec_token_s;
+} primec_token_value_s;
+
+/**
+ * @brief Side table of the token values and texts.
+ * 
+ * @note Every text is null terminated in the strings, so they can be passed to
+ * the functions, that expect c strings, but string literals may also contain
+ * null symbols, thus the length of the text should be preferred.
+ */
+typedef struct
+{
+	struct
+	{
+		primec_token_value_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} values;
+
+	struct
+	{
+		char* data;
+		uint64_t capacity;
+		uint64_t length;
+	} strings;
+} primec_token_literals_s;
 
 /**
  * @brief Create token with provided token type and location.
@@ -205,7 +239,10 @@ primec_token_s primec_token_from_type(
 	const primec_token_type_e type);
 
 /**
- * @brief Destroy token and free all its resources.
+ * @brief Destroy token.
+ * 
+ * @note Tokens do not own any resources (their values are owned by the side
+ * table), so this function only resets the token.
  */
 void primec_token_destroy(
 	primec_token_s* const token);
@@ -218,6 +255,43 @@ void primec_token_destroy(
  * overwritten every time this function is called!
  */
 const char* primec_token_to_string(
+	const primec_token_s* const token,
+	const primec_token_literals_s* const literals);
+
+/**
+ * @brief Destroy the side table and free all its values and strings.
+ */
+void primec_token_literals_destroy(
+	primec_token_literals_s* const literals);
+
+/**
+ * @brief Push a value to the side table and get its index.
+ */
+uint32_t primec_token_literals_push_value(
+	primec_token_literals_s* const literals,
+	const primec_token_value_s value);
+
+/**
+ * @brief Copy a text to the strings of the side table and get the index of its
+ * value.
+ */
+uint32_t primec_token_literals_push_text(
+	primec_token_literals_s* const literals,
+	const char* const text,
+	const uint64_t length);
+
+/**
+ * @brief Get the value of provided token.
+ */
+const primec_token_value_s* primec_token_literals_get_value(
+	const primec_token_literals_s* const literals,
+	const primec_token_s* const token);
+
+/**
+ * @brief Get the null terminated text of provided token.
+ */
+const char* primec_token_literals_get_text(
+	const primec_token_literals_s* const literals,
 	const primec_token_s* const token);
 
 #endif
@@ -0,0 +1,286 @@
+
+/**
+ * @file type_table.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__type_table_h__
+#define __primec__include__primec__type_table_h__
+
+#include <primec/token.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <pthread.h>
+
+/**
+ * @brief Handle of an interned type.
+ * 
+ * @note Every type is interned exactly once, thus two types are equal if and
+ * only if their handles are equal.
+ */
+typedef uint32_t primec_type_t;
+
+typedef enum
+{
+	primec_type_kind_void,
+	primec_type_kind_bool,
+	primec_type_kind_i8,
+	primec_type_kind_i16,
+	primec_type_kind_i32,
+	primec_type_kind_i64,
+	primec_type_kind_u8,
+	primec_type_kind_u16,
+	primec_type_kind_u32,
+	primec_type_kind_u64,
+	primec_type_kind_f32,
+	primec_type_kind_f64,
+	primec_type_kind_c8,
+	primec_type_kind_untyped_int,		// type of unsuffixed integer literals
+	primec_type_kind_untyped_float,		// type of unsuffixed float literals
+	primec_type_kind_error,				// type of erroneous expressions (suppresses further errors)
+	primec_type_kind_reference,			// element: pointee, flags: mut
+	primec_type_kind_pointer,			// element: pointee, flags: mut
+	primec_type_kind_array,				// element: element type, count: elements count
+	primec_type_kind_slice,				// element: element type
+	primec_type_kind_func,				// element: return type, list: parameters, flags: variadic
+	primec_type_kind_struct,			// nominal: declaration, list: field types
+	primec_type_kind_enum,				// nominal: declaration, element: underlying type
+	primec_type_kind_vector,			// element: lane type, count: lanes count (made by the optimizer only)
+	primec_type_kinds_count,
+
+	// NOTE: The primitive types are preallocated, and their handles are equal to
+	//       their kinds.
+	primec_type_primitives_count = primec_type_kind_reference
+} primec_type_kind_e;
+
+#define primec_type_void ((primec_type_t)primec_type_kind_void)
+#define primec_type_bool ((primec_type_t)primec_type_kind_bool)
+#define primec_type_i8 ((primec_type_t)primec_type_kind_i8)
+#define primec_type_i16 ((primec_type_t)primec_type_kind_i16)
+#define primec_type_i32 ((primec_type_t)primec_type_kind_i32)
+#define primec_type_i64 ((primec_type_t)primec_type_kind_i64)
+#define primec_type_u8 ((primec_type_t)primec_type_kind_u8)
+#define primec_type_u16 ((primec_type_t)primec_type_kind_u16)
+#define primec_type_u32 ((primec_type_t)primec_type_kind_u32)
+#define primec_type_u64 ((primec_type_t)primec_type_kind_u64)
+#define primec_type_f32 ((primec_type_t)primec_type_kind_f32)
+#define primec_type_f64 ((primec_type_t)primec_type_kind_f64)
+#define primec_type_c8 ((primec_type_t)primec_type_kind_c8)
+#define primec_type_untyped_int ((primec_type_t)primec_type_kind_untyped_int)
+#define primec_type_untyped_float ((primec_type_t)primec_type_kind_untyped_float)
+#define primec_type_error ((primec_type_t)primec_type_kind_error)
+
+typedef enum
+{
+	primec_type_flag_mut = 1 << 0,
+	primec_type_flag_variadic = 1 << 1,
+	primec_type_flag_complete = 1 << 2, // struct with its fields already set
+	primec_type_flag_reordered = 1 << 3, // struct with its fields laid out by their alignments
+} primec_type_flag_e;
+
+/**
+ * @brief Interned type record.
+ */
+typedef struct
+{
+	uint8_t kind;
+	uint8_t flags;
+	uint16_t reserved;
+	primec_type_t element;
+
+	union
+	{
+		uint64_t count;
+
+		struct
+		{
+			uint32_t file;
+			uint32_t node;
+		} nominal;
+	};
+
+	struct
+	{
+		uint32_t start;
+		uint32_t count;
+	} list;
+
+	const char* name;
+} primec_type_s;
+
+_Static_assert(sizeof(primec_type_s) == 32, "primec_type_s must stay 32 bytes");
+
+/**
+ * @brief Hash-consing table of all types of the build.
+ * 
+ * @note Types and lists are stored in pages that are never moved, so the types
+ * can be read without any locking by any thread that has got their handles,
+ * while interning of new types is serialized by the mutex.
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+
+	struct
+	{
+		primec_type_s** pages;
+		uint32_t count;
+	} types;
+
+	struct
+	{
+		primec_type_t** pages;
+		uint32_t count;
+	} lists;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+	} buckets;
+} primec_type_table_s;
+
+/**
+ * @brief Create a type table with all the primitive types preallocated.
+ * 
+ * @note The table is returned by pointer, as it is shared by the threads, so it
+ * cannot be moved.
+ */
+primec_type_table_s* primec_type_table_create(
+	void);
+
+/**
+ * @brief Destroy the type table.
+ */
+void primec_type_table_destroy(
+	primec_type_table_s* const table);
+
+/**
+ * @brief Get the record of provided type.
+ */
+const primec_type_s* primec_type_table_get(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+/**
+ * @brief Get the list (parameters of a function, or fields of a struct) of
+ * provided type.
+ */
+const primec_type_t* primec_type_table_get_list(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+/**
+ * @brief Get the primitive type, named by provided keyword (or void if the
+ * keyword is not a primitive type).
+ */
+primec_type_t primec_type_table_get_primitive(
+	const primec_token_type_e keyword);
+
+primec_type_t primec_type_table_get_reference(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const bool is_mutable);
+
+primec_type_t primec_type_table_get_pointer(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const bool is_mutable);
+
+primec_type_t primec_type_table_get_array(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const uint64_t count);
+
+primec_type_t primec_type_table_get_slice(
+	primec_type_table_s* const table,
+	const primec_type_t element);
+
+/**
+ * @brief Get the vector type of provided lanes, that is kept in a single xmm
+ * register (16 bytes).
+ */
+primec_type_t primec_type_table_get_vector(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const uint64_t count);
+
+primec_type_t primec_type_table_get_func(
+	primec_type_table_s* const table,
+	const primec_type_t return_type,
+	const primec_type_t* const params,
+	const uint32_t params_count,
+	const bool is_variadic);
+
+/**
+ * @brief Get the struct type of the declaration at provided node of the file.
+ * 
+ * @note Structs are nominal, so they are identified by their declarations, and
+ * their fields are set later (see @ref primec_type_table_set_fields()), which
+ * allows the fields to refer to the struct itself.
+ */
+primec_type_t primec_type_table_get_struct(
+	primec_type_table_s* const table,
+	const uint32_t file,
+	const uint32_t node,
+	const char* const name);
+
+/**
+ * @brief Set the field types of a struct type (only once).
+ */
+void primec_type_table_set_fields(
+	primec_type_table_s* const table,
+	const primec_type_t type,
+	const primec_type_t* const fields,
+	const uint32_t fields_count);
+
+/**
+ * @brief Let the fields of a struct type be laid out by their alignments,
+ * instead of their declared order (see @ref primec_layout_reorder_structs()).
+ */
+void primec_type_table_set_reordered(
+	primec_type_table_s* const table,
+	const primec_type_t type);
+
+/**
+ * @brief Get the enum type of the declaration at provided node of the file.
+ */
+primec_type_t primec_type_table_get_enum(
+	primec_type_table_s* const table,
+	const uint32_t file,
+	const uint32_t node,
+	const char* const name,
+	const primec_type_t underlying);
+
+bool primec_type_is_integer(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+bool primec_type_is_signed(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+bool primec_type_is_float(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+/**
+ * @brief Format provided type as it would be written in the source code.
+ * 
+ * @note The type is written to provided buffer, which is also returned.
+ */
+const char* primec_type_table_format(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	char* const buffer,
+	const uint64_t capacity);
+
+#endif
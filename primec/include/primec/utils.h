@@ -35,6 +35,11 @@ void primec_utils_memcpy(
 	const void* const source,
 	const uint64_t length);
 
+int32_t primec_utils_memcmp(
+	const void* const left,
+	const void* const right,
+	const uint64_t length);
+
 char* primec_utils_strdup(
 	const char* const string);
 
@@ -57,4 +62,8 @@ void* primec_utils_bsearch(
 	const uint64_t member_size,
 	int32_t(*compare)(const void*, const void*));
 
+uint64_t primec_utils_hash(
+	const void* const data,
+	const uint64_t length);
+
 #endif
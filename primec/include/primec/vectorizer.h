@@ -0,0 +1,32 @@
+
+/**
+ * @file vectorizer.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__vectorizer_h__
+#define __primec__include__primec__vectorizer_h__
+
+#include <primec/ir.h>
+
+/**
+ * @brief Vectorize the counted loops of every function.
+ * 
+ * @note Loops of a header and a single body block, that count up by one to an
+ * invariant limit, and only load, compute and store the elements of arrays
+ * and slices at the counter, are given a vector loop of 16 bytes wide steps in
+ * front of them, guarded by the trip count and by the runtime checks, that
+ * the stored memory does not overlap the other accessed memory. The original
+ * loop runs the remainder. Integer sums and bitwise reductions are carried in
+ * vectors too. Slots should be promoted and the checks removed first.
+ */
+void primec_vectorizer_run(
+	primec_ir_program_s* const program);
+
+#endif
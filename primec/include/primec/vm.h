@@ -0,0 +1,35 @@
+
+/**
+ * @file vm.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__vm_h__
+#define __primec__include__primec__vm_h__
+
+#include <primec/bytecode.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Run the entry function of the compiled module in the current process.
+ * 
+ * @note The result of the entry function (or 0, if it returns nothing) is
+ * written to provided status. Traps (failed bounds checks, divisions by zero,
+ * unreachable code and stack overflows) stop the run and are reported.
+ * 
+ * @return True if the entry function returned.
+ */
+bool primec_vm_run(
+	const primec_bytecode_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status);
+
+#endif
@@ -0,0 +1,378 @@
+
+/**
+ * @file x86_64.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__x86_64_h__
+#define __primec__include__primec__x86_64_h__
+
+#include <primec/ir.h>
+#include <primec/thread_pool.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Register of the machine.
+ * 
+ * @note The general purpose registers are numbered as they are encoded, and
+ * the xmm registers follow them. Registers from primec_x86_64_vregs_start up
+ * are virtual, they are replaced by the machine ones by the register allocator.
+ */
+typedef enum
+{
+	primec_x86_64_reg_rax,
+	primec_x86_64_reg_rcx,
+	primec_x86_64_reg_rdx,
+	primec_x86_64_reg_rbx,
+	primec_x86_64_reg_rsp,
+	primec_x86_64_reg_rbp,
+	primec_x86_64_reg_rsi,
+	primec_x86_64_reg_rdi,
+	primec_x86_64_reg_r8,
+	primec_x86_64_reg_r9,
+	primec_x86_64_reg_r10,
+	primec_x86_64_reg_r11,
+	primec_x86_64_reg_r12,
+	primec_x86_64_reg_r13,
+	primec_x86_64_reg_r14,
+	primec_x86_64_reg_r15,
+	primec_x86_64_reg_xmm0,
+	primec_x86_64_reg_xmm1,
+	primec_x86_64_reg_xmm2,
+	primec_x86_64_reg_xmm3,
+	primec_x86_64_reg_xmm4,
+	primec_x86_64_reg_xmm5,
+	primec_x86_64_reg_xmm6,
+	primec_x86_64_reg_xmm7,
+	primec_x86_64_reg_xmm8,
+	primec_x86_64_reg_xmm9,
+	primec_x86_64_reg_xmm10,
+	primec_x86_64_reg_xmm11,
+	primec_x86_64_reg_xmm12,
+	primec_x86_64_reg_xmm13,
+	primec_x86_64_reg_xmm14,
+	primec_x86_64_reg_xmm15,
+	primec_x86_64_regs_count,
+
+	// NOTE: Base of the rip relative memory operands.
+	primec_x86_64_reg_rip = primec_x86_64_regs_count,
+	primec_x86_64_vregs_start = 64
+} primec_x86_64_reg_e;
+
+_Static_assert(primec_x86_64_regs_count == 32, "register masks must fit 32 bits");
+
+typedef enum
+{
+	primec_x86_64_class_gpr,
+	primec_x86_64_class_xmm,
+	primec_x86_64_classes_count
+} primec_x86_64_class_e;
+
+/**
+ * @brief Condition code, numbered as it is encoded.
+ */
+typedef enum
+{
+	primec_x86_64_cond_o,
+	primec_x86_64_cond_no,
+	primec_x86_64_cond_b,
+	primec_x86_64_cond_ae,
+	primec_x86_64_cond_e,
+	primec_x86_64_cond_ne,
+	primec_x86_64_cond_be,
+	primec_x86_64_cond_a,
+	primec_x86_64_cond_s,
+	primec_x86_64_cond_ns,
+	primec_x86_64_cond_p,
+	primec_x86_64_cond_np,
+	primec_x86_64_cond_l,
+	primec_x86_64_cond_ge,
+	primec_x86_64_cond_le,
+	primec_x86_64_cond_g,
+	primec_x86_64_conds_count
+} primec_x86_64_condition_e;
+
+/**
+ * @brief Operation of a machine instruction.
+ * 
+ * @note The size of an instruction is the size of its operation, the source
+ * size is the size of the source operand of the extensions and conversions.
+ * The packed operations take the size of their lanes, and always operate on
+ * the whole xmm registers. Instructions with two operands are written as
+ * destination, source.
+ */
+typedef enum
+{
+	primec_x86_64_op_label,			// 0: block that starts here
+	primec_x86_64_op_prologue,		// expanded to the frame setup once the frame is known
+	primec_x86_64_op_mov,
+	primec_x86_64_op_movzx,
+	primec_x86_64_op_movsx,
+	primec_x86_64_op_lea,
+	primec_x86_64_op_add,
+	primec_x86_64_op_sub,
+	primec_x86_64_op_and,
+	primec_x86_64_op_or,
+	primec_x86_64_op_xor,
+	primec_x86_64_op_cmp,
+	primec_x86_64_op_test,
+	primec_x86_64_op_imul,			// with an immediate source: three operand form over the destination
+	primec_x86_64_op_neg,
+	primec_x86_64_op_not,
+	primec_x86_64_op_shl,			// source: immediate or rcx
+	primec_x86_64_op_shr,
+	primec_x86_64_op_sar,
+	primec_x86_64_op_cqo,			// cdq or cqo by the size
+	primec_x86_64_op_div,
+	primec_x86_64_op_idiv,
+	primec_x86_64_op_setcc,
+	primec_x86_64_op_jmp,			// 0: block
+	primec_x86_64_op_jcc,			// 0: block
+	primec_x86_64_op_call,			// 0: symbol or register
+	primec_x86_64_op_ret,			// expanded to the frame teardown and return
+	primec_x86_64_op_tail,			// 0: symbol or register, expanded to the frame teardown and jump
+	primec_x86_64_op_ud2,
+	primec_x86_64_op_rep_movsb,
+	primec_x86_64_op_rep_stosb,
+	primec_x86_64_op_movf,			// movss, movsd or movups by the size (4, 8 or 16)
+	primec_x86_64_op_movq,			// movd or movq between the register classes
+	primec_x86_64_op_zerof,			// xorps of the register with itself
+	primec_x86_64_op_addf,
+	primec_x86_64_op_subf,
+	primec_x86_64_op_mulf,
+	primec_x86_64_op_divf,
+	primec_x86_64_op_ucomif,
+	primec_x86_64_op_cvtsi2f,
+	primec_x86_64_op_cvtf2si,		// truncating
+	primec_x86_64_op_cvtf2f,
+	primec_x86_64_op_addp,			// addps or addpd by the size of the lanes
+	primec_x86_64_op_subp,
+	primec_x86_64_op_mulp,
+	primec_x86_64_op_divp,
+	primec_x86_64_op_padd,			// paddb, paddw, paddd or paddq by the size of the lanes
+	primec_x86_64_op_psub,
+	primec_x86_64_op_pmullw,
+	primec_x86_64_op_pand,
+	primec_x86_64_op_por,
+	primec_x86_64_op_pxor,
+	primec_x86_64_op_psrldq,		// source: immediate count of the bytes
+	primec_x86_64_op_punpcklqdq,
+	primec_x86_64_ops_count
+} primec_x86_64_op_e;
+
+typedef enum
+{
+	primec_x86_64_op_flag_reads = 1 << 0,	// reads its destination
+	primec_x86_64_op_flag_writes = 1 << 1,	// writes its destination
+} primec_x86_64_op_flag_e;
+
+/**
+ * @brief Get the flags of provided op.
+ */
+uint32_t primec_x86_64_op_get_flags(
+	const primec_x86_64_op_e op);
+
+typedef enum
+{
+	primec_x86_64_operand_none,
+	primec_x86_64_operand_reg,
+	primec_x86_64_operand_imm,
+	primec_x86_64_operand_mem,		// [reg + index * scale + value], or [rip + symbol + value]
+	primec_x86_64_operand_block,	// value: block of the function
+	primec_x86_64_operand_symbol,	// address of the symbol
+} primec_x86_64_operand_kind_e;
+
+typedef enum
+{
+	primec_x86_64_symbol_func,
+	primec_x86_64_symbol_global,
+	primec_x86_64_symbol_string,
+} primec_x86_64_symbol_kind_e;
+
+typedef struct
+{
+	uint8_t kind;
+	uint8_t symbol_kind;
+	uint8_t scale;		// 0 if the memory operand has no index
+	uint8_t reserved;
+	uint32_t reg;
+	uint32_t index;
+	uint32_t symbol;
+	int64_t value;
+} primec_x86_64_operand_s;
+
+/**
+ * @brief Machine instruction.
+ * 
+ * @note The masks list the machine registers, that are read and written by the
+ * instruction without being its operands (arguments and clobbers of calls, the
+ * implicit registers of divisions and string operations).
+ */
+typedef struct
+{
+	uint8_t op;
+	uint8_t size;
+	uint8_t source_size;
+	uint8_t cond;
+	uint32_t uses;
+	uint32_t defs;
+	primec_x86_64_operand_s operands[2];
+} primec_x86_64_instruction_s;
+
+typedef enum
+{
+	primec_x86_64_relocation_pc32,		// S + A - P, of the rip relative operands
+	primec_x86_64_relocation_plt32,		// S + A - P, of the calls
+	primec_x86_64_relocation_64,		// S + A
+} primec_x86_64_relocation_e;
+
+/**
+ * @brief Reference of the encoded code (or data) to a symbol.
+ */
+typedef struct
+{
+	uint64_t offset;
+	uint8_t type;
+	uint8_t symbol_kind;
+	uint16_t reserved;
+	uint32_t symbol;
+	int64_t addend;
+} primec_x86_64_relocation_s;
+
+/**
+ * @brief Machine code of a function.
+ * 
+ * @note The frame holds the slots and the spilled registers below the frame
+ * pointer, then the saved callee-saved registers, and the outgoing stack
+ * arguments at its bottom. The frame size is the size of the whole frame once
+ * the function is generated.
+ */
+typedef struct
+{
+	uint32_t index;
+
+	struct
+	{
+		primec_x86_64_instruction_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} code;
+
+	struct
+	{
+		uint8_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} vregs;
+
+	uint32_t blocks_count;
+	uint32_t frame_size;
+	uint32_t outgoing_size;
+	uint32_t saved;
+	uint32_t saved_offset;
+
+	struct
+	{
+		uint8_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} bytes;
+
+	struct
+	{
+		primec_x86_64_relocation_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} relocations;
+} primec_x86_64_func_s;
+
+/**
+ * @brief Machine code of the whole program.
+ */
+typedef struct
+{
+	const primec_ir_program_s* program;
+	primec_x86_64_func_s* funcs;
+
+	// NOTE: Unique assembler names of the functions and globals.
+	char** func_names;
+	char** global_names;
+} primec_x86_64_module_s;
+
+/**
+ * @brief Generate the machine code of every function of the program.
+ * 
+ * @note Every function is selected and allocated as a separate task of the
+ * pool. The code follows the System V x86-64 abi, with aggregates passed and
+ * returned by pointers, so C functions, that take or return structs by value,
+ * cannot be called directly.
+ */
+primec_x86_64_module_s* primec_x86_64_generate(
+	const primec_ir_program_s* const program,
+	primec_thread_pool_s* const pool);
+
+/**
+ * @brief Destroy the machine code of the program.
+ */
+void primec_x86_64_destroy(
+	primec_x86_64_module_s* const module);
+
+/**
+ * @brief Find the function, that is named by provided entry symbol.
+ * 
+ * @note The roots are checked last, so their functions win over the functions
+ * of their dependencies with the same name.
+ * 
+ * @return Index of the function, or UINT32_MAX if there is none.
+ */
+uint32_t primec_x86_64_find_entry(
+	const primec_ir_program_s* const program,
+	const char* const entry);
+
+/**
+ * @brief Check if the functions of the module call the external functions.
+ * 
+ * @note The programs, that do not, need no C library, so their _start symbols
+ * exit by the system call.
+ */
+bool primec_x86_64_calls_externs(
+	const primec_x86_64_module_s* const module);
+
+/**
+ * @brief Write the module as GNU assembly (in the intel syntax).
+ * 
+ * @note If the entry is not UINT32_MAX, the _start symbol calls the entry
+ * function and exits the process with its result, by the exit function of the
+ * C library if the module calls the external functions (see
+ * @ref primec_x86_64_calls_externs()). Functions and globals are
+ * global symbols (the lambdas are local), like in the objects.
+ */
+void primec_x86_64_write_assembly(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	FILE* const file);
+
+/**
+ * @brief Link the module into an executable at provided path.
+ * 
+ * @note Modules, that call no external functions, are written as static
+ * executables. The other ones are written as dynamic executables, that import
+ * their external functions from the C library.
+ * 
+ * @return True if the executable was written.
+ */
+bool primec_x86_64_link(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const output);
+
+#endif
@@ -0,0 +1,28 @@
+
+/**
+ * @file x86_64_encoder.h
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#ifndef __primec__include__primec__x86_64_encoder_h__
+#define __primec__include__primec__x86_64_encoder_h__
+
+#include <primec/x86_64.h>
+
+/**
+ * @brief Encode the allocated machine code of the function into its bytes.
+ * 
+ * @note Jumps are resolved within the function (and shortened when their
+ * targets are near), while the references to the functions, globals and
+ * strings are left as relocations.
+ */
+void primec_x86_64_encode(
+	primec_x86_64_func_s* const func);
+
+#endif
@@ -16,13 +16,49 @@ SOURCES="
 	$PROJECT_DIR/source/primec/debug.c
 	$PROJECT_DIR/source/primec/logger.c
 	$PROJECT_DIR/source/primec/utils.c
+	$PROJECT_DIR/source/primec/diagnostics.c
 	$PROJECT_DIR/source/primec/utf8.c
+	$PROJECT_DIR/source/primec/thread_pool.c
+	$PROJECT_DIR/source/primec/source_manager.c
 	$PROJECT_DIR/source/primec/token.c
 	$PROJECT_DIR/source/primec/lexer.c
+	$PROJECT_DIR/source/primec/ast.c
+	$PROJECT_DIR/source/primec/type_table.c
+	$PROJECT_DIR/source/primec/const_eval.c
+	$PROJECT_DIR/source/primec/symbols.c
+	$PROJECT_DIR/source/primec/parser.c
+	$PROJECT_DIR/source/primec/build_graph.c
+	$PROJECT_DIR/source/primec/runtime.c
+	$PROJECT_DIR/source/primec/resolver.c
+	$PROJECT_DIR/source/primec/sema.c
+	$PROJECT_DIR/source/primec/ir.c
+	$PROJECT_DIR/source/primec/ir_builder.c
+	$PROJECT_DIR/source/primec/inliner.c
+	$PROJECT_DIR/source/primec/cfg.c
+	$PROJECT_DIR/source/primec/promote.c
+	$PROJECT_DIR/source/primec/tailcall.c
+	$PROJECT_DIR/source/primec/sccp.c
+	$PROJECT_DIR/source/primec/gvn.c
+	$PROJECT_DIR/source/primec/dce.c
+	$PROJECT_DIR/source/primec/bounds.c
+	$PROJECT_DIR/source/primec/licm.c
+	$PROJECT_DIR/source/primec/vectorizer.c
+	$PROJECT_DIR/source/primec/optimizer.c
+	$PROJECT_DIR/source/primec/layout.c
+	$PROJECT_DIR/source/primec/regalloc.c
+	$PROJECT_DIR/source/primec/string_pool.c
+	$PROJECT_DIR/source/primec/x86_64.c
+	$PROJECT_DIR/source/primec/x86_64_encoder.c
+	$PROJECT_DIR/source/primec/elf.c
+	$PROJECT_DIR/source/primec/bytecode.c
+	$PROJECT_DIR/source/primec/vm.c
+	$PROJECT_DIR/source/primec/jit.c
 	$PROJECT_DIR/source/main.c
 "
 
 LIBRARIES="
+	-lpthread
+	-ldl
 "
 
 # --------------------------------------------------------------------------- #
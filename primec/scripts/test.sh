@@ -1,4 +1,153 @@
 
 # !/bin/sh
 
-# TODO: implement!
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )"
+PROJECT_DIR="$SCRIPT_DIR/.."
+
+# --------------------------------------------------------------------------- #
+
+# Every test is a program in a directory of the tests, whose comments state what
+# is expected of it:
+#   // flags: -L              extra options of the compiler
+#   // expect: 42             exit code of the program, or `trap` for the runtime
+#                             errors (0 by default)
+#   // expect-stdout: text    line of the output of the program, the whole output
+#                             is compared, when any line is stated
+#   // expect-error: text     text of a diagnostic, the compilation must fail
+#   // expect-log: text       text of the output of the compiler
+# It is compiled at every optimization level and run by the interpreter, the JIT
+# and as an executable. The modules used by the tests live in the directories of
+# the tests directories, so they are not run themselves.
+TESTS_DIRS="front opt back"
+LEVELS="0 1 2"
+MODES="run jit native"
+
+# --------------------------------------------------------------------------- #
+
+COMPILER=${1:-"$PROJECT_DIR/build/primec"}
+
+if [ ! -x "$COMPILER" ]; then
+	echo "[error]: compiler '$COMPILER' not found. Please run './scripts/build.sh' first."
+	exit 1
+fi
+
+OUTPUT_DIR="$(mktemp -d)"
+trap 'rm -fr "$OUTPUT_DIR"' EXIT
+
+PASSED=0
+FAILED=0
+
+# Remove the colors of the diagnostics
+strip() {
+	sed 's/\x1b\[[0-9;]*m//g' "$1"
+}
+
+# Check that every line of the first file is a part of the second file
+contains_all() {
+	while IFS= read -r LINE; do
+		strip "$2" | grep -qF -- "$LINE" || { echo "$LINE"; return 1; }
+	done < "$1"
+	return 0
+}
+
+for DIR in $TESTS_DIRS; do
+	for TEST in "$PROJECT_DIR/tests/$DIR"/*.prm; do
+		[ -f "$TEST" ] || continue
+		NAME="$DIR/$(basename "$TEST" .prm)"
+		BINARY="$OUTPUT_DIR/binary"
+
+		EXPECTED="$(sed -n 's|^// expect: *||p' "$TEST" | head -n 1)"
+		FLAGS="$(sed -n 's|^// flags: *||p' "$TEST" | head -n 1)"
+		sed -n 's|^// expect-stdout: \{0,1\}||p' "$TEST" > "$OUTPUT_DIR/expected_stdout"
+		sed -n 's|^// expect-error: *||p' "$TEST" > "$OUTPUT_DIR/expected_errors"
+		sed -n 's|^// expect-log: *||p' "$TEST" > "$OUTPUT_DIR/expected_logs"
+		IS_CHECKING_STDOUT=$(grep -c '^// expect-stdout:' "$TEST")
+
+		if [ -z "$EXPECTED" ]; then
+			EXPECTED=0
+		fi
+
+		for LEVEL in $LEVELS; do
+			for MODE in $MODES; do
+				# NOTE: The signals, that kill the programs, are reported by the shell,
+				#       so its errors are silenced too.
+				COMPILED=0
+
+				case $MODE in
+					"run")
+						{ timeout 60 "$COMPILER" -O$LEVEL $FLAGS -r "$TEST"; } > "$OUTPUT_DIR/stdout" 2> "$OUTPUT_DIR/stderr"
+						ACTUAL=$?
+						cat "$OUTPUT_DIR/stdout" "$OUTPUT_DIR/stderr" > "$OUTPUT_DIR/log"
+						;;
+					"jit")
+						{ timeout 60 "$COMPILER" -O$LEVEL $FLAGS -J "$TEST"; } > "$OUTPUT_DIR/stdout" 2> "$OUTPUT_DIR/stderr"
+						ACTUAL=$?
+						cat "$OUTPUT_DIR/stdout" "$OUTPUT_DIR/stderr" > "$OUTPUT_DIR/log"
+						;;
+					"native")
+						rm -f "$BINARY"
+						"$COMPILER" -O$LEVEL $FLAGS -o "$BINARY" "$TEST" > "$OUTPUT_DIR/log" 2>&1
+						ACTUAL=$?
+						COMPILED=$ACTUAL
+
+						if [ $COMPILED -eq 0 ]; then
+							{ timeout 60 "$BINARY"; } > "$OUTPUT_DIR/stdout" 2> /dev/null
+							ACTUAL=$?
+						fi
+						;;
+				esac
+
+				FAILURE=""
+
+				if [ -s "$OUTPUT_DIR/expected_errors" ]; then
+					# NOTE: The interpreter and the JIT fail with the status 255, like
+					#       the compilation of the executables.
+					if [ "$ACTUAL" = "0" ]; then
+						FAILURE="the compilation succeeded"
+					elif ! MISSING="$(contains_all "$OUTPUT_DIR/expected_errors" "$OUTPUT_DIR/log")"; then
+						FAILURE="missing diagnostic: $MISSING"
+					fi
+				elif [ "$MODE" = "native" ] && [ $COMPILED -ne 0 ]; then
+					FAILURE="the compilation failed: $(strip "$OUTPUT_DIR/log" | head -n 1)"
+				else
+					# NOTE: The interpreter reports the runtime errors with the status 255,
+					#       while the native code is killed by a signal.
+					if [ "$EXPECTED" = "trap" ]; then
+						case $MODE in
+							"run") [ "$ACTUAL" = "255" ] || FAILURE="expected a trap, actual: $ACTUAL" ;;
+							*) { [ "$ACTUAL" -gt 128 ] && [ "$ACTUAL" -lt 255 ]; } || FAILURE="expected a trap, actual: $ACTUAL" ;;
+						esac
+					elif [ "$ACTUAL" != "$EXPECTED" ]; then
+						FAILURE="expected: $EXPECTED, actual: $ACTUAL"
+					fi
+
+					if [ -z "$FAILURE" ] && [ "$IS_CHECKING_STDOUT" -gt 0 ] &&
+						! cmp -s "$OUTPUT_DIR/expected_stdout" "$OUTPUT_DIR/stdout"; then
+						FAILURE="unexpected output: $(head -c 200 "$OUTPUT_DIR/stdout" | tr '\n' '|')"
+					fi
+
+					# NOTE: Only the compilations of the executables have their logs
+					#       apart from the outputs of the programs.
+					if [ -z "$FAILURE" ] && [ "$MODE" = "native" ] && [ -s "$OUTPUT_DIR/expected_logs" ] &&
+						! MISSING="$(contains_all "$OUTPUT_DIR/expected_logs" "$OUTPUT_DIR/log")"; then
+						FAILURE="missing log: $MISSING"
+					fi
+				fi
+
+				if [ -z "$FAILURE" ]; then
+					PASSED=$((PASSED + 1))
+				else
+					echo "[error]: test '$NAME' failed at -O$LEVEL ($MODE) - $FAILURE."
+					FAILED=$((FAILED + 1))
+				fi
+			done
+		done
+	done
+done
+
+if [ $FAILED -eq 0 ]; then
+	echo "[info]: all $PASSED tests passed."
+else
+	echo "[error]: $FAILED of $((PASSED + FAILED)) tests failed."
+	exit 1
+fi
@@ -15,16 +15,25 @@
 #include <primec/version.h>
 #include <primec/debug.h>
 #include <primec/logger.h>
-#include <primec/token.h>
-#include <primec/lexer.h>
+#include <primec/ast.h>
+#include <primec/thread_pool.h>
+#include <primec/build_graph.h>
+#include <primec/runtime.h>
+#include <primec/sema.h>
+#include <primec/ir_builder.h>
+#include <primec/layout.h>
+#include <primec/optimizer.h>
+#include <primec/x86_64.h>
+#include <primec/elf.h>
+#include <primec/bytecode.h>
+#include <primec/vm.h>
+#include <primec/jit.h>
+#include <primec/source_manager.h>
 
 #include <stddef.h>
-#include <string.h>
-#include <errno.h>
+#include <stdlib.h>
 #include <stdio.h>
 
-#include <sys/stat.h>
-#include <unistd.h>
 #include <getopt.h>
 
 static const char* const g_usage_banner =
@@ -35,21 +44,48 @@ static const char* const g_usage_banner =
 	"    -v, --version              print version and exit\n"
 	"    -e, --entry <symbol>       set the entry symbol\n"
 	"    -o, --output <path>        set output file name\n"
+	"    -c, --compile              write an object instead of an executable (the entry is optional)\n"
+	"    -S, --assembly             write the assembly instead of an executable (the entry is optional)\n"
+	"    -r, --run                  run the entry function in the compiler process\n"
+	"    -J, --jit                  run the native code of the entry function in the compiler process\n"
+	"    -j, --jobs <count>         set number of threads (default: processors count)\n"
+	"    -O, --optimize <level>     set the optimization level from 0 to 2 (default: 2)\n"
+	"    -R, --reorder-fields       reorder the fields of the structs to minimize their padding\n"
+	"    -L, --layouts              print the layouts of the structs with their padding bytes\n"
+	"    -D, --dump                 print the ast of every source file and the optimized ir\n"
 	"\n"
 	"notice:\n"
 	"    this executable is distributed under the \"prime gplv1\" license.\n";
 
+typedef enum
+{
+	emit_executable,
+	emit_object,
+	emit_assembly,
+	emit_run,
+	emit_jit,
+} emit_e;
+
 static void usage(
 	const char* const program);
 
+static bool emit(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const emit_e kind,
+	const char* const output);
+
 static int32_t parse_command_line(
 	const int32_t argc,
 	const char** const argv,
 	const char** const entry,
-	const char** const output);
-
-static FILE* validate_and_open_file_for_reading(
-	const char* const file_path);
+	const char** const output,
+	emit_e* const kind,
+	uint32_t* const jobs,
+	primec_optimizer_level_e* const level,
+	bool* const is_reordering,
+	bool* const is_reporting,
+	bool* const is_dumping);
 
 int32_t main(
 	const int32_t argc,
@@ -57,8 +93,17 @@ int32_t main(
 {
 	const char* entry = "main";
 	const char* output = NULL;
+	emit_e kind = emit_executable;
+	uint32_t jobs = primec_thread_pool_get_processors_count();
+	primec_optimizer_level_e level = primec_optimizer_level_full;
+	bool is_reordering = false;
+	bool is_reporting = false;
+	bool is_dumping = false;
+
+	const int32_t options_index = parse_command_line(argc, argv, &entry, &output, &kind, &jobs, &level, &is_reordering, &is_reporting,
+		&is_dumping
+	);
 
-	const int32_t options_index = parse_command_line(argc, argv, &entry, &output);
 	if (options_index <= 0) { return options_index; }
 
 	const char** const source_files = argv + (uint64_t)options_index;
@@ -70,32 +115,90 @@ int32_t main(
 		return -1;
 	}
 
+	primec_thread_pool_s* const pool = primec_thread_pool_create(jobs - 1);
+
+	primec_build_graph_s* const graph = primec_build_graph_create(pool);
+	primec_runtime_add(graph);
+
 	for (uint64_t index = 0; index < source_files_count; ++index)
 	{
-		const char* const source_file_path = source_files[index];
-		primec_debug_assert(source_file_path != NULL);
+		primec_debug_assert(source_files[index] != NULL);
+		(void)primec_build_graph_add_root(graph, source_files[index]);
+	}
+
+	primec_build_graph_load(graph);
 
-		const uint64_t source_file_path_length = strlen(source_file_path);
-		primec_debug_assert(source_file_path_length > 0);
+	// NOTE: The runtime is built with every program, so its ast is left out.
+	for (uint32_t index = 0; is_dumping && index < graph->order.count; ++index)
+	{
+		if (graph->order.data[index] == graph->runtime) { continue; }
+		primec_ast_dump(&graph->modules.data[graph->order.data[index]]->ast);
+	}
 
-		FILE* const source_file = validate_and_open_file_for_reading(source_file_path);
-		if (!source_file) { continue; }
+	primec_sema_s* const sema = primec_sema_create(graph);
+	primec_sema_check(sema);
 
-		primec_lexer_s lexer = primec_lexer_from_parts(
-			source_file_path, source_file
-		);
+	primec_ir_program_s* const program = primec_ir_build(sema);
+	if (is_reordering) { primec_layout_reorder_structs(program->types, program); }
+	if (is_reporting) { primec_layout_report(program->types); }
 
-		primec_token_s token = primec_token_from_type(primec_token_type_none);
-		while (!primec_lexer_should_stop_lexing(primec_lexer_lex(&lexer, &token)))
+	// NOTE: The bytecode vm has no vector instructions, so the interpreted
+	//       programs stay scalar.
+	primec_optimizer_run(program, graph, level, kind != emit_run);
+	if (is_dumping) { primec_ir_dump(program); }
+
+	// NOTE: The objects and the assembly without the entry function are the
+	//       libraries, which have no _start symbol.
+	const uint32_t entry_index = primec_x86_64_find_entry(program, entry);
+
+	if (UINT32_MAX == entry_index && kind != emit_object && kind != emit_assembly)
+	{
+		primec_logger_error("entry function `%s` is not defined.", entry);
+		primec_ir_program_destroy(program);
+		primec_sema_destroy(sema);
+		primec_build_graph_destroy(graph);
+		primec_thread_pool_destroy(pool);
+		primec_source_manager_destroy();
+		return -1;
+	}
+
+	int32_t status = -1;
+
+	if (emit_run == kind)
+	{
+		primec_bytecode_module_s* const module = primec_bytecode_compile(program);
+
+		if (module != NULL)
 		{
-			primec_logger_log("%s", primec_token_to_string(&token));
-			primec_token_destroy(&token);
+			int32_t result = 0;
+			if (primec_vm_run(module, entry_index, &result)) { status = result; }
+			primec_bytecode_destroy(module);
+		}
+	}
+	else
+	{
+		primec_x86_64_module_s* const module = primec_x86_64_generate(program, pool);
+
+		if (emit_jit == kind)
+		{
+			int32_t result = 0;
+			if (primec_jit_run(module, entry_index, &result)) { status = result; }
+		}
+		else
+		{
+			status = emit(module, entry_index, kind, output) ? 0 : -1;
 		}
 
-		(void)fclose(source_file);
+		primec_x86_64_destroy(module);
 	}
 
-	return 0;
+	primec_ir_program_destroy(program);
+	primec_sema_destroy(sema);
+
+	primec_build_graph_destroy(graph);
+	primec_thread_pool_destroy(pool);
+	primec_source_manager_destroy();
+	return status;
 }
 
 static void usage(
@@ -105,15 +208,72 @@ static void usage(
 	primec_logger_log(g_usage_banner, program);
 }
 
+static bool emit(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const emit_e kind,
+	const char* const output)
+{
+	primec_debug_assert(module != NULL);
+
+	switch (kind)
+	{
+		case emit_executable:
+		{
+			return primec_x86_64_link(module, entry, NULL == output ? "a.out" : output);
+		} break;
+
+		case emit_object:
+		{
+			return primec_elf_write_object(module, entry, NULL == output ? "a.o" : output);
+		} break;
+
+		case emit_assembly:
+		{
+			const char* const path = NULL == output ? "a.s" : output;
+			FILE* const file = fopen(path, "w");
+
+			if (NULL == file)
+			{
+				primec_logger_error("failed to open the output file '%s'.", path);
+				return false;
+			}
+
+			primec_x86_64_write_assembly(module, entry, file);
+			return 0 == fclose(file);
+		} break;
+
+		case emit_run:
+		case emit_jit:
+		{
+			primec_logger_panic("internal failure -- runs are not emitted.");
+		} break;
+	}
+
+	return false;
+}
+
 static int32_t parse_command_line(
 	const int32_t argc,
 	const char** const argv,
 	const char** const entry,
-	const char** const output)
+	const char** const output,
+	emit_e* const kind,
+	uint32_t* const jobs,
+	primec_optimizer_level_e* const level,
+	bool* const is_reordering,
+	bool* const is_reporting,
+	bool* const is_dumping)
 {
 	primec_debug_assert(argv != NULL);
 	primec_debug_assert(entry != NULL);
 	primec_debug_assert(output != NULL);
+	primec_debug_assert(kind != NULL);
+	primec_debug_assert(jobs != NULL);
+	primec_debug_assert(level != NULL);
+	primec_debug_assert(is_reordering != NULL);
+	primec_debug_assert(is_reporting != NULL);
+	primec_debug_assert(is_dumping != NULL);
 
 	typedef struct option option_s;
 	static const option_s options[] =
@@ -122,11 +282,20 @@ static int32_t parse_command_line(
 		{ "version", no_argument, 0, 'v' },
 		{ "entry", required_argument, 0, 'e' },
 		{ "output", required_argument, 0, 'o' },
+		{ "compile", no_argument, 0, 'c' },
+		{ "assembly", no_argument, 0, 'S' },
+		{ "run", no_argument, 0, 'r' },
+		{ "jit", no_argument, 0, 'J' },
+		{ "jobs", required_argument, 0, 'j' },
+		{ "optimize", required_argument, 0, 'O' },
+		{ "reorder-fields", no_argument, 0, 'R' },
+		{ "layouts", no_argument, 0, 'L' },
+		{ "dump", no_argument, 0, 'D' },
 		{ 0, 0, 0, 0 }
 	};
 
 	int32_t opt = -1;
-	while ((opt = (int32_t)getopt_long(argc, (char* const *)argv, "hve:o:", options, NULL)) != -1)
+	while ((opt = (int32_t)getopt_long(argc, (char* const *)argv, "hve:o:cSrJj:O:RLD", options, NULL)) != -1)
 	{
 		switch (opt)
 		{
@@ -152,64 +321,76 @@ static int32_t parse_command_line(
 				*output = (const char*)optarg;
 			} break;
 
-			default:
+			case 'c':
 			{
-				primec_logger_error("invalid command line option -- see '--help'.");
-				return -1;
+				*kind = emit_object;
 			} break;
-		}
-	}
-
-	return (int32_t)optind;
-}
 
-static FILE* validate_and_open_file_for_reading(
-	const char* const file_path)
-{
-	typedef struct stat file_stats_s;
-	file_stats_s file_stats = {0};
+			case 'S':
+			{
+				*kind = emit_assembly;
+			} break;
 
-	if (stat(file_path, &file_stats) != 0)
-	{
-		switch (errno)
-		{
-			case ENOENT:
+			case 'r':
 			{
-				primec_logger_error("unable to open %s for reading -- file not found.", file_path);
+				*kind = emit_run;
 			} break;
 
-			case EACCES:
+			case 'J':
 			{
-				primec_logger_error("unable to open %s for reading -- permission denied.", file_path);
+				*kind = emit_jit;
 			} break;
 
-			case ENAMETOOLONG:
+			case 'j':
 			{
-				primec_logger_error("unable to open %s for reading -- path name exceeds the system-defined maximum length.", file_path);
+				char* end = NULL;
+				const unsigned long count = strtoul(optarg, &end, 10);
+
+				if (end == optarg || *end != '\0' || count < 1 || count > 1024)
+				{
+					primec_logger_error("invalid jobs count '%s' -- expected a number from 1 to 1024.", optarg);
+					return -1;
+				}
+
+				*jobs = (uint32_t)count;
 			} break;
 
-			default:
+			case 'O':
 			{
-				primec_logger_error("unable to open %s for reading -- failed to stat.", file_path);
+				char* end = NULL;
+				const unsigned long value = strtoul(optarg, &end, 10);
+
+				if (end == optarg || *end != '\0' || value >= primec_optimizer_levels_count)
+				{
+					primec_logger_error("invalid optimization level '%s' -- expected a number from 0 to 2.", optarg);
+					return -1;
+				}
+
+				*level = (primec_optimizer_level_e)value;
 			} break;
-		}
 
-		return NULL;
-	}
+			case 'R':
+			{
+				*is_reordering = true;
+			} break;
 
-	if (S_ISDIR(file_stats.st_mode))
-	{
-		primec_logger_error("unable to open %s for reading -- it is a directory.", file_path);
-		return NULL;
-	}
+			case 'L':
+			{
+				*is_reporting = true;
+			} break;
 
-	FILE* const file = fopen(file_path, "rt");
+			case 'D':
+			{
+				*is_dumping = true;
+			} break;
 
-	if (NULL == file)
-	{
-		primec_logger_error("unable to open %s for reading -- failed to open.", file_path);
-		return NULL;
+			default:
+			{
+				primec_logger_error("invalid command line option -- see '--help'.");
+				return -1;
+			} break;
+		}
 	}
 
-	return file;
+	return (int32_t)optind;
 }
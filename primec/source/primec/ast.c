@@ -0,0 +1,831 @@
+
+/**
+ * @file ast.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/ast.h>
+
+#include <primec/source_manager.h>
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+static const char* const g_ast_kind_to_string_map[] =
+{
+	[primec_ast_kind_null] = "null",
+
+	[primec_ast_kind_module] = "module",
+	[primec_ast_kind_func_decl] = "func_decl",
+	[primec_ast_kind_param] = "param",
+	[primec_ast_kind_struct_decl] = "struct_decl",
+	[primec_ast_kind_field] = "field",
+	[primec_ast_kind_enum_decl] = "enum_decl",
+	[primec_ast_kind_enum_member] = "enum_member",
+	[primec_ast_kind_use_decl] = "use_decl",
+	[primec_ast_kind_alias_decl] = "alias_decl",
+	[primec_ast_kind_let_decl] = "let_decl",
+
+	[primec_ast_kind_type_name] = "type_name",
+	[primec_ast_kind_type_mut] = "type_mut",
+	[primec_ast_kind_type_reference] = "type_reference",
+	[primec_ast_kind_type_pointer] = "type_pointer",
+	[primec_ast_kind_type_array] = "type_array",
+	[primec_ast_kind_type_slice] = "type_slice",
+	[primec_ast_kind_type_func] = "type_func",
+
+	[primec_ast_kind_block] = "block",
+	[primec_ast_kind_unsafe_block] = "unsafe_block",
+	[primec_ast_kind_expr_stmt] = "expr_stmt",
+	[primec_ast_kind_if] = "if",
+	[primec_ast_kind_while] = "while",
+	[primec_ast_kind_loop] = "loop",
+	[primec_ast_kind_break] = "break",
+	[primec_ast_kind_continue] = "continue",
+	[primec_ast_kind_return] = "return",
+
+	[primec_ast_kind_int_literal] = "int_literal",
+	[primec_ast_kind_float_literal] = "float_literal",
+	[primec_ast_kind_rune_literal] = "rune_literal",
+	[primec_ast_kind_string_literal] = "string_literal",
+	[primec_ast_kind_identifier] = "identifier",
+	[primec_ast_kind_scope] = "scope",
+	[primec_ast_kind_unary] = "unary",
+	[primec_ast_kind_deref] = "deref",
+	[primec_ast_kind_address_of] = "address_of",
+	[primec_ast_kind_binary] = "binary",
+	[primec_ast_kind_assign] = "assign",
+	[primec_ast_kind_cast] = "cast",
+	[primec_ast_kind_call] = "call",
+	[primec_ast_kind_index] = "index",
+	[primec_ast_kind_slice] = "slice",
+	[primec_ast_kind_member] = "member",
+	[primec_ast_kind_lambda] = "lambda"
+};
+
+_Static_assert(
+	(sizeof(g_ast_kind_to_string_map) / sizeof(g_ast_kind_to_string_map[0])) == primec_ast_kinds_count,
+	"g_ast_kind_to_string_map is not in sync with primec_ast_kind_e enum!"
+);
+
+typedef enum
+{
+	slot_raw,
+	slot_node,
+	slot_list_start,
+	slot_list_end,
+	slot_proto,
+	slot_range,
+	slot_pair
+} slot_e;
+
+// NOTE: Describes what the lhs and rhs slots of every node kind refer to, so
+//       the nodes of an ast part can be relocated when it is merged.
+static const struct
+{
+	uint8_t lhs;
+	uint8_t rhs;
+} g_ast_kind_to_layout_map[] =
+{
+	[primec_ast_kind_null] = { slot_raw, slot_raw },
+
+	[primec_ast_kind_module] = { slot_list_start, slot_list_end },
+	[primec_ast_kind_func_decl] = { slot_proto, slot_node },
+	[primec_ast_kind_param] = { slot_node, slot_raw },
+	[primec_ast_kind_struct_decl] = { slot_list_start, slot_list_end },
+	[primec_ast_kind_field] = { slot_node, slot_raw },
+	[primec_ast_kind_enum_decl] = { slot_node, slot_range },
+	[primec_ast_kind_enum_member] = { slot_node, slot_raw },
+	[primec_ast_kind_use_decl] = { slot_raw, slot_raw },
+	[primec_ast_kind_alias_decl] = { slot_node, slot_raw },
+	[primec_ast_kind_let_decl] = { slot_node, slot_node },
+
+	[primec_ast_kind_type_name] = { slot_raw, slot_raw },
+	[primec_ast_kind_type_mut] = { slot_node, slot_raw },
+	[primec_ast_kind_type_reference] = { slot_node, slot_raw },
+	[primec_ast_kind_type_pointer] = { slot_node, slot_raw },
+	[primec_ast_kind_type_array] = { slot_node, slot_node },
+	[primec_ast_kind_type_slice] = { slot_node, slot_raw },
+	[primec_ast_kind_type_func] = { slot_proto, slot_raw },
+
+	[primec_ast_kind_block] = { slot_list_start, slot_list_end },
+	[primec_ast_kind_unsafe_block] = { slot_node, slot_raw },
+	[primec_ast_kind_expr_stmt] = { slot_node, slot_raw },
+	[primec_ast_kind_if] = { slot_node, slot_pair },
+	[primec_ast_kind_while] = { slot_node, slot_node },
+	[primec_ast_kind_loop] = { slot_node, slot_raw },
+	[primec_ast_kind_break] = { slot_raw, slot_raw },
+	[primec_ast_kind_continue] = { slot_raw, slot_raw },
+	[primec_ast_kind_return] = { slot_node, slot_raw },
+
+	[primec_ast_kind_int_literal] = { slot_raw, slot_raw },
+	[primec_ast_kind_float_literal] = { slot_raw, slot_raw },
+	[primec_ast_kind_rune_literal] = { slot_raw, slot_raw },
+	[primec_ast_kind_string_literal] = { slot_raw, slot_raw },
+	[primec_ast_kind_identifier] = { slot_raw, slot_raw },
+	[primec_ast_kind_scope] = { slot_node, slot_raw },
+	[primec_ast_kind_unary] = { slot_node, slot_raw },
+	[primec_ast_kind_deref] = { slot_node, slot_raw },
+	[primec_ast_kind_address_of] = { slot_node, slot_raw },
+	[primec_ast_kind_binary] = { slot_node, slot_node },
+	[primec_ast_kind_assign] = { slot_node, slot_node },
+	[primec_ast_kind_cast] = { slot_node, slot_node },
+	[primec_ast_kind_call] = { slot_node, slot_range },
+	[primec_ast_kind_index] = { slot_node, slot_node },
+	[primec_ast_kind_slice] = { slot_node, slot_pair },
+	[primec_ast_kind_member] = { slot_node, slot_raw },
+	[primec_ast_kind_lambda] = { slot_proto, slot_node }
+};
+
+_Static_assert(
+	(sizeof(g_ast_kind_to_layout_map) / sizeof(g_ast_kind_to_layout_map[0])) == primec_ast_kinds_count,
+	"g_ast_kind_to_layout_map is not in sync with primec_ast_kind_e enum!"
+);
+
+static void relocate_nodes_range(
+	primec_ast_s* const ast,
+	const primec_ast_index_t start,
+	const primec_ast_index_t end,
+	const primec_ast_index_t nodes_base);
+
+static void relocate_slot(
+	primec_ast_s* const ast,
+	const slot_e slot,
+	primec_ast_index_t* const value,
+	const primec_ast_index_t nodes_base,
+	const primec_ast_index_t extra_base);
+
+static void push_token(
+	primec_ast_s* const ast,
+	const primec_token_s* const token);
+
+static void dump_node(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index,
+	const uint64_t depth,
+	const char* const label);
+
+static void dump_range(
+	const primec_ast_s* const ast,
+	const primec_ast_range_s range,
+	const uint64_t depth,
+	const char* const label);
+
+static void dump_proto(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra,
+	const uint64_t depth);
+
+const char* primec_ast_kind_to_string(
+	const primec_ast_kind_e kind)
+{
+	primec_debug_assert(kind < primec_ast_kinds_count);
+	return g_ast_kind_to_string_map[kind];
+}
+
+primec_ast_s primec_ast_from_lexer(
+	primec_lexer_s* const lexer)
+{
+	primec_debug_assert(lexer != NULL);
+
+	primec_ast_s ast;
+	primec_utils_memset((void*)&ast, 0, sizeof(primec_ast_s));
+	ast.file = lexer->location.file;
+
+	ast.tokens.capacity = 1024;
+	ast.tokens.data = primec_utils_malloc(ast.tokens.capacity * sizeof(primec_token_s));
+
+	ast.nodes.capacity = 512;
+	ast.nodes.data = primec_utils_malloc(ast.nodes.capacity * sizeof(primec_ast_node_s));
+
+	ast.extra.capacity = 256;
+	ast.extra.data = primec_utils_malloc(ast.extra.capacity * sizeof(primec_ast_index_t));
+
+	// NOTE: Reserving the index 0 for the null node.
+	(void)primec_ast_push_node(&ast, primec_ast_kind_null, 0, primec_ast_null, primec_ast_null);
+
+	primec_token_s token = primec_token_from_type(primec_token_type_none);
+	while (!primec_lexer_should_stop_lexing(primec_lexer_lex(lexer, &token)))
+	{
+		if (primec_token_type_single_line_comment == token.type ||
+			primec_token_type_multi_line_comment == token.type)
+		{
+			primec_token_destroy(&token);
+			continue;
+		}
+
+		push_token(&ast, &token);
+	}
+
+	push_token(&ast, &token);
+
+	// NOTE: The tokens refer to the values in the side table of the lexer, so
+	//       the side table is taken over by the ast.
+	ast.literals = lexer->literals;
+	primec_utils_memset((void*)&lexer->literals, 0, sizeof(primec_token_literals_s));
+	return ast;
+}
+
+primec_ast_s primec_ast_part_from_ast(
+	const primec_ast_s* const ast)
+{
+	primec_debug_assert(ast != NULL);
+
+	primec_ast_s part;
+	primec_utils_memset((void*)&part, 0, sizeof(primec_ast_s));
+	part.file = ast->file;
+	part.tokens = ast->tokens;
+	part.literals = ast->literals;
+	part.is_part = true;
+
+	part.nodes.capacity = 256;
+	part.nodes.data = primec_utils_malloc(part.nodes.capacity * sizeof(primec_ast_node_s));
+
+	part.extra.capacity = 128;
+	part.extra.data = primec_utils_malloc(part.extra.capacity * sizeof(primec_ast_index_t));
+
+	// NOTE: Reserving the index 0 for the null node, same as in the ast.
+	(void)primec_ast_push_node(&part, primec_ast_kind_null, 0, primec_ast_null, primec_ast_null);
+	return part;
+}
+
+void primec_ast_destroy(
+	primec_ast_s* const ast)
+{
+	primec_debug_assert(ast != NULL);
+
+	if (!ast->is_part)
+	{
+		primec_utils_free(ast->tokens.data);
+		primec_token_literals_destroy(&ast->literals);
+	}
+
+	primec_utils_free(ast->nodes.data);
+	primec_utils_free(ast->extra.data);
+	primec_utils_memset((void*)ast, 0, sizeof(primec_ast_s));
+}
+
+void primec_ast_reserve(
+	primec_ast_s* const ast,
+	const uint32_t nodes_count,
+	const uint32_t extra_count)
+{
+	primec_debug_assert(ast != NULL);
+
+	if (ast->nodes.count + nodes_count > ast->nodes.capacity)
+	{
+		ast->nodes.capacity = ast->nodes.count + nodes_count;
+		ast->nodes.data = primec_utils_realloc(ast->nodes.data, ast->nodes.capacity * sizeof(primec_ast_node_s));
+	}
+
+	if (ast->extra.count + extra_count > ast->extra.capacity)
+	{
+		ast->extra.capacity = ast->extra.count + extra_count;
+		ast->extra.data = primec_utils_realloc(ast->extra.data, ast->extra.capacity * sizeof(primec_ast_index_t));
+	}
+}
+
+void primec_ast_merge_part(
+	primec_ast_s* const ast,
+	const primec_ast_s* const part,
+	const primec_ast_index_t nodes_base,
+	const primec_ast_index_t extra_base)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(part != NULL);
+	primec_debug_assert(part->is_part);
+	primec_debug_assert(nodes_base + part->nodes.count - 1 <= ast->nodes.capacity);
+	primec_debug_assert(extra_base + part->extra.count <= ast->extra.capacity);
+
+	const uint32_t nodes_count = part->nodes.count - 1;
+
+	if (nodes_count > 0)
+	{
+		primec_utils_memcpy(ast->nodes.data + nodes_base, part->nodes.data + 1, nodes_count * sizeof(primec_ast_node_s));
+	}
+
+	if (part->extra.count > 0)
+	{
+		primec_utils_memcpy(ast->extra.data + extra_base, part->extra.data, part->extra.count * sizeof(primec_ast_index_t));
+	}
+
+	for (primec_ast_index_t index = nodes_base; index < nodes_base + nodes_count; ++index)
+	{
+		primec_ast_node_s* const node = &ast->nodes.data[index];
+		relocate_slot(ast, (slot_e)g_ast_kind_to_layout_map[node->kind].lhs, &node->lhs, nodes_base, extra_base);
+		relocate_slot(ast, (slot_e)g_ast_kind_to_layout_map[node->kind].rhs, &node->rhs, nodes_base, extra_base);
+
+		if (slot_list_start == g_ast_kind_to_layout_map[node->kind].lhs)
+		{
+			relocate_nodes_range(ast, node->lhs, node->rhs, nodes_base);
+		}
+	}
+}
+
+primec_ast_index_t primec_ast_relocate_node(
+	const primec_ast_index_t index,
+	const primec_ast_index_t nodes_base)
+{
+	return primec_ast_null == index ? primec_ast_null : nodes_base + index - 1;
+}
+
+primec_ast_index_t primec_ast_push_node(
+	primec_ast_s* const ast,
+	const primec_ast_kind_e kind,
+	const uint32_t token,
+	const primec_ast_index_t lhs,
+	const primec_ast_index_t rhs)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(kind < primec_ast_kinds_count);
+
+	if (ast->nodes.count >= ast->nodes.capacity)
+	{
+		ast->nodes.capacity *= 2;
+		ast->nodes.data = primec_utils_realloc(ast->nodes.data, ast->nodes.capacity * sizeof(primec_ast_node_s));
+	}
+
+	const primec_ast_index_t index = ast->nodes.count++;
+	ast->nodes.data[index] = (primec_ast_node_s)
+	{
+		.kind = kind,
+		.token = token,
+		.lhs = lhs,
+		.rhs = rhs
+	};
+
+	return index;
+}
+
+primec_ast_index_t primec_ast_push_extra(
+	primec_ast_s* const ast,
+	const primec_ast_index_t* const values,
+	const uint32_t count)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(values != NULL || 0 == count);
+
+	while (ast->extra.count + count > ast->extra.capacity)
+	{
+		ast->extra.capacity *= 2;
+		ast->extra.data = primec_utils_realloc(ast->extra.data, ast->extra.capacity * sizeof(primec_ast_index_t));
+	}
+
+	const primec_ast_index_t index = ast->extra.count;
+
+	if (count > 0)
+	{
+		primec_utils_memcpy(ast->extra.data + index, values, count * sizeof(primec_ast_index_t));
+		ast->extra.count += count;
+	}
+
+	return index;
+}
+
+const primec_ast_node_s* primec_ast_get_node(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(index < ast->nodes.count);
+	return &ast->nodes.data[index];
+}
+
+const primec_token_s* primec_ast_get_token(
+	const primec_ast_s* const ast,
+	const uint32_t index)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(index < ast->tokens.count);
+	return &ast->tokens.data[index];
+}
+
+const primec_token_value_s* primec_ast_get_token_value(
+	const primec_ast_s* const ast,
+	const uint32_t index)
+{
+	return primec_token_literals_get_value(&ast->literals, primec_ast_get_token(ast, index));
+}
+
+const char* primec_ast_get_token_text(
+	const primec_ast_s* const ast,
+	const uint32_t index)
+{
+	return primec_token_literals_get_text(&ast->literals, primec_ast_get_token(ast, index));
+}
+
+const primec_token_s* primec_ast_get_node_token(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index)
+{
+	return primec_ast_get_token(ast, primec_ast_get_node(ast, index)->token);
+}
+
+primec_ast_range_s primec_ast_get_range(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(extra + 1 < ast->extra.count);
+	return (primec_ast_range_s)
+	{
+		.start = ast->extra.data[extra + 0],
+		.end = ast->extra.data[extra + 1]
+	};
+}
+
+primec_ast_proto_s primec_ast_get_proto(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(extra + 3 < ast->extra.count);
+	return (primec_ast_proto_s)
+	{
+		.params = { ast->extra.data[extra + 0], ast->extra.data[extra + 1] },
+		.return_type = ast->extra.data[extra + 2],
+		.flags = ast->extra.data[extra + 3]
+	};
+}
+
+primec_ast_if_s primec_ast_get_if(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(extra + 1 < ast->extra.count);
+	return (primec_ast_if_s)
+	{
+		.then_block = ast->extra.data[extra + 0],
+		.else_branch = ast->extra.data[extra + 1]
+	};
+}
+
+primec_ast_slice_s primec_ast_get_slice(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(extra + 1 < ast->extra.count);
+	return (primec_ast_slice_s)
+	{
+		.start = ast->extra.data[extra + 0],
+		.end = ast->extra.data[extra + 1]
+	};
+}
+
+primec_ast_range_s primec_ast_get_list(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index)
+{
+	const primec_ast_node_s* const node = primec_ast_get_node(ast, index);
+	primec_debug_assert(
+		primec_ast_kind_module == node->kind ||
+		primec_ast_kind_struct_decl == node->kind ||
+		primec_ast_kind_block == node->kind
+	);
+
+	return (primec_ast_range_s)
+	{
+		.start = node->lhs,
+		.end = node->rhs
+	};
+}
+
+primec_ast_index_t primec_ast_get_extra(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(extra < ast->extra.count);
+	return ast->extra.data[extra];
+}
+
+void primec_ast_dump(
+	const primec_ast_s* const ast)
+{
+	primec_debug_assert(ast != NULL);
+	dump_node(ast, ast->root, 0, NULL);
+}
+
+static void relocate_nodes_range(
+	primec_ast_s* const ast,
+	const primec_ast_index_t start,
+	const primec_ast_index_t end,
+	const primec_ast_index_t nodes_base)
+{
+	for (primec_ast_index_t extra = start; extra < end; ++extra)
+	{
+		ast->extra.data[extra] = primec_ast_relocate_node(ast->extra.data[extra], nodes_base);
+	}
+}
+
+static void relocate_slot(
+	primec_ast_s* const ast,
+	const slot_e slot,
+	primec_ast_index_t* const value,
+	const primec_ast_index_t nodes_base,
+	const primec_ast_index_t extra_base)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(value != NULL);
+
+	switch (slot)
+	{
+		case slot_raw:
+		{
+		} break;
+
+		case slot_node:
+		{
+			*value = primec_ast_relocate_node(*value, nodes_base);
+		} break;
+
+		case slot_list_start:
+		case slot_list_end:
+		{
+			*value += extra_base;
+		} break;
+
+		case slot_proto:
+		case slot_range:
+		{
+			*value += extra_base;
+			primec_ast_index_t* const record = &ast->extra.data[*value];
+			record[0] += extra_base;
+			record[1] += extra_base;
+			relocate_nodes_range(ast, record[0], record[1], nodes_base);
+
+			if (slot_proto == slot)
+			{
+				record[2] = primec_ast_relocate_node(record[2], nodes_base);
+			}
+		} break;
+
+		case slot_pair:
+		{
+			*value += extra_base;
+			primec_ast_index_t* const record = &ast->extra.data[*value];
+			record[0] = primec_ast_relocate_node(record[0], nodes_base);
+			record[1] = primec_ast_relocate_node(record[1], nodes_base);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0); // Sanity check for developers.
+		} break;
+	}
+}
+
+static void push_token(
+	primec_ast_s* const ast,
+	const primec_token_s* const token)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(token != NULL);
+
+	if (ast->tokens.count >= ast->tokens.capacity)
+	{
+		ast->tokens.capacity *= 2;
+		ast->tokens.data = primec_utils_realloc(ast->tokens.data, ast->tokens.capacity * sizeof(primec_token_s));
+	}
+
+	ast->tokens.data[ast->tokens.count++] = *token;
+}
+
+static void dump_node(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t index,
+	const uint64_t depth,
+	const char* const label)
+{
+	primec_debug_assert(ast != NULL);
+
+	if (primec_ast_null == index)
+	{
+		return;
+	}
+
+	const primec_ast_node_s* const node = primec_ast_get_node(ast, index);
+	const primec_token_s* const token = primec_ast_get_token(ast, node->token);
+
+	// NOTE: The token of the module is its first one, so the module is shown by
+	//       the path of its file instead.
+	if (primec_ast_kind_module == node->kind)
+	{
+		primec_logger_log("%*s%s%s%s `%s`", (signed int)(depth * 2), "",
+			label ? label : "", label ? ": " : "", primec_ast_kind_to_string(node->kind),
+			primec_source_manager_get_path(ast->file));
+
+		dump_range(ast, primec_ast_get_list(ast, index), depth + 1, NULL);
+		return;
+	}
+
+	switch (token->type)
+	{
+		case primec_token_type_identifier:
+		case primec_token_type_literal_str:
+		{
+			primec_logger_log("%*s%s%s%s `%s` (" primec_location_fmt ")", (signed int)(depth * 2), "",
+				label ? label : "", label ? ": " : "", primec_ast_kind_to_string(node->kind),
+				primec_token_literals_get_text(&ast->literals, token), primec_location_arg(token->location));
+		} break;
+
+		case primec_token_type_literal_rune:
+		case primec_token_type_literal_i8:
+		case primec_token_type_literal_i16:
+		case primec_token_type_literal_i32:
+		case primec_token_type_literal_i64:
+		case primec_token_type_literal_u8:
+		case primec_token_type_literal_u16:
+		case primec_token_type_literal_u32:
+		case primec_token_type_literal_u64:
+		case primec_token_type_literal_f32:
+		case primec_token_type_literal_f64:
+		case primec_token_type_eof:
+		case primec_token_type_none:
+		{
+			primec_logger_log("%*s%s%s%s %s", (signed int)(depth * 2), "",
+				label ? label : "", label ? ": " : "", primec_ast_kind_to_string(node->kind),
+				primec_token_to_string(token, &ast->literals));
+		} break;
+
+		default:
+		{
+			primec_logger_log("%*s%s%s%s `%s` (" primec_location_fmt ")", (signed int)(depth * 2), "",
+				label ? label : "", label ? ": " : "", primec_ast_kind_to_string(node->kind),
+				primec_token_type_to_string(token->type), primec_location_arg(token->location));
+		} break;
+	}
+
+	switch (node->kind)
+	{
+		case primec_ast_kind_struct_decl:
+		case primec_ast_kind_block:
+		{
+			dump_range(ast, primec_ast_get_list(ast, index), depth + 1, NULL);
+		} break;
+
+		case primec_ast_kind_func_decl:
+		case primec_ast_kind_lambda:
+		{
+			dump_proto(ast, node->lhs, depth + 1);
+			dump_node(ast, node->rhs, depth + 1, "body");
+		} break;
+
+		case primec_ast_kind_type_func:
+		{
+			dump_proto(ast, node->lhs, depth + 1);
+		} break;
+
+		case primec_ast_kind_enum_decl:
+		{
+			dump_node(ast, node->lhs, depth + 1, "type");
+			dump_range(ast, primec_ast_get_range(ast, node->rhs), depth + 1, NULL);
+		} break;
+
+		case primec_ast_kind_use_decl:
+		{
+			for (uint32_t token_index = node->lhs; token_index <= node->rhs; ++token_index)
+			{
+				const primec_token_s* const path_token = primec_ast_get_token(ast, token_index);
+				if (path_token->type != primec_token_type_identifier) { continue; }
+				primec_logger_log("%*spath: `%s`", (signed int)((depth + 1) * 2), "",
+					primec_token_literals_get_text(&ast->literals, path_token));
+			}
+		} break;
+
+		case primec_ast_kind_param:
+		case primec_ast_kind_field:
+		case primec_ast_kind_alias_decl:
+		case primec_ast_kind_type_mut:
+		case primec_ast_kind_type_slice:
+		{
+			dump_node(ast, node->lhs, depth + 1, "type");
+		} break;
+
+		case primec_ast_kind_type_reference:
+		case primec_ast_kind_type_pointer:
+		{
+			if (node->rhs) { primec_logger_log("%*smut", (signed int)((depth + 1) * 2), ""); }
+			dump_node(ast, node->lhs, depth + 1, "type");
+		} break;
+
+		case primec_ast_kind_type_array:
+		{
+			dump_node(ast, node->lhs, depth + 1, "type");
+			dump_node(ast, node->rhs, depth + 1, "size");
+		} break;
+
+		case primec_ast_kind_let_decl:
+		{
+			dump_node(ast, node->lhs, depth + 1, "type");
+			dump_node(ast, node->rhs, depth + 1, "value");
+		} break;
+
+		case primec_ast_kind_enum_member:
+		case primec_ast_kind_unsafe_block:
+		case primec_ast_kind_expr_stmt:
+		case primec_ast_kind_loop:
+		case primec_ast_kind_return:
+		case primec_ast_kind_scope:
+		case primec_ast_kind_unary:
+		case primec_ast_kind_deref:
+		case primec_ast_kind_member:
+		{
+			dump_node(ast, node->lhs, depth + 1, NULL);
+		} break;
+
+		case primec_ast_kind_address_of:
+		{
+			if (node->rhs) { primec_logger_log("%*smut", (signed int)((depth + 1) * 2), ""); }
+			dump_node(ast, node->lhs, depth + 1, NULL);
+		} break;
+
+		case primec_ast_kind_if:
+		{
+			const primec_ast_if_s record = primec_ast_get_if(ast, node->rhs);
+			dump_node(ast, node->lhs, depth + 1, "condition");
+			dump_node(ast, record.then_block, depth + 1, "then");
+			dump_node(ast, record.else_branch, depth + 1, "else");
+		} break;
+
+		case primec_ast_kind_while:
+		{
+			dump_node(ast, node->lhs, depth + 1, "condition");
+			dump_node(ast, node->rhs, depth + 1, "body");
+		} break;
+
+		case primec_ast_kind_binary:
+		case primec_ast_kind_assign:
+		{
+			dump_node(ast, node->lhs, depth + 1, NULL);
+			dump_node(ast, node->rhs, depth + 1, NULL);
+		} break;
+
+		case primec_ast_kind_cast:
+		{
+			dump_node(ast, node->lhs, depth + 1, NULL);
+			dump_node(ast, node->rhs, depth + 1, "type");
+		} break;
+
+		case primec_ast_kind_call:
+		{
+			dump_node(ast, node->lhs, depth + 1, "callee");
+			dump_range(ast, primec_ast_get_range(ast, node->rhs), depth + 1, "argument");
+		} break;
+
+		case primec_ast_kind_index:
+		{
+			dump_node(ast, node->lhs, depth + 1, NULL);
+			dump_node(ast, node->rhs, depth + 1, "index");
+		} break;
+
+		case primec_ast_kind_slice:
+		{
+			const primec_ast_slice_s record = primec_ast_get_slice(ast, node->rhs);
+			dump_node(ast, node->lhs, depth + 1, NULL);
+			dump_node(ast, record.start, depth + 1, "start");
+			dump_node(ast, record.end, depth + 1, "end");
+		} break;
+
+		default:
+		{
+		} break;
+	}
+}
+
+static void dump_range(
+	const primec_ast_s* const ast,
+	const primec_ast_range_s range,
+	const uint64_t depth,
+	const char* const label)
+{
+	for (primec_ast_index_t extra = range.start; extra < range.end; ++extra)
+	{
+		dump_node(ast, primec_ast_get_extra(ast, extra), depth, label);
+	}
+}
+
+static void dump_proto(
+	const primec_ast_s* const ast,
+	const primec_ast_index_t extra,
+	const uint64_t depth)
+{
+	const primec_ast_proto_s proto = primec_ast_get_proto(ast, extra);
+
+	if (proto.flags & primec_ast_proto_flag_inl) { primec_logger_log("%*sinl", (signed int)(depth * 2), ""); }
+	if (proto.flags & primec_ast_proto_flag_ext) { primec_logger_log("%*sext", (signed int)(depth * 2), ""); }
+
+	dump_range(ast, proto.params, depth, "param");
+	if (proto.flags & primec_ast_proto_flag_variadic) { primec_logger_log("%*s...", (signed int)(depth * 2), ""); }
+	dump_node(ast, proto.return_type, depth, "return");
+}
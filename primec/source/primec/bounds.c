@@ -0,0 +1,1193 @@
+
+/**
+ * @file bounds.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/bounds.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+
+#include <stddef.h>
+
+// NOTE: Facts are gathered up the dominator tree, up to this many, and the
+//       ranges are refined through this many operations.
+#define max_facts 32
+#define max_depth 4
+#define max_chain 4
+
+typedef enum
+{
+	state_none,
+	state_busy,
+	state_done,
+} state_e;
+
+/**
+ * @brief Range of the values of an integer type. Bounds are kept in 64 bits,
+ * sign extended for the signed types, and are ordered as their type.
+ */
+typedef struct
+{
+	uint64_t lo;
+	uint64_t hi;
+} range_s;
+
+typedef struct
+{
+	uint8_t bits;
+	bool is_signed;
+	bool is_integer;
+} integer_s;
+
+/**
+ * @brief Known relation of two values: left < right, or left <= right.
+ */
+typedef struct
+{
+	primec_ir_value_t left;
+	primec_ir_value_t right;
+	bool is_strict;
+	bool is_signed;
+} fact_s;
+
+typedef struct
+{
+	fact_s data[max_facts];
+	uint32_t count;
+} facts_s;
+
+typedef struct
+{
+	uint32_t op;
+	uint32_t type;
+	uint32_t a;
+	uint32_t b;
+} key_s;
+
+typedef struct
+{
+	const primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_cfg_s cfg;
+
+	primec_ir_block_t* blocks;		// block of every value
+	uint32_t* positions;			// position of every value in its block
+	primec_ir_value_t* roots;		// parameter, that the address is derived from
+	bool* is_invariant;				// memory of the parameter is never written
+	primec_ir_value_t* canons;		// first value of the same computation
+
+	primec_ir_value_t* table;
+	uint32_t table_mask;
+
+	range_s* ranges;
+	uint8_t* states;
+} analyzer_s;
+
+static void remove_unsafe(
+	primec_ir_func_s* const func);
+
+static void bounds_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static void find_invariants(
+	analyzer_s* const analyzer);
+
+static void mark_escaped(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void number_values(
+	analyzer_s* const analyzer);
+
+static bool get_key(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	key_s* const key);
+
+static void collect_facts(
+	const analyzer_s* const analyzer,
+	const primec_ir_block_t block,
+	const uint32_t position,
+	facts_s* const facts);
+
+static void add_condition(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t condition,
+	const bool is_true,
+	facts_s* const facts);
+
+static void add_fact(
+	facts_s* const facts,
+	const fact_s fact);
+
+static bool is_redundant(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t check);
+
+static uint32_t get_chain(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const facts_s* const facts,
+	const bool is_positive,
+	primec_ir_value_t* const chain);
+
+static bool is_in_chain(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const primec_ir_value_t* const chain,
+	const uint32_t count);
+
+static range_s get_range_at(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const facts_s* const facts,
+	const uint32_t depth);
+
+static range_s get_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value);
+
+static range_s compute_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value);
+
+static range_s compute_phi_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t phi);
+
+static integer_s get_integer(
+	const analyzer_s* const analyzer,
+	const primec_type_t type);
+
+static range_s get_full(
+	const integer_s integer);
+
+static uint64_t normalize(
+	const integer_s integer,
+	const uint64_t bits);
+
+static bool is_below(
+	const integer_s integer,
+	const uint64_t left,
+	const uint64_t right);
+
+static range_s intersect(
+	const integer_s integer,
+	const range_s left,
+	const range_s right);
+
+static bool convert_range(
+	const integer_s from,
+	const integer_s to,
+	const range_s range,
+	range_s* const result);
+
+static bool add_ranges(
+	const integer_s integer,
+	const range_s left,
+	const range_s right,
+	const bool is_subtraction,
+	range_s* const result);
+
+static bool multiply_ranges(
+	const integer_s integer,
+	const range_s left,
+	const range_s right,
+	range_s* const result);
+
+static bool is_nonnegative(
+	const integer_s integer,
+	const range_s range);
+
+static bool get_constant(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	uint64_t* const constant);
+
+void primec_bounds_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+
+		remove_unsafe(func);
+		bounds_func(program->types, func);
+	}
+}
+
+void primec_bounds_remove_unsafe(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		remove_unsafe(func);
+	}
+}
+
+static void remove_unsafe(
+	primec_ir_func_s* const func)
+{
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+			if (primec_ir_op_check == instruction->op && (instruction->flags & primec_ir_instruction_flag_unsafe)) { continue; }
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+}
+
+static void bounds_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	bool has_checks = false;
+
+	for (primec_ir_block_t block = 0; !has_checks && block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; !has_checks && index < record->instructions.count; ++index)
+		{
+			has_checks = primec_ir_op_check == primec_ir_func_get(func, record->instructions.data[index])->op;
+		}
+	}
+
+	if (!has_checks) { return; }
+
+	const uint32_t values_count = func->instructions.count;
+	analyzer_s analyzer = { .types = types, .func = func };
+	primec_cfg_build(&analyzer.cfg, func);
+
+	analyzer.blocks = primec_utils_malloc(values_count * sizeof(primec_ir_block_t));
+	analyzer.positions = primec_utils_malloc(values_count * sizeof(uint32_t));
+	analyzer.roots = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	analyzer.is_invariant = primec_utils_malloc(values_count * sizeof(bool));
+	analyzer.canons = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	analyzer.ranges = primec_utils_malloc(values_count * sizeof(range_s));
+	analyzer.states = primec_utils_malloc(values_count * sizeof(uint8_t));
+	primec_utils_memset(analyzer.roots, 0, values_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(analyzer.is_invariant, 0, values_count * sizeof(bool));
+	primec_utils_memset(analyzer.states, state_none, values_count * sizeof(uint8_t));
+
+	for (primec_ir_value_t value = 0; value < values_count; ++value)
+	{
+		analyzer.blocks[value] = primec_cfg_unreachable;
+		analyzer.positions[value] = 0;
+		analyzer.canons[value] = value;
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			analyzer.blocks[record->instructions.data[index]] = block;
+			analyzer.positions[record->instructions.data[index]] = index;
+		}
+	}
+
+	find_invariants(&analyzer);
+	number_values(&analyzer);
+
+	// NOTE: Checks are only marked while the blocks are analyzed, so the facts
+	//       of the removed checks are still seen by the checks they dominate.
+	bool* const is_removed = primec_utils_malloc(values_count * sizeof(bool));
+	primec_utils_memset(is_removed, 0, values_count * sizeof(bool));
+
+	for (uint32_t position = 0; position < analyzer.cfg.order_count; ++position)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[analyzer.cfg.order[position]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (primec_ir_func_get(func, value)->op != primec_ir_op_check) { continue; }
+			is_removed[value] = is_redundant(&analyzer, value);
+		}
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (is_removed[value]) { continue; }
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+
+	primec_utils_free(is_removed);
+	primec_utils_free(analyzer.blocks);
+	primec_utils_free(analyzer.positions);
+	primec_utils_free(analyzer.roots);
+	primec_utils_free(analyzer.is_invariant);
+	primec_utils_free(analyzer.canons);
+	primec_utils_free(analyzer.table);
+	primec_utils_free(analyzer.ranges);
+	primec_utils_free(analyzer.states);
+	primec_cfg_destroy(&analyzer.cfg);
+}
+
+static void find_invariants(
+	analyzer_s* const analyzer)
+{
+	primec_ir_func_s* const func = analyzer->func;
+	const primec_type_table_s* const types = analyzer->types;
+	const primec_type_t* const params = primec_type_table_get_list(types, func->type);
+	const uint32_t hidden = (func->flags & primec_ir_func_flag_sret) ? 1 : 0;
+
+	// NOTE: Aggregate arguments are the copies owned by the callers, so their
+	//       memory stays the same, unless the function writes it itself, or
+	//       lets its address escape.
+	for (uint32_t position = 0; position < analyzer->cfg.order_count; ++position)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[analyzer->cfg.order[position]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			switch ((primec_ir_op_e)instruction->op)
+			{
+				case primec_ir_op_param:
+				{
+					if (instruction->a < hidden) { break; }
+					if (!primec_ir_is_aggregate(types, params[instruction->a - hidden])) { break; }
+					analyzer->roots[value] = value;
+					analyzer->is_invariant[value] = true;
+				} break;
+
+				case primec_ir_op_offset:
+				case primec_ir_op_field:
+				case primec_ir_op_element:
+				{
+					analyzer->roots[value] = analyzer->roots[instruction->a];
+				} break;
+
+				default:
+				{
+				} break;
+			}
+		}
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			switch ((primec_ir_op_e)instruction->op)
+			{
+				case primec_ir_op_load:
+				case primec_ir_op_offset:
+				case primec_ir_op_field:
+				{
+				} break;
+
+				case primec_ir_op_element:
+				{
+					mark_escaped(analyzer, &instruction->b);
+				} break;
+
+				case primec_ir_op_copy:
+				{
+					mark_escaped(analyzer, &instruction->a);
+				} break;
+
+				default:
+				{
+					primec_ir_func_visit_operands(func, value, mark_escaped, analyzer);
+				} break;
+			}
+		}
+	}
+}
+
+static void mark_escaped(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	analyzer_s* const analyzer = context;
+	const primec_ir_value_t root = analyzer->roots[*operand];
+	if (root != primec_ir_null) { analyzer->is_invariant[root] = false; }
+}
+
+static void number_values(
+	analyzer_s* const analyzer)
+{
+	primec_ir_func_s* const func = analyzer->func;
+	uint32_t capacity = 16;
+	while (capacity < 2 * func->instructions.count) { capacity *= 2; }
+
+	analyzer->table = primec_utils_malloc(capacity * sizeof(primec_ir_value_t));
+	analyzer->table_mask = capacity - 1;
+	primec_utils_memset(analyzer->table, 0, capacity * sizeof(primec_ir_value_t));
+
+	// NOTE: Blocks are numbered in the reverse post order, so the operands are
+	//       numbered before their uses (the phis are never merged).
+	for (uint32_t position = 0; position < analyzer->cfg.order_count; ++position)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[analyzer->cfg.order[position]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			key_s key = {0};
+			if (!get_key(analyzer, value, &key)) { continue; }
+
+			uint32_t hash = key.op * 0x9e3779b1u ^ key.type * 0x85ebca6bu ^ key.a * 0xc2b2ae35u ^ key.b * 0x27d4eb2fu;
+			hash ^= hash >> 15;
+
+			for (uint32_t slot = hash & analyzer->table_mask; ; slot = (slot + 1) & analyzer->table_mask)
+			{
+				const primec_ir_value_t other = analyzer->table[slot];
+
+				if (primec_ir_null == other)
+				{
+					analyzer->table[slot] = value;
+					break;
+				}
+
+				key_s other_key = {0};
+				(void)get_key(analyzer, other, &other_key);
+
+				if (0 == primec_utils_memcmp(&key, &other_key, sizeof(key)))
+				{
+					analyzer->canons[value] = other;
+					break;
+				}
+			}
+		}
+	}
+}
+
+static bool get_key(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	key_s* const key)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(analyzer->func, value);
+	*key = (key_s) { .op = instruction->op, .type = instruction->type };
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_const:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		{
+			key->a = instruction->a;
+			key->b = instruction->b;
+		} break;
+
+		case primec_ir_op_offset:
+		case primec_ir_op_field:
+		{
+			key->a = analyzer->canons[instruction->a];
+			key->b = instruction->b;
+		} break;
+
+		case primec_ir_op_load:
+		{
+			// NOTE: Only the loads of the memory, that never changes, give the
+			//       same values.
+			const primec_ir_value_t root = analyzer->roots[instruction->a];
+			if (primec_ir_null == root || !analyzer->is_invariant[root]) { return false; }
+			key->a = analyzer->canons[instruction->a];
+		} break;
+
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		case primec_ir_op_convert:
+		{
+			key->a = analyzer->canons[instruction->a];
+		} break;
+
+		case primec_ir_op_element:
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_div:
+		case primec_ir_op_rem:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		case primec_ir_op_shl:
+		case primec_ir_op_shr:
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			key->a = analyzer->canons[instruction->a];
+			key->b = analyzer->canons[instruction->b];
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+static void collect_facts(
+	const analyzer_s* const analyzer,
+	const primec_ir_block_t block,
+	const uint32_t position,
+	facts_s* const facts)
+{
+	const primec_ir_func_s* const func = analyzer->func;
+	const primec_cfg_s* const cfg = &analyzer->cfg;
+	primec_ir_block_t current = block;
+	uint32_t limit = position;
+	facts->count = 0;
+
+	// NOTE: The checks before the position hold, and so do the conditions of
+	//       the branches, whose edges are the only ways into the dominators.
+	while (true)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[current];
+
+		for (uint32_t index = 0; index < limit; ++index)
+		{
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[index]);
+			if (instruction->op != primec_ir_op_check) { continue; }
+			add_fact(facts, (fact_s) { .left = instruction->a, .right = instruction->b, .is_strict = true, .is_signed = false });
+		}
+
+		if (1 == cfg->predecessors_starts[current + 1] - cfg->predecessors_starts[current])
+		{
+			const primec_ir_block_t predecessor = cfg->predecessors[cfg->predecessors_starts[current]];
+			const primec_ir_block_s* const source = &func->blocks.data[predecessor];
+			const primec_ir_instruction_s* const last = primec_ir_func_get(func, source->instructions.data[source->instructions.count - 1]);
+			primec_ir_block_t successors[2] = {0};
+
+			if (primec_ir_op_branch == last->op && 2 == primec_ir_block_get_successors(func, predecessor, successors))
+			{
+				add_condition(analyzer, last->a, successors[0] == current, facts);
+			}
+		}
+
+		if (0 == current) { break; }
+		current = cfg->idoms[current];
+		limit = func->blocks.data[current].instructions.count;
+	}
+}
+
+static void add_condition(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t condition,
+	const bool is_true,
+	facts_s* const facts)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(analyzer->func, condition);
+	if (instruction->op < primec_ir_op_eq || instruction->op > primec_ir_op_ge) { return; }
+
+	const integer_s integer = get_integer(analyzer, primec_ir_func_get(analyzer->func, instruction->a)->type);
+	if (!integer.is_integer) { return; }
+
+	const primec_ir_value_t left = instruction->a;
+	const primec_ir_value_t right = instruction->b;
+	const bool is_signed = integer.is_signed;
+
+	// NOTE: Every condition is turned into the less (or equal) relations.
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_eq:
+		{
+			if (!is_true) { break; }
+			add_fact(facts, (fact_s) { .left = left, .right = right, .is_strict = false, .is_signed = is_signed });
+			add_fact(facts, (fact_s) { .left = right, .right = left, .is_strict = false, .is_signed = is_signed });
+		} break;
+
+		case primec_ir_op_lt:
+		{
+			add_fact(facts, is_true
+				? (fact_s) { .left = left, .right = right, .is_strict = true, .is_signed = is_signed }
+				: (fact_s) { .left = right, .right = left, .is_strict = false, .is_signed = is_signed });
+		} break;
+
+		case primec_ir_op_le:
+		{
+			add_fact(facts, is_true
+				? (fact_s) { .left = left, .right = right, .is_strict = false, .is_signed = is_signed }
+				: (fact_s) { .left = right, .right = left, .is_strict = true, .is_signed = is_signed });
+		} break;
+
+		case primec_ir_op_gt:
+		{
+			add_fact(facts, is_true
+				? (fact_s) { .left = right, .right = left, .is_strict = true, .is_signed = is_signed }
+				: (fact_s) { .left = left, .right = right, .is_strict = false, .is_signed = is_signed });
+		} break;
+
+		case primec_ir_op_ge:
+		{
+			add_fact(facts, is_true
+				? (fact_s) { .left = right, .right = left, .is_strict = false, .is_signed = is_signed }
+				: (fact_s) { .left = left, .right = right, .is_strict = true, .is_signed = is_signed });
+		} break;
+
+		default:
+		{
+		} break;
+	}
+}
+
+static void add_fact(
+	facts_s* const facts,
+	const fact_s fact)
+{
+	if (facts->count < max_facts) { facts->data[facts->count++] = fact; }
+}
+
+static bool is_redundant(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t check)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(analyzer->func, check);
+	const primec_ir_value_t index = instruction->a;
+	const primec_ir_value_t length = instruction->b;
+	const integer_s u64 = { .bits = 64, .is_signed = false, .is_integer = true };
+
+	facts_s facts = {0};
+	collect_facts(analyzer, analyzer->blocks[check], analyzer->positions[check], &facts);
+
+	const range_s index_range = get_range_at(analyzer, index, &facts, 0);
+	const range_s length_range = get_range_at(analyzer, length, &facts, 0);
+	if (index_range.hi < length_range.lo) { return true; }
+
+	// NOTE: The chains list the values, that are equal to the index and to the
+	//       length, when the conversions between them keep their values.
+	primec_ir_value_t indices[max_chain] = {0};
+	primec_ir_value_t lengths[max_chain] = {0};
+	const uint32_t indices_count = get_chain(analyzer, index, &facts, false, indices);
+	const uint32_t lengths_count = get_chain(analyzer, length, &facts, false, lengths);
+
+	for (uint32_t fact = 0; fact < facts.count; ++fact)
+	{
+		const fact_s* const record = &facts.data[fact];
+		if (!is_in_chain(analyzer, record->left, indices, indices_count)) { continue; }
+
+		const integer_s integer = get_integer(analyzer, primec_ir_func_get(analyzer->func, record->right)->type);
+		const range_s right = get_range_at(analyzer, record->right, &facts, 1);
+		range_s bound = {0};
+		if (!convert_range(integer, u64, right, &bound)) { continue; }
+
+		if (!record->is_strict)
+		{
+			if (bound.hi < length_range.lo) { return true; }
+			continue;
+		}
+
+		// NOTE: The right side of a strict relation is above the index, so it
+		//       is positive, and the conversions of narrower values keep it.
+		primec_ir_value_t rights[max_chain] = {0};
+		const uint32_t rights_count = get_chain(analyzer, record->right, &facts, true, rights);
+
+		for (uint32_t element = 0; element < rights_count; ++element)
+		{
+			if (is_in_chain(analyzer, rights[element], lengths, lengths_count)) { return true; }
+		}
+
+		if (bound.hi <= length_range.lo) { return true; }
+	}
+
+	return false;
+}
+
+static uint32_t get_chain(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const facts_s* const facts,
+	const bool is_positive,
+	primec_ir_value_t* const chain)
+{
+	uint32_t count = 0;
+	primec_ir_value_t current = value;
+	chain[count++] = current;
+
+	while (count < max_chain)
+	{
+		const primec_ir_instruction_s* const instruction = primec_ir_func_get(analyzer->func, current);
+		if (instruction->op != primec_ir_op_convert) { break; }
+
+		const integer_s from = get_integer(analyzer, primec_ir_func_get(analyzer->func, instruction->a)->type);
+		const integer_s to = get_integer(analyzer, instruction->type);
+		if (!from.is_integer || !to.is_integer) { break; }
+
+		// NOTE: Positive values are kept by the conversions from the types, that
+		//       are not wider, or else the whole range has to fit.
+		range_s converted = {0};
+		const bool is_kept = (is_positive && from.bits <= to.bits) ||
+			convert_range(from, to, get_range_at(analyzer, instruction->a, facts, 1), &converted);
+		if (!is_kept) { break; }
+
+		current = instruction->a;
+		chain[count++] = current;
+	}
+
+	return count;
+}
+
+static bool is_in_chain(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const primec_ir_value_t* const chain,
+	const uint32_t count)
+{
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		if (analyzer->canons[chain[index]] == analyzer->canons[value]) { return true; }
+	}
+
+	return false;
+}
+
+static range_s get_range_at(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	const facts_s* const facts,
+	const uint32_t depth)
+{
+	const primec_ir_instruction_s instruction = *primec_ir_func_get(analyzer->func, value);
+	const integer_s integer = get_integer(analyzer, instruction.type);
+	range_s range = get_range(analyzer, value);
+	if (!integer.is_integer) { return range; }
+
+	if (depth < max_depth)
+	{
+		uint64_t constant = 0;
+		range_s refined = {0};
+
+		if (primec_ir_op_convert == instruction.op)
+		{
+			const integer_s from = get_integer(analyzer, primec_ir_func_get(analyzer->func, instruction.a)->type);
+			const range_s source = get_range_at(analyzer, instruction.a, facts, depth + 1);
+			if (from.is_integer && convert_range(from, integer, source, &refined)) { range = intersect(integer, range, refined); }
+		}
+		else if ((primec_ir_op_add == instruction.op || primec_ir_op_sub == instruction.op) && get_constant(analyzer, instruction.b, &constant))
+		{
+			const range_s source = get_range_at(analyzer, instruction.a, facts, depth + 1);
+			const range_s step = { .lo = constant, .hi = constant };
+			if (add_ranges(integer, source, step, primec_ir_op_sub == instruction.op, &refined)) { range = intersect(integer, range, refined); }
+		}
+	}
+
+	for (uint32_t index = 0; index < facts->count; ++index)
+	{
+		const fact_s* const fact = &facts->data[index];
+		if (fact->is_signed != integer.is_signed) { continue; }
+
+		if (analyzer->canons[fact->left] == analyzer->canons[value])
+		{
+			const range_s right = get_range(analyzer, fact->right);
+			const range_s full = get_full(integer);
+			if (fact->is_strict && right.hi == full.lo) { continue; }
+			const range_s bound = { .lo = full.lo, .hi = fact->is_strict ? right.hi - 1 : right.hi };
+			range = intersect(integer, range, bound);
+		}
+
+		if (analyzer->canons[fact->right] == analyzer->canons[value])
+		{
+			const range_s left = get_range(analyzer, fact->left);
+			const range_s full = get_full(integer);
+			if (fact->is_strict && left.lo == full.hi) { continue; }
+			const range_s bound = { .lo = fact->is_strict ? left.lo + 1 : left.lo, .hi = full.hi };
+			range = intersect(integer, range, bound);
+		}
+	}
+
+	return range;
+}
+
+static range_s get_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value)
+{
+	// NOTE: Values, that depend on themselves (through the phis), get the full
+	//       ranges of their types while they are computed.
+	switch ((state_e)analyzer->states[value])
+	{
+		case state_done:
+		{
+			return analyzer->ranges[value];
+		} break;
+
+		case state_busy:
+		{
+			return get_full(get_integer(analyzer, primec_ir_func_get(analyzer->func, value)->type));
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	analyzer->states[value] = state_busy;
+	const range_s range = compute_range(analyzer, value);
+	analyzer->ranges[value] = range;
+	analyzer->states[value] = state_done;
+	return range;
+}
+
+static range_s compute_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s instruction = *primec_ir_func_get(analyzer->func, value);
+	const integer_s integer = get_integer(analyzer, instruction.type);
+	const range_s full = get_full(integer);
+	if (!integer.is_integer) { return full; }
+
+	range_s result = full;
+
+	switch ((primec_ir_op_e)instruction.op)
+	{
+		case primec_ir_op_const:
+		{
+			const uint64_t constant = normalize(integer, primec_ir_get_const(&instruction).uval);
+			result = (range_s) { .lo = constant, .hi = constant };
+		} break;
+
+		case primec_ir_op_convert:
+		{
+			const integer_s from = get_integer(analyzer, primec_ir_func_get(analyzer->func, instruction.a)->type);
+			if (!from.is_integer || !convert_range(from, integer, get_range(analyzer, instruction.a), &result)) { result = full; }
+		} break;
+
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		{
+			const range_s left = get_range(analyzer, instruction.a);
+			const range_s right = get_range(analyzer, instruction.b);
+			if (!add_ranges(integer, left, right, primec_ir_op_sub == instruction.op, &result)) { result = full; }
+		} break;
+
+		case primec_ir_op_mul:
+		{
+			const range_s left = get_range(analyzer, instruction.a);
+			const range_s right = get_range(analyzer, instruction.b);
+			if (!multiply_ranges(integer, left, right, &result)) { result = full; }
+		} break;
+
+		case primec_ir_op_and:
+		{
+			// NOTE: Masks by the nonnegative values keep the results below them.
+			const range_s left = get_range(analyzer, instruction.a);
+			const range_s right = get_range(analyzer, instruction.b);
+			const bool is_left = is_nonnegative(integer, left);
+			const bool is_right = is_nonnegative(integer, right);
+			if (is_left && is_right) { result = (range_s) { .lo = 0, .hi = is_below(integer, left.hi, right.hi) ? left.hi : right.hi }; }
+			else if (is_left) { result = (range_s) { .lo = 0, .hi = left.hi }; }
+			else if (is_right) { result = (range_s) { .lo = 0, .hi = right.hi }; }
+		} break;
+
+		case primec_ir_op_rem:
+		case primec_ir_op_div:
+		{
+			const range_s left = get_range(analyzer, instruction.a);
+			const range_s right = get_range(analyzer, instruction.b);
+			if (!is_nonnegative(integer, left) || !is_nonnegative(integer, right) || 0 == right.lo) { break; }
+
+			if (primec_ir_op_div == instruction.op) { result = (range_s) { .lo = left.lo / right.hi, .hi = left.hi / right.lo }; }
+			else { result = (range_s) { .lo = 0, .hi = left.hi < right.hi - 1 ? left.hi : right.hi - 1 }; }
+		} break;
+
+		case primec_ir_op_shr:
+		{
+			const range_s left = get_range(analyzer, instruction.a);
+			uint64_t shift = 0;
+			if (!is_nonnegative(integer, left) || !get_constant(analyzer, instruction.b, &shift) || shift >= integer.bits) { break; }
+			result = (range_s) { .lo = left.lo >> shift, .hi = left.hi >> shift };
+		} break;
+
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			result = (range_s) { .lo = 0, .hi = 1 };
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			result = compute_phi_range(analyzer, value);
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	return result;
+}
+
+static range_s compute_phi_range(
+	analyzer_s* const analyzer,
+	const primec_ir_value_t phi)
+{
+	primec_ir_func_s* const func = analyzer->func;
+	const integer_s integer = get_integer(analyzer, primec_ir_func_get(func, phi)->type);
+	const range_s full = get_full(integer);
+
+	uint32_t count = 0;
+	const uint32_t* const incoming = primec_ir_func_get_list(func, primec_ir_func_get(func, phi)->a, &count);
+	bool has_others = false;
+	bool has_increments = false;
+	bool has_decrements = false;
+	range_s others = {0};
+
+	// NOTE: Induction variables are stepped by the constants, and they do not
+	//       wrap, when the step is guarded by a bound (as the loop conditions
+	//       do), so they never go below (or above) their initial values.
+	for (uint32_t pair = 0; pair + 1 < count; pair += 2)
+	{
+		const primec_ir_value_t value = incoming[pair + 1];
+		if (value == phi) { continue; }
+
+		const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+		uint64_t step = 0;
+
+		if ((primec_ir_op_add == instruction->op || primec_ir_op_sub == instruction->op) &&
+			instruction->a == phi && get_constant(analyzer, instruction->b, &step) && step != 0 &&
+			(!integer.is_signed || (int64_t)step > 0) && analyzer->blocks[value] != primec_cfg_unreachable &&
+			primec_cfg_is_reachable(&analyzer->cfg, analyzer->blocks[value]))
+		{
+			facts_s facts = {0};
+			collect_facts(analyzer, analyzer->blocks[value], analyzer->positions[value], &facts);
+			const range_s bound = get_range_at(analyzer, phi, &facts, max_depth);
+			const range_s delta = { .lo = step, .hi = step };
+			range_s stepped = {0};
+			if (!add_ranges(integer, bound, delta, primec_ir_op_sub == instruction->op, &stepped)) { return full; }
+
+			if (primec_ir_op_add == instruction->op) { has_increments = true; }
+			else { has_decrements = true; }
+			continue;
+		}
+
+		const range_s range = get_range(analyzer, value);
+
+		if (!has_others) { others = range; }
+		else
+		{
+			if (is_below(integer, range.lo, others.lo)) { others.lo = range.lo; }
+			if (is_below(integer, others.hi, range.hi)) { others.hi = range.hi; }
+		}
+
+		has_others = true;
+	}
+
+	if (!has_others || (has_increments && has_decrements)) { return full; }
+	if (has_increments) { return (range_s) { .lo = others.lo, .hi = full.hi }; }
+	if (has_decrements) { return (range_s) { .lo = full.lo, .hi = others.hi }; }
+	return others;
+}
+
+static integer_s get_integer(
+	const analyzer_s* const analyzer,
+	const primec_type_t type)
+{
+	const primec_type_s* record = primec_type_table_get(analyzer->types, type);
+	if (primec_type_kind_enum == record->kind) { record = primec_type_table_get(analyzer->types, record->element); }
+
+	switch (record->kind)
+	{
+		case primec_type_kind_bool: { return (integer_s) { .bits = 1, .is_signed = false, .is_integer = true }; } break;
+		case primec_type_kind_i8: { return (integer_s) { .bits = 8, .is_signed = true, .is_integer = true }; } break;
+		case primec_type_kind_i16: { return (integer_s) { .bits = 16, .is_signed = true, .is_integer = true }; } break;
+		case primec_type_kind_i32: { return (integer_s) { .bits = 32, .is_signed = true, .is_integer = true }; } break;
+		case primec_type_kind_i64: { return (integer_s) { .bits = 64, .is_signed = true, .is_integer = true }; } break;
+		case primec_type_kind_u8:
+		case primec_type_kind_c8: { return (integer_s) { .bits = 8, .is_signed = false, .is_integer = true }; } break;
+		case primec_type_kind_u16: { return (integer_s) { .bits = 16, .is_signed = false, .is_integer = true }; } break;
+		case primec_type_kind_u32: { return (integer_s) { .bits = 32, .is_signed = false, .is_integer = true }; } break;
+		case primec_type_kind_u64: { return (integer_s) { .bits = 64, .is_signed = false, .is_integer = true }; } break;
+		default: { return (integer_s) { .bits = 64, .is_signed = false, .is_integer = false }; } break;
+	}
+}
+
+static range_s get_full(
+	const integer_s integer)
+{
+	if (integer.is_signed)
+	{
+		const uint64_t hi = (UINT64_C(1) << (integer.bits - 1)) - 1;
+		return (range_s) { .lo = ~hi, .hi = hi };
+	}
+
+	return (range_s) { .lo = 0, .hi = 64 == integer.bits ? UINT64_MAX : (UINT64_C(1) << integer.bits) - 1 };
+}
+
+static uint64_t normalize(
+	const integer_s integer,
+	const uint64_t bits)
+{
+	if (64 == integer.bits) { return bits; }
+	const uint32_t shift = 64u - integer.bits;
+	if (integer.is_signed) { return (uint64_t)((int64_t)(bits << shift) >> shift); }
+	return (bits << shift) >> shift;
+}
+
+static bool is_below(
+	const integer_s integer,
+	const uint64_t left,
+	const uint64_t right)
+{
+	return integer.is_signed ? (int64_t)left < (int64_t)right : left < right;
+}
+
+static range_s intersect(
+	const integer_s integer,
+	const range_s left,
+	const range_s right)
+{
+	// NOTE: Empty intersections only come from the code, that cannot run, so
+	//       the left range is kept as it is.
+	const range_s result =
+	{
+		.lo = is_below(integer, left.lo, right.lo) ? right.lo : left.lo,
+		.hi = is_below(integer, right.hi, left.hi) ? right.hi : left.hi
+	};
+
+	return is_below(integer, result.hi, result.lo) ? left : result;
+}
+
+static bool convert_range(
+	const integer_s from,
+	const integer_s to,
+	const range_s range,
+	range_s* const result)
+{
+	// NOTE: Ranges are converted only if all their values are kept, so their
+	//       bounds stay the same.
+	const range_s full = get_full(to);
+
+	if (from.is_signed && (int64_t)range.lo < 0)
+	{
+		if (!to.is_signed) { return false; }
+		if ((int64_t)range.lo < (int64_t)full.lo || (int64_t)range.hi > (int64_t)full.hi) { return false; }
+	}
+	else if (range.hi > full.hi)
+	{
+		return false;
+	}
+
+	*result = range;
+	return true;
+}
+
+static bool add_ranges(
+	const integer_s integer,
+	const range_s left,
+	const range_s right,
+	const bool is_subtraction,
+	range_s* const result)
+{
+	const range_s full = get_full(integer);
+
+	if (integer.is_signed)
+	{
+		int64_t lo = 0;
+		int64_t hi = 0;
+		const bool is_overflow = is_subtraction
+			? __builtin_sub_overflow((int64_t)left.lo, (int64_t)right.hi, &lo) || __builtin_sub_overflow((int64_t)left.hi, (int64_t)right.lo, &hi)
+			: __builtin_add_overflow((int64_t)left.lo, (int64_t)right.lo, &lo) || __builtin_add_overflow((int64_t)left.hi, (int64_t)right.hi, &hi);
+		if (is_overflow || lo < (int64_t)full.lo || hi > (int64_t)full.hi) { return false; }
+		*result = (range_s) { .lo = (uint64_t)lo, .hi = (uint64_t)hi };
+		return true;
+	}
+
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+	const bool is_overflow = is_subtraction
+		? __builtin_sub_overflow(left.lo, right.hi, &lo) || __builtin_sub_overflow(left.hi, right.lo, &hi)
+		: __builtin_add_overflow(left.lo, right.lo, &lo) || __builtin_add_overflow(left.hi, right.hi, &hi);
+	if (is_overflow || hi > full.hi) { return false; }
+	*result = (range_s) { .lo = lo, .hi = hi };
+	return true;
+}
+
+static bool multiply_ranges(
+	const integer_s integer,
+	const range_s left,
+	const range_s right,
+	range_s* const result)
+{
+	// NOTE: Only the nonnegative ranges are multiplied, so their corners are
+	//       the bounds.
+	if (!is_nonnegative(integer, left) || !is_nonnegative(integer, right)) { return false; }
+
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+	if (__builtin_mul_overflow(left.lo, right.lo, &lo) || __builtin_mul_overflow(left.hi, right.hi, &hi)) { return false; }
+	if (hi > get_full(integer).hi) { return false; }
+
+	*result = (range_s) { .lo = lo, .hi = hi };
+	return true;
+}
+
+static bool is_nonnegative(
+	const integer_s integer,
+	const range_s range)
+{
+	return !integer.is_signed || (int64_t)range.lo >= 0;
+}
+
+static bool get_constant(
+	const analyzer_s* const analyzer,
+	const primec_ir_value_t value,
+	uint64_t* const constant)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(analyzer->func, value);
+	if (instruction->op != primec_ir_op_const) { return false; }
+
+	const integer_s integer = get_integer(analyzer, instruction->type);
+	if (!integer.is_integer) { return false; }
+
+	*constant = normalize(integer, primec_ir_get_const(instruction).uval);
+	return true;
+}
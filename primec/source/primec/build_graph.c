@@ -0,0 +1,584 @@
+
+/**
+ * @file build_graph.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/build_graph.h>
+
+#include <primec/source_manager.h>
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/lexer.h>
+#include <primec/parser.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+
+#define log_build_graph_error_and_exit(_location, _format, ...)                \
+	do                                                                         \
+	{                                                                          \
+		(void)fprintf(stderr, primec_location_fmt ": ",                        \
+			primec_location_arg(_location));                                   \
+		primec_logger_error(_format, ## __VA_ARGS__);                          \
+		exit(-1);                                                              \
+	} while (0)
+
+static void log_file_error(
+	const char* const path);
+
+static primec_module_s* find_or_add_module_locked(
+	primec_build_graph_s* const graph,
+	const uint32_t file,
+	bool* const is_new);
+
+static void add_import_locked(
+	primec_module_s* const module,
+	primec_module_s* const imported,
+	const uint32_t token,
+	const primec_location_s location);
+
+static void load_module_task(
+	void* const context);
+
+static void scan_imports(
+	primec_module_s* const module);
+
+static char* resolve_import_path(
+	const primec_module_s* const module,
+	const uint32_t first,
+	const uint32_t last);
+
+static void sort_modules(
+	primec_build_graph_s* const graph);
+
+static void report_cycle(
+	const primec_build_graph_s* const graph,
+	const uint32_t* const stack,
+	const uint32_t count,
+	const uint32_t start);
+
+static void run_stage_task(
+	void* const context);
+
+primec_build_graph_s* primec_build_graph_create(
+	primec_thread_pool_s* const pool)
+{
+	primec_debug_assert(pool != NULL);
+
+	primec_build_graph_s* const graph = primec_utils_malloc(sizeof(primec_build_graph_s));
+	primec_utils_memset((void*)graph, 0, sizeof(primec_build_graph_s));
+
+	if (pthread_mutex_init(&graph->mutex, NULL) != 0)
+	{
+		primec_logger_panic("internal failure -- failed to initialize build graph");
+	}
+
+	graph->pool = pool;
+	graph->runtime = UINT32_MAX;
+	graph->modules.capacity = 16;
+	graph->modules.data = primec_utils_malloc(graph->modules.capacity * sizeof(primec_module_s*));
+	return graph;
+}
+
+void primec_build_graph_destroy(
+	primec_build_graph_s* const graph)
+{
+	primec_debug_assert(graph != NULL);
+
+	for (uint32_t index = 0; index < graph->modules.count; ++index)
+	{
+		primec_module_s* const module = graph->modules.data[index];
+
+		if (module->ast.nodes.data != NULL)
+		{
+			primec_ast_destroy(&module->ast);
+		}
+
+		primec_utils_free(module->imports.data);
+		primec_utils_free(module->importers.data);
+		primec_utils_free(module);
+	}
+
+	(void)pthread_mutex_destroy(&graph->mutex);
+	primec_utils_free(graph->order.data);
+	primec_utils_free(graph->modules_by_file.data);
+	primec_utils_free(graph->modules.data);
+	primec_utils_free(graph);
+}
+
+bool primec_build_graph_add_root(
+	primec_build_graph_s* const graph,
+	const char* const path)
+{
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(path != NULL);
+
+	uint32_t file = 0;
+	bool is_new = false;
+
+	if (!primec_source_manager_add_file(path, &file, &is_new))
+	{
+		log_file_error(path);
+		return false;
+	}
+
+	(void)pthread_mutex_lock(&graph->mutex);
+	(void)find_or_add_module_locked(graph, file, &is_new);
+	(void)pthread_mutex_unlock(&graph->mutex);
+	return true;
+}
+
+void primec_build_graph_add_runtime(
+	primec_build_graph_s* const graph,
+	const char* const path,
+	const char* const text,
+	const uint32_t length)
+{
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(UINT32_MAX == graph->runtime);
+	const uint32_t file = primec_source_manager_add_text(path, text, length);
+	bool is_new = false;
+
+	(void)pthread_mutex_lock(&graph->mutex);
+	graph->runtime = find_or_add_module_locked(graph, file, &is_new)->index;
+	(void)pthread_mutex_unlock(&graph->mutex);
+}
+
+void primec_build_graph_load(
+	primec_build_graph_s* const graph)
+{
+	primec_debug_assert(graph != NULL);
+
+	// NOTE: Only the roots are submitted here, the imported modules are submitted
+	//       by the tasks of the modules that import them.
+	(void)pthread_mutex_lock(&graph->mutex);
+	const uint32_t roots_count = graph->modules.count;
+
+	for (uint32_t index = 0; index < roots_count; ++index)
+	{
+		primec_thread_pool_submit(graph->pool, &graph->group, load_module_task, graph->modules.data[index]);
+	}
+
+	(void)pthread_mutex_unlock(&graph->mutex);
+	primec_thread_pool_wait(graph->pool, &graph->group);
+	sort_modules(graph);
+}
+
+void primec_build_graph_schedule(
+	primec_build_graph_s* const graph,
+	const primec_build_graph_stage_f stage,
+	void* const context)
+{
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(stage != NULL);
+	primec_debug_assert(graph->order.count == graph->modules.count);
+
+	graph->stage = stage;
+	graph->context = context;
+
+	for (uint32_t index = 0; index < graph->modules.count; ++index)
+	{
+		primec_module_s* const module = graph->modules.data[index];
+		module->pending = module->imports.count;
+	}
+
+	(void)pthread_mutex_lock(&graph->mutex);
+
+	for (uint32_t index = 0; index < graph->order.count; ++index)
+	{
+		primec_module_s* const module = graph->modules.data[graph->order.data[index]];
+
+		if (0 == module->pending)
+		{
+			primec_thread_pool_submit(graph->pool, &graph->group, run_stage_task, module);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&graph->mutex);
+	primec_thread_pool_wait(graph->pool, &graph->group);
+
+	graph->stage = NULL;
+	graph->context = NULL;
+}
+
+static void log_file_error(
+	const char* const path)
+{
+	primec_debug_assert(path != NULL);
+
+	switch (errno)
+	{
+		case ENOENT:
+		{
+			primec_logger_error("unable to open %s for reading -- file not found.", path);
+		} break;
+
+		case EACCES:
+		{
+			primec_logger_error("unable to open %s for reading -- permission denied.", path);
+		} break;
+
+		case ENAMETOOLONG:
+		{
+			primec_logger_error("unable to open %s for reading -- path name exceeds the system-defined maximum length.", path);
+		} break;
+
+		case EISDIR:
+		{
+			primec_logger_error("unable to open %s for reading -- it is a directory.", path);
+		} break;
+
+		default:
+		{
+			primec_logger_error("unable to open %s for reading -- failed to stat.", path);
+		} break;
+	}
+}
+
+static primec_module_s* find_or_add_module_locked(
+	primec_build_graph_s* const graph,
+	const uint32_t file,
+	bool* const is_new)
+{
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(is_new != NULL);
+
+	// NOTE: Modules are identified by the ids of their files, which are already
+	//       deduplicated by the source manager, so importing the same file via
+	//       different paths loads it only once.
+	if (file >= graph->modules_by_file.capacity)
+	{
+		const uint32_t capacity = graph->modules_by_file.capacity;
+		graph->modules_by_file.capacity = 0 == capacity ? 64 : capacity;
+		while (file >= graph->modules_by_file.capacity) { graph->modules_by_file.capacity *= 2; }
+
+		graph->modules_by_file.data = primec_utils_realloc(
+			graph->modules_by_file.data, graph->modules_by_file.capacity * sizeof(uint32_t)
+		);
+
+		primec_utils_memset(graph->modules_by_file.data + capacity, 0,
+			(graph->modules_by_file.capacity - capacity) * sizeof(uint32_t)
+		);
+	}
+
+	if (graph->modules_by_file.data[file] != 0)
+	{
+		*is_new = false;
+		return graph->modules.data[graph->modules_by_file.data[file] - 1];
+	}
+
+	if (graph->modules.count >= graph->modules.capacity)
+	{
+		graph->modules.capacity *= 2;
+		graph->modules.data = primec_utils_realloc(graph->modules.data, graph->modules.capacity * sizeof(primec_module_s*));
+	}
+
+	primec_module_s* const module = primec_utils_malloc(sizeof(primec_module_s));
+	primec_utils_memset((void*)module, 0, sizeof(primec_module_s));
+	module->file = file;
+	module->path = primec_source_manager_get_path(file);
+	module->index = graph->modules.count;
+	module->graph = graph;
+
+	graph->modules.data[graph->modules.count++] = module;
+	graph->modules_by_file.data[file] = graph->modules.count;
+	*is_new = true;
+	return module;
+}
+
+static void add_import_locked(
+	primec_module_s* const module,
+	primec_module_s* const imported,
+	const uint32_t token,
+	const primec_location_s location)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(imported != NULL);
+
+	for (uint32_t index = 0; index < module->imports.count; ++index)
+	{
+		if (module->imports.data[index].module == imported->index)
+		{
+			return;
+		}
+	}
+
+	if (module->imports.count >= module->imports.capacity)
+	{
+		module->imports.capacity = 0 == module->imports.capacity ? 4 : module->imports.capacity * 2;
+		module->imports.data = primec_utils_realloc(module->imports.data, module->imports.capacity * sizeof(primec_module_import_s));
+	}
+
+	module->imports.data[module->imports.count++] = (primec_module_import_s)
+	{
+		.module = imported->index,
+		.token = token,
+		.location = location
+	};
+
+	if (imported->importers.count >= imported->importers.capacity)
+	{
+		imported->importers.capacity = 0 == imported->importers.capacity ? 4 : imported->importers.capacity * 2;
+		imported->importers.data = primec_utils_realloc(imported->importers.data, imported->importers.capacity * sizeof(uint32_t));
+	}
+
+	imported->importers.data[imported->importers.count++] = module->index;
+}
+
+static void load_module_task(
+	void* const context)
+{
+	primec_module_s* const module = (primec_module_s*)context;
+	primec_debug_assert(module != NULL);
+
+	primec_lexer_s lexer = primec_lexer_from_parts(primec_source_manager_get_view(module->file));
+	module->ast = primec_ast_from_lexer(&lexer);
+	primec_lexer_destroy(&lexer);
+
+	// NOTE: The imports are scanned before parsing, so the imported modules are
+	//       already being read while this one is parsed.
+	scan_imports(module);
+
+	// NOTE: The runtime is imported without a `use` declaration, so its import
+	//       has no token, and it is located at the start of the module.
+	primec_build_graph_s* const graph = module->graph;
+
+	if (graph->runtime != UINT32_MAX && graph->runtime != module->index)
+	{
+		(void)pthread_mutex_lock(&graph->mutex);
+		add_import_locked(module, graph->modules.data[graph->runtime], UINT32_MAX, (primec_location_s) { .file = module->file });
+		(void)pthread_mutex_unlock(&graph->mutex);
+	}
+
+	primec_parser_s parser = primec_parser_from_parts(&module->ast);
+	(void)primec_parser_parse(&parser, graph->pool);
+	primec_parser_destroy(&parser);
+}
+
+static void scan_imports(
+	primec_module_s* const module)
+{
+	primec_debug_assert(module != NULL);
+	primec_build_graph_s* const graph = module->graph;
+	const primec_ast_s* const ast = &module->ast;
+
+	for (uint32_t index = 0; index < ast->tokens.count; ++index)
+	{
+		if (ast->tokens.data[index].type != primec_token_type_keyword_use)
+		{
+			continue;
+		}
+
+		// NOTE: Only the well-formed `use a::b::c;` declarations are resolved,
+		//       malformed ones are reported by the parser.
+		uint32_t last = index + 1;
+		if (ast->tokens.data[last].type != primec_token_type_identifier) { continue; }
+
+		while (primec_token_type_double_colon == ast->tokens.data[last + 1].type &&
+			primec_token_type_identifier == ast->tokens.data[last + 2].type)
+		{
+			last += 2;
+		}
+
+		if (ast->tokens.data[last + 1].type != primec_token_type_semicolon) { continue; }
+
+		const primec_token_s* const use = &ast->tokens.data[index];
+		char* const path = resolve_import_path(module, index + 1, last);
+		uint32_t file = 0;
+		bool is_new = false;
+
+		if (!primec_source_manager_add_file(path, &file, &is_new))
+		{
+			log_build_graph_error_and_exit(use->location, "unable to resolve module -- file %s not found.", path);
+		}
+
+		(void)pthread_mutex_lock(&graph->mutex);
+		primec_module_s* const imported = find_or_add_module_locked(graph, file, &is_new);
+		add_import_locked(module, imported, index, use->location);
+
+		if (is_new)
+		{
+			primec_thread_pool_submit(graph->pool, &graph->group, load_module_task, imported);
+		}
+
+		(void)pthread_mutex_unlock(&graph->mutex);
+		primec_utils_free(path);
+		index = last + 1;
+	}
+}
+
+static char* resolve_import_path(
+	const primec_module_s* const module,
+	const uint32_t first,
+	const uint32_t last)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(first <= last);
+	const primec_ast_s* const ast = &module->ast;
+
+	// NOTE: Module `a::b` used in the file `dir/file.prm` resolves to the file
+	//       `dir/a/b.prm`, i.e. relative to the importing file.
+	const char* const slash = strrchr(module->path, '/');
+	const uint64_t directory_length = NULL == slash ? 0 : (uint64_t)(slash - module->path) + 1;
+	uint64_t length = directory_length + sizeof(".prm");
+
+	for (uint32_t token = first; token <= last; token += 2)
+	{
+		length += primec_ast_get_token_value(ast, token)->text.length + 1;
+	}
+
+	char* const path = primec_utils_malloc(length);
+	if (directory_length > 0) { primec_utils_memcpy(path, module->path, directory_length); }
+	uint64_t offset = directory_length;
+
+	for (uint32_t token = first; token <= last; token += 2)
+	{
+		const uint64_t token_length = primec_ast_get_token_value(ast, token)->text.length;
+		primec_utils_memcpy(path + offset, primec_ast_get_token_text(ast, token), token_length);
+		offset += token_length;
+		path[offset++] = token == last ? '.' : '/';
+	}
+
+	primec_utils_memcpy(path + offset, "prm", sizeof("prm"));
+	return path;
+}
+
+static void sort_modules(
+	primec_build_graph_s* const graph)
+{
+	primec_debug_assert(graph != NULL);
+
+	typedef enum
+	{
+		color_white,
+		color_gray,
+		color_black,
+	} color_e;
+
+	const uint32_t count = graph->modules.count;
+	if (0 == count) { return; }
+
+	color_e* const colors = primec_utils_malloc(count * sizeof(color_e));
+	uint32_t* const stack = primec_utils_malloc(count * sizeof(uint32_t));
+	uint32_t* const edges = primec_utils_malloc(count * sizeof(uint32_t));
+	for (uint32_t index = 0; index < count; ++index) { colors[index] = color_white; }
+
+	graph->order.data = primec_utils_realloc(graph->order.data, count * sizeof(uint32_t));
+	graph->order.count = 0;
+
+	// NOTE: Iterative depth-first search, that emits the modules in post-order,
+	//       which places every module after all the modules it imports. A gray
+	//       module reached again is on the current path, i.e. closes a cycle.
+	for (uint32_t root = 0; root < count; ++root)
+	{
+		if (colors[root] != color_white) { continue; }
+
+		uint32_t depth = 0;
+		stack[depth] = root;
+		edges[depth++] = 0;
+		colors[root] = color_gray;
+
+		while (depth > 0)
+		{
+			const primec_module_s* const module = graph->modules.data[stack[depth - 1]];
+
+			if (edges[depth - 1] >= module->imports.count)
+			{
+				colors[module->index] = color_black;
+				graph->order.data[graph->order.count++] = module->index;
+				--depth;
+				continue;
+			}
+
+			const uint32_t imported = module->imports.data[edges[depth - 1]++].module;
+
+			if (color_gray == colors[imported])
+			{
+				uint32_t start = depth - 1;
+				while (stack[start] != imported) { --start; }
+				report_cycle(graph, stack, depth, start);
+			}
+
+			if (color_white == colors[imported])
+			{
+				colors[imported] = color_gray;
+				stack[depth] = imported;
+				edges[depth++] = 0;
+			}
+		}
+	}
+
+	primec_utils_free(edges);
+	primec_utils_free(stack);
+	primec_utils_free(colors);
+}
+
+static void report_cycle(
+	const primec_build_graph_s* const graph,
+	const uint32_t* const stack,
+	const uint32_t count,
+	const uint32_t start)
+{
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(stack != NULL);
+
+	// NOTE: Every module of the cycle is reported at its `use` declaration of
+	//       the next one, so the whole chain can be followed from the output.
+	for (uint32_t index = start; index < count; ++index)
+	{
+		const primec_module_s* const module = graph->modules.data[stack[index]];
+		const uint32_t next = index + 1 < count ? stack[index + 1] : stack[start];
+		const primec_module_import_s* import = module->imports.data;
+		while (import->module != next) { ++import; }
+
+		(void)fprintf(stderr, primec_location_fmt ": ", primec_location_arg(import->location));
+
+		if (index == start)
+		{
+			primec_logger_error("import cycle detected -- module %s uses %s%s",
+				module->path, graph->modules.data[next]->path, index + 1 < count ? "," : ".");
+		}
+		else
+		{
+			primec_logger_error("... module %s uses %s%s",
+				module->path, graph->modules.data[next]->path, index + 1 < count ? "," : ".");
+		}
+	}
+
+	exit(-1);
+}
+
+static void run_stage_task(
+	void* const context)
+{
+	primec_module_s* const module = (primec_module_s*)context;
+	primec_debug_assert(module != NULL);
+	primec_build_graph_s* const graph = module->graph;
+
+	graph->stage(module, graph->context);
+
+	(void)pthread_mutex_lock(&graph->mutex);
+
+	for (uint32_t index = 0; index < module->importers.count; ++index)
+	{
+		primec_module_s* const importer = graph->modules.data[module->importers.data[index]];
+
+		if (0 == --importer->pending)
+		{
+			primec_thread_pool_submit(graph->pool, &graph->group, run_stage_task, importer);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&graph->mutex);
+}
@@ -0,0 +1,1069 @@
+
+/**
+ * @file bytecode.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/bytecode.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/layout.h>
+#include <primec/string_pool.h>
+
+#include <stddef.h>
+
+#include <dlfcn.h>
+
+// NOTE: External functions may take this many arguments on the stack, after
+//       the ones passed in the registers.
+#define native_stack_arguments 8
+#define native_gprs 6
+#define native_xmms 8
+
+typedef struct
+{
+	primec_bytecode_module_s* module;
+	const primec_type_table_s* types;
+	uint64_t* global_addresses;
+	uint64_t* string_addresses;
+} context_s;
+
+typedef struct
+{
+	uint32_t instruction;
+	uint32_t block;
+	bool is_else;
+} fixup_s;
+
+typedef struct
+{
+	uint32_t destination;
+	uint32_t source;
+} move_s;
+
+typedef struct
+{
+	const context_s* context;
+	const primec_type_table_s* types;
+	const primec_ir_func_s* ir;
+	primec_bytecode_func_s* func;
+	uint32_t* blocks;		// offsets of the blocks in the code
+	uint32_t temporaries;	// first register of the temporaries
+
+	struct
+	{
+		fixup_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} fixups;
+
+	struct
+	{
+		move_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} moves;
+} compiler_s;
+
+static bool resolve_natives(
+	primec_bytecode_module_s* const module);
+
+static void layout_globals(
+	context_s* const context);
+
+static void layout_strings(
+	context_s* const context);
+
+static bool compile_func(
+	const context_s* const context,
+	const uint32_t index);
+
+static void prepare(
+	compiler_s* const compiler);
+
+static bool compile_instruction(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static void compile_arithmetic(
+	compiler_s* const compiler,
+	const primec_ir_value_t value);
+
+static void compile_compare(
+	compiler_s* const compiler,
+	const primec_ir_value_t value);
+
+static void compile_convert(
+	compiler_s* const compiler,
+	const primec_ir_value_t value);
+
+static bool compile_call(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static void compile_branch(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static bool collect_moves(
+	compiler_s* const compiler,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to);
+
+static void emit_moves(
+	compiler_s* const compiler);
+
+static void emit_jump(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_block_t target);
+
+static primec_bytecode_instruction_s* emit(
+	compiler_s* const compiler,
+	const primec_bytecode_op_e op,
+	const uint32_t a,
+	const uint32_t b,
+	const uint32_t c);
+
+static void emit_const(
+	compiler_s* const compiler,
+	const uint32_t destination,
+	const uint64_t value);
+
+static void add_fixup(
+	compiler_s* const compiler,
+	const uint32_t instruction,
+	const primec_ir_block_t block,
+	const bool is_else);
+
+static void set_normalization(
+	const compiler_s* const compiler,
+	primec_bytecode_instruction_s* const instruction,
+	const primec_type_t type);
+
+static uint64_t normalize(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint64_t value);
+
+static primec_bytecode_class_e get_class(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static const primec_ir_instruction_s* get_instruction(
+	const compiler_s* const compiler,
+	const primec_ir_value_t value);
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static primec_type_t get_pointee(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static bool is_float(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static bool is_signed(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment);
+
+primec_bytecode_module_s* primec_bytecode_compile(
+	const primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+	const uint32_t funcs_count = program->funcs.count;
+
+	primec_bytecode_module_s* const module = primec_utils_malloc(sizeof(primec_bytecode_module_s));
+	*module = (primec_bytecode_module_s)
+	{
+		.program = program,
+		.funcs = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(primec_bytecode_func_s)),
+		.funcs_count = funcs_count
+	};
+
+	primec_utils_memset(module->funcs, 0, (funcs_count > 0 ? funcs_count : 1) * sizeof(primec_bytecode_func_s));
+
+	for (uint32_t index = 0; index < funcs_count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		const primec_type_t return_type = primec_type_table_get(program->types, func->type)->element;
+		module->funcs[index].name = func->name;
+		module->funcs[index].return_class = (func->flags & primec_ir_func_flag_sret)
+			? primec_bytecode_class_int : get_class(program->types, return_type);
+	}
+
+	if (!resolve_natives(module))
+	{
+		primec_bytecode_destroy(module);
+		return NULL;
+	}
+
+	context_s context =
+	{
+		.module = module,
+		.types = program->types
+	};
+
+	layout_strings(&context);
+	layout_globals(&context);
+	bool is_compiled = true;
+
+	for (uint32_t index = 0; index < funcs_count; ++index)
+	{
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+		is_compiled = compile_func(&context, index) && is_compiled;
+	}
+
+	primec_utils_free(context.global_addresses);
+	primec_utils_free(context.string_addresses);
+
+	if (!is_compiled)
+	{
+		primec_bytecode_destroy(module);
+		return NULL;
+	}
+
+	return module;
+}
+
+void primec_bytecode_destroy(
+	primec_bytecode_module_s* const module)
+{
+	primec_debug_assert(module != NULL);
+
+	for (uint32_t index = 0; index < module->funcs_count; ++index)
+	{
+		primec_utils_free(module->funcs[index].params);
+		primec_utils_free(module->funcs[index].code.data);
+		primec_utils_free(module->funcs[index].lists.data);
+	}
+
+	primec_utils_free(module->funcs);
+	primec_utils_free(module->globals);
+	primec_utils_free(module->strings);
+	primec_utils_free(module);
+}
+
+static bool resolve_natives(
+	primec_bytecode_module_s* const module)
+{
+	const primec_ir_program_s* const program = module->program;
+	void* const process = dlopen(NULL, RTLD_NOW);
+	bool is_resolved = true;
+
+	if (NULL == process)
+	{
+		primec_logger_error("failed to open the current process -- %s.", dlerror());
+		return false;
+	}
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (!(func->flags & primec_ir_func_flag_extern)) { continue; }
+
+		module->funcs[index].native = dlsym(process, func->name);
+
+		if (NULL == module->funcs[index].native)
+		{
+			primec_logger_error("external function `%s` was not found in the process.", func->name);
+			is_resolved = false;
+		}
+	}
+
+	(void)dlclose(process);
+	return is_resolved;
+}
+
+static void layout_globals(
+	context_s* const context)
+{
+	const primec_ir_program_s* const program = context->module->program;
+	const primec_type_table_s* const types = context->types;
+	const uint32_t globals_count = program->globals.count > 0 ? program->globals.count : 1;
+	uint64_t* const offsets = primec_utils_malloc(globals_count * sizeof(uint64_t));
+	uint64_t size = 0;
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_layout_s layout = primec_layout_get(types, program->globals.data[index].type);
+		size = align_up(size, layout.alignment > 0 ? layout.alignment : 1);
+		offsets[index] = size;
+		size += layout.size > 0 ? layout.size : 1;
+	}
+
+	uint8_t* const globals = primec_utils_malloc(size > 0 ? size : 1);
+	primec_utils_memset(globals, 0, size > 0 ? size : 1);
+	context->global_addresses = primec_utils_malloc(globals_count * sizeof(uint64_t));
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_ir_global_s* const global = &program->globals.data[index];
+		const uint64_t global_size = primec_layout_get(types, global->type).size;
+		uint8_t* const target = &globals[offsets[index]];
+		context->global_addresses[index] = (uint64_t)(uintptr_t)target;
+
+		if (primec_ir_global_init_const == global->init)
+		{
+			uint64_t bits = global->value.uval;
+
+			if (is_float(types, global->type) && 4 == global_size)
+			{
+				const float narrow = (float)global->value.fval;
+				uint32_t narrow_bits = 0;
+				primec_utils_memcpy(&narrow_bits, &narrow, sizeof(narrow_bits));
+				bits = narrow_bits;
+			}
+
+			for (uint32_t byte = 0; byte < 8 && byte < global_size; ++byte) { target[byte] = (uint8_t)(bits >> (8 * byte)); }
+		}
+		else if (primec_ir_global_init_string == global->init)
+		{
+			// NOTE: Strings are pointers to their characters, followed by their
+			//       lengths when they are slices.
+			const uint64_t address = context->string_addresses[global->string];
+			const uint64_t length = program->strings.data[global->string].length;
+			primec_utils_memcpy(target, &address, sizeof(address));
+			if (global_size > 8) { primec_utils_memcpy(target + 8, &length, sizeof(length)); }
+		}
+	}
+
+	primec_utils_free(offsets);
+	context->module->globals = globals;
+}
+
+static void layout_strings(
+	context_s* const context)
+{
+	// NOTE: The module keeps the characters of the pool, while the addresses of
+	//       the strings are needed by the compilation only.
+	const primec_ir_program_s* const program = context->module->program;
+	const uint32_t strings_count = program->strings.count > 0 ? program->strings.count : 1;
+	primec_string_pool_s pool = primec_string_pool_from_program(program);
+	context->string_addresses = primec_utils_malloc(strings_count * sizeof(uint64_t));
+
+	for (uint32_t index = 0; index < program->strings.count; ++index)
+	{
+		context->string_addresses[index] = (uint64_t)(uintptr_t)&pool.data[pool.offsets[index]];
+	}
+
+	context->module->strings = pool.data;
+	pool.data = NULL;
+	primec_string_pool_destroy(&pool);
+}
+
+static bool compile_func(
+	const context_s* const context,
+	const uint32_t index)
+{
+	const primec_ir_func_s* const ir = context->module->program->funcs.data[index];
+
+	compiler_s compiler =
+	{
+		.context = context,
+		.types = context->types,
+		.ir = ir,
+		.func = &context->module->funcs[index],
+		.blocks = primec_utils_malloc((ir->blocks.count > 0 ? ir->blocks.count : 1) * sizeof(uint32_t))
+	};
+
+	prepare(&compiler);
+	bool is_compiled = true;
+
+	for (primec_ir_block_t block = 0; block < ir->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &ir->blocks.data[block];
+		compiler.blocks[block] = compiler.func->code.count;
+
+		for (uint32_t position = 0; position < record->instructions.count; ++position)
+		{
+			is_compiled = compile_instruction(&compiler, block, record->instructions.data[position]) && is_compiled;
+		}
+	}
+
+	// NOTE: Frames are aligned as the stack of the native code.
+	compiler.func->frame_size = (uint32_t)align_up(compiler.func->frame_size, 16);
+
+	for (uint32_t fixup = 0; fixup < compiler.fixups.count; ++fixup)
+	{
+		const fixup_s* const record = &compiler.fixups.data[fixup];
+		primec_bytecode_instruction_s* const instruction = &compiler.func->code.data[record->instruction];
+		if (record->is_else) { instruction->c = compiler.blocks[record->block]; }
+		else { instruction->b = compiler.blocks[record->block]; }
+	}
+
+	primec_utils_free(compiler.blocks);
+	primec_utils_free(compiler.fixups.data);
+	primec_utils_free(compiler.moves.data);
+	return is_compiled;
+}
+
+static void prepare(
+	compiler_s* const compiler)
+{
+	const primec_ir_func_s* const ir = compiler->ir;
+	primec_bytecode_func_s* const func = compiler->func;
+	const primec_type_s* const type = primec_type_table_get(compiler->types, ir->type);
+	uint32_t phis = 0;
+
+	// NOTE: The temporaries of the parallel moves follow the registers of the
+	//       values, as many as the phis of a single block.
+	for (primec_ir_block_t block = 0; block < ir->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &ir->blocks.data[block];
+		uint32_t count = 0;
+		while (count < record->instructions.count && primec_ir_op_phi == get_instruction(compiler, record->instructions.data[count])->op) { ++count; }
+		if (count > phis) { phis = count; }
+	}
+
+	compiler->temporaries = ir->instructions.count;
+	func->registers_count = ir->instructions.count + phis;
+	func->params_count = type->list.count + ((ir->flags & primec_ir_func_flag_sret) ? 1 : 0);
+	func->params = primec_utils_malloc((func->params_count > 0 ? func->params_count : 1) * sizeof(uint32_t));
+
+	// NOTE: Parameters, that are never used, are written to the scratch register.
+	for (uint32_t index = 0; index < func->params_count; ++index)
+	{
+		func->params[index] = 0;
+	}
+}
+
+static bool compile_instruction(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	const context_s* const context = compiler->context;
+	const primec_type_table_s* const types = compiler->types;
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_phi:
+		{
+			// NOTE: Phis are written by the moves at the ends of their predecessors.
+		} break;
+
+		case primec_ir_op_param:
+		{
+			primec_debug_assert(instruction->a < compiler->func->params_count);
+			compiler->func->params[instruction->a] = value;
+		} break;
+
+		case primec_ir_op_const:
+		{
+			const primec_const_value_s constant = primec_ir_get_const(instruction);
+			uint64_t bits = constant.uval;
+
+			if (is_float(types, instruction->type) && 4 == get_size(types, instruction->type))
+			{
+				const float narrow = (float)constant.fval;
+				uint32_t narrow_bits = 0;
+				primec_utils_memcpy(&narrow_bits, &narrow, sizeof(narrow_bits));
+				bits = narrow_bits;
+			}
+			else if (!is_float(types, instruction->type))
+			{
+				bits = normalize(types, instruction->type, bits);
+			}
+
+			emit_const(compiler, value, bits);
+		} break;
+
+		case primec_ir_op_slot:
+		{
+			const primec_layout_s layout = primec_layout_get(types, get_pointee(types, instruction->type));
+			const uint64_t offset = align_up(compiler->func->frame_size, layout.alignment > 0 ? layout.alignment : 1);
+			compiler->func->frame_size = (uint32_t)(offset + (layout.size > 0 ? layout.size : 1));
+			(void)emit(compiler, primec_bytecode_op_frame, value, (uint32_t)offset, 0);
+		} break;
+
+		case primec_ir_op_global: { emit_const(compiler, value, context->global_addresses[instruction->a]); } break;
+		case primec_ir_op_string: { emit_const(compiler, value, context->string_addresses[instruction->a]); } break;
+
+		case primec_ir_op_func:
+		{
+			const primec_bytecode_func_s* const func = &context->module->funcs[instruction->a];
+			emit_const(compiler, value, NULL == func->native ? (uint64_t)(uintptr_t)func : (uint64_t)(uintptr_t)func->native);
+		} break;
+
+		case primec_ir_op_load:
+		{
+			static const primec_bytecode_op_e ops[] =
+			{
+				[1] = primec_bytecode_op_load8,
+				[2] = primec_bytecode_op_load16,
+				[4] = primec_bytecode_op_load32,
+				[8] = primec_bytecode_op_load64
+			};
+
+			primec_bytecode_instruction_s* const load = emit(compiler, ops[get_size(types, instruction->type)], value, instruction->a, 0);
+			load->is_signed = !is_float(types, instruction->type) && is_signed(types, instruction->type);
+		} break;
+
+		case primec_ir_op_store:
+		{
+			static const primec_bytecode_op_e ops[] =
+			{
+				[1] = primec_bytecode_op_store8,
+				[2] = primec_bytecode_op_store16,
+				[4] = primec_bytecode_op_store32,
+				[8] = primec_bytecode_op_store64
+			};
+
+			(void)emit(compiler, ops[get_size(types, instruction->type)], instruction->a, instruction->b, 0);
+		} break;
+
+		case primec_ir_op_copy:
+		{
+			const uint64_t size = primec_layout_get(types, instruction->type).size;
+			(void)emit(compiler, primec_bytecode_op_copy, instruction->a, instruction->b, (uint32_t)size);
+		} break;
+
+		case primec_ir_op_zero:
+		{
+			const uint64_t size = primec_layout_get(types, instruction->type).size;
+			(void)emit(compiler, primec_bytecode_op_zero, instruction->a, 0, (uint32_t)size);
+		} break;
+
+		case primec_ir_op_field:
+		{
+			const primec_type_t type = get_pointee(types, get_instruction(compiler, instruction->a)->type);
+			const uint64_t offset = primec_layout_get_field_offset(types, type, instruction->b);
+			(void)emit(compiler, primec_bytecode_op_addi, value, instruction->a, (uint32_t)offset);
+		} break;
+
+		case primec_ir_op_offset:
+		{
+			(void)emit(compiler, primec_bytecode_op_addi, value, instruction->a, instruction->b);
+		} break;
+
+		case primec_ir_op_element:
+		{
+			// NOTE: The scaled index is kept in the register of the element.
+			const uint64_t size = primec_layout_get(types, get_pointee(types, instruction->type)).size;
+			(void)emit(compiler, primec_bytecode_op_muli, value, instruction->b, (uint32_t)size);
+			(void)emit(compiler, primec_bytecode_op_add, value, instruction->a, value);
+		} break;
+
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_div:
+		case primec_ir_op_rem:
+		case primec_ir_op_neg:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		case primec_ir_op_not:
+		case primec_ir_op_shl:
+		case primec_ir_op_shr:
+		{
+			compile_arithmetic(compiler, value);
+		} break;
+
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			compile_compare(compiler, value);
+		} break;
+
+		case primec_ir_op_convert:
+		{
+			compile_convert(compiler, value);
+		} break;
+
+		case primec_ir_op_call:
+		case primec_ir_op_call_indirect:
+		{
+			return compile_call(compiler, block, value);
+		} break;
+
+		case primec_ir_op_check:
+		{
+			(void)emit(compiler, primec_bytecode_op_check, instruction->a, instruction->b, 0);
+		} break;
+
+		case primec_ir_op_jump:
+		{
+			emit_jump(compiler, block, instruction->a);
+		} break;
+
+		case primec_ir_op_branch:
+		{
+			compile_branch(compiler, block, value);
+		} break;
+
+		case primec_ir_op_ret:
+		{
+			(void)emit(compiler, primec_bytecode_op_ret, instruction->a, 0, 0);
+		} break;
+
+		case primec_ir_op_unreachable:
+		{
+			(void)emit(compiler, primec_bytecode_op_trap, 0, 0, 0);
+		} break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unexpected ir op `%s`.", primec_ir_op_to_string((primec_ir_op_e)instruction->op));
+		} break;
+	}
+
+	return true;
+}
+
+static void compile_arithmetic(
+	compiler_s* const compiler,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	const primec_type_table_s* const types = compiler->types;
+	const bool is_signed_type = is_signed(types, instruction->type);
+	primec_bytecode_op_e op = primec_bytecode_op_add;
+
+	if (is_float(types, instruction->type))
+	{
+		const bool is_wide = 8 == get_size(types, instruction->type);
+
+		switch ((primec_ir_op_e)instruction->op)
+		{
+			case primec_ir_op_add: { op = is_wide ? primec_bytecode_op_fadd64 : primec_bytecode_op_fadd32; } break;
+			case primec_ir_op_sub: { op = is_wide ? primec_bytecode_op_fsub64 : primec_bytecode_op_fsub32; } break;
+			case primec_ir_op_mul: { op = is_wide ? primec_bytecode_op_fmul64 : primec_bytecode_op_fmul32; } break;
+			case primec_ir_op_div: { op = is_wide ? primec_bytecode_op_fdiv64 : primec_bytecode_op_fdiv32; } break;
+			case primec_ir_op_neg: { op = is_wide ? primec_bytecode_op_fneg64 : primec_bytecode_op_fneg32; } break;
+
+			default:
+			{
+				primec_logger_panic("internal failure -- unexpected float ir op `%s`.", primec_ir_op_to_string((primec_ir_op_e)instruction->op));
+			} break;
+		}
+
+		(void)emit(compiler, op, value, instruction->a, instruction->b);
+		return;
+	}
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_add: { op = primec_bytecode_op_add; } break;
+		case primec_ir_op_sub: { op = primec_bytecode_op_sub; } break;
+		case primec_ir_op_mul: { op = primec_bytecode_op_mul; } break;
+		case primec_ir_op_div: { op = is_signed_type ? primec_bytecode_op_sdiv : primec_bytecode_op_udiv; } break;
+		case primec_ir_op_rem: { op = is_signed_type ? primec_bytecode_op_srem : primec_bytecode_op_urem; } break;
+		case primec_ir_op_neg: { op = primec_bytecode_op_neg; } break;
+		case primec_ir_op_and: { op = primec_bytecode_op_and; } break;
+		case primec_ir_op_or: { op = primec_bytecode_op_or; } break;
+		case primec_ir_op_xor: { op = primec_bytecode_op_xor; } break;
+		case primec_ir_op_not: { op = primec_bytecode_op_not; } break;
+		case primec_ir_op_shl: { op = primec_bytecode_op_shl; } break;
+		case primec_ir_op_shr: { op = is_signed_type ? primec_bytecode_op_sshr : primec_bytecode_op_ushr; } break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unexpected ir op `%s`.", primec_ir_op_to_string((primec_ir_op_e)instruction->op));
+		} break;
+	}
+
+	primec_bytecode_instruction_s* const result = emit(compiler, op, value, instruction->a, instruction->b);
+	set_normalization(compiler, result, instruction->type);
+}
+
+static void compile_compare(
+	compiler_s* const compiler,
+	const primec_ir_value_t value)
+{
+	// NOTE: The greater comparisons are the lesser ones with the swapped operands.
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	const primec_type_table_s* const types = compiler->types;
+	const primec_type_t type = get_instruction(compiler, instruction->a)->type;
+	const bool is_swapped = primec_ir_op_gt == instruction->op || primec_ir_op_ge == instruction->op;
+	const bool is_strict = primec_ir_op_lt == instruction->op || primec_ir_op_gt == instruction->op;
+	primec_bytecode_op_e op = primec_bytecode_op_eq;
+
+	if (is_float(types, type))
+	{
+		const bool is_wide = 8 == get_size(types, type);
+
+		if (primec_ir_op_eq == instruction->op) { op = is_wide ? primec_bytecode_op_feq64 : primec_bytecode_op_feq32; }
+		else if (primec_ir_op_ne == instruction->op) { op = is_wide ? primec_bytecode_op_fne64 : primec_bytecode_op_fne32; }
+		else if (is_strict) { op = is_wide ? primec_bytecode_op_flt64 : primec_bytecode_op_flt32; }
+		else { op = is_wide ? primec_bytecode_op_fle64 : primec_bytecode_op_fle32; }
+	}
+	else
+	{
+		const bool is_signed_type = is_signed(types, type);
+
+		if (primec_ir_op_eq == instruction->op) { op = primec_bytecode_op_eq; }
+		else if (primec_ir_op_ne == instruction->op) { op = primec_bytecode_op_ne; }
+		else if (is_strict) { op = is_signed_type ? primec_bytecode_op_slt : primec_bytecode_op_ult; }
+		else { op = is_signed_type ? primec_bytecode_op_sle : primec_bytecode_op_ule; }
+	}
+
+	(void)emit(compiler, op, value, is_swapped ? instruction->b : instruction->a, is_swapped ? instruction->a : instruction->b);
+}
+
+static void compile_convert(
+	compiler_s* const compiler,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	const primec_type_table_s* const types = compiler->types;
+	const primec_type_t from = get_instruction(compiler, instruction->a)->type;
+	const primec_type_t to = instruction->type;
+	const bool is_from_float = is_float(types, from);
+	const bool is_to_float = is_float(types, to);
+	const bool is_from_wide = 8 == get_size(types, from);
+	const bool is_to_wide = 8 == get_size(types, to);
+	primec_bytecode_op_e op = primec_bytecode_op_move;
+
+	if (is_from_float && is_to_float)
+	{
+		op = is_from_wide == is_to_wide ? primec_bytecode_op_move : is_to_wide ? primec_bytecode_op_f32f64 : primec_bytecode_op_f64f32;
+	}
+	else if (is_from_float)
+	{
+		op = is_signed(types, to)
+			? (is_from_wide ? primec_bytecode_op_f64s : primec_bytecode_op_f32s)
+			: (is_from_wide ? primec_bytecode_op_f64u : primec_bytecode_op_f32u);
+	}
+	else if (is_to_float)
+	{
+		op = is_signed(types, from)
+			? (is_to_wide ? primec_bytecode_op_s2f64 : primec_bytecode_op_s2f32)
+			: (is_to_wide ? primec_bytecode_op_u2f64 : primec_bytecode_op_u2f32);
+	}
+	else
+	{
+		op = primec_bytecode_op_extend;
+	}
+
+	primec_bytecode_instruction_s* const result = emit(compiler, op, value, instruction->a, 0);
+	if (!is_to_float) { set_normalization(compiler, result, to); }
+}
+
+static bool compile_call(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	const primec_type_table_s* const types = compiler->types;
+	const bool is_direct = primec_ir_op_call == instruction->op;
+
+	uint32_t count = 0;
+	const uint32_t* const arguments = primec_ir_func_get_list(compiler->ir, instruction->b, &count);
+	primec_bytecode_func_s* const func = compiler->func;
+
+	// NOTE: The list starts with the count of the arguments and the class of
+	//       the result.
+	while (func->lists.count + count + 1 > func->lists.capacity)
+	{
+		func->lists.capacity = 0 == func->lists.capacity ? 32 : func->lists.capacity * 2;
+		func->lists.data = primec_utils_realloc(func->lists.data, func->lists.capacity * sizeof(uint32_t));
+	}
+
+	const uint32_t list = func->lists.count;
+	const primec_bytecode_class_e result_class = instruction->type != primec_type_void
+		? get_class(types, instruction->type) : primec_bytecode_class_int;
+	func->lists.data[func->lists.count++] = count | ((uint32_t)result_class << primec_bytecode_class_shift);
+	uint32_t gprs = 0;
+	uint32_t xmms = 0;
+	uint32_t stack = 0;
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const primec_bytecode_class_e class = get_class(types, get_instruction(compiler, arguments[index])->type);
+		func->lists.data[func->lists.count++] = arguments[index] | ((uint32_t)class << primec_bytecode_class_shift);
+
+		if (primec_bytecode_class_int == class) { if (gprs < native_gprs) { ++gprs; } else { ++stack; } }
+		else { if (xmms < native_xmms) { ++xmms; } else { ++stack; } }
+	}
+
+	const bool is_native = !is_direct || compiler->context->module->funcs[instruction->a].native != NULL;
+
+	if (is_native && stack > native_stack_arguments)
+	{
+		primec_logger_error("`%s` calls an external function with too many arguments to be run.", compiler->ir->name);
+		return false;
+	}
+
+	// NOTE: Tail calls are still followed by their returns, that return the
+	//       results of the external callees.
+	const primec_ir_block_s* const record = &compiler->ir->blocks.data[block];
+	const bool is_tail = (instruction->flags & primec_ir_instruction_flag_tail) && record->instructions.count >= 2 &&
+		record->instructions.data[record->instructions.count - 2] == value &&
+		primec_ir_op_ret == get_instruction(compiler, record->instructions.data[record->instructions.count - 1])->op;
+
+	const uint32_t destination = instruction->type != primec_type_void ? value : 0;
+	primec_bytecode_instruction_s* const call = emit(compiler, is_tail
+		? (is_direct ? primec_bytecode_op_tail_call : primec_bytecode_op_tail_call_indirect)
+		: (is_direct ? primec_bytecode_op_call : primec_bytecode_op_call_indirect), destination, instruction->a, list
+	);
+
+	// NOTE: The results of the external functions are normalized like the
+	//       results of the arithmetic.
+	if (instruction->type != primec_type_void && primec_bytecode_class_int == result_class)
+	{
+		set_normalization(compiler, call, instruction->type);
+	}
+
+	return true;
+}
+
+static void compile_branch(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(compiler, value);
+	uint32_t count = 0;
+	const uint32_t* const targets = primec_ir_func_get_list(compiler->ir, instruction->b, &count);
+	primec_debug_assert(2 == count);
+	const primec_ir_block_t then_block = targets[0];
+	const primec_ir_block_t else_block = targets[1];
+
+	const uint32_t branch = compiler->func->code.count;
+	(void)emit(compiler, primec_bytecode_op_branch, instruction->a, 0, 0);
+
+	// NOTE: Edges into the blocks with phis go through the stubs, that move
+	//       the incoming values, after the branch.
+	for (uint32_t edge = 0; edge < 2; ++edge)
+	{
+		const primec_ir_block_t target = 0 == edge ? then_block : else_block;
+
+		if (!collect_moves(compiler, block, target))
+		{
+			add_fixup(compiler, branch, target, 1 == edge);
+			continue;
+		}
+
+		if (0 == edge) { compiler->func->code.data[branch].b = compiler->func->code.count; }
+		else { compiler->func->code.data[branch].c = compiler->func->code.count; }
+
+		emit_moves(compiler);
+		add_fixup(compiler, compiler->func->code.count, target, false);
+		(void)emit(compiler, primec_bytecode_op_jump, 0, 0, 0);
+	}
+}
+
+static bool collect_moves(
+	compiler_s* const compiler,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to)
+{
+	const primec_ir_block_s* const record = &compiler->ir->blocks.data[to];
+	compiler->moves.count = 0;
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_value_t phi = record->instructions.data[index];
+		const primec_ir_instruction_s* const instruction = get_instruction(compiler, phi);
+		if (instruction->op != primec_ir_op_phi) { break; }
+
+		uint32_t count = 0;
+		const uint32_t* const incoming = primec_ir_func_get_list(compiler->ir, instruction->a, &count);
+
+		for (uint32_t pair = 0; pair < count; pair += 2)
+		{
+			if (incoming[pair] != from || incoming[pair + 1] == phi) { continue; }
+
+			if (compiler->moves.count >= compiler->moves.capacity)
+			{
+				compiler->moves.capacity = 0 == compiler->moves.capacity ? 8 : compiler->moves.capacity * 2;
+				compiler->moves.data = primec_utils_realloc(compiler->moves.data, compiler->moves.capacity * sizeof(move_s));
+			}
+
+			compiler->moves.data[compiler->moves.count++] = (move_s) { .destination = phi, .source = incoming[pair + 1] };
+			break;
+		}
+	}
+
+	return compiler->moves.count > 0;
+}
+
+static void emit_moves(
+	compiler_s* const compiler)
+{
+	// NOTE: Phis are written at once, so a phi read by another phi of the same
+	//       block is first copied into its temporary.
+	if (1 == compiler->moves.count)
+	{
+		(void)emit(compiler, primec_bytecode_op_move, compiler->moves.data[0].destination, compiler->moves.data[0].source, 0);
+		return;
+	}
+
+	for (uint32_t index = 0; index < compiler->moves.count; ++index)
+	{
+		(void)emit(compiler, primec_bytecode_op_move, compiler->temporaries + index, compiler->moves.data[index].source, 0);
+	}
+
+	for (uint32_t index = 0; index < compiler->moves.count; ++index)
+	{
+		(void)emit(compiler, primec_bytecode_op_move, compiler->moves.data[index].destination, compiler->temporaries + index, 0);
+	}
+}
+
+static void emit_jump(
+	compiler_s* const compiler,
+	const primec_ir_block_t block,
+	const primec_ir_block_t target)
+{
+	if (collect_moves(compiler, block, target))
+	{
+		emit_moves(compiler);
+	}
+
+	// NOTE: Jumps to the next blocks fall through.
+	if (target == block + 1) { return; }
+
+	add_fixup(compiler, compiler->func->code.count, target, false);
+	(void)emit(compiler, primec_bytecode_op_jump, 0, 0, 0);
+}
+
+static primec_bytecode_instruction_s* emit(
+	compiler_s* const compiler,
+	const primec_bytecode_op_e op,
+	const uint32_t a,
+	const uint32_t b,
+	const uint32_t c)
+{
+	primec_bytecode_func_s* const func = compiler->func;
+
+	if (func->code.count >= func->code.capacity)
+	{
+		func->code.capacity = 0 == func->code.capacity ? 64 : func->code.capacity * 2;
+		func->code.data = primec_utils_realloc(func->code.data, func->code.capacity * sizeof(primec_bytecode_instruction_s));
+	}
+
+	primec_bytecode_instruction_s* const instruction = &func->code.data[func->code.count++];
+	*instruction = (primec_bytecode_instruction_s) { .op = (uint16_t)op, .a = a, .b = b, .c = c };
+	return instruction;
+}
+
+static void emit_const(
+	compiler_s* const compiler,
+	const uint32_t destination,
+	const uint64_t value)
+{
+	(void)emit(compiler, primec_bytecode_op_const, destination, (uint32_t)value, (uint32_t)(value >> 32));
+}
+
+static void add_fixup(
+	compiler_s* const compiler,
+	const uint32_t instruction,
+	const primec_ir_block_t block,
+	const bool is_else)
+{
+	if (compiler->fixups.count >= compiler->fixups.capacity)
+	{
+		compiler->fixups.capacity = 0 == compiler->fixups.capacity ? 16 : compiler->fixups.capacity * 2;
+		compiler->fixups.data = primec_utils_realloc(compiler->fixups.data, compiler->fixups.capacity * sizeof(fixup_s));
+	}
+
+	compiler->fixups.data[compiler->fixups.count++] = (fixup_s) { .instruction = instruction, .block = block, .is_else = is_else };
+}
+
+static void set_normalization(
+	const compiler_s* const compiler,
+	primec_bytecode_instruction_s* const instruction,
+	const primec_type_t type)
+{
+	instruction->shift = (uint8_t)(64 - 8 * get_size(compiler->types, type));
+	instruction->is_signed = is_signed(compiler->types, type);
+}
+
+static uint64_t normalize(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint64_t value)
+{
+	const uint32_t shift = 64 - 8 * get_size(types, type);
+	return is_signed(types, type) ? (uint64_t)((int64_t)(value << shift) >> shift) : (value << shift) >> shift;
+}
+
+static primec_bytecode_class_e get_class(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	if (!is_float(types, type)) { return primec_bytecode_class_int; }
+	return 8 == get_size(types, type) ? primec_bytecode_class_f64 : primec_bytecode_class_f32;
+}
+
+static const primec_ir_instruction_s* get_instruction(
+	const compiler_s* const compiler,
+	const primec_ir_value_t value)
+{
+	return primec_ir_func_get(compiler->ir, value);
+}
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	return primec_type_kind_enum == record->kind ? record->element : type;
+}
+
+static primec_type_t get_pointee(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_table_get(types, type)->element;
+}
+
+static bool is_float(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_is_float(types, get_scalar(types, type));
+}
+
+static bool is_signed(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_is_signed(types, get_scalar(types, type));
+}
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const uint64_t size = primec_layout_get(types, type).size;
+	return size > 8 ? 8 : 0 == size ? 1 : (uint32_t)size;
+}
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
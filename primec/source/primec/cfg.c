@@ -0,0 +1,296 @@
+
+/**
+ * @file cfg.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/cfg.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+static void build_order(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func);
+
+static void build_predecessors(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func);
+
+static void build_dominators(
+	primec_cfg_s* const cfg);
+
+static void build_tree(
+	primec_cfg_s* const cfg);
+
+static primec_ir_block_t intersect(
+	const primec_cfg_s* const cfg,
+	primec_ir_block_t left,
+	primec_ir_block_t right);
+
+void primec_cfg_build(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func)
+{
+	primec_debug_assert(cfg != NULL);
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(func->blocks.count > 0);
+
+	const uint32_t count = func->blocks.count;
+	*cfg = (primec_cfg_s) { .blocks_count = count };
+	cfg->order = primec_utils_malloc(count * sizeof(primec_ir_block_t));
+	cfg->positions = primec_utils_malloc(count * sizeof(uint32_t));
+	cfg->idoms = primec_utils_malloc(count * sizeof(primec_ir_block_t));
+	cfg->predecessors_starts = primec_utils_malloc((count + 1) * sizeof(uint32_t));
+	cfg->children_starts = primec_utils_malloc((count + 1) * sizeof(uint32_t));
+	cfg->preorder = primec_utils_malloc(count * sizeof(uint32_t));
+	cfg->sizes = primec_utils_malloc(count * sizeof(uint32_t));
+
+	build_order(cfg, func);
+	build_predecessors(cfg, func);
+	build_dominators(cfg);
+	build_tree(cfg);
+}
+
+void primec_cfg_destroy(
+	primec_cfg_s* const cfg)
+{
+	primec_debug_assert(cfg != NULL);
+	primec_utils_free(cfg->order);
+	primec_utils_free(cfg->positions);
+	primec_utils_free(cfg->idoms);
+	primec_utils_free(cfg->predecessors_starts);
+	primec_utils_free(cfg->predecessors);
+	primec_utils_free(cfg->children_starts);
+	primec_utils_free(cfg->children);
+	primec_utils_free(cfg->preorder);
+	primec_utils_free(cfg->sizes);
+}
+
+bool primec_cfg_is_reachable(
+	const primec_cfg_s* const cfg,
+	const primec_ir_block_t block)
+{
+	primec_debug_assert(cfg != NULL);
+	primec_debug_assert(block < cfg->blocks_count);
+	return cfg->positions[block] != primec_cfg_unreachable;
+}
+
+bool primec_cfg_dominates(
+	const primec_cfg_s* const cfg,
+	const primec_ir_block_t dominator,
+	const primec_ir_block_t block)
+{
+	primec_debug_assert(cfg != NULL);
+	if (!primec_cfg_is_reachable(cfg, dominator) || !primec_cfg_is_reachable(cfg, block)) { return false; }
+	return cfg->preorder[dominator] <= cfg->preorder[block] && cfg->preorder[block] < cfg->preorder[dominator] + cfg->sizes[dominator];
+}
+
+static void build_order(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func)
+{
+	// NOTE: The post order is found by an explicit depth first search, where
+	//       every entry of the stack remembers its next successor.
+	const uint32_t count = cfg->blocks_count;
+	primec_ir_block_t* const stack = primec_utils_malloc(count * sizeof(primec_ir_block_t));
+	uint32_t* const next = primec_utils_malloc(count * sizeof(uint32_t));
+	uint32_t stack_count = 0;
+	uint32_t post_count = 0;
+
+	for (primec_ir_block_t block = 0; block < count; ++block) { cfg->positions[block] = primec_cfg_unreachable; }
+
+	stack[stack_count++] = 0;
+	next[0] = 0;
+	cfg->positions[0] = 0;
+
+	while (stack_count > 0)
+	{
+		const primec_ir_block_t block = stack[stack_count - 1];
+		primec_ir_block_t successors[2] = {0};
+		const uint32_t successors_count = primec_ir_block_get_successors(func, block, successors);
+
+		if (next[block] < successors_count)
+		{
+			const primec_ir_block_t successor = successors[next[block]++];
+			if (cfg->positions[successor] != primec_cfg_unreachable) { continue; }
+
+			cfg->positions[successor] = 0;
+			next[successor] = 0;
+			stack[stack_count++] = successor;
+			continue;
+		}
+
+		--stack_count;
+		cfg->order[post_count++] = block;
+	}
+
+	for (uint32_t index = 0; index < post_count / 2; ++index)
+	{
+		const primec_ir_block_t block = cfg->order[index];
+		cfg->order[index] = cfg->order[post_count - 1 - index];
+		cfg->order[post_count - 1 - index] = block;
+	}
+
+	cfg->order_count = post_count;
+	for (uint32_t index = 0; index < post_count; ++index) { cfg->positions[cfg->order[index]] = index; }
+
+	primec_utils_free(stack);
+	primec_utils_free(next);
+}
+
+static void build_predecessors(
+	primec_cfg_s* const cfg,
+	const primec_ir_func_s* const func)
+{
+	const uint32_t count = cfg->blocks_count;
+	uint32_t* const filled = primec_utils_malloc(count * sizeof(uint32_t));
+	primec_utils_memset(cfg->predecessors_starts, 0, (count + 1) * sizeof(uint32_t));
+	primec_utils_memset(filled, 0, count * sizeof(uint32_t));
+
+	for (primec_ir_block_t block = 0; block < count; ++block)
+	{
+		primec_ir_block_t successors[2] = {0};
+		const uint32_t successors_count = primec_ir_block_get_successors(func, block, successors);
+		for (uint32_t index = 0; index < successors_count; ++index) { ++cfg->predecessors_starts[successors[index] + 1]; }
+	}
+
+	for (primec_ir_block_t block = 0; block < count; ++block)
+	{
+		cfg->predecessors_starts[block + 1] += cfg->predecessors_starts[block];
+	}
+
+	const uint32_t total = cfg->predecessors_starts[count];
+	cfg->predecessors = primec_utils_malloc((total > 0 ? total : 1) * sizeof(primec_ir_block_t));
+
+	for (primec_ir_block_t block = 0; block < count; ++block)
+	{
+		primec_ir_block_t successors[2] = {0};
+		const uint32_t successors_count = primec_ir_block_get_successors(func, block, successors);
+
+		for (uint32_t index = 0; index < successors_count; ++index)
+		{
+			const primec_ir_block_t successor = successors[index];
+			cfg->predecessors[cfg->predecessors_starts[successor] + filled[successor]++] = block;
+		}
+	}
+
+	primec_utils_free(filled);
+}
+
+static void build_dominators(
+	primec_cfg_s* const cfg)
+{
+	// NOTE: Dominators are found by the iterative algorithm of Cooper, Harvey
+	//       and Kennedy over the reverse post order.
+	for (primec_ir_block_t block = 0; block < cfg->blocks_count; ++block) { cfg->idoms[block] = primec_cfg_unreachable; }
+	cfg->idoms[0] = 0;
+
+	bool is_changed = true;
+
+	while (is_changed)
+	{
+		is_changed = false;
+
+		for (uint32_t position = 1; position < cfg->order_count; ++position)
+		{
+			const primec_ir_block_t block = cfg->order[position];
+			primec_ir_block_t idom = primec_cfg_unreachable;
+
+			for (uint32_t index = cfg->predecessors_starts[block]; index < cfg->predecessors_starts[block + 1]; ++index)
+			{
+				const primec_ir_block_t predecessor = cfg->predecessors[index];
+				if (primec_cfg_unreachable == cfg->idoms[predecessor]) { continue; }
+				idom = primec_cfg_unreachable == idom ? predecessor : intersect(cfg, predecessor, idom);
+			}
+
+			if (idom != cfg->idoms[block])
+			{
+				cfg->idoms[block] = idom;
+				is_changed = true;
+			}
+		}
+	}
+}
+
+static void build_tree(
+	primec_cfg_s* const cfg)
+{
+	const uint32_t count = cfg->blocks_count;
+	uint32_t* const filled = primec_utils_malloc(count * sizeof(uint32_t));
+	primec_utils_memset(cfg->children_starts, 0, (count + 1) * sizeof(uint32_t));
+	primec_utils_memset(filled, 0, count * sizeof(uint32_t));
+
+	for (uint32_t position = 1; position < cfg->order_count; ++position)
+	{
+		++cfg->children_starts[cfg->idoms[cfg->order[position]] + 1];
+	}
+
+	for (primec_ir_block_t block = 0; block < count; ++block)
+	{
+		cfg->children_starts[block + 1] += cfg->children_starts[block];
+	}
+
+	cfg->children = primec_utils_malloc((cfg->order_count > 0 ? cfg->order_count : 1) * sizeof(primec_ir_block_t));
+
+	// NOTE: Children are listed in the reverse post order of their blocks.
+	for (uint32_t position = 1; position < cfg->order_count; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		const primec_ir_block_t idom = cfg->idoms[block];
+		cfg->children[cfg->children_starts[idom] + filled[idom]++] = block;
+	}
+
+	// NOTE: Subtrees are numbered by their preorder, so a block dominates the
+	//       blocks, whose numbers are within its subtree.
+	primec_ir_block_t* const stack = filled;
+	uint32_t stack_count = 0;
+	uint32_t number = 0;
+	stack[stack_count++] = 0;
+
+	while (stack_count > 0)
+	{
+		const primec_ir_block_t block = stack[--stack_count];
+		cfg->preorder[block] = number++;
+
+		for (uint32_t index = cfg->children_starts[block + 1]; index > cfg->children_starts[block]; --index)
+		{
+			stack[stack_count++] = cfg->children[index - 1];
+		}
+	}
+
+	for (uint32_t position = cfg->order_count; position > 0; --position)
+	{
+		const primec_ir_block_t block = cfg->order[position - 1];
+		cfg->sizes[block] = 1;
+
+		for (uint32_t index = cfg->children_starts[block]; index < cfg->children_starts[block + 1]; ++index)
+		{
+			cfg->sizes[block] += cfg->sizes[cfg->children[index]];
+		}
+	}
+
+	primec_utils_free(filled);
+}
+
+static primec_ir_block_t intersect(
+	const primec_cfg_s* const cfg,
+	primec_ir_block_t left,
+	primec_ir_block_t right)
+{
+	while (left != right)
+	{
+		while (cfg->positions[left] > cfg->positions[right]) { left = cfg->idoms[left]; }
+		while (cfg->positions[right] > cfg->positions[left]) { right = cfg->idoms[right]; }
+	}
+
+	return left;
+}
@@ -0,0 +1,668 @@
+
+/**
+ * @file const_eval.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/const_eval.h>
+
+#include <primec/debug.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+static const char* const g_status_to_string_map[] =
+{
+	[primec_const_status_ok] = "ok",
+	[primec_const_status_overflow] = "overflow",
+	[primec_const_status_division_by_zero] = "division by zero",
+	[primec_const_status_invalid_shift] = "invalid shift amount",
+};
+
+_Static_assert(
+	(sizeof(g_status_to_string_map) / sizeof(g_status_to_string_map[0])) == primec_const_statuses_count,
+	"g_status_to_string_map is not in sync with primec_const_status_e enum!"
+);
+
+static uint8_t get_scalar_kind(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+static uint8_t get_bits(
+	const uint8_t kind);
+
+static bool is_signed_kind(
+	const uint8_t kind);
+
+static bool is_float_kind(
+	const uint8_t kind);
+
+static bool fits(
+	const uint8_t kind,
+	const primec_const_value_s value);
+
+static primec_const_value_s truncate(
+	const uint8_t kind,
+	const primec_const_value_s value);
+
+static primec_const_status_e finish(
+	const uint8_t kind,
+	const primec_const_value_s value,
+	primec_const_value_s* const result);
+
+static primec_const_status_e fold_arithmetic(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right,
+	primec_const_value_s* const result);
+
+static primec_const_status_e fold_float(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right,
+	primec_const_value_s* const result);
+
+static primec_const_status_e fold_shift(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const uint8_t count_kind,
+	const primec_const_value_s count,
+	primec_const_value_s* const result);
+
+static bool fold_comparison(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right);
+
+const char* primec_const_status_to_string(
+	const primec_const_status_e status)
+{
+	primec_debug_assert(status < primec_const_statuses_count);
+	return g_status_to_string_map[status];
+}
+
+primec_const_status_e primec_const_from_literal(
+	const primec_token_s* const token,
+	const primec_token_value_s* const value,
+	const primec_type_t type,
+	primec_const_value_s* const result)
+{
+	primec_debug_assert(token != NULL);
+	primec_debug_assert(value != NULL);
+	primec_debug_assert(result != NULL);
+
+	// NOTE: Literal types are primitives, so their kinds are their handles.
+	const uint8_t kind = (uint8_t)type;
+	primec_const_value_s literal = {0};
+
+	switch (token->type)
+	{
+		case primec_token_type_literal_f32:
+		case primec_token_type_literal_f64:
+		{
+			literal.fval = (double)value->fval;
+			if (primec_type_kind_f32 == kind && (literal.fval > FLT_MAX || literal.fval < -FLT_MAX)) { return primec_const_status_overflow; }
+			if (primec_type_kind_f32 == kind) { literal.fval = (double)(float)literal.fval; }
+			*result = literal;
+			return primec_const_status_ok;
+		} break;
+
+		case primec_token_type_literal_rune:
+		{
+			literal.uval = value->rune;
+		} break;
+
+		case primec_token_type_literal_u8:
+		case primec_token_type_literal_u16:
+		case primec_token_type_literal_u32:
+		case primec_token_type_literal_u64:
+		{
+			literal.uval = value->uval;
+		} break;
+
+		default:
+		{
+			// NOTE: Values of signed literals are never negative, as the sign is
+			//       a separate unary operator.
+			literal.ival = value->ival;
+			if (literal.ival < 0) { return primec_const_status_overflow; }
+		} break;
+	}
+
+	return finish(kind, literal, result);
+}
+
+primec_const_status_e primec_const_convert(
+	const primec_type_table_s* const table,
+	const primec_type_t from,
+	const primec_type_t to,
+	const primec_const_value_s value,
+	const bool is_explicit,
+	primec_const_value_s* const result)
+{
+	primec_debug_assert(result != NULL);
+	const uint8_t from_kind = get_scalar_kind(table, from);
+	const uint8_t to_kind = get_scalar_kind(table, to);
+	primec_const_value_s converted = {0};
+
+	if (is_float_kind(from_kind))
+	{
+		if (is_float_kind(to_kind))
+		{
+			converted.fval = value.fval;
+			if (primec_type_kind_f32 == to_kind && (value.fval > FLT_MAX || value.fval < -FLT_MAX)) { return primec_const_status_overflow; }
+			if (primec_type_kind_f32 == to_kind) { converted.fval = (double)(float)value.fval; }
+			*result = converted;
+			return primec_const_status_ok;
+		}
+
+		// NOTE: Floats out of the range of the integer are rejected, as their
+		//       conversions trap at run time.
+		if (isnan(value.fval) || value.fval < -0x1p63 || value.fval >= 0x1p64 ||
+			(is_signed_kind(to_kind) && value.fval >= 0x1p63))
+		{
+			return primec_const_status_overflow;
+		}
+
+		if (value.fval < 0) { converted.ival = (int64_t)value.fval; }
+		else { converted.uval = (uint64_t)value.fval; }
+
+		if (!is_signed_kind(to_kind) && converted.ival < 0) { return primec_const_status_overflow; }
+		return finish(to_kind, converted, result);
+	}
+
+	if (is_float_kind(to_kind))
+	{
+		converted.fval = is_signed_kind(from_kind) ? (double)value.ival : (double)value.uval;
+		if (primec_type_kind_f32 == to_kind) { converted.fval = (double)(float)converted.fval; }
+		*result = converted;
+		return primec_const_status_ok;
+	}
+
+	if (is_explicit)
+	{
+		*result = truncate(to_kind, value);
+		return primec_const_status_ok;
+	}
+
+	// NOTE: Negative values fit only into signed types, and non-negative values
+	//       are compared by their magnitude.
+	if (is_signed_kind(from_kind) && value.ival < 0 && !is_signed_kind(to_kind))
+	{
+		return primec_const_status_overflow;
+	}
+
+	if (!is_signed_kind(from_kind) && is_signed_kind(to_kind) && value.uval > (uint64_t)INT64_MAX)
+	{
+		return primec_const_status_overflow;
+	}
+
+	return finish(to_kind, value, result);
+}
+
+primec_const_status_e primec_const_fold_unary(
+	const primec_type_table_s* const table,
+	const primec_token_type_e operator,
+	const primec_type_t type,
+	const primec_const_value_s value,
+	primec_const_value_s* const result)
+{
+	primec_debug_assert(result != NULL);
+	const uint8_t kind = get_scalar_kind(table, type);
+	primec_const_value_s folded = value;
+
+	switch (operator)
+	{
+		case primec_token_type_add:
+		{
+		} break;
+
+		case primec_token_type_subtract:
+		{
+			if (is_float_kind(kind))
+			{
+				folded.fval = -value.fval;
+			}
+			else if (is_signed_kind(kind))
+			{
+				if (INT64_MIN == value.ival) { return primec_const_status_overflow; }
+				folded.ival = -value.ival;
+			}
+			else if (value.uval != 0)
+			{
+				return primec_const_status_overflow;
+			}
+		} break;
+
+		case primec_token_type_bnot:
+		{
+			// NOTE: Complements of sign extended values stay in range, while the
+			//       complements of unsigned values are truncated to their width.
+			folded.uval = ~value.uval;
+			if (!is_signed_kind(kind)) { folded = truncate(kind, folded); }
+		} break;
+
+		case primec_token_type_lnot:
+		{
+			folded.uval = 0 == value.uval;
+			*result = folded;
+			return primec_const_status_ok;
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	return finish(kind, folded, result);
+}
+
+primec_const_status_e primec_const_fold_binary(
+	const primec_type_table_s* const table,
+	const primec_token_type_e operator,
+	const primec_type_t left_type,
+	const primec_const_value_s left,
+	const primec_type_t right_type,
+	const primec_const_value_s right,
+	primec_const_value_s* const result)
+{
+	primec_debug_assert(result != NULL);
+	const uint8_t kind = get_scalar_kind(table, left_type);
+	primec_const_value_s folded = {0};
+
+	switch (operator)
+	{
+		case primec_token_type_add:
+		case primec_token_type_subtract:
+		case primec_token_type_multiply:
+		case primec_token_type_divide:
+		case primec_token_type_modulus:
+		{
+			if (is_float_kind(kind))
+			{
+				return fold_float(kind, operator, left, right, result);
+			}
+
+			return fold_arithmetic(kind, operator, left, right, result);
+		} break;
+
+		case primec_token_type_band:
+		case primec_token_type_bor:
+		case primec_token_type_bxor:
+		{
+			folded.uval = primec_token_type_band == operator ? left.uval & right.uval
+				: primec_token_type_bor == operator ? left.uval | right.uval
+				: left.uval ^ right.uval;
+
+			// NOTE: Both operands are extended the same way, so is the result.
+			*result = folded;
+			return primec_const_status_ok;
+		} break;
+
+		case primec_token_type_lshift:
+		case primec_token_type_rshift:
+		{
+			return fold_shift(kind, operator, left, get_scalar_kind(table, right_type), right, result);
+		} break;
+
+		case primec_token_type_land:
+		case primec_token_type_lor:
+		case primec_token_type_lxor:
+		{
+			const bool lhs = left.uval != 0;
+			const bool rhs = right.uval != 0;
+			folded.uval = primec_token_type_land == operator ? lhs && rhs
+				: primec_token_type_lor == operator ? lhs || rhs
+				: lhs != rhs;
+
+			*result = folded;
+			return primec_const_status_ok;
+		} break;
+
+		case primec_token_type_equal:
+		case primec_token_type_not_equal:
+		case primec_token_type_greater_than:
+		case primec_token_type_less_than:
+		case primec_token_type_greater_than_or_equal:
+		case primec_token_type_less_than_or_equal:
+		{
+			folded.uval = fold_comparison(kind, operator, left, right);
+			*result = folded;
+			return primec_const_status_ok;
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return primec_const_status_ok;
+		} break;
+	}
+}
+
+const char* primec_const_format(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	const primec_const_value_s value,
+	char* const buffer,
+	const uint64_t capacity)
+{
+	primec_debug_assert(buffer != NULL);
+	primec_debug_assert(capacity > 0);
+	const uint8_t kind = get_scalar_kind(table, type);
+
+	if (is_float_kind(kind))
+	{
+		(void)snprintf(buffer, capacity, "%g", value.fval);
+	}
+	else if (primec_type_kind_bool == kind)
+	{
+		(void)snprintf(buffer, capacity, "%s", value.uval != 0 ? "true" : "false");
+	}
+	else if (is_signed_kind(kind))
+	{
+		(void)snprintf(buffer, capacity, "%li", value.ival);
+	}
+	else
+	{
+		(void)snprintf(buffer, capacity, "%lu", value.uval);
+	}
+
+	return buffer;
+}
+
+static uint8_t get_scalar_kind(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	const primec_type_s* const record = primec_type_table_get(table, type);
+
+	// NOTE: Enums are folded as their underlying types.
+	if (primec_type_kind_enum == record->kind)
+	{
+		return primec_type_table_get(table, record->element)->kind;
+	}
+
+	return record->kind;
+}
+
+static uint8_t get_bits(
+	const uint8_t kind)
+{
+	switch (kind)
+	{
+		case primec_type_kind_bool: { return 1; } break;
+		case primec_type_kind_i8:
+		case primec_type_kind_u8:
+		case primec_type_kind_c8: { return 8; } break;
+		case primec_type_kind_i16:
+		case primec_type_kind_u16: { return 16; } break;
+		case primec_type_kind_i32:
+		case primec_type_kind_u32:
+		case primec_type_kind_f32: { return 32; } break;
+		default: { return 64; } break;
+	}
+}
+
+static bool is_signed_kind(
+	const uint8_t kind)
+{
+	return (kind >= primec_type_kind_i8 && kind <= primec_type_kind_i64) || primec_type_kind_untyped_int == kind;
+}
+
+static bool is_float_kind(
+	const uint8_t kind)
+{
+	return primec_type_kind_f32 == kind || primec_type_kind_f64 == kind || primec_type_kind_untyped_float == kind;
+}
+
+static bool fits(
+	const uint8_t kind,
+	const primec_const_value_s value)
+{
+	const uint8_t bits = get_bits(kind);
+	if (64 == bits || is_float_kind(kind)) { return true; }
+
+	if (is_signed_kind(kind))
+	{
+		const int64_t limit = (int64_t)1 << (bits - 1);
+		return value.ival >= -limit && value.ival < limit;
+	}
+
+	return value.uval < (uint64_t)1 << bits;
+}
+
+static primec_const_value_s truncate(
+	const uint8_t kind,
+	const primec_const_value_s value)
+{
+	const uint8_t bits = get_bits(kind);
+	if (64 == bits) { return value; }
+
+	primec_const_value_s truncated = {0};
+	truncated.uval = value.uval & (((uint64_t)1 << bits) - 1);
+
+	// NOTE: Signed values are sign extended back from their width.
+	if (is_signed_kind(kind) && (truncated.uval >> (bits - 1)) != 0)
+	{
+		truncated.uval |= ~(((uint64_t)1 << bits) - 1);
+	}
+
+	return truncated;
+}
+
+static primec_const_status_e finish(
+	const uint8_t kind,
+	const primec_const_value_s value,
+	primec_const_value_s* const result)
+{
+	if (!fits(kind, value))
+	{
+		return primec_const_status_overflow;
+	}
+
+	*result = value;
+	return primec_const_status_ok;
+}
+
+static primec_const_status_e fold_arithmetic(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right,
+	primec_const_value_s* const result)
+{
+	primec_const_value_s folded = {0};
+	bool overflow = false;
+
+	if ((primec_token_type_divide == operator || primec_token_type_modulus == operator) && 0 == right.uval)
+	{
+		return primec_const_status_division_by_zero;
+	}
+
+	if (is_signed_kind(kind))
+	{
+		switch (operator)
+		{
+			case primec_token_type_add: { overflow = __builtin_add_overflow(left.ival, right.ival, &folded.ival); } break;
+			case primec_token_type_subtract: { overflow = __builtin_sub_overflow(left.ival, right.ival, &folded.ival); } break;
+			case primec_token_type_multiply: { overflow = __builtin_mul_overflow(left.ival, right.ival, &folded.ival); } break;
+
+			case primec_token_type_divide:
+			{
+				overflow = INT64_MIN == left.ival && -1 == right.ival;
+				if (!overflow) { folded.ival = left.ival / right.ival; }
+			} break;
+
+			case primec_token_type_modulus:
+			{
+				// NOTE: The remainder overflows together with its quotient, as both
+				//       trap at the runtime.
+				const primec_const_value_s quotient = { .ival = INT64_MIN == left.ival ? left.ival : -left.ival };
+				overflow = -1 == right.ival && (INT64_MIN == left.ival || !fits(kind, quotient));
+				if (!overflow) { folded.ival = left.ival % right.ival; }
+			} break;
+
+			default:
+			{
+				primec_debug_assert(0);
+			} break;
+		}
+	}
+	else
+	{
+		switch (operator)
+		{
+			case primec_token_type_add: { overflow = __builtin_add_overflow(left.uval, right.uval, &folded.uval); } break;
+			case primec_token_type_subtract: { overflow = __builtin_sub_overflow(left.uval, right.uval, &folded.uval); } break;
+			case primec_token_type_multiply: { overflow = __builtin_mul_overflow(left.uval, right.uval, &folded.uval); } break;
+			case primec_token_type_divide: { folded.uval = left.uval / right.uval; } break;
+			case primec_token_type_modulus: { folded.uval = left.uval % right.uval; } break;
+
+			default:
+			{
+				primec_debug_assert(0);
+			} break;
+		}
+	}
+
+	if (overflow)
+	{
+		return primec_const_status_overflow;
+	}
+
+	return finish(kind, folded, result);
+}
+
+static primec_const_status_e fold_float(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right,
+	primec_const_value_s* const result)
+{
+	primec_const_value_s folded = {0};
+
+	switch (operator)
+	{
+		case primec_token_type_add: { folded.fval = left.fval + right.fval; } break;
+		case primec_token_type_subtract: { folded.fval = left.fval - right.fval; } break;
+		case primec_token_type_multiply: { folded.fval = left.fval * right.fval; } break;
+
+		case primec_token_type_divide:
+		{
+			if (0 == right.fval) { return primec_const_status_division_by_zero; }
+			folded.fval = left.fval / right.fval;
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	if (primec_type_kind_f32 == kind)
+	{
+		if (folded.fval > FLT_MAX || folded.fval < -FLT_MAX) { return primec_const_status_overflow; }
+		folded.fval = (double)(float)folded.fval;
+	}
+
+	if (isinf(folded.fval) && !isinf(left.fval) && !isinf(right.fval))
+	{
+		return primec_const_status_overflow;
+	}
+
+	*result = folded;
+	return primec_const_status_ok;
+}
+
+static primec_const_status_e fold_shift(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const uint8_t count_kind,
+	const primec_const_value_s count,
+	primec_const_value_s* const result)
+{
+	const uint8_t bits = get_bits(kind);
+
+	if ((is_signed_kind(count_kind) && count.ival < 0) || count.uval >= bits)
+	{
+		return primec_const_status_invalid_shift;
+	}
+
+	primec_const_value_s folded = {0};
+
+	if (primec_token_type_rshift == operator)
+	{
+		if (is_signed_kind(kind)) { folded.ival = left.ival >> count.uval; }
+		else { folded.uval = left.uval >> count.uval; }
+		*result = folded;
+		return primec_const_status_ok;
+	}
+
+	folded.uval = left.uval << count.uval;
+
+	// NOTE: Shifting bits of signed values out (or into the sign) is an overflow,
+	//       unsigned values are truncated.
+	if (is_signed_kind(kind))
+	{
+		if ((folded.ival >> count.uval) != left.ival) { return primec_const_status_overflow; }
+		return finish(kind, folded, result);
+	}
+
+	*result = truncate(kind, folded);
+	return primec_const_status_ok;
+}
+
+static bool fold_comparison(
+	const uint8_t kind,
+	const primec_token_type_e operator,
+	const primec_const_value_s left,
+	const primec_const_value_s right)
+{
+	int32_t order = 0;
+
+	if (is_float_kind(kind))
+	{
+		// NOTE: Comparisons with nans are all false but the inequality.
+		if (isnan(left.fval) || isnan(right.fval)) { return primec_token_type_not_equal == operator; }
+		order = left.fval < right.fval ? -1 : left.fval > right.fval ? 1 : 0;
+	}
+	else if (is_signed_kind(kind))
+	{
+		order = left.ival < right.ival ? -1 : left.ival > right.ival ? 1 : 0;
+	}
+	else
+	{
+		order = left.uval < right.uval ? -1 : left.uval > right.uval ? 1 : 0;
+	}
+
+	switch (operator)
+	{
+		case primec_token_type_equal: { return 0 == order; } break;
+		case primec_token_type_not_equal: { return order != 0; } break;
+		case primec_token_type_greater_than: { return order > 0; } break;
+		case primec_token_type_less_than: { return order < 0; } break;
+		case primec_token_type_greater_than_or_equal: { return order >= 0; } break;
+		case primec_token_type_less_than_or_equal: { return order <= 0; } break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return false;
+		} break;
+	}
+}
@@ -0,0 +1,152 @@
+
+/**
+ * @file dce.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/dce.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	primec_ir_func_s* func;
+	bool* is_live;
+	list_s worklist;
+} eliminator_s;
+
+static void eliminate_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static bool is_removable(
+	const primec_type_table_s* const types,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value);
+
+static void mark_live(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_dce_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		eliminate_func(program->types, func);
+	}
+}
+
+static void eliminate_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	const uint32_t values_count = func->instructions.count;
+	eliminator_s eliminator = { .func = func, .is_live = primec_utils_malloc(values_count * sizeof(bool)) };
+	primec_utils_memset(eliminator.is_live, 0, values_count * sizeof(bool));
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (is_removable(types, func, value)) { continue; }
+			eliminator.is_live[value] = true;
+			push(&eliminator.worklist, value);
+		}
+	}
+
+	while (eliminator.worklist.count > 0)
+	{
+		primec_ir_func_visit_operands(func, eliminator.worklist.data[--eliminator.worklist.count], mark_live, &eliminator);
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (!eliminator.is_live[value]) { primec_ir_func_get(func, value)->op = primec_ir_op_nop; continue; }
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+
+	primec_utils_free(eliminator.is_live);
+	primec_utils_free(eliminator.worklist.data);
+}
+
+static bool is_removable(
+	const primec_type_table_s* const types,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value)
+{
+	switch ((primec_ir_op_e)primec_ir_func_get(func, value)->op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_slot:
+		case primec_ir_op_load:
+		case primec_ir_op_phi:
+		{
+			return true;
+		} break;
+
+		default:
+		{
+			return primec_ir_is_pure(types, func, value);
+		} break;
+	}
+}
+
+static void mark_live(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	eliminator_s* const eliminator = context;
+	if (eliminator->is_live[*operand]) { return; }
+	eliminator->is_live[*operand] = true;
+	push(&eliminator->worklist, *operand);
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -0,0 +1,85 @@
+
+/**
+ * @file diagnostics.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/diagnostics.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/source_manager.h>
+
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+void primec_diagnostics_report(
+	primec_diagnostics_s* const diagnostics,
+	const primec_location_s location,
+	const char* const format,
+	...)
+{
+	primec_debug_assert(diagnostics != NULL);
+	primec_debug_assert(format != NULL);
+
+	if (diagnostics->count >= diagnostics->capacity)
+	{
+		diagnostics->capacity = 0 == diagnostics->capacity ? 8 : diagnostics->capacity * 2;
+		diagnostics->data = primec_utils_realloc(diagnostics->data, diagnostics->capacity * sizeof(primec_diagnostic_s));
+	}
+
+	va_list args; va_start(args, format);
+	const int32_t length = (int32_t)vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	char* const message = primec_utils_malloc((uint64_t)(length < 0 ? 0 : length) + 1);
+	va_start(args, format);
+	(void)vsnprintf(message, (uint64_t)(length < 0 ? 0 : length) + 1, format, args);
+	va_end(args);
+
+	diagnostics->data[diagnostics->count++] = (primec_diagnostic_s)
+	{
+		.location = location,
+		.message = message
+	};
+}
+
+uint32_t primec_diagnostics_flush(
+	primec_diagnostics_s* const diagnostics)
+{
+	primec_debug_assert(diagnostics != NULL);
+	const uint32_t count = diagnostics->count;
+
+	for (uint32_t index = 0; index < diagnostics->count; ++index)
+	{
+		const primec_diagnostic_s* const diagnostic = &diagnostics->data[index];
+		(void)fprintf(stderr, primec_location_fmt ": ", primec_location_arg(diagnostic->location));
+		primec_logger_error("%s", diagnostic->message);
+		primec_utils_free(diagnostic->message);
+	}
+
+	diagnostics->count = 0;
+	return count;
+}
+
+void primec_diagnostics_destroy(
+	primec_diagnostics_s* const diagnostics)
+{
+	primec_debug_assert(diagnostics != NULL);
+
+	for (uint32_t index = 0; index < diagnostics->count; ++index)
+	{
+		primec_utils_free(diagnostics->data[index].message);
+	}
+
+	primec_utils_free(diagnostics->data);
+	*diagnostics = (primec_diagnostics_s) {0};
+}
@@ -0,0 +1,1415 @@
+
+/**
+ * @file elf.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/elf.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/layout.h>
+#include <primec/string_pool.h>
+
+#include <stddef.h>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// NOTE: The exit function of the C library, called by the _start of objects.
+#define symbol_exit (primec_x86_64_symbol_string + 1)
+
+#define image_base UINT64_C(0x400000)
+#define page_size UINT64_C(0x1000)
+#define func_alignment 16
+#define max_segments 6
+
+// NOTE: The dynamic executables import their external functions from the C
+//       library, through the stubs, that jump through their slots of the
+//       global offset table: jmp [rip+slot]; int3; int3
+#define interpreter "/lib64/ld-linux-x86-64.so.2"
+#define library "libc.so.6"
+#define stub_size 8
+#define dynamic_entries_count 10
+
+// NOTE: The syscall function of the runtime, that moves the number of the call
+//       and its arguments from the registers of the calling convention to the
+//       ones of the kernel: mov rax, rdi; mov rdi, rsi; mov rsi, rdx; mov rdx,
+//       rcx; mov r10, r8; mov r8, r9; mov r9, [rsp+8]; syscall; ret
+static const uint8_t g_syscall_stub[] =
+{
+	0x48, 0x89, 0xf8, 0x48, 0x89, 0xf7, 0x48, 0x89, 0xd6, 0x48, 0x89, 0xca, 0x4d, 0x89, 0xc2,
+	0x4d, 0x89, 0xc8, 0x4c, 0x8b, 0x4c, 0x24, 0x08, 0x0f, 0x05, 0xc3
+};
+
+typedef enum
+{
+	section_null,
+	section_text,
+	section_rodata,
+	section_data,
+	section_bss,
+	section_note_stack,
+	section_symtab,
+	section_strtab,
+	section_shstrtab,
+	section_rela_text,
+	section_rela_data,
+	sections_count
+} section_e;
+
+// NOTE: Sections of the dynamic executables, that follow the ones of the static
+//       executables, in the place of the relocations of the objects.
+typedef enum
+{
+	section_interp = section_rela_text,
+	section_hash,
+	section_dynsym,
+	section_dynstr,
+	section_rela_dyn,
+	section_dynamic,
+	section_got,
+	dynamic_sections_count
+} dynamic_section_e;
+
+typedef struct
+{
+	uint8_t* data;
+	uint64_t capacity;
+	uint64_t count;
+} buffer_s;
+
+typedef struct
+{
+	primec_x86_64_relocation_s* data;
+	uint32_t capacity;
+	uint32_t count;
+} relocations_s;
+
+typedef struct
+{
+	const primec_x86_64_module_s* module;
+	bool is_static;
+	bool has_start;
+
+	buffer_s text;
+	buffer_s rodata;
+	buffer_s data;
+	uint64_t bss_size;
+	uint64_t data_alignment;
+	uint64_t bss_alignment;
+
+	uint64_t* func_offsets;		// offsets in the text, or UINT64_MAX for the external functions
+	uint64_t* global_offsets;	// offsets in their sections
+	uint8_t* global_sections;
+	primec_string_pool_s strings;	// offsets in the rodata
+
+	relocations_s text_relocations;
+	relocations_s data_relocations;
+
+	// NOTE: Imports of the dynamic executables, the external functions and the
+	//       exit function, whose stubs follow the functions in the text.
+	uint32_t* func_imports;		// indices of the imports, or UINT32_MAX for the other functions
+	uint32_t* imports;			// functions of the imports, or UINT32_MAX for the exit function
+	uint32_t imports_count;
+	uint32_t exit_import;
+	uint64_t stubs_offset;
+
+	// NOTE: Addresses of the sections, only for the executables.
+	uint64_t addresses[sections_count];
+} image_s;
+
+typedef struct
+{
+	buffer_s tables;			// interpreter, hash, symbols, names and relocations
+	buffer_s entries;
+	uint64_t hash_offset;
+	uint64_t symbols_offset;
+	uint64_t names_offset;
+	uint64_t names_size;
+	uint64_t relocations_offset;
+	uint32_t library_name;
+} dynamic_s;
+
+typedef struct
+{
+	buffer_s symbols;
+	buffer_s names;
+	uint32_t* func_symbols;
+	uint32_t* global_symbols;
+	uint32_t start_symbol;
+	uint32_t exit_symbol;
+	uint32_t first_global;
+} symbols_s;
+
+static void build_image(
+	image_s* const image,
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const bool is_static);
+
+static void destroy_image(
+	image_s* const image);
+
+static void build_start(
+	image_s* const image,
+	const uint32_t entry);
+
+static void build_globals(
+	image_s* const image);
+
+static void collect_imports(
+	image_s* const image,
+	const primec_x86_64_module_s* const module);
+
+static void build_dynamic(
+	image_s* const image,
+	dynamic_s* const dynamic);
+
+static void link_dynamic(
+	image_s* const image,
+	dynamic_s* const dynamic,
+	const uint64_t tables_address,
+	const uint64_t got_address);
+
+static void build_symbols(
+	const image_s* const image,
+	symbols_s* const symbols);
+
+static void add_symbol(
+	symbols_s* const symbols,
+	const char* const name,
+	const uint8_t info,
+	const uint16_t section,
+	const uint64_t value,
+	const uint64_t size);
+
+static uint32_t add_name(
+	buffer_s* const names,
+	const char* const name);
+
+static bool resolve(
+	image_s* const image,
+	const section_e section,
+	const relocations_s* const relocations);
+
+static bool get_symbol_address(
+	const image_s* const image,
+	const primec_x86_64_relocation_s* const relocation,
+	uint64_t* const address);
+
+static void write_relocations(
+	const image_s* const image,
+	const symbols_s* const symbols,
+	const relocations_s* const relocations,
+	buffer_s* const output);
+
+static void write_section_header(
+	buffer_s* const output,
+	const uint64_t offset,
+	const Elf64_Shdr header);
+
+static bool write_file(
+	const char* const path,
+	const buffer_s* const output,
+	const uint32_t mode);
+
+static void append(
+	buffer_s* const buffer,
+	const void* const data,
+	const uint64_t size);
+
+static void append_zeros(
+	buffer_s* const buffer,
+	const uint64_t size);
+
+static void align_buffer(
+	buffer_s* const buffer,
+	const uint64_t alignment,
+	const uint8_t fill);
+
+static void add_relocation(
+	relocations_s* const relocations,
+	const primec_x86_64_relocation_s relocation);
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment);
+
+bool primec_elf_write_object(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const path)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(path != NULL);
+
+	image_s image = {0};
+	build_image(&image, module, entry, !primec_x86_64_calls_externs(module));
+
+	symbols_s symbols = {0};
+	build_symbols(&image, &symbols);
+
+	buffer_s shstrtab = {0};
+	uint32_t names[sections_count] = {0};
+	static const char* const section_names[sections_count] =
+	{
+		[section_null] = "",
+		[section_text] = ".text",
+		[section_rodata] = ".rodata",
+		[section_data] = ".data",
+		[section_bss] = ".bss",
+		[section_note_stack] = ".note.GNU-stack",
+		[section_symtab] = ".symtab",
+		[section_strtab] = ".strtab",
+		[section_shstrtab] = ".shstrtab",
+		[section_rela_text] = ".rela.text",
+		[section_rela_data] = ".rela.data"
+	};
+
+	for (uint32_t section = 0; section < sections_count; ++section)
+	{
+		names[section] = add_name(&shstrtab, section_names[section]);
+	}
+
+	buffer_s rela_text = {0};
+	buffer_s rela_data = {0};
+	write_relocations(&image, &symbols, &image.text_relocations, &rela_text);
+	write_relocations(&image, &symbols, &image.data_relocations, &rela_data);
+
+	// NOTE: The sections follow the header in their order, and the section
+	//       headers come last.
+	buffer_s output = {0};
+	append_zeros(&output, sizeof(Elf64_Ehdr));
+	uint64_t offsets[sections_count] = {0};
+
+	const buffer_s* const contents[sections_count] =
+	{
+		[section_text] = &image.text,
+		[section_rodata] = &image.rodata,
+		[section_data] = &image.data,
+		[section_symtab] = &symbols.symbols,
+		[section_strtab] = &symbols.names,
+		[section_shstrtab] = &shstrtab,
+		[section_rela_text] = &rela_text,
+		[section_rela_data] = &rela_data
+	};
+
+	for (uint32_t section = 1; section < sections_count; ++section)
+	{
+		if (NULL == contents[section]) { offsets[section] = output.count; continue; }
+		align_buffer(&output, 16, 0);
+		offsets[section] = output.count;
+		append(&output, contents[section]->data, contents[section]->count);
+	}
+
+	align_buffer(&output, 8, 0);
+	const uint64_t headers_offset = output.count;
+	append_zeros(&output, sections_count * sizeof(Elf64_Shdr));
+
+	const Elf64_Shdr headers[sections_count] =
+	{
+		[section_text] =
+		{
+			.sh_name = names[section_text], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC | SHF_EXECINSTR,
+			.sh_offset = offsets[section_text], .sh_size = image.text.count, .sh_addralign = func_alignment
+		},
+		[section_rodata] =
+		{
+			.sh_name = names[section_rodata], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC,
+			.sh_offset = offsets[section_rodata], .sh_size = image.rodata.count, .sh_addralign = 1
+		},
+		[section_data] =
+		{
+			.sh_name = names[section_data], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_offset = offsets[section_data], .sh_size = image.data.count, .sh_addralign = image.data_alignment
+		},
+		[section_bss] =
+		{
+			.sh_name = names[section_bss], .sh_type = SHT_NOBITS, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_offset = offsets[section_bss], .sh_size = image.bss_size, .sh_addralign = image.bss_alignment
+		},
+		[section_note_stack] =
+		{
+			.sh_name = names[section_note_stack], .sh_type = SHT_PROGBITS,
+			.sh_offset = offsets[section_note_stack], .sh_addralign = 1
+		},
+		[section_symtab] =
+		{
+			.sh_name = names[section_symtab], .sh_type = SHT_SYMTAB, .sh_offset = offsets[section_symtab],
+			.sh_size = symbols.symbols.count, .sh_link = section_strtab, .sh_info = symbols.first_global,
+			.sh_addralign = 8, .sh_entsize = sizeof(Elf64_Sym)
+		},
+		[section_strtab] =
+		{
+			.sh_name = names[section_strtab], .sh_type = SHT_STRTAB,
+			.sh_offset = offsets[section_strtab], .sh_size = symbols.names.count, .sh_addralign = 1
+		},
+		[section_shstrtab] =
+		{
+			.sh_name = names[section_shstrtab], .sh_type = SHT_STRTAB,
+			.sh_offset = offsets[section_shstrtab], .sh_size = shstrtab.count, .sh_addralign = 1
+		},
+		[section_rela_text] =
+		{
+			.sh_name = names[section_rela_text], .sh_type = SHT_RELA, .sh_flags = SHF_INFO_LINK,
+			.sh_offset = offsets[section_rela_text], .sh_size = rela_text.count, .sh_link = section_symtab,
+			.sh_info = section_text, .sh_addralign = 8, .sh_entsize = sizeof(Elf64_Rela)
+		},
+		[section_rela_data] =
+		{
+			.sh_name = names[section_rela_data], .sh_type = SHT_RELA, .sh_flags = SHF_INFO_LINK,
+			.sh_offset = offsets[section_rela_data], .sh_size = rela_data.count, .sh_link = section_symtab,
+			.sh_info = section_data, .sh_addralign = 8, .sh_entsize = sizeof(Elf64_Rela)
+		}
+	};
+
+	for (uint32_t section = 0; section < sections_count; ++section)
+	{
+		write_section_header(&output, headers_offset + section * sizeof(Elf64_Shdr), headers[section]);
+	}
+
+	const Elf64_Ehdr header =
+	{
+		.e_ident = { ELFMAG0, ELFMAG1, ELFMAG2, ELFMAG3, ELFCLASS64, ELFDATA2LSB, EV_CURRENT, ELFOSABI_SYSV },
+		.e_type = ET_REL,
+		.e_machine = EM_X86_64,
+		.e_version = EV_CURRENT,
+		.e_shoff = headers_offset,
+		.e_ehsize = sizeof(Elf64_Ehdr),
+		.e_shentsize = sizeof(Elf64_Shdr),
+		.e_shnum = sections_count,
+		.e_shstrndx = section_shstrtab
+	};
+
+	primec_utils_memcpy(output.data, &header, sizeof(header));
+	const bool is_written = write_file(path, &output, 0644);
+
+	primec_utils_free(output.data);
+	primec_utils_free(rela_text.data);
+	primec_utils_free(rela_data.data);
+	primec_utils_free(shstrtab.data);
+	primec_utils_free(symbols.symbols.data);
+	primec_utils_free(symbols.names.data);
+	primec_utils_free(symbols.func_symbols);
+	primec_utils_free(symbols.global_symbols);
+	destroy_image(&image);
+	return is_written;
+}
+
+bool primec_elf_write_executable(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const path)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(path != NULL);
+	primec_debug_assert(entry < module->program->funcs.count);
+
+	image_s image = {0};
+	collect_imports(&image, module);
+	const bool is_dynamic = image.imports_count > 0;
+	build_image(&image, module, entry, !is_dynamic);
+
+	dynamic_s dynamic = {0};
+
+	if (is_dynamic)
+	{
+		build_dynamic(&image, &dynamic);
+	}
+
+	// NOTE: The text segment maps the headers and the tables of the dynamic
+	//       linker too, while the other segments start at their own pages, so
+	//       their permissions can differ. The dynamic section and the global
+	//       offset table precede the data.
+	const uint64_t headers_size = sizeof(Elf64_Ehdr) + max_segments * sizeof(Elf64_Phdr);
+	const uint64_t tables_offset = align_up(headers_size, 8);
+	const uint64_t text_offset = align_up(tables_offset + dynamic.tables.count, func_alignment);
+	const uint64_t rodata_offset = align_up(text_offset + image.text.count, page_size);
+	const uint64_t data_offset = align_up(rodata_offset + image.rodata.count, page_size);
+	const uint64_t got_start = dynamic.entries.count;
+	const uint64_t data_start = align_up(got_start + image.imports_count * sizeof(uint64_t), image.data_alignment);
+	const uint64_t bss_start = align_up(data_start + image.data.count, image.bss_alignment);
+
+	image.addresses[section_text] = image_base + text_offset;
+	image.addresses[section_rodata] = image_base + rodata_offset;
+	image.addresses[section_data] = image_base + data_offset + data_start;
+	image.addresses[section_bss] = image_base + data_offset + bss_start;
+
+	if (!resolve(&image, section_text, &image.text_relocations) ||
+		!resolve(&image, section_data, &image.data_relocations))
+	{
+		primec_utils_free(dynamic.tables.data);
+		primec_utils_free(dynamic.entries.data);
+		destroy_image(&image);
+		return false;
+	}
+
+	if (is_dynamic)
+	{
+		link_dynamic(&image, &dynamic, image_base + tables_offset, image_base + data_offset + got_start);
+	}
+
+	symbols_s symbols = {0};
+	build_symbols(&image, &symbols);
+
+	buffer_s shstrtab = {0};
+	const uint16_t headers_count = is_dynamic ? dynamic_sections_count : section_rela_text;
+	uint32_t names[dynamic_sections_count] = {0};
+	static const char* const section_names[dynamic_sections_count] =
+	{
+		[section_null] = "",
+		[section_text] = ".text",
+		[section_rodata] = ".rodata",
+		[section_data] = ".data",
+		[section_bss] = ".bss",
+		[section_note_stack] = ".note.GNU-stack",
+		[section_symtab] = ".symtab",
+		[section_strtab] = ".strtab",
+		[section_shstrtab] = ".shstrtab",
+		[section_interp] = ".interp",
+		[section_hash] = ".hash",
+		[section_dynsym] = ".dynsym",
+		[section_dynstr] = ".dynstr",
+		[section_rela_dyn] = ".rela.dyn",
+		[section_dynamic] = ".dynamic",
+		[section_got] = ".got"
+	};
+
+	for (uint32_t section = 0; section < headers_count; ++section)
+	{
+		names[section] = add_name(&shstrtab, section_names[section]);
+	}
+
+	// NOTE: The slots of the global offset table are filled by the dynamic
+	//       linker, so they are left zeroed in the file.
+	buffer_s output = {0};
+	append_zeros(&output, tables_offset);
+	append(&output, dynamic.tables.data, dynamic.tables.count);
+	append_zeros(&output, text_offset - output.count);
+	append(&output, image.text.data, image.text.count);
+	append_zeros(&output, rodata_offset - output.count);
+	append(&output, image.rodata.data, image.rodata.count);
+	append_zeros(&output, data_offset - output.count);
+	append(&output, dynamic.entries.data, dynamic.entries.count);
+	append_zeros(&output, data_offset + data_start - output.count);
+	append(&output, image.data.data, image.data.count);
+
+	align_buffer(&output, 8, 0);
+	const uint64_t symtab_offset = output.count;
+	append(&output, symbols.symbols.data, symbols.symbols.count);
+	const uint64_t strtab_offset = output.count;
+	append(&output, symbols.names.data, symbols.names.count);
+	const uint64_t shstrtab_offset = output.count;
+	append(&output, shstrtab.data, shstrtab.count);
+
+	align_buffer(&output, 8, 0);
+	const uint64_t headers_offset = output.count;
+	append_zeros(&output, headers_count * sizeof(Elf64_Shdr));
+
+	const uint64_t tables_address = image_base + tables_offset;
+	const uint64_t got_size = image.imports_count * sizeof(uint64_t);
+	const Elf64_Shdr headers[dynamic_sections_count] =
+	{
+		[section_text] =
+		{
+			.sh_name = names[section_text], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC | SHF_EXECINSTR,
+			.sh_addr = image.addresses[section_text], .sh_offset = text_offset, .sh_size = image.text.count,
+			.sh_addralign = func_alignment
+		},
+		[section_rodata] =
+		{
+			.sh_name = names[section_rodata], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC,
+			.sh_addr = image.addresses[section_rodata], .sh_offset = rodata_offset, .sh_size = image.rodata.count,
+			.sh_addralign = 1
+		},
+		[section_data] =
+		{
+			.sh_name = names[section_data], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_addr = image.addresses[section_data], .sh_offset = data_offset + data_start, .sh_size = image.data.count,
+			.sh_addralign = image.data_alignment
+		},
+		[section_bss] =
+		{
+			.sh_name = names[section_bss], .sh_type = SHT_NOBITS, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_addr = image.addresses[section_bss], .sh_offset = data_offset + bss_start, .sh_size = image.bss_size,
+			.sh_addralign = image.bss_alignment
+		},
+		[section_note_stack] =
+		{
+			.sh_name = names[section_note_stack], .sh_type = SHT_PROGBITS, .sh_offset = symtab_offset, .sh_addralign = 1
+		},
+		[section_symtab] =
+		{
+			.sh_name = names[section_symtab], .sh_type = SHT_SYMTAB, .sh_offset = symtab_offset,
+			.sh_size = symbols.symbols.count, .sh_link = section_strtab, .sh_info = symbols.first_global,
+			.sh_addralign = 8, .sh_entsize = sizeof(Elf64_Sym)
+		},
+		[section_strtab] =
+		{
+			.sh_name = names[section_strtab], .sh_type = SHT_STRTAB, .sh_offset = strtab_offset,
+			.sh_size = symbols.names.count, .sh_addralign = 1
+		},
+		[section_shstrtab] =
+		{
+			.sh_name = names[section_shstrtab], .sh_type = SHT_STRTAB, .sh_offset = shstrtab_offset,
+			.sh_size = shstrtab.count, .sh_addralign = 1
+		},
+		[section_interp] =
+		{
+			.sh_name = names[section_interp], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC, .sh_addr = tables_address,
+			.sh_offset = tables_offset, .sh_size = sizeof(interpreter), .sh_addralign = 1
+		},
+		[section_hash] =
+		{
+			.sh_name = names[section_hash], .sh_type = SHT_HASH, .sh_flags = SHF_ALLOC,
+			.sh_addr = tables_address + dynamic.hash_offset, .sh_offset = tables_offset + dynamic.hash_offset,
+			.sh_size = dynamic.symbols_offset - dynamic.hash_offset, .sh_link = section_dynsym, .sh_addralign = 8,
+			.sh_entsize = sizeof(uint32_t)
+		},
+		[section_dynsym] =
+		{
+			.sh_name = names[section_dynsym], .sh_type = SHT_DYNSYM, .sh_flags = SHF_ALLOC,
+			.sh_addr = tables_address + dynamic.symbols_offset, .sh_offset = tables_offset + dynamic.symbols_offset,
+			.sh_size = dynamic.names_offset - dynamic.symbols_offset, .sh_link = section_dynstr, .sh_info = 1,
+			.sh_addralign = 8, .sh_entsize = sizeof(Elf64_Sym)
+		},
+		[section_dynstr] =
+		{
+			.sh_name = names[section_dynstr], .sh_type = SHT_STRTAB, .sh_flags = SHF_ALLOC,
+			.sh_addr = tables_address + dynamic.names_offset, .sh_offset = tables_offset + dynamic.names_offset,
+			.sh_size = dynamic.names_size, .sh_addralign = 1
+		},
+		[section_rela_dyn] =
+		{
+			.sh_name = names[section_rela_dyn], .sh_type = SHT_RELA, .sh_flags = SHF_ALLOC,
+			.sh_addr = tables_address + dynamic.relocations_offset, .sh_offset = tables_offset + dynamic.relocations_offset,
+			.sh_size = image.imports_count * sizeof(Elf64_Rela), .sh_link = section_dynsym, .sh_addralign = 8,
+			.sh_entsize = sizeof(Elf64_Rela)
+		},
+		[section_dynamic] =
+		{
+			.sh_name = names[section_dynamic], .sh_type = SHT_DYNAMIC, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_addr = image_base + data_offset, .sh_offset = data_offset, .sh_size = dynamic.entries.count,
+			.sh_link = section_dynstr, .sh_addralign = 8, .sh_entsize = sizeof(Elf64_Dyn)
+		},
+		[section_got] =
+		{
+			.sh_name = names[section_got], .sh_type = SHT_PROGBITS, .sh_flags = SHF_ALLOC | SHF_WRITE,
+			.sh_addr = image_base + data_offset + got_start, .sh_offset = data_offset + got_start, .sh_size = got_size,
+			.sh_addralign = 8, .sh_entsize = sizeof(uint64_t)
+		}
+	};
+
+	for (uint32_t section = 0; section < headers_count; ++section)
+	{
+		write_section_header(&output, headers_offset + section * sizeof(Elf64_Shdr), headers[section]);
+	}
+
+	// NOTE: Empty segments are left out, except the text one, that holds the
+	//       headers and the _start. The interpreter precedes the loaded ones.
+	Elf64_Phdr segments[max_segments] = {0};
+	uint16_t segments_count = 0;
+
+	if (is_dynamic)
+	{
+		segments[segments_count++] = (Elf64_Phdr)
+		{
+			.p_type = PT_INTERP, .p_flags = PF_R, .p_offset = tables_offset, .p_vaddr = image_base + tables_offset,
+			.p_paddr = image_base + tables_offset, .p_filesz = sizeof(interpreter), .p_memsz = sizeof(interpreter), .p_align = 1
+		};
+	}
+
+	segments[segments_count++] = (Elf64_Phdr)
+	{
+		.p_type = PT_LOAD, .p_flags = PF_R | PF_X, .p_offset = 0, .p_vaddr = image_base, .p_paddr = image_base,
+		.p_filesz = text_offset + image.text.count, .p_memsz = text_offset + image.text.count, .p_align = page_size
+	};
+
+	if (image.rodata.count > 0)
+	{
+		segments[segments_count++] = (Elf64_Phdr)
+		{
+			.p_type = PT_LOAD, .p_flags = PF_R, .p_offset = rodata_offset,
+			.p_vaddr = image.addresses[section_rodata], .p_paddr = image.addresses[section_rodata],
+			.p_filesz = image.rodata.count, .p_memsz = image.rodata.count, .p_align = page_size
+		};
+	}
+
+	if (data_start + image.data.count + image.bss_size > 0)
+	{
+		segments[segments_count++] = (Elf64_Phdr)
+		{
+			.p_type = PT_LOAD, .p_flags = PF_R | PF_W, .p_offset = data_offset,
+			.p_vaddr = image_base + data_offset, .p_paddr = image_base + data_offset,
+			.p_filesz = data_start + image.data.count, .p_memsz = bss_start + image.bss_size, .p_align = page_size
+		};
+	}
+
+	if (is_dynamic)
+	{
+		segments[segments_count++] = (Elf64_Phdr)
+		{
+			.p_type = PT_DYNAMIC, .p_flags = PF_R | PF_W, .p_offset = data_offset, .p_vaddr = image_base + data_offset,
+			.p_paddr = image_base + data_offset, .p_filesz = dynamic.entries.count, .p_memsz = dynamic.entries.count, .p_align = 8
+		};
+	}
+
+	segments[segments_count++] = (Elf64_Phdr) { .p_type = PT_GNU_STACK, .p_flags = PF_R | PF_W, .p_align = 16 };
+
+	const Elf64_Ehdr header =
+	{
+		.e_ident = { ELFMAG0, ELFMAG1, ELFMAG2, ELFMAG3, ELFCLASS64, ELFDATA2LSB, EV_CURRENT, ELFOSABI_SYSV },
+		.e_type = ET_EXEC,
+		.e_machine = EM_X86_64,
+		.e_version = EV_CURRENT,
+		.e_entry = image.addresses[section_text],
+		.e_phoff = sizeof(Elf64_Ehdr),
+		.e_shoff = headers_offset,
+		.e_ehsize = sizeof(Elf64_Ehdr),
+		.e_phentsize = sizeof(Elf64_Phdr),
+		.e_phnum = segments_count,
+		.e_shentsize = sizeof(Elf64_Shdr),
+		.e_shnum = headers_count,
+		.e_shstrndx = section_shstrtab
+	};
+
+	primec_utils_memcpy(output.data, &header, sizeof(header));
+	primec_utils_memcpy(output.data + sizeof(header), segments, segments_count * sizeof(Elf64_Phdr));
+	const bool is_written = write_file(path, &output, 0755);
+
+	primec_utils_free(output.data);
+	primec_utils_free(dynamic.tables.data);
+	primec_utils_free(dynamic.entries.data);
+	primec_utils_free(shstrtab.data);
+	primec_utils_free(symbols.symbols.data);
+	primec_utils_free(symbols.names.data);
+	primec_utils_free(symbols.func_symbols);
+	primec_utils_free(symbols.global_symbols);
+	destroy_image(&image);
+	return is_written;
+}
+
+static void build_image(
+	image_s* const image,
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const bool is_static)
+{
+	const primec_ir_program_s* const program = module->program;
+	const uint32_t funcs_count = program->funcs.count;
+
+	image->module = module;
+	image->is_static = is_static;
+	image->has_start = entry != UINT32_MAX;
+	image->data_alignment = 1;
+	image->bss_alignment = 1;
+	image->func_offsets = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(uint64_t));
+	image->strings = primec_string_pool_from_program(program);
+
+	if (image->has_start)
+	{
+		build_start(image, entry);
+	}
+
+	for (uint32_t index = 0; index < funcs_count; ++index)
+	{
+		if (index == program->syscall)
+		{
+			align_buffer(&image->text, func_alignment, 0xcc);
+			image->func_offsets[index] = image->text.count;
+			append(&image->text, g_syscall_stub, sizeof(g_syscall_stub));
+			continue;
+		}
+
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern)
+		{
+			image->func_offsets[index] = UINT64_MAX;
+			continue;
+		}
+
+		const primec_x86_64_func_s* const func = &module->funcs[index];
+		align_buffer(&image->text, func_alignment, 0xcc);
+		image->func_offsets[index] = image->text.count;
+
+		for (uint32_t relocation = 0; relocation < func->relocations.count; ++relocation)
+		{
+			primec_x86_64_relocation_s record = func->relocations.data[relocation];
+			record.offset += image->text.count;
+			add_relocation(&image->text_relocations, record);
+		}
+
+		append(&image->text, func->bytes.data, func->bytes.count);
+	}
+
+	append(&image->rodata, image->strings.data, image->strings.size);
+
+	build_globals(image);
+}
+
+static void destroy_image(
+	image_s* const image)
+{
+	primec_utils_free(image->text.data);
+	primec_utils_free(image->rodata.data);
+	primec_utils_free(image->data.data);
+	primec_utils_free(image->func_offsets);
+	primec_utils_free(image->global_offsets);
+	primec_utils_free(image->global_sections);
+	primec_string_pool_destroy(&image->strings);
+	primec_utils_free(image->text_relocations.data);
+	primec_utils_free(image->data_relocations.data);
+	primec_utils_free(image->func_imports);
+	primec_utils_free(image->imports);
+}
+
+static void build_start(
+	image_s* const image,
+	const uint32_t entry)
+{
+	const primec_ir_program_s* const program = image->module->program;
+	const bool returns_value = primec_type_table_get(program->types, program->funcs.data[entry]->type)->element != primec_type_void;
+
+	// NOTE: xor ebp, ebp; call entry
+	static const uint8_t call[] = { 0x31, 0xed, 0xe8 };
+	append(&image->text, call, sizeof(call));
+	add_relocation(&image->text_relocations, (primec_x86_64_relocation_s)
+	{
+		.offset = image->text.count,
+		.type = primec_x86_64_relocation_plt32,
+		.symbol_kind = primec_x86_64_symbol_func,
+		.symbol = entry,
+		.addend = -4
+	});
+	append_zeros(&image->text, 4);
+
+	if (program->flush != UINT32_MAX)
+	{
+		// NOTE: The status is kept in ebx, which the flush of the runtime
+		//       preserves: mov ebx, eax (or xor ebx, ebx); call flush; mov
+		//       edi, ebx
+		static const uint8_t status[] = { 0x89, 0xc3 };
+		static const uint8_t no_status[] = { 0x31, 0xdb };
+		static const uint8_t call_flush[] = { 0xe8 };
+		append(&image->text, returns_value ? status : no_status, 2);
+		append(&image->text, call_flush, sizeof(call_flush));
+		add_relocation(&image->text_relocations, (primec_x86_64_relocation_s)
+		{
+			.offset = image->text.count,
+			.type = primec_x86_64_relocation_plt32,
+			.symbol_kind = primec_x86_64_symbol_func,
+			.symbol = program->flush,
+			.addend = -4
+		});
+		append_zeros(&image->text, 4);
+
+		static const uint8_t restore[] = { 0x89, 0xdf };
+		append(&image->text, restore, sizeof(restore));
+	}
+	else
+	{
+		// NOTE: mov edi, eax (or xor edi, edi)
+		static const uint8_t status[] = { 0x89, 0xc7 };
+		static const uint8_t no_status[] = { 0x31, 0xff };
+		append(&image->text, returns_value ? status : no_status, 2);
+	}
+
+	if (image->is_static)
+	{
+		// NOTE: mov eax, 60 (exit); syscall
+		static const uint8_t exit[] = { 0xb8, 0x3c, 0x00, 0x00, 0x00, 0x0f, 0x05 };
+		append(&image->text, exit, sizeof(exit));
+	}
+	else
+	{
+		// NOTE: call exit, which flushes the streams of the C library.
+		static const uint8_t exit[] = { 0xe8 };
+		append(&image->text, exit, sizeof(exit));
+		add_relocation(&image->text_relocations, (primec_x86_64_relocation_s)
+		{
+			.offset = image->text.count,
+			.type = primec_x86_64_relocation_plt32,
+			.symbol_kind = symbol_exit,
+			.addend = -4
+		});
+		append_zeros(&image->text, 4);
+	}
+
+	static const uint8_t trap[] = { 0x0f, 0x0b };
+	append(&image->text, trap, sizeof(trap));
+}
+
+static void build_globals(
+	image_s* const image)
+{
+	const primec_ir_program_s* const program = image->module->program;
+	const primec_type_table_s* const types = program->types;
+	const uint32_t globals_count = program->globals.count > 0 ? program->globals.count : 1;
+
+	image->global_offsets = primec_utils_malloc(globals_count * sizeof(uint64_t));
+	image->global_sections = primec_utils_malloc(globals_count * sizeof(uint8_t));
+
+	// NOTE: Globals without initializers take no space in the file.
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_ir_global_s* const global = &program->globals.data[index];
+		const primec_layout_s layout = primec_layout_get(types, global->type);
+		const uint64_t size = layout.size > 0 ? layout.size : 1;
+
+		if (primec_ir_global_init_zero == global->init)
+		{
+			image->bss_size = align_up(image->bss_size, layout.alignment);
+			image->global_offsets[index] = image->bss_size;
+			image->global_sections[index] = section_bss;
+			image->bss_size += size;
+			if (layout.alignment > image->bss_alignment) { image->bss_alignment = layout.alignment; }
+			continue;
+		}
+
+		align_buffer(&image->data, layout.alignment, 0);
+		image->global_offsets[index] = image->data.count;
+		image->global_sections[index] = section_data;
+		if (layout.alignment > image->data_alignment) { image->data_alignment = layout.alignment; }
+
+		if (primec_ir_global_init_const == global->init)
+		{
+			uint64_t bits = global->value.uval;
+
+			if (primec_type_is_float(types, global->type) && 4 == size)
+			{
+				const float narrow = (float)global->value.fval;
+				uint32_t narrow_bits = 0;
+				primec_utils_memcpy(&narrow_bits, &narrow, sizeof(narrow_bits));
+				bits = narrow_bits;
+			}
+
+			uint8_t bytes[8] = {0};
+			for (uint32_t byte = 0; byte < 8; ++byte) { bytes[byte] = (uint8_t)(bits >> (8 * byte)); }
+			append(&image->data, bytes, size < 8 ? size : 8);
+			if (size > 8) { append_zeros(&image->data, size - 8); }
+			continue;
+		}
+
+		// NOTE: Strings are pointers to their characters, followed by their
+		//       lengths when they are slices.
+		add_relocation(&image->data_relocations, (primec_x86_64_relocation_s)
+		{
+			.offset = image->data.count,
+			.type = primec_x86_64_relocation_64,
+			.symbol_kind = primec_x86_64_symbol_string,
+			.symbol = global->string
+		});
+		append_zeros(&image->data, 8);
+
+		if (size > 8)
+		{
+			const uint64_t length = program->strings.data[global->string].length;
+			uint8_t bytes[8] = {0};
+			for (uint32_t byte = 0; byte < 8; ++byte) { bytes[byte] = (uint8_t)(length >> (8 * byte)); }
+			append(&image->data, bytes, sizeof(bytes));
+			if (size > 16) { append_zeros(&image->data, size - 16); }
+		}
+	}
+}
+
+static void collect_imports(
+	image_s* const image,
+	const primec_x86_64_module_s* const module)
+{
+	const primec_ir_program_s* const program = module->program;
+	const uint32_t funcs_count = program->funcs.count > 0 ? program->funcs.count : 1;
+
+	image->func_imports = primec_utils_malloc(funcs_count * sizeof(uint32_t));
+	image->imports = primec_utils_malloc((funcs_count + 1) * sizeof(uint32_t));
+	image->exit_import = UINT32_MAX;
+	primec_utils_memset(image->func_imports, 0xff, funcs_count * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_x86_64_func_s* const func = &module->funcs[index];
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+
+		for (uint32_t relocation = 0; relocation < func->relocations.count; ++relocation)
+		{
+			const primec_x86_64_relocation_s* const record = &func->relocations.data[relocation];
+			// NOTE: The syscall of the runtime is a stub of the module itself.
+			if (record->symbol_kind != primec_x86_64_symbol_func || record->symbol == program->syscall) { continue; }
+			if (0 == (program->funcs.data[record->symbol]->flags & primec_ir_func_flag_extern)) { continue; }
+			if (image->func_imports[record->symbol] != UINT32_MAX) { continue; }
+
+			image->func_imports[record->symbol] = image->imports_count;
+			image->imports[image->imports_count++] = record->symbol;
+		}
+	}
+
+	// NOTE: The _start of the dynamic executables exits by the C library, so
+	//       its streams are flushed.
+	if (image->imports_count > 0)
+	{
+		image->exit_import = image->imports_count;
+		image->imports[image->imports_count++] = UINT32_MAX;
+	}
+}
+
+static void build_dynamic(
+	image_s* const image,
+	dynamic_s* const dynamic)
+{
+	const primec_x86_64_module_s* const module = image->module;
+	const uint32_t symbols_count = image->imports_count + 1;
+
+	align_buffer(&image->text, stub_size, 0xcc);
+	image->stubs_offset = image->text.count;
+
+	// NOTE: The displacements of the stubs are filled, once the addresses of
+	//       their slots are known.
+	for (uint32_t index = 0; index < image->imports_count; ++index)
+	{
+		static const uint8_t stub[stub_size] = { 0xff, 0x25, 0x00, 0x00, 0x00, 0x00, 0xcc, 0xcc };
+		append(&image->text, stub, sizeof(stub));
+	}
+
+	append(&dynamic->tables, interpreter, sizeof(interpreter));
+
+	// NOTE: The hash table has a single bucket, that chains all the symbols,
+	//       as the dynamic linker only searches it for the few imports.
+	align_buffer(&dynamic->tables, 8, 0);
+	dynamic->hash_offset = dynamic->tables.count;
+	const uint32_t hash[] = { 1, symbols_count, symbols_count - 1 };
+	append(&dynamic->tables, hash, sizeof(hash));
+
+	for (uint32_t index = 0; index < symbols_count; ++index)
+	{
+		const uint32_t chain = index > 0 ? index - 1 : 0;
+		append(&dynamic->tables, &chain, sizeof(chain));
+	}
+
+	buffer_s names = {0};
+	(void)add_name(&names, "");
+	dynamic->library_name = add_name(&names, library);
+
+	align_buffer(&dynamic->tables, 8, 0);
+	dynamic->symbols_offset = dynamic->tables.count;
+	append_zeros(&dynamic->tables, sizeof(Elf64_Sym));
+
+	for (uint32_t index = 0; index < image->imports_count; ++index)
+	{
+		const uint32_t func = image->imports[index];
+		const Elf64_Sym symbol =
+		{
+			.st_name = add_name(&names, UINT32_MAX == func ? "exit" : module->func_names[func]),
+			.st_info = ELF64_ST_INFO(STB_GLOBAL, STT_FUNC),
+			.st_shndx = SHN_UNDEF
+		};
+
+		append(&dynamic->tables, &symbol, sizeof(symbol));
+	}
+
+	dynamic->names_offset = dynamic->tables.count;
+	dynamic->names_size = names.count;
+	append(&dynamic->tables, names.data, names.count);
+	primec_utils_free(names.data);
+
+	align_buffer(&dynamic->tables, 8, 0);
+	dynamic->relocations_offset = dynamic->tables.count;
+	append_zeros(&dynamic->tables, image->imports_count * sizeof(Elf64_Rela));
+	append_zeros(&dynamic->entries, dynamic_entries_count * sizeof(Elf64_Dyn));
+}
+
+static void link_dynamic(
+	image_s* const image,
+	dynamic_s* const dynamic,
+	const uint64_t tables_address,
+	const uint64_t got_address)
+{
+	const uint64_t stubs_address = image->addresses[section_text] + image->stubs_offset;
+
+	for (uint32_t index = 0; index < image->imports_count; ++index)
+	{
+		const uint64_t slot = got_address + index * sizeof(uint64_t);
+		const uint64_t place = stubs_address + index * stub_size + 6;
+		const int64_t displacement = (int64_t)(slot - place);
+		primec_debug_assert(displacement >= INT32_MIN && displacement <= INT32_MAX);
+
+		uint8_t* const bytes = &image->text.data[image->stubs_offset + index * stub_size + 2];
+		for (uint32_t byte = 0; byte < 4; ++byte) { bytes[byte] = (uint8_t)((uint64_t)displacement >> (8 * byte)); }
+
+		const Elf64_Rela record =
+		{
+			.r_offset = slot,
+			.r_info = ELF64_R_INFO(index + 1, R_X86_64_GLOB_DAT)
+		};
+
+		primec_utils_memcpy(dynamic->tables.data + dynamic->relocations_offset + index * sizeof(record), &record, sizeof(record));
+	}
+
+	const Elf64_Dyn entries[dynamic_entries_count] =
+	{
+		{ .d_tag = DT_NEEDED, .d_un.d_val = dynamic->library_name },
+		{ .d_tag = DT_HASH, .d_un.d_ptr = tables_address + dynamic->hash_offset },
+		{ .d_tag = DT_STRTAB, .d_un.d_ptr = tables_address + dynamic->names_offset },
+		{ .d_tag = DT_SYMTAB, .d_un.d_ptr = tables_address + dynamic->symbols_offset },
+		{ .d_tag = DT_STRSZ, .d_un.d_val = dynamic->names_size },
+		{ .d_tag = DT_SYMENT, .d_un.d_val = sizeof(Elf64_Sym) },
+		{ .d_tag = DT_RELA, .d_un.d_ptr = tables_address + dynamic->relocations_offset },
+		{ .d_tag = DT_RELASZ, .d_un.d_val = image->imports_count * sizeof(Elf64_Rela) },
+		{ .d_tag = DT_RELAENT, .d_un.d_val = sizeof(Elf64_Rela) },
+		{ .d_tag = DT_NULL }
+	};
+
+	primec_utils_memcpy(dynamic->entries.data, entries, sizeof(entries));
+}
+
+static void build_symbols(
+	const image_s* const image,
+	symbols_s* const symbols)
+{
+	const primec_x86_64_module_s* const module = image->module;
+	const primec_ir_program_s* const program = module->program;
+	const uint32_t funcs_count = program->funcs.count > 0 ? program->funcs.count : 1;
+	const uint32_t globals_count = program->globals.count > 0 ? program->globals.count : 1;
+
+	symbols->func_symbols = primec_utils_malloc(funcs_count * sizeof(uint32_t));
+	symbols->global_symbols = primec_utils_malloc(globals_count * sizeof(uint32_t));
+	primec_utils_memset(symbols->func_symbols, 0, funcs_count * sizeof(uint32_t));
+	(void)add_name(&symbols->names, "");
+
+	// NOTE: The local symbols come first, the sections (for the strings), the
+	//       lambdas and the syscall stub, so the stub never clashes with the
+	//       syscall of the C library, when the objects are linked with it.
+	add_symbol(symbols, NULL, 0, 0, 0, 0);
+
+	for (uint16_t section = section_text; section <= section_bss; ++section)
+	{
+		add_symbol(symbols, NULL, ELF64_ST_INFO(STB_LOCAL, STT_SECTION), section, image->addresses[section], 0);
+	}
+
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		const bool is_local_pass = 0 == pass;
+
+		if (!is_local_pass)
+		{
+			symbols->first_global = (uint32_t)(symbols->symbols.count / sizeof(Elf64_Sym));
+
+			if (image->has_start)
+			{
+				symbols->start_symbol = symbols->first_global;
+				add_symbol(symbols, "_start", ELF64_ST_INFO(STB_GLOBAL, STT_FUNC), section_text, image->addresses[section_text], 0);
+			}
+		}
+
+		for (uint32_t index = 0; index < program->funcs.count; ++index)
+		{
+			const primec_ir_func_s* const func = program->funcs.data[index];
+			const bool is_stub = index == program->syscall;
+			const bool is_extern = 0 != (func->flags & primec_ir_func_flag_extern) && !is_stub;
+			const bool is_local = is_stub || 0 != (func->flags & primec_ir_func_flag_lambda);
+			if (is_extern || is_local != is_local_pass) { continue; }
+
+			symbols->func_symbols[index] = (uint32_t)(symbols->symbols.count / sizeof(Elf64_Sym));
+			add_symbol(symbols, module->func_names[index],
+				ELF64_ST_INFO(is_local ? STB_LOCAL : STB_GLOBAL, STT_FUNC), section_text,
+				image->addresses[section_text] + image->func_offsets[index],
+				is_stub ? sizeof(g_syscall_stub) : module->funcs[index].bytes.count);
+		}
+	}
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_layout_s layout = primec_layout_get(program->types, program->globals.data[index].type);
+		const uint8_t section = image->global_sections[index];
+
+		symbols->global_symbols[index] = (uint32_t)(symbols->symbols.count / sizeof(Elf64_Sym));
+		add_symbol(symbols, module->global_names[index], ELF64_ST_INFO(STB_GLOBAL, STT_OBJECT), section,
+			image->addresses[section] + image->global_offsets[index], layout.size);
+	}
+
+	// NOTE: The external functions are undefined, and only the referenced ones
+	//       are listed.
+	for (uint32_t relocation = 0; relocation < image->text_relocations.count; ++relocation)
+	{
+		const primec_x86_64_relocation_s* const record = &image->text_relocations.data[relocation];
+
+		if (symbol_exit == record->symbol_kind && 0 == symbols->exit_symbol)
+		{
+			symbols->exit_symbol = (uint32_t)(symbols->symbols.count / sizeof(Elf64_Sym));
+			add_symbol(symbols, "exit", ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE), SHN_UNDEF, 0, 0);
+			continue;
+		}
+
+		if (record->symbol_kind != primec_x86_64_symbol_func || symbols->func_symbols[record->symbol] != 0) { continue; }
+		symbols->func_symbols[record->symbol] = (uint32_t)(symbols->symbols.count / sizeof(Elf64_Sym));
+		add_symbol(symbols, module->func_names[record->symbol], ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE), SHN_UNDEF, 0, 0);
+	}
+}
+
+static void add_symbol(
+	symbols_s* const symbols,
+	const char* const name,
+	const uint8_t info,
+	const uint16_t section,
+	const uint64_t value,
+	const uint64_t size)
+{
+	const Elf64_Sym symbol =
+	{
+		.st_name = NULL == name ? 0 : add_name(&symbols->names, name),
+		.st_info = info,
+		.st_shndx = section,
+		.st_value = value,
+		.st_size = size
+	};
+
+	append(&symbols->symbols, &symbol, sizeof(symbol));
+}
+
+static uint32_t add_name(
+	buffer_s* const names,
+	const char* const name)
+{
+	const uint32_t offset = (uint32_t)names->count;
+	uint64_t length = 0;
+	while (name[length] != '\0') { ++length; }
+	append(names, name, length + 1);
+	return offset;
+}
+
+static bool resolve(
+	image_s* const image,
+	const section_e section,
+	const relocations_s* const relocations)
+{
+	buffer_s* const buffer = section_text == section ? &image->text : &image->data;
+
+	for (uint32_t index = 0; index < relocations->count; ++index)
+	{
+		const primec_x86_64_relocation_s* const relocation = &relocations->data[index];
+		uint64_t target = 0;
+
+		if (!get_symbol_address(image, relocation, &target))
+		{
+			const char* const name = symbol_exit == relocation->symbol_kind
+				? "exit" : image->module->func_names[relocation->symbol];
+			primec_logger_error("external function `%s` cannot be linked into a static executable.", name);
+			return false;
+		}
+
+		const uint64_t place = image->addresses[section] + relocation->offset;
+		const uint64_t value = target + (uint64_t)relocation->addend;
+		uint8_t* const bytes = &buffer->data[relocation->offset];
+
+		if (primec_x86_64_relocation_64 == relocation->type)
+		{
+			for (uint32_t byte = 0; byte < 8; ++byte) { bytes[byte] = (uint8_t)(value >> (8 * byte)); }
+			continue;
+		}
+
+		const int64_t displacement = (int64_t)(value - place);
+		primec_debug_assert(displacement >= INT32_MIN && displacement <= INT32_MAX);
+		for (uint32_t byte = 0; byte < 4; ++byte) { bytes[byte] = (uint8_t)((uint64_t)displacement >> (8 * byte)); }
+	}
+
+	return true;
+}
+
+static bool get_symbol_address(
+	const image_s* const image,
+	const primec_x86_64_relocation_s* const relocation,
+	uint64_t* const address)
+{
+	switch (relocation->symbol_kind)
+	{
+		case primec_x86_64_symbol_func:
+		{
+			const uint64_t offset = image->func_offsets[relocation->symbol];
+			const uint32_t import = image->func_imports[relocation->symbol];
+
+			if (UINT64_MAX == offset)
+			{
+				if (UINT32_MAX == import) { return false; }
+				*address = image->addresses[section_text] + image->stubs_offset + import * stub_size;
+				break;
+			}
+
+			*address = image->addresses[section_text] + offset;
+		} break;
+
+		case primec_x86_64_symbol_global:
+		{
+			*address = image->addresses[image->global_sections[relocation->symbol]] + image->global_offsets[relocation->symbol];
+		} break;
+
+		case primec_x86_64_symbol_string:
+		{
+			*address = image->addresses[section_rodata] + image->strings.offsets[relocation->symbol];
+		} break;
+
+		default:
+		{
+			if (UINT32_MAX == image->exit_import) { return false; }
+			*address = image->addresses[section_text] + image->stubs_offset + image->exit_import * stub_size;
+		} break;
+	}
+
+	return true;
+}
+
+static void write_relocations(
+	const image_s* const image,
+	const symbols_s* const symbols,
+	const relocations_s* const relocations,
+	buffer_s* const output)
+{
+	for (uint32_t index = 0; index < relocations->count; ++index)
+	{
+		const primec_x86_64_relocation_s* const relocation = &relocations->data[index];
+		uint32_t symbol = 0;
+		int64_t addend = relocation->addend;
+
+		switch (relocation->symbol_kind)
+		{
+			case primec_x86_64_symbol_func: { symbol = symbols->func_symbols[relocation->symbol]; } break;
+			case primec_x86_64_symbol_global: { symbol = symbols->global_symbols[relocation->symbol]; } break;
+
+			case primec_x86_64_symbol_string:
+			{
+				// NOTE: Strings have no symbols, they are referenced through the
+				//       symbol of their section.
+				symbol = section_rodata;
+				addend += (int64_t)image->strings.offsets[relocation->symbol];
+			} break;
+
+			default: { symbol = symbols->exit_symbol; } break;
+		}
+
+		const uint32_t type =
+			primec_x86_64_relocation_pc32 == relocation->type ? R_X86_64_PC32 :
+			primec_x86_64_relocation_plt32 == relocation->type ? R_X86_64_PLT32 : R_X86_64_64;
+
+		const Elf64_Rela record =
+		{
+			.r_offset = relocation->offset,
+			.r_info = ELF64_R_INFO(symbol, type),
+			.r_addend = addend
+		};
+
+		append(output, &record, sizeof(record));
+	}
+}
+
+static void write_section_header(
+	buffer_s* const output,
+	const uint64_t offset,
+	const Elf64_Shdr header)
+{
+	primec_utils_memcpy(output->data + offset, &header, sizeof(header));
+}
+
+static bool write_file(
+	const char* const path,
+	const buffer_s* const output,
+	const uint32_t mode)
+{
+	const int32_t descriptor = (int32_t)open(path, O_WRONLY | O_CREAT | O_TRUNC, (mode_t)mode);
+
+	if (descriptor < 0)
+	{
+		primec_logger_error("failed to open the output file '%s'.", path);
+		return false;
+	}
+
+	uint64_t written = 0;
+
+	while (written < output->count)
+	{
+		const ssize_t result = write(descriptor, output->data + written, output->count - written);
+		if (result <= 0) { break; }
+		written += (uint64_t)result;
+	}
+
+	(void)close(descriptor);
+
+	if (written != output->count)
+	{
+		primec_logger_error("failed to write the output file '%s'.", path);
+		return false;
+	}
+
+	return true;
+}
+
+static void append(
+	buffer_s* const buffer,
+	const void* const data,
+	const uint64_t size)
+{
+	if (0 == size) { return; }
+
+	if (buffer->count + size > buffer->capacity)
+	{
+		while (buffer->count + size > buffer->capacity)
+		{
+			buffer->capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 4096;
+		}
+
+		buffer->data = primec_utils_realloc(buffer->data, buffer->capacity);
+	}
+
+	primec_utils_memcpy(buffer->data + buffer->count, data, size);
+	buffer->count += size;
+}
+
+static void append_zeros(
+	buffer_s* const buffer,
+	const uint64_t size)
+{
+	static const uint8_t zeros[256] = {0};
+
+	for (uint64_t remaining = size; remaining > 0;)
+	{
+		const uint64_t chunk = remaining < sizeof(zeros) ? remaining : sizeof(zeros);
+		append(buffer, zeros, chunk);
+		remaining -= chunk;
+	}
+}
+
+static void align_buffer(
+	buffer_s* const buffer,
+	const uint64_t alignment,
+	const uint8_t fill)
+{
+	while (buffer->count % alignment != 0)
+	{
+		append(buffer, &fill, 1);
+	}
+}
+
+static void add_relocation(
+	relocations_s* const relocations,
+	const primec_x86_64_relocation_s relocation)
+{
+	if (relocations->count >= relocations->capacity)
+	{
+		relocations->capacity = relocations->capacity > 0 ? relocations->capacity * 2 : 64;
+		relocations->data = primec_utils_realloc(relocations->data, relocations->capacity * sizeof(primec_x86_64_relocation_s));
+	}
+
+	relocations->data[relocations->count++] = relocation;
+}
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment)
+{
+	primec_debug_assert(alignment > 0);
+	return (value + alignment - 1) / alignment * alignment;
+}
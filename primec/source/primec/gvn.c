@@ -0,0 +1,281 @@
+
+/**
+ * @file gvn.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/gvn.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+
+#include <stddef.h>
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	uint32_t block;
+	uint32_t mark;		// length of the undo log before the block, or UINT32_MAX if it is not entered yet
+} visit_s;
+
+typedef struct
+{
+	const primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_cfg_s cfg;
+
+	primec_ir_value_t* table;		// available values, hashed by their instructions (open addressing)
+	uint32_t mask;
+	primec_ir_value_t* replacements;
+	list_s undo;					// slots of the table, filled in the walked blocks
+} numberer_s;
+
+static void number_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static void number_block(
+	numberer_s* const numberer,
+	const primec_ir_block_t block);
+
+static bool is_numbered(
+	const numberer_s* const numberer,
+	const primec_ir_value_t value);
+
+static bool is_commutative(
+	const primec_ir_op_e op);
+
+static uint32_t hash(
+	const primec_ir_instruction_s* const instruction);
+
+static bool is_equal(
+	const primec_ir_instruction_s* const left,
+	const primec_ir_instruction_s* const right);
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_gvn_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		number_func(program->types, func);
+	}
+}
+
+static void number_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	const uint32_t values_count = func->instructions.count;
+	uint32_t capacity = 16;
+	while (capacity < 2 * values_count) { capacity *= 2; }
+
+	numberer_s numberer =
+	{
+		.types = types,
+		.func = func,
+		.table = primec_utils_malloc(capacity * sizeof(primec_ir_value_t)),
+		.mask = capacity - 1,
+		.replacements = primec_utils_malloc(values_count * sizeof(primec_ir_value_t))
+	};
+
+	primec_utils_memset(numberer.table, 0, capacity * sizeof(primec_ir_value_t));
+	primec_utils_memset(numberer.replacements, 0, values_count * sizeof(primec_ir_value_t));
+	primec_cfg_build(&numberer.cfg, func);
+
+	const primec_cfg_s* const cfg = &numberer.cfg;
+	visit_s* const stack = primec_utils_malloc(2 * cfg->blocks_count * sizeof(visit_s));
+	uint32_t stack_count = 0;
+
+	// NOTE: The dominator tree is walked depth first, and every block takes its
+	//       values out of the table, when it is left.
+	stack[stack_count++] = (visit_s) { .block = 0, .mark = UINT32_MAX };
+
+	while (stack_count > 0)
+	{
+		const visit_s visit = stack[--stack_count];
+
+		if (visit.mark != UINT32_MAX)
+		{
+			while (numberer.undo.count > visit.mark)
+			{
+				numberer.table[numberer.undo.data[--numberer.undo.count]] = primec_ir_null;
+			}
+
+			continue;
+		}
+
+		stack[stack_count++] = (visit_s) { .block = visit.block, .mark = numberer.undo.count };
+		number_block(&numberer, visit.block);
+
+		for (uint32_t index = cfg->children_starts[visit.block + 1]; index > cfg->children_starts[visit.block]; --index)
+		{
+			stack[stack_count++] = (visit_s) { .block = cfg->children[index - 1], .mark = UINT32_MAX };
+		}
+	}
+
+	// NOTE: The phis and the unreachable blocks may use the replaced values
+	//       too, so every operand is resolved once more.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (numberer.replacements[value] != primec_ir_null) { continue; }
+			primec_ir_func_visit_operands(func, value, replace, &numberer);
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+
+	primec_utils_free(stack);
+	primec_utils_free(numberer.table);
+	primec_utils_free(numberer.replacements);
+	primec_utils_free(numberer.undo.data);
+	primec_cfg_destroy(&numberer.cfg);
+}
+
+static void number_block(
+	numberer_s* const numberer,
+	const primec_ir_block_t block)
+{
+	primec_ir_func_s* const func = numberer->func;
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_value_t value = record->instructions.data[index];
+		primec_ir_func_visit_operands(func, value, replace, numberer);
+		if (!is_numbered(numberer, value)) { continue; }
+
+		primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+		uint32_t slot = hash(instruction) & numberer->mask;
+
+		while (numberer->table[slot] != primec_ir_null && !is_equal(primec_ir_func_get(func, numberer->table[slot]), instruction))
+		{
+			slot = (slot + 1) & numberer->mask;
+		}
+
+		if (numberer->table[slot] != primec_ir_null)
+		{
+			numberer->replacements[value] = numberer->table[slot];
+			instruction->op = primec_ir_op_nop;
+			continue;
+		}
+
+		numberer->table[slot] = value;
+		push(&numberer->undo, slot);
+	}
+}
+
+static bool is_numbered(
+	const numberer_s* const numberer,
+	const primec_ir_value_t value)
+{
+	// NOTE: The divisions and the conversions may trap, but the equal ones,
+	//       that dominate them, would have trapped first.
+	const primec_ir_op_e op = primec_ir_func_get(numberer->func, value)->op;
+	return primec_ir_op_div == op || primec_ir_op_rem == op || primec_ir_op_convert == op ||
+		primec_ir_is_pure(numberer->types, numberer->func, value);
+}
+
+static bool is_commutative(
+	const primec_ir_op_e op)
+{
+	switch (op)
+	{
+		case primec_ir_op_add:
+		case primec_ir_op_mul:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		{
+			return true;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static uint32_t hash(
+	const primec_ir_instruction_s* const instruction)
+{
+	uint32_t a = instruction->a;
+	uint32_t b = instruction->b;
+
+	if (is_commutative(instruction->op) && a > b)
+	{
+		const uint32_t swapped = a;
+		a = b;
+		b = swapped;
+	}
+
+	uint64_t result = instruction->op;
+	result = (result ^ instruction->type) * UINT64_C(0x9e3779b97f4a7c15);
+	result = (result ^ a) * UINT64_C(0x9e3779b97f4a7c15);
+	result = (result ^ b) * UINT64_C(0x9e3779b97f4a7c15);
+	return (uint32_t)(result >> 32);
+}
+
+static bool is_equal(
+	const primec_ir_instruction_s* const left,
+	const primec_ir_instruction_s* const right)
+{
+	if (left->op != right->op || left->type != right->type) { return false; }
+	if (left->a == right->a && left->b == right->b) { return true; }
+	return is_commutative(left->op) && left->a == right->b && left->b == right->a;
+}
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	const numberer_s* const numberer = context;
+	if (numberer->replacements[*operand] != primec_ir_null) { *operand = numberer->replacements[*operand]; }
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -0,0 +1,752 @@
+
+/**
+ * @file inliner.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/inliner.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/diagnostics.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// NOTE: Callees up to this cost are inlined without being marked `inl`, as long
+//       as their callers stay within the budget. Callees, that are passed known
+//       functions, may cost more, as their indirect calls become direct ones.
+#define small_callee_cost 16
+#define callback_callee_cost 64
+#define caller_cost_budget 2048
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	uint32_t func;
+	uint32_t edge;
+} frame_s;
+
+typedef struct
+{
+	primec_ir_program_s* program;
+	const primec_build_graph_s* graph;
+	bool is_inlining_small;
+	list_s* callees;		// direct callees of every function
+	list_s* references;		// functions, whose addresses every function takes
+	uint32_t* components;	// strongly connected component of every function
+	uint32_t* order;		// functions in the order of their components, callees first
+	uint32_t* costs;
+	primec_diagnostics_s diagnostics;
+} inliner_s;
+
+static void collect_callees(
+	inliner_s* const inliner);
+
+static void find_components(
+	inliner_s* const inliner);
+
+static void report_recursive(
+	inliner_s* const inliner);
+
+static bool is_recursive(
+	const inliner_s* const inliner,
+	const uint32_t func,
+	const bool is_referencing);
+
+static uint32_t get_edge(
+	const inliner_s* const inliner,
+	const uint32_t func,
+	const uint32_t edge);
+
+static void inline_calls(
+	inliner_s* const inliner,
+	const uint32_t caller);
+
+static void devirtualize(
+	primec_ir_func_s* const func,
+	const primec_ir_value_t value);
+
+static bool should_inline(
+	const inliner_s* const inliner,
+	const uint32_t caller,
+	const uint32_t callee,
+	const uint32_t cost,
+	const bool is_passing_func);
+
+static bool is_passing_func(
+	const primec_ir_func_s* const func,
+	const primec_ir_instruction_s* const call);
+
+static void inline_call(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	const primec_ir_block_t block,
+	const uint32_t position);
+
+static primec_ir_instruction_s remap_instruction(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	primec_ir_instruction_s instruction,
+	const primec_ir_value_t* const values,
+	const primec_ir_block_t* const blocks);
+
+static uint32_t remap_list(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	const uint32_t list,
+	const primec_ir_value_t* const values,
+	const primec_ir_block_t* const blocks,
+	const uint32_t blocks_stride);
+
+static void retarget_phis(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to);
+
+static uint32_t get_cost(
+	const primec_ir_func_s* const func);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_inliner_run(
+	primec_ir_program_s* const program,
+	const primec_build_graph_s* const graph,
+	const bool is_inlining_small)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(graph != NULL);
+	const uint32_t funcs_count = program->funcs.count > 0 ? program->funcs.count : 1;
+
+	inliner_s inliner =
+	{
+		.program = program,
+		.graph = graph,
+		.is_inlining_small = is_inlining_small,
+		.callees = primec_utils_malloc(funcs_count * sizeof(list_s)),
+		.references = primec_utils_malloc(funcs_count * sizeof(list_s)),
+		.components = primec_utils_malloc(funcs_count * sizeof(uint32_t)),
+		.order = primec_utils_malloc(funcs_count * sizeof(uint32_t)),
+		.costs = primec_utils_malloc(funcs_count * sizeof(uint32_t))
+	};
+
+	primec_utils_memset(inliner.callees, 0, funcs_count * sizeof(list_s));
+	primec_utils_memset(inliner.references, 0, funcs_count * sizeof(list_s));
+	primec_utils_memset(inliner.costs, 0, funcs_count * sizeof(uint32_t));
+
+	collect_callees(&inliner);
+	find_components(&inliner);
+	report_recursive(&inliner);
+	const uint32_t errors_count = primec_diagnostics_flush(&inliner.diagnostics);
+
+	// NOTE: The callees come first, so their calls are inlined into them before
+	//       they are inlined into their callers.
+	for (uint32_t index = 0; 0 == errors_count && index < program->funcs.count; ++index)
+	{
+		const uint32_t func = inliner.order[index];
+		if (program->funcs.data[func]->flags & primec_ir_func_flag_extern) { continue; }
+		inline_calls(&inliner, func);
+	}
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_utils_free(inliner.callees[index].data);
+		primec_utils_free(inliner.references[index].data);
+	}
+
+	primec_utils_free(inliner.callees);
+	primec_utils_free(inliner.references);
+	primec_utils_free(inliner.components);
+	primec_utils_free(inliner.order);
+	primec_utils_free(inliner.costs);
+	primec_diagnostics_destroy(&inliner.diagnostics);
+
+	if (errors_count > 0)
+	{
+		exit(-1);
+	}
+}
+
+static void collect_callees(
+	inliner_s* const inliner)
+{
+	const primec_ir_program_s* const program = inliner->program;
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+
+		for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+		{
+			const primec_ir_block_s* const record = &func->blocks.data[block];
+
+			for (uint32_t position = 0; position < record->instructions.count; ++position)
+			{
+				const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[position]);
+				if (instruction->op != primec_ir_op_call && instruction->op != primec_ir_op_func) { continue; }
+				if (program->funcs.data[instruction->a]->flags & primec_ir_func_flag_extern) { continue; }
+				push(primec_ir_op_call == instruction->op ? &inliner->callees[index] : &inliner->references[index], instruction->a);
+			}
+		}
+	}
+}
+
+static void find_components(
+	inliner_s* const inliner)
+{
+	// NOTE: The components are found by the Tarjan's algorithm, which finishes
+	//       them in the reverse topological order, so the callees come first.
+	//       The recursion is kept on an explicit stack, as the call chains may
+	//       be deep. Taken addresses count as calls, as the indirect calls
+	//       through them may become direct ones.
+	const uint32_t funcs_count = inliner->program->funcs.count;
+	const uint32_t capacity = funcs_count > 0 ? funcs_count : 1;
+
+	uint32_t* const indices = primec_utils_malloc(capacity * sizeof(uint32_t));
+	uint32_t* const lowlinks = primec_utils_malloc(capacity * sizeof(uint32_t));
+	uint8_t* const is_on_stack = primec_utils_malloc(capacity * sizeof(uint8_t));
+	uint32_t* const stack = primec_utils_malloc(capacity * sizeof(uint32_t));
+	frame_s* const frames = primec_utils_malloc(capacity * sizeof(frame_s));
+
+	primec_utils_memset(indices, 0xff, capacity * sizeof(uint32_t));
+	primec_utils_memset(is_on_stack, 0, capacity * sizeof(uint8_t));
+
+	uint32_t next_index = 0;
+	uint32_t stack_count = 0;
+	uint32_t components_count = 0;
+	uint32_t order_count = 0;
+
+	for (uint32_t root = 0; root < funcs_count; ++root)
+	{
+		if (indices[root] != UINT32_MAX) { continue; }
+
+		uint32_t frames_count = 0;
+		indices[root] = lowlinks[root] = next_index++;
+		stack[stack_count++] = root;
+		is_on_stack[root] = 1;
+		frames[frames_count++] = (frame_s) { .func = root, .edge = 0 };
+
+		while (frames_count > 0)
+		{
+			frame_s* const top = &frames[frames_count - 1];
+
+			if (top->edge < inliner->callees[top->func].count + inliner->references[top->func].count)
+			{
+				const uint32_t callee = get_edge(inliner, top->func, top->edge++);
+
+				if (UINT32_MAX == indices[callee])
+				{
+					indices[callee] = lowlinks[callee] = next_index++;
+					stack[stack_count++] = callee;
+					is_on_stack[callee] = 1;
+					frames[frames_count++] = (frame_s) { .func = callee, .edge = 0 };
+				}
+				else if (is_on_stack[callee] && indices[callee] < lowlinks[top->func])
+				{
+					lowlinks[top->func] = indices[callee];
+				}
+
+				continue;
+			}
+
+			const uint32_t func = top->func;
+			--frames_count;
+
+			if (frames_count > 0 && lowlinks[func] < lowlinks[frames[frames_count - 1].func])
+			{
+				lowlinks[frames[frames_count - 1].func] = lowlinks[func];
+			}
+
+			if (lowlinks[func] != indices[func]) { continue; }
+			uint32_t member = UINT32_MAX;
+
+			while (member != func)
+			{
+				member = stack[--stack_count];
+				is_on_stack[member] = 0;
+				inliner->components[member] = components_count;
+				inliner->order[order_count++] = member;
+			}
+
+			++components_count;
+		}
+	}
+
+	primec_utils_free(indices);
+	primec_utils_free(lowlinks);
+	primec_utils_free(is_on_stack);
+	primec_utils_free(stack);
+	primec_utils_free(frames);
+}
+
+static void report_recursive(
+	inliner_s* const inliner)
+{
+	const primec_ir_program_s* const program = inliner->program;
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (!(func->flags & primec_ir_func_flag_inline) || !is_recursive(inliner, index, false)) { continue; }
+
+		const primec_ast_s* const ast = &inliner->graph->modules.data[func->module]->ast;
+		primec_diagnostics_report(&inliner->diagnostics, primec_ast_get_node_token(ast, func->node)->location,
+			"`inl` function `%s` is recursive, so it cannot be inlined.", func->name);
+	}
+}
+
+static bool is_recursive(
+	const inliner_s* const inliner,
+	const uint32_t func,
+	const bool is_referencing)
+{
+	// NOTE: Every function of a component, that has more than one function,
+	//       calls (or refers to) another one of them.
+	const uint32_t count = inliner->callees[func].count + (is_referencing ? inliner->references[func].count : 0);
+
+	for (uint32_t edge = 0; edge < count; ++edge)
+	{
+		if (inliner->components[get_edge(inliner, func, edge)] == inliner->components[func]) { return true; }
+	}
+
+	return false;
+}
+
+static uint32_t get_edge(
+	const inliner_s* const inliner,
+	const uint32_t func,
+	const uint32_t edge)
+{
+	const list_s* const callees = &inliner->callees[func];
+	return edge < callees->count ? callees->data[edge] : inliner->references[func].data[edge - callees->count];
+}
+
+static void inline_calls(
+	inliner_s* const inliner,
+	const uint32_t caller)
+{
+	primec_ir_func_s* const func = inliner->program->funcs.data[caller];
+	uint32_t cost = get_cost(func);
+
+	// NOTE: The rest of the block, after an inlined call, is moved into a new
+	//       block, which is visited later, like the inlined blocks.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		for (uint32_t position = 0; position < func->blocks.data[block].instructions.count; ++position)
+		{
+			const primec_ir_value_t value = func->blocks.data[block].instructions.data[position];
+			devirtualize(func, value);
+
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+			if (instruction->op != primec_ir_op_call) { continue; }
+
+			const uint32_t callee = instruction->a;
+			if (!should_inline(inliner, caller, callee, cost, is_passing_func(func, instruction))) { continue; }
+
+			cost += inliner->costs[callee];
+			inline_call(func, inliner->program->funcs.data[callee], block, position);
+			break;
+		}
+	}
+
+	inliner->costs[caller] = get_cost(func);
+}
+
+static void devirtualize(
+	primec_ir_func_s* const func,
+	const primec_ir_value_t value)
+{
+	// NOTE: Indirect calls of the known functions, like the callbacks passed to
+	//       the inlined callees, become direct calls, that may be inlined too.
+	primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+	if (instruction->op != primec_ir_op_call_indirect) { return; }
+
+	const primec_ir_instruction_s* const callee = primec_ir_func_get(func, instruction->a);
+	if (callee->op != primec_ir_op_func) { return; }
+
+	instruction->op = primec_ir_op_call;
+	instruction->a = callee->a;
+}
+
+static bool should_inline(
+	const inliner_s* const inliner,
+	const uint32_t caller,
+	const uint32_t callee,
+	const uint32_t cost,
+	const bool is_passing_func)
+{
+	const primec_ir_func_s* const func = inliner->program->funcs.data[callee];
+
+	if ((func->flags & primec_ir_func_flag_extern) || inliner->components[callee] == inliner->components[caller])
+	{
+		return false;
+	}
+
+	// NOTE: Recursive callees would be inlined into their inlined bodies again,
+	//       so only the calls of the other ones are inlined. The callees, that
+	//       refer to their callers, may call them once the indirect calls
+	//       become direct, so they are recursive too.
+	if (is_recursive(inliner, callee, true))
+	{
+		return false;
+	}
+
+	if (func->flags & primec_ir_func_flag_inline)
+	{
+		return true;
+	}
+
+	const uint32_t limit = is_passing_func ? callback_callee_cost : small_callee_cost;
+	return inliner->is_inlining_small && inliner->costs[callee] <= limit && cost + inliner->costs[callee] <= caller_cost_budget;
+}
+
+static bool is_passing_func(
+	const primec_ir_func_s* const func,
+	const primec_ir_instruction_s* const call)
+{
+	uint32_t count = 0;
+	const uint32_t* const arguments = primec_ir_func_get_list(func, call->b, &count);
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		if (primec_ir_op_func == primec_ir_func_get(func, arguments[index])->op) { return true; }
+	}
+
+	return false;
+}
+
+static void inline_call(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	const primec_ir_block_t block,
+	const uint32_t position)
+{
+	const primec_ir_value_t call = caller->blocks.data[block].instructions.data[position];
+	const primec_ir_instruction_s record = *primec_ir_func_get(caller, call);
+	const bool returns_value = record.type != primec_type_void;
+
+	uint32_t arguments_count = 0;
+	const uint32_t* const list = primec_ir_func_get_list(caller, record.b, &arguments_count);
+	primec_ir_value_t* const arguments = primec_utils_malloc((arguments_count > 0 ? arguments_count : 1) * sizeof(primec_ir_value_t));
+	if (arguments_count > 0) { primec_utils_memcpy(arguments, list, arguments_count * sizeof(primec_ir_value_t)); }
+
+	// NOTE: The instructions after the call move into the continuation, with
+	//       the first place kept for the value of the call.
+	const primec_ir_block_t continuation = primec_ir_func_add_block(caller);
+	primec_ir_block_s* const source = &caller->blocks.data[block];
+	const uint32_t tail_count = source->instructions.count - position - 1;
+
+	primec_ir_block_s* const target = &caller->blocks.data[continuation];
+	target->instructions.capacity = tail_count + 1;
+	target->instructions.data = primec_utils_malloc(target->instructions.capacity * sizeof(primec_ir_value_t));
+	target->instructions.count = tail_count + 1;
+	if (tail_count > 0)
+	{
+		primec_utils_memcpy(&target->instructions.data[1], &source->instructions.data[position + 1], tail_count * sizeof(primec_ir_value_t));
+	}
+
+	source->instructions.count = position;
+
+	// NOTE: Blocks and values of the callee are allocated first, so the phis
+	//       and the branches may refer to the later ones. Parameters are
+	//       replaced by the arguments.
+	primec_ir_block_t* const blocks = primec_utils_malloc(callee->blocks.count * sizeof(primec_ir_block_t));
+	primec_ir_value_t* const values = primec_utils_malloc(callee->instructions.count * sizeof(primec_ir_value_t));
+	primec_utils_memset(values, 0, callee->instructions.count * sizeof(primec_ir_value_t));
+
+	for (primec_ir_block_t index = 0; index < callee->blocks.count; ++index)
+	{
+		blocks[index] = primec_ir_func_add_block(caller);
+	}
+
+	for (primec_ir_block_t index = 0; index < callee->blocks.count; ++index)
+	{
+		const primec_ir_block_s* const from = &callee->blocks.data[index];
+
+		for (uint32_t instruction = 0; instruction < from->instructions.count; ++instruction)
+		{
+			const primec_ir_value_t value = from->instructions.data[instruction];
+			const primec_ir_instruction_s* const definition = primec_ir_func_get(callee, value);
+
+			if (primec_ir_op_param == definition->op)
+			{
+				primec_debug_assert(definition->a < arguments_count);
+				values[value] = arguments[definition->a];
+				continue;
+			}
+
+			values[value] = primec_ir_func_add(caller, blocks[index], primec_ir_op_nop, primec_type_void, 0, 0);
+		}
+	}
+
+	(void)primec_ir_func_add(caller, block, primec_ir_op_jump, primec_type_void, blocks[0], 0);
+	list_s returns = {0};
+
+	for (primec_ir_block_t index = 0; index < callee->blocks.count; ++index)
+	{
+		const primec_ir_block_s* const from = &callee->blocks.data[index];
+
+		for (uint32_t instruction = 0; instruction < from->instructions.count; ++instruction)
+		{
+			const primec_ir_value_t value = from->instructions.data[instruction];
+			const primec_ir_instruction_s definition = *primec_ir_func_get(callee, value);
+			if (primec_ir_op_param == definition.op) { continue; }
+
+			// NOTE: Returns jump to the continuation, where their values are
+			//       merged by a phi.
+			if (primec_ir_op_ret == definition.op)
+			{
+				if (returns_value && definition.a != primec_ir_null)
+				{
+					push(&returns, blocks[index]);
+					push(&returns, values[definition.a]);
+				}
+
+				*primec_ir_func_get(caller, values[value]) = (primec_ir_instruction_s)
+				{
+					.op = primec_ir_op_jump,
+					.type = primec_type_void,
+					.a = continuation
+				};
+
+				continue;
+			}
+
+			*primec_ir_func_get(caller, values[value]) = remap_instruction(caller, callee, definition, values, blocks);
+		}
+	}
+
+	primec_ir_block_s* const merge = &caller->blocks.data[continuation];
+
+	if (!returns_value)
+	{
+		*primec_ir_func_get(caller, call) = (primec_ir_instruction_s) { .op = primec_ir_op_nop, .type = primec_type_void };
+		for (uint32_t index = 0; index < tail_count; ++index) { merge->instructions.data[index] = merge->instructions.data[index + 1]; }
+		--merge->instructions.count;
+	}
+	else if (returns.count > 0)
+	{
+		*primec_ir_func_get(caller, call) = (primec_ir_instruction_s)
+		{
+			.op = primec_ir_op_phi,
+			.type = record.type,
+			.a = primec_ir_func_add_list(caller, returns.data, returns.count)
+		};
+
+		merge->instructions.data[0] = call;
+	}
+	else
+	{
+		// NOTE: The callee never returns, so the continuation is unreachable,
+		//       and the value of the call is never observed.
+		*primec_ir_func_get(caller, call) = (primec_ir_instruction_s) { .op = primec_ir_op_const, .type = record.type };
+		merge->instructions.data[0] = call;
+	}
+
+	retarget_phis(caller, block, continuation);
+
+	primec_utils_free(returns.data);
+	primec_utils_free(arguments);
+	primec_utils_free(blocks);
+	primec_utils_free(values);
+}
+
+static primec_ir_instruction_s remap_instruction(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	primec_ir_instruction_s instruction,
+	const primec_ir_value_t* const values,
+	const primec_ir_block_t* const blocks)
+{
+	switch ((primec_ir_op_e)instruction.op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_const:
+		case primec_ir_op_slot:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		case primec_ir_op_unreachable:
+		{
+		} break;
+
+		case primec_ir_op_load:
+		case primec_ir_op_zero:
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		case primec_ir_op_convert:
+		case primec_ir_op_splat:
+		case primec_ir_op_reduce:
+		case primec_ir_op_ret:
+		{
+			instruction.a = values[instruction.a];
+		} break;
+
+		case primec_ir_op_call:
+		{
+			instruction.b = remap_list(caller, callee, instruction.b, values, NULL, 0);
+		} break;
+
+		case primec_ir_op_call_indirect:
+		{
+			instruction.a = values[instruction.a];
+			instruction.b = remap_list(caller, callee, instruction.b, values, NULL, 0);
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			instruction.a = remap_list(caller, callee, instruction.a, values, blocks, 2);
+		} break;
+
+		case primec_ir_op_jump:
+		{
+			instruction.a = blocks[instruction.a];
+		} break;
+
+		case primec_ir_op_branch:
+		{
+			instruction.a = values[instruction.a];
+			instruction.b = remap_list(caller, callee, instruction.b, NULL, blocks, 1);
+		} break;
+
+		case primec_ir_op_param:
+		case primec_ir_ops_count:
+		{
+			primec_logger_panic("internal failure -- unexpected ir op `%s` in an inlined body.", primec_ir_op_to_string((primec_ir_op_e)instruction.op));
+		} break;
+
+		default:
+		{
+			// NOTE: The remaining ops (memory, arithmetic and comparisons) take
+			//       two values.
+			instruction.a = values[instruction.a];
+			instruction.b = values[instruction.b];
+		} break;
+	}
+
+	return instruction;
+}
+
+static uint32_t remap_list(
+	primec_ir_func_s* const caller,
+	const primec_ir_func_s* const callee,
+	const uint32_t list,
+	const primec_ir_value_t* const values,
+	const primec_ir_block_t* const blocks,
+	const uint32_t blocks_stride)
+{
+	// NOTE: Lists either hold values, blocks, or the (block, value) pairs, where
+	//       every element at a multiple of the stride is a block.
+	uint32_t count = 0;
+	const uint32_t* const from = primec_ir_func_get_list(callee, list, &count);
+	uint32_t* const elements = primec_utils_malloc((count > 0 ? count : 1) * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const bool is_block = blocks_stride > 0 && 0 == index % blocks_stride;
+		elements[index] = is_block ? blocks[from[index]] : values[from[index]];
+	}
+
+	const uint32_t result = primec_ir_func_add_list(caller, elements, count);
+	primec_utils_free(elements);
+	return result;
+}
+
+static void retarget_phis(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to)
+{
+	primec_ir_block_t successors[2] = {0};
+	const uint32_t successors_count = primec_ir_block_get_successors(func, to, successors);
+
+	for (uint32_t successor = 0; successor < successors_count; ++successor)
+	{
+		// NOTE: Both edges may lead to the same block, which is retargeted once.
+		if (1 == successor && successors[0] == successors[1]) { break; }
+		const primec_ir_block_s* const record = &func->blocks.data[successors[successor]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[index]);
+			if (instruction->op != primec_ir_op_phi) { break; }
+
+			uint32_t count = 0;
+			uint32_t* const incoming = primec_ir_func_get_list(func, instruction->a, &count);
+
+			for (uint32_t pair = 0; pair < count; pair += 2)
+			{
+				if (from == incoming[pair]) { incoming[pair] = to; }
+			}
+		}
+	}
+}
+
+static uint32_t get_cost(
+	const primec_ir_func_s* const func)
+{
+	uint32_t cost = 0;
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			// NOTE: Constants and addresses are folded into their uses, and the
+			//       parameters are replaced by the arguments, so they are free.
+			switch ((primec_ir_op_e)primec_ir_func_get(func, record->instructions.data[index])->op)
+			{
+				case primec_ir_op_nop:
+				case primec_ir_op_const:
+				case primec_ir_op_param:
+				case primec_ir_op_slot:
+				case primec_ir_op_global:
+				case primec_ir_op_func:
+				case primec_ir_op_string:
+				case primec_ir_op_field:
+				case primec_ir_op_offset:
+				case primec_ir_op_phi:
+				{
+				} break;
+
+				default:
+				{
+					++cost;
+				} break;
+			}
+		}
+	}
+
+	return cost;
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = 0 == list->capacity ? 8 : list->capacity * 2;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -0,0 +1,893 @@
+
+/**
+ * @file ir.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/ir.h>
+
+#include <primec/debug.h>
+#include <primec/layout.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#define dump_line_capacity 512
+
+static const char* const g_ir_op_to_string_map[] =
+{
+	[primec_ir_op_nop] = "nop",
+	[primec_ir_op_const] = "const",
+	[primec_ir_op_param] = "param",
+	[primec_ir_op_slot] = "slot",
+	[primec_ir_op_global] = "global",
+	[primec_ir_op_func] = "func",
+	[primec_ir_op_string] = "string",
+	[primec_ir_op_load] = "load",
+	[primec_ir_op_store] = "store",
+	[primec_ir_op_copy] = "copy",
+	[primec_ir_op_zero] = "zero",
+	[primec_ir_op_field] = "field",
+	[primec_ir_op_element] = "element",
+	[primec_ir_op_offset] = "offset",
+	[primec_ir_op_add] = "add",
+	[primec_ir_op_sub] = "sub",
+	[primec_ir_op_mul] = "mul",
+	[primec_ir_op_div] = "div",
+	[primec_ir_op_rem] = "rem",
+	[primec_ir_op_neg] = "neg",
+	[primec_ir_op_and] = "and",
+	[primec_ir_op_or] = "or",
+	[primec_ir_op_xor] = "xor",
+	[primec_ir_op_not] = "not",
+	[primec_ir_op_shl] = "shl",
+	[primec_ir_op_shr] = "shr",
+	[primec_ir_op_eq] = "eq",
+	[primec_ir_op_ne] = "ne",
+	[primec_ir_op_lt] = "lt",
+	[primec_ir_op_le] = "le",
+	[primec_ir_op_gt] = "gt",
+	[primec_ir_op_ge] = "ge",
+	[primec_ir_op_convert] = "convert",
+	[primec_ir_op_splat] = "splat",
+	[primec_ir_op_reduce] = "reduce",
+	[primec_ir_op_call] = "call",
+	[primec_ir_op_call_indirect] = "call_indirect",
+	[primec_ir_op_phi] = "phi",
+	[primec_ir_op_check] = "check",
+	[primec_ir_op_jump] = "jump",
+	[primec_ir_op_branch] = "branch",
+	[primec_ir_op_ret] = "ret",
+	[primec_ir_op_unreachable] = "unreachable"
+};
+
+_Static_assert(
+	(sizeof(g_ir_op_to_string_map) / sizeof(g_ir_op_to_string_map[0])) == primec_ir_ops_count,
+	"g_ir_op_to_string_map is not in sync with primec_ir_op_e enum!"
+);
+
+static void destroy_func(
+	primec_ir_func_s* const func);
+
+static uint32_t* find_string_bucket_locked(
+	const primec_ir_program_s* const program,
+	const char* const data,
+	const uint64_t length,
+	const uint32_t hash);
+
+static void grow_string_buckets_locked(
+	primec_ir_program_s* const program);
+
+static const char* escape_string(
+	const primec_ir_string_s* const string,
+	char* const buffer,
+	const uint64_t capacity);
+
+static uint64_t dump_instruction(
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value,
+	char* const line);
+
+const char* primec_ir_op_to_string(
+	const primec_ir_op_e op)
+{
+	primec_debug_assert(op < primec_ir_ops_count);
+	return g_ir_op_to_string_map[op];
+}
+
+primec_ir_program_s* primec_ir_program_create(
+	primec_type_table_s* const types)
+{
+	primec_debug_assert(types != NULL);
+	primec_ir_program_s* const program = primec_utils_malloc(sizeof(primec_ir_program_s));
+	primec_utils_memset((void*)program, 0, sizeof(primec_ir_program_s));
+	program->types = types;
+	program->flush = UINT32_MAX;
+	program->syscall = UINT32_MAX;
+
+	if (pthread_mutex_init(&program->mutex, NULL) != 0)
+	{
+		primec_logger_panic("internal failure -- failed to initialize the program mutex.");
+	}
+
+	return program;
+}
+
+void primec_ir_program_destroy(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		destroy_func(program->funcs.data[index]);
+	}
+
+	for (uint32_t index = 0; index < program->names.count; ++index)
+	{
+		primec_utils_free(program->names.data[index]);
+	}
+
+	primec_utils_free(program->funcs.data);
+	primec_utils_free(program->globals.data);
+	primec_utils_free(program->strings.data);
+	primec_utils_free(program->strings.buckets);
+	primec_utils_free(program->names.data);
+	(void)pthread_mutex_destroy(&program->mutex);
+	primec_utils_free(program);
+}
+
+uint32_t primec_ir_program_add_func(
+	primec_ir_program_s* const program,
+	const char* const name,
+	const primec_type_t type,
+	const uint32_t flags)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(name != NULL);
+
+	primec_ir_func_s* const func = primec_utils_malloc(sizeof(primec_ir_func_s));
+	primec_utils_memset((void*)func, 0, sizeof(primec_ir_func_s));
+	func->name = name;
+	func->type = type;
+	func->flags = flags;
+
+	// NOTE: Reserving the value 0 for the null value.
+	func->instructions.capacity = 16;
+	func->instructions.data = primec_utils_malloc(func->instructions.capacity * sizeof(primec_ir_instruction_s));
+	func->instructions.data[0] = (primec_ir_instruction_s) { .op = primec_ir_op_nop };
+	func->instructions.count = 1;
+
+	(void)pthread_mutex_lock(&program->mutex);
+
+	if (program->funcs.count >= program->funcs.capacity)
+	{
+		program->funcs.capacity = 0 == program->funcs.capacity ? 64 : program->funcs.capacity * 2;
+		program->funcs.data = primec_utils_realloc(program->funcs.data, program->funcs.capacity * sizeof(primec_ir_func_s*));
+	}
+
+	const uint32_t index = program->funcs.count++;
+	program->funcs.data[index] = func;
+	(void)pthread_mutex_unlock(&program->mutex);
+	return index;
+}
+
+uint32_t primec_ir_program_add_string(
+	primec_ir_program_s* const program,
+	const char* const data,
+	const uint64_t length)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(data != NULL);
+	const uint32_t hash = (uint32_t)primec_utils_hash(data, length);
+	(void)pthread_mutex_lock(&program->mutex);
+
+	if (2 * (program->strings.count + 1) > program->strings.buckets_capacity)
+	{
+		grow_string_buckets_locked(program);
+	}
+
+	uint32_t* const bucket = find_string_bucket_locked(program, data, length, hash);
+
+	if (*bucket != 0)
+	{
+		(void)pthread_mutex_unlock(&program->mutex);
+		return *bucket - 1;
+	}
+
+	if (program->strings.count >= program->strings.capacity)
+	{
+		program->strings.capacity = 0 == program->strings.capacity ? 64 : program->strings.capacity * 2;
+		program->strings.data = primec_utils_realloc(program->strings.data, program->strings.capacity * sizeof(primec_ir_string_s));
+	}
+
+	const uint32_t index = program->strings.count++;
+	program->strings.data[index] = (primec_ir_string_s) { .data = data, .length = length, .hash = hash };
+	*bucket = index + 1;
+	(void)pthread_mutex_unlock(&program->mutex);
+	return index;
+}
+
+uint32_t primec_ir_program_add_global(
+	primec_ir_program_s* const program,
+	const primec_ir_global_s global)
+{
+	primec_debug_assert(program != NULL);
+	(void)pthread_mutex_lock(&program->mutex);
+
+	if (program->globals.count >= program->globals.capacity)
+	{
+		program->globals.capacity = 0 == program->globals.capacity ? 64 : program->globals.capacity * 2;
+		program->globals.data = primec_utils_realloc(program->globals.data, program->globals.capacity * sizeof(primec_ir_global_s));
+	}
+
+	const uint32_t index = program->globals.count++;
+	program->globals.data[index] = global;
+	(void)pthread_mutex_unlock(&program->mutex);
+	return index;
+}
+
+const char* primec_ir_program_add_name(
+	primec_ir_program_s* const program,
+	const char* const format,
+	...)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(format != NULL);
+
+	va_list args; va_start(args, format);
+	const int32_t length = (int32_t)vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	char* const name = primec_utils_malloc((uint64_t)(length < 0 ? 0 : length) + 1);
+	va_start(args, format);
+	(void)vsnprintf(name, (uint64_t)(length < 0 ? 0 : length) + 1, format, args);
+	va_end(args);
+
+	(void)pthread_mutex_lock(&program->mutex);
+
+	if (program->names.count >= program->names.capacity)
+	{
+		program->names.capacity = 0 == program->names.capacity ? 64 : program->names.capacity * 2;
+		program->names.data = primec_utils_realloc(program->names.data, program->names.capacity * sizeof(char*));
+	}
+
+	program->names.data[program->names.count++] = name;
+	(void)pthread_mutex_unlock(&program->mutex);
+	return name;
+}
+
+primec_ir_func_s* primec_ir_program_get_func(
+	const primec_ir_program_s* const program,
+	const uint32_t index)
+{
+	primec_debug_assert(program != NULL);
+
+	// NOTE: The functions list may be grown by other threads, so it is read
+	//       under the lock, while the functions themselves are never moved.
+	(void)pthread_mutex_lock((pthread_mutex_t*)&program->mutex);
+	primec_debug_assert(index < program->funcs.count);
+	primec_ir_func_s* const func = program->funcs.data[index];
+	(void)pthread_mutex_unlock((pthread_mutex_t*)&program->mutex);
+	return func;
+}
+
+primec_ir_block_t primec_ir_func_add_block(
+	primec_ir_func_s* const func)
+{
+	primec_debug_assert(func != NULL);
+
+	if (func->blocks.count >= func->blocks.capacity)
+	{
+		func->blocks.capacity = 0 == func->blocks.capacity ? 8 : func->blocks.capacity * 2;
+		func->blocks.data = primec_utils_realloc(func->blocks.data, func->blocks.capacity * sizeof(primec_ir_block_s));
+	}
+
+	func->blocks.data[func->blocks.count] = (primec_ir_block_s) {0};
+	return func->blocks.count++;
+}
+
+primec_ir_value_t primec_ir_func_add(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const uint32_t a,
+	const uint32_t b)
+{
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(block < func->blocks.count);
+	primec_debug_assert(op < primec_ir_ops_count);
+
+	if (func->instructions.count >= func->instructions.capacity)
+	{
+		func->instructions.capacity *= 2;
+		func->instructions.data = primec_utils_realloc(func->instructions.data,
+			func->instructions.capacity * sizeof(primec_ir_instruction_s)
+		);
+	}
+
+	const primec_ir_value_t value = func->instructions.count++;
+
+	func->instructions.data[value] = (primec_ir_instruction_s)
+	{
+		.op = (uint8_t)op,
+		.type = type,
+		.a = a,
+		.b = b
+	};
+
+	primec_ir_block_s* const target = &func->blocks.data[block];
+
+	if (target->instructions.count >= target->instructions.capacity)
+	{
+		target->instructions.capacity = 0 == target->instructions.capacity ? 8 : target->instructions.capacity * 2;
+		target->instructions.data = primec_utils_realloc(target->instructions.data,
+			target->instructions.capacity * sizeof(primec_ir_value_t)
+		);
+	}
+
+	target->instructions.data[target->instructions.count++] = value;
+	return value;
+}
+
+primec_ir_value_t primec_ir_func_add_const(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_type_t type,
+	const primec_const_value_s value)
+{
+	return primec_ir_func_add(func, block, primec_ir_op_const, type,
+		(uint32_t)value.uval, (uint32_t)(value.uval >> 32)
+	);
+}
+
+uint32_t primec_ir_func_add_list(
+	primec_ir_func_s* const func,
+	const uint32_t* const values,
+	const uint32_t count)
+{
+	primec_debug_assert(func != NULL);
+
+	while (func->extra.count + count + 1 > func->extra.capacity)
+	{
+		func->extra.capacity = 0 == func->extra.capacity ? 32 : func->extra.capacity * 2;
+		func->extra.data = primec_utils_realloc(func->extra.data, func->extra.capacity * sizeof(uint32_t));
+	}
+
+	const uint32_t index = func->extra.count;
+	func->extra.data[func->extra.count++] = count;
+
+	if (count > 0)
+	{
+		primec_debug_assert(values != NULL);
+		primec_utils_memcpy(&func->extra.data[func->extra.count], values, count * sizeof(uint32_t));
+		func->extra.count += count;
+	}
+
+	return index;
+}
+
+primec_ir_instruction_s* primec_ir_func_get(
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value)
+{
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(value < func->instructions.count);
+	return &func->instructions.data[value];
+}
+
+uint32_t* primec_ir_func_get_list(
+	const primec_ir_func_s* const func,
+	const uint32_t index,
+	uint32_t* const count)
+{
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(index < func->extra.count);
+	primec_debug_assert(count != NULL);
+	*count = func->extra.data[index];
+	return &func->extra.data[index + 1];
+}
+
+primec_const_value_s primec_ir_get_const(
+	const primec_ir_instruction_s* const instruction)
+{
+	primec_debug_assert(instruction != NULL);
+	primec_debug_assert(primec_ir_op_const == instruction->op);
+	primec_const_value_s value = {0};
+	value.uval = (uint64_t)instruction->a | (uint64_t)instruction->b << 32;
+	return value;
+}
+
+bool primec_ir_is_terminator(
+	const primec_ir_op_e op)
+{
+	return op >= primec_ir_op_jump && op <= primec_ir_op_unreachable;
+}
+
+bool primec_ir_block_is_terminated(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block)
+{
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(block < func->blocks.count);
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+	if (0 == record->instructions.count) { return false; }
+
+	const primec_ir_value_t last = record->instructions.data[record->instructions.count - 1];
+	return primec_ir_is_terminator((primec_ir_op_e)func->instructions.data[last].op);
+}
+
+uint32_t primec_ir_block_get_successors(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	primec_ir_block_t* const successors)
+{
+	primec_debug_assert(successors != NULL);
+	if (!primec_ir_block_is_terminated(func, block)) { return 0; }
+
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+	const primec_ir_instruction_s* const last = &func->instructions.data[record->instructions.data[record->instructions.count - 1]];
+
+	switch (last->op)
+	{
+		case primec_ir_op_jump:
+		{
+			successors[0] = last->a;
+			return 1;
+		} break;
+
+		case primec_ir_op_branch:
+		{
+			uint32_t count = 0;
+			const uint32_t* const targets = primec_ir_func_get_list(func, last->b, &count);
+			primec_debug_assert(2 == count);
+			successors[0] = targets[0];
+			successors[1] = targets[1];
+			return successors[0] == successors[1] ? 1 : 2;
+		} break;
+
+		default:
+		{
+			return 0;
+		} break;
+	}
+}
+
+void primec_ir_func_visit_operands(
+	primec_ir_func_s* const func,
+	const primec_ir_value_t value,
+	const primec_ir_operand_visitor_f visitor,
+	void* const context)
+{
+	primec_debug_assert(func != NULL);
+	primec_debug_assert(visitor != NULL);
+	primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+	uint32_t* list = NULL;
+	uint32_t count = 0;
+	uint32_t stride = 1;
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_const:
+		case primec_ir_op_param:
+		case primec_ir_op_slot:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		case primec_ir_op_jump:
+		case primec_ir_op_unreachable:
+		case primec_ir_ops_count:
+		{
+		} break;
+
+		case primec_ir_op_load:
+		case primec_ir_op_zero:
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		case primec_ir_op_convert:
+		case primec_ir_op_splat:
+		case primec_ir_op_reduce:
+		case primec_ir_op_ret:
+		case primec_ir_op_branch:
+		{
+			if (instruction->a != primec_ir_null) { visitor(context, &instruction->a); }
+		} break;
+
+		case primec_ir_op_call:
+		{
+			list = primec_ir_func_get_list(func, instruction->b, &count);
+		} break;
+
+		case primec_ir_op_call_indirect:
+		{
+			visitor(context, &instruction->a);
+			list = primec_ir_func_get_list(func, instruction->b, &count);
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			// NOTE: Incoming values follow their blocks.
+			list = primec_ir_func_get_list(func, instruction->a, &count) + 1;
+			count = count > 0 ? count - 1 : 0;
+			stride = 2;
+		} break;
+
+		default:
+		{
+			visitor(context, &instruction->a);
+			visitor(context, &instruction->b);
+		} break;
+	}
+
+	for (uint32_t index = 0; index < count; index += stride)
+	{
+		visitor(context, &list[index]);
+	}
+}
+
+bool primec_ir_is_aggregate(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const primec_type_s* const record = primec_type_table_get(types, type);
+
+	switch (record->kind)
+	{
+		case primec_type_kind_struct:
+		case primec_type_kind_array:
+		case primec_type_kind_slice:
+		{
+			return true;
+		} break;
+
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		{
+			// NOTE: References to slices are pairs of the data pointer and the
+			//       count of the elements.
+			return primec_type_kind_slice == primec_type_table_get(types, record->element)->kind;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+bool primec_ir_is_pure(
+	const primec_type_table_s* const types,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_const:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		case primec_ir_op_field:
+		case primec_ir_op_element:
+		case primec_ir_op_offset:
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_neg:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		case primec_ir_op_not:
+		case primec_ir_op_shl:
+		case primec_ir_op_shr:
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		case primec_ir_op_splat:
+		case primec_ir_op_reduce:
+		{
+			return true;
+		} break;
+
+		case primec_ir_op_convert:
+		{
+			// NOTE: The floats out of the ranges of the integers trap, when they
+			//       are converted to them.
+			const primec_type_t from = primec_ir_func_get(func, instruction->a)->type;
+			return !primec_type_is_float(types, from) || primec_type_is_float(types, instruction->type);
+		} break;
+
+		case primec_ir_op_div:
+		case primec_ir_op_rem:
+		{
+			const primec_type_s* const record = primec_type_table_get(types, instruction->type);
+			const primec_type_t type = primec_type_kind_enum == record->kind || primec_type_kind_vector == record->kind ? record->element : instruction->type;
+			if (primec_type_is_float(types, type)) { return true; }
+
+			const primec_ir_instruction_s* const divisor = primec_ir_func_get(func, instruction->b);
+			if (divisor->op != primec_ir_op_const) { return false; }
+
+			// NOTE: The x86_64 division traps on the quotient of the minimal value
+			//       and minus one too, so the divisor is compared in its width.
+			const uint64_t size = primec_layout_get(types, type).size;
+			const uint32_t shift = size > 0 && size < 8 ? 64 - 8 * (uint32_t)size : 0;
+			const uint64_t bits = primec_ir_get_const(divisor).uval << shift;
+			return bits != 0 && (!primec_type_is_signed(types, type) || bits != UINT64_MAX << shift);
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+void primec_ir_dump(
+	const primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+	char buffer[dump_line_capacity] = {0};
+
+	for (uint32_t index = 0; index < program->strings.count; ++index)
+	{
+		const primec_ir_string_s* const string = &program->strings.data[index];
+		primec_logger_log("string %u = \"%s\"", index, escape_string(string, buffer, dump_line_capacity));
+	}
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_ir_global_s* const global = &program->globals.data[index];
+		primec_logger_log("global %u `%s`: %s", index, global->name,
+			primec_type_table_format(program->types, global->type, buffer, dump_line_capacity)
+		);
+	}
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_dump_func(program, program->funcs.data[index]);
+	}
+}
+
+void primec_ir_dump_func(
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const func)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(func != NULL);
+	char line[dump_line_capacity] = {0};
+
+	primec_logger_log("func `%s`: %s%s", func->name,
+		primec_type_table_format(program->types, func->type, line, dump_line_capacity),
+		func->flags & primec_ir_func_flag_extern ? " (extern)" : ""
+	);
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+		primec_logger_log("  block%u:", block);
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			(void)dump_instruction(program, func, record->instructions.data[index], line);
+			primec_logger_log("    %s", line);
+		}
+	}
+}
+
+static void destroy_func(
+	primec_ir_func_s* const func)
+{
+	primec_debug_assert(func != NULL);
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_utils_free(func->blocks.data[block].instructions.data);
+	}
+
+	primec_utils_free(func->instructions.data);
+	primec_utils_free(func->blocks.data);
+	primec_utils_free(func->extra.data);
+	primec_utils_free(func);
+}
+
+static uint32_t* find_string_bucket_locked(
+	const primec_ir_program_s* const program,
+	const char* const data,
+	const uint64_t length,
+	const uint32_t hash)
+{
+	primec_debug_assert(program->strings.buckets_capacity > 0);
+	const uint32_t mask = program->strings.buckets_capacity - 1;
+	uint32_t index = hash & mask;
+
+	while (program->strings.buckets[index] != 0)
+	{
+		const primec_ir_string_s* const string = &program->strings.data[program->strings.buckets[index] - 1];
+
+		if (string->hash == hash && string->length == length &&
+			(0 == length || 0 == primec_utils_memcmp(string->data, data, length)))
+		{
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return &program->strings.buckets[index];
+}
+
+static void grow_string_buckets_locked(
+	primec_ir_program_s* const program)
+{
+	primec_utils_free(program->strings.buckets);
+	program->strings.buckets_capacity = 0 == program->strings.buckets_capacity ? 256 : program->strings.buckets_capacity * 2;
+	program->strings.buckets = primec_utils_malloc(program->strings.buckets_capacity * sizeof(uint32_t));
+	primec_utils_memset(program->strings.buckets, 0, program->strings.buckets_capacity * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < program->strings.count; ++index)
+	{
+		const primec_ir_string_s* const string = &program->strings.data[index];
+		*find_string_bucket_locked(program, string->data, string->length, string->hash) = index + 1;
+	}
+}
+
+static const char* escape_string(
+	const primec_ir_string_s* const string,
+	char* const buffer,
+	const uint64_t capacity)
+{
+	uint64_t written = 0;
+
+	// NOTE: Long strings are cut, leaving room for the longest escape sequence.
+	for (uint64_t index = 0; index < string->length && written + 5 < capacity; ++index)
+	{
+		const uint8_t c = (uint8_t)string->data[index];
+
+		switch (c)
+		{
+			case '\n': { buffer[written++] = '\\'; buffer[written++] = 'n'; } break;
+			case '\t': { buffer[written++] = '\\'; buffer[written++] = 't'; } break;
+			case '\\': { buffer[written++] = '\\'; buffer[written++] = '\\'; } break;
+			case '"': { buffer[written++] = '\\'; buffer[written++] = '"'; } break;
+
+			default:
+			{
+				if (c >= 0x20 && c < 0x7f) { buffer[written++] = (char)c; break; }
+				written += (uint64_t)snprintf(buffer + written, capacity - written, "\\x%02x", c);
+			} break;
+		}
+	}
+
+	buffer[written] = '\0';
+	return buffer;
+}
+
+static uint64_t dump_instruction(
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const func,
+	const primec_ir_value_t value,
+	char* const line)
+{
+	const primec_ir_instruction_s* const instruction = &func->instructions.data[value];
+	char type[dump_line_capacity / 4] = {0};
+	(void)primec_type_table_format(program->types, instruction->type, type, sizeof(type));
+	uint64_t written = (uint64_t)snprintf(line, dump_line_capacity, "%%%u = %s %s", value,
+		primec_ir_op_to_string((primec_ir_op_e)instruction->op), type
+	);
+
+	#define append(_format, ...)                                                            \
+		if (written < dump_line_capacity)                                                   \
+		{                                                                                   \
+			written += (uint64_t)snprintf(line + written, dump_line_capacity - written,     \
+				_format, ## __VA_ARGS__);                                                   \
+		}
+
+	switch (instruction->op)
+	{
+		case primec_ir_op_const:
+		{
+			const primec_const_value_s constant = primec_ir_get_const(instruction);
+			append(" %s", primec_const_format(program->types, instruction->type, constant, type, sizeof(type)));
+		} break;
+
+		case primec_ir_op_param:
+		case primec_ir_op_global:
+		case primec_ir_op_string:
+		{
+			append(" %u", instruction->a);
+		} break;
+
+		case primec_ir_op_func:
+		case primec_ir_op_call:
+		{
+			append(" `%s`", program->funcs.data[instruction->a]->name);
+		} break;
+
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		{
+			append(" %%%u, %u", instruction->a, instruction->b);
+		} break;
+
+		case primec_ir_op_jump:
+		{
+			append(" block%u", instruction->a);
+		} break;
+
+		case primec_ir_op_branch:
+		{
+			uint32_t count = 0;
+			const uint32_t* const targets = primec_ir_func_get_list(func, instruction->b, &count);
+			append(" %%%u, block%u, block%u", instruction->a, targets[0], targets[1]);
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			uint32_t count = 0;
+			const uint32_t* const pairs = primec_ir_func_get_list(func, instruction->a, &count);
+
+			for (uint32_t index = 0; index + 1 < count; index += 2)
+			{
+				append("%s [block%u: %%%u]", index > 0 ? "," : "", pairs[index], pairs[index + 1]);
+			}
+		} break;
+
+		case primec_ir_op_call_indirect:
+		{
+			append(" %%%u", instruction->a);
+		} break;
+
+		case primec_ir_op_reduce:
+		{
+			append(" %s %%%u", primec_ir_op_to_string((primec_ir_op_e)instruction->b), instruction->a);
+		} break;
+
+		case primec_ir_op_slot:
+		case primec_ir_op_unreachable:
+		case primec_ir_op_nop:
+		{
+		} break;
+
+		default:
+		{
+			if (instruction->a != primec_ir_null) { append(" %%%u", instruction->a); }
+			if (instruction->b != primec_ir_null) { append(", %%%u", instruction->b); }
+		} break;
+	}
+
+	if (primec_ir_op_call == instruction->op || primec_ir_op_call_indirect == instruction->op)
+	{
+		uint32_t count = 0;
+		const uint32_t* const arguments = primec_ir_func_get_list(func, instruction->b, &count);
+		append("(");
+
+		for (uint32_t index = 0; index < count; ++index)
+		{
+			append("%s%%%u", index > 0 ? ", " : "", arguments[index]);
+		}
+
+		append(")");
+	}
+
+	#undef append
+
+	return written;
+}
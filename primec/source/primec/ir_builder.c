@@ -0,0 +1,1737 @@
+
+/**
+ * @file ir_builder.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/ir_builder.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/runtime.h>
+
+#include <stddef.h>
+
+// NOTE: Slices are kept in memory as pairs of the pointer to their first element
+//       and the count of their elements.
+#define slice_count_offset 8
+
+typedef struct
+{
+	primec_sema_s* sema;
+	primec_ir_program_s* program;
+	uint32_t** indices;
+} context_s;
+
+typedef struct
+{
+	primec_ir_block_t breaks;
+	primec_ir_block_t continues;
+} loop_s;
+
+typedef struct
+{
+	primec_ast_index_t node;
+	primec_ir_value_t value;
+} local_s;
+
+typedef struct
+{
+	context_s* context;
+	uint32_t module;
+	const primec_ast_s* ast;
+	const primec_sema_module_s* info;
+	primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_ir_block_t block;
+	primec_ir_value_t result;
+	uint32_t unsafe;
+	uint32_t* lambdas;
+
+	struct
+	{
+		loop_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} loops;
+
+	// NOTE: Open addressing table of the slots of the locals, keyed by their
+	//       declarations, its capacity is always a power of two.
+	struct
+	{
+		local_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} locals;
+
+	struct
+	{
+		primec_ast_index_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} chain;			// binary nodes of the left-deep chains being lowered
+} builder_s;
+
+typedef struct
+{
+	context_s* context;
+	uint32_t module;
+	primec_ast_index_t node;
+	uint32_t func;
+} build_task_s;
+
+static void declare_module(
+	context_s* const context,
+	const uint32_t module);
+
+static void build_task(
+	void* const context);
+
+static builder_s builder_from_parts(
+	context_s* const context,
+	const uint32_t module,
+	primec_ir_func_s* const func,
+	uint32_t* const lambdas);
+
+static void builder_destroy(
+	builder_s* const builder);
+
+static void build_function(
+	builder_s* const builder,
+	const primec_ast_index_t proto,
+	const primec_ast_index_t body);
+
+static const primec_sema_node_s* get_info(
+	const builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_type_t pointer_to(
+	const builder_s* const builder,
+	const primec_type_t type);
+
+static bool is_aggregate(
+	const builder_s* const builder,
+	const primec_type_t type);
+
+static uint8_t get_kind(
+	const builder_s* const builder,
+	const primec_type_t type);
+
+static primec_type_t get_element(
+	const builder_s* const builder,
+	const primec_type_t type);
+
+static void push_loop(
+	builder_s* const builder,
+	const primec_ir_block_t breaks,
+	const primec_ir_block_t continues);
+
+static void set_local(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t get_local(
+	const builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t emit(
+	builder_s* const builder,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const uint32_t a,
+	const uint32_t b);
+
+static primec_ir_value_t emit_const(
+	builder_s* const builder,
+	const primec_type_t type,
+	const uint64_t value);
+
+static void emit_store(
+	builder_s* const builder,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value);
+
+static void emit_assign(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t emit_load(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t address);
+
+static primec_ir_value_t emit_convert(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t emit_truth(
+	builder_s* const builder,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t emit_check(
+	builder_s* const builder,
+	const primec_ir_value_t index,
+	const primec_ir_value_t length);
+
+static void emit_jump(
+	builder_s* const builder,
+	const primec_ir_block_t target);
+
+static void emit_branch(
+	builder_s* const builder,
+	const primec_ir_value_t condition,
+	const primec_ir_block_t then_block,
+	const primec_ir_block_t else_block);
+
+static void emit_return(
+	builder_s* const builder,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t make_slice(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t pointer,
+	const primec_ir_value_t count);
+
+static primec_ir_value_t slice_pointer(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t slice);
+
+static primec_ir_value_t slice_count(
+	builder_s* const builder,
+	const primec_ir_value_t slice);
+
+static bool is_statement(
+	const primec_ast_kind_e kind);
+
+static primec_ir_value_t lower_block(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static void lower_statement(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static void lower_let(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static void lower_if(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_condition(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_value(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_expression(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_address(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_binding(
+	builder_s* const builder,
+	const primec_sema_node_s* const info);
+
+static primec_ir_value_t lower_string(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	const bool is_pointer);
+
+static primec_ir_value_t lower_unary(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_binary(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static bool is_arithmetic(
+	const builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_logical(
+	builder_s* const builder,
+	const bool is_and,
+	const primec_ir_value_t left,
+	const primec_ast_index_t right);
+
+static primec_ir_value_t lower_assign(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_cast(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_call(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static bool is_temporary(
+	const builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t promote_variadic(
+	builder_s* const builder,
+	const primec_ir_value_t value,
+	const primec_type_t type);
+
+static primec_ir_value_t lower_index(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static void lower_sequence(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	primec_ir_value_t* const pointer,
+	primec_ir_value_t* const count);
+
+static primec_ir_value_t lower_slice(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_member(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_value_t lower_lambda(
+	builder_s* const builder,
+	const primec_ast_index_t node);
+
+static primec_ir_op_e get_operator(
+	const primec_token_type_e operator);
+
+primec_ir_program_s* primec_ir_build(
+	primec_sema_s* const sema)
+{
+	primec_debug_assert(sema != NULL);
+	primec_build_graph_s* const graph = sema->graph;
+
+	context_s context =
+	{
+		.sema = sema,
+		.program = primec_ir_program_create(sema->types),
+		.indices = primec_utils_malloc((graph->modules.count > 0 ? graph->modules.count : 1) * sizeof(uint32_t*))
+	};
+
+	// NOTE: Every function and global is declared before any body is lowered,
+	//       so the calls and the uses of the globals refer to their indices.
+	for (uint32_t index = 0; index < graph->order.count; ++index)
+	{
+		declare_module(&context, graph->order.data[index]);
+	}
+
+	const uint32_t funcs_count = context.program->funcs.count;
+	build_task_s* const tasks = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(build_task_s));
+	primec_thread_pool_group_s group = {0};
+	uint32_t tasks_count = 0;
+
+	for (uint32_t index = 0; index < funcs_count; ++index)
+	{
+		const primec_ir_func_s* const func = context.program->funcs.data[index];
+		if (func->flags & primec_ir_func_flag_extern) { continue; }
+
+		tasks[tasks_count] = (build_task_s)
+		{
+			.context = &context,
+			.module = func->module,
+			.node = func->node,
+			.func = index
+		};
+
+		primec_thread_pool_submit(graph->pool, &group, build_task, &tasks[tasks_count]);
+		++tasks_count;
+	}
+
+	primec_thread_pool_wait(graph->pool, &group);
+	primec_utils_free(tasks);
+
+	for (uint32_t index = 0; index < graph->order.count; ++index)
+	{
+		primec_utils_free(context.indices[graph->order.data[index]]);
+	}
+
+	primec_utils_free(context.indices);
+	return context.program;
+}
+
+static void declare_module(
+	context_s* const context,
+	const uint32_t module)
+{
+	const primec_ast_s* const ast = &context->sema->graph->modules.data[module]->ast;
+	const primec_sema_module_s* const info = &context->sema->modules[module];
+	const primec_ast_range_s declarations = primec_ast_get_list(ast, ast->root);
+	primec_type_table_s* const types = context->sema->types;
+
+	context->indices[module] = primec_utils_malloc(ast->nodes.count * sizeof(uint32_t));
+	primec_utils_memset(context->indices[module], 0, ast->nodes.count * sizeof(uint32_t));
+
+	for (primec_ast_index_t extra = declarations.start; extra < declarations.end; ++extra)
+	{
+		const primec_ast_index_t node = primec_ast_get_extra(ast, extra);
+		const primec_ast_node_s* const declaration = primec_ast_get_node(ast, node);
+		const char* const name = primec_ast_get_token_text(ast, declaration->token);
+
+		if (primec_ast_kind_func_decl == declaration->kind)
+		{
+			const primec_ast_proto_s proto = primec_ast_get_proto(ast, declaration->lhs);
+			const primec_type_t type = info->nodes[node].type;
+			uint32_t flags = 0;
+
+			if (proto.flags & primec_ast_proto_flag_ext) { flags |= primec_ir_func_flag_extern; }
+			if (proto.flags & primec_ast_proto_flag_inl) { flags |= primec_ir_func_flag_inline; }
+
+			if (primec_ir_is_aggregate(types, primec_type_table_get(types, type)->element))
+			{
+				flags |= primec_ir_func_flag_sret;
+			}
+
+			const uint32_t index = primec_ir_program_add_func(context->program, name, type, flags);
+			primec_ir_func_s* const func = primec_ir_program_get_func(context->program, index);
+			func->module = module;
+			func->node = node;
+			context->indices[module][node] = index;
+
+			if (module == context->sema->graph->runtime)
+			{
+				if (0 == primec_utils_strcmp(name, primec_runtime_flush)) { context->program->flush = index; }
+				if (0 == primec_utils_strcmp(name, primec_runtime_syscall)) { context->program->syscall = index; }
+			}
+		}
+		else if (primec_ast_kind_let_decl == declaration->kind)
+		{
+			primec_ir_global_s global =
+			{
+				.name = name,
+				.type = info->nodes[node].type,
+				.module = module,
+				.node = node,
+				.init = primec_ir_global_init_zero
+			};
+
+			// NOTE: The initializers of the globals are either constants or
+			//       string literals (which is checked by the semantic analysis).
+			if (declaration->rhs != primec_ast_null &&
+				primec_ast_kind_string_literal == primec_ast_get_node(ast, declaration->rhs)->kind)
+			{
+				const primec_token_value_s* const value = primec_ast_get_token_value(ast, primec_ast_get_node(ast, declaration->rhs)->token);
+				global.init = primec_ir_global_init_string;
+				global.string = primec_ir_program_add_string(context->program,
+					primec_ast_get_token_text(ast, primec_ast_get_node(ast, declaration->rhs)->token), value->text.length
+				);
+			}
+			else if (declaration->rhs != primec_ast_null && (info->nodes[declaration->rhs].flags & primec_sema_flag_constant))
+			{
+				global.init = primec_ir_global_init_const;
+				global.value = info->values[declaration->rhs];
+			}
+
+			context->indices[module][node] = primec_ir_program_add_global(context->program, global);
+		}
+	}
+}
+
+static void build_task(
+	void* const context)
+{
+	build_task_s* const task = (build_task_s*)context;
+	primec_debug_assert(task != NULL);
+	primec_ir_func_s* const func = primec_ir_program_get_func(task->context->program, task->func);
+	uint32_t lambdas = 0;
+
+	builder_s builder = builder_from_parts(task->context, task->module, func, &lambdas);
+	const primec_ast_node_s* const node = primec_ast_get_node(builder.ast, task->node);
+	build_function(&builder, node->lhs, node->rhs);
+	builder_destroy(&builder);
+}
+
+static builder_s builder_from_parts(
+	context_s* const context,
+	const uint32_t module,
+	primec_ir_func_s* const func,
+	uint32_t* const lambdas)
+{
+	return (builder_s)
+	{
+		.context = context,
+		.module = module,
+		.ast = &context->sema->graph->modules.data[module]->ast,
+		.info = &context->sema->modules[module],
+		.types = context->sema->types,
+		.func = func,
+		.lambdas = lambdas
+	};
+}
+
+static void builder_destroy(
+	builder_s* const builder)
+{
+	primec_debug_assert(builder != NULL);
+	primec_utils_free(builder->loops.data);
+	primec_utils_free(builder->locals.data);
+	primec_utils_free(builder->chain.data);
+}
+
+static void build_function(
+	builder_s* const builder,
+	const primec_ast_index_t proto,
+	const primec_ast_index_t body)
+{
+	const primec_ast_proto_s record = primec_ast_get_proto(builder->ast, proto);
+	const primec_type_t* const params = primec_type_table_get_list(builder->types, builder->func->type);
+	const primec_type_t return_type = get_element(builder, builder->func->type);
+	uint32_t abi_index = 0;
+
+	builder->block = primec_ir_func_add_block(builder->func);
+
+	// NOTE: Aggregates are returned through the hidden pointer, passed first.
+	if (builder->func->flags & primec_ir_func_flag_sret)
+	{
+		builder->result = emit(builder, primec_ir_op_param, pointer_to(builder, return_type), abi_index++, 0);
+	}
+
+	// NOTE: Aggregate arguments are passed by the addresses of their copies,
+	//       owned by the callers, so they are used in place, while the scalar
+	//       ones are spilled into slots like the other locals.
+	for (uint32_t index = 0; index < record.params.end - record.params.start; ++index)
+	{
+		const primec_ast_index_t param = primec_ast_get_extra(builder->ast, record.params.start + index);
+		const primec_type_t type = params[index];
+
+		if (is_aggregate(builder, type))
+		{
+			set_local(builder, param, emit(builder, primec_ir_op_param, pointer_to(builder, type), abi_index++, 0));
+			continue;
+		}
+
+		const primec_ir_value_t value = emit(builder, primec_ir_op_param, type, abi_index++, 0);
+		const primec_ir_value_t slot = emit(builder, primec_ir_op_slot, pointer_to(builder, type), 0, 0);
+		emit_store(builder, slot, value);
+		set_local(builder, param, slot);
+	}
+
+	const primec_ir_value_t tail = lower_block(builder, body);
+
+	if (!primec_ir_block_is_terminated(builder->func, builder->block))
+	{
+		if (primec_type_void == return_type)
+		{
+			(void)emit(builder, primec_ir_op_ret, primec_type_void, primec_ir_null, 0);
+		}
+		else if (tail != primec_ir_null)
+		{
+			emit_return(builder, tail);
+		}
+		else
+		{
+			(void)emit(builder, primec_ir_op_unreachable, primec_type_void, 0, 0);
+		}
+	}
+}
+
+static const primec_sema_node_s* get_info(
+	const builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	primec_debug_assert(node < builder->ast->nodes.count);
+	return &builder->info->nodes[node];
+}
+
+static primec_type_t pointer_to(
+	const builder_s* const builder,
+	const primec_type_t type)
+{
+	return primec_type_table_get_pointer(builder->types, type, true);
+}
+
+static bool is_aggregate(
+	const builder_s* const builder,
+	const primec_type_t type)
+{
+	return primec_ir_is_aggregate(builder->types, type);
+}
+
+static uint8_t get_kind(
+	const builder_s* const builder,
+	const primec_type_t type)
+{
+	return primec_type_table_get(builder->types, type)->kind;
+}
+
+static primec_type_t get_element(
+	const builder_s* const builder,
+	const primec_type_t type)
+{
+	return primec_type_table_get(builder->types, type)->element;
+}
+
+static void push_loop(
+	builder_s* const builder,
+	const primec_ir_block_t breaks,
+	const primec_ir_block_t continues)
+{
+	if (builder->loops.count >= builder->loops.capacity)
+	{
+		builder->loops.capacity = 0 == builder->loops.capacity ? 8 : builder->loops.capacity * 2;
+		builder->loops.data = primec_utils_realloc(builder->loops.data, builder->loops.capacity * sizeof(loop_s));
+	}
+
+	builder->loops.data[builder->loops.count++] = (loop_s) { .breaks = breaks, .continues = continues };
+}
+
+static void set_local(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	const primec_ir_value_t value)
+{
+	primec_debug_assert(node != primec_ast_null);
+
+	if ((builder->locals.count + 1) * 2 > builder->locals.capacity)
+	{
+		const uint32_t capacity = 0 == builder->locals.capacity ? 32 : builder->locals.capacity * 2;
+		local_s* const data = primec_utils_malloc(capacity * sizeof(local_s));
+		primec_utils_memset(data, 0, capacity * sizeof(local_s));
+
+		for (uint32_t index = 0; index < builder->locals.capacity; ++index)
+		{
+			const local_s local = builder->locals.data[index];
+			if (primec_ast_null == local.node) { continue; }
+
+			uint32_t slot = (local.node * 2654435761u) & (capacity - 1);
+			while (data[slot].node != primec_ast_null) { slot = (slot + 1) & (capacity - 1); }
+			data[slot] = local;
+		}
+
+		primec_utils_free(builder->locals.data);
+		builder->locals.data = data;
+		builder->locals.capacity = capacity;
+	}
+
+	const uint32_t mask = builder->locals.capacity - 1;
+	uint32_t slot = (node * 2654435761u) & mask;
+	while (builder->locals.data[slot].node != primec_ast_null) { slot = (slot + 1) & mask; }
+	builder->locals.data[slot] = (local_s) { .node = node, .value = value };
+	++builder->locals.count;
+}
+
+static primec_ir_value_t get_local(
+	const builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	primec_debug_assert(builder->locals.capacity > 0);
+	const uint32_t mask = builder->locals.capacity - 1;
+	uint32_t slot = (node * 2654435761u) & mask;
+
+	while (builder->locals.data[slot].node != node)
+	{
+		primec_debug_assert(builder->locals.data[slot].node != primec_ast_null);
+		slot = (slot + 1) & mask;
+	}
+
+	return builder->locals.data[slot].value;
+}
+
+static primec_ir_value_t emit(
+	builder_s* const builder,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const uint32_t a,
+	const uint32_t b)
+{
+	const primec_ir_value_t value = primec_ir_func_add(builder->func, builder->block, op, type, a, b);
+	if (builder->unsafe > 0) { primec_ir_func_get(builder->func, value)->flags |= primec_ir_instruction_flag_unsafe; }
+	return value;
+}
+
+static primec_ir_value_t emit_const(
+	builder_s* const builder,
+	const primec_type_t type,
+	const uint64_t value)
+{
+	primec_type_t actual = type;
+
+	// NOTE: Untyped constants in the contexts without a type are evaluated with
+	//       the widest types.
+	if (primec_type_untyped_int == type) { actual = primec_type_i64; }
+	if (primec_type_untyped_float == type) { actual = primec_type_f64; }
+
+	return emit(builder, primec_ir_op_const, actual, (uint32_t)value, (uint32_t)(value >> 32));
+}
+
+static void emit_store(
+	builder_s* const builder,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value)
+{
+	(void)emit(builder, primec_ir_op_store, primec_ir_func_get(builder->func, value)->type, address, value);
+}
+
+static void emit_assign(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value)
+{
+	if (is_aggregate(builder, type))
+	{
+		(void)emit(builder, primec_ir_op_copy, type, address, value);
+		return;
+	}
+
+	emit_store(builder, address, value);
+}
+
+static primec_ir_value_t emit_load(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t address)
+{
+	// NOTE: The values of the aggregates are their addresses.
+	if (is_aggregate(builder, type))
+	{
+		return address;
+	}
+
+	return emit(builder, primec_ir_op_load, type, address, 0);
+}
+
+static primec_ir_value_t emit_convert(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t value)
+{
+	if (primec_ir_func_get(builder->func, value)->type == type)
+	{
+		return value;
+	}
+
+	return emit(builder, primec_ir_op_convert, type, value, 0);
+}
+
+static primec_ir_value_t emit_truth(
+	builder_s* const builder,
+	const primec_ir_value_t value)
+{
+	const primec_type_t type = primec_ir_func_get(builder->func, value)->type;
+	if (primec_type_bool == type) { return value; }
+	return emit(builder, primec_ir_op_ne, primec_type_bool, value, emit_const(builder, type, 0));
+}
+
+static primec_ir_value_t emit_check(
+	builder_s* const builder,
+	const primec_ir_value_t index,
+	const primec_ir_value_t length)
+{
+	// NOTE: Signed indices are sign extended, so the negative ones are out of
+	//       range as well.
+	const primec_ir_value_t unsigned_index = emit_convert(builder, primec_type_u64, index);
+	(void)emit(builder, primec_ir_op_check, primec_type_u64, unsigned_index, length);
+	return unsigned_index;
+}
+
+static void emit_jump(
+	builder_s* const builder,
+	const primec_ir_block_t target)
+{
+	if (!primec_ir_block_is_terminated(builder->func, builder->block))
+	{
+		(void)emit(builder, primec_ir_op_jump, primec_type_void, target, 0);
+	}
+}
+
+static void emit_branch(
+	builder_s* const builder,
+	const primec_ir_value_t condition,
+	const primec_ir_block_t then_block,
+	const primec_ir_block_t else_block)
+{
+	const uint32_t targets[2] = { then_block, else_block };
+	const uint32_t list = primec_ir_func_add_list(builder->func, targets, 2);
+	(void)emit(builder, primec_ir_op_branch, primec_type_void, condition, list);
+}
+
+static void emit_return(
+	builder_s* const builder,
+	const primec_ir_value_t value)
+{
+	const primec_type_t type = get_element(builder, builder->func->type);
+
+	if (builder->result != primec_ir_null)
+	{
+		(void)emit(builder, primec_ir_op_copy, type, builder->result, value);
+		(void)emit(builder, primec_ir_op_ret, primec_type_void, primec_ir_null, 0);
+		return;
+	}
+
+	(void)emit(builder, primec_ir_op_ret, type, value, 0);
+}
+
+static primec_ir_value_t make_slice(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t pointer,
+	const primec_ir_value_t count)
+{
+	const primec_ir_value_t slot = emit(builder, primec_ir_op_slot, pointer_to(builder, type), 0, 0);
+	emit_store(builder, slot, pointer);
+	emit_store(builder, emit(builder, primec_ir_op_offset, pointer_to(builder, primec_type_u64), slot, slice_count_offset), count);
+	return slot;
+}
+
+static primec_ir_value_t slice_pointer(
+	builder_s* const builder,
+	const primec_type_t type,
+	const primec_ir_value_t slice)
+{
+	return emit(builder, primec_ir_op_load, type, slice, 0);
+}
+
+static primec_ir_value_t slice_count(
+	builder_s* const builder,
+	const primec_ir_value_t slice)
+{
+	const primec_ir_value_t address = emit(builder, primec_ir_op_offset, pointer_to(builder, primec_type_u64), slice, slice_count_offset);
+	return emit(builder, primec_ir_op_load, primec_type_u64, address, 0);
+}
+
+static bool is_statement(
+	const primec_ast_kind_e kind)
+{
+	return (kind >= primec_ast_kind_block && kind <= primec_ast_kind_return) ||
+		primec_ast_kind_let_decl == kind || primec_ast_kind_alias_decl == kind;
+}
+
+static primec_ir_value_t lower_block(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_range_s statements = primec_ast_get_list(builder->ast, node);
+	primec_ir_value_t value = primec_ir_null;
+
+	for (primec_ast_index_t extra = statements.start; extra < statements.end; ++extra)
+	{
+		const primec_ast_index_t statement = primec_ast_get_extra(builder->ast, extra);
+		const primec_ast_kind_e kind = primec_ast_get_node(builder->ast, statement)->kind;
+
+		// NOTE: The last expression (or unsafe block) of a block is its value.
+		if (!is_statement(kind) || (primec_ast_kind_unsafe_block == kind && extra + 1 == statements.end))
+		{
+			value = lower_value(builder, statement);
+			continue;
+		}
+
+		lower_statement(builder, statement);
+	}
+
+	return value;
+}
+
+static void lower_statement(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const statement = primec_ast_get_node(builder->ast, node);
+
+	switch (statement->kind)
+	{
+		case primec_ast_kind_let_decl:
+		{
+			lower_let(builder, node);
+		} break;
+
+		case primec_ast_kind_alias_decl:
+		{
+		} break;
+
+		case primec_ast_kind_block:
+		{
+			(void)lower_block(builder, node);
+		} break;
+
+		case primec_ast_kind_unsafe_block:
+		{
+			++builder->unsafe;
+			(void)lower_block(builder, statement->lhs);
+			--builder->unsafe;
+		} break;
+
+		case primec_ast_kind_expr_stmt:
+		{
+			(void)lower_expression(builder, statement->lhs);
+		} break;
+
+		case primec_ast_kind_if:
+		{
+			lower_if(builder, node);
+		} break;
+
+		case primec_ast_kind_while:
+		{
+			const primec_ir_block_t condition = primec_ir_func_add_block(builder->func);
+			const primec_ir_block_t body = primec_ir_func_add_block(builder->func);
+			const primec_ir_block_t end = primec_ir_func_add_block(builder->func);
+
+			emit_jump(builder, condition);
+			builder->block = condition;
+			emit_branch(builder, lower_condition(builder, statement->lhs), body, end);
+
+			builder->block = body;
+			push_loop(builder, end, condition);
+			(void)lower_block(builder, statement->rhs);
+			--builder->loops.count;
+			emit_jump(builder, condition);
+			builder->block = end;
+		} break;
+
+		case primec_ast_kind_loop:
+		{
+			const primec_ir_block_t body = primec_ir_func_add_block(builder->func);
+			const primec_ir_block_t end = primec_ir_func_add_block(builder->func);
+
+			emit_jump(builder, body);
+			builder->block = body;
+			push_loop(builder, end, body);
+			(void)lower_block(builder, statement->lhs);
+			--builder->loops.count;
+			emit_jump(builder, body);
+			builder->block = end;
+		} break;
+
+		case primec_ast_kind_break:
+		case primec_ast_kind_continue:
+		{
+			primec_debug_assert(builder->loops.count > 0);
+			const loop_s* const loop = &builder->loops.data[builder->loops.count - 1];
+			emit_jump(builder, primec_ast_kind_break == statement->kind ? loop->breaks : loop->continues);
+			builder->block = primec_ir_func_add_block(builder->func);
+		} break;
+
+		case primec_ast_kind_return:
+		{
+			if (primec_ast_null == statement->lhs)
+			{
+				(void)emit(builder, primec_ir_op_ret, primec_type_void, primec_ir_null, 0);
+			}
+			else
+			{
+				emit_return(builder, lower_value(builder, statement->lhs));
+			}
+
+			// NOTE: The statements after the return are lowered into a block
+			//       without predecessors, which is dropped by the optimizer.
+			builder->block = primec_ir_func_add_block(builder->func);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+}
+
+static void lower_let(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const declaration = primec_ast_get_node(builder->ast, node);
+	const primec_type_t type = get_info(builder, node)->type;
+
+	// NOTE: The slot is bound after the initializer is lowered, but the names
+	//       are already resolved, so the order does not matter.
+	const primec_ir_value_t slot = emit(builder, primec_ir_op_slot, pointer_to(builder, type), 0, 0);
+
+	if (declaration->rhs != primec_ast_null)
+	{
+		emit_assign(builder, type, slot, lower_value(builder, declaration->rhs));
+	}
+	else if (is_aggregate(builder, type))
+	{
+		(void)emit(builder, primec_ir_op_zero, type, slot, 0);
+	}
+	else
+	{
+		emit_store(builder, slot, emit_const(builder, type, 0));
+	}
+
+	set_local(builder, node, slot);
+}
+
+static void lower_if(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const statement = primec_ast_get_node(builder->ast, node);
+	const primec_ast_if_s record = primec_ast_get_if(builder->ast, statement->rhs);
+	const primec_ir_value_t condition = lower_condition(builder, statement->lhs);
+
+	const primec_ir_block_t then_block = primec_ir_func_add_block(builder->func);
+	const primec_ir_block_t else_block = record.else_branch != primec_ast_null ? primec_ir_func_add_block(builder->func) : 0;
+	const primec_ir_block_t end = primec_ir_func_add_block(builder->func);
+
+	emit_branch(builder, condition, then_block, record.else_branch != primec_ast_null ? else_block : end);
+	builder->block = then_block;
+	(void)lower_block(builder, record.then_block);
+	emit_jump(builder, end);
+
+	if (record.else_branch != primec_ast_null)
+	{
+		builder->block = else_block;
+
+		if (primec_ast_kind_if == primec_ast_get_node(builder->ast, record.else_branch)->kind)
+		{
+			lower_if(builder, record.else_branch);
+		}
+		else
+		{
+			(void)lower_block(builder, record.else_branch);
+		}
+
+		emit_jump(builder, end);
+	}
+
+	builder->block = end;
+}
+
+static primec_ir_value_t lower_condition(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	return emit_truth(builder, lower_value(builder, node));
+}
+
+static primec_ir_value_t lower_value(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_sema_node_s* const info = get_info(builder, node);
+
+	// NOTE: String literals used as pointers refer to their characters directly.
+	if (primec_sema_coercion_slice_to_pointer == info->coercion &&
+		primec_ast_kind_string_literal == primec_ast_get_node(builder->ast, node)->kind)
+	{
+		return lower_string(builder, node, true);
+	}
+
+	const primec_ir_value_t value = lower_expression(builder, node);
+
+	switch (info->coercion)
+	{
+		case primec_sema_coercion_none:
+		{
+			return value;
+		} break;
+
+		case primec_sema_coercion_deref:
+		{
+			return emit_load(builder, info->target, value);
+		} break;
+
+		case primec_sema_coercion_array_to_slice:
+		{
+			const uint64_t count = primec_type_table_get(builder->types, get_element(builder, info->type))->count;
+			return make_slice(builder, info->target, value, emit_const(builder, primec_type_u64, count));
+		} break;
+
+		case primec_sema_coercion_slice_to_pointer:
+		{
+			return slice_pointer(builder, info->target, value);
+		} break;
+
+		case primec_sema_coercion_bool_to_int:
+		{
+			return emit_convert(builder, info->target, value);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return value;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_expression(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_sema_node_s* const info = get_info(builder, node);
+
+	if (info->flags & primec_sema_flag_constant)
+	{
+		return emit_const(builder, info->type, builder->info->values[node].uval);
+	}
+
+	switch (expression->kind)
+	{
+		case primec_ast_kind_identifier:
+		case primec_ast_kind_scope:
+		{
+			if (primec_binding_kind_func == info->binding)
+			{
+				return emit(builder, primec_ir_op_func, info->type, builder->context->indices[info->module][info->node], 0);
+			}
+
+			return emit_load(builder, info->type, lower_binding(builder, info));
+		} break;
+
+		case primec_ast_kind_string_literal: { return lower_string(builder, node, false); } break;
+		case primec_ast_kind_unary: { return lower_unary(builder, node); } break;
+		case primec_ast_kind_binary: { return lower_binary(builder, node); } break;
+		case primec_ast_kind_assign: { return lower_assign(builder, node); } break;
+		case primec_ast_kind_cast: { return lower_cast(builder, node); } break;
+		case primec_ast_kind_call: { return lower_call(builder, node); } break;
+		case primec_ast_kind_slice: { return lower_slice(builder, node); } break;
+		case primec_ast_kind_lambda: { return lower_lambda(builder, node); } break;
+		case primec_ast_kind_address_of: { return lower_address(builder, expression->lhs); } break;
+
+		case primec_ast_kind_index:
+		case primec_ast_kind_deref:
+		{
+			return emit_load(builder, info->type, lower_address(builder, node));
+		} break;
+
+		case primec_ast_kind_member:
+		{
+			if (primec_sema_member_count == info->node)
+			{
+				return lower_member(builder, node);
+			}
+
+			return emit_load(builder, info->type, lower_address(builder, node));
+		} break;
+
+		case primec_ast_kind_unsafe_block:
+		{
+			++builder->unsafe;
+			const primec_ir_value_t value = lower_block(builder, expression->lhs);
+			--builder->unsafe;
+			return value;
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return primec_ir_null;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_address(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_sema_node_s* const info = get_info(builder, node);
+
+	switch (expression->kind)
+	{
+		case primec_ast_kind_identifier:
+		case primec_ast_kind_scope:
+		{
+			if (info->binding != primec_binding_kind_func)
+			{
+				return lower_binding(builder, info);
+			}
+		} break;
+
+		// NOTE: References to slices are the addresses of their pairs already.
+		case primec_ast_kind_deref: { return lower_expression(builder, expression->lhs); } break;
+		case primec_ast_kind_index: { return lower_index(builder, node); } break;
+		case primec_ast_kind_slice: { return lower_slice(builder, node); } break;
+
+		case primec_ast_kind_member:
+		{
+			if (info->node != primec_sema_member_count)
+			{
+				return lower_member(builder, node);
+			}
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	// NOTE: Temporaries are spilled into slots to get their addresses.
+	const primec_ir_value_t value = lower_value(builder, node);
+	if (is_aggregate(builder, info->target)) { return value; }
+
+	const primec_ir_value_t slot = emit(builder, primec_ir_op_slot, pointer_to(builder, info->target), 0, 0);
+	emit_store(builder, slot, value);
+	return slot;
+}
+
+static primec_ir_value_t lower_binding(
+	builder_s* const builder,
+	const primec_sema_node_s* const info)
+{
+	switch (info->binding)
+	{
+		case primec_binding_kind_global:
+		{
+			return emit(builder, primec_ir_op_global, pointer_to(builder, info->type),
+				builder->context->indices[info->module][info->node], 0
+			);
+		} break;
+
+		case primec_binding_kind_param:
+		case primec_binding_kind_local:
+		{
+			primec_debug_assert(info->module == builder->module);
+			return get_local(builder, info->node);
+		} break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unexpected binding kind `%s` in the ir builder.",
+				primec_binding_kind_to_string((primec_binding_kind_e)info->binding)
+			);
+			return primec_ir_null;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_string(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	const bool is_pointer)
+{
+	const uint32_t token = primec_ast_get_node(builder->ast, node)->token;
+	const primec_token_value_s* const value = primec_ast_get_token_value(builder->ast, token);
+	const uint32_t index = primec_ir_program_add_string(builder->context->program,
+		primec_ast_get_token_text(builder->ast, token), value->text.length
+	);
+
+	const primec_ir_value_t pointer = emit(builder, primec_ir_op_string, pointer_to(builder, primec_type_c8), index, 0);
+	if (is_pointer) { return pointer; }
+	return make_slice(builder, get_info(builder, node)->type, pointer, emit_const(builder, primec_type_u64, value->text.length));
+}
+
+static primec_ir_value_t lower_unary(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(builder->ast, expression->token)->type;
+	const primec_type_t type = get_info(builder, node)->type;
+	const primec_ir_value_t operand = lower_value(builder, expression->lhs);
+
+	switch (operator)
+	{
+		case primec_token_type_add: { return operand; } break;
+		case primec_token_type_subtract: { return emit(builder, primec_ir_op_neg, type, operand, 0); } break;
+		case primec_token_type_bnot: { return emit(builder, primec_ir_op_not, type, operand, 0); } break;
+
+		case primec_token_type_lnot:
+		{
+			const primec_type_t operand_type = primec_ir_func_get(builder->func, operand)->type;
+			return emit(builder, primec_ir_op_eq, primec_type_bool, operand, emit_const(builder, operand_type, 0));
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return primec_ir_null;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_binary(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(builder->ast, expression->token)->type;
+
+	if (primec_token_type_land == operator || primec_token_type_lor == operator)
+	{
+		return lower_logical(builder, primec_token_type_land == operator, lower_condition(builder, expression->lhs), expression->rhs);
+	}
+
+	if (primec_token_type_lxor == operator)
+	{
+		const primec_ir_value_t left = lower_condition(builder, expression->lhs);
+		return emit(builder, primec_ir_op_ne, primec_type_bool, left, lower_condition(builder, expression->rhs));
+	}
+
+	// NOTE: The left operands of the left-deep chains, such as the long sums,
+	//       are walked down without the recursion, as long as lowering them as
+	//       values is the same as lowering their operators.
+	const uint32_t base = builder->chain.count;
+	primec_ast_index_t innermost = node;
+
+	while (true)
+	{
+		if (builder->chain.count >= builder->chain.capacity)
+		{
+			builder->chain.capacity = 0 == builder->chain.capacity ? 64 : builder->chain.capacity * 2;
+			builder->chain.data = primec_utils_realloc(builder->chain.data, builder->chain.capacity * sizeof(primec_ast_index_t));
+		}
+
+		builder->chain.data[builder->chain.count++] = innermost;
+		const primec_ast_index_t left = primec_ast_get_node(builder->ast, innermost)->lhs;
+		const primec_sema_node_s* const info = get_info(builder, left);
+
+		if (!is_arithmetic(builder, left) || (info->flags & primec_sema_flag_constant) ||
+			info->coercion != primec_sema_coercion_none)
+		{
+			break;
+		}
+
+		innermost = left;
+	}
+
+	primec_ir_value_t value = lower_value(builder, primec_ast_get_node(builder->ast, innermost)->lhs);
+
+	while (builder->chain.count > base)
+	{
+		const primec_ast_index_t binary = builder->chain.data[--builder->chain.count];
+		const primec_ast_node_s* const record = primec_ast_get_node(builder->ast, binary);
+		const primec_token_type_e binary_operator = (primec_token_type_e)primec_ast_get_token(builder->ast, record->token)->type;
+		const primec_ir_value_t right = lower_value(builder, record->rhs);
+		value = emit(builder, get_operator(binary_operator), get_info(builder, binary)->type, value, right);
+	}
+
+	return value;
+}
+
+static bool is_arithmetic(
+	const builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	if (expression->kind != primec_ast_kind_binary) { return false; }
+
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(builder->ast, expression->token)->type;
+	return operator != primec_token_type_land && operator != primec_token_type_lor && operator != primec_token_type_lxor;
+}
+
+static primec_ir_value_t lower_logical(
+	builder_s* const builder,
+	const bool is_and,
+	const primec_ir_value_t left,
+	const primec_ast_index_t right)
+{
+	const primec_ir_block_t left_block = builder->block;
+	const primec_ir_block_t right_block = primec_ir_func_add_block(builder->func);
+	const primec_ir_block_t end = primec_ir_func_add_block(builder->func);
+
+	// NOTE: When the right operand is skipped, the result is the left one.
+	emit_branch(builder, left, is_and ? right_block : end, is_and ? end : right_block);
+	builder->block = right_block;
+	const primec_ir_value_t value = lower_condition(builder, right);
+	const uint32_t incoming[4] = { left_block, left, builder->block, value };
+	emit_jump(builder, end);
+
+	builder->block = end;
+	return emit(builder, primec_ir_op_phi, primec_type_bool, primec_ir_func_add_list(builder->func, incoming, 4), 0);
+}
+
+static primec_ir_value_t lower_assign(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(builder->ast, expression->token)->type;
+	const primec_sema_node_s* const target = get_info(builder, expression->lhs);
+	const primec_type_t type = target->target;
+
+	// NOTE: Assigning to a reference assigns to the value it refers to.
+	const primec_ir_value_t address = primec_sema_coercion_deref == target->coercion
+		? lower_expression(builder, expression->lhs)
+		: lower_address(builder, expression->lhs);
+
+	if (primec_token_type_assign == operator)
+	{
+		emit_assign(builder, type, address, lower_value(builder, expression->rhs));
+		return primec_ir_null;
+	}
+
+	const primec_ir_value_t old = emit_load(builder, type, address);
+	primec_ir_value_t value = primec_ir_null;
+
+	switch (operator)
+	{
+		case primec_token_type_land_assign:
+		case primec_token_type_lor_assign:
+		{
+			value = lower_logical(builder, primec_token_type_land_assign == operator, emit_truth(builder, old), expression->rhs);
+			value = emit_convert(builder, type, value);
+		} break;
+
+		case primec_token_type_lxor_assign:
+		{
+			const primec_ir_value_t left = emit_truth(builder, old);
+			value = emit(builder, primec_ir_op_ne, primec_type_bool, left, lower_condition(builder, expression->rhs));
+			value = emit_convert(builder, type, value);
+		} break;
+
+		case primec_token_type_bnot_assign:
+		{
+			value = emit(builder, primec_ir_op_not, type, lower_value(builder, expression->rhs), 0);
+		} break;
+
+		case primec_token_type_add_assign:        { value = emit(builder, primec_ir_op_add, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_subtract_assign:   { value = emit(builder, primec_ir_op_sub, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_multiply_assign:   { value = emit(builder, primec_ir_op_mul, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_divide_assign:     { value = emit(builder, primec_ir_op_div, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_modulus_assign:    { value = emit(builder, primec_ir_op_rem, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_band_assign:       { value = emit(builder, primec_ir_op_and, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_bor_assign:        { value = emit(builder, primec_ir_op_or, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_bxor_assign:       { value = emit(builder, primec_ir_op_xor, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_lshift_assign:     { value = emit(builder, primec_ir_op_shl, type, old, lower_value(builder, expression->rhs)); } break;
+		case primec_token_type_rshift_assign:     { value = emit(builder, primec_ir_op_shr, type, old, lower_value(builder, expression->rhs)); } break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	emit_store(builder, address, value);
+	return primec_ir_null;
+}
+
+static primec_ir_value_t lower_cast(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_type_t from = get_info(builder, expression->lhs)->target;
+	const primec_type_t to = get_info(builder, node)->type;
+	const primec_ir_value_t value = lower_value(builder, expression->lhs);
+
+	// NOTE: References to slices are cast through their data pointers.
+	if (is_aggregate(builder, from))
+	{
+		const primec_ir_value_t pointer = slice_pointer(builder,
+			pointer_to(builder, get_element(builder, get_element(builder, from))), value
+		);
+
+		return emit_convert(builder, to, pointer);
+	}
+
+	return emit_convert(builder, to, value);
+}
+
+static primec_ir_value_t lower_call(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_sema_node_s* const callee = get_info(builder, expression->lhs);
+	const primec_ast_kind_e callee_kind = primec_ast_get_node(builder->ast, expression->lhs)->kind;
+	const primec_ast_range_s arguments = primec_ast_get_range(builder->ast, expression->rhs);
+	const uint32_t arguments_count = arguments.end - arguments.start;
+
+	const primec_type_t func_type = callee->target;
+	const primec_type_t* const params = primec_type_table_get_list(builder->types, func_type);
+	const uint32_t params_count = primec_type_table_get(builder->types, func_type)->list.count;
+	const primec_type_t return_type = get_element(builder, func_type);
+	const bool is_sret = is_aggregate(builder, return_type);
+
+	// NOTE: Functions named directly are called directly, the other callees are
+	//       evaluated first, as they are written first.
+	const bool is_direct = primec_binding_kind_func == callee->binding && primec_sema_coercion_none == callee->coercion &&
+		(primec_ast_kind_identifier == callee_kind || primec_ast_kind_scope == callee_kind);
+	const primec_ir_value_t target = is_direct ? primec_ir_null : lower_value(builder, expression->lhs);
+
+	uint32_t* const values = primec_utils_malloc((arguments_count + 1) * sizeof(uint32_t));
+	uint32_t values_count = 0;
+	primec_ir_value_t result = primec_ir_null;
+
+	if (is_sret)
+	{
+		result = emit(builder, primec_ir_op_slot, pointer_to(builder, return_type), 0, 0);
+		values[values_count++] = result;
+	}
+
+	for (uint32_t index = 0; index < arguments_count; ++index)
+	{
+		const primec_ast_index_t argument = primec_ast_get_extra(builder->ast, arguments.start + index);
+		primec_ir_value_t value = lower_value(builder, argument);
+
+		if (index >= params_count)
+		{
+			value = promote_variadic(builder, value, get_info(builder, argument)->target);
+		}
+		else if (is_aggregate(builder, params[index]) && !is_temporary(builder, argument))
+		{
+			// NOTE: Aggregates are passed by the addresses of their copies, so the
+			//       callees may modify them.
+			const primec_ir_value_t copy = emit(builder, primec_ir_op_slot, pointer_to(builder, params[index]), 0, 0);
+			(void)emit(builder, primec_ir_op_copy, params[index], copy, value);
+			value = copy;
+		}
+
+		values[values_count++] = value;
+	}
+
+	const uint32_t list = primec_ir_func_add_list(builder->func, values, values_count);
+	const primec_type_t type = is_sret ? primec_type_void : return_type;
+	primec_utils_free(values);
+
+	const primec_ir_value_t value = is_direct
+		? emit(builder, primec_ir_op_call, type, builder->context->indices[callee->module][callee->node], list)
+		: emit(builder, primec_ir_op_call_indirect, type, target, list);
+
+	return is_sret ? result : value;
+}
+
+static bool is_temporary(
+	const builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_sema_node_s* const info = get_info(builder, node);
+
+	if (primec_sema_coercion_array_to_slice == info->coercion)
+	{
+		return true;
+	}
+
+	if (info->coercion != primec_sema_coercion_none)
+	{
+		return false;
+	}
+
+	return primec_ast_kind_call == expression->kind || primec_ast_kind_string_literal == expression->kind ||
+		(primec_ast_kind_address_of == expression->kind &&
+		primec_ast_kind_slice == primec_ast_get_node(builder->ast, expression->lhs)->kind);
+}
+
+static primec_ir_value_t promote_variadic(
+	builder_s* const builder,
+	const primec_ir_value_t value,
+	const primec_type_t type)
+{
+	// NOTE: The variadic arguments follow the promotions of c, so they can be
+	//       passed to the external functions.
+	switch (get_kind(builder, type))
+	{
+		case primec_type_kind_f32:
+		{
+			return emit_convert(builder, primec_type_f64, value);
+		} break;
+
+		case primec_type_kind_bool:
+		case primec_type_kind_i8:
+		case primec_type_kind_i16:
+		case primec_type_kind_u8:
+		case primec_type_kind_u16:
+		case primec_type_kind_c8:
+		{
+			return emit_convert(builder, primec_type_i32, value);
+		} break;
+
+		case primec_type_kind_enum:
+		{
+			return promote_variadic(builder, emit_convert(builder, get_element(builder, type), value), get_element(builder, type));
+		} break;
+
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		{
+			if (!is_aggregate(builder, type)) { return value; }
+			return slice_pointer(builder, pointer_to(builder, get_element(builder, get_element(builder, type))), value);
+		} break;
+
+		default:
+		{
+			return value;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_index(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_type_t element = get_info(builder, node)->type;
+	primec_ir_value_t pointer = primec_ir_null;
+	primec_ir_value_t count = primec_ir_null;
+
+	lower_sequence(builder, expression->lhs, &pointer, &count);
+	primec_ir_value_t index = lower_value(builder, expression->rhs);
+
+	// NOTE: Plain pointers are indexed without the bounds checks.
+	if (count != primec_ir_null)
+	{
+		index = emit_check(builder, index, count);
+	}
+
+	return emit(builder, primec_ir_op_element, pointer_to(builder, element), pointer, index);
+}
+
+static void lower_sequence(
+	builder_s* const builder,
+	const primec_ast_index_t node,
+	primec_ir_value_t* const pointer,
+	primec_ir_value_t* const count)
+{
+	const primec_type_t type = get_info(builder, node)->type;
+	primec_type_t sequence = type;
+
+	if (primec_type_kind_reference == get_kind(builder, type) || primec_type_kind_pointer == get_kind(builder, type))
+	{
+		sequence = get_element(builder, type);
+	}
+
+	const primec_ir_value_t base = lower_expression(builder, node);
+
+	switch (get_kind(builder, sequence))
+	{
+		case primec_type_kind_array:
+		{
+			*pointer = base;
+			*count = emit_const(builder, primec_type_u64, primec_type_table_get(builder->types, sequence)->count);
+		} break;
+
+		case primec_type_kind_slice:
+		{
+			*pointer = slice_pointer(builder, pointer_to(builder, get_element(builder, sequence)), base);
+			*count = slice_count(builder, base);
+		} break;
+
+		default:
+		{
+			*pointer = base;
+			*count = primec_ir_null;
+		} break;
+	}
+}
+
+static primec_ir_value_t lower_slice(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_ast_slice_s record = primec_ast_get_slice(builder->ast, expression->rhs);
+	primec_ir_value_t pointer = primec_ir_null;
+	primec_ir_value_t count = primec_ir_null;
+
+	lower_sequence(builder, expression->lhs, &pointer, &count);
+
+	primec_ir_value_t start = record.start != primec_ast_null
+		? emit_convert(builder, primec_type_u64, lower_value(builder, record.start))
+		: emit_const(builder, primec_type_u64, 0);
+
+	// NOTE: Slices of plain pointers without the end are empty.
+	primec_ir_value_t end = start;
+	if (record.end != primec_ast_null) { end = emit_convert(builder, primec_type_u64, lower_value(builder, record.end)); }
+	else if (count != primec_ir_null) { end = count; }
+
+	if (count != primec_ir_null)
+	{
+		const primec_ir_value_t one = emit_const(builder, primec_type_u64, 1);
+		end = emit_check(builder, end, emit(builder, primec_ir_op_add, primec_type_u64, count, one));
+		start = emit_check(builder, start, emit(builder, primec_ir_op_add, primec_type_u64, end, one));
+	}
+
+	const primec_type_t element = get_element(builder, get_info(builder, node)->type);
+	pointer = emit(builder, primec_ir_op_element, pointer_to(builder, element), pointer, start);
+	return make_slice(builder, get_info(builder, node)->type, pointer, emit(builder, primec_ir_op_sub, primec_type_u64, end, start));
+}
+
+static primec_ir_value_t lower_member(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_sema_node_s* const info = get_info(builder, node);
+
+	if (primec_sema_member_count == info->node)
+	{
+		primec_ir_value_t pointer = primec_ir_null;
+		primec_ir_value_t count = primec_ir_null;
+		lower_sequence(builder, expression->lhs, &pointer, &count);
+		return count;
+	}
+
+	// NOTE: The address of a struct and the references to it are the same.
+	const primec_ir_value_t base = lower_expression(builder, expression->lhs);
+	return emit(builder, primec_ir_op_field, pointer_to(builder, info->type), base, info->node);
+}
+
+static primec_ir_value_t lower_lambda(
+	builder_s* const builder,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(builder->ast, node);
+	const primec_type_t type = get_info(builder, node)->type;
+	uint32_t flags = primec_ir_func_flag_lambda;
+
+	if (is_aggregate(builder, get_element(builder, type)))
+	{
+		flags |= primec_ir_func_flag_sret;
+	}
+
+	// NOTE: Lambdas do not capture, so they are hoisted into plain functions.
+	const char* const name = primec_ir_program_add_name(builder->context->program, "%s.lambda%u",
+		builder->func->name, (*builder->lambdas)++
+	);
+
+	const uint32_t index = primec_ir_program_add_func(builder->context->program, name, type, flags);
+	primec_ir_func_s* const func = primec_ir_program_get_func(builder->context->program, index);
+	func->module = builder->module;
+	func->node = node;
+
+	builder_s lambda = builder_from_parts(builder->context, builder->module, func, builder->lambdas);
+	build_function(&lambda, expression->lhs, expression->rhs);
+	builder_destroy(&lambda);
+
+	return emit(builder, primec_ir_op_func, type, index, 0);
+}
+
+static primec_ir_op_e get_operator(
+	const primec_token_type_e operator)
+{
+	switch (operator)
+	{
+		case primec_token_type_add:                   { return primec_ir_op_add; } break;
+		case primec_token_type_subtract:              { return primec_ir_op_sub; } break;
+		case primec_token_type_multiply:              { return primec_ir_op_mul; } break;
+		case primec_token_type_divide:                { return primec_ir_op_div; } break;
+		case primec_token_type_modulus:               { return primec_ir_op_rem; } break;
+		case primec_token_type_band:                  { return primec_ir_op_and; } break;
+		case primec_token_type_bor:                   { return primec_ir_op_or; } break;
+		case primec_token_type_bxor:                  { return primec_ir_op_xor; } break;
+		case primec_token_type_lshift:                { return primec_ir_op_shl; } break;
+		case primec_token_type_rshift:                { return primec_ir_op_shr; } break;
+		case primec_token_type_equal:                 { return primec_ir_op_eq; } break;
+		case primec_token_type_not_equal:             { return primec_ir_op_ne; } break;
+		case primec_token_type_less_than:             { return primec_ir_op_lt; } break;
+		case primec_token_type_less_than_or_equal:    { return primec_ir_op_le; } break;
+		case primec_token_type_greater_than:          { return primec_ir_op_gt; } break;
+		case primec_token_type_greater_than_or_equal: { return primec_ir_op_ge; } break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unexpected operator `%s` in the ir builder.", primec_token_type_to_string(operator));
+			return primec_ir_op_nop;
+		} break;
+	}
+}
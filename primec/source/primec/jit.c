@@ -0,0 +1,360 @@
+
+/**
+ * @file jit.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/jit.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/layout.h>
+#include <primec/string_pool.h>
+
+#include <stddef.h>
+
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define func_alignment 16
+#define stub_size 16
+
+typedef int32_t (*entry_f)(void);
+
+typedef struct
+{
+	const primec_x86_64_module_s* module;
+	uint8_t* memory;
+	uint64_t size;
+
+	// NOTE: Offsets in the mapped memory. The external functions are placed at
+	//       their stubs.
+	uint64_t* func_offsets;
+	uint64_t* global_offsets;
+	void** natives;
+	primec_string_pool_s strings;
+
+	uint64_t text_size;
+	uint64_t rodata_offset;
+	uint64_t rodata_size;
+	uint64_t data_offset;
+	uint64_t data_size;
+} image_s;
+
+static bool resolve_natives(
+	image_s* const image);
+
+static void layout(
+	image_s* const image);
+
+static void write_text(
+	image_s* const image);
+
+static void write_rodata(
+	image_s* const image);
+
+static void write_data(
+	image_s* const image);
+
+static void write_le(
+	uint8_t* const bytes,
+	const uint64_t value,
+	const uint32_t size);
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment);
+
+bool primec_jit_run(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(status != NULL);
+	const primec_ir_program_s* const program = module->program;
+	primec_debug_assert(entry < program->funcs.count);
+
+	const uint32_t funcs_count = program->funcs.count > 0 ? program->funcs.count : 1;
+	const uint32_t globals_count = program->globals.count > 0 ? program->globals.count : 1;
+
+	image_s image = {0};
+	image.module = module;
+	image.func_offsets = primec_utils_malloc(funcs_count * sizeof(uint64_t));
+	image.global_offsets = primec_utils_malloc(globals_count * sizeof(uint64_t));
+	image.strings = primec_string_pool_from_program(program);
+	image.natives = primec_utils_malloc(funcs_count * sizeof(void*));
+	primec_utils_memset(image.natives, 0, funcs_count * sizeof(void*));
+
+	bool is_called = false;
+
+	if (!resolve_natives(&image))
+	{
+		goto cleanup;
+	}
+
+	layout(&image);
+
+	void* const memory = mmap(NULL, image.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (MAP_FAILED == memory)
+	{
+		primec_logger_error("failed to map %lu bytes of the memory for the code.", image.size);
+		goto cleanup;
+	}
+
+	image.memory = memory;
+	write_rodata(&image);
+	write_data(&image);
+	write_text(&image);
+
+	// NOTE: The code and the strings are sealed before anything is called, and
+	//       the data (with the bss) stays writable only.
+	if (mprotect(image.memory, image.text_size, PROT_READ | PROT_EXEC) != 0 ||
+		(image.rodata_size > 0 && mprotect(image.memory + image.rodata_offset, image.rodata_size, PROT_READ) != 0))
+	{
+		primec_logger_error("failed to protect the memory of the code.");
+		(void)munmap(image.memory, image.size);
+		goto cleanup;
+	}
+
+	const primec_ir_func_s* const entry_func = program->funcs.data[entry];
+	const bool returns_value = primec_type_table_get(program->types, entry_func->type)->element != primec_type_void;
+	void* const address = image.memory + image.func_offsets[entry];
+	entry_f function = NULL;
+	primec_utils_memcpy(&function, &address, sizeof(function));
+
+	const int32_t result = function();
+	*status = returns_value ? result : 0;
+	is_called = true;
+
+	// NOTE: The output buffered by the runtime is written out, as the _start of
+	//       the executables does, before the image is unmapped.
+	if (program->flush != UINT32_MAX)
+	{
+		void* const flush_address = image.memory + image.func_offsets[program->flush];
+		entry_f flush = NULL;
+		primec_utils_memcpy(&flush, &flush_address, sizeof(flush));
+		(void)flush();
+	}
+
+	(void)munmap(image.memory, image.size);
+
+cleanup:
+	primec_utils_free(image.func_offsets);
+	primec_utils_free(image.global_offsets);
+	primec_string_pool_destroy(&image.strings);
+	primec_utils_free(image.natives);
+	return is_called;
+}
+
+static bool resolve_natives(
+	image_s* const image)
+{
+	const primec_ir_program_s* const program = image->module->program;
+	void* const process = dlopen(NULL, RTLD_NOW);
+	bool is_resolved = true;
+
+	if (NULL == process)
+	{
+		primec_logger_error("failed to open the current process -- %s.", dlerror());
+		return false;
+	}
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (!(func->flags & primec_ir_func_flag_extern)) { continue; }
+
+		image->natives[index] = dlsym(process, func->name);
+
+		if (NULL == image->natives[index])
+		{
+			primec_logger_error("external function `%s` was not found in the process.", func->name);
+			is_resolved = false;
+		}
+	}
+
+	(void)dlclose(process);
+	return is_resolved;
+}
+
+static void layout(
+	image_s* const image)
+{
+	const primec_x86_64_module_s* const module = image->module;
+	const primec_ir_program_s* const program = module->program;
+	const uint64_t page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+	uint64_t offset = 0;
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+		offset = align_up(offset, func_alignment);
+		image->func_offsets[index] = offset;
+		offset += module->funcs[index].bytes.count;
+	}
+
+	// NOTE: The external functions may be further than the 32 bit displacements
+	//       of the calls reach, so they are called through the stubs.
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		if (!(program->funcs.data[index]->flags & primec_ir_func_flag_extern)) { continue; }
+		offset = align_up(offset, stub_size);
+		image->func_offsets[index] = offset;
+		offset += stub_size;
+	}
+
+	image->text_size = align_up(offset > 0 ? offset : 1, page_size);
+	image->rodata_offset = image->text_size;
+	image->rodata_size = align_up(image->strings.size, page_size);
+	image->data_offset = image->rodata_offset + image->rodata_size;
+	offset = 0;
+
+	// NOTE: The mapping is cleared, so the globals without initializers take
+	//       their space only.
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_layout_s global_layout = primec_layout_get(program->types, program->globals.data[index].type);
+		offset = align_up(offset, global_layout.alignment > 0 ? global_layout.alignment : 1);
+		image->global_offsets[index] = image->data_offset + offset;
+		offset += global_layout.size > 0 ? global_layout.size : 1;
+	}
+
+	image->data_size = align_up(offset, page_size);
+	image->size = image->data_offset + image->data_size;
+}
+
+static void write_text(
+	image_s* const image)
+{
+	const primec_x86_64_module_s* const module = image->module;
+	const primec_ir_program_s* const program = module->program;
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		uint8_t* const code = image->memory + image->func_offsets[index];
+
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern)
+		{
+			// NOTE: jmp [rip + 0]; followed by the absolute address.
+			static const uint8_t jump[] = { 0xff, 0x25, 0x00, 0x00, 0x00, 0x00 };
+			primec_utils_memcpy(code, jump, sizeof(jump));
+			write_le(code + sizeof(jump), (uint64_t)(uintptr_t)image->natives[index], 8);
+			continue;
+		}
+
+		const primec_x86_64_func_s* const func = &module->funcs[index];
+		primec_utils_memcpy(code, func->bytes.data, func->bytes.count);
+
+		for (uint32_t relocation = 0; relocation < func->relocations.count; ++relocation)
+		{
+			const primec_x86_64_relocation_s* const record = &func->relocations.data[relocation];
+			uint64_t target = 0;
+
+			switch (record->symbol_kind)
+			{
+				case primec_x86_64_symbol_func:
+				{
+					target = image->func_offsets[record->symbol];
+				} break;
+
+				case primec_x86_64_symbol_global:
+				{
+					target = image->global_offsets[record->symbol];
+				} break;
+
+				case primec_x86_64_symbol_string:
+				{
+					target = image->rodata_offset + image->strings.offsets[record->symbol];
+				} break;
+
+				default:
+				{
+					primec_logger_panic("internal failure -- unknown symbol kind %u.", record->symbol_kind);
+				} break;
+			}
+
+			uint8_t* const place = code + record->offset;
+			const uint64_t value = (uint64_t)(uintptr_t)image->memory + target + (uint64_t)record->addend;
+
+			if (primec_x86_64_relocation_64 == record->type)
+			{
+				write_le(place, value, 8);
+				continue;
+			}
+
+			const int64_t displacement = (int64_t)(value - (uint64_t)(uintptr_t)place);
+			primec_debug_assert(displacement >= INT32_MIN && displacement <= INT32_MAX);
+			write_le(place, (uint64_t)displacement, 4);
+		}
+	}
+}
+
+static void write_rodata(
+	image_s* const image)
+{
+	if (image->strings.size > 0)
+	{
+		primec_utils_memcpy(image->memory + image->rodata_offset, image->strings.data, image->strings.size);
+	}
+}
+
+static void write_data(
+	image_s* const image)
+{
+	const primec_ir_program_s* const program = image->module->program;
+	const primec_type_table_s* const types = program->types;
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_ir_global_s* const global = &program->globals.data[index];
+		const uint64_t size = primec_layout_get(types, global->type).size;
+		uint8_t* const target = image->memory + image->global_offsets[index];
+
+		if (primec_ir_global_init_const == global->init)
+		{
+			uint64_t bits = global->value.uval;
+
+			if (primec_type_is_float(types, global->type) && 4 == size)
+			{
+				const float narrow = (float)global->value.fval;
+				uint32_t narrow_bits = 0;
+				primec_utils_memcpy(&narrow_bits, &narrow, sizeof(narrow_bits));
+				bits = narrow_bits;
+			}
+
+			write_le(target, bits, size < 8 ? (uint32_t)size : 8);
+		}
+		else if (primec_ir_global_init_string == global->init)
+		{
+			// NOTE: Strings are pointers to their characters, followed by their
+			//       lengths when they are slices.
+			write_le(target, (uint64_t)(uintptr_t)image->memory + image->rodata_offset + image->strings.offsets[global->string], 8);
+			if (size > 8) { write_le(target + 8, program->strings.data[global->string].length, 8); }
+		}
+	}
+}
+
+static void write_le(
+	uint8_t* const bytes,
+	const uint64_t value,
+	const uint32_t size)
+{
+	for (uint32_t byte = 0; byte < size; ++byte) { bytes[byte] = (uint8_t)(value >> (8 * byte)); }
+}
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
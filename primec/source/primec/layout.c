@@ -0,0 +1,286 @@
+
+/**
+ * @file layout.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/layout.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+static primec_layout_s layout_struct(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const bool is_reordered,
+	const uint32_t target,
+	uint64_t* const offset);
+
+static void keep_declared(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	bool* const is_kept);
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment);
+
+primec_layout_s primec_layout_get(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	primec_debug_assert(types != NULL);
+	const primec_type_s* const record = primec_type_table_get(types, type);
+
+	switch (record->kind)
+	{
+		case primec_type_kind_void:
+		{
+			return (primec_layout_s) { .size = 0, .alignment = 1 };
+		} break;
+
+		case primec_type_kind_bool:
+		case primec_type_kind_i8:
+		case primec_type_kind_u8:
+		case primec_type_kind_c8:
+		{
+			return (primec_layout_s) { .size = 1, .alignment = 1 };
+		} break;
+
+		case primec_type_kind_i16:
+		case primec_type_kind_u16:
+		{
+			return (primec_layout_s) { .size = 2, .alignment = 2 };
+		} break;
+
+		case primec_type_kind_i32:
+		case primec_type_kind_u32:
+		case primec_type_kind_f32:
+		{
+			return (primec_layout_s) { .size = 4, .alignment = 4 };
+		} break;
+
+		case primec_type_kind_i64:
+		case primec_type_kind_u64:
+		case primec_type_kind_f64:
+		case primec_type_kind_untyped_int:
+		case primec_type_kind_untyped_float:
+		case primec_type_kind_error:
+		case primec_type_kind_func:
+		{
+			return (primec_layout_s) { .size = 8, .alignment = 8 };
+		} break;
+
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		{
+			const bool is_pair = primec_type_kind_slice == primec_type_table_get(types, record->element)->kind;
+			return (primec_layout_s) { .size = is_pair ? 16 : 8, .alignment = 8 };
+		} break;
+
+		case primec_type_kind_slice:
+		{
+			return (primec_layout_s) { .size = 16, .alignment = 8 };
+		} break;
+
+		case primec_type_kind_array:
+		{
+			const primec_layout_s element = primec_layout_get(types, record->element);
+			return (primec_layout_s) { .size = element.size * record->count, .alignment = element.alignment };
+		} break;
+
+		case primec_type_kind_struct:
+		{
+			return layout_struct(types, type, record->flags & primec_type_flag_reordered, UINT32_MAX, NULL);
+		} break;
+
+		case primec_type_kind_enum:
+		{
+			return primec_layout_get(types, record->element);
+		} break;
+
+		case primec_type_kind_vector:
+		{
+			const primec_layout_s element = primec_layout_get(types, record->element);
+			return (primec_layout_s) { .size = element.size * record->count, .alignment = 16 };
+		} break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unknown type kind.");
+			return (primec_layout_s) { .size = 0, .alignment = 1 };
+		} break;
+	}
+}
+
+uint64_t primec_layout_get_field_offset(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint32_t index)
+{
+	primec_debug_assert(types != NULL);
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	primec_debug_assert(primec_type_kind_struct == record->kind);
+	primec_debug_assert(index < record->list.count);
+
+	uint64_t offset = 0;
+	(void)layout_struct(types, type, record->flags & primec_type_flag_reordered, index, &offset);
+	return offset;
+}
+
+void primec_layout_reorder_structs(
+	primec_type_table_s* const types,
+	const primec_ir_program_s* const program)
+{
+	primec_debug_assert(types != NULL);
+	primec_debug_assert(program != NULL);
+	const uint32_t types_count = types->types.count;
+	bool* const is_kept = primec_utils_malloc(types_count * sizeof(bool));
+	primec_utils_memset(is_kept, 0, types_count * sizeof(bool));
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (func->flags & primec_ir_func_flag_extern) { keep_declared(types, func->type, is_kept); }
+	}
+
+	for (primec_type_t type = primec_type_primitives_count; type < types_count; ++type)
+	{
+		const primec_type_s* const record = primec_type_table_get(types, type);
+		if (primec_type_kind_struct != record->kind || is_kept[type]) { continue; }
+		primec_type_table_set_reordered(types, type);
+	}
+
+	primec_utils_free(is_kept);
+}
+
+void primec_layout_report(
+	const primec_type_table_s* const types)
+{
+	primec_debug_assert(types != NULL);
+	uint64_t total = 0;
+
+	for (primec_type_t type = primec_type_primitives_count; type < types->types.count; ++type)
+	{
+		const primec_type_s* const record = primec_type_table_get(types, type);
+		if (primec_type_kind_struct != record->kind || !(record->flags & primec_type_flag_complete)) { continue; }
+
+		// NOTE: The padding is what is left of the size by the fields.
+		const primec_type_t* const fields = primec_type_table_get_list(types, type);
+		const primec_layout_s layout = primec_layout_get(types, type);
+		uint64_t used = 0;
+
+		for (uint32_t index = 0; index < record->list.count; ++index)
+		{
+			used += primec_layout_get(types, fields[index]).size;
+		}
+
+		total += layout.size - used;
+
+		if (record->flags & primec_type_flag_reordered)
+		{
+			primec_logger_log("struct `%s`: size %lu, alignment %lu, padding %lu bytes (fields reordered)",
+				record->name, layout.size, layout.alignment, layout.size - used);
+			continue;
+		}
+
+		const primec_layout_s reordered = layout_struct(types, type, true, UINT32_MAX, NULL);
+		primec_logger_log("struct `%s`: size %lu, alignment %lu, padding %lu bytes (%lu if the fields were reordered)",
+			record->name, layout.size, layout.alignment, layout.size - used, reordered.size - used);
+	}
+
+	primec_logger_log("structs padding: %lu bytes in total", total);
+}
+
+static primec_layout_s layout_struct(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const bool is_reordered,
+	const uint32_t target,
+	uint64_t* const offset)
+{
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	const primec_type_t* const fields = primec_type_table_get_list(types, type);
+	primec_layout_s layout = { .size = 0, .alignment = 1 };
+
+	for (uint32_t index = 0; index < record->list.count; ++index)
+	{
+		const primec_layout_s field = primec_layout_get(types, fields[index]);
+		if (field.alignment > layout.alignment) { layout.alignment = field.alignment; }
+	}
+
+	// NOTE: Reordered fields are placed from the largest alignment down (in
+	//       their declared order among the same alignments), so no padding is
+	//       left between them, as the sizes are multiples of the alignments.
+	//       Declared fields are placed in a single pass over all alignments.
+	for (uint64_t alignment = layout.alignment; alignment > 0; alignment /= 2)
+	{
+		for (uint32_t index = 0; index < record->list.count; ++index)
+		{
+			const primec_layout_s field = primec_layout_get(types, fields[index]);
+			if (is_reordered && field.alignment != alignment) { continue; }
+			layout.size = align_up(layout.size, field.alignment);
+			if (index == target) { *offset = layout.size; }
+			layout.size += field.size;
+		}
+
+		if (!is_reordered) { break; }
+	}
+
+	layout.size = align_up(layout.size, layout.alignment);
+	return layout;
+}
+
+static void keep_declared(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	bool* const is_kept)
+{
+	if (type < primec_type_primitives_count || is_kept[type]) { return; }
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	is_kept[type] = true;
+
+	switch (record->kind)
+	{
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		case primec_type_kind_array:
+		case primec_type_kind_slice:
+		{
+			keep_declared(types, record->element, is_kept);
+		} break;
+
+		case primec_type_kind_func:
+		case primec_type_kind_struct:
+		{
+			if (primec_type_kind_func == record->kind) { keep_declared(types, record->element, is_kept); }
+			const primec_type_t* const list = primec_type_table_get_list(types, type);
+
+			for (uint32_t index = 0; index < record->list.count; ++index)
+			{
+				keep_declared(types, list[index], is_kept);
+			}
+		} break;
+
+		default:
+		{
+		} break;
+	}
+}
+
+static uint64_t align_up(
+	const uint64_t value,
+	const uint64_t alignment)
+{
+	primec_debug_assert(alignment > 0);
+	return (value + alignment - 1) / alignment * alignment;
+}
@@ -12,6 +12,7 @@
 
 #include <primec/lexer.h>
 
+#include <primec/source_manager.h>
 #include <primec/debug.h>
 #include <primec/logger.h>
 #include <primec/utils.h>
@@ -28,14 +29,13 @@
 
 #define log_lexer_error_and_exit(_location, _format, ...)                      \
 	do {                                                                       \
-		(void)fprintf(stderr, "%s:%lu:%lu: ",                                  \
-			(_location).file, (_location).line, (_location).column);           \
+		(void)fprintf(stderr, primec_location_fmt ": ",                        \
+			primec_location_arg(_location));                                   \
 		primec_logger_error(_format, ## __VA_ARGS__);                          \
 		exit(-1);                                                              \
 	} while (0)
 
-static void update_location(
-	primec_location_s* const location,
+static uint32_t get_utf8char_size(
 	const utf8char_t utf8char);
 
 static void append_buffer(
@@ -107,18 +107,16 @@ static primec_token_type_e lex_up_to_3_symbol_token(
 	uint32_t utf8char);
 
 primec_lexer_s primec_lexer_from_parts(
-	const char* const file_path,
-	FILE* const file)
+	const primec_source_view_s source)
 {
-	primec_debug_assert(file_path != NULL);
-	primec_debug_assert(file != NULL);
+	primec_debug_assert(source.data != NULL);
 
 	primec_lexer_s lexer;
-	lexer.file = file;
+	primec_utils_memset((void*)&lexer, 0, sizeof(primec_lexer_s));
+	lexer.source = source;
 	lexer.token.type = primec_token_type_none;
-	lexer.location.file = file_path;
-	lexer.location.line = 1;
-	lexer.location.column = 0;
+	lexer.location.file = source.file;
+	lexer.location.offset = 0;
 
 	lexer.buffer.capacity = 256;
 	lexer.buffer.data = primec_utils_malloc(lexer.buffer.capacity * sizeof(char));
@@ -133,6 +131,7 @@ void primec_lexer_destroy(
 	primec_lexer_s* const lexer)
 {
 	primec_utils_free(lexer->buffer.data);
+	primec_token_literals_destroy(&lexer->literals);
 	primec_utils_memset((void*)lexer, 0, sizeof(primec_lexer_s));
 }
 
@@ -150,6 +149,9 @@ primec_token_type_e primec_lexer_lex(
 		return token->type;
 	}
 
+	token->flags = 0;
+	token->reserved = 0;
+	token->payload = 0;
 	utf8char_t utf8char = get_utf8char(lexer, &token->location);
 
 	if (primec_utf8_invalid == utf8char)
@@ -287,21 +289,16 @@ void primec_lexer_unlex(
 	lexer->token = *token;
 }
 
-static void update_location(
-	primec_location_s* const location,
+static uint32_t get_utf8char_size(
 	const utf8char_t utf8char)
 {
-	primec_debug_assert(location != NULL);
-
-	if ('\n' == utf8char)
-	{
-		location->line++;
-		location->column = 0;
-	}
-	else
+	if (primec_utf8_invalid == utf8char)
 	{
-		location->column++;
+		return 0;
 	}
+
+	char buffer[primec_utf8_max_size];
+	return primec_utf8_encode(buffer, utf8char);
 }
 
 static void append_buffer(
@@ -331,32 +328,37 @@ static utf8char_t next_utf8char(
 {
 	primec_debug_assert(lexer != NULL);
 	utf8char_t utf8char = primec_utf8_invalid;
+	uint32_t offset = lexer->location.offset;
 
 	if (lexer->cache[0] != primec_utf8_invalid)
 	{
+		// NOTE: The cached symbols are always the last ones read from the file,
+		//       thus the offset of the symbol is right before the offsets of the
+		//       symbols left in the cache.
 		utf8char = lexer->cache[0];
 		lexer->cache[0] = lexer->cache[1];
 		lexer->cache[1] = primec_utf8_invalid;
+		offset -= get_utf8char_size(utf8char) + get_utf8char_size(lexer->cache[0]);
 	}
-	else
+	else if (lexer->location.offset < lexer->source.length)
 	{
-		utf8char = primec_utf8_get(lexer->file);
-		update_location(&lexer->location, utf8char);
+		// NOTE: The text of the view is null terminated, thus decoding of a cut
+		//       utf-8 sequence at the end of the file never reads past it.
+		const char* cursor = lexer->source.data + lexer->location.offset;
+		utf8char = primec_utf8_decode(&cursor);
 
-		if (primec_utf8_invalid == utf8char && !feof(lexer->file))
+		if (primec_utf8_invalid == utf8char || cursor > lexer->source.data + lexer->source.length)
 		{
 			log_lexer_error_and_exit(lexer->location, "invalid utf-8 sequence encountered.");
 		}
+
+		lexer->location.offset = (uint32_t)(cursor - lexer->source.data);
 	}
 
 	if (location != NULL)
 	{
-		*location = lexer->location;
-
-		for (uint8_t index = 0; index < 2 && lexer->cache[index] != primec_utf8_invalid; ++index)
-		{
-			update_location(&lexer->location, lexer->cache[index]);
-		}
+		location->file = lexer->location.file;
+		location->offset = offset;
 	}
 
 	if (primec_utf8_invalid == utf8char || !buffer)
@@ -469,9 +471,12 @@ static primec_token_type_e lex_identifier_or_keyword(
 		}
 	}
 
-	token->type = primec_token_type_from_string(lexer->buffer.data);
-	token->ident.data = primec_utils_strndup(lexer->buffer.data, lexer->buffer.length);
-	token->ident.length = lexer->buffer.length;
+	token->type = (uint8_t)primec_token_type_from_string(lexer->buffer.data);
+
+	if (primec_token_type_identifier == token->type)
+	{
+		token->payload = primec_token_literals_push_text(&lexer->literals, lexer->buffer.data, lexer->buffer.length);
+	}
 
 	clear_buffer(lexer);
 	return token->type;
@@ -713,7 +718,7 @@ want_int:
 		{
 			if (!primec_utils_strcmp(literals[index].suffix, lexer->buffer.data + suffix_start))
 			{
-				token->type = literals[index].type;
+				token->type = (uint8_t)literals[index].type;
 				kind = literals[index].kind;
 				break;
 			}
@@ -732,13 +737,16 @@ want_int:
 		if (kind_unknown == kind)
 		{
 			token->type = primec_token_type_literal_f64;
+			token->flags |= primec_token_flag_untyped;
 		}
 		else if (kind != kind_float)
 		{
 			log_lexer_error_and_exit(token->location, "unexpected decimal point in integer literal");
 		}
 
-		token->fval = strtod(lexer->buffer.data, NULL);
+		primec_token_value_s value;
+		value.fval = strtod(lexer->buffer.data, NULL);
+		token->payload = primec_token_literals_push_value(&lexer->literals, value);
 		clear_buffer(lexer);
 		return true;
 	}
@@ -747,6 +755,7 @@ want_int:
 	{
 		kind = kind_iconst;
 		token->type = primec_token_type_literal_i64;
+		token->flags |= primec_token_flag_untyped;
 	}
 
 	uint64_t exponent = 0;
@@ -757,27 +766,29 @@ want_int:
 		exponent = strtoumax(lexer->buffer.data + exponent_start + 1, NULL, 10);
 	}
 
-	token->uval = strtoumax(lexer->buffer.data + (10 == base ? 0 : 2), NULL, base);
-	token->uval = compute_exponent(token->uval, exponent, kind_signed == kind);
+	primec_token_value_s value;
+	value.uval = strtoumax(lexer->buffer.data + (10 == base ? 0 : 2), NULL, base);
+	value.uval = compute_exponent(value.uval, exponent, kind_signed == kind);
 
 	if (ERANGE == errno)
 	{
 		log_lexer_error_and_exit(token->location, "numeric literal overflow.");
 	}
 
-	if (kind_iconst == kind && token->uval > (uint64_t)INT64_MAX)
+	if (kind_iconst == kind && value.uval > (uint64_t)INT64_MAX)
 	{
 		token->type = primec_token_type_literal_u64;
 	}
-	else if (kind_signed == kind && token->uval == (uint64_t)INT64_MIN)
+	else if (kind_signed == kind && value.uval == (uint64_t)INT64_MIN)
 	{
-		token->ival = INT64_MIN;
+		value.ival = INT64_MIN;
 	}
 	else if (kind != kind_unsigned)
 	{
-		token->ival = (int64_t)token->uval;
+		value.ival = (int64_t)value.uval;
 	}
 
+	token->payload = primec_token_literals_push_value(&lexer->literals, value);
 	clear_buffer(lexer);
 	return true;
 }
@@ -965,6 +976,7 @@ static primec_token_type_e lex_rune_literal_token(
 	{
 		case '\'':
 		{
+			primec_token_value_s value;
 			utf8char = next_utf8char(lexer, NULL, false);
 
 			switch (utf8char)
@@ -984,9 +996,9 @@ static primec_token_type_e lex_rune_literal_token(
 					buffer[size] = '\0';
 
 					const char* rune = buffer;
-					token->rune = primec_utf8_decode(&rune);
+					value.rune = primec_utf8_decode(&rune);
 
-					if (primec_utf8_invalid == token->rune)
+					if (primec_utf8_invalid == value.rune)
 					{
 						log_lexer_error_and_exit(location, "invalid utf-8 in rune literal.");
 					}
@@ -994,7 +1006,7 @@ static primec_token_type_e lex_rune_literal_token(
 
 				default:
 				{
-					token->rune = utf8char;
+					value.rune = utf8char;
 				} break;
 			}
 
@@ -1004,6 +1016,7 @@ static primec_token_type_e lex_rune_literal_token(
 			}
 
 			token->type = primec_token_type_literal_rune;
+			token->payload = primec_token_literals_push_value(&lexer->literals, value);
 			return token->type;
 		} break;
 
@@ -1062,12 +1075,8 @@ static primec_token_type_e lex_string_literal_token(
 				}
 			}
 
-			char* const string = primec_utils_malloc((lexer->buffer.length + 1) * sizeof(char));
-			primec_utils_memcpy(string, lexer->buffer.data, lexer->buffer.length);
-
 			token->type = primec_token_type_literal_str;
-			token->str.data = string;
-			token->str.length = lexer->buffer.length;
+			token->payload = primec_token_literals_push_text(&lexer->literals, lexer->buffer.data, lexer->buffer.length);
 
 			clear_buffer(lexer);
 			return token->type;
@@ -1150,9 +1159,10 @@ static primec_token_type_e lex_up_to_2_symbol_token(
 					token->type = primec_token_type_single_line_comment;
 					while ((utf8char = next_utf8char(lexer, NULL, true)) != primec_utf8_invalid && utf8char != '\n');
 
-					// NOTE: subtracting one from the length of the buffer to ignore the end of line symbol '\n':
-					token->comment.data = primec_utils_strndup(lexer->buffer.data, lexer->buffer.length - 1);
-					token->comment.length = lexer->buffer.length - 1;
+					// NOTE: subtracting one from the length of the buffer to ignore the end of line symbol '\n'
+					//       (unless the comment ends with the end of file):
+					token->payload = primec_token_literals_push_text(&lexer->literals, lexer->buffer.data,
+						lexer->buffer.length - ('\n' == utf8char ? 1 : 0));
 					clear_buffer(lexer);
 				} break;
 
@@ -1171,9 +1181,9 @@ static primec_token_type_e lex_up_to_2_symbol_token(
 					}
 
 					// NOTE: subtracting two from the length of the buffer to ignore the end of multi line comment
-					//       symbols "*/":
-					token->comment.data = primec_utils_strndup(lexer->buffer.data, lexer->buffer.length - 2);
-					token->comment.length = lexer->buffer.length - 2;
+					//       symbols "*/" (unless the comment ends with the end of file):
+					token->payload = primec_token_literals_push_text(&lexer->literals, lexer->buffer.data,
+						lexer->buffer.length - (primec_utf8_invalid == utf8char ? 0 : 2));
 					clear_buffer(lexer);
 				} break;
 
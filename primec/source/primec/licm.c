@@ -0,0 +1,363 @@
+
+/**
+ * @file licm.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/licm.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+
+#include <stddef.h>
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	const primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_cfg_s cfg;
+
+	primec_ir_block_t* blocks;		// block of every value
+	uint32_t* loops;				// number of the last processed loop, that contains the block, or 0
+	bool* is_hoisted;
+	list_s worklist;
+	list_s hoisted;
+
+	uint32_t loop;					// number of the processed loop
+	uint32_t first;					// positions of its blocks in the order
+	uint32_t last;
+	bool is_invariant;
+} hoister_s;
+
+static void hoist_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static void hoist_loop(
+	hoister_s* const hoister,
+	const primec_ir_block_t header);
+
+static bool collect_body(
+	hoister_s* const hoister,
+	const primec_ir_block_t header);
+
+static primec_ir_block_t find_preheader(
+	const hoister_s* const hoister,
+	const primec_ir_block_t header);
+
+static bool is_writing(
+	const hoister_s* const hoister);
+
+static bool can_hoist(
+	hoister_s* const hoister,
+	const primec_ir_value_t value,
+	const bool is_header,
+	const bool is_memory_invariant);
+
+static void check_invariant(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void move_hoisted(
+	hoister_s* const hoister,
+	const primec_ir_block_t preheader);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_licm_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		hoist_func(program->types, func);
+	}
+}
+
+static void hoist_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	hoister_s hoister = { .types = types, .func = func };
+	primec_cfg_build(&hoister.cfg, func);
+	const primec_cfg_s* const cfg = &hoister.cfg;
+
+	// NOTE: Headers dominate their loops, so the inner headers come later in
+	//       the order, and the loops are processed from the last header back.
+	list_s headers = {0};
+
+	for (uint32_t position = cfg->order_count; position > 0; --position)
+	{
+		const primec_ir_block_t block = cfg->order[position - 1];
+
+		for (uint32_t index = cfg->predecessors_starts[block]; index < cfg->predecessors_starts[block + 1]; ++index)
+		{
+			const primec_ir_block_t predecessor = cfg->predecessors[index];
+			if (!primec_cfg_is_reachable(cfg, predecessor) || !primec_cfg_dominates(cfg, block, predecessor)) { continue; }
+			push(&headers, block);
+			break;
+		}
+	}
+
+	if (headers.count > 0)
+	{
+		const uint32_t values_count = func->instructions.count;
+		hoister.blocks = primec_utils_malloc(values_count * sizeof(primec_ir_block_t));
+		hoister.loops = primec_utils_malloc(cfg->blocks_count * sizeof(uint32_t));
+		hoister.is_hoisted = primec_utils_malloc(values_count * sizeof(bool));
+		primec_utils_memset(hoister.loops, 0, cfg->blocks_count * sizeof(uint32_t));
+		primec_utils_memset(hoister.is_hoisted, 0, values_count * sizeof(bool));
+
+		for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+		{
+			const primec_ir_block_s* const record = &func->blocks.data[block];
+			for (uint32_t index = 0; index < record->instructions.count; ++index) { hoister.blocks[record->instructions.data[index]] = block; }
+		}
+
+		for (uint32_t index = 0; index < headers.count; ++index)
+		{
+			hoister.loop = index + 1;
+			hoist_loop(&hoister, headers.data[index]);
+		}
+
+		primec_utils_free(hoister.blocks);
+		primec_utils_free(hoister.loops);
+		primec_utils_free(hoister.is_hoisted);
+	}
+
+	primec_utils_free(headers.data);
+	primec_utils_free(hoister.worklist.data);
+	primec_utils_free(hoister.hoisted.data);
+	primec_cfg_destroy(&hoister.cfg);
+}
+
+static void hoist_loop(
+	hoister_s* const hoister,
+	const primec_ir_block_t header)
+{
+	if (!collect_body(hoister, header)) { return; }
+
+	const primec_ir_block_t preheader = find_preheader(hoister, header);
+	if (primec_cfg_unreachable == preheader) { return; }
+
+	const primec_cfg_s* const cfg = &hoister->cfg;
+	const primec_ir_func_s* const func = hoister->func;
+	const bool is_memory_invariant = !is_writing(hoister);
+	hoister->hoisted.count = 0;
+
+	// NOTE: The blocks are walked in the order, so the dominating invariants
+	//       are hoisted before their users are checked.
+	for (uint32_t position = hoister->first; position <= hoister->last; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		if (hoister->loops[block] != hoister->loop) { continue; }
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (!can_hoist(hoister, value, block == header, is_memory_invariant)) { continue; }
+			hoister->is_hoisted[value] = true;
+			hoister->blocks[value] = preheader;
+			push(&hoister->hoisted, value);
+		}
+	}
+
+	if (hoister->hoisted.count > 0) { move_hoisted(hoister, preheader); }
+}
+
+static bool collect_body(
+	hoister_s* const hoister,
+	const primec_ir_block_t header)
+{
+	const primec_cfg_s* const cfg = &hoister->cfg;
+	hoister->loops[header] = hoister->loop;
+	hoister->first = cfg->positions[header];
+	hoister->last = cfg->positions[header];
+	hoister->worklist.count = 0;
+
+	for (uint32_t index = cfg->predecessors_starts[header]; index < cfg->predecessors_starts[header + 1]; ++index)
+	{
+		const primec_ir_block_t predecessor = cfg->predecessors[index];
+		if (!primec_cfg_is_reachable(cfg, predecessor) || !primec_cfg_dominates(cfg, header, predecessor)) { continue; }
+		if (hoister->loops[predecessor] == hoister->loop) { continue; }
+		hoister->loops[predecessor] = hoister->loop;
+		push(&hoister->worklist, predecessor);
+	}
+
+	// NOTE: The body is found backwards from the latches, and the loops, that
+	//       are entered past their headers, are left as they are.
+	while (hoister->worklist.count > 0)
+	{
+		const primec_ir_block_t block = hoister->worklist.data[--hoister->worklist.count];
+		if (cfg->positions[block] > hoister->last) { hoister->last = cfg->positions[block]; }
+
+		for (uint32_t index = cfg->predecessors_starts[block]; index < cfg->predecessors_starts[block + 1]; ++index)
+		{
+			const primec_ir_block_t predecessor = cfg->predecessors[index];
+			if (!primec_cfg_is_reachable(cfg, predecessor) || hoister->loops[predecessor] == hoister->loop) { continue; }
+			if (!primec_cfg_dominates(cfg, header, predecessor)) { return false; }
+			hoister->loops[predecessor] = hoister->loop;
+			push(&hoister->worklist, predecessor);
+		}
+	}
+
+	return true;
+}
+
+static primec_ir_block_t find_preheader(
+	const hoister_s* const hoister,
+	const primec_ir_block_t header)
+{
+	const primec_cfg_s* const cfg = &hoister->cfg;
+	primec_ir_block_t preheader = primec_cfg_unreachable;
+
+	for (uint32_t index = cfg->predecessors_starts[header]; index < cfg->predecessors_starts[header + 1]; ++index)
+	{
+		const primec_ir_block_t predecessor = cfg->predecessors[index];
+		if (!primec_cfg_is_reachable(cfg, predecessor) || hoister->loops[predecessor] == hoister->loop) { continue; }
+		if (preheader != primec_cfg_unreachable) { return primec_cfg_unreachable; }
+		preheader = predecessor;
+	}
+
+	// NOTE: The hoisted instructions run on every path into the loop, so the
+	//       preheader must lead nowhere else.
+	if (primec_cfg_unreachable == preheader) { return primec_cfg_unreachable; }
+	const primec_ir_block_s* const record = &hoister->func->blocks.data[preheader];
+	const primec_ir_value_t terminator = record->instructions.data[record->instructions.count - 1];
+	return primec_ir_op_jump == primec_ir_func_get(hoister->func, terminator)->op ? preheader : primec_cfg_unreachable;
+}
+
+static bool is_writing(
+	const hoister_s* const hoister)
+{
+	const primec_cfg_s* const cfg = &hoister->cfg;
+	const primec_ir_func_s* const func = hoister->func;
+
+	for (uint32_t position = hoister->first; position <= hoister->last; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		if (hoister->loops[block] != hoister->loop) { continue; }
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			switch ((primec_ir_op_e)primec_ir_func_get(func, record->instructions.data[index])->op)
+			{
+				case primec_ir_op_store:
+				case primec_ir_op_copy:
+				case primec_ir_op_zero:
+				case primec_ir_op_call:
+				case primec_ir_op_call_indirect:
+				{
+					return true;
+				} break;
+
+				default:
+				{
+				} break;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool can_hoist(
+	hoister_s* const hoister,
+	const primec_ir_value_t value,
+	const bool is_header,
+	const bool is_memory_invariant)
+{
+	// NOTE: The header runs whenever the loop is entered, so its loads can be
+	//       hoisted, as long as nothing in the loop writes to the memory.
+	const bool is_load = primec_ir_op_load == primec_ir_func_get(hoister->func, value)->op;
+	if (is_load ? !(is_header && is_memory_invariant) : !primec_ir_is_pure(hoister->types, hoister->func, value)) { return false; }
+
+	hoister->is_invariant = true;
+	primec_ir_func_visit_operands(hoister->func, value, check_invariant, hoister);
+	return hoister->is_invariant;
+}
+
+static void check_invariant(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	hoister_s* const hoister = context;
+	if (hoister->loops[hoister->blocks[*operand]] == hoister->loop) { hoister->is_invariant = false; }
+}
+
+static void move_hoisted(
+	hoister_s* const hoister,
+	const primec_ir_block_t preheader)
+{
+	primec_ir_func_s* const func = hoister->func;
+	const primec_cfg_s* const cfg = &hoister->cfg;
+
+	for (uint32_t position = hoister->first; position <= hoister->last; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		if (hoister->loops[block] != hoister->loop) { continue; }
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (hoister->is_hoisted[value]) { continue; }
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+
+	// NOTE: The hoisted instructions go in front of the jump of the preheader,
+	//       and they are not hoisted again from there by the outer loops.
+	primec_ir_block_s* const record = &func->blocks.data[preheader];
+	const uint32_t count = record->instructions.count + hoister->hoisted.count;
+
+	if (count > record->instructions.capacity)
+	{
+		while (count > record->instructions.capacity) { record->instructions.capacity = 0 == record->instructions.capacity ? 8 : record->instructions.capacity * 2; }
+		record->instructions.data = primec_utils_realloc(record->instructions.data, record->instructions.capacity * sizeof(primec_ir_value_t));
+	}
+
+	const primec_ir_value_t terminator = record->instructions.data[record->instructions.count - 1];
+	primec_utils_memcpy(record->instructions.data + record->instructions.count - 1, hoister->hoisted.data, hoister->hoisted.count * sizeof(primec_ir_value_t));
+	record->instructions.data[count - 1] = terminator;
+	record->instructions.count = count;
+
+	for (uint32_t index = 0; index < hoister->hoisted.count; ++index) { hoister->is_hoisted[hoister->hoisted.data[index]] = false; }
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -112,9 +112,10 @@ static void log_with_tag(
 	primec_debug_assert(format != NULL);
 
 	#define logging_buffer_capacity 2048
-	static char logging_buffer[logging_buffer_capacity + 1];
+	static _Thread_local char logging_buffer[logging_buffer_capacity + 1];
 	uint64_t length = (uint64_t)vsnprintf(
 		logging_buffer, logging_buffer_capacity, format, args);
+	if (length >= logging_buffer_capacity) { length = logging_buffer_capacity - 1; }
 	logging_buffer[length++] = '\n';
 	logging_buffer[length] = 0;
 	#undef logging_buffer_capacity
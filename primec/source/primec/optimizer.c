@@ -0,0 +1,173 @@
+
+/**
+ * @file optimizer.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/optimizer.h>
+
+#include <primec/debug.h>
+#include <primec/inliner.h>
+#include <primec/promote.h>
+#include <primec/tailcall.h>
+#include <primec/sccp.h>
+#include <primec/gvn.h>
+#include <primec/dce.h>
+#include <primec/bounds.h>
+#include <primec/licm.h>
+#include <primec/vectorizer.h>
+
+#include <stddef.h>
+
+typedef struct
+{
+	primec_ir_program_s* program;
+	const primec_build_graph_s* graph;
+	primec_optimizer_level_e level;
+	bool is_vectorizing;
+} optimizer_s;
+
+typedef void (*pass_f)(
+	const optimizer_s* const optimizer);
+
+typedef struct
+{
+	primec_optimizer_level_e level;	// lowest level, that runs the pass
+	pass_f run;
+} pass_s;
+
+static void run_inliner(
+	const optimizer_s* const optimizer);
+
+static void run_promote(
+	const optimizer_s* const optimizer);
+
+static void run_tailcall(
+	const optimizer_s* const optimizer);
+
+static void run_sccp(
+	const optimizer_s* const optimizer);
+
+static void run_gvn(
+	const optimizer_s* const optimizer);
+
+static void run_dce(
+	const optimizer_s* const optimizer);
+
+static void run_bounds(
+	const optimizer_s* const optimizer);
+
+static void run_licm(
+	const optimizer_s* const optimizer);
+
+static void run_vectorizer(
+	const optimizer_s* const optimizer);
+
+// NOTE: The slots are promoted before the inlining too, so the arguments of the
+//       inlined calls replace the parameters in their uses, and the calls of
+//       the functions passed as arguments become direct. The self-recursive
+//       tail calls become loops right after the promotion, so the other passes
+//       see them as the written loops. The constants are propagated and the
+//       values numbered before the checks are removed, so the ranges see the
+//       folded values, and the invariants are hoisted before the vectorizer
+//       looks for the invariant limits.
+static const pass_s g_passes[] =
+{
+	{ primec_optimizer_level_scalar, run_promote },
+	{ primec_optimizer_level_none, run_inliner },
+	{ primec_optimizer_level_scalar, run_promote },
+	{ primec_optimizer_level_scalar, run_tailcall },
+	{ primec_optimizer_level_scalar, run_sccp },
+	{ primec_optimizer_level_scalar, run_gvn },
+	{ primec_optimizer_level_scalar, run_dce },
+	{ primec_optimizer_level_none, run_bounds },
+	{ primec_optimizer_level_scalar, run_licm },
+	{ primec_optimizer_level_full, run_vectorizer },
+	{ primec_optimizer_level_scalar, run_dce },
+};
+
+void primec_optimizer_run(
+	primec_ir_program_s* const program,
+	const primec_build_graph_s* const graph,
+	const primec_optimizer_level_e level,
+	const bool is_vectorizing)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(graph != NULL);
+	primec_debug_assert(level < primec_optimizer_levels_count);
+
+	const optimizer_s optimizer =
+	{
+		.program = program,
+		.graph = graph,
+		.level = level,
+		.is_vectorizing = is_vectorizing
+	};
+
+	for (uint32_t index = 0; index < sizeof(g_passes) / sizeof(g_passes[0]); ++index)
+	{
+		if (g_passes[index].level > level) { continue; }
+		g_passes[index].run(&optimizer);
+	}
+}
+
+static void run_inliner(
+	const optimizer_s* const optimizer)
+{
+	primec_inliner_run(optimizer->program, optimizer->graph, optimizer->level > primec_optimizer_level_none);
+}
+
+static void run_promote(
+	const optimizer_s* const optimizer)
+{
+	primec_promote_run(optimizer->program);
+}
+
+static void run_tailcall(
+	const optimizer_s* const optimizer)
+{
+	primec_tailcall_run(optimizer->program);
+}
+
+static void run_sccp(
+	const optimizer_s* const optimizer)
+{
+	primec_sccp_run(optimizer->program);
+}
+
+static void run_gvn(
+	const optimizer_s* const optimizer)
+{
+	primec_gvn_run(optimizer->program);
+}
+
+static void run_dce(
+	const optimizer_s* const optimizer)
+{
+	primec_dce_run(optimizer->program);
+}
+
+static void run_bounds(
+	const optimizer_s* const optimizer)
+{
+	if (primec_optimizer_level_none == optimizer->level) { primec_bounds_remove_unsafe(optimizer->program); }
+	else { primec_bounds_run(optimizer->program); }
+}
+
+static void run_licm(
+	const optimizer_s* const optimizer)
+{
+	primec_licm_run(optimizer->program);
+}
+
+static void run_vectorizer(
+	const optimizer_s* const optimizer)
+{
+	if (optimizer->is_vectorizing) { primec_vectorizer_run(optimizer->program); }
+}
@@ -0,0 +1,1494 @@
+
+/**
+ * @file parser.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/parser.h>
+
+#include <primec/source_manager.h>
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define log_parser_error_and_exit(_location, _format, ...)                     \
+	do {                                                                       \
+		(void)fprintf(stderr, primec_location_fmt ": ",                        \
+			primec_location_arg(_location));                                   \
+		primec_logger_error(_format, ## __VA_ARGS__);                          \
+		exit(-1);                                                              \
+	} while (0)
+
+#define max_expression_depth 1024
+
+typedef enum
+{
+	associativity_left,
+	associativity_right,
+	associativity_none
+} associativity_e;
+
+typedef enum
+{
+	precedence_none,
+	precedence_assignment,
+	precedence_range,
+	precedence_lor,
+	precedence_lxor,
+	precedence_land,
+	precedence_comparison,
+	precedence_bor,
+	precedence_bxor,
+	precedence_band,
+	precedence_shift,
+	precedence_additive,
+	precedence_multiplicative,
+	precedence_cast,
+	precedence_prefix
+} precedence_e;
+
+typedef struct
+{
+	uint8_t precedence;
+	uint8_t associativity;
+	uint8_t kind;
+} binding_power_s;
+
+#define binding_power(_precedence, _associativity, _kind)                      \
+	{ (uint8_t)(_precedence), (uint8_t)(_associativity), (uint8_t)(_kind) }
+
+static const binding_power_s g_token_type_to_binding_power_map[] =
+{
+	[primec_token_type_keyword_as] = binding_power(precedence_cast, associativity_left, primec_ast_kind_cast),
+
+	[primec_token_type_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_add_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_subtract_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_multiply_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_divide_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_modulus_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_land_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_lor_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_lxor_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_band_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_bor_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_bnot_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_bxor_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_lshift_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+	[primec_token_type_rshift_assign] = binding_power(precedence_assignment, associativity_right, primec_ast_kind_assign),
+
+	[primec_token_type_add] = binding_power(precedence_additive, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_subtract] = binding_power(precedence_additive, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_star] = binding_power(precedence_multiplicative, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_divide] = binding_power(precedence_multiplicative, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_modulus] = binding_power(precedence_multiplicative, associativity_left, primec_ast_kind_binary),
+
+	[primec_token_type_equal] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_not_equal] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_greater_than] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_less_than] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_greater_than_or_equal] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_less_than_or_equal] = binding_power(precedence_comparison, associativity_none, primec_ast_kind_binary),
+
+	[primec_token_type_land] = binding_power(precedence_land, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_lor] = binding_power(precedence_lor, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_lxor] = binding_power(precedence_lxor, associativity_left, primec_ast_kind_binary),
+
+	[primec_token_type_ampersand] = binding_power(precedence_band, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_bor] = binding_power(precedence_bor, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_bxor] = binding_power(precedence_bxor, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_lshift] = binding_power(precedence_shift, associativity_left, primec_ast_kind_binary),
+	[primec_token_type_rshift] = binding_power(precedence_shift, associativity_left, primec_ast_kind_binary),
+
+	[primec_token_type_slice] = binding_power(precedence_range, associativity_none, primec_ast_kind_binary),
+	[primec_token_type_ellipsis] = binding_power(precedence_range, associativity_none, primec_ast_kind_binary)
+};
+
+_Static_assert(
+	(sizeof(g_token_type_to_binding_power_map) / sizeof(g_token_type_to_binding_power_map[0])) == (primec_token_type_informationless_count + 1),
+	"g_token_type_to_binding_power_map is not in sync with primec_token_type_e enum!"
+);
+
+#undef binding_power
+
+typedef struct
+{
+	primec_ast_s* ast;
+	primec_ast_s part;
+	const primec_parser_body_s* bodies;
+	primec_ast_index_t* blocks;
+	uint32_t count;
+	primec_ast_index_t nodes_base;
+	primec_ast_index_t extra_base;
+} batch_s;
+
+static void build_skeleton(
+	primec_parser_s* const parser);
+
+static void parse_batch_task(
+	void* const context);
+
+static void merge_batch_task(
+	void* const context);
+
+static void parse_bodies(
+	primec_parser_s* const parser,
+	primec_thread_pool_s* const pool);
+
+static const primec_token_s* peek(
+	const primec_parser_s* const parser);
+
+static const primec_token_s* peek_at(
+	const primec_parser_s* const parser,
+	const uint32_t offset);
+
+static bool check(
+	const primec_parser_s* const parser,
+	const primec_token_type_e type);
+
+static uint32_t advance(
+	primec_parser_s* const parser);
+
+static bool match(
+	primec_parser_s* const parser,
+	const primec_token_type_e type);
+
+static uint32_t expect(
+	primec_parser_s* const parser,
+	const primec_token_type_e type,
+	const char* const what);
+
+static uint32_t scratch_top(
+	const primec_parser_s* const parser);
+
+static void scratch_push(
+	primec_parser_s* const parser,
+	const primec_ast_index_t index);
+
+static primec_ast_range_s scratch_flush(
+	primec_parser_s* const parser,
+	const uint32_t top);
+
+static primec_ast_index_t push_range_record(
+	primec_parser_s* const parser,
+	const primec_ast_range_s range);
+
+static bool is_primitive_type_keyword(
+	const primec_token_type_e type);
+
+static primec_ast_index_t parse_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_use_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_proto(
+	primec_parser_s* const parser,
+	uint32_t flags,
+	const bool named_params);
+
+static primec_ast_index_t parse_func_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_struct_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_enum_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_alias_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_let_declaration(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_type(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_block(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_statement(
+	primec_parser_s* const parser,
+	bool* const is_tail);
+
+static primec_ast_index_t parse_if_statement(
+	primec_parser_s* const parser);
+
+static binding_power_s get_binding_power(
+	const primec_token_type_e type);
+
+static void check_depth(
+	const primec_parser_s* const parser);
+
+static void push_operator(
+	primec_parser_s* const parser,
+	const uint32_t token,
+	const binding_power_s binding,
+	const primec_ast_index_t flags);
+
+static void reduce_operator(
+	primec_parser_s* const parser);
+
+static bool parse_prefix_operator(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_expression(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_postfix(
+	primec_parser_s* const parser);
+
+static primec_ast_index_t parse_primary(
+	primec_parser_s* const parser);
+
+primec_parser_s primec_parser_from_parts(
+	primec_ast_s* const ast)
+{
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(ast->tokens.count > 0);
+
+	primec_parser_s parser;
+	parser.ast = ast;
+	parser.cursor = 0;
+	parser.depth = 0;
+	parser.scratch.capacity = 64;
+	parser.scratch.data = primec_utils_malloc(parser.scratch.capacity * sizeof(primec_ast_index_t));
+	parser.scratch.count = 0;
+	parser.operators.capacity = 32;
+	parser.operators.data = primec_utils_malloc(parser.operators.capacity * sizeof(parser.operators.data[0]));
+	parser.operators.count = 0;
+	parser.skeleton.capacity = 64;
+	parser.skeleton.data = primec_utils_malloc(parser.skeleton.capacity * sizeof(primec_parser_braces_s));
+	parser.skeleton.count = 0;
+	parser.skeleton.next = 0;
+	parser.bodies.capacity = 64;
+	parser.bodies.data = primec_utils_malloc(parser.bodies.capacity * sizeof(primec_parser_body_s));
+	parser.bodies.count = 0;
+	return parser;
+}
+
+void primec_parser_destroy(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	primec_utils_free(parser->scratch.data);
+	primec_utils_free(parser->operators.data);
+	primec_utils_free(parser->skeleton.data);
+	primec_utils_free(parser->bodies.data);
+	primec_utils_memset((void*)parser, 0, sizeof(primec_parser_s));
+}
+
+primec_ast_index_t primec_parser_parse(
+	primec_parser_s* const parser,
+	primec_thread_pool_s* const pool)
+{
+	primec_debug_assert(parser != NULL);
+	primec_debug_assert(!parser->ast->is_part);
+
+	build_skeleton(parser);
+	const uint32_t top = scratch_top(parser);
+
+	while (!check(parser, primec_token_type_eof))
+	{
+		scratch_push(parser, parse_declaration(parser));
+	}
+
+	const primec_ast_range_s declarations = scratch_flush(parser, top);
+	parser->ast->root = primec_ast_push_node(
+		parser->ast, primec_ast_kind_module, 0, declarations.start, declarations.end
+	);
+
+	parse_bodies(parser, pool);
+	return parser->ast->root;
+}
+
+static void build_skeleton(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	const primec_ast_s* const ast = parser->ast;
+	uint64_t depth = 0;
+	uint32_t open = 0;
+
+	// NOTE: The skeleton pass only counts braces, thus it is a single linear
+	//       scan over the token types of the file.
+	for (uint32_t index = 0; index < ast->tokens.count; ++index)
+	{
+		const primec_token_type_e type = ast->tokens.data[index].type;
+
+		if (primec_token_type_left_brace == type)
+		{
+			if (0 == depth++)
+			{
+				open = index;
+			}
+		}
+		else if (primec_token_type_right_brace == type)
+		{
+			if (0 == depth)
+			{
+				log_parser_error_and_exit(ast->tokens.data[index].location, "unexpected `}` without matching `{`.");
+			}
+
+			if (0 == --depth)
+			{
+				if (parser->skeleton.count >= parser->skeleton.capacity)
+				{
+					parser->skeleton.capacity *= 2;
+					parser->skeleton.data = primec_utils_realloc(
+						parser->skeleton.data, parser->skeleton.capacity * sizeof(primec_parser_braces_s)
+					);
+				}
+
+				parser->skeleton.data[parser->skeleton.count++] = (primec_parser_braces_s)
+				{
+					.open = open,
+					.close = index
+				};
+			}
+		}
+	}
+
+	if (depth > 0)
+	{
+		log_parser_error_and_exit(ast->tokens.data[open].location, "unexpected end of file, `{` is never closed.");
+	}
+}
+
+static void parse_batch_task(
+	void* const context)
+{
+	batch_s* const batch = (batch_s*)context;
+	primec_debug_assert(batch != NULL);
+
+	batch->part = primec_ast_part_from_ast(batch->ast);
+	primec_parser_s parser = primec_parser_from_parts(&batch->part);
+
+	for (uint32_t index = 0; index < batch->count; ++index)
+	{
+		parser.cursor = batch->bodies[index].braces.open;
+		batch->blocks[index] = parse_block(&parser);
+		primec_debug_assert(parser.cursor == batch->bodies[index].braces.close + 1);
+	}
+
+	primec_parser_destroy(&parser);
+}
+
+static void merge_batch_task(
+	void* const context)
+{
+	batch_s* const batch = (batch_s*)context;
+	primec_debug_assert(batch != NULL);
+
+	primec_ast_merge_part(batch->ast, &batch->part, batch->nodes_base, batch->extra_base);
+
+	for (uint32_t index = 0; index < batch->count; ++index)
+	{
+		batch->ast->nodes.data[batch->bodies[index].node].rhs =
+			primec_ast_relocate_node(batch->blocks[index], batch->nodes_base);
+	}
+
+	primec_ast_destroy(&batch->part);
+}
+
+static void parse_bodies(
+	primec_parser_s* const parser,
+	primec_thread_pool_s* const pool)
+{
+	primec_debug_assert(parser != NULL);
+
+	if (0 == parser->bodies.count)
+	{
+		return;
+	}
+
+	uint64_t tokens_count = 0;
+
+	for (uint32_t index = 0; index < parser->bodies.count; ++index)
+	{
+		tokens_count += parser->bodies.data[index].braces.close - parser->bodies.data[index].braces.open + 1;
+	}
+
+	// NOTE: Bodies are parsed in batches of consecutive functions, so files with
+	//       thousands of tiny functions do not pay for a task and an ast part
+	//       per function, while there are still a few batches per thread.
+	const uint64_t threads_count = NULL == pool ? 1 : (uint64_t)pool->workers.count + 1;
+	uint64_t batch_tokens = tokens_count / (threads_count * 4);
+	if (batch_tokens < 4096) { batch_tokens = 4096; }
+
+	batch_s* const batches = primec_utils_malloc(parser->bodies.count * sizeof(batch_s));
+	primec_ast_index_t* const blocks = primec_utils_malloc(parser->bodies.count * sizeof(primec_ast_index_t));
+	uint32_t batches_count = 0;
+
+	for (uint32_t index = 0; index < parser->bodies.count;)
+	{
+		batch_s* const batch = &batches[batches_count++];
+		batch->ast = parser->ast;
+		batch->bodies = &parser->bodies.data[index];
+		batch->blocks = &blocks[index];
+		batch->count = 0;
+
+		for (uint64_t batch_tokens_count = 0; index < parser->bodies.count && batch_tokens_count < batch_tokens; ++index)
+		{
+			batch_tokens_count += parser->bodies.data[index].braces.close - parser->bodies.data[index].braces.open + 1;
+			++batch->count;
+		}
+	}
+
+	primec_thread_pool_group_s group = {0};
+
+	for (uint32_t index = 0; index < batches_count; ++index)
+	{
+		if (NULL == pool) { parse_batch_task(&batches[index]); continue; }
+		primec_thread_pool_submit(pool, &group, parse_batch_task, &batches[index]);
+	}
+
+	if (pool != NULL) { primec_thread_pool_wait(pool, &group); }
+
+	// NOTE: The ranges of the parts in the ast are known upfront, so the parts
+	//       are merged into disjoint ranges without any locking.
+	uint32_t nodes_count = 0;
+	uint32_t extra_count = 0;
+
+	for (uint32_t index = 0; index < batches_count; ++index)
+	{
+		batches[index].nodes_base = parser->ast->nodes.count + nodes_count;
+		batches[index].extra_base = parser->ast->extra.count + extra_count;
+		nodes_count += batches[index].part.nodes.count - 1;
+		extra_count += batches[index].part.extra.count;
+	}
+
+	primec_ast_reserve(parser->ast, nodes_count, extra_count);
+
+	for (uint32_t index = 0; index < batches_count; ++index)
+	{
+		if (NULL == pool) { merge_batch_task(&batches[index]); continue; }
+		primec_thread_pool_submit(pool, &group, merge_batch_task, &batches[index]);
+	}
+
+	if (pool != NULL) { primec_thread_pool_wait(pool, &group); }
+
+	parser->ast->nodes.count += nodes_count;
+	parser->ast->extra.count += extra_count;
+
+	primec_utils_free(blocks);
+	primec_utils_free(batches);
+	parser->bodies.count = 0;
+}
+
+static const primec_token_s* peek(
+	const primec_parser_s* const parser)
+{
+	return peek_at(parser, 0);
+}
+
+static const primec_token_s* peek_at(
+	const primec_parser_s* const parser,
+	const uint32_t offset)
+{
+	primec_debug_assert(parser != NULL);
+	const uint32_t last = parser->ast->tokens.count - 1;
+	const uint32_t index = parser->cursor + offset > last ? last : parser->cursor + offset;
+	return &parser->ast->tokens.data[index];
+}
+
+static bool check(
+	const primec_parser_s* const parser,
+	const primec_token_type_e type)
+{
+	return peek(parser)->type == type;
+}
+
+static uint32_t advance(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	const uint32_t index = parser->cursor;
+
+	if (parser->cursor + 1 < parser->ast->tokens.count)
+	{
+		++parser->cursor;
+	}
+
+	return index;
+}
+
+static bool match(
+	primec_parser_s* const parser,
+	const primec_token_type_e type)
+{
+	if (!check(parser, type))
+	{
+		return false;
+	}
+
+	(void)advance(parser);
+	return true;
+}
+
+static uint32_t expect(
+	primec_parser_s* const parser,
+	const primec_token_type_e type,
+	const char* const what)
+{
+	primec_debug_assert(parser != NULL);
+	primec_debug_assert(what != NULL);
+
+	const primec_token_s* const token = peek(parser);
+
+	if (token->type != type)
+	{
+		log_parser_error_and_exit(token->location, "expected %s, but found `%s`.",
+			what, primec_token_type_to_string(token->type)
+		);
+	}
+
+	return advance(parser);
+}
+
+static uint32_t scratch_top(
+	const primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	return parser->scratch.count;
+}
+
+static void scratch_push(
+	primec_parser_s* const parser,
+	const primec_ast_index_t index)
+{
+	primec_debug_assert(parser != NULL);
+
+	if (parser->scratch.count >= parser->scratch.capacity)
+	{
+		parser->scratch.capacity *= 2;
+		parser->scratch.data = primec_utils_realloc(
+			parser->scratch.data, parser->scratch.capacity * sizeof(primec_ast_index_t)
+		);
+	}
+
+	parser->scratch.data[parser->scratch.count++] = index;
+}
+
+static primec_ast_range_s scratch_flush(
+	primec_parser_s* const parser,
+	const uint32_t top)
+{
+	primec_debug_assert(parser != NULL);
+	primec_debug_assert(top <= parser->scratch.count);
+
+	// NOTE: Children of nested lists are collected on the scratch stack, and
+	//       only moved to the extra data once the list is complete, so every
+	//       list ends up contiguous in the extra data array.
+	const uint32_t count = parser->scratch.count - top;
+	const primec_ast_index_t start = primec_ast_push_extra(parser->ast, parser->scratch.data + top, count);
+	parser->scratch.count = top;
+
+	return (primec_ast_range_s)
+	{
+		.start = start,
+		.end = start + count
+	};
+}
+
+static primec_ast_index_t push_range_record(
+	primec_parser_s* const parser,
+	const primec_ast_range_s range)
+{
+	const primec_ast_index_t record[] = { range.start, range.end };
+	return primec_ast_push_extra(parser->ast, record, 2);
+}
+
+static bool is_primitive_type_keyword(
+	const primec_token_type_e type)
+{
+	switch (type)
+	{
+		case primec_token_type_keyword_i8:
+		case primec_token_type_keyword_i16:
+		case primec_token_type_keyword_i32:
+		case primec_token_type_keyword_i64:
+		case primec_token_type_keyword_u8:
+		case primec_token_type_keyword_u16:
+		case primec_token_type_keyword_u32:
+		case primec_token_type_keyword_u64:
+		case primec_token_type_keyword_f32:
+		case primec_token_type_keyword_f64:
+		case primec_token_type_keyword_c8:
+		{
+			return true;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static primec_ast_index_t parse_declaration(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	const primec_token_s* const token = peek(parser);
+
+	switch (token->type)
+	{
+		case primec_token_type_keyword_use:
+		{
+			return parse_use_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_inl:
+		case primec_token_type_keyword_ext:
+		case primec_token_type_keyword_func:
+		{
+			return parse_func_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_struct:
+		{
+			return parse_struct_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_enum:
+		{
+			return parse_enum_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_alias:
+		{
+			return parse_alias_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_let:
+		{
+			return parse_let_declaration(parser);
+		} break;
+
+		default:
+		{
+			log_parser_error_and_exit(token->location, "expected declaration, but found `%s`.",
+				primec_token_type_to_string(token->type)
+			);
+		} break;
+	}
+
+	return primec_ast_null;
+}
+
+static primec_ast_index_t parse_use_declaration(
+	primec_parser_s* const parser)
+{
+	const uint32_t use = expect(parser, primec_token_type_keyword_use, "`use`");
+	const uint32_t first = expect(parser, primec_token_type_identifier, "module name");
+	uint32_t last = first;
+
+	while (match(parser, primec_token_type_double_colon))
+	{
+		last = expect(parser, primec_token_type_identifier, "module name");
+	}
+
+	(void)expect(parser, primec_token_type_semicolon, "`;`");
+	return primec_ast_push_node(parser->ast, primec_ast_kind_use_decl, use, first, last);
+}
+
+static primec_ast_index_t parse_proto(
+	primec_parser_s* const parser,
+	uint32_t flags,
+	const bool named_params)
+{
+	(void)expect(parser, primec_token_type_left_parenth, "`(`");
+	const uint32_t top = scratch_top(parser);
+
+	while (!check(parser, primec_token_type_right_parenth))
+	{
+		if (match(parser, primec_token_type_ellipsis))
+		{
+			flags |= primec_ast_proto_flag_variadic;
+			break;
+		}
+
+		if (named_params)
+		{
+			const uint32_t name = expect(parser, primec_token_type_identifier, "parameter name");
+			(void)expect(parser, primec_token_type_colon, "`:`");
+			const primec_ast_index_t type = parse_type(parser);
+			scratch_push(parser, primec_ast_push_node(parser->ast, primec_ast_kind_param, name, type, primec_ast_null));
+		}
+		else
+		{
+			scratch_push(parser, parse_type(parser));
+		}
+
+		if (!match(parser, primec_token_type_comma))
+		{
+			break;
+		}
+	}
+
+	(void)expect(parser, primec_token_type_right_parenth, "`)`");
+	const primec_ast_range_s params = scratch_flush(parser, top);
+	primec_ast_index_t return_type = primec_ast_null;
+
+	if (match(parser, primec_token_type_arrow))
+	{
+		return_type = parse_type(parser);
+	}
+
+	const primec_ast_index_t record[] = { params.start, params.end, return_type, flags };
+	return primec_ast_push_extra(parser->ast, record, 4);
+}
+
+static primec_ast_index_t parse_func_declaration(
+	primec_parser_s* const parser)
+{
+	uint32_t flags = 0;
+
+	if (match(parser, primec_token_type_keyword_inl))
+	{
+		flags |= primec_ast_proto_flag_inl;
+	}
+	else if (match(parser, primec_token_type_keyword_ext))
+	{
+		flags |= primec_ast_proto_flag_ext;
+	}
+
+	(void)expect(parser, primec_token_type_keyword_func, "`func`");
+	const uint32_t name = expect(parser, primec_token_type_identifier, "function name");
+	const primec_ast_index_t proto = parse_proto(parser, flags, true);
+	primec_ast_index_t body = primec_ast_null;
+
+	if (flags & primec_ast_proto_flag_ext)
+	{
+		(void)expect(parser, primec_token_type_semicolon, "`;`");
+		return primec_ast_push_node(parser->ast, primec_ast_kind_func_decl, name, proto, body);
+	}
+
+	if (!check(parser, primec_token_type_left_brace))
+	{
+		(void)expect(parser, primec_token_type_left_brace, "`{`");
+	}
+
+	// NOTE: The body is skipped by jumping over its skeleton braces, and it is
+	//       parsed later, together with all the other bodies.
+	while (parser->skeleton.data[parser->skeleton.next].open < parser->cursor)
+	{
+		++parser->skeleton.next;
+	}
+
+	primec_debug_assert(parser->skeleton.next < parser->skeleton.count);
+	const primec_parser_braces_s braces = parser->skeleton.data[parser->skeleton.next];
+	primec_debug_assert(braces.open == parser->cursor);
+	parser->cursor = braces.close + 1;
+
+	const primec_ast_index_t node = primec_ast_push_node(parser->ast, primec_ast_kind_func_decl, name, proto, body);
+
+	if (parser->bodies.count >= parser->bodies.capacity)
+	{
+		parser->bodies.capacity *= 2;
+		parser->bodies.data = primec_utils_realloc(parser->bodies.data, parser->bodies.capacity * sizeof(primec_parser_body_s));
+	}
+
+	parser->bodies.data[parser->bodies.count++] = (primec_parser_body_s)
+	{
+		.node = node,
+		.braces = braces
+	};
+
+	return node;
+}
+
+static primec_ast_index_t parse_struct_declaration(
+	primec_parser_s* const parser)
+{
+	(void)expect(parser, primec_token_type_keyword_struct, "`struct`");
+	const uint32_t name = expect(parser, primec_token_type_identifier, "struct name");
+	(void)expect(parser, primec_token_type_left_brace, "`{`");
+	const uint32_t top = scratch_top(parser);
+
+	while (!check(parser, primec_token_type_right_brace))
+	{
+		const uint32_t field = expect(parser, primec_token_type_identifier, "field name");
+		(void)expect(parser, primec_token_type_colon, "`:`");
+		const primec_ast_index_t type = parse_type(parser);
+		scratch_push(parser, primec_ast_push_node(parser->ast, primec_ast_kind_field, field, type, primec_ast_null));
+
+		if (!match(parser, primec_token_type_comma))
+		{
+			break;
+		}
+	}
+
+	(void)expect(parser, primec_token_type_right_brace, "`}`");
+	const primec_ast_range_s fields = scratch_flush(parser, top);
+	return primec_ast_push_node(parser->ast, primec_ast_kind_struct_decl, name, fields.start, fields.end);
+}
+
+static primec_ast_index_t parse_enum_declaration(
+	primec_parser_s* const parser)
+{
+	(void)expect(parser, primec_token_type_keyword_enum, "`enum`");
+	const uint32_t name = expect(parser, primec_token_type_identifier, "enum name");
+	primec_ast_index_t type = primec_ast_null;
+
+	if (match(parser, primec_token_type_colon))
+	{
+		type = parse_type(parser);
+	}
+
+	(void)expect(parser, primec_token_type_left_brace, "`{`");
+	const uint32_t top = scratch_top(parser);
+
+	while (!check(parser, primec_token_type_right_brace))
+	{
+		const uint32_t member = expect(parser, primec_token_type_identifier, "enum member name");
+		primec_ast_index_t value = primec_ast_null;
+
+		if (match(parser, primec_token_type_assign))
+		{
+			value = parse_expression(parser);
+		}
+
+		scratch_push(parser, primec_ast_push_node(parser->ast, primec_ast_kind_enum_member, member, value, primec_ast_null));
+
+		if (!match(parser, primec_token_type_comma))
+		{
+			break;
+		}
+	}
+
+	(void)expect(parser, primec_token_type_right_brace, "`}`");
+	const primec_ast_index_t members = push_range_record(parser, scratch_flush(parser, top));
+	return primec_ast_push_node(parser->ast, primec_ast_kind_enum_decl, name, type, members);
+}
+
+static primec_ast_index_t parse_alias_declaration(
+	primec_parser_s* const parser)
+{
+	(void)expect(parser, primec_token_type_keyword_alias, "`alias`");
+	const uint32_t name = expect(parser, primec_token_type_identifier, "alias name");
+	(void)expect(parser, primec_token_type_assign, "`=`");
+	const primec_ast_index_t type = parse_type(parser);
+	(void)expect(parser, primec_token_type_semicolon, "`;`");
+	return primec_ast_push_node(parser->ast, primec_ast_kind_alias_decl, name, type, primec_ast_null);
+}
+
+static primec_ast_index_t parse_let_declaration(
+	primec_parser_s* const parser)
+{
+	(void)expect(parser, primec_token_type_keyword_let, "`let`");
+	const uint32_t name = expect(parser, primec_token_type_identifier, "variable name");
+	primec_ast_index_t type = primec_ast_null;
+	primec_ast_index_t value = primec_ast_null;
+
+	if (match(parser, primec_token_type_colon))
+	{
+		type = parse_type(parser);
+	}
+
+	if (match(parser, primec_token_type_assign))
+	{
+		value = parse_expression(parser);
+	}
+
+	if (primec_ast_null == type && primec_ast_null == value)
+	{
+		log_parser_error_and_exit(primec_ast_get_token(parser->ast, name)->location,
+			"variable declaration requires a type or an initializer."
+		);
+	}
+
+	(void)expect(parser, primec_token_type_semicolon, "`;`");
+	return primec_ast_push_node(parser->ast, primec_ast_kind_let_decl, name, type, value);
+}
+
+static primec_ast_index_t parse_type(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	const primec_token_s* const token = peek(parser);
+
+	if (is_primitive_type_keyword(token->type) || primec_token_type_identifier == token->type)
+	{
+		const uint32_t name = advance(parser);
+		return primec_ast_push_node(parser->ast, primec_ast_kind_type_name, name, primec_ast_null, primec_ast_null);
+	}
+
+	switch (token->type)
+	{
+		case primec_token_type_keyword_mut:
+		{
+			const uint32_t mut = advance(parser);
+			const primec_ast_index_t inner = parse_type(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_type_mut, mut, inner, primec_ast_null);
+		} break;
+
+		case primec_token_type_reference:
+		case primec_token_type_pointer:
+		{
+			const uint32_t sigil = advance(parser);
+			const bool is_mutable = match(parser, primec_token_type_keyword_mut);
+			const primec_ast_index_t pointee = parse_type(parser);
+			return primec_ast_push_node(parser->ast,
+				primec_token_type_reference == token->type ? primec_ast_kind_type_reference : primec_ast_kind_type_pointer,
+				sigil, pointee, (primec_ast_index_t)is_mutable
+			);
+		} break;
+
+		case primec_token_type_left_bracket:
+		{
+			const uint32_t bracket = advance(parser);
+			const primec_ast_index_t element = parse_type(parser);
+
+			if (match(parser, primec_token_type_comma))
+			{
+				const primec_ast_index_t size = parse_expression(parser);
+				(void)expect(parser, primec_token_type_right_bracket, "`]`");
+				return primec_ast_push_node(parser->ast, primec_ast_kind_type_array, bracket, element, size);
+			}
+
+			(void)expect(parser, primec_token_type_right_bracket, "`]`");
+			return primec_ast_push_node(parser->ast, primec_ast_kind_type_slice, bracket, element, primec_ast_null);
+		} break;
+
+		case primec_token_type_keyword_func:
+		{
+			const uint32_t func = advance(parser);
+			const primec_ast_index_t proto = parse_proto(parser, 0, false);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_type_func, func, proto, primec_ast_null);
+		} break;
+
+		default:
+		{
+			log_parser_error_and_exit(token->location, "expected type, but found `%s`.",
+				primec_token_type_to_string(token->type)
+			);
+		} break;
+	}
+
+	return primec_ast_null;
+}
+
+static primec_ast_index_t parse_block(
+	primec_parser_s* const parser)
+{
+	const uint32_t brace = expect(parser, primec_token_type_left_brace, "`{`");
+	const uint32_t top = scratch_top(parser);
+
+	while (!check(parser, primec_token_type_right_brace))
+	{
+		if (check(parser, primec_token_type_eof))
+		{
+			log_parser_error_and_exit(peek(parser)->location, "unexpected end of file, expected `}`.");
+		}
+
+		bool is_tail = false;
+		scratch_push(parser, parse_statement(parser, &is_tail));
+
+		if (is_tail)
+		{
+			break;
+		}
+	}
+
+	(void)expect(parser, primec_token_type_right_brace, "`}`");
+	const primec_ast_range_s statements = scratch_flush(parser, top);
+	return primec_ast_push_node(parser->ast, primec_ast_kind_block, brace, statements.start, statements.end);
+}
+
+static primec_ast_index_t parse_statement(
+	primec_parser_s* const parser,
+	bool* const is_tail)
+{
+	primec_debug_assert(parser != NULL);
+	primec_debug_assert(is_tail != NULL);
+	const primec_token_s* const token = peek(parser);
+
+	switch (token->type)
+	{
+		case primec_token_type_keyword_let:
+		{
+			return parse_let_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_alias:
+		{
+			return parse_alias_declaration(parser);
+		} break;
+
+		case primec_token_type_keyword_if:
+		{
+			return parse_if_statement(parser);
+		} break;
+
+		case primec_token_type_keyword_while:
+		{
+			const uint32_t keyword = advance(parser);
+			const primec_ast_index_t condition = parse_expression(parser);
+			const primec_ast_index_t body = parse_block(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_while, keyword, condition, body);
+		} break;
+
+		case primec_token_type_keyword_loop:
+		{
+			const uint32_t keyword = advance(parser);
+			const primec_ast_index_t body = parse_block(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_loop, keyword, body, primec_ast_null);
+		} break;
+
+		case primec_token_type_keyword_break:
+		case primec_token_type_keyword_continue:
+		{
+			const uint32_t keyword = advance(parser);
+			(void)expect(parser, primec_token_type_semicolon, "`;`");
+			return primec_ast_push_node(parser->ast,
+				primec_token_type_keyword_break == token->type ? primec_ast_kind_break : primec_ast_kind_continue,
+				keyword, primec_ast_null, primec_ast_null
+			);
+		} break;
+
+		case primec_token_type_keyword_return:
+		{
+			const uint32_t keyword = advance(parser);
+			primec_ast_index_t value = primec_ast_null;
+
+			if (!check(parser, primec_token_type_semicolon))
+			{
+				value = parse_expression(parser);
+			}
+
+			(void)expect(parser, primec_token_type_semicolon, "`;`");
+			return primec_ast_push_node(parser->ast, primec_ast_kind_return, keyword, value, primec_ast_null);
+		} break;
+
+		case primec_token_type_left_brace:
+		{
+			return parse_block(parser);
+		} break;
+
+		case primec_token_type_keyword_unsafe:
+		{
+			if (peek_at(parser, 1)->type == primec_token_type_left_brace)
+			{
+				// NOTE: An unsafe block is an expression, however, when it is used
+				//       as a statement it does not require a trailing semicolon.
+				const uint32_t keyword = advance(parser);
+				const primec_ast_index_t block = parse_block(parser);
+				const primec_ast_index_t unsafe_block = primec_ast_push_node(
+					parser->ast, primec_ast_kind_unsafe_block, keyword, block, primec_ast_null
+				);
+
+				(void)match(parser, primec_token_type_semicolon);
+				return unsafe_block;
+			}
+		} /* fallthrough */
+
+		default:
+		{
+			const uint32_t first = parser->cursor;
+			const primec_ast_index_t expression = parse_expression(parser);
+
+			if (check(parser, primec_token_type_right_brace))
+			{
+				*is_tail = true;
+				return expression;
+			}
+
+			(void)expect(parser, primec_token_type_semicolon, "`;`");
+			return primec_ast_push_node(parser->ast, primec_ast_kind_expr_stmt, first, expression, primec_ast_null);
+		} break;
+	}
+
+	return primec_ast_null;
+}
+
+static primec_ast_index_t parse_if_statement(
+	primec_parser_s* const parser)
+{
+	const uint32_t keyword = advance(parser);
+	const primec_ast_index_t condition = parse_expression(parser);
+	const primec_ast_index_t then_block = parse_block(parser);
+	primec_ast_index_t else_branch = primec_ast_null;
+
+	if (check(parser, primec_token_type_keyword_elif))
+	{
+		else_branch = parse_if_statement(parser);
+	}
+	else if (match(parser, primec_token_type_keyword_else))
+	{
+		else_branch = parse_block(parser);
+	}
+
+	const primec_ast_index_t record[] = { then_block, else_branch };
+	const primec_ast_index_t extra = primec_ast_push_extra(parser->ast, record, 2);
+	return primec_ast_push_node(parser->ast, primec_ast_kind_if, keyword, condition, extra);
+}
+
+static binding_power_s get_binding_power(
+	const primec_token_type_e type)
+{
+	if (type > primec_token_type_informationless_count)
+	{
+		return (binding_power_s) { precedence_none, associativity_left, primec_ast_kind_null };
+	}
+
+	return g_token_type_to_binding_power_map[type];
+}
+
+static void check_depth(
+	const primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+
+	// NOTE: The nested expressions and the pending operators, such as the long
+	//       runs of the prefix ones, are the depths of the trees, which all the
+	//       later passes walk recursively, so they are limited here.
+	if (parser->depth + parser->operators.count > max_expression_depth)
+	{
+		log_parser_error_and_exit(peek(parser)->location, "expression is nested too deeply -- more than %u levels.",
+			max_expression_depth
+		);
+	}
+}
+
+static void push_operator(
+	primec_parser_s* const parser,
+	const uint32_t token,
+	const binding_power_s binding,
+	const primec_ast_index_t flags)
+{
+	primec_debug_assert(parser != NULL);
+	check_depth(parser);
+
+	if (parser->operators.count >= parser->operators.capacity)
+	{
+		parser->operators.capacity *= 2;
+		parser->operators.data = primec_utils_realloc(
+			parser->operators.data, parser->operators.capacity * sizeof(parser->operators.data[0])
+		);
+	}
+
+	parser->operators.data[parser->operators.count].token = token;
+	parser->operators.data[parser->operators.count].precedence = binding.precedence;
+	parser->operators.data[parser->operators.count].kind = binding.kind;
+	parser->operators.data[parser->operators.count].flags = flags;
+	++parser->operators.count;
+}
+
+static void reduce_operator(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+	primec_debug_assert(parser->operators.count > 0);
+
+	const uint32_t index = --parser->operators.count;
+	const uint32_t token = parser->operators.data[index].token;
+	const primec_ast_kind_e kind = (primec_ast_kind_e)parser->operators.data[index].kind;
+	const primec_ast_index_t flags = parser->operators.data[index].flags;
+
+	if (precedence_prefix == parser->operators.data[index].precedence)
+	{
+		primec_debug_assert(parser->scratch.count > 0);
+		const primec_ast_index_t operand = parser->scratch.data[parser->scratch.count - 1];
+		parser->scratch.data[parser->scratch.count - 1] = primec_ast_push_node(parser->ast, kind, token, operand, flags);
+		return;
+	}
+
+	primec_debug_assert(parser->scratch.count > 1);
+	const primec_ast_index_t right = parser->scratch.data[--parser->scratch.count];
+	const primec_ast_index_t left = parser->scratch.data[parser->scratch.count - 1];
+	parser->scratch.data[parser->scratch.count - 1] = primec_ast_push_node(parser->ast, kind, token, left, right);
+}
+
+static bool parse_prefix_operator(
+	primec_parser_s* const parser)
+{
+	const primec_token_type_e type = peek(parser)->type;
+	const binding_power_s prefix = { precedence_prefix, associativity_right, primec_ast_kind_null };
+	binding_power_s binding = prefix;
+
+	switch (type)
+	{
+		case primec_token_type_add:
+		case primec_token_type_subtract:
+		case primec_token_type_lnot:
+		case primec_token_type_bnot:
+		{
+			binding.kind = primec_ast_kind_unary;
+			push_operator(parser, advance(parser), binding, primec_ast_null);
+		} break;
+
+		case primec_token_type_pointer:
+		{
+			binding.kind = primec_ast_kind_deref;
+			push_operator(parser, advance(parser), binding, primec_ast_null);
+		} break;
+
+		case primec_token_type_reference:
+		{
+			binding.kind = primec_ast_kind_address_of;
+			const uint32_t token = advance(parser);
+			const bool is_mutable = match(parser, primec_token_type_keyword_mut);
+			push_operator(parser, token, binding, (primec_ast_index_t)is_mutable);
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+static primec_ast_index_t parse_expression(
+	primec_parser_s* const parser)
+{
+	primec_debug_assert(parser != NULL);
+
+	// NOTE: Precedence climbing over an explicit operator stack (operands live
+	//       on the scratch stack): every token is pushed and reduced at most
+	//       once, and the only recursion left is for nested sub-expressions,
+	//       such as parenthesized expressions and call arguments, and never for
+	//       the precedence tiers.
+	const uint32_t operators_base = parser->operators.count;
+	const uint32_t operands_base = scratch_top(parser);
+	++parser->depth;
+	check_depth(parser);
+
+	while (true)
+	{
+		while (parse_prefix_operator(parser));
+		scratch_push(parser, parse_postfix(parser));
+
+		binding_power_s binding = get_binding_power(peek(parser)->type);
+
+		while (primec_ast_kind_cast == binding.kind)
+		{
+			while (parser->operators.count > operators_base &&
+				parser->operators.data[parser->operators.count - 1].precedence > binding.precedence)
+			{
+				reduce_operator(parser);
+			}
+
+			const uint32_t keyword = advance(parser);
+			const primec_ast_index_t type = parse_type(parser);
+			const primec_ast_index_t operand = parser->scratch.data[parser->scratch.count - 1];
+			parser->scratch.data[parser->scratch.count - 1] = primec_ast_push_node(
+				parser->ast, primec_ast_kind_cast, keyword, operand, type
+			);
+
+			binding = get_binding_power(peek(parser)->type);
+		}
+
+		if (precedence_none == binding.precedence)
+		{
+			break;
+		}
+
+		while (parser->operators.count > operators_base)
+		{
+			const uint8_t top = parser->operators.data[parser->operators.count - 1].precedence;
+
+			if (top == binding.precedence && associativity_none == binding.associativity)
+			{
+				log_parser_error_and_exit(peek(parser)->location, "operator `%s` cannot be chained without parentheses.",
+					primec_token_type_to_string(peek(parser)->type)
+				);
+			}
+
+			if (top < binding.precedence || (top == binding.precedence && associativity_right == binding.associativity))
+			{
+				break;
+			}
+
+			reduce_operator(parser);
+		}
+
+		push_operator(parser, advance(parser), binding, primec_ast_null);
+	}
+
+	while (parser->operators.count > operators_base)
+	{
+		reduce_operator(parser);
+	}
+
+	primec_debug_assert(parser->scratch.count == operands_base + 1);
+	(void)operands_base;
+	--parser->depth;
+	return parser->scratch.data[--parser->scratch.count];
+}
+
+static primec_ast_index_t parse_postfix(
+	primec_parser_s* const parser)
+{
+	primec_ast_index_t base = parse_primary(parser);
+
+	while (true)
+	{
+		switch (peek(parser)->type)
+		{
+			case primec_token_type_left_parenth:
+			{
+				const uint32_t parenth = advance(parser);
+				const uint32_t top = scratch_top(parser);
+
+				while (!check(parser, primec_token_type_right_parenth))
+				{
+					scratch_push(parser, parse_expression(parser));
+
+					if (!match(parser, primec_token_type_comma))
+					{
+						break;
+					}
+				}
+
+				(void)expect(parser, primec_token_type_right_parenth, "`)`");
+				const primec_ast_index_t arguments = push_range_record(parser, scratch_flush(parser, top));
+				base = primec_ast_push_node(parser->ast, primec_ast_kind_call, parenth, base, arguments);
+			} break;
+
+			case primec_token_type_left_bracket:
+			{
+				const uint32_t bracket = advance(parser);
+				primec_ast_index_t start = primec_ast_null;
+
+				if (!check(parser, primec_token_type_colon))
+				{
+					start = parse_expression(parser);
+				}
+
+				if (check(parser, primec_token_type_colon))
+				{
+					const uint32_t colon = advance(parser);
+					primec_ast_index_t end = primec_ast_null;
+
+					if (!check(parser, primec_token_type_right_bracket))
+					{
+						end = parse_expression(parser);
+					}
+
+					(void)expect(parser, primec_token_type_right_bracket, "`]`");
+					const primec_ast_index_t record[] = { start, end };
+					const primec_ast_index_t extra = primec_ast_push_extra(parser->ast, record, 2);
+					base = primec_ast_push_node(parser->ast, primec_ast_kind_slice, colon, base, extra);
+				}
+				else
+				{
+					(void)expect(parser, primec_token_type_right_bracket, "`]`");
+					base = primec_ast_push_node(parser->ast, primec_ast_kind_index, bracket, base, start);
+				}
+			} break;
+
+			case primec_token_type_dot:
+			{
+				(void)advance(parser);
+				const uint32_t field = expect(parser, primec_token_type_identifier, "field name");
+				base = primec_ast_push_node(parser->ast, primec_ast_kind_member, field, base, primec_ast_null);
+			} break;
+
+			case primec_token_type_double_colon:
+			{
+				(void)advance(parser);
+				const uint32_t name = expect(parser, primec_token_type_identifier, "name");
+				base = primec_ast_push_node(parser->ast, primec_ast_kind_scope, name, base, primec_ast_null);
+			} break;
+
+			default:
+			{
+				return base;
+			} break;
+		}
+	}
+}
+
+static primec_ast_index_t parse_primary(
+	primec_parser_s* const parser)
+{
+	const primec_token_s* const token = peek(parser);
+
+	switch (token->type)
+	{
+		case primec_token_type_literal_i8:
+		case primec_token_type_literal_i16:
+		case primec_token_type_literal_i32:
+		case primec_token_type_literal_i64:
+		case primec_token_type_literal_u8:
+		case primec_token_type_literal_u16:
+		case primec_token_type_literal_u32:
+		case primec_token_type_literal_u64:
+		{
+			const uint32_t literal = advance(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_int_literal, literal, primec_ast_null, primec_ast_null);
+		} break;
+
+		case primec_token_type_literal_f32:
+		case primec_token_type_literal_f64:
+		{
+			const uint32_t literal = advance(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_float_literal, literal, primec_ast_null, primec_ast_null);
+		} break;
+
+		case primec_token_type_literal_rune:
+		{
+			const uint32_t literal = advance(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_rune_literal, literal, primec_ast_null, primec_ast_null);
+		} break;
+
+		case primec_token_type_literal_str:
+		{
+			const uint32_t literal = advance(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_string_literal, literal, primec_ast_null, primec_ast_null);
+		} break;
+
+		case primec_token_type_identifier:
+		{
+			const uint32_t name = advance(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_identifier, name, primec_ast_null, primec_ast_null);
+		} break;
+
+		case primec_token_type_left_parenth:
+		{
+			(void)advance(parser);
+			const primec_ast_index_t expression = parse_expression(parser);
+			(void)expect(parser, primec_token_type_right_parenth, "`)`");
+			return expression;
+		} break;
+
+		case primec_token_type_keyword_unsafe:
+		{
+			const uint32_t keyword = advance(parser);
+			const primec_ast_index_t block = parse_block(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_unsafe_block, keyword, block, primec_ast_null);
+		} break;
+
+		case primec_token_type_keyword_func:
+		{
+			const uint32_t func = advance(parser);
+			const primec_ast_index_t proto = parse_proto(parser, 0, true);
+			const primec_ast_index_t body = parse_block(parser);
+			return primec_ast_push_node(parser->ast, primec_ast_kind_lambda, func, proto, body);
+		} break;
+
+		default:
+		{
+			log_parser_error_and_exit(token->location, "expected expression, but found `%s`.",
+				primec_token_type_to_string(token->type)
+			);
+		} break;
+	}
+
+	return primec_ast_null;
+}
@@ -0,0 +1,647 @@
+
+/**
+ * @file promote.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/promote.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+
+#include <stddef.h>
+
+#define no_slot UINT32_MAX
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	uint32_t block;
+	uint32_t mark;		// length of the undo log before the block, or UINT32_MAX if it is not entered yet
+} visit_s;
+
+typedef struct
+{
+	const primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_cfg_s cfg;
+
+	uint32_t* slots;				// number of the promoted slot of every value, or no_slot
+	primec_ir_value_t* candidates;	// slot values by their numbers
+	uint32_t candidates_count;
+	primec_ir_value_t* undefined;	// zeros, seen by the loads before any store
+
+	uint32_t* owners;				// promoted slot of every inserted phi, or no_slot
+	list_s* incoming;				// incoming pairs of the inserted phis
+	primec_ir_value_t* current;		// values of the slots in the renamed block
+	primec_ir_value_t* replacements;
+	list_s undo;					// (slot, previous value) pairs
+	bool* is_used;
+	list_s worklist;
+} promoter_s;
+
+static void promote_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static void find_candidates(
+	promoter_s* const promoter);
+
+static void disqualify(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void place_phis(
+	promoter_s* const promoter);
+
+static void rename_blocks(
+	promoter_s* const promoter);
+
+static void rename_block(
+	promoter_s* const promoter,
+	const primec_ir_block_t block);
+
+static void set_current(
+	promoter_s* const promoter,
+	const uint32_t slot,
+	const primec_ir_value_t value);
+
+static primec_ir_value_t resolve(
+	const promoter_s* const promoter,
+	primec_ir_value_t value);
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void mark_used(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void remove_unused(
+	promoter_s* const promoter);
+
+static void move_to_front(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const uint32_t count);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_promote_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		promote_func(program->types, func);
+	}
+}
+
+static void promote_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	promoter_s promoter = { .types = types, .func = func };
+	primec_cfg_build(&promoter.cfg, func);
+
+	// NOTE: The entry has no place for the phis, so the functions, that jump
+	//       back to it, are left as they are.
+	if (promoter.cfg.predecessors_starts[1] > 0)
+	{
+		primec_cfg_destroy(&promoter.cfg);
+		return;
+	}
+
+	find_candidates(&promoter);
+
+	if (0 == promoter.candidates_count)
+	{
+		primec_utils_free(promoter.slots);
+		primec_utils_free(promoter.candidates);
+		primec_cfg_destroy(&promoter.cfg);
+		return;
+	}
+
+	promoter.undefined = primec_utils_malloc(promoter.candidates_count * sizeof(primec_ir_value_t));
+
+	for (uint32_t slot = 0; slot < promoter.candidates_count; ++slot)
+	{
+		const primec_type_t type = primec_type_table_get(types, primec_ir_func_get(func, promoter.candidates[slot])->type)->element;
+		promoter.undefined[slot] = primec_ir_func_add(func, 0, primec_ir_op_const, type, 0, 0);
+	}
+
+	move_to_front(func, 0, promoter.candidates_count);
+
+	place_phis(&promoter);
+
+	// NOTE: No values are added from here on, so the tables cover them all.
+	const uint32_t values_count = func->instructions.count;
+	promoter.replacements = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	promoter.incoming = primec_utils_malloc(values_count * sizeof(list_s));
+	promoter.is_used = primec_utils_malloc(values_count * sizeof(bool));
+	promoter.current = primec_utils_malloc(promoter.candidates_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(promoter.replacements, 0, values_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(promoter.incoming, 0, values_count * sizeof(list_s));
+	primec_utils_memset(promoter.is_used, 0, values_count * sizeof(bool));
+
+	rename_blocks(&promoter);
+
+	for (primec_ir_value_t value = 1; value < values_count; ++value)
+	{
+		if (promoter.owners[value] == no_slot) { continue; }
+		primec_ir_func_get(func, value)->a = primec_ir_func_add_list(func, promoter.incoming[value].data, promoter.incoming[value].count);
+		primec_utils_free(promoter.incoming[value].data);
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			primec_ir_func_visit_operands(func, record->instructions.data[index], replace, &promoter);
+		}
+	}
+
+	remove_unused(&promoter);
+
+	primec_utils_free(promoter.slots);
+	primec_utils_free(promoter.candidates);
+	primec_utils_free(promoter.undefined);
+	primec_utils_free(promoter.owners);
+	primec_utils_free(promoter.incoming);
+	primec_utils_free(promoter.current);
+	primec_utils_free(promoter.replacements);
+	primec_utils_free(promoter.undo.data);
+	primec_utils_free(promoter.is_used);
+	primec_utils_free(promoter.worklist.data);
+	primec_cfg_destroy(&promoter.cfg);
+}
+
+static void find_candidates(
+	promoter_s* const promoter)
+{
+	primec_ir_func_s* const func = promoter->func;
+	const uint32_t values_count = func->instructions.count;
+	promoter->slots = primec_utils_malloc(values_count * sizeof(uint32_t));
+
+	for (primec_ir_value_t value = 0; value < values_count; ++value)
+	{
+		const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+		const bool is_scalar = primec_ir_op_slot == instruction->op &&
+			!primec_ir_is_aggregate(promoter->types, primec_type_table_get(promoter->types, instruction->type)->element);
+		promoter->slots[value] = is_scalar ? 0 : no_slot;
+	}
+
+	// NOTE: Slots are promoted only if they are the addresses of the loads and
+	//       the stores of their own types, so no other instruction can see their
+	//       memory.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			if (primec_ir_op_load == instruction->op || primec_ir_op_store == instruction->op)
+			{
+				const uint32_t address = instruction->a;
+
+				if (promoter->slots[address] != no_slot &&
+					primec_type_table_get(promoter->types, primec_ir_func_get(func, address)->type)->element != instruction->type)
+				{
+					promoter->slots[address] = no_slot;
+				}
+
+				if (primec_ir_op_store == instruction->op && promoter->slots[instruction->b] != no_slot)
+				{
+					promoter->slots[instruction->b] = no_slot;
+				}
+
+				continue;
+			}
+
+			primec_ir_func_visit_operands(func, value, disqualify, promoter);
+		}
+	}
+
+	promoter->candidates = primec_utils_malloc((values_count > 0 ? values_count : 1) * sizeof(primec_ir_value_t));
+	promoter->candidates_count = 0;
+
+	for (primec_ir_value_t value = 0; value < values_count; ++value)
+	{
+		if (no_slot == promoter->slots[value]) { continue; }
+		promoter->slots[value] = promoter->candidates_count;
+		promoter->candidates[promoter->candidates_count++] = value;
+	}
+}
+
+static void disqualify(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	promoter_s* const promoter = context;
+	promoter->slots[*operand] = no_slot;
+}
+
+static void place_phis(
+	promoter_s* const promoter)
+{
+	primec_ir_func_s* const func = promoter->func;
+	const primec_cfg_s* const cfg = &promoter->cfg;
+	const uint32_t blocks_count = func->blocks.count;
+
+	// NOTE: Frontiers are found by walking up from the predecessors of every
+	//       join to its immediate dominator.
+	list_s* const frontiers = primec_utils_malloc(blocks_count * sizeof(list_s));
+	primec_utils_memset(frontiers, 0, blocks_count * sizeof(list_s));
+
+	for (uint32_t position = 0; position < cfg->order_count; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		const uint32_t start = cfg->predecessors_starts[block];
+		const uint32_t end = cfg->predecessors_starts[block + 1];
+		if (end - start < 2) { continue; }
+
+		for (uint32_t index = start; index < end; ++index)
+		{
+			primec_ir_block_t runner = cfg->predecessors[index];
+			if (!primec_cfg_is_reachable(cfg, runner)) { continue; }
+
+			while (runner != cfg->idoms[block])
+			{
+				list_s* const frontier = &frontiers[runner];
+				if (0 == frontier->count || frontier->data[frontier->count - 1] != block) { push(frontier, block); }
+				runner = cfg->idoms[runner];
+			}
+		}
+	}
+
+	// NOTE: Stamps tell, for which slot the blocks got their phis, or were put
+	//       on the worklist.
+	uint32_t* const has_phi = primec_utils_malloc(blocks_count * sizeof(uint32_t));
+	uint32_t* const has_work = primec_utils_malloc(blocks_count * sizeof(uint32_t));
+	uint32_t* const phis_counts = primec_utils_malloc(blocks_count * sizeof(uint32_t));
+	primec_utils_memset(has_phi, 0, blocks_count * sizeof(uint32_t));
+	primec_utils_memset(has_work, 0, blocks_count * sizeof(uint32_t));
+	primec_utils_memset(phis_counts, 0, blocks_count * sizeof(uint32_t));
+	list_s worklist = {0};
+	list_s phis = {0};
+
+	// NOTE: The blocks storing to every slot are gathered in a single walk over
+	//       the function, by the slots, with every block listed once per slot.
+	const uint32_t slots_count = promoter->candidates_count;
+	uint32_t* const stores_starts = primec_utils_malloc((slots_count + 1) * sizeof(uint32_t));
+	uint32_t* const stores_fill = primec_utils_malloc(slots_count * sizeof(uint32_t));
+	primec_utils_memset(stores_starts, 0, (slots_count + 1) * sizeof(uint32_t));
+	for (uint32_t slot = 0; slot < slots_count; ++slot) { stores_fill[slot] = UINT32_MAX; }
+	list_s stores = {0};
+
+	for (uint32_t position = 0; position < cfg->order_count; ++position)
+	{
+		const primec_ir_block_t block = cfg->order[position];
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[index]);
+			if (primec_ir_op_store != instruction->op || no_slot == promoter->slots[instruction->a]) { continue; }
+
+			// NOTE: Until the lists are filled, the fills hold the last block,
+			//       that was listed for the slot.
+			const uint32_t slot = promoter->slots[instruction->a];
+			if (stores_fill[slot] == block) { continue; }
+			stores_fill[slot] = block;
+			push(&stores, slot);
+			push(&stores, block);
+			++stores_starts[slot + 1];
+		}
+	}
+
+	for (uint32_t slot = 0; slot < slots_count; ++slot) { stores_starts[slot + 1] += stores_starts[slot]; }
+	primec_ir_block_t* const stores_blocks = primec_utils_malloc((stores.count > 0 ? stores.count / 2 : 1) * sizeof(primec_ir_block_t));
+	primec_utils_memcpy(stores_fill, stores_starts, slots_count * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < stores.count; index += 2)
+	{
+		stores_blocks[stores_fill[stores.data[index]]++] = stores.data[index + 1];
+	}
+
+	for (uint32_t slot = 0; slot < slots_count; ++slot)
+	{
+		const uint32_t stamp = slot + 1;
+		worklist.count = 0;
+
+		for (uint32_t index = stores_starts[slot]; index < stores_starts[slot + 1]; ++index)
+		{
+			has_work[stores_blocks[index]] = stamp;
+			push(&worklist, stores_blocks[index]);
+		}
+
+		while (worklist.count > 0)
+		{
+			const primec_ir_block_t block = worklist.data[--worklist.count];
+
+			for (uint32_t index = 0; index < frontiers[block].count; ++index)
+			{
+				const primec_ir_block_t frontier = frontiers[block].data[index];
+				if (stamp == has_phi[frontier]) { continue; }
+
+				const primec_type_t type = primec_ir_func_get(func, promoter->undefined[slot])->type;
+				const primec_ir_value_t phi = primec_ir_func_add(func, frontier, primec_ir_op_phi, type, 0, 0);
+				++phis_counts[frontier];
+				push(&phis, phi);
+				push(&phis, slot);
+				has_phi[frontier] = stamp;
+
+				if (has_work[frontier] != stamp)
+				{
+					has_work[frontier] = stamp;
+					push(&worklist, frontier);
+				}
+			}
+		}
+	}
+
+	for (primec_ir_block_t block = 0; block < blocks_count; ++block)
+	{
+		if (phis_counts[block] > 0) { move_to_front(func, block, phis_counts[block]); }
+	}
+
+	const uint32_t values_count = func->instructions.count;
+	promoter->owners = primec_utils_malloc(values_count * sizeof(uint32_t));
+	for (primec_ir_value_t value = 0; value < values_count; ++value) { promoter->owners[value] = no_slot; }
+	for (uint32_t index = 0; index < phis.count; index += 2) { promoter->owners[phis.data[index]] = phis.data[index + 1]; }
+
+	for (primec_ir_block_t block = 0; block < blocks_count; ++block) { primec_utils_free(frontiers[block].data); }
+	primec_utils_free(frontiers);
+	primec_utils_free(has_phi);
+	primec_utils_free(has_work);
+	primec_utils_free(phis_counts);
+	primec_utils_free(stores_starts);
+	primec_utils_free(stores_blocks);
+	primec_utils_free(stores_fill);
+	primec_utils_free(stores.data);
+	primec_utils_free(worklist.data);
+	primec_utils_free(phis.data);
+}
+
+static void rename_blocks(
+	promoter_s* const promoter)
+{
+	const primec_cfg_s* const cfg = &promoter->cfg;
+	visit_s* const stack = primec_utils_malloc(2 * cfg->blocks_count * sizeof(visit_s));
+	uint32_t stack_count = 0;
+
+	for (uint32_t slot = 0; slot < promoter->candidates_count; ++slot) { promoter->current[slot] = promoter->undefined[slot]; }
+
+	// NOTE: The dominator tree is walked depth first, and every block leaves
+	//       the values of the slots as it found them.
+	stack[stack_count++] = (visit_s) { .block = 0, .mark = UINT32_MAX };
+
+	while (stack_count > 0)
+	{
+		const visit_s visit = stack[--stack_count];
+
+		if (visit.mark != UINT32_MAX)
+		{
+			while (promoter->undo.count > visit.mark)
+			{
+				promoter->undo.count -= 2;
+				promoter->current[promoter->undo.data[promoter->undo.count]] = promoter->undo.data[promoter->undo.count + 1];
+			}
+
+			continue;
+		}
+
+		stack[stack_count++] = (visit_s) { .block = visit.block, .mark = promoter->undo.count };
+		rename_block(promoter, visit.block);
+
+		for (uint32_t index = cfg->children_starts[visit.block + 1]; index > cfg->children_starts[visit.block]; --index)
+		{
+			stack[stack_count++] = (visit_s) { .block = cfg->children[index - 1], .mark = UINT32_MAX };
+		}
+	}
+
+	// NOTE: Unreachable blocks are never run, but they still need the values
+	//       for their loads and for the phis of their successors. The walk left
+	//       every slot undefined, and so does every such block, by its undo log.
+	for (primec_ir_block_t block = 0; block < cfg->blocks_count; ++block)
+	{
+		if (primec_cfg_is_reachable(cfg, block)) { continue; }
+		const uint32_t mark = promoter->undo.count;
+		rename_block(promoter, block);
+
+		while (promoter->undo.count > mark)
+		{
+			promoter->undo.count -= 2;
+			promoter->current[promoter->undo.data[promoter->undo.count]] = promoter->undo.data[promoter->undo.count + 1];
+		}
+	}
+
+	primec_utils_free(stack);
+}
+
+static void rename_block(
+	promoter_s* const promoter,
+	const primec_ir_block_t block)
+{
+	primec_ir_func_s* const func = promoter->func;
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_value_t value = record->instructions.data[index];
+		primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+		switch ((primec_ir_op_e)instruction->op)
+		{
+			case primec_ir_op_phi:
+			{
+				if (promoter->owners[value] != no_slot) { set_current(promoter, promoter->owners[value], value); }
+			} break;
+
+			case primec_ir_op_load:
+			{
+				if (no_slot == promoter->slots[instruction->a]) { break; }
+				promoter->replacements[value] = promoter->current[promoter->slots[instruction->a]];
+				instruction->op = primec_ir_op_nop;
+			} break;
+
+			case primec_ir_op_store:
+			{
+				if (no_slot == promoter->slots[instruction->a]) { break; }
+				set_current(promoter, promoter->slots[instruction->a], resolve(promoter, instruction->b));
+				instruction->op = primec_ir_op_nop;
+			} break;
+
+			case primec_ir_op_slot:
+			{
+				if (promoter->slots[value] != no_slot) { instruction->op = primec_ir_op_nop; }
+			} break;
+
+			default:
+			{
+			} break;
+		}
+	}
+
+	primec_ir_block_t successors[2] = {0};
+	const uint32_t successors_count = primec_ir_block_get_successors(func, block, successors);
+
+	for (uint32_t successor = 0; successor < successors_count; ++successor)
+	{
+		const primec_ir_block_s* const target = &func->blocks.data[successors[successor]];
+
+		for (uint32_t index = 0; index < target->instructions.count; ++index)
+		{
+			const primec_ir_value_t phi = target->instructions.data[index];
+			if (primec_ir_func_get(func, phi)->op != primec_ir_op_phi) { break; }
+			if (no_slot == promoter->owners[phi]) { continue; }
+
+			push(&promoter->incoming[phi], block);
+			push(&promoter->incoming[phi], promoter->current[promoter->owners[phi]]);
+		}
+	}
+}
+
+static void set_current(
+	promoter_s* const promoter,
+	const uint32_t slot,
+	const primec_ir_value_t value)
+{
+	push(&promoter->undo, slot);
+	push(&promoter->undo, promoter->current[slot]);
+	promoter->current[slot] = value;
+}
+
+static primec_ir_value_t resolve(
+	const promoter_s* const promoter,
+	primec_ir_value_t value)
+{
+	while (promoter->replacements[value] != primec_ir_null) { value = promoter->replacements[value]; }
+	return value;
+}
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	const promoter_s* const promoter = context;
+	*operand = resolve(promoter, *operand);
+}
+
+static void mark_used(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	promoter_s* const promoter = context;
+	if (promoter->is_used[*operand]) { return; }
+	promoter->is_used[*operand] = true;
+	if (promoter->owners[*operand] != no_slot) { push(&promoter->worklist, *operand); }
+}
+
+static void remove_unused(
+	promoter_s* const promoter)
+{
+	primec_ir_func_s* const func = promoter->func;
+
+	// NOTE: The inserted phis and zeros are kept only if they are used by the
+	//       other instructions, or by the phis, that are kept.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (promoter->owners[value] != no_slot) { continue; }
+			primec_ir_func_visit_operands(func, value, mark_used, promoter);
+		}
+	}
+
+	while (promoter->worklist.count > 0)
+	{
+		primec_ir_func_visit_operands(func, promoter->worklist.data[--promoter->worklist.count], mark_used, promoter);
+	}
+
+	for (uint32_t slot = 0; slot < promoter->candidates_count; ++slot)
+	{
+		if (!promoter->is_used[promoter->undefined[slot]]) { primec_ir_func_get(func, promoter->undefined[slot])->op = primec_ir_op_nop; }
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+			if (promoter->owners[value] != no_slot && !promoter->is_used[value]) { instruction->op = primec_ir_op_nop; }
+			if (primec_ir_op_nop == instruction->op) { continue; }
+			record->instructions.data[count++] = value;
+		}
+
+		record->instructions.count = count;
+	}
+}
+
+static void move_to_front(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const uint32_t count)
+{
+	// NOTE: The values were appended last, so they are moved to the front, in
+	//       their order, at once.
+	primec_ir_block_s* const record = &func->blocks.data[block];
+	primec_debug_assert(record->instructions.count >= count);
+	if (0 == count) { return; }
+
+	const uint32_t others_count = record->instructions.count - count;
+	primec_ir_value_t* const moved = primec_utils_malloc(count * sizeof(primec_ir_value_t));
+	primec_utils_memcpy(moved, record->instructions.data + others_count, count * sizeof(primec_ir_value_t));
+
+	for (uint32_t index = others_count; index > 0; --index)
+	{
+		record->instructions.data[index - 1 + count] = record->instructions.data[index - 1];
+	}
+
+	primec_utils_memcpy(record->instructions.data, moved, count * sizeof(primec_ir_value_t));
+	primec_utils_free(moved);
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -0,0 +1,1592 @@
+
+/**
+ * @file regalloc.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/regalloc.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+#define max_occurrences 4
+#define max_split_blocks 32
+#define spilled UINT32_MAX
+
+typedef struct
+{
+	uint32_t reg;
+	bool is_use;
+	bool is_def;
+} occurrence_s;
+
+typedef struct
+{
+	uint32_t start;
+	uint32_t end;
+} range_s;
+
+typedef struct
+{
+	range_s* data;
+	uint32_t capacity;
+	uint32_t count;
+} ranges_s;
+
+/**
+ * @brief Part of the live range of a virtual register, that stays in a single
+ * machine register (or in the slot of the virtual register).
+ */
+typedef struct
+{
+	uint32_t start;
+	uint32_t end;
+	uint32_t vreg;
+	uint32_t reg;	// machine register (or spilled)
+	uint32_t next;	// interval, that continues the live range after a split (or UINT32_MAX)
+} interval_s;
+
+typedef struct
+{
+	primec_x86_64_func_s* func;
+	uint32_t vregs_count;
+	uint32_t words_count;
+
+	struct
+	{
+		uint32_t* starts;	// index of the first instruction of the block
+		uint32_t* ends;		// index past the last instruction of the block
+		uint32_t* labels;	// block of every label
+		uint32_t* depths;	// number of the loops around the block
+		uint64_t* gen;
+		uint64_t* kill;
+		uint64_t* live_in;
+		uint64_t* live_out;
+		uint32_t count;
+	} blocks;
+
+	range_s* ranges;		// whole live range of every virtual register
+	uint32_t* firsts;		// first interval of every virtual register (or UINT32_MAX)
+	uint32_t* spills;
+
+	struct
+	{
+		uint32_t* starts;	// first entry of every virtual register (the last one is the total)
+		uint32_t* data;		// instructions, that use or define the virtual register, in order
+	} occurrences;
+
+	struct
+	{
+		interval_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} intervals;
+
+	struct
+	{
+		uint32_t* data;		// binary heap of the intervals, ordered by their starts
+		uint32_t capacity;
+		uint32_t count;
+	} unhandled;
+
+	struct
+	{
+		uint32_t* starts;	// first entry of every virtual register (the last one is the total)
+		uint32_t* data;		// intervals of the virtual register, ordered by their starts
+	} chains;
+
+	struct
+	{
+		uint32_t* starts;	// first entry of every instruction (the last one is the total)
+		uint32_t* data;		// intervals, whose registers are loaded before the instruction
+	} reloads;
+
+	ranges_s fixed[primec_x86_64_regs_count];
+} allocator_s;
+
+// NOTE: Caller-saved registers are preferred, as they do not need to be saved
+//       by the prologue. The scratch registers are left out.
+static const uint32_t g_gprs_order[] =
+{
+	primec_x86_64_reg_rax, primec_x86_64_reg_rcx, primec_x86_64_reg_rdx, primec_x86_64_reg_rsi,
+	primec_x86_64_reg_rdi, primec_x86_64_reg_r8, primec_x86_64_reg_r9, primec_x86_64_reg_rbx,
+	primec_x86_64_reg_r12, primec_x86_64_reg_r13, primec_x86_64_reg_r14, primec_x86_64_reg_r15
+};
+
+static const uint32_t g_xmms_order[] =
+{
+	primec_x86_64_reg_xmm0, primec_x86_64_reg_xmm1, primec_x86_64_reg_xmm2, primec_x86_64_reg_xmm3,
+	primec_x86_64_reg_xmm4, primec_x86_64_reg_xmm5, primec_x86_64_reg_xmm6, primec_x86_64_reg_xmm7,
+	primec_x86_64_reg_xmm8, primec_x86_64_reg_xmm9, primec_x86_64_reg_xmm10, primec_x86_64_reg_xmm11,
+	primec_x86_64_reg_xmm12, primec_x86_64_reg_xmm13
+};
+
+static const uint32_t g_gprs_scratch[] = { primec_x86_64_reg_r11, primec_x86_64_reg_r10 };
+static const uint32_t g_xmms_scratch[] = { primec_x86_64_reg_xmm15, primec_x86_64_reg_xmm14 };
+
+static const uint32_t g_callee_saved_mask =
+	1u << primec_x86_64_reg_rbx | 1u << primec_x86_64_reg_r12 | 1u << primec_x86_64_reg_r13 |
+	1u << primec_x86_64_reg_r14 | 1u << primec_x86_64_reg_r15;
+
+static uint32_t get_occurrences(
+	const primec_x86_64_instruction_s* const instruction,
+	occurrence_s* const occurrences);
+
+static void add_occurrence(
+	occurrence_s* const occurrences,
+	uint32_t* const count,
+	const uint32_t reg,
+	const bool is_use,
+	const bool is_def);
+
+static void build_blocks(
+	allocator_s* const allocator);
+
+static void build_depths(
+	allocator_s* const allocator);
+
+static uint32_t get_successors(
+	const allocator_s* const allocator,
+	const uint32_t block,
+	uint32_t* const successors);
+
+static void compute_liveness(
+	allocator_s* const allocator);
+
+static void build_ranges(
+	allocator_s* const allocator);
+
+static void build_occurrences(
+	allocator_s* const allocator);
+
+static void build_fixed_ranges(
+	allocator_s* const allocator);
+
+static void add_fixed_range(
+	allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t start,
+	const uint32_t end);
+
+static uint32_t get_free_until(
+	const allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t position);
+
+static uint32_t get_next_use(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t index);
+
+static uint32_t find_block(
+	const allocator_s* const allocator,
+	const uint32_t index);
+
+static uint32_t choose_split(
+	const allocator_s* const allocator,
+	const uint32_t start,
+	const uint32_t limit);
+
+static uint32_t add_interval(
+	allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t start,
+	const uint32_t end);
+
+static uint32_t split_interval(
+	allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position);
+
+static void spill_until_use(
+	allocator_s* const allocator,
+	const uint32_t interval);
+
+static bool has_use_before(
+	const allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position);
+
+static void assign_until(
+	allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position);
+
+static void push_unhandled(
+	allocator_s* const allocator,
+	const uint32_t interval);
+
+static uint32_t pop_unhandled(
+	allocator_s* const allocator);
+
+static bool is_before(
+	const allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t other);
+
+static void allocate(
+	allocator_s* const allocator);
+
+static void build_chains(
+	allocator_s* const allocator);
+
+static uint32_t find_interval(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t position);
+
+static bool is_split(
+	const allocator_s* const allocator,
+	const uint32_t vreg);
+
+static bool is_redefined(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t index);
+
+static bool is_redefined(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t index)
+{
+	// NOTE: A definition, that is followed by another one in the same block and
+	//       in the same register, needs no store, as the later one stores it.
+	const uint32_t use = get_next_use(allocator, vreg, index + 1);
+	if (UINT32_MAX == use || find_block(allocator, use / 2) != find_block(allocator, index)) { return false; }
+	if (find_interval(allocator, vreg, use) != find_interval(allocator, vreg, 2 * index)) { return false; }
+
+	occurrence_s occurrences[max_occurrences] = {0};
+	const uint32_t count = get_occurrences(&allocator->func->code.data[use / 2], occurrences);
+
+	for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+	{
+		if (primec_x86_64_vregs_start + vreg == occurrences[occurrence].reg) { return occurrences[occurrence].is_def; }
+	}
+
+	return false;
+}
+
+static bool is_defined_first(
+	const allocator_s* const allocator,
+	const interval_s* const interval);
+
+static void build_reloads(
+	allocator_s* const allocator);
+
+static void rewrite(
+	allocator_s* const allocator);
+
+static primec_x86_64_instruction_s make_move(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const primec_x86_64_operand_s destination,
+	const primec_x86_64_operand_s source);
+
+static primec_x86_64_operand_s get_location(
+	allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t index);
+
+static primec_x86_64_operand_s get_slot(
+	allocator_s* const allocator,
+	const uint32_t vreg);
+
+static bool is_vreg(
+	const uint32_t reg);
+
+static bool is_xmm_vreg(
+	const allocator_s* const allocator,
+	const uint32_t reg);
+
+static uint32_t get_block_end(
+	const allocator_s* const allocator,
+	const uint32_t block);
+
+void primec_regalloc_run(
+	primec_x86_64_func_s* const func)
+{
+	primec_debug_assert(func != NULL);
+
+	allocator_s allocator =
+	{
+		.func = func,
+		.vregs_count = func->vregs.count,
+		.words_count = (func->vregs.count + 63) / 64
+	};
+
+	const uint32_t vregs_count = func->vregs.count > 0 ? func->vregs.count : 1;
+	allocator.ranges = primec_utils_malloc(vregs_count * sizeof(range_s));
+	allocator.firsts = primec_utils_malloc(vregs_count * sizeof(uint32_t));
+	allocator.spills = primec_utils_malloc(vregs_count * sizeof(uint32_t));
+	primec_utils_memset(allocator.firsts, 0xff, vregs_count * sizeof(uint32_t));
+	primec_utils_memset(allocator.spills, 0, vregs_count * sizeof(uint32_t));
+
+	build_blocks(&allocator);
+	build_depths(&allocator);
+	compute_liveness(&allocator);
+	build_ranges(&allocator);
+	build_occurrences(&allocator);
+	build_fixed_ranges(&allocator);
+	allocate(&allocator);
+	build_chains(&allocator);
+	build_reloads(&allocator);
+	rewrite(&allocator);
+
+	for (uint32_t reg = 0; reg < primec_x86_64_regs_count; ++reg)
+	{
+		primec_utils_free(allocator.fixed[reg].data);
+	}
+
+	primec_utils_free(allocator.blocks.starts);
+	primec_utils_free(allocator.blocks.ends);
+	primec_utils_free(allocator.blocks.labels);
+	primec_utils_free(allocator.blocks.depths);
+	primec_utils_free(allocator.blocks.gen);
+	primec_utils_free(allocator.blocks.kill);
+	primec_utils_free(allocator.blocks.live_in);
+	primec_utils_free(allocator.blocks.live_out);
+	primec_utils_free(allocator.ranges);
+	primec_utils_free(allocator.firsts);
+	primec_utils_free(allocator.spills);
+	primec_utils_free(allocator.occurrences.starts);
+	primec_utils_free(allocator.occurrences.data);
+	primec_utils_free(allocator.intervals.data);
+	primec_utils_free(allocator.unhandled.data);
+	primec_utils_free(allocator.chains.starts);
+	primec_utils_free(allocator.chains.data);
+	primec_utils_free(allocator.reloads.starts);
+	primec_utils_free(allocator.reloads.data);
+}
+
+static uint32_t get_occurrences(
+	const primec_x86_64_instruction_s* const instruction,
+	occurrence_s* const occurrences)
+{
+	const uint32_t flags = primec_x86_64_op_get_flags((primec_x86_64_op_e)instruction->op);
+	uint32_t count = 0;
+
+	for (uint32_t index = 0; index < 2; ++index)
+	{
+		const primec_x86_64_operand_s* const operand = &instruction->operands[index];
+
+		if (primec_x86_64_operand_reg == operand->kind)
+		{
+			// NOTE: Sources are always read, while the destinations are read
+			//       and written as told by the flags of the op.
+			const bool is_destination = 0 == index;
+			const bool is_use = !is_destination || (flags & primec_x86_64_op_flag_reads) || !(flags & primec_x86_64_op_flag_writes);
+			const bool is_def = is_destination && (flags & primec_x86_64_op_flag_writes);
+			add_occurrence(occurrences, &count, operand->reg, is_use, is_def);
+		}
+		else if (primec_x86_64_operand_mem == operand->kind)
+		{
+			add_occurrence(occurrences, &count, operand->reg, true, false);
+			if (operand->scale != 0) { add_occurrence(occurrences, &count, operand->index, true, false); }
+		}
+	}
+
+	return count;
+}
+
+static void add_occurrence(
+	occurrence_s* const occurrences,
+	uint32_t* const count,
+	const uint32_t reg,
+	const bool is_use,
+	const bool is_def)
+{
+	// NOTE: The frame and stack pointers are not allocated.
+	if (primec_x86_64_reg_rbp == reg || primec_x86_64_reg_rsp == reg || primec_x86_64_reg_rip == reg)
+	{
+		return;
+	}
+
+	for (uint32_t index = 0; index < *count; ++index)
+	{
+		if (occurrences[index].reg != reg) { continue; }
+		occurrences[index].is_use |= is_use;
+		occurrences[index].is_def |= is_def;
+		return;
+	}
+
+	primec_debug_assert(*count < max_occurrences);
+	occurrences[(*count)++] = (occurrence_s) { .reg = reg, .is_use = is_use, .is_def = is_def };
+}
+
+static void build_blocks(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t count = func->code.count;
+
+	// NOTE: Blocks start at the labels and after the jumps, so every jump
+	//       ends its block.
+	uint32_t blocks_count = 0;
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const uint8_t op = func->code.data[index].op;
+		const bool is_start = 0 == index || primec_x86_64_op_label == op;
+		const uint8_t previous = index > 0 ? func->code.data[index - 1].op : primec_x86_64_op_label;
+		const bool is_after_jump = index > 0 && op != primec_x86_64_op_label &&
+			(primec_x86_64_op_jmp == previous || primec_x86_64_op_jcc == previous ||
+			primec_x86_64_op_ret == previous || primec_x86_64_op_tail == previous || primec_x86_64_op_ud2 == previous);
+		if (is_start || is_after_jump) { ++blocks_count; }
+	}
+
+	const uint32_t capacity = blocks_count > 0 ? blocks_count : 1;
+	const uint32_t labels_count = func->blocks_count > 0 ? func->blocks_count : 1;
+	const uint64_t words = (uint64_t)capacity * (allocator->words_count > 0 ? allocator->words_count : 1);
+
+	allocator->blocks.starts = primec_utils_malloc(capacity * sizeof(uint32_t));
+	allocator->blocks.ends = primec_utils_malloc(capacity * sizeof(uint32_t));
+	allocator->blocks.labels = primec_utils_malloc(labels_count * sizeof(uint32_t));
+	allocator->blocks.gen = primec_utils_malloc(words * sizeof(uint64_t));
+	allocator->blocks.kill = primec_utils_malloc(words * sizeof(uint64_t));
+	allocator->blocks.live_in = primec_utils_malloc(words * sizeof(uint64_t));
+	allocator->blocks.live_out = primec_utils_malloc(words * sizeof(uint64_t));
+	allocator->blocks.count = 0;
+
+	primec_utils_memset(allocator->blocks.labels, 0xff, labels_count * sizeof(uint32_t));
+	primec_utils_memset(allocator->blocks.gen, 0, words * sizeof(uint64_t));
+	primec_utils_memset(allocator->blocks.kill, 0, words * sizeof(uint64_t));
+	primec_utils_memset(allocator->blocks.live_in, 0, words * sizeof(uint64_t));
+	primec_utils_memset(allocator->blocks.live_out, 0, words * sizeof(uint64_t));
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const primec_x86_64_instruction_s* const instruction = &func->code.data[index];
+		const uint8_t previous = index > 0 ? func->code.data[index - 1].op : primec_x86_64_op_label;
+		const bool is_after_jump = index > 0 && instruction->op != primec_x86_64_op_label &&
+			(primec_x86_64_op_jmp == previous || primec_x86_64_op_jcc == previous ||
+			primec_x86_64_op_ret == previous || primec_x86_64_op_tail == previous || primec_x86_64_op_ud2 == previous);
+
+		if (0 == index || primec_x86_64_op_label == instruction->op || is_after_jump)
+		{
+			if (allocator->blocks.count > 0) { allocator->blocks.ends[allocator->blocks.count - 1] = index; }
+			allocator->blocks.starts[allocator->blocks.count++] = index;
+		}
+
+		if (primec_x86_64_op_label == instruction->op)
+		{
+			allocator->blocks.labels[instruction->operands[0].value] = allocator->blocks.count - 1;
+		}
+	}
+
+	if (allocator->blocks.count > 0)
+	{
+		allocator->blocks.ends[allocator->blocks.count - 1] = count;
+	}
+}
+
+static void build_depths(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t count = allocator->blocks.count;
+
+	// NOTE: Every backward jump closes a loop over the blocks from its target
+	//       up to the jump, so the depths are summed from the differences.
+	allocator->blocks.depths = primec_utils_malloc((count + 1) * sizeof(uint32_t));
+	primec_utils_memset(allocator->blocks.depths, 0, (count + 1) * sizeof(uint32_t));
+
+	for (uint32_t block = 0; block < count; ++block)
+	{
+		const primec_x86_64_instruction_s* const instruction = &func->code.data[allocator->blocks.ends[block] - 1];
+		if (instruction->op != primec_x86_64_op_jmp && instruction->op != primec_x86_64_op_jcc) { continue; }
+
+		const uint32_t target = allocator->blocks.labels[instruction->operands[0].value];
+		if (target > block) { continue; }
+
+		++allocator->blocks.depths[target];
+		--allocator->blocks.depths[block + 1];
+	}
+
+	for (uint32_t block = 1; block < count; ++block)
+	{
+		allocator->blocks.depths[block] += allocator->blocks.depths[block - 1];
+	}
+}
+
+static uint32_t get_successors(
+	const allocator_s* const allocator,
+	const uint32_t block,
+	uint32_t* const successors)
+{
+	const primec_x86_64_instruction_s* const instruction = &allocator->func->code.data[allocator->blocks.ends[block] - 1];
+	uint32_t count = 0;
+
+	if (primec_x86_64_op_jmp == instruction->op || primec_x86_64_op_jcc == instruction->op)
+	{
+		successors[count++] = allocator->blocks.labels[instruction->operands[0].value];
+	}
+
+	const bool is_terminal = primec_x86_64_op_jmp == instruction->op || primec_x86_64_op_ret == instruction->op ||
+		primec_x86_64_op_tail == instruction->op || primec_x86_64_op_ud2 == instruction->op;
+
+	if (!is_terminal && block + 1 < allocator->blocks.count)
+	{
+		successors[count++] = block + 1;
+	}
+
+	return count;
+}
+
+static void compute_liveness(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t words_count = allocator->words_count;
+	if (0 == words_count) { return; }
+
+	for (uint32_t block = 0; block < allocator->blocks.count; ++block)
+	{
+		uint64_t* const gen = &allocator->blocks.gen[(uint64_t)block * words_count];
+		uint64_t* const kill = &allocator->blocks.kill[(uint64_t)block * words_count];
+
+		for (uint32_t index = allocator->blocks.starts[block]; index < allocator->blocks.ends[block]; ++index)
+		{
+			occurrence_s occurrences[max_occurrences] = {0};
+			const uint32_t count = get_occurrences(&func->code.data[index], occurrences);
+
+			for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+			{
+				if (!is_vreg(occurrences[occurrence].reg)) { continue; }
+				const uint32_t vreg = occurrences[occurrence].reg - primec_x86_64_vregs_start;
+				const uint64_t bit = UINT64_C(1) << (vreg % 64);
+
+				if (occurrences[occurrence].is_use && !(kill[vreg / 64] & bit)) { gen[vreg / 64] |= bit; }
+			}
+
+			for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+			{
+				if (!is_vreg(occurrences[occurrence].reg) || !occurrences[occurrence].is_def) { continue; }
+				const uint32_t vreg = occurrences[occurrence].reg - primec_x86_64_vregs_start;
+				kill[vreg / 64] |= UINT64_C(1) << (vreg % 64);
+			}
+		}
+	}
+
+	// NOTE: The blocks are visited backwards, so the loops converge within a
+	//       few passes.
+	for (bool is_changed = true; is_changed;)
+	{
+		is_changed = false;
+
+		for (uint32_t block = allocator->blocks.count; block > 0; --block)
+		{
+			const uint32_t current = block - 1;
+			uint64_t* const live_out = &allocator->blocks.live_out[(uint64_t)current * words_count];
+			uint64_t* const live_in = &allocator->blocks.live_in[(uint64_t)current * words_count];
+
+			uint32_t successors[2] = {0};
+			const uint32_t successors_count = get_successors(allocator, current, successors);
+
+			for (uint32_t successor = 0; successor < successors_count; ++successor)
+			{
+				primec_debug_assert(successors[successor] < allocator->blocks.count);
+				const uint64_t* const successor_in = &allocator->blocks.live_in[(uint64_t)successors[successor] * words_count];
+
+				for (uint32_t word = 0; word < words_count; ++word)
+				{
+					live_out[word] |= successor_in[word];
+				}
+			}
+
+			const uint64_t* const gen = &allocator->blocks.gen[(uint64_t)current * words_count];
+			const uint64_t* const kill = &allocator->blocks.kill[(uint64_t)current * words_count];
+
+			for (uint32_t word = 0; word < words_count; ++word)
+			{
+				const uint64_t value = gen[word] | (live_out[word] & ~kill[word]);
+				if (value != live_in[word]) { live_in[word] = value; is_changed = true; }
+			}
+		}
+	}
+}
+
+static void build_ranges(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t words_count = allocator->words_count;
+
+	for (uint32_t vreg = 0; vreg < allocator->vregs_count; ++vreg)
+	{
+		allocator->ranges[vreg] = (range_s) { .start = UINT32_MAX, .end = 0 };
+	}
+
+	// NOTE: Uses are at the even positions and definitions at the odd ones, so
+	//       a register, that is last read by an instruction, can be reused for
+	//       its result.
+	for (uint32_t index = 0; index < func->code.count; ++index)
+	{
+		occurrence_s occurrences[max_occurrences] = {0};
+		const uint32_t count = get_occurrences(&func->code.data[index], occurrences);
+
+		for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+		{
+			if (!is_vreg(occurrences[occurrence].reg)) { continue; }
+			range_s* const range = &allocator->ranges[occurrences[occurrence].reg - primec_x86_64_vregs_start];
+			const uint32_t start = occurrences[occurrence].is_use ? 2 * index : 2 * index + 1;
+			const uint32_t end = occurrences[occurrence].is_def ? 2 * index + 1 : 2 * index;
+
+			if (start < range->start) { range->start = start; }
+			if (end > range->end) { range->end = end; }
+		}
+	}
+
+	for (uint32_t block = 0; block < allocator->blocks.count; ++block)
+	{
+		const uint64_t* const live_in = &allocator->blocks.live_in[(uint64_t)block * words_count];
+		const uint64_t* const live_out = &allocator->blocks.live_out[(uint64_t)block * words_count];
+		const uint32_t start = 2 * allocator->blocks.starts[block];
+		const uint32_t end = get_block_end(allocator, block);
+
+		for (uint32_t word = 0; word < words_count; ++word)
+		{
+			for (uint64_t bits = live_in[word] | live_out[word]; bits != 0; bits &= bits - 1)
+			{
+				const uint32_t vreg = 64 * word + (uint32_t)__builtin_ctzll(bits);
+				range_s* const range = &allocator->ranges[vreg];
+
+				if ((live_in[word] >> (vreg % 64)) & 1) { if (start < range->start) { range->start = start; } }
+				if ((live_out[word] >> (vreg % 64)) & 1) { if (end > range->end) { range->end = end; } }
+			}
+		}
+	}
+}
+
+static void build_occurrences(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t vregs_count = allocator->vregs_count;
+
+	allocator->occurrences.starts = primec_utils_malloc((vregs_count + 1) * sizeof(uint32_t));
+	primec_utils_memset(allocator->occurrences.starts, 0, (vregs_count + 1) * sizeof(uint32_t));
+
+	// NOTE: The instructions are counted first and then filled in, so the
+	//       occurrences of every virtual register stay in the order of the code.
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		for (uint32_t index = 0; index < func->code.count; ++index)
+		{
+			occurrence_s occurrences[max_occurrences] = {0};
+			const uint32_t count = get_occurrences(&func->code.data[index], occurrences);
+
+			for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+			{
+				if (!is_vreg(occurrences[occurrence].reg)) { continue; }
+				const uint32_t vreg = occurrences[occurrence].reg - primec_x86_64_vregs_start;
+
+				if (0 == pass) { ++allocator->occurrences.starts[vreg + 1]; }
+				else { allocator->occurrences.data[allocator->occurrences.starts[vreg]++] = index; }
+			}
+		}
+
+		if (0 == pass)
+		{
+			for (uint32_t vreg = 0; vreg < vregs_count; ++vreg)
+			{
+				allocator->occurrences.starts[vreg + 1] += allocator->occurrences.starts[vreg];
+			}
+
+			const uint32_t total = allocator->occurrences.starts[vregs_count];
+			allocator->occurrences.data = primec_utils_malloc((total > 0 ? total : 1) * sizeof(uint32_t));
+		}
+	}
+
+	// NOTE: The filling has moved every start to the start of the next virtual
+	//       register, so the starts are shifted back.
+	for (uint32_t vreg = vregs_count; vreg > 0; --vreg)
+	{
+		allocator->occurrences.starts[vreg] = allocator->occurrences.starts[vreg - 1];
+	}
+
+	allocator->occurrences.starts[0] = 0;
+}
+
+static void build_fixed_ranges(
+	allocator_s* const allocator)
+{
+	const primec_x86_64_func_s* const func = allocator->func;
+
+	// NOTE: Machine registers never live across the blocks, so their ranges
+	//       are found by a backward walk of every block.
+	for (uint32_t block = 0; block < allocator->blocks.count; ++block)
+	{
+		uint32_t ends[primec_x86_64_regs_count] = {0};
+		uint32_t firsts[primec_x86_64_regs_count] = {0};
+		uint32_t live = 0;
+
+		for (uint32_t reg = 0; reg < primec_x86_64_regs_count; ++reg)
+		{
+			firsts[reg] = allocator->fixed[reg].count;
+		}
+
+		for (uint32_t index = allocator->blocks.ends[block]; index > allocator->blocks.starts[block]; --index)
+		{
+			const primec_x86_64_instruction_s* const instruction = &func->code.data[index - 1];
+			const uint32_t position = 2 * (index - 1);
+
+			occurrence_s occurrences[max_occurrences] = {0};
+			const uint32_t count = get_occurrences(instruction, occurrences);
+			uint32_t uses = instruction->uses;
+			uint32_t defs = instruction->defs;
+
+			for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+			{
+				const uint32_t reg = occurrences[occurrence].reg;
+				if (reg >= primec_x86_64_regs_count) { continue; }
+				if (occurrences[occurrence].is_use) { uses |= 1u << reg; }
+				if (occurrences[occurrence].is_def) { defs |= 1u << reg; }
+			}
+
+			for (uint32_t reg = 0; reg < primec_x86_64_regs_count; ++reg)
+			{
+				if (!((defs >> reg) & 1)) { continue; }
+				add_fixed_range(allocator, reg, position + 1, ((live >> reg) & 1) ? ends[reg] : position + 1);
+				live &= ~(1u << reg);
+			}
+
+			for (uint32_t reg = 0; reg < primec_x86_64_regs_count; ++reg)
+			{
+				if (!((uses >> reg) & 1) || ((live >> reg) & 1)) { continue; }
+				ends[reg] = position;
+				live |= 1u << reg;
+			}
+		}
+
+		for (uint32_t reg = 0; reg < primec_x86_64_regs_count; ++reg)
+		{
+			if ((live >> reg) & 1) { add_fixed_range(allocator, reg, 2 * allocator->blocks.starts[block], ends[reg]); }
+
+			// NOTE: The ranges of the block were found backwards, so they are
+			//       reversed to keep all the ranges sorted.
+			range_s* const ranges = allocator->fixed[reg].data;
+
+			for (uint32_t low = firsts[reg], high = allocator->fixed[reg].count; low + 1 < high; ++low, --high)
+			{
+				const range_s range = ranges[low];
+				ranges[low] = ranges[high - 1];
+				ranges[high - 1] = range;
+			}
+		}
+	}
+}
+
+static void add_fixed_range(
+	allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t start,
+	const uint32_t end)
+{
+	ranges_s* const ranges = &allocator->fixed[reg];
+
+	if (ranges->count >= ranges->capacity)
+	{
+		ranges->capacity = ranges->capacity > 0 ? ranges->capacity * 2 : 16;
+		ranges->data = primec_utils_realloc(ranges->data, ranges->capacity * sizeof(range_s));
+	}
+
+	ranges->data[ranges->count++] = (range_s) { .start = start, .end = end };
+}
+
+static uint32_t get_free_until(
+	const allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t position)
+{
+	const ranges_s* const ranges = &allocator->fixed[reg];
+
+	// NOTE: The ranges are sorted and disjoint, so the first range, that ends
+	//       at or after the position, is the only one to check.
+	uint32_t low = 0;
+	uint32_t high = ranges->count;
+
+	while (low < high)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+		if (ranges->data[middle].end < position) { low = middle + 1; }
+		else { high = middle; }
+	}
+
+	if (low >= ranges->count) { return UINT32_MAX; }
+	return ranges->data[low].start <= position ? position : ranges->data[low].start;
+}
+
+static uint32_t get_next_use(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t index)
+{
+	const uint32_t* const occurrences = allocator->occurrences.data;
+	uint32_t low = allocator->occurrences.starts[vreg];
+	uint32_t high = allocator->occurrences.starts[vreg + 1];
+
+	while (low < high)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+		if (occurrences[middle] < index) { low = middle + 1; }
+		else { high = middle; }
+	}
+
+	return low < allocator->occurrences.starts[vreg + 1] ? 2 * occurrences[low] : UINT32_MAX;
+}
+
+static uint32_t find_block(
+	const allocator_s* const allocator,
+	const uint32_t index)
+{
+	uint32_t low = 0;
+	uint32_t high = allocator->blocks.count;
+
+	while (low + 1 < high)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+		if (allocator->blocks.starts[middle] <= index) { low = middle; }
+		else { high = middle; }
+	}
+
+	return low;
+}
+
+static uint32_t choose_split(
+	const allocator_s* const allocator,
+	const uint32_t start,
+	const uint32_t limit)
+{
+	// NOTE: Splits are made at the even positions only, so the reloads come
+	//       right before the instructions. Block starts before the limit, that
+	//       are in fewer loops, are preferred, as the reload is moved out of the
+	//       loops then.
+	const uint32_t position = limit & ~1u;
+	if (position <= start) { return UINT32_MAX; }
+
+	uint32_t block = find_block(allocator, position / 2);
+	uint32_t chosen = position;
+	uint32_t depth = allocator->blocks.depths[block];
+
+	for (uint32_t count = 0; count < max_split_blocks; ++count)
+	{
+		const uint32_t candidate = 2 * allocator->blocks.starts[block];
+		if (candidate <= start) { break; }
+
+		if (allocator->blocks.depths[block] < depth)
+		{
+			chosen = candidate;
+			depth = allocator->blocks.depths[block];
+		}
+
+		if (0 == block) { break; }
+		--block;
+	}
+
+	return chosen;
+}
+
+static uint32_t add_interval(
+	allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t start,
+	const uint32_t end)
+{
+	if (allocator->intervals.count >= allocator->intervals.capacity)
+	{
+		allocator->intervals.capacity = allocator->intervals.capacity > 0 ? allocator->intervals.capacity * 2 : 64;
+		allocator->intervals.data = primec_utils_realloc(allocator->intervals.data, allocator->intervals.capacity * sizeof(interval_s));
+	}
+
+	allocator->intervals.data[allocator->intervals.count] = (interval_s)
+	{
+		.start = start,
+		.end = end,
+		.vreg = vreg,
+		.reg = spilled,
+		.next = UINT32_MAX
+	};
+
+	return allocator->intervals.count++;
+}
+
+static uint32_t split_interval(
+	allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position)
+{
+	primec_debug_assert(allocator->intervals.data[interval].start < position);
+	primec_debug_assert(position <= allocator->intervals.data[interval].end);
+
+	const interval_s current = allocator->intervals.data[interval];
+	const uint32_t split = add_interval(allocator, current.vreg, position, current.end);
+
+	allocator->intervals.data[split].next = current.next;
+	allocator->intervals.data[interval].end = position - 1;
+	allocator->intervals.data[interval].next = split;
+	return split;
+}
+
+static void spill_until_use(
+	allocator_s* const allocator,
+	const uint32_t interval)
+{
+	// NOTE: The interval is kept in its slot up to its next occurrence, and the
+	//       rest of it gets another chance for a register from there.
+	interval_s* const current = &allocator->intervals.data[interval];
+	current->reg = spilled;
+
+	const uint32_t use = get_next_use(allocator, current->vreg, current->start / 2 + 1);
+	if (UINT32_MAX == use || use > current->end) { return; }
+
+	const uint32_t position = choose_split(allocator, current->start, use);
+	primec_debug_assert(position != UINT32_MAX);
+	push_unhandled(allocator, split_interval(allocator, interval, position));
+}
+
+static bool has_use_before(
+	const allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position)
+{
+	const interval_s* const current = &allocator->intervals.data[interval];
+	return get_next_use(allocator, current->vreg, current->start / 2) < position;
+}
+
+static void assign_until(
+	allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t position)
+{
+	const interval_s* const current = &allocator->intervals.data[interval];
+	const uint32_t* const occurrences = allocator->occurrences.data;
+	uint32_t low = allocator->occurrences.starts[current->vreg];
+	uint32_t high = allocator->occurrences.starts[current->vreg + 1];
+
+	while (low < high)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+		if (2 * occurrences[middle] < position) { low = middle + 1; }
+		else { high = middle; }
+	}
+
+	primec_debug_assert(low > allocator->occurrences.starts[current->vreg]);
+	const uint32_t last = 2 * occurrences[low - 1] + 2;
+
+	// NOTE: The register is kept only up to the last occurrence before the
+	//       split, as a register without uses after it would only have to be
+	//       reloaded at the following block starts.
+	if (last < position) { spill_until_use(allocator, split_interval(allocator, interval, last)); }
+	else { push_unhandled(allocator, split_interval(allocator, interval, position)); }
+}
+
+static void push_unhandled(
+	allocator_s* const allocator,
+	const uint32_t interval)
+{
+	if (allocator->unhandled.count >= allocator->unhandled.capacity)
+	{
+		allocator->unhandled.capacity = allocator->unhandled.capacity > 0 ? allocator->unhandled.capacity * 2 : 64;
+		allocator->unhandled.data = primec_utils_realloc(allocator->unhandled.data, allocator->unhandled.capacity * sizeof(uint32_t));
+	}
+
+	uint32_t* const heap = allocator->unhandled.data;
+	uint32_t index = allocator->unhandled.count++;
+
+	while (index > 0)
+	{
+		const uint32_t parent = (index - 1) / 2;
+		if (!is_before(allocator, interval, heap[parent])) { break; }
+		heap[index] = heap[parent];
+		index = parent;
+	}
+
+	heap[index] = interval;
+}
+
+static uint32_t pop_unhandled(
+	allocator_s* const allocator)
+{
+	primec_debug_assert(allocator->unhandled.count > 0);
+
+	uint32_t* const heap = allocator->unhandled.data;
+	const uint32_t first = heap[0];
+	const uint32_t last = heap[--allocator->unhandled.count];
+	const uint32_t count = allocator->unhandled.count;
+	uint32_t index = 0;
+
+	for (;;)
+	{
+		uint32_t child = 2 * index + 1;
+		if (child >= count) { break; }
+		if (child + 1 < count && is_before(allocator, heap[child + 1], heap[child])) { ++child; }
+		if (!is_before(allocator, heap[child], last)) { break; }
+		heap[index] = heap[child];
+		index = child;
+	}
+
+	if (count > 0) { heap[index] = last; }
+	return first;
+}
+
+static bool is_before(
+	const allocator_s* const allocator,
+	const uint32_t interval,
+	const uint32_t other)
+{
+	const uint32_t start = allocator->intervals.data[interval].start;
+	const uint32_t other_start = allocator->intervals.data[other].start;
+	return start < other_start || (start == other_start && interval < other);
+}
+
+static void allocate(
+	allocator_s* const allocator)
+{
+	const uint32_t vregs_count = allocator->vregs_count;
+	if (0 == vregs_count) { return; }
+
+	for (uint32_t vreg = 0; vreg < vregs_count; ++vreg)
+	{
+		if (UINT32_MAX == allocator->ranges[vreg].start) { continue; }
+		allocator->firsts[vreg] = add_interval(allocator, vreg, allocator->ranges[vreg].start, allocator->ranges[vreg].end);
+		push_unhandled(allocator, allocator->firsts[vreg]);
+	}
+
+	uint32_t active[primec_x86_64_regs_count] = {0};
+	uint32_t active_count = 0;
+
+	while (allocator->unhandled.count > 0)
+	{
+		const uint32_t current = pop_unhandled(allocator);
+		const uint32_t start = allocator->intervals.data[current].start;
+		const uint32_t end = allocator->intervals.data[current].end;
+		const bool is_xmm = is_xmm_vreg(allocator, primec_x86_64_vregs_start + allocator->intervals.data[current].vreg);
+		const uint32_t* const registers = is_xmm ? g_xmms_order : g_gprs_order;
+		const uint32_t registers_count = is_xmm
+			? (uint32_t)(sizeof(g_xmms_order) / sizeof(g_xmms_order[0]))
+			: (uint32_t)(sizeof(g_gprs_order) / sizeof(g_gprs_order[0]));
+
+		uint32_t busy = 0;
+
+		for (uint32_t index = 0; index < active_count;)
+		{
+			if (allocator->intervals.data[active[index]].end < start)
+			{
+				active[index] = active[--active_count];
+				continue;
+			}
+
+			busy |= 1u << allocator->intervals.data[active[index]].reg;
+			++index;
+		}
+
+		// NOTE: The first register, that is free for the whole interval, is taken,
+		//       so the caller-saved registers are still preferred. Otherwise the
+		//       register, that stays free for the longest, holds the interval up
+		//       to a split before its next fixed use (the calls clobber all the
+		//       caller-saved registers, so the intervals are split at them).
+		uint32_t chosen = spilled;
+		uint32_t until = start;
+
+		for (uint32_t candidate = 0; candidate < registers_count; ++candidate)
+		{
+			const uint32_t reg = registers[candidate];
+			if ((busy >> reg) & 1) { continue; }
+
+			const uint32_t free_until = get_free_until(allocator, reg, start);
+			if (free_until > end) { chosen = reg; until = free_until; break; }
+			if (free_until > until) { chosen = reg; until = free_until; }
+		}
+
+		// NOTE: A part of the interval without any occurrence is better left in
+		//       the slot, as its register would only be loaded and dropped.
+		if (chosen != spilled && until <= end)
+		{
+			const uint32_t position = choose_split(allocator, start, until);
+			if (UINT32_MAX == position || !has_use_before(allocator, current, position)) { chosen = spilled; }
+			else { assign_until(allocator, current, position); }
+		}
+
+		if (chosen != spilled)
+		{
+			allocator->intervals.data[current].reg = chosen;
+			active[active_count++] = current;
+			continue;
+		}
+
+		// NOTE: Without a free register, the interval that ends last loses its
+		//       register from here on, as it would block it for the longest time.
+		//       The rest of it waits in its slot for its next occurrence.
+		uint32_t victim = UINT32_MAX;
+
+		for (uint32_t index = 0; index < active_count; ++index)
+		{
+			const interval_s* const other = &allocator->intervals.data[active[index]];
+			if (is_xmm_vreg(allocator, primec_x86_64_vregs_start + other->vreg) != is_xmm) { continue; }
+			if (other->end <= end) { continue; }
+
+			const uint32_t free_until = get_free_until(allocator, other->reg, start);
+			if (free_until <= end && ((free_until & ~1u) <= start ||
+				!has_use_before(allocator, current, choose_split(allocator, start, free_until)))) { continue; }
+			if (UINT32_MAX == victim || other->end > allocator->intervals.data[active[victim]].end) { victim = index; }
+		}
+
+		if (UINT32_MAX == victim)
+		{
+			spill_until_use(allocator, current);
+			continue;
+		}
+
+		const uint32_t other = active[victim];
+		const uint32_t reg = allocator->intervals.data[other].reg;
+		const uint32_t free_until = get_free_until(allocator, reg, start);
+
+		if (free_until <= end)
+		{
+			assign_until(allocator, current, choose_split(allocator, start, free_until));
+		}
+
+		const uint32_t position = start & ~1u;
+
+		if (position > allocator->intervals.data[other].start)
+		{
+			spill_until_use(allocator, split_interval(allocator, other, position));
+		}
+		else
+		{
+			spill_until_use(allocator, other);
+		}
+
+		allocator->intervals.data[current].reg = reg;
+		active[victim] = current;
+	}
+
+	for (uint32_t interval = 0; interval < allocator->intervals.count; ++interval)
+	{
+		const uint32_t reg = allocator->intervals.data[interval].reg;
+		if (reg != spilled && ((g_callee_saved_mask >> reg) & 1)) { allocator->func->saved |= 1u << reg; }
+	}
+}
+
+static void build_chains(
+	allocator_s* const allocator)
+{
+	const uint32_t vregs_count = allocator->vregs_count;
+	const uint32_t total = allocator->intervals.count;
+
+	allocator->chains.starts = primec_utils_malloc((vregs_count + 1) * sizeof(uint32_t));
+	allocator->chains.data = primec_utils_malloc((total > 0 ? total : 1) * sizeof(uint32_t));
+	allocator->chains.starts[0] = 0;
+
+	// NOTE: Every split continues its interval, so following the intervals
+	//       from the first one gives them ordered by their starts.
+	for (uint32_t vreg = 0, count = 0; vreg < vregs_count; ++vreg)
+	{
+		for (uint32_t interval = allocator->firsts[vreg]; interval != UINT32_MAX; interval = allocator->intervals.data[interval].next)
+		{
+			allocator->chains.data[count++] = interval;
+		}
+
+		allocator->chains.starts[vreg + 1] = count;
+	}
+}
+
+static uint32_t find_interval(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const uint32_t position)
+{
+	const uint32_t* const chain = allocator->chains.data;
+	uint32_t low = allocator->chains.starts[vreg];
+	uint32_t high = allocator->chains.starts[vreg + 1];
+	primec_debug_assert(low < high);
+
+	// NOTE: Positions before the first interval (the use position of the first
+	//       definition) belong to the first interval.
+	while (low + 1 < high)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+		if (allocator->intervals.data[chain[middle]].start <= position) { low = middle; }
+		else { high = middle; }
+	}
+
+	return chain[low];
+}
+
+static bool is_split(
+	const allocator_s* const allocator,
+	const uint32_t vreg)
+{
+	return allocator->chains.starts[vreg + 1] - allocator->chains.starts[vreg] > 1;
+}
+
+static bool is_defined_first(
+	const allocator_s* const allocator,
+	const interval_s* const interval)
+{
+	// NOTE: An interval, that starts at an instruction, that only writes it,
+	//       needs no reload.
+	occurrence_s occurrences[max_occurrences] = {0};
+	const uint32_t count = get_occurrences(&allocator->func->code.data[interval->start / 2], occurrences);
+
+	for (uint32_t occurrence = 0; occurrence < count; ++occurrence)
+	{
+		if (primec_x86_64_vregs_start + interval->vreg != occurrences[occurrence].reg) { continue; }
+		return occurrences[occurrence].is_def && !occurrences[occurrence].is_use;
+	}
+
+	return false;
+}
+
+static void build_reloads(
+	allocator_s* const allocator)
+{
+	const uint32_t count = allocator->func->code.count;
+	const uint32_t words_count = allocator->words_count;
+	const uint32_t blocks_count = allocator->blocks.count;
+
+	// NOTE: The predecessors are only needed here, so they are gathered from
+	//       the successors of every block.
+	uint32_t* const predecessors_starts = primec_utils_malloc((blocks_count + 1) * sizeof(uint32_t));
+	uint32_t* const predecessors = primec_utils_malloc((2 * blocks_count + 1) * sizeof(uint32_t));
+	primec_utils_memset(predecessors_starts, 0, (blocks_count + 1) * sizeof(uint32_t));
+
+	for (uint32_t block = 0; block < blocks_count; ++block)
+	{
+		uint32_t successors[2] = {0};
+		const uint32_t successors_count = get_successors(allocator, block, successors);
+		for (uint32_t successor = 0; successor < successors_count; ++successor) { ++predecessors_starts[successors[successor] + 1]; }
+	}
+
+	for (uint32_t block = 0; block < blocks_count; ++block)
+	{
+		predecessors_starts[block + 1] += predecessors_starts[block];
+	}
+
+	for (uint32_t block = 0; block < blocks_count; ++block)
+	{
+		uint32_t successors[2] = {0};
+		const uint32_t successors_count = get_successors(allocator, block, successors);
+		for (uint32_t successor = 0; successor < successors_count; ++successor) { predecessors[predecessors_starts[successors[successor]]++] = block; }
+	}
+
+	for (uint32_t block = blocks_count; block > 0; --block)
+	{
+		predecessors_starts[block] = predecessors_starts[block - 1];
+	}
+
+	predecessors_starts[0] = 0;
+
+	allocator->reloads.starts = primec_utils_malloc((count + 1) * sizeof(uint32_t));
+	primec_utils_memset(allocator->reloads.starts, 0, (count + 1) * sizeof(uint32_t));
+
+	// NOTE: A register is loaded from the slot at the start of every interval,
+	//       that continues a split, and at the block starts, where a live value
+	//       may come from a predecessor, that had it elsewhere. The slots are
+	//       kept up to date by the definitions, so the loads are always valid.
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		for (uint32_t vreg = 0; vreg < allocator->vregs_count; ++vreg)
+		{
+			for (uint32_t entry = allocator->chains.starts[vreg] + 1; entry < allocator->chains.starts[vreg + 1]; ++entry)
+			{
+				const interval_s* const interval = &allocator->intervals.data[allocator->chains.data[entry]];
+				if (spilled == interval->reg || is_defined_first(allocator, interval)) { continue; }
+
+				const uint32_t index = interval->start / 2;
+				if (0 == pass) { ++allocator->reloads.starts[index + 1]; }
+				else { allocator->reloads.data[allocator->reloads.starts[index]++] = allocator->chains.data[entry]; }
+			}
+		}
+
+		for (uint32_t block = 0; block < blocks_count && words_count > 0; ++block)
+		{
+			const uint64_t* const live_in = &allocator->blocks.live_in[(uint64_t)block * words_count];
+			const uint32_t position = 2 * allocator->blocks.starts[block];
+
+			for (uint32_t word = 0; word < words_count; ++word)
+			{
+				for (uint64_t bits = live_in[word]; bits != 0; bits &= bits - 1)
+				{
+					const uint32_t vreg = 64 * word + (uint32_t)__builtin_ctzll(bits);
+					if (!is_split(allocator, vreg)) { continue; }
+
+					const uint32_t interval = find_interval(allocator, vreg, position);
+					const interval_s* const current = &allocator->intervals.data[interval];
+					if (spilled == current->reg) { continue; }
+					if (position == current->start && interval != allocator->firsts[vreg]) { continue; }
+
+					bool is_needed = false;
+
+					for (uint32_t entry = predecessors_starts[block]; entry < predecessors_starts[block + 1] && !is_needed; ++entry)
+					{
+						const uint32_t other = find_interval(allocator, vreg, get_block_end(allocator, predecessors[entry]));
+						is_needed = allocator->intervals.data[other].reg != current->reg;
+					}
+
+					if (!is_needed) { continue; }
+					if (0 == pass) { ++allocator->reloads.starts[position / 2 + 1]; }
+					else { allocator->reloads.data[allocator->reloads.starts[position / 2]++] = interval; }
+				}
+			}
+		}
+
+		if (0 == pass)
+		{
+			for (uint32_t index = 0; index < count; ++index)
+			{
+				allocator->reloads.starts[index + 1] += allocator->reloads.starts[index];
+			}
+
+			const uint32_t total = allocator->reloads.starts[count];
+			allocator->reloads.data = primec_utils_malloc((total > 0 ? total : 1) * sizeof(uint32_t));
+		}
+	}
+
+	for (uint32_t index = count; index > 0; --index)
+	{
+		allocator->reloads.starts[index] = allocator->reloads.starts[index - 1];
+	}
+
+	allocator->reloads.starts[0] = 0;
+	primec_utils_free(predecessors_starts);
+	primec_utils_free(predecessors);
+}
+
+static void rewrite(
+	allocator_s* const allocator)
+{
+	primec_x86_64_func_s* const func = allocator->func;
+	const uint32_t count = func->code.count;
+
+	primec_x86_64_instruction_s* const code = func->code.data;
+	uint32_t capacity = count + count / 2 + 16;
+	primec_x86_64_instruction_s* rewritten = primec_utils_malloc(capacity * sizeof(primec_x86_64_instruction_s));
+	uint32_t rewritten_count = 0;
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const uint32_t reloads_start = allocator->reloads.starts[index];
+		const uint32_t reloads_end = allocator->reloads.starts[index + 1];
+
+		while (rewritten_count + (reloads_end - reloads_start) + 3 * max_occurrences + 2 >= capacity)
+		{
+			capacity *= 2;
+			rewritten = primec_utils_realloc(rewritten, capacity * sizeof(primec_x86_64_instruction_s));
+		}
+
+		primec_x86_64_instruction_s instruction = code[index];
+		const bool is_label = primec_x86_64_op_label == instruction.op;
+
+		// NOTE: The reloads of a block start come after its label, as the jumps
+		//       land there.
+		if (is_label) { rewritten[rewritten_count++] = instruction; }
+
+		for (uint32_t entry = reloads_start; entry < reloads_end; ++entry)
+		{
+			const interval_s* const interval = &allocator->intervals.data[allocator->reloads.data[entry]];
+			const primec_x86_64_operand_s destination = { .kind = primec_x86_64_operand_reg, .reg = interval->reg };
+			rewritten[rewritten_count++] = make_move(allocator, interval->vreg, destination, get_slot(allocator, interval->vreg));
+		}
+
+		if (is_label) { continue; }
+
+		// NOTE: Moves of the spilled registers use their slots directly, and
+		//       the xmm registers are spilled whole, as they may hold vectors.
+		if ((primec_x86_64_op_mov == instruction.op || primec_x86_64_op_movf == instruction.op) && 8 == instruction.size &&
+			primec_x86_64_operand_reg == instruction.operands[0].kind && primec_x86_64_operand_reg == instruction.operands[1].kind)
+		{
+			const uint32_t target = instruction.operands[0].reg;
+			const primec_x86_64_operand_s destination = get_location(allocator, target, index);
+			const primec_x86_64_operand_s source = get_location(allocator, instruction.operands[1].reg, index);
+			if (primec_x86_64_op_movf == instruction.op) { instruction.size = 16; }
+
+			if (primec_x86_64_operand_mem == destination.kind && primec_x86_64_operand_mem == source.kind)
+			{
+				if (destination.value == source.value) { continue; }
+
+				const uint32_t scratch = primec_x86_64_op_movf == instruction.op ? g_xmms_scratch[0] : g_gprs_scratch[0];
+				instruction.operands[0] = (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = scratch };
+				instruction.operands[1] = source;
+				rewritten[rewritten_count++] = instruction;
+				instruction.operands[0] = destination;
+				instruction.operands[1] = rewritten[rewritten_count - 1].operands[0];
+			}
+			else
+			{
+				instruction.operands[0] = destination;
+				instruction.operands[1] = source;
+			}
+
+			rewritten[rewritten_count++] = instruction;
+
+			const uint32_t vreg = target - primec_x86_64_vregs_start;
+
+			if (is_vreg(target) && primec_x86_64_operand_reg == destination.kind && is_split(allocator, vreg) && !is_redefined(allocator, vreg, index))
+			{
+				rewritten[rewritten_count++] = make_move(allocator, vreg, get_slot(allocator, vreg), destination);
+			}
+
+			continue;
+		}
+
+		occurrence_s occurrences[max_occurrences] = {0};
+		const uint32_t occurrences_count = get_occurrences(&instruction, occurrences);
+		uint32_t replacements[max_occurrences] = {0};
+		uint32_t gprs_used = 0;
+		uint32_t xmms_used = 0;
+
+		for (uint32_t occurrence = 0; occurrence < occurrences_count; ++occurrence)
+		{
+			const uint32_t reg = occurrences[occurrence].reg;
+			const primec_x86_64_operand_s location = get_location(allocator, reg, index);
+
+			if (primec_x86_64_operand_reg == location.kind)
+			{
+				replacements[occurrence] = location.reg;
+				continue;
+			}
+
+			// NOTE: Destinations, that are only written, reuse the first scratch
+			//       register, as the sources are already read when it is written.
+			const bool is_xmm = is_xmm_vreg(allocator, reg);
+			uint32_t scratch = is_xmm ? g_xmms_scratch[0] : g_gprs_scratch[0];
+
+			if (occurrences[occurrence].is_use)
+			{
+				primec_debug_assert((is_xmm ? xmms_used : gprs_used) < 2);
+				scratch = is_xmm ? g_xmms_scratch[xmms_used++] : g_gprs_scratch[gprs_used++];
+
+				rewritten[rewritten_count++] = make_move(allocator, reg - primec_x86_64_vregs_start,
+					(primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = scratch }, location);
+			}
+
+			replacements[occurrence] = scratch;
+		}
+
+		for (uint32_t operand = 0; operand < 2; ++operand)
+		{
+			primec_x86_64_operand_s* const current = &instruction.operands[operand];
+			if (current->kind != primec_x86_64_operand_reg && current->kind != primec_x86_64_operand_mem) { continue; }
+
+			for (uint32_t occurrence = 0; occurrence < occurrences_count; ++occurrence)
+			{
+				if (current->reg == occurrences[occurrence].reg) { current->reg = replacements[occurrence]; }
+
+				if (primec_x86_64_operand_mem == current->kind && current->scale != 0 && current->index == occurrences[occurrence].reg)
+				{
+					current->index = replacements[occurrence];
+				}
+			}
+		}
+
+		rewritten[rewritten_count++] = instruction;
+
+		// NOTE: Definitions of the split registers are written through to their
+		//       slots, so every later part of them can be loaded from there.
+		for (uint32_t occurrence = 0; occurrence < occurrences_count; ++occurrence)
+		{
+			const uint32_t reg = occurrences[occurrence].reg;
+			if (!occurrences[occurrence].is_def || !is_vreg(reg)) { continue; }
+
+			const uint32_t vreg = reg - primec_x86_64_vregs_start;
+			const primec_x86_64_operand_s location = get_location(allocator, reg, index);
+			if (primec_x86_64_operand_reg == location.kind && (!is_split(allocator, vreg) || is_redefined(allocator, vreg, index))) { continue; }
+
+			rewritten[rewritten_count++] = make_move(allocator, vreg, get_slot(allocator, vreg),
+				(primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = replacements[occurrence] });
+		}
+	}
+
+	primec_utils_free(func->code.data);
+	func->code.data = rewritten;
+	func->code.capacity = capacity;
+	func->code.count = rewritten_count;
+}
+
+static primec_x86_64_instruction_s make_move(
+	const allocator_s* const allocator,
+	const uint32_t vreg,
+	const primec_x86_64_operand_s destination,
+	const primec_x86_64_operand_s source)
+{
+	const bool is_xmm = is_xmm_vreg(allocator, primec_x86_64_vregs_start + vreg);
+
+	return (primec_x86_64_instruction_s)
+	{
+		.op = is_xmm ? primec_x86_64_op_movf : primec_x86_64_op_mov,
+		.size = is_xmm ? 16 : 8,
+		.operands = { destination, source }
+	};
+}
+
+static primec_x86_64_operand_s get_location(
+	allocator_s* const allocator,
+	const uint32_t reg,
+	const uint32_t index)
+{
+	if (!is_vreg(reg))
+	{
+		return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = reg };
+	}
+
+	// NOTE: Splits are at the even positions only, so the use and the definition
+	//       of an instruction always share their interval.
+	const uint32_t vreg = reg - primec_x86_64_vregs_start;
+	const uint32_t interval = find_interval(allocator, vreg, 2 * index);
+
+	if (allocator->intervals.data[interval].reg != spilled)
+	{
+		return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = allocator->intervals.data[interval].reg };
+	}
+
+	return get_slot(allocator, vreg);
+}
+
+static primec_x86_64_operand_s get_slot(
+	allocator_s* const allocator,
+	const uint32_t vreg)
+{
+	if (0 == allocator->spills[vreg])
+	{
+		primec_x86_64_func_s* const func = allocator->func;
+		func->frame_size = (func->frame_size + 7) / 8 * 8 + (is_xmm_vreg(allocator, primec_x86_64_vregs_start + vreg) ? 16 : 8);
+		allocator->spills[vreg] = func->frame_size;
+	}
+
+	return (primec_x86_64_operand_s)
+	{
+		.kind = primec_x86_64_operand_mem,
+		.reg = primec_x86_64_reg_rbp,
+		.value = -(int64_t)allocator->spills[vreg]
+	};
+}
+
+static bool is_vreg(
+	const uint32_t reg)
+{
+	return reg >= primec_x86_64_vregs_start;
+}
+
+static bool is_xmm_vreg(
+	const allocator_s* const allocator,
+	const uint32_t reg)
+{
+	return primec_x86_64_class_xmm == allocator->func->vregs.data[reg - primec_x86_64_vregs_start];
+}
+
+static uint32_t get_block_end(
+	const allocator_s* const allocator,
+	const uint32_t block)
+{
+	return 2 * allocator->blocks.ends[block] - 1;
+}
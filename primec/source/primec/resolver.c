@@ -0,0 +1,435 @@
+
+/**
+ * @file resolver.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/resolver.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/source_manager.h>
+
+#include <stddef.h>
+
+// NOTE: Initial capacity of a local scope table, most blocks declare only a
+//       handful of names.
+#define scope_initial_capacity 8u
+
+static const char* const g_binding_kind_to_string_map[] =
+{
+	[primec_binding_kind_none] = "none",
+	[primec_binding_kind_module] = "module",
+	[primec_binding_kind_func] = "func",
+	[primec_binding_kind_struct] = "struct",
+	[primec_binding_kind_enum] = "enum",
+	[primec_binding_kind_alias] = "alias",
+	[primec_binding_kind_global] = "global",
+	[primec_binding_kind_param] = "param",
+	[primec_binding_kind_local] = "local",
+	[primec_binding_kind_member] = "member"
+};
+
+_Static_assert(
+	(sizeof(g_binding_kind_to_string_map) / sizeof(g_binding_kind_to_string_map[0])) == primec_binding_kinds_count,
+	"g_binding_kind_to_string_map is not in sync with primec_binding_kind_e enum!"
+);
+
+static uint32_t hash_symbol(
+	const primec_symbol_t symbol);
+
+static primec_binding_s* find_module_binding(
+	const primec_module_scope_s* const scope,
+	const primec_symbol_t symbol);
+
+static void declare_module_binding(
+	primec_module_scope_s* const scope,
+	const primec_binding_s binding);
+
+static primec_scope_slot_s* find_slot(
+	primec_scope_slot_s* const slots,
+	const uint32_t capacity,
+	const primec_symbol_t symbol);
+
+static void reserve_slots(
+	primec_resolver_s* const resolver,
+	const uint32_t count);
+
+static void grow_scope(
+	primec_resolver_s* const resolver,
+	primec_scope_s* const scope);
+
+const char* primec_binding_kind_to_string(
+	const primec_binding_kind_e kind)
+{
+	primec_debug_assert(kind < primec_binding_kinds_count);
+	return g_binding_kind_to_string_map[kind];
+}
+
+primec_module_scope_s primec_module_scope_from_module(
+	primec_symbols_s* const symbols,
+	const primec_module_s* const module,
+	primec_diagnostics_s* const diagnostics)
+{
+	primec_debug_assert(symbols != NULL);
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(diagnostics != NULL);
+	const primec_ast_s* const ast = &module->ast;
+
+	primec_module_scope_s scope =
+	{
+		.module = module->index,
+		.ast = ast,
+		.tokens = primec_utils_malloc(ast->tokens.count * sizeof(primec_symbol_t)),
+	};
+
+	primec_symbols_intern_ast(symbols, ast, scope.tokens);
+
+	const primec_ast_range_s declarations = primec_ast_get_list(ast, ast->root);
+	uint32_t capacity = 16;
+	while (capacity < 2 * (declarations.end - declarations.start)) { capacity *= 2; }
+	scope.bindings.capacity = capacity;
+	scope.bindings.data = primec_utils_malloc(capacity * sizeof(primec_binding_s));
+	primec_utils_memset(scope.bindings.data, 0, capacity * sizeof(primec_binding_s));
+
+	for (primec_ast_index_t extra = declarations.start; extra < declarations.end; ++extra)
+	{
+		const primec_ast_index_t index = primec_ast_get_extra(ast, extra);
+		const primec_ast_node_s* const node = primec_ast_get_node(ast, index);
+
+		primec_binding_s binding =
+		{
+			.symbol = scope.tokens[node->token],
+			.module = module->index,
+			.node = index
+		};
+
+		switch (node->kind)
+		{
+			case primec_ast_kind_func_decl:   { binding.kind = primec_binding_kind_func;   } break;
+			case primec_ast_kind_struct_decl: { binding.kind = primec_binding_kind_struct; } break;
+			case primec_ast_kind_enum_decl:   { binding.kind = primec_binding_kind_enum;   } break;
+			case primec_ast_kind_alias_decl:  { binding.kind = primec_binding_kind_alias;  } break;
+			case primec_ast_kind_let_decl:    { binding.kind = primec_binding_kind_global; } break;
+
+			case primec_ast_kind_use_decl:
+			{
+				// NOTE: The module is bound by the last component of its path,
+				//       i.e. `use lib::math;` declares `math`.
+				binding.kind = primec_binding_kind_module;
+				binding.symbol = scope.tokens[node->rhs];
+				binding.module = (uint32_t)-1;
+
+				for (uint32_t import = 0; import < module->imports.count; ++import)
+				{
+					if (module->imports.data[import].token == node->token)
+					{
+						binding.module = module->imports.data[import].module;
+						break;
+					}
+				}
+
+				// NOTE: The build graph keeps only the first `use` of a module.
+				if ((uint32_t)-1 == binding.module)
+				{
+					primec_diagnostics_report(diagnostics, primec_ast_get_node_token(ast, index)->location,
+						"module `%s` is already imported.", primec_symbols_get_text(symbols, binding.symbol)
+					);
+					continue;
+				}
+			} break;
+
+			default:
+			{
+				primec_debug_assert(0);
+			} break;
+		}
+
+		const primec_binding_s* const previous = find_module_binding(&scope, binding.symbol);
+
+		if (previous != NULL)
+		{
+			const primec_location_s location = primec_ast_get_node_token(ast, index)->location;
+			const primec_location_s previous_location = primec_ast_get_node_token(ast, previous->node)->location;
+			primec_diagnostics_report(diagnostics, location, "symbol `%s` is already declared -- previous declaration at " primec_location_fmt ".",
+				primec_symbols_get_text(symbols, binding.symbol), primec_location_arg(previous_location)
+			);
+			continue;
+		}
+
+		declare_module_binding(&scope, binding);
+	}
+
+	return scope;
+}
+
+void primec_module_scope_destroy(
+	primec_module_scope_s* const scope)
+{
+	primec_debug_assert(scope != NULL);
+	primec_utils_free(scope->tokens);
+	primec_utils_free(scope->bindings.data);
+	*scope = (primec_module_scope_s) {0};
+}
+
+const primec_binding_s* primec_module_scope_find(
+	const primec_module_scope_s* const scope,
+	const primec_symbol_t symbol)
+{
+	primec_debug_assert(scope != NULL);
+	return find_module_binding(scope, symbol);
+}
+
+primec_resolver_s primec_resolver_from_parts(
+	const primec_module_scope_s* const modules,
+	const uint32_t module,
+	const uint32_t runtime)
+{
+	primec_debug_assert(modules != NULL);
+
+	// NOTE: The runtime itself has no runtime to fall back to.
+	primec_resolver_s resolver =
+	{
+		.modules = modules,
+		.module = &modules[module],
+		.runtime = UINT32_MAX == runtime || runtime == module ? NULL : &modules[runtime]
+	};
+
+	resolver.slots.capacity = 256;
+	resolver.slots.data = primec_utils_malloc(resolver.slots.capacity * sizeof(primec_scope_slot_s));
+	resolver.scopes.capacity = 32;
+	resolver.scopes.data = primec_utils_malloc(resolver.scopes.capacity * sizeof(primec_scope_s));
+	resolver.bindings.capacity = 64;
+	resolver.bindings.data = primec_utils_malloc(resolver.bindings.capacity * sizeof(primec_binding_s));
+	return resolver;
+}
+
+void primec_resolver_destroy(
+	primec_resolver_s* const resolver)
+{
+	primec_debug_assert(resolver != NULL);
+	primec_utils_free(resolver->slots.data);
+	primec_utils_free(resolver->scopes.data);
+	primec_utils_free(resolver->bindings.data);
+	*resolver = (primec_resolver_s) {0};
+}
+
+void primec_resolver_push_scope(
+	primec_resolver_s* const resolver)
+{
+	primec_debug_assert(resolver != NULL);
+
+	if (resolver->scopes.count >= resolver->scopes.capacity)
+	{
+		resolver->scopes.capacity *= 2;
+		resolver->scopes.data = primec_utils_realloc(resolver->scopes.data, resolver->scopes.capacity * sizeof(primec_scope_s));
+	}
+
+	reserve_slots(resolver, scope_initial_capacity);
+	primec_utils_memset(&resolver->slots.data[resolver->slots.count], 0, scope_initial_capacity * sizeof(primec_scope_slot_s));
+
+	resolver->scopes.data[resolver->scopes.count++] = (primec_scope_s)
+	{
+		.start = resolver->slots.count,
+		.capacity = scope_initial_capacity,
+		.count = 0,
+		.bindings = resolver->bindings.count
+	};
+
+	resolver->slots.count += scope_initial_capacity;
+}
+
+void primec_resolver_pop_scope(
+	primec_resolver_s* const resolver)
+{
+	primec_debug_assert(resolver != NULL);
+	primec_debug_assert(resolver->scopes.count > 0);
+	const primec_scope_s* const scope = &resolver->scopes.data[--resolver->scopes.count];
+	resolver->slots.count = scope->start;
+	resolver->bindings.count = scope->bindings;
+}
+
+const primec_binding_s* primec_resolver_declare(
+	primec_resolver_s* const resolver,
+	const primec_binding_s binding)
+{
+	primec_debug_assert(resolver != NULL);
+	primec_debug_assert(resolver->scopes.count > 0);
+	primec_debug_assert(binding.symbol != primec_symbol_null);
+	primec_scope_s* const scope = &resolver->scopes.data[resolver->scopes.count - 1];
+
+	if (2 * (scope->count + 1) > scope->capacity)
+	{
+		grow_scope(resolver, scope);
+	}
+
+	primec_scope_slot_s* const slot = find_slot(&resolver->slots.data[scope->start], scope->capacity, binding.symbol);
+
+	if (slot->symbol != primec_symbol_null)
+	{
+		return &resolver->bindings.data[slot->binding];
+	}
+
+	if (resolver->bindings.count >= resolver->bindings.capacity)
+	{
+		resolver->bindings.capacity *= 2;
+		resolver->bindings.data = primec_utils_realloc(resolver->bindings.data, resolver->bindings.capacity * sizeof(primec_binding_s));
+	}
+
+	*slot = (primec_scope_slot_s) { .symbol = binding.symbol, .binding = resolver->bindings.count };
+	resolver->bindings.data[resolver->bindings.count++] = binding;
+	++scope->count;
+	return NULL;
+}
+
+const primec_binding_s* primec_resolver_find(
+	const primec_resolver_s* const resolver,
+	const primec_symbol_t symbol)
+{
+	primec_debug_assert(resolver != NULL);
+
+	for (uint32_t index = resolver->scopes.count; index > 0; --index)
+	{
+		const primec_scope_s* const scope = &resolver->scopes.data[index - 1];
+		if (0 == scope->count) { continue; }
+		const primec_scope_slot_s* const slot = find_slot(&resolver->slots.data[scope->start], scope->capacity, symbol);
+
+		if (slot->symbol != primec_symbol_null)
+		{
+			return &resolver->bindings.data[slot->binding];
+		}
+	}
+
+	const primec_binding_s* const binding = find_module_binding(resolver->module, symbol);
+	if (binding != NULL || NULL == resolver->runtime) { return binding; }
+
+	// NOTE: The imports of the runtime are not visible in the other modules.
+	const primec_binding_s* const fallback = find_module_binding(resolver->runtime, symbol);
+	return NULL == fallback || primec_binding_kind_module == fallback->kind ? NULL : fallback;
+}
+
+const primec_binding_s* primec_resolver_find_in_module(
+	const primec_resolver_s* const resolver,
+	const uint32_t module,
+	const primec_symbol_t symbol)
+{
+	primec_debug_assert(resolver != NULL);
+	const primec_binding_s* const binding = find_module_binding(&resolver->modules[module], symbol);
+	return NULL == binding || primec_binding_kind_module == binding->kind ? NULL : binding;
+}
+
+primec_symbol_t primec_resolver_get_symbol(
+	const primec_resolver_s* const resolver,
+	const uint32_t token)
+{
+	primec_debug_assert(resolver != NULL);
+	primec_debug_assert(token < resolver->module->ast->tokens.count);
+	return resolver->module->tokens[token];
+}
+
+static uint32_t hash_symbol(
+	const primec_symbol_t symbol)
+{
+	// NOTE: Symbols are dense ids, so the multiplicative hash spreads them well.
+	return (uint32_t)((symbol * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static primec_binding_s* find_module_binding(
+	const primec_module_scope_s* const scope,
+	const primec_symbol_t symbol)
+{
+	primec_debug_assert(scope != NULL);
+	primec_debug_assert(scope->bindings.capacity > 0);
+	const uint32_t mask = scope->bindings.capacity - 1;
+	uint32_t index = hash_symbol(symbol) & mask;
+
+	while (scope->bindings.data[index].symbol != primec_symbol_null)
+	{
+		if (scope->bindings.data[index].symbol == symbol)
+		{
+			return &scope->bindings.data[index];
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return NULL;
+}
+
+static void declare_module_binding(
+	primec_module_scope_s* const scope,
+	const primec_binding_s binding)
+{
+	primec_debug_assert(2 * (scope->bindings.count + 1) <= scope->bindings.capacity);
+	const uint32_t mask = scope->bindings.capacity - 1;
+	uint32_t index = hash_symbol(binding.symbol) & mask;
+
+	while (scope->bindings.data[index].symbol != primec_symbol_null)
+	{
+		index = (index + 1) & mask;
+	}
+
+	scope->bindings.data[index] = binding;
+	++scope->bindings.count;
+}
+
+static primec_scope_slot_s* find_slot(
+	primec_scope_slot_s* const slots,
+	const uint32_t capacity,
+	const primec_symbol_t symbol)
+{
+	const uint32_t mask = capacity - 1;
+	uint32_t index = hash_symbol(symbol) & mask;
+
+	while (slots[index].symbol != primec_symbol_null && slots[index].symbol != symbol)
+	{
+		index = (index + 1) & mask;
+	}
+
+	return &slots[index];
+}
+
+static void reserve_slots(
+	primec_resolver_s* const resolver,
+	const uint32_t count)
+{
+	if (resolver->slots.count + count > resolver->slots.capacity)
+	{
+		while (resolver->slots.count + count > resolver->slots.capacity) { resolver->slots.capacity *= 2; }
+		resolver->slots.data = primec_utils_realloc(resolver->slots.data, resolver->slots.capacity * sizeof(primec_scope_slot_s));
+	}
+}
+
+static void grow_scope(
+	primec_resolver_s* const resolver,
+	primec_scope_s* const scope)
+{
+	primec_debug_assert(scope->start + scope->capacity == resolver->slots.count);
+
+	// NOTE: The innermost scope is always at the top of the arena, so it grows
+	//       in place: its slots are copied past the grown table, and reinserted.
+	const uint32_t capacity = scope->capacity * 2;
+	reserve_slots(resolver, capacity);
+	primec_scope_slot_s* const slots = &resolver->slots.data[scope->start];
+	primec_scope_slot_s* const old_slots = &slots[capacity];
+	primec_utils_memcpy(old_slots, slots, scope->capacity * sizeof(primec_scope_slot_s));
+	primec_utils_memset(slots, 0, capacity * sizeof(primec_scope_slot_s));
+
+	for (uint32_t index = 0; index < scope->capacity; ++index)
+	{
+		if (old_slots[index].symbol != primec_symbol_null)
+		{
+			*find_slot(slots, capacity, old_slots[index].symbol) = old_slots[index];
+		}
+	}
+
+	scope->capacity = capacity;
+	resolver->slots.count = scope->start + capacity;
+}
@@ -0,0 +1,212 @@
+
+/**
+ * @file runtime.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/runtime.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <string.h>
+
+// NOTE: The source is kept line by line, as a single literal would exceed the
+//       length the C standard guarantees.
+static const char* const g_runtime_lines[] =
+{
+	"// NOTE: The system calls go through the syscall stub, which takes the number",
+	"//       of the call first and its arguments after it.",
+	"ext func syscall(number: i64, a: i64, b: i64, c: i64, d: i64, e: i64, f: i64) -> i64;",
+	"",
+	"func sys_read(fd: i32, data: *mut u8, length: u64) -> i64 {",
+	"\treturn syscall(0, fd as i64, data as i64, length as i64, 0, 0, 0);",
+	"}",
+	"",
+	"func sys_write(fd: i32, data: *u8, length: u64) -> i64 {",
+	"\treturn syscall(1, fd as i64, data as i64, length as i64, 0, 0, 0);",
+	"}",
+	"",
+	"func sys_mmap(address: *u8, length: u64, protection: i32, flags: i32, fd: i32, offset: i64) -> *mut u8 {",
+	"\treturn syscall(9, address as i64, length as i64, protection as i64, flags as i64, fd as i64, offset) as *mut u8;",
+	"}",
+	"",
+	"func sys_exit(status: i32) {",
+	"\tsyscall(60, status as i64, 0, 0, 0, 0, 0);",
+	"}",
+	"",
+	"// NOTE: The standard output is buffered, and the buffer is flushed when it is",
+	"//       full and once the entry function returns.",
+	"let stdout_buffer: mut [u8, 4096];",
+	"let stdout_count: mut u64 = 0;",
+	"",
+	"func flush() {",
+	"\tlet offset: mut u64 = 0;",
+	"",
+	"\twhile offset < stdout_count {",
+	"\t\tlet written = sys_write(1, &stdout_buffer[offset], stdout_count - offset);",
+	"\t\tif written <= 0 { break; }",
+	"\t\toffset += written as u64;",
+	"\t}",
+	"",
+	"\tstdout_count = 0;",
+	"}",
+	"",
+	"func print(text: &[c8]) {",
+	"\tlet index: mut u64 = 0;",
+	"",
+	"\twhile index < text.count {",
+	"\t\tif stdout_count == 4096 { flush(); }",
+	"\t\tlet count: mut u64 = stdout_count;",
+	"\t\tlet end: mut u64 = index + 4096 - count;",
+	"\t\tif end > text.count { end = text.count; }",
+	"",
+	"\t\twhile index < end {",
+	"\t\t\tstdout_buffer[count] = text[index] as u8;",
+	"\t\t\tcount += 1;",
+	"\t\t\tindex += 1;",
+	"\t\t}",
+	"",
+	"\t\tstdout_count = count;",
+	"\t}",
+	"}",
+	"",
+	"func print_c8(value: c8) {",
+	"\tif stdout_count == 4096 { flush(); }",
+	"\tstdout_buffer[stdout_count] = value as u8;",
+	"\tstdout_count += 1;",
+	"}",
+	"",
+	"// NOTE: The digits are produced from the lowest one, so they are written to",
+	"//       the end of a scratch buffer, and copied out in the reading order.",
+	"func print_u64(value: u64) {",
+	"\tif stdout_count > 4096 - 20 { flush(); }",
+	"\tlet digits: mut [u8, 20];",
+	"\tlet first: mut u64 = 20;",
+	"\tlet rest: mut u64 = value;",
+	"",
+	"\twhile first == 20 || rest != 0 {",
+	"\t\tfirst -= 1;",
+	"\t\tdigits[first] = (rest % 10) as u8 + 48;",
+	"\t\trest /= 10;",
+	"\t}",
+	"",
+	"\tlet count: mut u64 = stdout_count;",
+	"",
+	"\twhile first < 20 {",
+	"\t\tstdout_buffer[count] = digits[first];",
+	"\t\tcount += 1;",
+	"\t\tfirst += 1;",
+	"\t}",
+	"",
+	"\tstdout_count = count;",
+	"}",
+	"",
+	"func print_i64(value: i64) {",
+	"\tif value < 0 {",
+	"\t\tprint_c8('-');",
+	"\t\tprint_u64(0 - value as u64);",
+	"\t\treturn;",
+	"\t}",
+	"",
+	"\tprint_u64(value as u64);",
+	"}",
+	"",
+	"func print_u32(value: u32) {",
+	"\tprint_u64(value as u64);",
+	"}",
+	"",
+	"func print_i32(value: i32) {",
+	"\tprint_i64(value as i64);",
+	"}",
+	"",
+	"// NOTE: Floats are printed with six decimals, as the %f of the C library, but",
+	"//       the values too large for u64 are printed with an exponent.",
+	"func print_f64(value: f64) {",
+	"\tif value != value {",
+	"\t\tprint(\"nan\");",
+	"\t\treturn;",
+	"\t}",
+	"",
+	"\tlet magnitude: mut f64 = value;",
+	"",
+	"\tif value < 0.0 {",
+	"\t\tprint_c8('-');",
+	"\t\tmagnitude = -value;",
+	"\t}",
+	"",
+	"\tif magnitude > 1.7976931348623157e308 {",
+	"\t\tprint(\"inf\");",
+	"\t\treturn;",
+	"\t}",
+	"",
+	"\tlet exponent: mut i32 = 0;",
+	"",
+	"\tif magnitude >= 1.0e19 {",
+	"\t\twhile magnitude >= 10.0 {",
+	"\t\t\tmagnitude /= 10.0;",
+	"\t\t\texponent += 1;",
+	"\t\t}",
+	"\t}",
+	"",
+	"\tlet whole: mut u64 = magnitude as u64;",
+	"\tlet fraction: mut u64 = ((magnitude - whole as f64) * 1000000.0 + 0.5) as u64;",
+	"",
+	"\tif fraction >= 1000000 {",
+	"\t\twhole += 1;",
+	"\t\tfraction -= 1000000;",
+	"\t}",
+	"",
+	"\tprint_u64(whole);",
+	"\tprint_c8('.');",
+	"\tlet scale: mut u64 = 100000;",
+	"",
+	"\twhile scale > 0 {",
+	"\t\tprint_c8((((fraction / scale) % 10) as u8 + 48) as c8);",
+	"\t\tscale /= 10;",
+	"\t}",
+	"",
+	"\tif exponent > 0 {",
+	"\t\tprint(\"e+\");",
+	"\t\tprint_i32(exponent);",
+	"\t}",
+	"}",
+	"",
+	"func print_f32(value: f32) {",
+	"\tprint_f64(value as f64);",
+	"}",
+};
+
+void primec_runtime_add(
+	primec_build_graph_s* const graph)
+{
+	primec_debug_assert(graph != NULL);
+	const uint32_t lines_count = (uint32_t)(sizeof(g_runtime_lines) / sizeof(g_runtime_lines[0]));
+	uint64_t length = 0;
+
+	for (uint32_t index = 0; index < lines_count; ++index)
+	{
+		length += strlen(g_runtime_lines[index]) + 1;
+	}
+
+	char* const text = primec_utils_malloc(length);
+	uint64_t offset = 0;
+
+	for (uint32_t index = 0; index < lines_count; ++index)
+	{
+		const uint64_t line_length = strlen(g_runtime_lines[index]);
+		if (line_length > 0) { primec_utils_memcpy(text + offset, g_runtime_lines[index], line_length); }
+		text[offset + line_length] = '\n';
+		offset += line_length + 1;
+	}
+
+	primec_build_graph_add_runtime(graph, primec_runtime_path, text, (uint32_t)length);
+	primec_utils_free(text);
+}
@@ -0,0 +1,925 @@
+
+/**
+ * @file sccp.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/sccp.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/layout.h>
+
+#include <stddef.h>
+#include <math.h>
+
+typedef enum
+{
+	lattice_undefined,	// not computed by any executable block yet
+	lattice_constant,
+	lattice_unknown,
+} lattice_e;
+
+typedef enum
+{
+	class_other,
+	class_integer,
+	class_f32,
+	class_f64,
+} class_e;
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	const primec_type_table_s* types;
+	primec_ir_func_s* func;
+
+	uint8_t* states;				// lattice of every value
+	uint64_t* constants;			// bits of the constant values, normalized to their types
+	primec_ir_block_t* blocks;		// block of every value
+	uint8_t* edges;					// executable edges of every block, a bit by the index of the successor
+	bool* is_executable;
+
+	uint32_t* users_starts;			// users of every value
+	primec_ir_value_t* users;
+	primec_ir_value_t user;			// instruction, whose operands are being visited
+	primec_ir_value_t* replacements;
+
+	list_s blocks_worklist;
+	list_s values_worklist;
+	list_s others;					// instructions of the rewritten block, that are not phis
+} propagator_s;
+
+static void propagate_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func);
+
+static void build_users(
+	propagator_s* const propagator);
+
+static void count_user(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void add_user(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void visit(
+	propagator_s* const propagator,
+	const primec_ir_value_t value);
+
+static void visit_phi(
+	propagator_s* const propagator,
+	const primec_ir_value_t value);
+
+static void visit_branch(
+	propagator_s* const propagator,
+	const primec_ir_value_t value);
+
+static void visit_computation(
+	propagator_s* const propagator,
+	const primec_ir_value_t value);
+
+static void mark_edge(
+	propagator_s* const propagator,
+	const primec_ir_block_t block,
+	const uint32_t index);
+
+static bool is_edge_executable(
+	const propagator_s* const propagator,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to);
+
+static void set_state(
+	propagator_s* const propagator,
+	const primec_ir_value_t value,
+	lattice_e state,
+	const uint64_t bits);
+
+static bool fold(
+	const propagator_s* const propagator,
+	const primec_ir_instruction_s* const instruction,
+	uint64_t* const result);
+
+static bool fold_integer(
+	const primec_type_table_s* const types,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const primec_type_t operand,
+	const uint64_t left,
+	const uint64_t right,
+	uint64_t* const result);
+
+static bool fold_float(
+	const primec_ir_op_e op,
+	const bool is_wide,
+	const uint64_t left,
+	const uint64_t right,
+	uint64_t* const result);
+
+static bool fold_convert(
+	const primec_type_table_s* const types,
+	const primec_type_t from,
+	const primec_type_t to,
+	const uint64_t bits,
+	uint64_t* const result);
+
+static void rewrite(
+	propagator_s* const propagator);
+
+static void remove_dead_entries(
+	propagator_s* const propagator,
+	const primec_ir_value_t value);
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static bool is_folded(
+	const primec_ir_op_e op);
+
+static class_e get_class(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint64_t normalize(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint64_t bits);
+
+static double to_double(
+	const uint64_t bits);
+
+static uint64_t from_double(
+	const double value);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_sccp_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		propagate_func(program->types, func);
+	}
+}
+
+static void propagate_func(
+	const primec_type_table_s* const types,
+	primec_ir_func_s* const func)
+{
+	const uint32_t values_count = func->instructions.count;
+	const uint32_t blocks_count = func->blocks.count;
+
+	propagator_s propagator =
+	{
+		.types = types,
+		.func = func,
+		.states = primec_utils_malloc(values_count * sizeof(uint8_t)),
+		.constants = primec_utils_malloc(values_count * sizeof(uint64_t)),
+		.blocks = primec_utils_malloc(values_count * sizeof(primec_ir_block_t)),
+		.edges = primec_utils_malloc(blocks_count * sizeof(uint8_t)),
+		.is_executable = primec_utils_malloc(blocks_count * sizeof(bool)),
+		.users_starts = primec_utils_malloc((values_count + 1) * sizeof(uint32_t)),
+		.replacements = primec_utils_malloc(values_count * sizeof(primec_ir_value_t))
+	};
+
+	primec_utils_memset(propagator.states, lattice_undefined, values_count * sizeof(uint8_t));
+	primec_utils_memset(propagator.constants, 0, values_count * sizeof(uint64_t));
+	primec_utils_memset(propagator.edges, 0, blocks_count * sizeof(uint8_t));
+	primec_utils_memset(propagator.is_executable, 0, blocks_count * sizeof(bool));
+	primec_utils_memset(propagator.replacements, 0, values_count * sizeof(primec_ir_value_t));
+	build_users(&propagator);
+
+	propagator.is_executable[0] = true;
+	push(&propagator.blocks_worklist, 0);
+
+	// NOTE: Blocks are visited once, when they become executable, while the
+	//       users of the lowered values (and the phis of the blocks, that get
+	//       new executable edges) are visited again.
+	while (propagator.blocks_worklist.count > 0 || propagator.values_worklist.count > 0)
+	{
+		while (propagator.blocks_worklist.count > 0)
+		{
+			const primec_ir_block_t block = propagator.blocks_worklist.data[--propagator.blocks_worklist.count];
+			const primec_ir_block_s* const record = &func->blocks.data[block];
+
+			for (uint32_t index = 0; index < record->instructions.count; ++index)
+			{
+				visit(&propagator, record->instructions.data[index]);
+			}
+		}
+
+		while (propagator.values_worklist.count > 0)
+		{
+			const primec_ir_value_t value = propagator.values_worklist.data[--propagator.values_worklist.count];
+
+			for (uint32_t index = propagator.users_starts[value]; index < propagator.users_starts[value + 1]; ++index)
+			{
+				const primec_ir_value_t user = propagator.users[index];
+				if (propagator.is_executable[propagator.blocks[user]]) { visit(&propagator, user); }
+			}
+		}
+	}
+
+	rewrite(&propagator);
+
+	primec_utils_free(propagator.states);
+	primec_utils_free(propagator.constants);
+	primec_utils_free(propagator.blocks);
+	primec_utils_free(propagator.edges);
+	primec_utils_free(propagator.is_executable);
+	primec_utils_free(propagator.users_starts);
+	primec_utils_free(propagator.users);
+	primec_utils_free(propagator.replacements);
+	primec_utils_free(propagator.blocks_worklist.data);
+	primec_utils_free(propagator.values_worklist.data);
+	primec_utils_free(propagator.others.data);
+}
+
+static void build_users(
+	propagator_s* const propagator)
+{
+	primec_ir_func_s* const func = propagator->func;
+	const uint32_t values_count = func->instructions.count;
+	primec_utils_memset(propagator->users_starts, 0, (values_count + 1) * sizeof(uint32_t));
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			propagator->blocks[record->instructions.data[index]] = block;
+			primec_ir_func_visit_operands(func, record->instructions.data[index], count_user, propagator);
+		}
+	}
+
+	for (uint32_t value = 0; value < values_count; ++value)
+	{
+		propagator->users_starts[value + 1] += propagator->users_starts[value];
+	}
+
+	propagator->users = primec_utils_malloc((propagator->users_starts[values_count] + 1) * sizeof(primec_ir_value_t));
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			propagator->user = record->instructions.data[index];
+			primec_ir_func_visit_operands(func, propagator->user, add_user, propagator);
+		}
+	}
+
+	// NOTE: The starts were moved to the ends of the lists by the filling, so
+	//       they are moved back.
+	for (uint32_t value = values_count; value > 0; --value)
+	{
+		propagator->users_starts[value] = propagator->users_starts[value - 1];
+	}
+
+	propagator->users_starts[0] = 0;
+}
+
+static void count_user(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	propagator_s* const propagator = context;
+	++propagator->users_starts[*operand + 1];
+}
+
+static void add_user(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	propagator_s* const propagator = context;
+	propagator->users[propagator->users_starts[*operand]++] = propagator->user;
+}
+
+static void visit(
+	propagator_s* const propagator,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(propagator->func, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_store:
+		case primec_ir_op_copy:
+		case primec_ir_op_zero:
+		case primec_ir_op_check:
+		case primec_ir_op_ret:
+		case primec_ir_op_unreachable:
+		{
+		} break;
+
+		case primec_ir_op_const:
+		{
+			set_state(propagator, value, lattice_constant, normalize(propagator->types, instruction->type, primec_ir_get_const(instruction).uval));
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			visit_phi(propagator, value);
+		} break;
+
+		case primec_ir_op_jump:
+		{
+			mark_edge(propagator, propagator->blocks[value], 0);
+		} break;
+
+		case primec_ir_op_branch:
+		{
+			visit_branch(propagator, value);
+		} break;
+
+		default:
+		{
+			if (is_folded(instruction->op)) { visit_computation(propagator, value); }
+			else { set_state(propagator, value, lattice_unknown, 0); }
+		} break;
+	}
+}
+
+static void visit_phi(
+	propagator_s* const propagator,
+	const primec_ir_value_t value)
+{
+	const primec_ir_func_s* const func = propagator->func;
+	const primec_ir_block_t block = propagator->blocks[value];
+
+	uint32_t count = 0;
+	const uint32_t* const pairs = primec_ir_func_get_list(func, primec_ir_func_get(func, value)->a, &count);
+	lattice_e state = lattice_undefined;
+	uint64_t bits = 0;
+
+	for (uint32_t index = 0; index < count; index += 2)
+	{
+		const primec_ir_value_t incoming = pairs[index + 1];
+		if (!is_edge_executable(propagator, pairs[index], block) || lattice_undefined == propagator->states[incoming]) { continue; }
+
+		if (lattice_unknown == propagator->states[incoming] || (lattice_constant == state && bits != propagator->constants[incoming]))
+		{
+			state = lattice_unknown;
+			break;
+		}
+
+		state = lattice_constant;
+		bits = propagator->constants[incoming];
+	}
+
+	set_state(propagator, value, state, bits);
+}
+
+static void visit_branch(
+	propagator_s* const propagator,
+	const primec_ir_value_t value)
+{
+	const primec_ir_block_t block = propagator->blocks[value];
+	const primec_ir_value_t condition = primec_ir_func_get(propagator->func, value)->a;
+	primec_ir_block_t successors[2] = {0};
+	const uint32_t count = primec_ir_block_get_successors(propagator->func, block, successors);
+
+	switch ((lattice_e)propagator->states[condition])
+	{
+		case lattice_undefined:
+		{
+		} break;
+
+		case lattice_constant:
+		{
+			mark_edge(propagator, block, 0 == propagator->constants[condition] && 2 == count ? 1 : 0);
+		} break;
+
+		case lattice_unknown:
+		{
+			for (uint32_t index = 0; index < count; ++index) { mark_edge(propagator, block, index); }
+		} break;
+	}
+}
+
+static void visit_computation(
+	propagator_s* const propagator,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(propagator->func, value);
+	const bool is_unary = primec_ir_op_neg == instruction->op || primec_ir_op_not == instruction->op || primec_ir_op_convert == instruction->op;
+	const lattice_e left = propagator->states[instruction->a];
+	const lattice_e right = is_unary ? lattice_constant : propagator->states[instruction->b];
+
+	if (lattice_undefined == left || lattice_undefined == right) { return; }
+
+	uint64_t bits = 0;
+	const bool is_constant = lattice_constant == left && lattice_constant == right && fold(propagator, instruction, &bits);
+	set_state(propagator, value, is_constant ? lattice_constant : lattice_unknown, bits);
+}
+
+static void mark_edge(
+	propagator_s* const propagator,
+	const primec_ir_block_t block,
+	const uint32_t index)
+{
+	const uint8_t bit = (uint8_t)(1u << index);
+	if (propagator->edges[block] & bit) { return; }
+	propagator->edges[block] |= bit;
+
+	primec_ir_block_t successors[2] = {0};
+	(void)primec_ir_block_get_successors(propagator->func, block, successors);
+	const primec_ir_block_t target = successors[index];
+
+	if (!propagator->is_executable[target])
+	{
+		propagator->is_executable[target] = true;
+		push(&propagator->blocks_worklist, target);
+		return;
+	}
+
+	// NOTE: The other instructions of the target were visited already, only
+	//       its phis see the new edge.
+	const primec_ir_block_s* const record = &propagator->func->blocks.data[target];
+
+	for (uint32_t position = 0; position < record->instructions.count; ++position)
+	{
+		const primec_ir_value_t value = record->instructions.data[position];
+		if (primec_ir_op_phi == primec_ir_func_get(propagator->func, value)->op) { visit_phi(propagator, value); }
+	}
+}
+
+static bool is_edge_executable(
+	const propagator_s* const propagator,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to)
+{
+	primec_ir_block_t successors[2] = {0};
+	const uint32_t count = primec_ir_block_get_successors(propagator->func, from, successors);
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		if (successors[index] == to && (propagator->edges[from] & (1u << index))) { return true; }
+	}
+
+	return false;
+}
+
+static void set_state(
+	propagator_s* const propagator,
+	const primec_ir_value_t value,
+	lattice_e state,
+	const uint64_t bits)
+{
+	const lattice_e previous = propagator->states[value];
+	if (lattice_unknown == previous || (state == previous && (state != lattice_constant || bits == propagator->constants[value]))) { return; }
+
+	// NOTE: Values are only ever lowered, so two different constants make the
+	//       value unknown.
+	if (lattice_constant == previous && lattice_constant == state) { state = lattice_unknown; }
+	if (state < previous) { return; }
+
+	propagator->states[value] = (uint8_t)state;
+	propagator->constants[value] = bits;
+	push(&propagator->values_worklist, value);
+}
+
+static bool fold(
+	const propagator_s* const propagator,
+	const primec_ir_instruction_s* const instruction,
+	uint64_t* const result)
+{
+	const primec_type_table_s* const types = propagator->types;
+	const primec_type_t operand = primec_ir_func_get(propagator->func, instruction->a)->type;
+	const uint64_t left = propagator->constants[instruction->a];
+
+	if (primec_ir_op_convert == instruction->op)
+	{
+		return fold_convert(types, operand, instruction->type, left, result);
+	}
+
+	const bool is_unary = primec_ir_op_neg == instruction->op || primec_ir_op_not == instruction->op;
+	const uint64_t right = is_unary ? 0 : propagator->constants[instruction->b];
+
+	switch (get_class(types, operand))
+	{
+		case class_integer: { return fold_integer(types, instruction->op, instruction->type, operand, left, right, result); } break;
+		case class_f32: { return fold_float(instruction->op, false, left, right, result); } break;
+		case class_f64: { return fold_float(instruction->op, true, left, right, result); } break;
+		case class_other: { return false; } break;
+	}
+
+	return false;
+}
+
+static bool fold_integer(
+	const primec_type_table_s* const types,
+	const primec_ir_op_e op,
+	const primec_type_t type,
+	const primec_type_t operand,
+	const uint64_t left,
+	const uint64_t right,
+	uint64_t* const result)
+{
+	const bool is_signed = primec_type_is_signed(types, get_scalar(types, operand));
+	const uint64_t mask = 8 == get_size(types, type) ? 63 : 31;
+	uint64_t value = 0;
+
+	switch (op)
+	{
+		case primec_ir_op_add: { value = left + right; } break;
+		case primec_ir_op_sub: { value = left - right; } break;
+		case primec_ir_op_mul: { value = left * right; } break;
+		case primec_ir_op_neg: { value = 0 - left; } break;
+		case primec_ir_op_and: { value = left & right; } break;
+		case primec_ir_op_or: { value = left | right; } break;
+		case primec_ir_op_xor: { value = left ^ right; } break;
+		case primec_ir_op_not: { value = ~left; } break;
+		case primec_ir_op_shl: { value = left << (right & mask); } break;
+		case primec_ir_op_shr: { value = is_signed ? (uint64_t)((int64_t)left >> (right & mask)) : left >> (right & mask); } break;
+		case primec_ir_op_eq: { value = left == right; } break;
+		case primec_ir_op_ne: { value = left != right; } break;
+		case primec_ir_op_lt: { value = is_signed ? (int64_t)left < (int64_t)right : left < right; } break;
+		case primec_ir_op_le: { value = is_signed ? (int64_t)left <= (int64_t)right : left <= right; } break;
+		case primec_ir_op_gt: { value = is_signed ? (int64_t)left > (int64_t)right : left > right; } break;
+		case primec_ir_op_ge: { value = is_signed ? (int64_t)left >= (int64_t)right : left >= right; } break;
+
+		case primec_ir_op_div:
+		case primec_ir_op_rem:
+		{
+			// NOTE: The divisions by zero trap, and so do the signed divisions and
+			//       remainders of the minimal value by minus one on every backend,
+			//       so the divisions by these divisors are left to the runtime.
+			if (0 == right || (is_signed && UINT64_MAX == right)) { return false; }
+
+			if (primec_ir_op_div == op) { value = is_signed ? (uint64_t)((int64_t)left / (int64_t)right) : left / right; }
+			else { value = is_signed ? (uint64_t)((int64_t)left % (int64_t)right) : left % right; }
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+
+	*result = normalize(types, type, value);
+	return true;
+}
+
+static bool fold_float(
+	const primec_ir_op_e op,
+	const bool is_wide,
+	const uint64_t left,
+	const uint64_t right,
+	uint64_t* const result)
+{
+	const double x = to_double(left);
+	const double y = to_double(right);
+
+	switch (op)
+	{
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			// NOTE: The comparisons of the nans are left to the backends, which
+			//       order their operands on their own.
+			if (isnan(x) || isnan(y)) { return false; }
+			*result = primec_ir_op_eq == op ? x == y : primec_ir_op_ne == op ? x != y : primec_ir_op_lt == op ? x < y :
+				primec_ir_op_le == op ? x <= y : primec_ir_op_gt == op ? x > y : x >= y;
+			return true;
+		} break;
+
+		case primec_ir_op_add:
+		{
+			*result = from_double(is_wide ? x + y : (double)((float)x + (float)y));
+			return true;
+		} break;
+
+		case primec_ir_op_sub:
+		{
+			*result = from_double(is_wide ? x - y : (double)((float)x - (float)y));
+			return true;
+		} break;
+
+		case primec_ir_op_mul:
+		{
+			*result = from_double(is_wide ? x * y : (double)((float)x * (float)y));
+			return true;
+		} break;
+
+		case primec_ir_op_div:
+		{
+			*result = from_double(is_wide ? x / y : (double)((float)x / (float)y));
+			return true;
+		} break;
+
+		case primec_ir_op_neg:
+		{
+			*result = from_double(-x);
+			return true;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static bool fold_convert(
+	const primec_type_table_s* const types,
+	const primec_type_t from,
+	const primec_type_t to,
+	const uint64_t bits,
+	uint64_t* const result)
+{
+	const class_e from_class = get_class(types, from);
+	const class_e to_class = get_class(types, to);
+	if (class_other == from_class || class_other == to_class) { return false; }
+
+	const bool is_from_signed = primec_type_is_signed(types, get_scalar(types, from));
+	const bool is_to_signed = primec_type_is_signed(types, get_scalar(types, to));
+
+	if (class_integer == from_class && class_integer == to_class)
+	{
+		*result = normalize(types, to, bits);
+	}
+	else if (class_integer == from_class)
+	{
+		// NOTE: The integers are rounded straight to the narrow floats, as the
+		//       rounding through the wide ones could differ.
+		if (class_f32 == to_class) { *result = from_double((double)(is_from_signed ? (float)(int64_t)bits : (float)bits)); }
+		else { *result = from_double(is_from_signed ? (double)(int64_t)bits : (double)bits); }
+	}
+	else if (class_integer == to_class)
+	{
+		// NOTE: Only the floats, that fit the integer type, are converted, as the
+		//       others trap at run time.
+		const double value = to_double(bits);
+		const uint32_t width = 8 * get_size(types, to);
+		if (isnan(value)) { return false; }
+
+		if (is_to_signed)
+		{
+			const double limit = (double)(UINT64_C(1) << (width - 1));
+			if (!(value > -limit && value < limit)) { return false; }
+			*result = normalize(types, to, (uint64_t)(int64_t)value);
+		}
+		else
+		{
+			const double limit = 2.0 * (double)(UINT64_C(1) << (width - 1));
+			if (!(value > -1.0 && value < limit)) { return false; }
+			*result = normalize(types, to, (uint64_t)value);
+		}
+	}
+	else
+	{
+		const double value = to_double(bits);
+		*result = from_double(class_f32 == to_class ? (double)(float)value : value);
+	}
+
+	return true;
+}
+
+static void rewrite(
+	propagator_s* const propagator)
+{
+	primec_ir_func_s* const func = propagator->func;
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+
+		// NOTE: The blocks, that are never executed, keep no uses of the values,
+		//       so the other passes do not have to look at them.
+		if (!propagator->is_executable[block])
+		{
+			record->instructions.count = 0;
+			(void)primec_ir_func_add(func, block, primec_ir_op_unreachable, primec_type_void, 0, 0);
+			continue;
+		}
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			if (lattice_constant == propagator->states[value] && (is_folded(instruction->op) || primec_ir_op_phi == instruction->op))
+			{
+				instruction->op = primec_ir_op_const;
+				instruction->a = (uint32_t)propagator->constants[value];
+				instruction->b = (uint32_t)(propagator->constants[value] >> 32);
+			}
+			else if (primec_ir_op_phi == instruction->op)
+			{
+				remove_dead_entries(propagator, value);
+			}
+		}
+	}
+
+	// NOTE: The executable edges are kept by the indices of the successors of
+	//       the original terminators, so the branches are folded only after all
+	//       the phis dropped the entries of the dead edges.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+		if (!propagator->is_executable[block] || 0 == record->instructions.count) { continue; }
+
+		primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+
+		if (primec_ir_op_branch == instruction->op && lattice_constant == propagator->states[instruction->a])
+		{
+			uint32_t count = 0;
+			const uint32_t* const targets = primec_ir_func_get_list(func, instruction->b, &count);
+			instruction->op = primec_ir_op_jump;
+			instruction->a = targets[0 == propagator->constants[instruction->a] ? 1 : 0];
+			instruction->b = 0;
+		}
+	}
+
+	// NOTE: The phis, that were folded or lost all their entries but one, are
+	//       taken out of their blocks, and the phis are kept in front of the
+	//       other instructions.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		primec_ir_block_s* const record = &func->blocks.data[block];
+		uint32_t phis_count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			primec_ir_func_visit_operands(func, value, replace, propagator);
+			if (primec_ir_op_phi == primec_ir_func_get(func, value)->op) { ++phis_count; }
+		}
+
+		uint32_t phis_position = 0;
+		propagator->others.count = 0;
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_op_e op = primec_ir_func_get(func, value)->op;
+			if (primec_ir_op_nop == op) { continue; }
+			if (primec_ir_op_phi == op) { record->instructions.data[phis_position++] = value; }
+			else { push(&propagator->others, value); }
+		}
+
+		primec_utils_memcpy(record->instructions.data + phis_count, propagator->others.data, propagator->others.count * sizeof(primec_ir_value_t));
+		record->instructions.count = phis_count + propagator->others.count;
+	}
+}
+
+static void remove_dead_entries(
+	propagator_s* const propagator,
+	const primec_ir_value_t value)
+{
+	primec_ir_func_s* const func = propagator->func;
+	primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+	const primec_ir_block_t block = propagator->blocks[value];
+
+	uint32_t count = 0;
+	uint32_t* const pairs = primec_ir_func_get_list(func, instruction->a, &count);
+	uint32_t kept = 0;
+
+	for (uint32_t index = 0; index < count; index += 2)
+	{
+		if (!is_edge_executable(propagator, pairs[index], block)) { continue; }
+		pairs[kept] = pairs[index];
+		pairs[kept + 1] = pairs[index + 1];
+		kept += 2;
+	}
+
+	func->extra.data[instruction->a] = kept;
+
+	if (2 == kept && pairs[1] != value)
+	{
+		propagator->replacements[value] = pairs[1];
+		instruction->op = primec_ir_op_nop;
+	}
+}
+
+static void replace(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	const propagator_s* const propagator = context;
+	while (propagator->replacements[*operand] != primec_ir_null) { *operand = propagator->replacements[*operand]; }
+}
+
+static bool is_folded(
+	const primec_ir_op_e op)
+{
+	return (op >= primec_ir_op_add && op <= primec_ir_op_ge) || primec_ir_op_convert == op;
+}
+
+static class_e get_class(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	switch (primec_type_table_get(types, get_scalar(types, type))->kind)
+	{
+		case primec_type_kind_bool:
+		case primec_type_kind_i8:
+		case primec_type_kind_i16:
+		case primec_type_kind_i32:
+		case primec_type_kind_i64:
+		case primec_type_kind_u8:
+		case primec_type_kind_u16:
+		case primec_type_kind_u32:
+		case primec_type_kind_u64:
+		case primec_type_kind_c8:
+		{
+			return class_integer;
+		} break;
+
+		case primec_type_kind_f32: { return class_f32; } break;
+		case primec_type_kind_f64: { return class_f64; } break;
+		default: { return class_other; } break;
+	}
+}
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	return primec_type_kind_enum == record->kind ? record->element : type;
+}
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const uint64_t size = primec_layout_get(types, type).size;
+	return size > 8 ? 8 : 0 == size ? 1 : (uint32_t)size;
+}
+
+static uint64_t normalize(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const uint64_t bits)
+{
+	if (get_class(types, type) != class_integer) { return bits; }
+	const uint32_t shift = 64 - 8 * get_size(types, type);
+	return primec_type_is_signed(types, get_scalar(types, type)) ? (uint64_t)((int64_t)(bits << shift) >> shift) : (bits << shift) >> shift;
+}
+
+static double to_double(
+	const uint64_t bits)
+{
+	primec_const_value_s value = {0};
+	value.uval = bits;
+	return value.fval;
+}
+
+static uint64_t from_double(
+	const double value)
+{
+	primec_const_value_s result = {0};
+	result.fval = value;
+	return result.uval;
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
@@ -0,0 +1,2809 @@
+
+/**
+ * @file sema.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/sema.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/source_manager.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#define report_error(_checker, _node, _format, ...)                            \
+	primec_diagnostics_report((_checker)->diagnostics,                         \
+		primec_ast_get_node_token((_checker)->ast, _node)->location,           \
+		_format, ## __VA_ARGS__)
+
+#define type_buffer_capacity 128
+
+typedef enum
+{
+	state_unresolved,
+	state_resolving,
+	state_resolved,
+} state_e;
+
+typedef struct
+{
+	primec_sema_s* sema;
+	primec_sema_module_s* module;
+	uint32_t module_index;
+	const primec_ast_s* ast;
+	primec_resolver_s resolver;
+	primec_diagnostics_s* diagnostics;
+	primec_type_t return_type;
+	uint32_t loops;
+	uint32_t breaks;
+	uint32_t barrier;
+
+	struct
+	{
+		primec_ast_index_t* data;
+		uint32_t capacity;
+		uint32_t count;
+	} chain;						// binary nodes of the left-deep chains being checked
+} checker_s;
+
+typedef struct
+{
+	primec_sema_s* sema;
+	uint32_t module;
+	primec_ast_index_t node;
+	primec_diagnostics_s diagnostics;
+} body_task_s;
+
+static checker_s checker_from_parts(
+	primec_sema_s* const sema,
+	const uint32_t module,
+	primec_diagnostics_s* const diagnostics);
+
+static void checker_destroy(
+	checker_s* const checker);
+
+static primec_sema_node_s* get_node(
+	const checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_symbol_t get_symbol(
+	const checker_s* const checker,
+	const uint32_t token);
+
+static const char* format_type(
+	const checker_s* const checker,
+	const primec_type_t type,
+	char* const buffer);
+
+static void declare_module_stage(
+	primec_module_s* const module,
+	void* const context);
+
+static void check_body_task(
+	void* const context);
+
+static primec_type_t ensure_declaration(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t get_declaration_type(
+	checker_s* const checker,
+	const primec_binding_s* const binding);
+
+static primec_type_t resolve_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	bool* const is_mutable);
+
+static primec_type_t resolve_proto(
+	checker_s* const checker,
+	const primec_ast_index_t extra);
+
+static void resolve_struct(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void resolve_enum(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t resolve_global(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void declare_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_ast_index_t initializer);
+
+static void check_function(
+	checker_s* const checker,
+	const primec_ast_index_t proto,
+	const primec_ast_index_t body);
+
+static void declare_local(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_binding_kind_e kind);
+
+static primec_type_t check_block(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static bool is_statement(
+	const primec_ast_kind_e kind);
+
+static void check_statement(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void check_let(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void check_if(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void check_condition(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_expression(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_value(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t to_value(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type);
+
+static primec_type_t fold_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type);
+
+static void expect_expression(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected);
+
+static void expect_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected);
+
+static bool coerce(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected);
+
+static void finalize_untyped(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type);
+
+static void retype_untyped(
+	checker_s* const checker,
+	primec_ast_index_t node,
+	const primec_type_t type);
+
+static primec_ast_index_t retype_untyped_node(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type);
+
+static primec_type_t default_untyped(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t set_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type,
+	const uint8_t flags);
+
+static bool set_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_const_status_e status,
+	const primec_const_value_s value);
+
+static bool is_constant(
+	const checker_s* const checker,
+	const primec_ast_index_t node);
+
+static void copy_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const uint32_t module,
+	const primec_ast_index_t declaration);
+
+static bool is_scalar(
+	const checker_s* const checker,
+	const primec_type_t type);
+
+static primec_type_t check_literal(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_identifier(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_scope(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t bind_value(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_binding_s* const binding);
+
+static primec_type_t check_unary(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t unify_operands(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_ast_index_t left,
+	const primec_ast_index_t right);
+
+static primec_type_t check_binary_chain(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_binary(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t left);
+
+static primec_type_t check_assign(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_cast(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_call(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_index(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_member(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_address_of(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_deref(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static primec_type_t check_lambda(
+	checker_s* const checker,
+	const primec_ast_index_t node);
+
+static bool is_numeric(
+	const checker_s* const checker,
+	const primec_type_t type);
+
+static bool is_untyped(
+	const primec_type_t type);
+
+static uint8_t get_kind(
+	const checker_s* const checker,
+	const primec_type_t type);
+
+static primec_type_t get_element(
+	const checker_s* const checker,
+	const primec_type_t type);
+
+static bool is_mutable_reference(
+	const checker_s* const checker,
+	const primec_type_t type);
+
+primec_sema_s* primec_sema_create(
+	primec_build_graph_s* const graph)
+{
+	primec_debug_assert(graph != NULL);
+	primec_sema_s* const sema = primec_utils_malloc(sizeof(primec_sema_s));
+	primec_utils_memset((void*)sema, 0, sizeof(primec_sema_s));
+	sema->graph = graph;
+	sema->types = primec_type_table_create();
+	sema->symbols = primec_symbols_create();
+
+	const uint32_t count = graph->modules.count;
+	sema->scopes = primec_utils_malloc((count > 0 ? count : 1) * sizeof(primec_module_scope_s));
+	sema->modules = primec_utils_malloc((count > 0 ? count : 1) * sizeof(primec_sema_module_s));
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const primec_module_s* const module = graph->modules.data[index];
+		const uint32_t nodes_count = module->ast.nodes.count;
+		sema->scopes[index] = (primec_module_scope_s) {0};
+
+		sema->modules[index] = (primec_sema_module_s)
+		{
+			.module = module,
+			.nodes = primec_utils_malloc(nodes_count * sizeof(primec_sema_node_s)),
+			.states = primec_utils_malloc(nodes_count * sizeof(uint8_t)),
+			.values = primec_utils_malloc(nodes_count * sizeof(primec_const_value_s))
+		};
+
+		primec_utils_memset(sema->modules[index].nodes, 0, nodes_count * sizeof(primec_sema_node_s));
+		primec_utils_memset(sema->modules[index].states, state_unresolved, nodes_count * sizeof(uint8_t));
+	}
+
+	return sema;
+}
+
+void primec_sema_destroy(
+	primec_sema_s* const sema)
+{
+	primec_debug_assert(sema != NULL);
+
+	for (uint32_t index = 0; index < sema->graph->modules.count; ++index)
+	{
+		primec_module_scope_destroy(&sema->scopes[index]);
+		primec_utils_free(sema->modules[index].nodes);
+		primec_utils_free(sema->modules[index].states);
+		primec_utils_free(sema->modules[index].values);
+		primec_diagnostics_destroy(&sema->modules[index].diagnostics);
+	}
+
+	primec_utils_free(sema->scopes);
+	primec_utils_free(sema->modules);
+	primec_symbols_destroy(sema->symbols);
+	primec_type_table_destroy(sema->types);
+	primec_utils_free(sema);
+}
+
+void primec_sema_check(
+	primec_sema_s* const sema)
+{
+	primec_debug_assert(sema != NULL);
+	primec_build_graph_s* const graph = sema->graph;
+	uint32_t errors_count = 0;
+
+	// NOTE: The first phase resolves the declarations of every module after the
+	//       modules it imports, so the signatures it refers to are known.
+	primec_build_graph_schedule(graph, declare_module_stage, sema);
+
+	for (uint32_t index = 0; index < graph->order.count; ++index)
+	{
+		errors_count += primec_diagnostics_flush(&sema->modules[graph->order.data[index]].diagnostics);
+	}
+
+	if (errors_count > 0)
+	{
+		exit(-1);
+	}
+
+	uint32_t tasks_count = 0;
+
+	for (uint32_t index = 0; index < graph->modules.count; ++index)
+	{
+		const primec_ast_s* const ast = &graph->modules.data[index]->ast;
+		const primec_ast_range_s declarations = primec_ast_get_list(ast, ast->root);
+
+		for (primec_ast_index_t extra = declarations.start; extra < declarations.end; ++extra)
+		{
+			const primec_ast_node_s* const node = primec_ast_get_node(ast, primec_ast_get_extra(ast, extra));
+			if (primec_ast_kind_func_decl == node->kind && node->rhs != primec_ast_null) { ++tasks_count; }
+		}
+	}
+
+	// NOTE: The second phase checks every function body as a separate task, the
+	//       tasks are laid out in the order of the modules and of the functions
+	//       in them, which is also the order the errors are logged in.
+	body_task_s* const tasks = primec_utils_malloc((tasks_count > 0 ? tasks_count : 1) * sizeof(body_task_s));
+	primec_thread_pool_group_s group = {0};
+	uint32_t task = 0;
+
+	for (uint32_t index = 0; index < graph->order.count; ++index)
+	{
+		const uint32_t module = graph->order.data[index];
+		const primec_ast_s* const ast = &graph->modules.data[module]->ast;
+		const primec_ast_range_s declarations = primec_ast_get_list(ast, ast->root);
+
+		for (primec_ast_index_t extra = declarations.start; extra < declarations.end; ++extra)
+		{
+			const primec_ast_index_t node = primec_ast_get_extra(ast, extra);
+			const primec_ast_node_s* const declaration = primec_ast_get_node(ast, node);
+			if (primec_ast_kind_func_decl != declaration->kind || primec_ast_null == declaration->rhs) { continue; }
+
+			tasks[task] = (body_task_s)
+			{
+				.sema = sema,
+				.module = module,
+				.node = node
+			};
+
+			primec_thread_pool_submit(graph->pool, &group, check_body_task, &tasks[task]);
+			++task;
+		}
+	}
+
+	primec_thread_pool_wait(graph->pool, &group);
+
+	for (uint32_t index = 0; index < tasks_count; ++index)
+	{
+		errors_count += primec_diagnostics_flush(&tasks[index].diagnostics);
+		primec_diagnostics_destroy(&tasks[index].diagnostics);
+	}
+
+	primec_utils_free(tasks);
+
+	if (errors_count > 0)
+	{
+		exit(-1);
+	}
+}
+
+const primec_sema_node_s* primec_sema_get_node(
+	const primec_sema_s* const sema,
+	const uint32_t module,
+	const primec_ast_index_t node)
+{
+	primec_debug_assert(sema != NULL);
+	primec_debug_assert(module < sema->graph->modules.count);
+	primec_debug_assert(node < sema->modules[module].module->ast.nodes.count);
+	return &sema->modules[module].nodes[node];
+}
+
+primec_const_value_s primec_sema_get_value(
+	const primec_sema_s* const sema,
+	const uint32_t module,
+	const primec_ast_index_t node)
+{
+	primec_debug_assert(sema != NULL);
+	primec_debug_assert(module < sema->graph->modules.count);
+	primec_debug_assert(sema->modules[module].nodes[node].flags & primec_sema_flag_constant);
+	return sema->modules[module].values[node];
+}
+
+static checker_s checker_from_parts(
+	primec_sema_s* const sema,
+	const uint32_t module,
+	primec_diagnostics_s* const diagnostics)
+{
+	return (checker_s)
+	{
+		.sema = sema,
+		.module = &sema->modules[module],
+		.module_index = module,
+		.ast = &sema->modules[module].module->ast,
+		.resolver = primec_resolver_from_parts(sema->scopes, module, sema->graph->runtime),
+		.diagnostics = diagnostics,
+		.return_type = primec_type_void
+	};
+}
+
+static void checker_destroy(
+	checker_s* const checker)
+{
+	primec_debug_assert(checker != NULL);
+	primec_resolver_destroy(&checker->resolver);
+	primec_utils_free(checker->chain.data);
+}
+
+static primec_sema_node_s* get_node(
+	const checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	primec_debug_assert(node < checker->ast->nodes.count);
+	return &checker->module->nodes[node];
+}
+
+static primec_symbol_t get_symbol(
+	const checker_s* const checker,
+	const uint32_t token)
+{
+	return primec_resolver_get_symbol(&checker->resolver, token);
+}
+
+static const char* format_type(
+	const checker_s* const checker,
+	const primec_type_t type,
+	char* const buffer)
+{
+	return primec_type_table_format(checker->sema->types, type, buffer, type_buffer_capacity);
+}
+
+static void declare_module_stage(
+	primec_module_s* const module,
+	void* const context)
+{
+	primec_sema_s* const sema = (primec_sema_s*)context;
+	primec_debug_assert(sema != NULL);
+	primec_sema_module_s* const sema_module = &sema->modules[module->index];
+	sema->scopes[module->index] = primec_module_scope_from_module(sema->symbols, module, &sema_module->diagnostics);
+
+	checker_s checker = checker_from_parts(sema, module->index, &sema_module->diagnostics);
+	const primec_ast_range_s declarations = primec_ast_get_list(checker.ast, checker.ast->root);
+
+	for (primec_ast_index_t extra = declarations.start; extra < declarations.end; ++extra)
+	{
+		(void)ensure_declaration(&checker, primec_ast_get_extra(checker.ast, extra));
+	}
+
+	checker_destroy(&checker);
+}
+
+static void check_body_task(
+	void* const context)
+{
+	body_task_s* const task = (body_task_s*)context;
+	primec_debug_assert(task != NULL);
+	checker_s checker = checker_from_parts(task->sema, task->module, &task->diagnostics);
+	const primec_ast_node_s* const node = primec_ast_get_node(checker.ast, task->node);
+	check_function(&checker, node->lhs, node->rhs);
+	checker_destroy(&checker);
+}
+
+static primec_type_t ensure_declaration(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+	const uint8_t state = checker->module->states[node];
+
+	if (state_resolved == state)
+	{
+		return info->type;
+	}
+
+	if (state_resolving == state)
+	{
+		report_error(checker, node, "declaration of `%s` depends on itself.",
+			primec_symbols_get_text(checker->sema->symbols, get_symbol(checker, primec_ast_get_node(checker->ast, node)->token))
+		);
+
+		return primec_type_error;
+	}
+
+	checker->module->states[node] = state_resolving;
+	const primec_ast_node_s* const declaration = primec_ast_get_node(checker->ast, node);
+
+	switch (declaration->kind)
+	{
+		case primec_ast_kind_func_decl:
+		{
+			info->type = resolve_proto(checker, declaration->lhs);
+		} break;
+
+		case primec_ast_kind_struct_decl:
+		{
+			resolve_struct(checker, node);
+		} break;
+
+		case primec_ast_kind_enum_decl:
+		{
+			resolve_enum(checker, node);
+		} break;
+
+		case primec_ast_kind_alias_decl:
+		{
+			info->type = resolve_type(checker, declaration->lhs, NULL);
+		} break;
+
+		case primec_ast_kind_let_decl:
+		{
+			info->type = resolve_global(checker, node);
+		} break;
+
+		default:
+		{
+			info->type = primec_type_void;
+		} break;
+	}
+
+	info->target = info->type;
+	checker->module->states[node] = state_resolved;
+	return info->type;
+}
+
+static primec_type_t get_declaration_type(
+	checker_s* const checker,
+	const primec_binding_s* const binding)
+{
+	if (binding->module == checker->module_index)
+	{
+		// NOTE: Locals are resolved when they are declared, and module-level
+		//       declarations are resolved lazily during the first phase, so the
+		//       declarations may refer to the ones declared later.
+		if (primec_binding_kind_local == binding->kind || primec_binding_kind_param == binding->kind)
+		{
+			return get_node(checker, binding->node)->type;
+		}
+
+		return ensure_declaration(checker, binding->node);
+	}
+
+	// NOTE: Imported modules are fully resolved before their importers.
+	const primec_sema_module_s* const module = &checker->sema->modules[binding->module];
+	primec_debug_assert(state_resolved == module->states[binding->node]);
+	return module->nodes[binding->node].type;
+}
+
+static primec_type_t resolve_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	bool* const is_mutable)
+{
+	const primec_ast_node_s* const type = primec_ast_get_node(checker->ast, node);
+	primec_type_table_s* const types = checker->sema->types;
+	primec_type_t result = primec_type_error;
+
+	switch (type->kind)
+	{
+		case primec_ast_kind_type_name:
+		{
+			const primec_token_s* const token = primec_ast_get_token(checker->ast, type->token);
+
+			if (token->type != primec_token_type_identifier)
+			{
+				result = primec_type_table_get_primitive((primec_token_type_e)token->type);
+				break;
+			}
+
+			const primec_symbol_t symbol = get_symbol(checker, type->token);
+			const primec_binding_s* const binding = primec_resolver_find(&checker->resolver, symbol);
+
+			if (NULL == binding)
+			{
+				report_error(checker, node, "unknown type `%s`.", primec_symbols_get_text(checker->sema->symbols, symbol));
+				break;
+			}
+
+			if (binding->kind != primec_binding_kind_struct && binding->kind != primec_binding_kind_enum &&
+				binding->kind != primec_binding_kind_alias)
+			{
+				report_error(checker, node, "`%s` is not a type.", primec_symbols_get_text(checker->sema->symbols, symbol));
+				break;
+			}
+
+			result = get_declaration_type(checker, binding);
+		} break;
+
+		case primec_ast_kind_type_mut:
+		{
+			if (NULL == is_mutable)
+			{
+				report_error(checker, node, "`mut` is only allowed on the type of a variable.");
+				break;
+			}
+
+			*is_mutable = true;
+			result = resolve_type(checker, type->lhs, NULL);
+		} break;
+
+		case primec_ast_kind_type_reference:
+		case primec_ast_kind_type_pointer:
+		{
+			const primec_ast_node_s* const pointee = primec_ast_get_node(checker->ast, type->lhs);
+			primec_type_t element = primec_type_error;
+
+			// NOTE: Slices are unsized, so they exist only behind references and
+			//       pointers.
+			if (primec_ast_kind_type_slice == pointee->kind)
+			{
+				element = primec_type_table_get_slice(types, resolve_type(checker, pointee->lhs, NULL));
+			}
+			else
+			{
+				element = resolve_type(checker, type->lhs, NULL);
+			}
+
+			if (primec_type_error == element) { break; }
+
+			result = primec_ast_kind_type_reference == type->kind
+				? primec_type_table_get_reference(types, element, type->rhs != 0)
+				: primec_type_table_get_pointer(types, element, type->rhs != 0);
+		} break;
+
+		case primec_ast_kind_type_array:
+		{
+			const primec_type_t element = resolve_type(checker, type->lhs, NULL);
+			const primec_type_t size = check_value(checker, type->rhs);
+
+			if (primec_type_error == size)
+			{
+				break;
+			}
+
+			if (!primec_type_is_integer(types, size) || !is_constant(checker, type->rhs))
+			{
+				report_error(checker, type->rhs, "array size must be a constant integer expression.");
+				break;
+			}
+
+			// NOTE: Untyped sizes must fit into u64, typed ones must not be negative.
+			finalize_untyped(checker, type->rhs, primec_type_u64);
+			const primec_const_value_s count = checker->module->values[type->rhs];
+
+			if (primec_type_is_signed(types, get_node(checker, type->rhs)->type) && count.ival < 0)
+			{
+				report_error(checker, type->rhs, "array size must not be negative.");
+				break;
+			}
+
+			result = primec_type_error == element ? element : primec_type_table_get_array(types, element, count.uval);
+		} break;
+
+		case primec_ast_kind_type_slice:
+		{
+			report_error(checker, node, "slice type must be behind a reference or a pointer.");
+		} break;
+
+		case primec_ast_kind_type_func:
+		{
+			result = resolve_proto(checker, type->lhs);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	get_node(checker, node)->type = result;
+	get_node(checker, node)->target = result;
+	return result;
+}
+
+static primec_type_t resolve_proto(
+	checker_s* const checker,
+	const primec_ast_index_t extra)
+{
+	const primec_ast_proto_s proto = primec_ast_get_proto(checker->ast, extra);
+	const uint32_t params_count = proto.params.end - proto.params.start;
+	primec_type_t* const params = primec_utils_malloc((params_count > 0 ? params_count : 1) * sizeof(primec_type_t));
+	bool has_errors = false;
+
+	for (uint32_t index = 0; index < params_count; ++index)
+	{
+		const primec_ast_index_t param = primec_ast_get_extra(checker->ast, proto.params.start + index);
+		const primec_ast_node_s* const node = primec_ast_get_node(checker->ast, param);
+		primec_type_t type = primec_type_error;
+		bool is_mutable = false;
+
+		if (node->kind != primec_ast_kind_param)
+		{
+			// NOTE: Function types list the parameter types only.
+			type = resolve_type(checker, param, NULL);
+		}
+		else
+		{
+			type = resolve_type(checker, node->lhs, &is_mutable);
+			get_node(checker, param)->type = type;
+			get_node(checker, param)->target = type;
+			get_node(checker, param)->flags = is_mutable ? primec_sema_flag_mutable : 0;
+		}
+
+		if (primec_type_void == type)
+		{
+			report_error(checker, param, "parameter cannot be of type `void`.");
+			type = primec_type_error;
+		}
+
+		has_errors |= primec_type_error == type;
+		params[index] = type;
+	}
+
+	const primec_type_t return_type = primec_ast_null == proto.return_type
+		? primec_type_void
+		: resolve_type(checker, proto.return_type, NULL);
+
+	primec_type_t result = primec_type_error;
+
+	if (!has_errors && return_type != primec_type_error)
+	{
+		result = primec_type_table_get_func(checker->sema->types, return_type, params, params_count,
+			(proto.flags & primec_ast_proto_flag_variadic) != 0
+		);
+	}
+
+	primec_utils_free(params);
+	return result;
+}
+
+static void resolve_struct(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const declaration = primec_ast_get_node(checker->ast, node);
+	primec_sema_node_s* const info = get_node(checker, node);
+	const primec_symbol_t name = get_symbol(checker, declaration->token);
+
+	// NOTE: The struct is resolved before its fields, so they can refer to it
+	//       (through references and pointers).
+	info->type = primec_type_table_get_struct(checker->sema->types, checker->ast->file, node,
+		primec_symbols_get_text(checker->sema->symbols, name)
+	);
+
+	info->target = info->type;
+	checker->module->states[node] = state_resolved;
+
+	const primec_ast_range_s fields = primec_ast_get_list(checker->ast, node);
+	const uint32_t fields_count = fields.end - fields.start;
+	primec_type_t* const types = primec_utils_malloc((fields_count > 0 ? fields_count : 1) * sizeof(primec_type_t));
+
+	for (uint32_t index = 0; index < fields_count; ++index)
+	{
+		const primec_ast_index_t field = primec_ast_get_extra(checker->ast, fields.start + index);
+		const primec_symbol_t symbol = get_symbol(checker, primec_ast_get_node(checker->ast, field)->token);
+
+		for (uint32_t other = 0; other < index; ++other)
+		{
+			const primec_ast_index_t previous = primec_ast_get_extra(checker->ast, fields.start + other);
+
+			if (get_symbol(checker, primec_ast_get_node(checker->ast, previous)->token) == symbol)
+			{
+				report_error(checker, field, "field `%s` is already declared.", primec_symbols_get_text(checker->sema->symbols, symbol));
+				break;
+			}
+		}
+
+		types[index] = resolve_type(checker, primec_ast_get_node(checker->ast, field)->lhs, NULL);
+
+		if (primec_type_void == types[index])
+		{
+			report_error(checker, field, "field cannot be of type `void`.");
+			types[index] = primec_type_error;
+		}
+
+		get_node(checker, field)->type = types[index];
+		get_node(checker, field)->target = types[index];
+	}
+
+	primec_type_table_set_fields(checker->sema->types, info->type, types, fields_count);
+	primec_utils_free(types);
+}
+
+static void resolve_enum(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const declaration = primec_ast_get_node(checker->ast, node);
+	primec_sema_node_s* const info = get_node(checker, node);
+	const primec_symbol_t name = get_symbol(checker, declaration->token);
+	primec_type_t underlying = primec_type_i32;
+
+	if (declaration->lhs != primec_ast_null)
+	{
+		underlying = resolve_type(checker, declaration->lhs, NULL);
+
+		if (underlying != primec_type_error && !primec_type_is_integer(checker->sema->types, underlying))
+		{
+			char buffer[type_buffer_capacity] = {0};
+			report_error(checker, declaration->lhs, "underlying type of an enum must be an integer, but found `%s`.",
+				format_type(checker, underlying, buffer)
+			);
+		}
+
+		if (!primec_type_is_integer(checker->sema->types, underlying)) { underlying = primec_type_i32; }
+	}
+
+	info->type = primec_type_table_get_enum(checker->sema->types, checker->ast->file, node,
+		primec_symbols_get_text(checker->sema->symbols, name), underlying
+	);
+
+	info->target = info->type;
+	checker->module->states[node] = state_resolved;
+
+	const primec_ast_range_s members = primec_ast_get_range(checker->ast, declaration->rhs);
+	primec_const_value_s value = {0};
+	bool has_value = true;
+
+	for (primec_ast_index_t extra = members.start; extra < members.end; ++extra)
+	{
+		const primec_ast_index_t member = primec_ast_get_extra(checker->ast, extra);
+		const primec_ast_node_s* const member_node = primec_ast_get_node(checker->ast, member);
+		const primec_symbol_t symbol = get_symbol(checker, member_node->token);
+
+		for (primec_ast_index_t previous = members.start; previous < extra; ++previous)
+		{
+			if (get_symbol(checker, primec_ast_get_node(checker->ast, primec_ast_get_extra(checker->ast, previous))->token) == symbol)
+			{
+				report_error(checker, member, "enum member `%s` is already declared.", primec_symbols_get_text(checker->sema->symbols, symbol));
+				break;
+			}
+		}
+
+		primec_const_status_e status = primec_const_status_ok;
+
+		// NOTE: Members without values follow the previous ones, starting from
+		//       zero.
+		if (member_node->lhs != primec_ast_null)
+		{
+			(void)check_value(checker, member_node->lhs);
+			expect_type(checker, member_node->lhs, underlying);
+			has_value = is_constant(checker, member_node->lhs);
+			value = checker->module->values[member_node->lhs];
+
+			if (!has_value && get_node(checker, member_node->lhs)->type != primec_type_error)
+			{
+				report_error(checker, member_node->lhs, "enum member value must be a constant expression.");
+			}
+		}
+		else if (extra > members.start && has_value)
+		{
+			const primec_const_value_s one = { .uval = 1 };
+			status = primec_const_fold_binary(checker->sema->types, primec_token_type_add, underlying, value,
+				underlying, one, &value
+			);
+		}
+
+		if (status != primec_const_status_ok)
+		{
+			char buffer[type_buffer_capacity] = {0};
+			report_error(checker, member, "value of enum member `%s` overflows `%s`.",
+				primec_symbols_get_text(checker->sema->symbols, symbol), format_type(checker, underlying, buffer)
+			);
+
+			has_value = false;
+		}
+
+		get_node(checker, member)->type = info->type;
+		get_node(checker, member)->target = info->type;
+		if (has_value) { (void)set_constant(checker, member, status, value); }
+	}
+}
+
+static primec_type_t resolve_global(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const declaration = primec_ast_get_node(checker->ast, node);
+	bool is_mutable = false;
+	primec_type_t type = primec_type_error;
+
+	if (declaration->lhs != primec_ast_null)
+	{
+		type = resolve_type(checker, declaration->lhs, &is_mutable);
+
+		if (declaration->rhs != primec_ast_null)
+		{
+			expect_expression(checker, declaration->rhs, type);
+		}
+	}
+	else if (declaration->rhs != primec_ast_null)
+	{
+		(void)check_expression(checker, declaration->rhs);
+		type = default_untyped(checker, declaration->rhs);
+	}
+	else
+	{
+		report_error(checker, node, "variable without an initializer must have a type.");
+	}
+
+	if (primec_type_void == type)
+	{
+		report_error(checker, node, "variable cannot be of type `void`.");
+		type = primec_type_error;
+	}
+
+	// NOTE: Globals are initialized statically, so their initializers must be
+	//       constants or string literals.
+	if (declaration->rhs != primec_ast_null && type != primec_type_error &&
+		get_node(checker, declaration->rhs)->type != primec_type_error && !is_constant(checker, declaration->rhs) &&
+		primec_ast_get_node(checker->ast, declaration->rhs)->kind != primec_ast_kind_string_literal)
+	{
+		report_error(checker, declaration->rhs, "initializer of a global variable must be a constant expression.");
+	}
+
+	get_node(checker, node)->type = type;
+	get_node(checker, node)->flags = is_mutable ? primec_sema_flag_mutable : 0;
+	declare_constant(checker, node, declaration->rhs);
+	return type;
+}
+
+static void declare_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_ast_index_t initializer)
+{
+	const primec_sema_node_s* const info = get_node(checker, node);
+
+	// NOTE: Immutable scalar variables with constant initializers are constants
+	//       themselves, and their uses are folded as well.
+	if ((info->flags & primec_sema_flag_mutable) || primec_ast_null == initializer || !is_constant(checker, initializer) ||
+		!is_scalar(checker, info->type) || get_node(checker, initializer)->target != info->type)
+	{
+		return;
+	}
+
+	(void)set_constant(checker, node, primec_const_status_ok, checker->module->values[initializer]);
+}
+
+static void check_function(
+	checker_s* const checker,
+	const primec_ast_index_t proto,
+	const primec_ast_index_t body)
+{
+	const primec_ast_proto_s record = primec_ast_get_proto(checker->ast, proto);
+	checker->return_type = primec_type_void;
+
+	if (record.return_type != primec_ast_null)
+	{
+		checker->return_type = get_node(checker, record.return_type)->type;
+	}
+
+	primec_resolver_push_scope(&checker->resolver);
+
+	for (primec_ast_index_t extra = record.params.start; extra < record.params.end; ++extra)
+	{
+		declare_local(checker, primec_ast_get_extra(checker->ast, extra), primec_binding_kind_param);
+	}
+
+	const primec_ast_range_s statements = primec_ast_get_list(checker->ast, body);
+	const primec_type_t tail = check_block(checker, body);
+	bool returns = (get_node(checker, body)->flags & primec_sema_flag_returns) != 0;
+
+	// NOTE: The tail expression of the body (or the unsafe block it ends with)
+	//       is the returned value.
+	if (statements.end > statements.start)
+	{
+		const primec_ast_index_t last = primec_ast_get_extra(checker->ast, statements.end - 1);
+		const primec_ast_kind_e kind = primec_ast_get_node(checker->ast, last)->kind;
+		const bool is_tail = !is_statement(kind) || primec_ast_kind_unsafe_block == kind;
+
+		if (is_tail && tail != primec_type_void && checker->return_type != primec_type_void)
+		{
+			expect_type(checker, last, checker->return_type);
+			returns = true;
+		}
+		else if (is_tail)
+		{
+			(void)default_untyped(checker, last);
+		}
+	}
+
+	if (!returns && checker->return_type != primec_type_void && checker->return_type != primec_type_error)
+	{
+		char buffer[type_buffer_capacity] = {0};
+		primec_diagnostics_report(checker->diagnostics, primec_ast_get_token(checker->ast,
+			primec_ast_get_node(checker->ast, body)->token)->location,
+			"missing return in function returning `%s`.", format_type(checker, checker->return_type, buffer)
+		);
+	}
+
+	primec_resolver_pop_scope(&checker->resolver);
+}
+
+static void declare_local(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_binding_kind_e kind)
+{
+	const primec_symbol_t symbol = get_symbol(checker, primec_ast_get_node(checker->ast, node)->token);
+
+	const primec_binding_s binding =
+	{
+		.symbol = symbol,
+		.kind = kind,
+		.module = checker->module_index,
+		.node = node
+	};
+
+	if (primec_resolver_declare(&checker->resolver, binding) != NULL)
+	{
+		report_error(checker, node, "`%s` is already declared in this scope.", primec_symbols_get_text(checker->sema->symbols, symbol));
+	}
+}
+
+static primec_type_t check_block(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_range_s statements = primec_ast_get_list(checker->ast, node);
+	primec_type_t type = primec_type_void;
+	uint8_t flags = 0;
+
+	primec_resolver_push_scope(&checker->resolver);
+
+	for (primec_ast_index_t extra = statements.start; extra < statements.end; ++extra)
+	{
+		const primec_ast_index_t statement = primec_ast_get_extra(checker->ast, extra);
+		const primec_ast_kind_e kind = primec_ast_get_node(checker->ast, statement)->kind;
+
+		// NOTE: The last expression of a block without a semicolon is the value
+		//       of the block.
+		if (!is_statement(kind))
+		{
+			type = check_expression(checker, statement);
+			continue;
+		}
+
+		check_statement(checker, statement);
+		flags |= get_node(checker, statement)->flags & primec_sema_flag_returns;
+
+		if (primec_ast_kind_unsafe_block == kind && extra + 1 == statements.end)
+		{
+			type = get_node(checker, statement)->type;
+		}
+	}
+
+	primec_resolver_pop_scope(&checker->resolver);
+	set_type(checker, node, type, flags);
+	return type;
+}
+
+static bool is_statement(
+	const primec_ast_kind_e kind)
+{
+	return (kind >= primec_ast_kind_block && kind <= primec_ast_kind_return) ||
+		primec_ast_kind_let_decl == kind || primec_ast_kind_alias_decl == kind;
+}
+
+static void check_statement(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const statement = primec_ast_get_node(checker->ast, node);
+
+	switch (statement->kind)
+	{
+		case primec_ast_kind_let_decl:
+		{
+			check_let(checker, node);
+		} break;
+
+		case primec_ast_kind_alias_decl:
+		{
+			set_type(checker, node, resolve_type(checker, statement->lhs, NULL), 0);
+			checker->module->states[node] = state_resolved;
+			declare_local(checker, node, primec_binding_kind_alias);
+		} break;
+
+		case primec_ast_kind_block:
+		{
+			(void)check_block(checker, node);
+		} break;
+
+		case primec_ast_kind_unsafe_block:
+		{
+			const primec_type_t type = check_block(checker, statement->lhs);
+			set_type(checker, node, type, get_node(checker, statement->lhs)->flags);
+		} break;
+
+		case primec_ast_kind_expr_stmt:
+		{
+			(void)check_expression(checker, statement->lhs);
+			(void)default_untyped(checker, statement->lhs);
+			set_type(checker, node, primec_type_void, 0);
+		} break;
+
+		case primec_ast_kind_if:
+		{
+			check_if(checker, node);
+		} break;
+
+		case primec_ast_kind_while:
+		{
+			check_condition(checker, statement->lhs);
+			++checker->loops;
+			(void)check_block(checker, statement->rhs);
+			--checker->loops;
+			set_type(checker, node, primec_type_void, 0);
+		} break;
+
+		case primec_ast_kind_loop:
+		{
+			// NOTE: A loop without any break never completes normally.
+			const uint32_t breaks = checker->breaks;
+			checker->breaks = 0;
+			++checker->loops;
+			(void)check_block(checker, statement->lhs);
+			--checker->loops;
+			set_type(checker, node, primec_type_void, 0 == checker->breaks ? primec_sema_flag_returns : 0);
+			checker->breaks = breaks;
+		} break;
+
+		case primec_ast_kind_break:
+		case primec_ast_kind_continue:
+		{
+			if (0 == checker->loops)
+			{
+				report_error(checker, node, "`%s` outside of a loop.",
+					primec_ast_kind_break == statement->kind ? "break" : "continue"
+				);
+			}
+
+			if (primec_ast_kind_break == statement->kind) { ++checker->breaks; }
+			set_type(checker, node, primec_type_void, 0);
+		} break;
+
+		case primec_ast_kind_return:
+		{
+			if (statement->lhs != primec_ast_null)
+			{
+				if (primec_type_void == checker->return_type)
+				{
+					(void)check_expression(checker, statement->lhs);
+					report_error(checker, statement->lhs, "unexpected return value in function returning nothing.");
+				}
+				else
+				{
+					expect_expression(checker, statement->lhs, checker->return_type);
+				}
+			}
+			else if (checker->return_type != primec_type_void && checker->return_type != primec_type_error)
+			{
+				char buffer[type_buffer_capacity] = {0};
+				report_error(checker, node, "missing return value in function returning `%s`.",
+					format_type(checker, checker->return_type, buffer)
+				);
+			}
+
+			set_type(checker, node, primec_type_void, primec_sema_flag_returns);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+}
+
+static void check_let(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const declaration = primec_ast_get_node(checker->ast, node);
+	bool is_mutable = false;
+	primec_type_t type = primec_type_error;
+
+	if (declaration->lhs != primec_ast_null)
+	{
+		type = resolve_type(checker, declaration->lhs, &is_mutable);
+
+		if (declaration->rhs != primec_ast_null)
+		{
+			expect_expression(checker, declaration->rhs, type);
+		}
+	}
+	else if (declaration->rhs != primec_ast_null)
+	{
+		(void)check_expression(checker, declaration->rhs);
+		type = default_untyped(checker, declaration->rhs);
+
+		if (primec_type_kind_slice == get_kind(checker, type))
+		{
+			report_error(checker, declaration->rhs, "slice must be borrowed with `&` or `&mut`.");
+			type = primec_type_error;
+		}
+	}
+	else
+	{
+		report_error(checker, node, "variable without an initializer must have a type.");
+	}
+
+	if (primec_type_void == type)
+	{
+		report_error(checker, node, "variable cannot be of type `void`.");
+		type = primec_type_error;
+	}
+
+	// NOTE: The variable is declared after its initializer is checked, so the
+	//       initializer refers to the shadowed variables.
+	set_type(checker, node, type, is_mutable ? primec_sema_flag_mutable : 0);
+	declare_constant(checker, node, declaration->rhs);
+	declare_local(checker, node, primec_binding_kind_local);
+}
+
+static void check_if(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const statement = primec_ast_get_node(checker->ast, node);
+	const primec_ast_if_s record = primec_ast_get_if(checker->ast, statement->rhs);
+	check_condition(checker, statement->lhs);
+	(void)check_block(checker, record.then_block);
+	uint8_t flags = 0;
+
+	if (record.else_branch != primec_ast_null)
+	{
+		if (primec_ast_kind_if == primec_ast_get_node(checker->ast, record.else_branch)->kind)
+		{
+			check_if(checker, record.else_branch);
+		}
+		else
+		{
+			(void)check_block(checker, record.else_branch);
+		}
+
+		flags = get_node(checker, record.then_block)->flags & get_node(checker, record.else_branch)->flags;
+	}
+
+	set_type(checker, node, primec_type_void, flags & primec_sema_flag_returns);
+}
+
+static void check_condition(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_type_t type = check_value(checker, node);
+	(void)default_untyped(checker, node);
+
+	if (type != primec_type_bool && type != primec_type_error && !primec_type_is_integer(checker->sema->types, type))
+	{
+		char buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "condition must be a boolean or an integer, but found `%s`.", format_type(checker, type, buffer));
+	}
+}
+
+static primec_type_t check_expression(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+
+	switch (expression->kind)
+	{
+		case primec_ast_kind_int_literal:
+		case primec_ast_kind_float_literal:
+		case primec_ast_kind_rune_literal:
+		case primec_ast_kind_string_literal:
+		{
+			return check_literal(checker, node);
+		} break;
+
+		case primec_ast_kind_identifier: { return check_identifier(checker, node); } break;
+		case primec_ast_kind_scope:
+		{
+			const primec_type_t type = check_scope(checker, node);
+			const primec_sema_node_s* const info = get_node(checker, node);
+
+			// NOTE: Scopes may name types, which are used as namespaces only.
+			if (primec_binding_kind_struct == info->binding || primec_binding_kind_enum == info->binding ||
+				primec_binding_kind_alias == info->binding)
+			{
+				report_error(checker, node, "`%s` is a %s, not a value.", primec_ast_get_token_text(checker->ast, expression->token),
+					primec_binding_kind_to_string((primec_binding_kind_e)info->binding)
+				);
+
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			return type;
+		} break;
+
+		case primec_ast_kind_unary: { return fold_constant(checker, node, check_unary(checker, node)); } break;
+		case primec_ast_kind_binary: { return check_binary_chain(checker, node); } break;
+		case primec_ast_kind_assign: { return check_assign(checker, node); } break;
+		case primec_ast_kind_cast: { return fold_constant(checker, node, check_cast(checker, node)); } break;
+		case primec_ast_kind_call: { return check_call(checker, node); } break;
+		case primec_ast_kind_index: { return check_index(checker, node); } break;
+		case primec_ast_kind_slice: { return check_index(checker, node); } break;
+		case primec_ast_kind_member: { return check_member(checker, node); } break;
+		case primec_ast_kind_address_of: { return check_address_of(checker, node); } break;
+		case primec_ast_kind_deref: { return check_deref(checker, node); } break;
+		case primec_ast_kind_lambda: { return check_lambda(checker, node); } break;
+
+		case primec_ast_kind_unsafe_block:
+		{
+			const primec_type_t type = check_block(checker, expression->lhs);
+			return set_type(checker, node, type, 0);
+		} break;
+
+		default:
+		{
+			report_error(checker, node, "expected expression, but found `%s`.", primec_ast_kind_to_string(expression->kind));
+			return set_type(checker, node, primec_type_error, 0);
+		} break;
+	}
+}
+
+static primec_type_t check_value(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	return to_value(checker, node, check_expression(checker, node));
+}
+
+static primec_type_t to_value(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type)
+{
+	// NOTE: References are dereferenced automatically when their value is
+	//       used by an operator.
+	if (primec_type_kind_reference == get_kind(checker, type) &&
+		get_kind(checker, get_element(checker, type)) != primec_type_kind_slice)
+	{
+		primec_sema_node_s* const info = get_node(checker, node);
+		info->coercion = primec_sema_coercion_deref;
+		info->target = get_element(checker, type);
+		return info->target;
+	}
+
+	if (primec_type_kind_slice == get_kind(checker, type))
+	{
+		report_error(checker, node, "slice must be borrowed with `&` or `&mut`.");
+		return primec_type_error;
+	}
+
+	return type;
+}
+
+static primec_type_t fold_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_sema_node_s* const left = get_node(checker, expression->lhs);
+	const primec_const_value_s* const values = checker->module->values;
+	primec_type_table_s* const types = checker->sema->types;
+	primec_const_value_s value = {0};
+	bool is_folded = true;
+
+	if (primec_type_error == type || !is_constant(checker, expression->lhs))
+	{
+		return type;
+	}
+
+	// NOTE: The operands are already converted to the types of the operators,
+	//       so the folding only has to follow the semantics of these types.
+	switch (expression->kind)
+	{
+		case primec_ast_kind_unary:
+		{
+			const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+			is_folded = set_constant(checker, node, primec_const_fold_unary(types, operator, left->type, values[expression->lhs], &value), value);
+		} break;
+
+		case primec_ast_kind_binary:
+		{
+			if (!is_constant(checker, expression->rhs)) { break; }
+			const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+
+			is_folded = set_constant(checker, node, primec_const_fold_binary(types, operator, left->type, values[expression->lhs],
+				get_node(checker, expression->rhs)->type, values[expression->rhs], &value), value
+			);
+		} break;
+
+		case primec_ast_kind_cast:
+		{
+			if (!is_scalar(checker, left->type) || !is_scalar(checker, type)) { break; }
+			is_folded = set_constant(checker, node, primec_const_convert(types, left->type, type, values[expression->lhs], true, &value), value);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	// NOTE: The failed folds are reported already, so the expressions become
+	//       errors, which are not reported again by their users.
+	if (!is_folded)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	return type;
+}
+
+static void expect_expression(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected)
+{
+	(void)check_expression(checker, node);
+	expect_type(checker, node, expected);
+}
+
+static void expect_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected)
+{
+	const primec_type_t actual = get_node(checker, node)->type;
+
+	if (primec_type_error == actual || primec_type_error == expected)
+	{
+		return;
+	}
+
+	if (!coerce(checker, node, expected))
+	{
+		char expected_buffer[type_buffer_capacity] = {0};
+		char actual_buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "mismatched types -- expected `%s`, but found `%s`.",
+			format_type(checker, expected, expected_buffer), format_type(checker, actual, actual_buffer)
+		);
+	}
+}
+
+static bool coerce(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t expected)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+	const primec_type_t type = info->type;
+	primec_type_table_s* const types = checker->sema->types;
+
+	if (type == expected || primec_type_error == type || primec_type_error == expected)
+	{
+		info->coercion = primec_sema_coercion_none;
+		info->target = expected;
+		return true;
+	}
+
+	const uint8_t kind = get_kind(checker, type);
+	const uint8_t expected_kind = get_kind(checker, expected);
+
+	if (primec_type_untyped_int == type &&
+		(is_numeric(checker, expected) || primec_type_c8 == expected) && !is_untyped(expected))
+	{
+		finalize_untyped(checker, node, expected);
+		return true;
+	}
+
+	if (primec_type_untyped_float == type && primec_type_is_float(types, expected) && !is_untyped(expected))
+	{
+		finalize_untyped(checker, node, expected);
+		return true;
+	}
+
+	if (primec_type_untyped_int == type && primec_type_untyped_float == expected)
+	{
+		finalize_untyped(checker, node, expected);
+		return true;
+	}
+
+	if (primec_type_bool == type && primec_type_is_integer(types, expected))
+	{
+		if (is_untyped(expected)) { return false; }
+		info->coercion = primec_sema_coercion_bool_to_int;
+		info->target = expected;
+		return true;
+	}
+
+	if (primec_type_kind_reference == kind)
+	{
+		const primec_type_t element = get_element(checker, type);
+		const bool is_mutable = is_mutable_reference(checker, type);
+
+		// NOTE: Mutable references can be used as immutable ones, and references
+		//       can be used as pointers, without changing their representation.
+		if ((primec_type_kind_reference == expected_kind || primec_type_kind_pointer == expected_kind) &&
+			get_element(checker, expected) == element &&
+			(is_mutable || !is_mutable_reference(checker, expected)))
+		{
+			info->coercion = primec_sema_coercion_none;
+			info->target = expected;
+			return true;
+		}
+
+		if (primec_type_kind_reference == expected_kind && primec_type_kind_array == get_kind(checker, element) &&
+			primec_type_kind_slice == get_kind(checker, get_element(checker, expected)) &&
+			get_element(checker, element) == get_element(checker, get_element(checker, expected)) &&
+			(is_mutable || !is_mutable_reference(checker, expected)))
+		{
+			info->coercion = primec_sema_coercion_array_to_slice;
+			info->target = expected;
+			return true;
+		}
+
+		if (primec_type_kind_pointer == expected_kind && primec_type_kind_slice == get_kind(checker, element) &&
+			get_element(checker, element) == get_element(checker, expected) &&
+			(is_mutable || !is_mutable_reference(checker, expected)))
+		{
+			info->coercion = primec_sema_coercion_slice_to_pointer;
+			info->target = expected;
+			return true;
+		}
+
+		if (element == expected && primec_type_kind_slice != get_kind(checker, element))
+		{
+			info->coercion = primec_sema_coercion_deref;
+			info->target = expected;
+			return true;
+		}
+	}
+
+	if (primec_type_kind_pointer == kind && primec_type_kind_pointer == expected_kind &&
+		get_element(checker, type) == get_element(checker, expected) &&
+		is_mutable_reference(checker, type))
+	{
+		info->coercion = primec_sema_coercion_none;
+		info->target = expected;
+		return true;
+	}
+
+	return false;
+}
+
+static void finalize_untyped(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type)
+{
+	const primec_sema_node_s* const info = get_node(checker, node);
+	if (!is_untyped(info->type)) { return; }
+
+	// NOTE: Untyped constants are evaluated exactly, so only the value of the
+	//       whole expression has to fit into the type of its context.
+	if (info->flags & primec_sema_flag_constant)
+	{
+		primec_const_value_s value = {0};
+
+		if (primec_const_convert(checker->sema->types, info->type, type, checker->module->values[node], false, &value) !=
+			primec_const_status_ok)
+		{
+			char value_buffer[type_buffer_capacity] = {0};
+			char type_buffer[type_buffer_capacity] = {0};
+			report_error(checker, node, "constant `%s` does not fit into `%s`.",
+				primec_const_format(checker->sema->types, info->type, checker->module->values[node], value_buffer, type_buffer_capacity),
+				format_type(checker, type, type_buffer)
+			);
+		}
+	}
+
+	retype_untyped(checker, node, type);
+}
+
+static void retype_untyped(
+	checker_s* const checker,
+	primec_ast_index_t node,
+	const primec_type_t type)
+{
+	// NOTE: The left operands are followed by the loop, so the left-deep chains
+	//       do not recurse.
+	while (true)
+	{
+		const primec_ast_index_t next = retype_untyped_node(checker, node, type);
+		if (primec_ast_null == next) { return; }
+		node = next;
+	}
+}
+
+static primec_ast_index_t retype_untyped_node(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+	if (!is_untyped(info->type)) { return primec_ast_null; }
+
+	if (info->flags & primec_sema_flag_constant)
+	{
+		primec_const_value_s* const value = &checker->module->values[node];
+		(void)primec_const_convert(checker->sema->types, info->type, type, *value, true, value);
+	}
+
+	info->type = type;
+	info->target = type;
+	info->coercion = primec_sema_coercion_none;
+
+	// NOTE: Untyped constant expressions take the type of their context, and
+	//       so do all their untyped operands.
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+
+	switch (expression->kind)
+	{
+		case primec_ast_kind_unary:
+		{
+			return expression->lhs;
+		} break;
+
+		case primec_ast_kind_binary:
+		{
+			const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+
+			if (operator != primec_token_type_lshift && operator != primec_token_type_rshift)
+			{
+				retype_untyped(checker, expression->rhs, type);
+			}
+
+			return expression->lhs;
+		} break;
+
+		case primec_ast_kind_unsafe_block:
+		{
+			const primec_ast_range_s statements = primec_ast_get_list(checker->ast, expression->lhs);
+
+			if (statements.end > statements.start)
+			{
+				retype_untyped(checker, primec_ast_get_extra(checker->ast, statements.end - 1), type);
+			}
+
+			get_node(checker, expression->lhs)->type = type;
+			get_node(checker, expression->lhs)->target = type;
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	return primec_ast_null;
+}
+
+static primec_type_t default_untyped(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_sema_node_s* const info = get_node(checker, node);
+
+	if (primec_type_untyped_int == info->target)
+	{
+		finalize_untyped(checker, node, primec_type_i32);
+	}
+	else if (primec_type_untyped_float == info->target)
+	{
+		finalize_untyped(checker, node, primec_type_f64);
+	}
+
+	return info->target;
+}
+
+static primec_type_t set_type(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t type,
+	const uint8_t flags)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+	info->type = type;
+	info->target = type;
+	info->coercion = primec_sema_coercion_none;
+	info->flags = flags;
+	return type;
+}
+
+static bool set_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_const_status_e status,
+	const primec_const_value_s value)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+
+	switch (status)
+	{
+		case primec_const_status_ok:
+		{
+			info->flags |= primec_sema_flag_constant;
+			checker->module->values[node] = value;
+		} break;
+
+		case primec_const_status_overflow:
+		{
+			char buffer[type_buffer_capacity] = {0};
+			report_error(checker, node, "constant expression overflows `%s`.", format_type(checker, info->type, buffer));
+		} break;
+
+		default:
+		{
+			report_error(checker, node, "%s in constant expression.", primec_const_status_to_string(status));
+		} break;
+	}
+
+	return primec_const_status_ok == status;
+}
+
+static bool is_constant(
+	const checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	return (get_node(checker, node)->flags & primec_sema_flag_constant) != 0;
+}
+
+static void copy_constant(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const uint32_t module,
+	const primec_ast_index_t declaration)
+{
+	const primec_sema_module_s* const source = &checker->sema->modules[module];
+
+	if (source->nodes[declaration].flags & primec_sema_flag_constant)
+	{
+		(void)set_constant(checker, node, primec_const_status_ok, source->values[declaration]);
+	}
+}
+
+static bool is_scalar(
+	const checker_s* const checker,
+	const primec_type_t type)
+{
+	const uint8_t kind = get_kind(checker, type);
+	return is_numeric(checker, type) || primec_type_bool == type || primec_type_c8 == type || primec_type_kind_enum == kind;
+}
+
+static primec_type_t check_literal(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_token_s* const token = primec_ast_get_token(checker->ast, expression->token);
+	primec_type_t type = primec_type_error;
+
+	switch (token->type)
+	{
+		case primec_token_type_literal_i8:  { type = primec_type_i8;  } break;
+		case primec_token_type_literal_i16: { type = primec_type_i16; } break;
+		case primec_token_type_literal_i32: { type = primec_type_i32; } break;
+		case primec_token_type_literal_i64: { type = primec_type_i64; } break;
+		case primec_token_type_literal_u8:  { type = primec_type_u8;  } break;
+		case primec_token_type_literal_u16: { type = primec_type_u16; } break;
+		case primec_token_type_literal_u32: { type = primec_type_u32; } break;
+		case primec_token_type_literal_u64: { type = primec_type_u64; } break;
+		case primec_token_type_literal_f32: { type = primec_type_f32; } break;
+		case primec_token_type_literal_f64: { type = primec_type_f64; } break;
+		case primec_token_type_literal_rune: { type = primec_type_c8; } break;
+
+		case primec_token_type_literal_str:
+		{
+			// NOTE: String literals are immutable views of their characters.
+			type = primec_type_table_get_reference(checker->sema->types,
+				primec_type_table_get_slice(checker->sema->types, primec_type_c8), false
+			);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+		} break;
+	}
+
+	// NOTE: Unsuffixed literals too large for i64 are typed as u64 by the lexer.
+	if ((token->flags & primec_token_flag_untyped) &&
+		(primec_token_type_literal_i64 == token->type || primec_token_type_literal_f64 == token->type))
+	{
+		type = primec_ast_kind_float_literal == expression->kind ? primec_type_untyped_float : primec_type_untyped_int;
+	}
+
+	set_type(checker, node, type, 0);
+
+	if (primec_token_type_literal_str == token->type)
+	{
+		return type;
+	}
+
+	primec_const_value_s value = {0};
+	const primec_const_status_e status = primec_const_from_literal(token,
+		primec_ast_get_token_value(checker->ast, expression->token), type, &value
+	);
+
+	if (status != primec_const_status_ok)
+	{
+		char buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "literal is out of range of `%s`.", format_type(checker, type, buffer));
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	(void)set_constant(checker, node, status, value);
+	return type;
+}
+
+static primec_type_t check_identifier(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_symbol_t symbol = get_symbol(checker, primec_ast_get_node(checker->ast, node)->token);
+	const primec_binding_s* const binding = primec_resolver_find(&checker->resolver, symbol);
+
+	if (NULL == binding)
+	{
+		report_error(checker, node, "unknown identifier `%s`.", primec_symbols_get_text(checker->sema->symbols, symbol));
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	// NOTE: Lambdas do not capture, so the locals of the enclosing functions
+	//       are not visible in their bodies.
+	if ((primec_binding_kind_local == binding->kind || primec_binding_kind_param == binding->kind) &&
+		(uint32_t)(binding - checker->resolver.bindings.data) < checker->barrier)
+	{
+		report_error(checker, node, "lambda cannot capture local `%s` of the enclosing function.",
+			primec_symbols_get_text(checker->sema->symbols, symbol)
+		);
+
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	return bind_value(checker, node, binding);
+}
+
+static primec_type_t check_scope(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_ast_node_s* const left = primec_ast_get_node(checker->ast, expression->lhs);
+	const primec_symbol_t symbol = get_symbol(checker, expression->token);
+	primec_binding_s namespace = {0};
+
+	if (primec_ast_kind_identifier == left->kind)
+	{
+		const primec_symbol_t left_symbol = get_symbol(checker, left->token);
+		const primec_binding_s* const binding = primec_resolver_find(&checker->resolver, left_symbol);
+
+		if (NULL == binding)
+		{
+			report_error(checker, expression->lhs, "unknown identifier `%s`.", primec_symbols_get_text(checker->sema->symbols, left_symbol));
+			return set_type(checker, node, primec_type_error, 0);
+		}
+
+		namespace = *binding;
+	}
+	else if (primec_ast_kind_scope == left->kind)
+	{
+		if (primec_type_error == check_scope(checker, expression->lhs))
+		{
+			return set_type(checker, node, primec_type_error, 0);
+		}
+
+		const primec_sema_node_s* const info = get_node(checker, expression->lhs);
+		namespace = (primec_binding_s) { .kind = info->binding, .module = info->module, .node = info->node };
+	}
+
+	primec_sema_node_s* const left_info = get_node(checker, expression->lhs);
+	left_info->binding = (uint8_t)namespace.kind;
+	left_info->module = namespace.module;
+	left_info->node = namespace.node;
+
+	if (primec_binding_kind_module == namespace.kind)
+	{
+		left_info->type = primec_type_void;
+		left_info->target = primec_type_void;
+		const primec_binding_s* const binding = primec_resolver_find_in_module(&checker->resolver, namespace.module, symbol);
+
+		if (NULL == binding)
+		{
+			report_error(checker, node, "module `%s` has no declaration `%s`.",
+				checker->sema->graph->modules.data[namespace.module]->path, primec_symbols_get_text(checker->sema->symbols, symbol)
+			);
+
+			return set_type(checker, node, primec_type_error, 0);
+		}
+
+		// NOTE: Types and enums of other modules are used as namespaces only.
+		if (primec_binding_kind_struct == binding->kind || primec_binding_kind_enum == binding->kind ||
+			primec_binding_kind_alias == binding->kind)
+		{
+			primec_sema_node_s* const info = get_node(checker, node);
+			set_type(checker, node, primec_type_void, 0);
+			info->binding = (uint8_t)binding->kind;
+			info->module = binding->module;
+			info->node = binding->node;
+			return primec_type_void;
+		}
+
+		return bind_value(checker, node, binding);
+	}
+
+	if (primec_binding_kind_enum == namespace.kind)
+	{
+		const primec_sema_module_s* const module = &checker->sema->modules[namespace.module];
+		const primec_ast_s* const ast = &module->module->ast;
+		const primec_ast_range_s members = primec_ast_get_range(ast, primec_ast_get_node(ast, namespace.node)->rhs);
+		const primec_module_scope_s* const scope = &checker->sema->scopes[namespace.module];
+		const primec_type_t type = namespace.module == checker->module_index
+			? ensure_declaration(checker, namespace.node)
+			: module->nodes[namespace.node].type;
+
+		left_info->type = primec_type_void;
+		left_info->target = primec_type_void;
+
+		for (primec_ast_index_t extra = members.start; extra < members.end; ++extra)
+		{
+			const primec_ast_index_t member = primec_ast_get_extra(ast, extra);
+
+			if (scope->tokens[primec_ast_get_node(ast, member)->token] == symbol)
+			{
+				primec_sema_node_s* const info = get_node(checker, node);
+				set_type(checker, node, type, 0);
+				info->binding = primec_binding_kind_member;
+				info->module = namespace.module;
+				info->node = member;
+				copy_constant(checker, node, namespace.module, member);
+				return type;
+			}
+		}
+
+		report_error(checker, node, "enum has no member `%s`.", primec_symbols_get_text(checker->sema->symbols, symbol));
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	report_error(checker, expression->lhs, "expected module or enum before `::`.");
+	return set_type(checker, node, primec_type_error, 0);
+}
+
+static primec_type_t bind_value(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_binding_s* const binding)
+{
+	primec_sema_node_s* const info = get_node(checker, node);
+	uint8_t flags = 0;
+	primec_type_t type = primec_type_error;
+
+	switch (binding->kind)
+	{
+		case primec_binding_kind_func:
+		{
+			type = get_declaration_type(checker, binding);
+		} break;
+
+		case primec_binding_kind_global:
+		case primec_binding_kind_param:
+		case primec_binding_kind_local:
+		{
+			type = get_declaration_type(checker, binding);
+			const primec_sema_node_s* const declaration = &checker->sema->modules[binding->module].nodes[binding->node];
+			flags = primec_sema_flag_place | (declaration->flags & primec_sema_flag_mutable);
+		} break;
+
+		default:
+		{
+			report_error(checker, node, "`%s` is a %s, not a value.",
+				primec_symbols_get_text(checker->sema->symbols, binding->symbol),
+				primec_binding_kind_to_string((primec_binding_kind_e)binding->kind)
+			);
+		} break;
+	}
+
+	set_type(checker, node, type, flags);
+	info->binding = (uint8_t)binding->kind;
+	info->module = binding->module;
+	info->node = binding->node;
+	copy_constant(checker, node, binding->module, binding->node);
+	return type;
+}
+
+static primec_type_t check_unary(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+	const primec_type_t type = check_value(checker, expression->lhs);
+	char buffer[type_buffer_capacity] = {0};
+
+	if (primec_type_error == type)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	switch (operator)
+	{
+		case primec_token_type_add:
+		case primec_token_type_subtract:
+		{
+			if (!is_numeric(checker, type))
+			{
+				report_error(checker, node, "operand of unary `%s` must be a number, but found `%s`.",
+					primec_token_type_to_string(operator), format_type(checker, type, buffer)
+				);
+
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			return set_type(checker, node, type, 0);
+		} break;
+
+		case primec_token_type_lnot:
+		{
+			if (type != primec_type_bool && !primec_type_is_integer(checker->sema->types, type))
+			{
+				report_error(checker, node, "operand of `!` must be a boolean or an integer, but found `%s`.", format_type(checker, type, buffer));
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			(void)default_untyped(checker, expression->lhs);
+			return set_type(checker, node, primec_type_bool, 0);
+		} break;
+
+		case primec_token_type_bnot:
+		{
+			if (!primec_type_is_integer(checker->sema->types, type))
+			{
+				report_error(checker, node, "operand of `~` must be an integer, but found `%s`.", format_type(checker, type, buffer));
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			return set_type(checker, node, type, 0);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return set_type(checker, node, primec_type_error, 0);
+		} break;
+	}
+}
+
+static primec_type_t unify_operands(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_ast_index_t left,
+	const primec_ast_index_t right)
+{
+	const primec_type_t left_type = get_node(checker, left)->target;
+	const primec_type_t right_type = get_node(checker, right)->target;
+
+	if (primec_type_error == left_type || primec_type_error == right_type)
+	{
+		return primec_type_error;
+	}
+
+	if (left_type == right_type)
+	{
+		return left_type;
+	}
+
+	// NOTE: The untyped operand takes the type of the typed one, and of two
+	//       untyped operands the integer one becomes a float.
+	if (!is_untyped(left_type) && coerce(checker, right, left_type))
+	{
+		return left_type;
+	}
+
+	if (!is_untyped(right_type) && coerce(checker, left, right_type))
+	{
+		return right_type;
+	}
+
+	if (is_untyped(left_type) && is_untyped(right_type))
+	{
+		finalize_untyped(checker, primec_type_untyped_int == left_type ? left : right, primec_type_untyped_float);
+		return primec_type_untyped_float;
+	}
+
+	char left_buffer[type_buffer_capacity] = {0};
+	char right_buffer[type_buffer_capacity] = {0};
+	report_error(checker, node, "mismatched operand types `%s` and `%s`.",
+		format_type(checker, left_type, left_buffer), format_type(checker, right_type, right_buffer)
+	);
+
+	return primec_type_error;
+}
+
+static primec_type_t check_binary_chain(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	// NOTE: The left operands of the left-deep chains, such as the long sums,
+	//       are walked down without the recursion, and the binaries are checked
+	//       from the innermost one up, so only their right operands recurse.
+	const uint32_t base = checker->chain.count;
+	primec_ast_index_t innermost = node;
+
+	while (primec_ast_kind_binary == primec_ast_get_node(checker->ast, innermost)->kind)
+	{
+		if (checker->chain.count >= checker->chain.capacity)
+		{
+			checker->chain.capacity = 0 == checker->chain.capacity ? 64 : checker->chain.capacity * 2;
+			checker->chain.data = primec_utils_realloc(checker->chain.data, checker->chain.capacity * sizeof(primec_ast_index_t));
+		}
+
+		checker->chain.data[checker->chain.count++] = innermost;
+		innermost = primec_ast_get_node(checker->ast, innermost)->lhs;
+	}
+
+	primec_type_t left = check_value(checker, innermost);
+
+	while (true)
+	{
+		const primec_ast_index_t binary = checker->chain.data[--checker->chain.count];
+		const primec_type_t type = fold_constant(checker, binary, check_binary(checker, binary, left));
+		if (checker->chain.count == base) { return type; }
+		left = to_value(checker, binary, type);
+	}
+}
+
+static primec_type_t check_binary(
+	checker_s* const checker,
+	const primec_ast_index_t node,
+	const primec_type_t left)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+	const primec_type_t right = check_value(checker, expression->rhs);
+	primec_type_table_s* const types = checker->sema->types;
+	char buffer[type_buffer_capacity] = {0};
+
+	if (primec_type_error == left || primec_type_error == right)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	switch (operator)
+	{
+		case primec_token_type_lshift:
+		case primec_token_type_rshift:
+		{
+			if (!primec_type_is_integer(types, left) || !primec_type_is_integer(types, right))
+			{
+				report_error(checker, node, "operands of `%s` must be integers.", primec_token_type_to_string(operator));
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			(void)default_untyped(checker, expression->rhs);
+			return set_type(checker, node, left, 0);
+		} break;
+
+		case primec_token_type_land:
+		case primec_token_type_lor:
+		case primec_token_type_lxor:
+		{
+			if ((left != primec_type_bool && !primec_type_is_integer(types, left)) ||
+				(right != primec_type_bool && !primec_type_is_integer(types, right)))
+			{
+				report_error(checker, node, "operands of `%s` must be booleans or integers.", primec_token_type_to_string(operator));
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			(void)default_untyped(checker, expression->lhs);
+			(void)default_untyped(checker, expression->rhs);
+			return set_type(checker, node, primec_type_bool, 0);
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	const primec_type_t type = unify_operands(checker, node, expression->lhs, expression->rhs);
+
+	if (primec_type_error == type)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	const uint8_t kind = get_kind(checker, type);
+
+	switch (operator)
+	{
+		case primec_token_type_add:
+		case primec_token_type_subtract:
+		case primec_token_type_multiply:
+		case primec_token_type_divide:
+		case primec_token_type_modulus:
+		{
+			if (!is_numeric(checker, type) || (primec_token_type_modulus == operator && !primec_type_is_integer(types, type)))
+			{
+				report_error(checker, node, "operands of `%s` must be %s, but found `%s`.", primec_token_type_to_string(operator),
+					primec_token_type_modulus == operator ? "integers" : "numbers", format_type(checker, type, buffer)
+				);
+
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			return set_type(checker, node, type, 0);
+		} break;
+
+		case primec_token_type_band:
+		case primec_token_type_bor:
+		case primec_token_type_bxor:
+		{
+			if (!primec_type_is_integer(types, type))
+			{
+				report_error(checker, node, "operands of `%s` must be integers, but found `%s`.",
+					primec_token_type_to_string(operator), format_type(checker, type, buffer)
+				);
+
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			return set_type(checker, node, type, 0);
+		} break;
+
+		case primec_token_type_equal:
+		case primec_token_type_not_equal:
+		case primec_token_type_greater_than:
+		case primec_token_type_less_than:
+		case primec_token_type_greater_than_or_equal:
+		case primec_token_type_less_than_or_equal:
+		{
+			const bool is_equality = primec_token_type_equal == operator || primec_token_type_not_equal == operator;
+			const bool is_comparable = is_numeric(checker, type) || primec_type_c8 == type ||
+				primec_type_kind_pointer == kind || (is_equality && (primec_type_bool == type ||
+				primec_type_kind_enum == kind || primec_type_kind_func == kind));
+
+			if (!is_comparable)
+			{
+				report_error(checker, node, "values of type `%s` cannot be compared with `%s`.",
+					format_type(checker, type, buffer), primec_token_type_to_string(operator)
+				);
+
+				return set_type(checker, node, primec_type_error, 0);
+			}
+
+			(void)default_untyped(checker, expression->lhs);
+			(void)default_untyped(checker, expression->rhs);
+			return set_type(checker, node, primec_type_bool, 0);
+		} break;
+
+		default:
+		{
+			primec_debug_assert(0);
+			return set_type(checker, node, primec_type_error, 0);
+		} break;
+	}
+}
+
+static primec_type_t check_assign(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_token_type_e operator = (primec_token_type_e)primec_ast_get_token(checker->ast, expression->token)->type;
+	primec_type_t type = check_expression(checker, expression->lhs);
+	primec_sema_node_s* const target = get_node(checker, expression->lhs);
+	primec_type_table_s* const types = checker->sema->types;
+	char buffer[type_buffer_capacity] = {0};
+
+	if (primec_type_error == type)
+	{
+		(void)check_expression(checker, expression->rhs);
+		return set_type(checker, node, primec_type_void, 0);
+	}
+
+	// NOTE: Assigning to a reference assigns to the value it refers to.
+	if (primec_type_kind_reference == get_kind(checker, type) &&
+		get_kind(checker, get_element(checker, type)) != primec_type_kind_slice)
+	{
+		if (!is_mutable_reference(checker, type))
+		{
+			report_error(checker, expression->lhs, "cannot assign through an immutable reference.");
+		}
+
+		target->coercion = primec_sema_coercion_deref;
+		target->target = get_element(checker, type);
+		type = target->target;
+	}
+	else if (!(target->flags & primec_sema_flag_place))
+	{
+		report_error(checker, expression->lhs, "cannot assign to this expression.");
+	}
+	else if (!(target->flags & primec_sema_flag_mutable))
+	{
+		report_error(checker, expression->lhs, "cannot assign to an immutable location.");
+	}
+
+	switch (operator)
+	{
+		case primec_token_type_assign:
+		{
+			expect_expression(checker, expression->rhs, type);
+		} break;
+
+		case primec_token_type_lshift_assign:
+		case primec_token_type_rshift_assign:
+		{
+			const primec_type_t value = check_value(checker, expression->rhs);
+			(void)default_untyped(checker, expression->rhs);
+
+			if (!primec_type_is_integer(types, type) || (value != primec_type_error && !primec_type_is_integer(types, value)))
+			{
+				report_error(checker, node, "operands of `%s` must be integers.", primec_token_type_to_string(operator));
+			}
+		} break;
+
+		case primec_token_type_land_assign:
+		case primec_token_type_lor_assign:
+		case primec_token_type_lxor_assign:
+		{
+			const primec_type_t value = check_value(checker, expression->rhs);
+			(void)default_untyped(checker, expression->rhs);
+
+			if ((type != primec_type_bool && !primec_type_is_integer(types, type)) ||
+				(value != primec_type_error && value != primec_type_bool && !primec_type_is_integer(types, value)))
+			{
+				report_error(checker, node, "operands of `%s` must be booleans or integers.", primec_token_type_to_string(operator));
+			}
+		} break;
+
+		default:
+		{
+			const bool is_integral = primec_token_type_modulus_assign == operator || operator >= primec_token_type_band_assign;
+
+			if (is_integral ? !primec_type_is_integer(types, type) : !is_numeric(checker, type))
+			{
+				report_error(checker, node, "operands of `%s` must be %s, but found `%s`.", primec_token_type_to_string(operator),
+					is_integral ? "integers" : "numbers", format_type(checker, type, buffer)
+				);
+			}
+
+			(void)check_value(checker, expression->rhs);
+			expect_type(checker, expression->rhs, type);
+		} break;
+	}
+
+	return set_type(checker, node, primec_type_void, 0);
+}
+
+static primec_type_t check_cast(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t to = resolve_type(checker, expression->rhs, NULL);
+	primec_type_t from = check_expression(checker, expression->lhs);
+
+	if (primec_type_error == to || primec_type_error == from)
+	{
+		return set_type(checker, node, to, 0);
+	}
+
+	const uint8_t to_kind = get_kind(checker, to);
+	const bool is_scalar_target = is_numeric(checker, to) || primec_type_c8 == to || primec_type_kind_enum == to_kind;
+
+	if (is_scalar_target || (primec_type_kind_reference != to_kind && primec_type_kind_pointer != to_kind))
+	{
+		from = check_value(checker, expression->lhs);
+	}
+
+	(void)default_untyped(checker, expression->lhs);
+	from = get_node(checker, expression->lhs)->target;
+	const uint8_t from_kind = get_kind(checker, from);
+	const bool is_scalar_source = is_numeric(checker, from) || primec_type_c8 == from || primec_type_bool == from ||
+		primec_type_kind_enum == from_kind;
+	const bool is_address_source = primec_type_kind_pointer == from_kind || primec_type_kind_reference == from_kind;
+
+	// NOTE: Scalars convert to each other, and addresses convert to pointers and
+	//       to the 64-bit integers.
+	const bool is_valid = from == to ||
+		(is_scalar_target && is_scalar_source) ||
+		(primec_type_kind_pointer == to_kind && (is_address_source || primec_type_is_integer(checker->sema->types, from))) ||
+		((primec_type_u64 == to || primec_type_i64 == to) && is_address_source);
+
+	if (!is_valid)
+	{
+		char from_buffer[type_buffer_capacity] = {0};
+		char to_buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "cannot cast `%s` to `%s`.", format_type(checker, from, from_buffer), format_type(checker, to, to_buffer));
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	return set_type(checker, node, to, 0);
+}
+
+static primec_type_t check_call(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t callee = check_value(checker, expression->lhs);
+	const primec_ast_range_s arguments = primec_ast_get_range(checker->ast, expression->rhs);
+	const uint32_t arguments_count = arguments.end - arguments.start;
+
+	if (primec_type_error == callee || get_kind(checker, callee) != primec_type_kind_func)
+	{
+		if (callee != primec_type_error)
+		{
+			char buffer[type_buffer_capacity] = {0};
+			report_error(checker, expression->lhs, "cannot call a value of type `%s`.", format_type(checker, callee, buffer));
+		}
+
+		for (primec_ast_index_t extra = arguments.start; extra < arguments.end; ++extra)
+		{
+			(void)check_expression(checker, primec_ast_get_extra(checker->ast, extra));
+		}
+
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	const primec_type_s* const func = primec_type_table_get(checker->sema->types, callee);
+	const primec_type_t* const params = primec_type_table_get_list(checker->sema->types, callee);
+	const bool is_variadic = (func->flags & primec_type_flag_variadic) != 0;
+
+	if (arguments_count < func->list.count || (arguments_count > func->list.count && !is_variadic))
+	{
+		report_error(checker, node, "expected %s%u arguments, but found %u.", is_variadic ? "at least " : "",
+			func->list.count, arguments_count
+		);
+	}
+
+	for (uint32_t index = 0; index < arguments_count; ++index)
+	{
+		const primec_ast_index_t argument = primec_ast_get_extra(checker->ast, arguments.start + index);
+
+		if (index < func->list.count)
+		{
+			expect_expression(checker, argument, params[index]);
+			continue;
+		}
+
+		// NOTE: The variadic arguments are passed as they are, with the untyped
+		//       constants taking their default types.
+		(void)check_value(checker, argument);
+		(void)default_untyped(checker, argument);
+	}
+
+	return set_type(checker, node, func->element, 0);
+}
+
+static primec_type_t check_index(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t base = check_expression(checker, expression->lhs);
+	const primec_sema_node_s* const base_info = get_node(checker, expression->lhs);
+	primec_type_t element = primec_type_error;
+	uint8_t flags = primec_sema_flag_place;
+
+	switch (get_kind(checker, base))
+	{
+		case primec_type_kind_array:
+		case primec_type_kind_slice:
+		{
+			element = get_element(checker, base);
+			flags = base_info->flags & (primec_sema_flag_place | primec_sema_flag_mutable);
+		} break;
+
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		{
+			const primec_type_t pointee = get_element(checker, base);
+			const uint8_t pointee_kind = get_kind(checker, pointee);
+
+			// NOTE: Pointers are indexed as arrays of their pointees, while
+			//       references are indexed only when they refer to arrays or
+			//       slices.
+			if (primec_type_kind_array == pointee_kind || primec_type_kind_slice == pointee_kind)
+			{
+				element = get_element(checker, pointee);
+			}
+			else if (primec_type_kind_pointer == get_kind(checker, base))
+			{
+				element = pointee;
+			}
+
+			if (is_mutable_reference(checker, base)) { flags |= primec_sema_flag_mutable; }
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	if (primec_type_error == element && base != primec_type_error)
+	{
+		char buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "cannot index into a value of type `%s`.", format_type(checker, base, buffer));
+	}
+
+	primec_ast_index_t indices[2] = { expression->rhs, primec_ast_null };
+
+	if (primec_ast_kind_slice == expression->kind)
+	{
+		const primec_ast_slice_s record = primec_ast_get_slice(checker->ast, expression->rhs);
+		indices[0] = record.start;
+		indices[1] = record.end;
+	}
+
+	for (uint32_t index = 0; index < 2; ++index)
+	{
+		if (primec_ast_null == indices[index]) { continue; }
+		const primec_type_t type = check_value(checker, indices[index]);
+
+		if (type != primec_type_error && !primec_type_is_integer(checker->sema->types, type))
+		{
+			char buffer[type_buffer_capacity] = {0};
+			report_error(checker, indices[index], "index must be an integer, but found `%s`.", format_type(checker, type, buffer));
+		}
+
+		if (primec_type_untyped_int == type) { finalize_untyped(checker, indices[index], primec_type_u64); }
+	}
+
+	if (primec_type_error == element)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	if (primec_ast_kind_slice == expression->kind)
+	{
+		return set_type(checker, node, primec_type_table_get_slice(checker->sema->types, element), flags);
+	}
+
+	return set_type(checker, node, element, flags);
+}
+
+static primec_type_t check_member(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t base = check_expression(checker, expression->lhs);
+	const primec_sema_node_s* const base_info = get_node(checker, expression->lhs);
+	const primec_symbol_t symbol = get_symbol(checker, expression->token);
+	primec_type_t type = base;
+	uint8_t flags = base_info->flags & (primec_sema_flag_place | primec_sema_flag_mutable);
+
+	if (primec_type_error == base)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	// NOTE: Members are accessed through references and pointers directly.
+	if (primec_type_kind_reference == get_kind(checker, type) || primec_type_kind_pointer == get_kind(checker, type))
+	{
+		flags = primec_sema_flag_place | (is_mutable_reference(checker, type) ? primec_sema_flag_mutable : 0);
+		type = get_element(checker, type);
+	}
+
+	const uint8_t kind = get_kind(checker, type);
+
+	// NOTE: Arrays and slices have a single builtin member, their count.
+	if ((primec_type_kind_array == kind || primec_type_kind_slice == kind) &&
+		0 == primec_utils_strcmp(primec_symbols_get_text(checker->sema->symbols, symbol), "count"))
+	{
+		set_type(checker, node, primec_type_u64, 0);
+		get_node(checker, node)->node = primec_sema_member_count;
+		return primec_type_u64;
+	}
+
+	if (kind != primec_type_kind_struct)
+	{
+		char buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "value of type `%s` has no member `%s`.",
+			format_type(checker, base, buffer), primec_symbols_get_text(checker->sema->symbols, symbol)
+		);
+
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	const primec_type_s* const record = primec_type_table_get(checker->sema->types, type);
+	const uint32_t module = checker->sema->graph->modules_by_file.data[record->nominal.file] - 1;
+	const primec_ast_s* const ast = &checker->sema->modules[module].module->ast;
+	const primec_ast_range_s fields = primec_ast_get_list(ast, record->nominal.node);
+
+	for (uint32_t index = 0; index < fields.end - fields.start; ++index)
+	{
+		const primec_ast_index_t field = primec_ast_get_extra(ast, fields.start + index);
+
+		if (checker->sema->scopes[module].tokens[primec_ast_get_node(ast, field)->token] == symbol)
+		{
+			set_type(checker, node, primec_type_table_get_list(checker->sema->types, type)[index], flags);
+			get_node(checker, node)->module = module;
+			get_node(checker, node)->node = index;
+			return get_node(checker, node)->type;
+		}
+	}
+
+	report_error(checker, node, "struct `%s` has no field `%s`.", record->name, primec_symbols_get_text(checker->sema->symbols, symbol));
+	return set_type(checker, node, primec_type_error, 0);
+}
+
+static primec_type_t check_address_of(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const bool is_mutable = expression->rhs != 0;
+	const primec_type_t type = check_expression(checker, expression->lhs);
+	const primec_sema_node_s* const operand = get_node(checker, expression->lhs);
+
+	if (primec_type_error == type)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	if (!(operand->flags & primec_sema_flag_place))
+	{
+		report_error(checker, node, "cannot take a reference to a temporary value.");
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	if (is_mutable && !(operand->flags & primec_sema_flag_mutable))
+	{
+		report_error(checker, node, "cannot take a mutable reference to an immutable location.");
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	return set_type(checker, node, primec_type_table_get_reference(checker->sema->types, type, is_mutable), 0);
+}
+
+static primec_type_t check_deref(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t type = check_expression(checker, expression->lhs);
+	const uint8_t kind = get_kind(checker, type);
+
+	if (primec_type_error == type)
+	{
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	if (kind != primec_type_kind_reference && kind != primec_type_kind_pointer)
+	{
+		char buffer[type_buffer_capacity] = {0};
+		report_error(checker, node, "cannot dereference a value of type `%s`.", format_type(checker, type, buffer));
+		return set_type(checker, node, primec_type_error, 0);
+	}
+
+	return set_type(checker, node, get_element(checker, type),
+		primec_sema_flag_place | (is_mutable_reference(checker, type) ? primec_sema_flag_mutable : 0)
+	);
+}
+
+static primec_type_t check_lambda(
+	checker_s* const checker,
+	const primec_ast_index_t node)
+{
+	const primec_ast_node_s* const expression = primec_ast_get_node(checker->ast, node);
+	const primec_type_t type = resolve_proto(checker, expression->lhs);
+
+	const primec_type_t return_type = checker->return_type;
+	const uint32_t loops = checker->loops;
+	const uint32_t breaks = checker->breaks;
+	const uint32_t barrier = checker->barrier;
+
+	checker->loops = 0;
+	checker->breaks = 0;
+	checker->barrier = checker->resolver.bindings.count;
+	check_function(checker, expression->lhs, expression->rhs);
+
+	checker->return_type = return_type;
+	checker->loops = loops;
+	checker->breaks = breaks;
+	checker->barrier = barrier;
+	return set_type(checker, node, type, 0);
+}
+
+static bool is_numeric(
+	const checker_s* const checker,
+	const primec_type_t type)
+{
+	return primec_type_is_integer(checker->sema->types, type) || primec_type_is_float(checker->sema->types, type);
+}
+
+static bool is_untyped(
+	const primec_type_t type)
+{
+	return primec_type_untyped_int == type || primec_type_untyped_float == type;
+}
+
+static uint8_t get_kind(
+	const checker_s* const checker,
+	const primec_type_t type)
+{
+	return primec_type_table_get(checker->sema->types, type)->kind;
+}
+
+static primec_type_t get_element(
+	const checker_s* const checker,
+	const primec_type_t type)
+{
+	return primec_type_table_get(checker->sema->types, type)->element;
+}
+
+static bool is_mutable_reference(
+	const checker_s* const checker,
+	const primec_type_t type)
+{
+	return (primec_type_table_get(checker->sema->types, type)->flags & primec_type_flag_mut) != 0;
+}
@@ -0,0 +1,489 @@
+
+/**
+ * @file source_manager.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/source_manager.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdio.h>
+
+#include <sys/stat.h>
+#include <pthread.h>
+
+typedef enum
+{
+	state_registered,
+	state_loading,
+	state_loaded,
+} state_e;
+
+typedef struct
+{
+	char* path;
+	uint64_t device;
+	uint64_t inode;
+	state_e state;
+	char* text;
+	uint32_t length;
+
+	struct
+	{
+		uint32_t* data;
+		uint32_t count;
+	} lines;
+
+	// NOTE: Column of the last location asked for, so the locations asked for
+	//       in order along a long line continue the counting from it.
+	struct
+	{
+		uint32_t line;
+		uint32_t offset;
+		uint32_t column;
+	} last;
+} file_s;
+
+static struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t file_loaded;
+
+	struct
+	{
+		file_s** data;
+		uint32_t capacity;
+		uint32_t count;
+	} files;
+
+	// NOTE: Open addressing table from device and inode to file id plus one (0
+	//       marks an empty bucket), its capacity is always a power of two.
+	struct
+	{
+		uint32_t* data;
+		uint32_t capacity;
+	} buckets;
+} g_source_manager =
+{
+	.mutex = PTHREAD_MUTEX_INITIALIZER,
+	.file_loaded = PTHREAD_COND_INITIALIZER
+};
+
+static file_s* get_file_locked(
+	const uint32_t file);
+
+static uint32_t add_file_locked(
+	file_s* const entry);
+
+static uint32_t hash_file_key(
+	const uint64_t device,
+	const uint64_t inode);
+
+static uint32_t* find_bucket_locked(
+	const uint64_t device,
+	const uint64_t inode);
+
+static void grow_buckets_locked(
+	void);
+
+static void read_file(
+	file_s* const file);
+
+static void compute_lines_locked(
+	file_s* const file);
+
+static uint32_t find_line_index_locked(
+	const file_s* const file,
+	const uint32_t offset);
+
+bool primec_source_manager_add_file(
+	const char* const path,
+	uint32_t* const file,
+	bool* const is_new)
+{
+	primec_debug_assert(path != NULL);
+	primec_debug_assert(file != NULL);
+	primec_debug_assert(is_new != NULL);
+
+	typedef struct stat file_stats_s;
+	file_stats_s file_stats = {0};
+
+	if (stat(path, &file_stats) != 0)
+	{
+		return false;
+	}
+
+	if (S_ISDIR(file_stats.st_mode))
+	{
+		errno = EISDIR;
+		return false;
+	}
+
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+
+	if (2 * (g_source_manager.files.count + 1) > g_source_manager.buckets.capacity)
+	{
+		grow_buckets_locked();
+	}
+
+	uint32_t* const bucket = find_bucket_locked((uint64_t)file_stats.st_dev, (uint64_t)file_stats.st_ino);
+
+	if (*bucket != 0)
+	{
+		*file = *bucket - 1;
+		*is_new = false;
+		(void)pthread_mutex_unlock(&g_source_manager.mutex);
+		return true;
+	}
+
+	file_s* const entry = primec_utils_malloc(sizeof(file_s));
+	primec_utils_memset((void*)entry, 0, sizeof(file_s));
+	entry->path = primec_utils_strdup(path);
+	entry->device = (uint64_t)file_stats.st_dev;
+	entry->inode = (uint64_t)file_stats.st_ino;
+	entry->state = state_registered;
+
+	*file = add_file_locked(entry);
+	*is_new = true;
+	*bucket = *file + 1;
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return true;
+}
+
+uint32_t primec_source_manager_add_text(
+	const char* const path,
+	const char* const text,
+	const uint32_t length)
+{
+	primec_debug_assert(path != NULL);
+	primec_debug_assert(text != NULL);
+
+	// NOTE: The file is loaded right away and it is left out of the buckets,
+	//       as it has no device and inode (no real file has the inode 0).
+	file_s* const entry = primec_utils_malloc(sizeof(file_s));
+	primec_utils_memset((void*)entry, 0, sizeof(file_s));
+	entry->path = primec_utils_strdup(path);
+	entry->state = state_loaded;
+	entry->text = primec_utils_malloc((uint64_t)length + 1);
+	if (length > 0) { primec_utils_memcpy(entry->text, text, length); }
+	entry->text[length] = 0;
+	entry->length = length;
+
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+	const uint32_t file = add_file_locked(entry);
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return file;
+}
+
+primec_source_view_s primec_source_manager_get_view(
+	const uint32_t file)
+{
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+	file_s* const entry = get_file_locked(file);
+
+	if (state_registered == entry->state)
+	{
+		// NOTE: The file is read without holding the lock, so different files
+		//       are read in parallel, while the other requests of the same file
+		//       wait for this one to finish.
+		entry->state = state_loading;
+		(void)pthread_mutex_unlock(&g_source_manager.mutex);
+		read_file(entry);
+		(void)pthread_mutex_lock(&g_source_manager.mutex);
+		entry->state = state_loaded;
+		(void)pthread_cond_broadcast(&g_source_manager.file_loaded);
+	}
+
+	while (entry->state != state_loaded)
+	{
+		(void)pthread_cond_wait(&g_source_manager.file_loaded, &g_source_manager.mutex);
+	}
+
+	const primec_source_view_s view =
+	{
+		.data = entry->text,
+		.length = entry->length,
+		.file = file
+	};
+
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return view;
+}
+
+const char* primec_source_manager_get_path(
+	const uint32_t file)
+{
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+	const char* const path = get_file_locked(file)->path;
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return path;
+}
+
+uint32_t primec_source_manager_get_line(
+	const primec_location_s location)
+{
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+	file_s* const file = get_file_locked(location.file);
+	compute_lines_locked(file);
+	const uint32_t line = find_line_index_locked(file, location.offset) + 1;
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return line;
+}
+
+uint32_t primec_source_manager_get_column(
+	const primec_location_s location)
+{
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+	file_s* const file = get_file_locked(location.file);
+	compute_lines_locked(file);
+	const uint32_t line = find_line_index_locked(file, location.offset);
+	uint32_t offset = file->lines.data[line];
+	uint32_t column = 1;
+
+	// NOTE: The counting starts from the last location, if it is on the same
+	//       line and closer than the start of the line, in either direction.
+	if (file->last.column > 0 && file->last.line == line)
+	{
+		if (file->last.offset <= location.offset)
+		{
+			offset = file->last.offset;
+			column = file->last.column;
+		}
+		else if (file->last.offset - location.offset < location.offset - offset)
+		{
+			offset = file->last.offset;
+			column = file->last.column;
+
+			for (; offset > location.offset; --offset)
+			{
+				if ((file->text[offset - 1] & 0xC0) != 0x80) { --column; }
+			}
+		}
+	}
+
+	// NOTE: Columns are counted in utf-8 symbols, so only the leading bytes of
+	//       the symbols are counted.
+	for (; offset < location.offset && offset < file->length; ++offset)
+	{
+		if ((file->text[offset] & 0xC0) != 0x80) { ++column; }
+	}
+
+	file->last.line = line;
+	file->last.offset = offset;
+	file->last.column = column;
+
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+	return column;
+}
+
+void primec_source_manager_destroy(
+	void)
+{
+	(void)pthread_mutex_lock(&g_source_manager.mutex);
+
+	for (uint32_t index = 0; index < g_source_manager.files.count; ++index)
+	{
+		file_s* const file = g_source_manager.files.data[index];
+		primec_utils_free(file->lines.data);
+		primec_utils_free(file->text);
+		primec_utils_free(file->path);
+		primec_utils_free(file);
+	}
+
+	primec_utils_free(g_source_manager.files.data);
+	primec_utils_free(g_source_manager.buckets.data);
+	g_source_manager.files.data = NULL;
+	g_source_manager.files.capacity = 0;
+	g_source_manager.files.count = 0;
+	g_source_manager.buckets.data = NULL;
+	g_source_manager.buckets.capacity = 0;
+	(void)pthread_mutex_unlock(&g_source_manager.mutex);
+}
+
+static file_s* get_file_locked(
+	const uint32_t file)
+{
+	primec_debug_assert(file < g_source_manager.files.count);
+	return g_source_manager.files.data[file];
+}
+
+static uint32_t add_file_locked(
+	file_s* const entry)
+{
+	primec_debug_assert(entry != NULL);
+
+	if (g_source_manager.files.count >= g_source_manager.files.capacity)
+	{
+		g_source_manager.files.capacity = 0 == g_source_manager.files.capacity ? 16 : g_source_manager.files.capacity * 2;
+		g_source_manager.files.data = primec_utils_realloc(
+			g_source_manager.files.data, g_source_manager.files.capacity * sizeof(file_s*)
+		);
+	}
+
+	g_source_manager.files.data[g_source_manager.files.count] = entry;
+	return g_source_manager.files.count++;
+}
+
+static uint32_t hash_file_key(
+	const uint64_t device,
+	const uint64_t inode)
+{
+	uint64_t hash = (inode ^ (device * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+	hash ^= hash >> 31;
+	return (uint32_t)hash;
+}
+
+static uint32_t* find_bucket_locked(
+	const uint64_t device,
+	const uint64_t inode)
+{
+	primec_debug_assert(g_source_manager.buckets.capacity > 0);
+	const uint32_t mask = g_source_manager.buckets.capacity - 1;
+	uint32_t index = hash_file_key(device, inode) & mask;
+
+	while (g_source_manager.buckets.data[index] != 0)
+	{
+		const file_s* const file = g_source_manager.files.data[g_source_manager.buckets.data[index] - 1];
+
+		if (file->device == device && file->inode == inode)
+		{
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return &g_source_manager.buckets.data[index];
+}
+
+static void grow_buckets_locked(
+	void)
+{
+	primec_utils_free(g_source_manager.buckets.data);
+	g_source_manager.buckets.capacity = 0 == g_source_manager.buckets.capacity ? 64 : g_source_manager.buckets.capacity * 2;
+	g_source_manager.buckets.data = primec_utils_malloc(g_source_manager.buckets.capacity * sizeof(uint32_t));
+	primec_utils_memset(g_source_manager.buckets.data, 0, g_source_manager.buckets.capacity * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < g_source_manager.files.count; ++index)
+	{
+		const file_s* const file = g_source_manager.files.data[index];
+		if (0 == file->inode) { continue; }
+		*find_bucket_locked(file->device, file->inode) = index + 1;
+	}
+}
+
+static void read_file(
+	file_s* const file)
+{
+	primec_debug_assert(file != NULL);
+	FILE* const stream = fopen(file->path, "rb");
+
+	if (NULL == stream)
+	{
+		primec_logger_error("unable to open %s for reading -- failed to open.", file->path);
+		exit(-1);
+	}
+
+	uint64_t capacity = 4096;
+	uint64_t length = 0;
+	char* text = primec_utils_malloc(capacity);
+
+	while (true)
+	{
+		if (length + 1 >= capacity)
+		{
+			capacity *= 2;
+			text = primec_utils_realloc(text, capacity);
+		}
+
+		const uint64_t read = fread(text + length, 1, capacity - length - 1, stream);
+		if (0 == read) { break; }
+		length += read;
+	}
+
+	const bool failed = ferror(stream) != 0;
+	(void)fclose(stream);
+
+	if (failed)
+	{
+		primec_logger_error("unable to read %s -- failed to read.", file->path);
+		exit(-1);
+	}
+
+	if (length >= UINT32_MAX)
+	{
+		primec_logger_error("unable to read %s -- file is too big (more than 4 GiB).", file->path);
+		exit(-1);
+	}
+
+	text[length] = 0;
+	file->text = text;
+	file->length = (uint32_t)length;
+}
+
+static void compute_lines_locked(
+	file_s* const file)
+{
+	primec_debug_assert(file != NULL);
+	primec_debug_assert(state_loaded == file->state);
+
+	if (file->lines.data != NULL)
+	{
+		return;
+	}
+
+	uint32_t count = 1;
+
+	for (uint32_t index = 0; index < file->length; ++index)
+	{
+		if ('\n' == file->text[index]) { ++count; }
+	}
+
+	file->lines.data = primec_utils_malloc(count * sizeof(uint32_t));
+	file->lines.data[0] = 0;
+	file->lines.count = 1;
+
+	for (uint32_t index = 0; index < file->length; ++index)
+	{
+		if ('\n' == file->text[index]) { file->lines.data[file->lines.count++] = index + 1; }
+	}
+}
+
+static uint32_t find_line_index_locked(
+	const file_s* const file,
+	const uint32_t offset)
+{
+	primec_debug_assert(file != NULL);
+	primec_debug_assert(file->lines.count > 0);
+
+	uint32_t low = 0;
+	uint32_t high = file->lines.count;
+
+	while (high - low > 1)
+	{
+		const uint32_t middle = low + (high - low) / 2;
+
+		if (file->lines.data[middle] <= offset)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
@@ -0,0 +1,138 @@
+
+/**
+ * @file string_pool.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/string_pool.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+static int compare_reversed(
+	const void* const left,
+	const void* const right);
+
+static bool is_suffix(
+	const primec_ir_string_s* const string,
+	const primec_ir_string_s* const other);
+
+primec_string_pool_s primec_string_pool_from_program(
+	const primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+	const uint32_t strings_count = program->strings.count;
+
+	primec_string_pool_s pool =
+	{
+		.offsets = primec_utils_malloc((strings_count > 0 ? strings_count : 1) * sizeof(uint64_t))
+	};
+
+	if (0 == strings_count)
+	{
+		pool.data = primec_utils_malloc(1);
+		return pool;
+	}
+
+	// NOTE: Sorting by the reversed characters puts every string right before
+	//       the strings, that end with it, so walking the order backwards, each
+	//       string is either the suffix of the one after it, or starts a new
+	//       tail of its own.
+	const primec_ir_string_s** const order = primec_utils_malloc(strings_count * sizeof(primec_ir_string_s*));
+
+	for (uint32_t index = 0; index < strings_count; ++index)
+	{
+		order[index] = &program->strings.data[index];
+	}
+
+	qsort((void*)order, strings_count, sizeof(primec_ir_string_s*), compare_reversed);
+
+	for (uint32_t index = strings_count; index-- > 0;)
+	{
+		if (index + 1 == strings_count || !is_suffix(order[index], order[index + 1]))
+		{
+			pool.size += order[index]->length + 1;
+		}
+	}
+
+	pool.data = primec_utils_malloc(pool.size);
+	uint64_t size = 0;
+
+	for (uint32_t index = strings_count; index-- > 0;)
+	{
+		const primec_ir_string_s* const string = order[index];
+		const uint64_t string_index = (uint64_t)(string - program->strings.data);
+
+		if (index + 1 < strings_count && is_suffix(string, order[index + 1]))
+		{
+			const primec_ir_string_s* const next = order[index + 1];
+			const uint64_t next_index = (uint64_t)(next - program->strings.data);
+			pool.offsets[string_index] = pool.offsets[next_index] + next->length - string->length;
+			continue;
+		}
+
+		pool.offsets[string_index] = size;
+		if (string->length > 0) { primec_utils_memcpy(&pool.data[size], string->data, string->length); }
+		pool.data[size + string->length] = '\0';
+		size += string->length + 1;
+	}
+
+	primec_debug_assert(size == pool.size);
+	primec_utils_free((void*)order);
+	return pool;
+}
+
+void primec_string_pool_destroy(
+	primec_string_pool_s* const pool)
+{
+	primec_debug_assert(pool != NULL);
+	primec_utils_free(pool->data);
+	primec_utils_free(pool->offsets);
+	*pool = (primec_string_pool_s) {0};
+}
+
+static int compare_reversed(
+	const void* const left,
+	const void* const right)
+{
+	const primec_ir_string_s* const left_string = *(const primec_ir_string_s* const*)left;
+	const primec_ir_string_s* const right_string = *(const primec_ir_string_s* const*)right;
+	uint64_t left_index = left_string->length;
+	uint64_t right_index = right_string->length;
+
+	while (left_index > 0 && right_index > 0)
+	{
+		const uint8_t left_char = (uint8_t)left_string->data[--left_index];
+		const uint8_t right_char = (uint8_t)right_string->data[--right_index];
+
+		if (left_char != right_char)
+		{
+			return left_char < right_char ? -1 : 1;
+		}
+	}
+
+	// NOTE: The shorter string goes first, being the suffix of the longer one.
+	return left_index == right_index ? 0 : (0 == left_index ? -1 : 1);
+}
+
+static bool is_suffix(
+	const primec_ir_string_s* const string,
+	const primec_ir_string_s* const other)
+{
+	if (string->length > other->length)
+	{
+		return false;
+	}
+
+	return 0 == string->length ||
+		0 == primec_utils_memcmp(string->data, other->data + other->length - string->length, string->length);
+}
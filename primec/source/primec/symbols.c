@@ -0,0 +1,255 @@
+
+/**
+ * @file symbols.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/symbols.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+#define entries_page_bits 10
+#define entries_page_size (1u << entries_page_bits)
+#define entries_pages_capacity 16384u
+#define texts_chunk_size (64u * 1024u)
+
+static primec_symbol_entry_s* get_entry(
+	const primec_symbols_s* const symbols,
+	const primec_symbol_t symbol);
+
+static uint32_t* find_bucket_locked(
+	const primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length,
+	const uint32_t hash);
+
+static void grow_buckets_locked(
+	primec_symbols_s* const symbols);
+
+static const char* store_text_locked(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length);
+
+static primec_symbol_t intern_locked(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length);
+
+primec_symbols_s* primec_symbols_create(
+	void)
+{
+	primec_symbols_s* const symbols = primec_utils_malloc(sizeof(primec_symbols_s));
+	primec_utils_memset((void*)symbols, 0, sizeof(primec_symbols_s));
+
+	if (pthread_mutex_init(&symbols->mutex, NULL) != 0)
+	{
+		primec_logger_panic("internal failure -- failed to initialize symbols");
+	}
+
+	symbols->entries.pages = primec_utils_malloc(entries_pages_capacity * sizeof(primec_symbol_entry_s*));
+	grow_buckets_locked(symbols);
+
+	// NOTE: The first entry is the null symbol, which is never found by text.
+	symbols->entries.pages[0] = primec_utils_malloc(entries_page_size * sizeof(primec_symbol_entry_s));
+	symbols->entries.pages[0][0] = (primec_symbol_entry_s) { .text = "", .length = 0, .hash = 0 };
+	symbols->entries.count = 1;
+	return symbols;
+}
+
+void primec_symbols_destroy(
+	primec_symbols_s* const symbols)
+{
+	primec_debug_assert(symbols != NULL);
+
+	for (uint32_t page = 0; page < (symbols->entries.count + entries_page_size - 1) / entries_page_size; ++page)
+	{
+		primec_utils_free(symbols->entries.pages[page]);
+	}
+
+	for (uint32_t chunk = 0; chunk < symbols->texts.count; ++chunk)
+	{
+		primec_utils_free(symbols->texts.chunks[chunk]);
+	}
+
+	primec_utils_free(symbols->entries.pages);
+	primec_utils_free(symbols->texts.chunks);
+	primec_utils_free(symbols->buckets.data);
+	(void)pthread_mutex_destroy(&symbols->mutex);
+	primec_utils_free(symbols);
+}
+
+primec_symbol_t primec_symbols_intern(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length)
+{
+	primec_debug_assert(symbols != NULL);
+	primec_debug_assert(text != NULL);
+	(void)pthread_mutex_lock(&symbols->mutex);
+	const primec_symbol_t symbol = intern_locked(symbols, text, length);
+	(void)pthread_mutex_unlock(&symbols->mutex);
+	return symbol;
+}
+
+void primec_symbols_intern_ast(
+	primec_symbols_s* const symbols,
+	const primec_ast_s* const ast,
+	primec_symbol_t* const tokens)
+{
+	primec_debug_assert(symbols != NULL);
+	primec_debug_assert(ast != NULL);
+	primec_debug_assert(tokens != NULL);
+	(void)pthread_mutex_lock(&symbols->mutex);
+
+	for (uint32_t index = 0; index < ast->tokens.count; ++index)
+	{
+		tokens[index] = primec_symbol_null;
+
+		if (primec_token_type_identifier == ast->tokens.data[index].type)
+		{
+			const primec_token_value_s* const value = primec_ast_get_token_value(ast, index);
+			tokens[index] = intern_locked(symbols, primec_ast_get_token_text(ast, index), (uint32_t)value->text.length);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&symbols->mutex);
+}
+
+const char* primec_symbols_get_text(
+	const primec_symbols_s* const symbols,
+	const primec_symbol_t symbol)
+{
+	return get_entry(symbols, symbol)->text;
+}
+
+static primec_symbol_entry_s* get_entry(
+	const primec_symbols_s* const symbols,
+	const primec_symbol_t symbol)
+{
+	primec_debug_assert(symbols != NULL);
+	primec_debug_assert((symbol >> entries_page_bits) < entries_pages_capacity);
+	return &symbols->entries.pages[symbol >> entries_page_bits][symbol & (entries_page_size - 1)];
+}
+
+static uint32_t* find_bucket_locked(
+	const primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length,
+	const uint32_t hash)
+{
+	primec_debug_assert(symbols->buckets.capacity > 0);
+	const uint32_t mask = symbols->buckets.capacity - 1;
+	uint32_t index = hash & mask;
+
+	while (symbols->buckets.data[index] != 0)
+	{
+		const primec_symbol_entry_s* const entry = get_entry(symbols, symbols->buckets.data[index]);
+
+		if (entry->hash == hash && entry->length == length &&
+			(0 == length || 0 == primec_utils_memcmp(entry->text, text, length)))
+		{
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return &symbols->buckets.data[index];
+}
+
+static void grow_buckets_locked(
+	primec_symbols_s* const symbols)
+{
+	primec_utils_free(symbols->buckets.data);
+	symbols->buckets.capacity = 0 == symbols->buckets.capacity ? 1024 : symbols->buckets.capacity * 2;
+	symbols->buckets.data = primec_utils_malloc(symbols->buckets.capacity * sizeof(uint32_t));
+	primec_utils_memset(symbols->buckets.data, 0, symbols->buckets.capacity * sizeof(uint32_t));
+
+	for (primec_symbol_t symbol = 1; symbol < symbols->entries.count; ++symbol)
+	{
+		const primec_symbol_entry_s* const entry = get_entry(symbols, symbol);
+		*find_bucket_locked(symbols, entry->text, entry->length, entry->hash) = symbol;
+	}
+}
+
+static const char* store_text_locked(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length)
+{
+	// NOTE: Texts are never moved, so a text that does not fit the rest of the
+	//       current chunk starts a new one (of its own size, if it is longer).
+	if (0 == symbols->texts.count || symbols->texts.used + length + 1 > symbols->texts.size)
+	{
+		if (symbols->texts.count >= symbols->texts.capacity)
+		{
+			symbols->texts.capacity = 0 == symbols->texts.capacity ? 16 : symbols->texts.capacity * 2;
+			symbols->texts.chunks = primec_utils_realloc(symbols->texts.chunks, symbols->texts.capacity * sizeof(char*));
+		}
+
+		symbols->texts.size = length + 1 > texts_chunk_size ? length + 1 : texts_chunk_size;
+		symbols->texts.chunks[symbols->texts.count++] = primec_utils_malloc(symbols->texts.size);
+		symbols->texts.used = 0;
+	}
+
+	char* const stored = symbols->texts.chunks[symbols->texts.count - 1] + symbols->texts.used;
+	if (length > 0) { primec_utils_memcpy(stored, text, length); }
+	stored[length] = 0;
+	symbols->texts.used += length + 1;
+	return stored;
+}
+
+static primec_symbol_t intern_locked(
+	primec_symbols_s* const symbols,
+	const char* const text,
+	const uint32_t length)
+{
+	if (2 * (symbols->entries.count + 1) > symbols->buckets.capacity)
+	{
+		grow_buckets_locked(symbols);
+	}
+
+	const uint32_t hash = (uint32_t)primec_utils_hash(text, length);
+	uint32_t* const bucket = find_bucket_locked(symbols, text, length, hash);
+
+	if (*bucket != 0)
+	{
+		return *bucket;
+	}
+
+	const primec_symbol_t symbol = symbols->entries.count;
+
+	if (0 == (symbol & (entries_page_size - 1)))
+	{
+		if ((symbol >> entries_page_bits) >= entries_pages_capacity)
+		{
+			primec_logger_panic("internal failure -- symbols table is full");
+		}
+
+		symbols->entries.pages[symbol >> entries_page_bits] = primec_utils_malloc(
+			entries_page_size * sizeof(primec_symbol_entry_s)
+		);
+	}
+
+	*get_entry(symbols, symbol) = (primec_symbol_entry_s)
+	{
+		.text = store_text_locked(symbols, text, length),
+		.length = length,
+		.hash = hash
+	};
+
+	++symbols->entries.count;
+	*bucket = symbol;
+	return symbol;
+}
@@ -0,0 +1,398 @@
+
+/**
+ * @file tailcall.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/tailcall.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+typedef struct
+{
+	uint32_t* data;
+	uint32_t capacity;
+	uint32_t count;
+} list_s;
+
+typedef struct
+{
+	primec_ir_func_s* func;
+	list_s sites;		// blocks, whose calls are in the tail positions
+	list_s recursive;	// sites of the self-recursive calls
+	list_s pairs;		// incoming pairs of the built phi
+} rewriter_s;
+
+static void rewrite_func(
+	primec_ir_program_s* const program,
+	const uint32_t index);
+
+static bool has_slots(
+	const primec_ir_func_s* const func);
+
+static void duplicate_returns(
+	primec_ir_func_s* const func);
+
+static bool is_returning_join(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block);
+
+static void remove_entry(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_block_t predecessor);
+
+static bool is_tail_site(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block);
+
+static void build_loop(
+	rewriter_s* const rewriter);
+
+static void retarget_phis(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to);
+
+static void remove_nops(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block);
+
+static void push(
+	list_s* const list,
+	const uint32_t value);
+
+void primec_tailcall_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+		rewrite_func(program, index);
+	}
+}
+
+static void rewrite_func(
+	primec_ir_program_s* const program,
+	const uint32_t index)
+{
+	primec_ir_func_s* const func = program->funcs.data[index];
+
+	// NOTE: Arguments may point into the frame of the caller, if it has slots,
+	//       and the hidden result pointer has to be returned by the caller.
+	if ((func->flags & primec_ir_func_flag_sret) || has_slots(func)) { return; }
+
+	duplicate_returns(func);
+
+	rewriter_s rewriter = { .func = func };
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		if (!is_tail_site(func, block)) { continue; }
+
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+		const primec_ir_instruction_s* const call = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 2]);
+		const bool is_recursive = primec_ir_op_call == call->op && call->a == index;
+		push(is_recursive ? &rewriter.recursive : &rewriter.sites, block);
+	}
+
+	if (rewriter.recursive.count > 0) { build_loop(&rewriter); }
+
+	for (uint32_t site = 0; site < rewriter.sites.count; ++site)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[rewriter.sites.data[site]];
+		primec_ir_func_get(func, record->instructions.data[record->instructions.count - 2])->flags |= primec_ir_instruction_flag_tail;
+	}
+
+	primec_utils_free(rewriter.sites.data);
+	primec_utils_free(rewriter.recursive.data);
+	primec_utils_free(rewriter.pairs.data);
+}
+
+static bool has_slots(
+	const primec_ir_func_s* const func)
+{
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			if (primec_ir_op_slot == primec_ir_func_get(func, record->instructions.data[index])->op) { return true; }
+		}
+	}
+
+	return false;
+}
+
+static void duplicate_returns(
+	primec_ir_func_s* const func)
+{
+	// NOTE: Blocks, that call and jump to a join block, which only returns the
+	//       result of the call, return it themselves.
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+		if (record->instructions.count < 2) { continue; }
+
+		const primec_ir_value_t value = record->instructions.data[record->instructions.count - 2];
+		const primec_ir_instruction_s* const call = primec_ir_func_get(func, value);
+		primec_ir_instruction_s* const jump = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+
+		if (jump->op != primec_ir_op_jump || (call->op != primec_ir_op_call && call->op != primec_ir_op_call_indirect)) { continue; }
+
+		const primec_ir_block_t join = jump->a;
+		if (!is_returning_join(func, join)) { continue; }
+
+		const primec_ir_block_s* const target = &func->blocks.data[join];
+		primec_ir_value_t result = primec_ir_null;
+
+		if (2 == target->instructions.count)
+		{
+			const primec_ir_instruction_s* const phi = primec_ir_func_get(func, target->instructions.data[0]);
+			uint32_t count = 0;
+			const uint32_t* const pairs = primec_ir_func_get_list(func, phi->a, &count);
+
+			for (uint32_t index = 0; index < count; index += 2)
+			{
+				if (pairs[index] == block) { result = pairs[index + 1]; }
+			}
+
+			if (result != value) { continue; }
+			remove_entry(func, join, block);
+		}
+		else if (call->type != primec_type_void)
+		{
+			continue;
+		}
+
+		jump->op = primec_ir_op_ret;
+		jump->type = call->type;
+		jump->a = result;
+	}
+}
+
+static bool is_returning_join(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block)
+{
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+
+	if (1 == record->instructions.count)
+	{
+		const primec_ir_instruction_s* const ret = primec_ir_func_get(func, record->instructions.data[0]);
+		return primec_ir_op_ret == ret->op && primec_ir_null == ret->a;
+	}
+
+	if (record->instructions.count != 2) { return false; }
+
+	const primec_ir_value_t value = record->instructions.data[0];
+	const primec_ir_instruction_s* const ret = primec_ir_func_get(func, record->instructions.data[1]);
+	return primec_ir_op_phi == primec_ir_func_get(func, value)->op && primec_ir_op_ret == ret->op && ret->a == value;
+}
+
+static void remove_entry(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_block_t predecessor)
+{
+	primec_ir_block_s* const record = &func->blocks.data[block];
+	primec_ir_instruction_s* const phi = primec_ir_func_get(func, record->instructions.data[0]);
+
+	uint32_t count = 0;
+	uint32_t* const pairs = primec_ir_func_get_list(func, phi->a, &count);
+	uint32_t kept = 0;
+
+	for (uint32_t index = 0; index < count; index += 2)
+	{
+		if (pairs[index] == predecessor) { continue; }
+		pairs[kept] = pairs[index];
+		pairs[kept + 1] = pairs[index + 1];
+		kept += 2;
+	}
+
+	func->extra.data[phi->a] = kept;
+
+	// NOTE: Join blocks, that lost all their predecessors, are left unreachable.
+	if (0 == kept)
+	{
+		phi->op = primec_ir_op_nop;
+		primec_ir_instruction_s* const ret = primec_ir_func_get(func, record->instructions.data[1]);
+		ret->op = primec_ir_op_unreachable;
+		ret->type = primec_type_void;
+		ret->a = 0;
+		remove_nops(func, block);
+	}
+}
+
+static bool is_tail_site(
+	const primec_ir_func_s* const func,
+	const primec_ir_block_t block)
+{
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+	if (record->instructions.count < 2) { return false; }
+
+	const primec_ir_value_t value = record->instructions.data[record->instructions.count - 2];
+	const primec_ir_instruction_s* const call = primec_ir_func_get(func, value);
+	const primec_ir_instruction_s* const ret = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+
+	if (ret->op != primec_ir_op_ret || (call->op != primec_ir_op_call && call->op != primec_ir_op_call_indirect)) { return false; }
+	return ret->a == value || (primec_ir_null == ret->a && primec_type_void == call->type);
+}
+
+static void build_loop(
+	rewriter_s* const rewriter)
+{
+	primec_ir_func_s* const func = rewriter->func;
+
+	// NOTE: The entry block keeps new parameters and jumps to the header, that
+	//       takes over its instructions. The old parameters become the phis of
+	//       the header, so their uses see the arguments of the latest call.
+	const primec_ir_block_t header = primec_ir_func_add_block(func);
+	func->blocks.data[header].instructions = func->blocks.data[0].instructions;
+	primec_utils_memset(&func->blocks.data[0].instructions, 0, sizeof(func->blocks.data[0].instructions));
+
+	for (uint32_t site = 0; site < rewriter->recursive.count; ++site)
+	{
+		if (0 == rewriter->recursive.data[site]) { rewriter->recursive.data[site] = header; }
+	}
+
+	for (uint32_t site = 0; site < rewriter->sites.count; ++site)
+	{
+		if (0 == rewriter->sites.data[site]) { rewriter->sites.data[site] = header; }
+	}
+
+	primec_ir_block_t successors[2] = {0};
+	const uint32_t successors_count = primec_ir_block_get_successors(func, header, successors);
+
+	for (uint32_t index = 0; index < successors_count; ++index)
+	{
+		retarget_phis(func, successors[index], 0, header);
+	}
+
+	const uint32_t values_count = func->blocks.data[header].instructions.count;
+
+	for (uint32_t index = 0; index < values_count; ++index)
+	{
+		const primec_ir_value_t value = func->blocks.data[header].instructions.data[index];
+		const primec_ir_instruction_s param = *primec_ir_func_get(func, value);
+		if (param.op != primec_ir_op_param) { continue; }
+
+		rewriter->pairs.count = 0;
+		push(&rewriter->pairs, 0);
+		push(&rewriter->pairs, primec_ir_func_add(func, 0, primec_ir_op_param, param.type, param.a, 0));
+
+		for (uint32_t site = 0; site < rewriter->recursive.count; ++site)
+		{
+			const primec_ir_block_t block = rewriter->recursive.data[site];
+			const primec_ir_block_s* const record = &func->blocks.data[block];
+			const primec_ir_instruction_s* const call = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 2]);
+
+			uint32_t count = 0;
+			const uint32_t* const arguments = primec_ir_func_get_list(func, call->b, &count);
+			primec_debug_assert(param.a < count);
+			push(&rewriter->pairs, block);
+			push(&rewriter->pairs, arguments[param.a]);
+		}
+
+		primec_ir_instruction_s* const phi = primec_ir_func_get(func, value);
+		phi->op = primec_ir_op_phi;
+		phi->a = primec_ir_func_add_list(func, rewriter->pairs.data, rewriter->pairs.count);
+		phi->b = 0;
+	}
+
+	(void)primec_ir_func_add(func, 0, primec_ir_op_jump, primec_type_void, header, 0);
+
+	for (uint32_t site = 0; site < rewriter->recursive.count; ++site)
+	{
+		const primec_ir_block_t block = rewriter->recursive.data[site];
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		primec_ir_func_get(func, record->instructions.data[record->instructions.count - 2])->op = primec_ir_op_nop;
+		primec_ir_instruction_s* const ret = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+		ret->op = primec_ir_op_jump;
+		ret->type = primec_type_void;
+		ret->a = header;
+		remove_nops(func, block);
+	}
+
+	// NOTE: The phis are moved in front of the other instructions of the header.
+	primec_ir_block_s* const record = &func->blocks.data[header];
+	rewriter->pairs.count = 0;
+	uint32_t phis_count = 0;
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_value_t value = record->instructions.data[index];
+		if (primec_ir_op_phi == primec_ir_func_get(func, value)->op) { record->instructions.data[phis_count++] = value; }
+		else { push(&rewriter->pairs, value); }
+	}
+
+	primec_utils_memcpy(record->instructions.data + phis_count, rewriter->pairs.data, rewriter->pairs.count * sizeof(primec_ir_value_t));
+}
+
+static void retarget_phis(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to)
+{
+	const primec_ir_block_s* const record = &func->blocks.data[block];
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, record->instructions.data[index]);
+		if (instruction->op != primec_ir_op_phi) { break; }
+
+		uint32_t count = 0;
+		uint32_t* const pairs = primec_ir_func_get_list(func, instruction->a, &count);
+
+		for (uint32_t pair = 0; pair < count; pair += 2)
+		{
+			if (pairs[pair] == from) { pairs[pair] = to; }
+		}
+	}
+}
+
+static void remove_nops(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block)
+{
+	primec_ir_block_s* const record = &func->blocks.data[block];
+	uint32_t count = 0;
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		const primec_ir_value_t value = record->instructions.data[index];
+		if (primec_ir_op_nop == primec_ir_func_get(func, value)->op) { continue; }
+		record->instructions.data[count++] = value;
+	}
+
+	record->instructions.count = count;
+}
+
+static void push(
+	list_s* const list,
+	const uint32_t value)
+{
+	if (list->count >= list->capacity)
+	{
+		list->capacity = list->capacity > 0 ? list->capacity * 2 : 8;
+		list->data = primec_utils_realloc(list->data, list->capacity * sizeof(uint32_t));
+	}
+
+	list->data[list->count++] = value;
+}
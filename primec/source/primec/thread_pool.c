@@ -0,0 +1,246 @@
+
+/**
+ * @file thread_pool.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/thread_pool.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <unistd.h>
+
+static void* worker_routine(
+	void* const argument);
+
+static bool pop_task_locked(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_task_f* const task,
+	void** const context,
+	primec_thread_pool_group_s** const group);
+
+static void run_task_locked(
+	primec_thread_pool_s* const pool,
+	const primec_thread_pool_task_f task,
+	void* const context,
+	primec_thread_pool_group_s* const group);
+
+uint32_t primec_thread_pool_get_processors_count(
+	void)
+{
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count < 1 ? 1 : (uint32_t)count;
+}
+
+primec_thread_pool_s* primec_thread_pool_create(
+	const uint32_t workers_count)
+{
+	primec_thread_pool_s* const pool = primec_utils_malloc(sizeof(primec_thread_pool_s));
+	primec_utils_memset((void*)pool, 0, sizeof(primec_thread_pool_s));
+
+	if (pthread_mutex_init(&pool->mutex, NULL) != 0 ||
+		pthread_cond_init(&pool->task_available, NULL) != 0 ||
+		pthread_cond_init(&pool->task_finished, NULL) != 0)
+	{
+		primec_logger_panic("internal failure -- failed to initialize thread pool");
+	}
+
+	pool->queue.capacity = 256;
+	pool->queue.data = primec_utils_malloc(pool->queue.capacity * sizeof(primec_thread_pool_entry_s));
+	pool->should_stop = false;
+
+	if (workers_count > 0)
+	{
+		pool->workers.data = primec_utils_malloc(workers_count * sizeof(pthread_t));
+	}
+
+	for (uint32_t index = 0; index < workers_count; ++index)
+	{
+		if (pthread_create(&pool->workers.data[index], NULL, worker_routine, (void*)pool) != 0)
+		{
+			primec_logger_panic("internal failure -- failed to create worker thread");
+		}
+
+		++pool->workers.count;
+	}
+
+	return pool;
+}
+
+void primec_thread_pool_destroy(
+	primec_thread_pool_s* const pool)
+{
+	primec_debug_assert(pool != NULL);
+
+	(void)pthread_mutex_lock(&pool->mutex);
+	primec_debug_assert(0 == pool->queue.count);
+	pool->should_stop = true;
+	(void)pthread_cond_broadcast(&pool->task_available);
+	(void)pthread_mutex_unlock(&pool->mutex);
+
+	for (uint32_t index = 0; index < pool->workers.count; ++index)
+	{
+		(void)pthread_join(pool->workers.data[index], NULL);
+	}
+
+	(void)pthread_cond_destroy(&pool->task_finished);
+	(void)pthread_cond_destroy(&pool->task_available);
+	(void)pthread_mutex_destroy(&pool->mutex);
+
+	primec_utils_free(pool->workers.data);
+	primec_utils_free(pool->queue.data);
+	primec_utils_free(pool);
+}
+
+void primec_thread_pool_submit(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_group_s* const group,
+	const primec_thread_pool_task_f task,
+	void* const context)
+{
+	primec_debug_assert(pool != NULL);
+	primec_debug_assert(group != NULL);
+	primec_debug_assert(task != NULL);
+
+	(void)pthread_mutex_lock(&pool->mutex);
+
+	if (pool->queue.count >= pool->queue.capacity)
+	{
+		// NOTE: Unrolling the ring buffer into a twice as big one, so the oldest
+		//       task is at the beginning of it again.
+		const uint64_t capacity = pool->queue.capacity * 2;
+		primec_thread_pool_entry_s* const data = primec_utils_malloc(capacity * sizeof(primec_thread_pool_entry_s));
+
+		for (uint64_t index = 0; index < pool->queue.count; ++index)
+		{
+			data[index] = pool->queue.data[(pool->queue.head + index) % pool->queue.capacity];
+		}
+
+		primec_utils_free(pool->queue.data);
+		pool->queue.data = data;
+		pool->queue.capacity = capacity;
+		pool->queue.head = 0;
+	}
+
+	const uint64_t tail = (pool->queue.head + pool->queue.count) % pool->queue.capacity;
+	pool->queue.data[tail] = (primec_thread_pool_entry_s)
+	{
+		.task = task,
+		.context = context,
+		.group = group
+	};
+	++pool->queue.count;
+	++group->pending;
+
+	(void)pthread_cond_signal(&pool->task_available);
+	(void)pthread_mutex_unlock(&pool->mutex);
+}
+
+void primec_thread_pool_wait(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_group_s* const group)
+{
+	primec_debug_assert(pool != NULL);
+	primec_debug_assert(group != NULL);
+
+	(void)pthread_mutex_lock(&pool->mutex);
+
+	while (group->pending > 0)
+	{
+		primec_thread_pool_task_f task = NULL;
+		void* context = NULL;
+		primec_thread_pool_group_s* task_group = NULL;
+
+		if (pop_task_locked(pool, &task, &context, &task_group))
+		{
+			run_task_locked(pool, task, context, task_group);
+		}
+		else
+		{
+			(void)pthread_cond_wait(&pool->task_finished, &pool->mutex);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&pool->mutex);
+}
+
+static void* worker_routine(
+	void* const argument)
+{
+	primec_thread_pool_s* const pool = (primec_thread_pool_s*)argument;
+	primec_debug_assert(pool != NULL);
+
+	(void)pthread_mutex_lock(&pool->mutex);
+
+	while (true)
+	{
+		primec_thread_pool_task_f task = NULL;
+		void* context = NULL;
+		primec_thread_pool_group_s* group = NULL;
+
+		if (pop_task_locked(pool, &task, &context, &group))
+		{
+			run_task_locked(pool, task, context, group);
+			continue;
+		}
+
+		if (pool->should_stop)
+		{
+			break;
+		}
+
+		(void)pthread_cond_wait(&pool->task_available, &pool->mutex);
+	}
+
+	(void)pthread_mutex_unlock(&pool->mutex);
+	return NULL;
+}
+
+static bool pop_task_locked(
+	primec_thread_pool_s* const pool,
+	primec_thread_pool_task_f* const task,
+	void** const context,
+	primec_thread_pool_group_s** const group)
+{
+	primec_debug_assert(pool != NULL);
+
+	if (0 == pool->queue.count)
+	{
+		return false;
+	}
+
+	const primec_thread_pool_entry_s* const entry = &pool->queue.data[pool->queue.head];
+	*task = entry->task;
+	*context = entry->context;
+	*group = entry->group;
+	pool->queue.head = (pool->queue.head + 1) % pool->queue.capacity;
+	--pool->queue.count;
+	return true;
+}
+
+static void run_task_locked(
+	primec_thread_pool_s* const pool,
+	const primec_thread_pool_task_f task,
+	void* const context,
+	primec_thread_pool_group_s* const group)
+{
+	primec_debug_assert(pool != NULL);
+	primec_debug_assert(task != NULL);
+	primec_debug_assert(group != NULL);
+
+	(void)pthread_mutex_unlock(&pool->mutex);
+	task(context);
+	(void)pthread_mutex_lock(&pool->mutex);
+
+	--group->pending;
+	(void)pthread_cond_broadcast(&pool->task_finished);
+}
@@ -12,6 +12,7 @@
 
 #include <primec/token.h>
 
+#include <primec/source_manager.h>
 #include <primec/debug.h>
 #include <primec/logger.h>
 #include <primec/logger.h>
@@ -245,7 +246,7 @@ primec_token_s primec_token_from_parts(
 		(void* const)&token, 0, sizeof(primec_token_s)
 	);
 
-	token.type = type;
+	token.type = (uint8_t)type;
 	token.location = location;
 	return token;
 }
@@ -258,7 +259,7 @@ primec_token_s primec_token_from_type(
 		(void* const)&token, 0, sizeof(primec_token_s)
 	);
 
-	token.type = type;
+	token.type = (uint8_t)type;
 	return token;
 }
 
@@ -266,44 +267,17 @@ void primec_token_destroy(
 	primec_token_s* const token)
 {
 	primec_debug_assert(token != NULL);
-
-	switch (token->type)
-	{
-		case primec_token_type_single_line_comment:
-		case primec_token_type_multi_line_comment:
-		{
-			primec_utils_free(token->comment.data);
-		} break;
-
-		case primec_token_type_literal_str:
-		{
-			primec_utils_free(token->str.data);
-		} break;
-
-		case primec_token_type_identifier:
-		{
-			primec_utils_free(token->ident.data);
-		} break;
-
-		case primec_token_type_invalid:
-		{
-			primec_utils_free(token->invalid.data);
-		} break;
-	
-		default:
-		{
-		} break;
-	}
-
 	primec_utils_memset(
 		(void* const)token, 0, sizeof(primec_token_s));
 	token->type = primec_token_type_none;
 }
 
 const char* primec_token_to_string(
-	const primec_token_s* const token)
+	const primec_token_s* const token,
+	const primec_token_literals_s* const literals)
 {
 	primec_debug_assert(token != NULL);
+	primec_debug_assert(literals != NULL);
 	#define token_string_buffer_capacity 1024
 	static char token_string_buffer[token_string_buffer_capacity + 1];
 	token_string_buffer[0] = 0;
@@ -318,25 +292,24 @@ const char* primec_token_to_string(
 	switch (token->type)
 	{
 		case primec_token_type_single_line_comment:
-		{
-			written += (uint64_t)snprintf(
-				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%.*s`]", (signed int)token->comment.length, token->comment.data
-			);
-		} break;
-
 		case primec_token_type_multi_line_comment:
+		case primec_token_type_literal_str:
+		case primec_token_type_identifier:
+		case primec_token_type_invalid:
 		{
 			written += (uint64_t)snprintf(
 				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%.*s`]", (signed int)token->comment.length, token->comment.data
+				", value=`%.*s`]", (signed int)primec_token_literals_get_value(literals, token)->text.length,
+				primec_token_literals_get_text(literals, token)
 			);
 		} break;
 
 		case primec_token_type_literal_rune:
 		{
 			char rune_buffer[4];
-			const uint8_t rune_buffer_length = primec_utf8_encode(rune_buffer, token->rune);
+			const uint8_t rune_buffer_length = primec_utf8_encode(
+				rune_buffer, primec_token_literals_get_value(literals, token)->rune
+			);
 
 			written += (uint64_t)snprintf(
 				token_string_buffer + written, token_string_buffer_capacity - written,
@@ -351,7 +324,7 @@ const char* primec_token_to_string(
 		{
 			written += (uint64_t)snprintf(
 				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%li`]", token->ival
+				", value=`%li`]", primec_token_literals_get_value(literals, token)->ival
 			);
 		} break;
 
@@ -362,7 +335,7 @@ const char* primec_token_to_string(
 		{
 			written += (uint64_t)snprintf(
 				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%lu`]", token->uval
+				", value=`%lu`]", primec_token_literals_get_value(literals, token)->uval
 			);
 		} break;
 
@@ -371,31 +344,7 @@ const char* primec_token_to_string(
 		{
 			written += (uint64_t)snprintf(
 				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%Lf`]", token->fval
-			);
-		} break;
-
-		case primec_token_type_literal_str:
-		{
-			written += (uint64_t)snprintf(
-				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%.*s`]", (signed int)token->str.length, token->str.data
-			);
-		} break;
-
-		case primec_token_type_identifier:
-		{
-			written += (uint64_t)snprintf(
-				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%.*s`]", (signed int)token->ident.length, token->ident.data
-			);
-		} break;
-
-		case primec_token_type_invalid:
-		{
-			written += (uint64_t)snprintf(
-				token_string_buffer + written, token_string_buffer_capacity - written,
-				", value=`%.*s`]", (signed int)token->invalid.length, token->invalid.data
+				", value=`%Lf`]", primec_token_literals_get_value(literals, token)->fval
 			);
 		} break;
 	
@@ -411,6 +360,77 @@ const char* primec_token_to_string(
 	return token_string_buffer;
 }
 
+void primec_token_literals_destroy(
+	primec_token_literals_s* const literals)
+{
+	primec_debug_assert(literals != NULL);
+	primec_utils_free(literals->values.data);
+	primec_utils_free(literals->strings.data);
+	primec_utils_memset((void*)literals, 0, sizeof(primec_token_literals_s));
+}
+
+uint32_t primec_token_literals_push_value(
+	primec_token_literals_s* const literals,
+	const primec_token_value_s value)
+{
+	primec_debug_assert(literals != NULL);
+
+	if (literals->values.count >= literals->values.capacity)
+	{
+		literals->values.capacity = 0 == literals->values.capacity ? 256 : literals->values.capacity * 2;
+		literals->values.data = primec_utils_realloc(
+			literals->values.data, literals->values.capacity * sizeof(primec_token_value_s)
+		);
+	}
+
+	literals->values.data[literals->values.count] = value;
+	return literals->values.count++;
+}
+
+uint32_t primec_token_literals_push_text(
+	primec_token_literals_s* const literals,
+	const char* const text,
+	const uint64_t length)
+{
+	primec_debug_assert(literals != NULL);
+	primec_debug_assert(text != NULL);
+
+	if (literals->strings.length + length + 1 > literals->strings.capacity)
+	{
+		literals->strings.capacity = 0 == literals->strings.capacity ? 4096 : literals->strings.capacity;
+		while (literals->strings.length + length + 1 > literals->strings.capacity) { literals->strings.capacity *= 2; }
+		literals->strings.data = primec_utils_realloc(literals->strings.data, literals->strings.capacity);
+	}
+
+	primec_token_value_s value;
+	value.text.offset = literals->strings.length;
+	value.text.length = length;
+
+	if (length > 0) { primec_utils_memcpy(literals->strings.data + literals->strings.length, text, length); }
+	literals->strings.length += length;
+	literals->strings.data[literals->strings.length++] = 0;
+	return primec_token_literals_push_value(literals, value);
+}
+
+const primec_token_value_s* primec_token_literals_get_value(
+	const primec_token_literals_s* const literals,
+	const primec_token_s* const token)
+{
+	primec_debug_assert(literals != NULL);
+	primec_debug_assert(token != NULL);
+	primec_debug_assert(token->payload < literals->values.count);
+	return &literals->values.data[token->payload];
+}
+
+const char* primec_token_literals_get_text(
+	const primec_token_literals_s* const literals,
+	const primec_token_s* const token)
+{
+	const primec_token_value_s* const value = primec_token_literals_get_value(literals, token);
+	primec_debug_assert(value->text.offset < literals->strings.length);
+	return literals->strings.data + value->text.offset;
+}
+
 static int32_t compare_keyword_tokens(
 	const void* const left,
 	const void* const right)
@@ -0,0 +1,698 @@
+
+/**
+ * @file type_table.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/type_table.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+#include <stdio.h>
+
+// NOTE: Handles and list starts are split into a page index and an offset in
+//       the page, the pages are allocated on demand and never moved.
+#define types_page_bits 10
+#define types_page_size (1u << types_page_bits)
+#define types_pages_capacity 4096u
+#define lists_page_bits 12
+#define lists_page_size (1u << lists_page_bits)
+#define lists_pages_capacity 4096u
+
+static const char* const g_primitive_names[] =
+{
+	[primec_type_kind_void] = "void",
+	[primec_type_kind_bool] = "bool",
+	[primec_type_kind_i8] = "i8",
+	[primec_type_kind_i16] = "i16",
+	[primec_type_kind_i32] = "i32",
+	[primec_type_kind_i64] = "i64",
+	[primec_type_kind_u8] = "u8",
+	[primec_type_kind_u16] = "u16",
+	[primec_type_kind_u32] = "u32",
+	[primec_type_kind_u64] = "u64",
+	[primec_type_kind_f32] = "f32",
+	[primec_type_kind_f64] = "f64",
+	[primec_type_kind_c8] = "c8",
+	[primec_type_kind_untyped_int] = "untyped int",
+	[primec_type_kind_untyped_float] = "untyped float",
+	[primec_type_kind_error] = "<error>",
+};
+
+_Static_assert(
+	(sizeof(g_primitive_names) / sizeof(g_primitive_names[0])) == primec_type_primitives_count,
+	"g_primitive_names must cover all primitive types"
+);
+
+static primec_type_s* get_type(
+	const primec_type_table_s* const table,
+	const primec_type_t type);
+
+static const primec_type_t* get_list(
+	const primec_type_table_s* const table,
+	const primec_type_s* const type);
+
+static uint32_t hash_type(
+	const primec_type_s* const key,
+	const primec_type_t* const list);
+
+static bool is_nominal(
+	const uint8_t kind);
+
+static bool equal_types_locked(
+	const primec_type_table_s* const table,
+	const primec_type_s* const type,
+	const primec_type_s* const key,
+	const primec_type_t* const list);
+
+static uint32_t* find_bucket_locked(
+	const primec_type_table_s* const table,
+	const primec_type_s* const key,
+	const primec_type_t* const list);
+
+static void grow_buckets_locked(
+	primec_type_table_s* const table);
+
+static primec_type_t append_type_locked(
+	primec_type_table_s* const table,
+	const primec_type_s* const key);
+
+static uint32_t append_list_locked(
+	primec_type_table_s* const table,
+	const primec_type_t* const list,
+	const uint32_t count);
+
+static primec_type_t intern_type(
+	primec_type_table_s* const table,
+	const primec_type_s* const key,
+	const primec_type_t* const list);
+
+static void format_type(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	char* const buffer,
+	const uint64_t capacity,
+	uint64_t* const length);
+
+static void format_text(
+	const char* const text,
+	char* const buffer,
+	const uint64_t capacity,
+	uint64_t* const length);
+
+primec_type_table_s* primec_type_table_create(
+	void)
+{
+	primec_type_table_s* const table = primec_utils_malloc(sizeof(primec_type_table_s));
+	primec_utils_memset((void*)table, 0, sizeof(primec_type_table_s));
+
+	if (pthread_mutex_init(&table->mutex, NULL) != 0)
+	{
+		primec_logger_panic("internal failure -- failed to initialize type table");
+	}
+
+	table->types.pages = primec_utils_malloc(types_pages_capacity * sizeof(primec_type_s*));
+	table->lists.pages = primec_utils_malloc(lists_pages_capacity * sizeof(primec_type_t*));
+	grow_buckets_locked(table);
+
+	for (uint32_t kind = 0; kind < primec_type_primitives_count; ++kind)
+	{
+		const primec_type_s key =
+		{
+			.kind = (uint8_t)kind,
+			.name = g_primitive_names[kind]
+		};
+
+		const primec_type_t type = intern_type(table, &key, NULL);
+		primec_debug_assert(type == kind);
+		(void)type;
+	}
+
+	return table;
+}
+
+void primec_type_table_destroy(
+	primec_type_table_s* const table)
+{
+	primec_debug_assert(table != NULL);
+
+	for (uint32_t page = 0; page < (table->types.count + types_page_size - 1) / types_page_size; ++page)
+	{
+		primec_utils_free(table->types.pages[page]);
+	}
+
+	for (uint32_t page = 0; page < (table->lists.count + lists_page_size - 1) / lists_page_size; ++page)
+	{
+		primec_utils_free(table->lists.pages[page]);
+	}
+
+	primec_utils_free(table->types.pages);
+	primec_utils_free(table->lists.pages);
+	primec_utils_free(table->buckets.data);
+	(void)pthread_mutex_destroy(&table->mutex);
+	primec_utils_free(table);
+}
+
+const primec_type_s* primec_type_table_get(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	return get_type(table, type);
+}
+
+const primec_type_t* primec_type_table_get_list(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	return get_list(table, get_type(table, type));
+}
+
+primec_type_t primec_type_table_get_primitive(
+	const primec_token_type_e keyword)
+{
+	switch (keyword)
+	{
+		case primec_token_type_keyword_c8:  { return primec_type_c8;  } break;
+		case primec_token_type_keyword_f32: { return primec_type_f32; } break;
+		case primec_token_type_keyword_f64: { return primec_type_f64; } break;
+		case primec_token_type_keyword_i8:  { return primec_type_i8;  } break;
+		case primec_token_type_keyword_i16: { return primec_type_i16; } break;
+		case primec_token_type_keyword_i32: { return primec_type_i32; } break;
+		case primec_token_type_keyword_i64: { return primec_type_i64; } break;
+		case primec_token_type_keyword_u8:  { return primec_type_u8;  } break;
+		case primec_token_type_keyword_u16: { return primec_type_u16; } break;
+		case primec_token_type_keyword_u32: { return primec_type_u32; } break;
+		case primec_token_type_keyword_u64: { return primec_type_u64; } break;
+		default: { return primec_type_void; } break;
+	}
+}
+
+primec_type_t primec_type_table_get_reference(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const bool is_mutable)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_reference,
+		.flags = is_mutable ? primec_type_flag_mut : 0,
+		.element = element
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+primec_type_t primec_type_table_get_pointer(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const bool is_mutable)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_pointer,
+		.flags = is_mutable ? primec_type_flag_mut : 0,
+		.element = element
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+primec_type_t primec_type_table_get_array(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const uint64_t count)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_array,
+		.element = element,
+		.count = count
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+primec_type_t primec_type_table_get_slice(
+	primec_type_table_s* const table,
+	const primec_type_t element)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_slice,
+		.element = element
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+primec_type_t primec_type_table_get_vector(
+	primec_type_table_s* const table,
+	const primec_type_t element,
+	const uint64_t count)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_vector,
+		.element = element,
+		.count = count
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+primec_type_t primec_type_table_get_func(
+	primec_type_table_s* const table,
+	const primec_type_t return_type,
+	const primec_type_t* const params,
+	const uint32_t params_count,
+	const bool is_variadic)
+{
+	primec_debug_assert(params != NULL || 0 == params_count);
+
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_func,
+		.flags = is_variadic ? primec_type_flag_variadic : 0,
+		.element = return_type,
+		.list = { .count = params_count }
+	};
+
+	return intern_type(table, &key, params);
+}
+
+primec_type_t primec_type_table_get_struct(
+	primec_type_table_s* const table,
+	const uint32_t file,
+	const uint32_t node,
+	const char* const name)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_struct,
+		.nominal = { .file = file, .node = node },
+		.name = name
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+void primec_type_table_set_fields(
+	primec_type_table_s* const table,
+	const primec_type_t type,
+	const primec_type_t* const fields,
+	const uint32_t fields_count)
+{
+	primec_debug_assert(table != NULL);
+	primec_debug_assert(fields != NULL || 0 == fields_count);
+	primec_type_s* const record = get_type(table, type);
+	primec_debug_assert(primec_type_kind_struct == record->kind);
+	primec_debug_assert(!(record->flags & primec_type_flag_complete));
+
+	(void)pthread_mutex_lock(&table->mutex);
+	record->list.start = append_list_locked(table, fields, fields_count);
+	record->list.count = fields_count;
+	record->flags |= primec_type_flag_complete;
+	(void)pthread_mutex_unlock(&table->mutex);
+}
+
+void primec_type_table_set_reordered(
+	primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	primec_debug_assert(table != NULL);
+	primec_type_s* const record = get_type(table, type);
+	primec_debug_assert(primec_type_kind_struct == record->kind);
+
+	(void)pthread_mutex_lock(&table->mutex);
+	record->flags |= primec_type_flag_reordered;
+	(void)pthread_mutex_unlock(&table->mutex);
+}
+
+primec_type_t primec_type_table_get_enum(
+	primec_type_table_s* const table,
+	const uint32_t file,
+	const uint32_t node,
+	const char* const name,
+	const primec_type_t underlying)
+{
+	const primec_type_s key =
+	{
+		.kind = primec_type_kind_enum,
+		.element = underlying,
+		.nominal = { .file = file, .node = node },
+		.name = name
+	};
+
+	return intern_type(table, &key, NULL);
+}
+
+bool primec_type_is_integer(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	const uint8_t kind = get_type(table, type)->kind;
+	return (kind >= primec_type_kind_i8 && kind <= primec_type_kind_u64) || primec_type_kind_untyped_int == kind;
+}
+
+bool primec_type_is_signed(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	const uint8_t kind = get_type(table, type)->kind;
+	return (kind >= primec_type_kind_i8 && kind <= primec_type_kind_i64) || primec_type_kind_untyped_int == kind;
+}
+
+bool primec_type_is_float(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	const uint8_t kind = get_type(table, type)->kind;
+	return primec_type_kind_f32 == kind || primec_type_kind_f64 == kind || primec_type_kind_untyped_float == kind;
+}
+
+const char* primec_type_table_format(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	char* const buffer,
+	const uint64_t capacity)
+{
+	primec_debug_assert(buffer != NULL);
+	primec_debug_assert(capacity > 0);
+	uint64_t length = 0;
+	format_type(table, type, buffer, capacity, &length);
+	buffer[length < capacity ? length : capacity - 1] = 0;
+	return buffer;
+}
+
+static primec_type_s* get_type(
+	const primec_type_table_s* const table,
+	const primec_type_t type)
+{
+	primec_debug_assert(table != NULL);
+	primec_debug_assert((type >> types_page_bits) < types_pages_capacity);
+	return &table->types.pages[type >> types_page_bits][type & (types_page_size - 1)];
+}
+
+static const primec_type_t* get_list(
+	const primec_type_table_s* const table,
+	const primec_type_s* const type)
+{
+	if (0 == type->list.count)
+	{
+		return NULL;
+	}
+
+	return &table->lists.pages[type->list.start >> lists_page_bits][type->list.start & (lists_page_size - 1)];
+}
+
+static uint32_t hash_type(
+	const primec_type_s* const key,
+	const primec_type_t* const list)
+{
+	// NOTE: The name of nominal types, their flags (which change, once they are
+	//       completed) and the fields of structs are not a part of their
+	//       identity, so they are not hashed.
+	const uint8_t flags = is_nominal(key->kind) ? 0 : key->flags;
+	uint64_t hash = ((uint64_t)key->kind << 8 | flags) * 0x9E3779B97F4A7C15ull;
+	hash = (hash ^ key->element) * 0xBF58476D1CE4E5B9ull;
+	hash = (hash ^ key->count) * 0x94D049BB133111EBull;
+
+	if (!is_nominal(key->kind))
+	{
+		for (uint32_t index = 0; index < key->list.count; ++index)
+		{
+			hash = (hash ^ list[index]) * 0xBF58476D1CE4E5B9ull;
+		}
+	}
+
+	hash ^= hash >> 31;
+	return (uint32_t)hash;
+}
+
+static bool is_nominal(
+	const uint8_t kind)
+{
+	return primec_type_kind_struct == kind || primec_type_kind_enum == kind;
+}
+
+static bool equal_types_locked(
+	const primec_type_table_s* const table,
+	const primec_type_s* const type,
+	const primec_type_s* const key,
+	const primec_type_t* const list)
+{
+	if (type->kind != key->kind || type->element != key->element || type->count != key->count)
+	{
+		return false;
+	}
+
+	if (is_nominal(key->kind))
+	{
+		return true;
+	}
+
+	if (type->flags != key->flags || type->list.count != key->list.count)
+	{
+		return false;
+	}
+
+	for (uint32_t index = 0; index < key->list.count; ++index)
+	{
+		if (get_list(table, type)[index] != list[index])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint32_t* find_bucket_locked(
+	const primec_type_table_s* const table,
+	const primec_type_s* const key,
+	const primec_type_t* const list)
+{
+	primec_debug_assert(table->buckets.capacity > 0);
+	const uint32_t mask = table->buckets.capacity - 1;
+	uint32_t index = hash_type(key, list) & mask;
+
+	while (table->buckets.data[index] != 0)
+	{
+		if (equal_types_locked(table, get_type(table, table->buckets.data[index] - 1), key, list))
+		{
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return &table->buckets.data[index];
+}
+
+static void grow_buckets_locked(
+	primec_type_table_s* const table)
+{
+	primec_utils_free(table->buckets.data);
+	table->buckets.capacity = 0 == table->buckets.capacity ? 256 : table->buckets.capacity * 2;
+	table->buckets.data = primec_utils_malloc(table->buckets.capacity * sizeof(uint32_t));
+	primec_utils_memset(table->buckets.data, 0, table->buckets.capacity * sizeof(uint32_t));
+
+	for (primec_type_t type = 0; type < table->types.count; ++type)
+	{
+		const primec_type_s* const record = get_type(table, type);
+		*find_bucket_locked(table, record, get_list(table, record)) = type + 1;
+	}
+}
+
+static primec_type_t append_type_locked(
+	primec_type_table_s* const table,
+	const primec_type_s* const key)
+{
+	const primec_type_t type = table->types.count;
+
+	if (0 == (type & (types_page_size - 1)))
+	{
+		if ((type >> types_page_bits) >= types_pages_capacity)
+		{
+			primec_logger_panic("internal failure -- type table is full");
+		}
+
+		table->types.pages[type >> types_page_bits] = primec_utils_malloc(types_page_size * sizeof(primec_type_s));
+	}
+
+	*get_type(table, type) = *key;
+	++table->types.count;
+	return type;
+}
+
+static uint32_t append_list_locked(
+	primec_type_table_s* const table,
+	const primec_type_t* const list,
+	const uint32_t count)
+{
+	if (0 == count)
+	{
+		return 0;
+	}
+
+	uint32_t page = table->lists.count >> lists_page_bits;
+	uint32_t offset = table->lists.count & (lists_page_size - 1);
+
+	// NOTE: Lists never cross the pages, so a list that does not fit the rest
+	//       of the current page starts a new one, and a list longer than a page
+	//       gets a page of its own.
+	if (offset > 0 && offset + count > lists_page_size)
+	{
+		++page;
+		offset = 0;
+	}
+
+	if (0 == offset)
+	{
+		if (page >= lists_pages_capacity)
+		{
+			primec_logger_panic("internal failure -- type table is full");
+		}
+
+		const uint32_t page_size = count > lists_page_size ? count : lists_page_size;
+		table->lists.pages[page] = primec_utils_malloc(page_size * sizeof(primec_type_t));
+	}
+
+	primec_utils_memcpy(&table->lists.pages[page][offset], list, count * sizeof(primec_type_t));
+	const uint32_t start = (page << lists_page_bits) | offset;
+	table->lists.count = count >= lists_page_size ? (page + 1) << lists_page_bits : start + count;
+	return start;
+}
+
+static primec_type_t intern_type(
+	primec_type_table_s* const table,
+	const primec_type_s* const key,
+	const primec_type_t* const list)
+{
+	primec_debug_assert(table != NULL);
+	primec_debug_assert(key != NULL);
+	(void)pthread_mutex_lock(&table->mutex);
+
+	if (2 * (table->types.count + 1) > table->buckets.capacity)
+	{
+		grow_buckets_locked(table);
+	}
+
+	uint32_t* const bucket = find_bucket_locked(table, key, list);
+
+	if (*bucket != 0)
+	{
+		const primec_type_t type = *bucket - 1;
+		(void)pthread_mutex_unlock(&table->mutex);
+		return type;
+	}
+
+	primec_type_s record = *key;
+
+	if (!is_nominal(key->kind))
+	{
+		record.list.start = append_list_locked(table, list, key->list.count);
+	}
+
+	const primec_type_t type = append_type_locked(table, &record);
+	*bucket = type + 1;
+	(void)pthread_mutex_unlock(&table->mutex);
+	return type;
+}
+
+static void format_type(
+	const primec_type_table_s* const table,
+	const primec_type_t type,
+	char* const buffer,
+	const uint64_t capacity,
+	uint64_t* const length)
+{
+	const primec_type_s* const record = get_type(table, type);
+
+	switch (record->kind)
+	{
+		case primec_type_kind_reference:
+		case primec_type_kind_pointer:
+		{
+			format_text(primec_type_kind_reference == record->kind ? "&" : "*", buffer, capacity, length);
+			if (record->flags & primec_type_flag_mut) { format_text("mut ", buffer, capacity, length); }
+			format_type(table, record->element, buffer, capacity, length);
+		} break;
+
+		case primec_type_kind_array:
+		{
+			char count[32] = {0};
+			(void)snprintf(count, sizeof(count), ", %lu]", record->count);
+			format_text("[", buffer, capacity, length);
+			format_type(table, record->element, buffer, capacity, length);
+			format_text(count, buffer, capacity, length);
+		} break;
+
+		case primec_type_kind_slice:
+		{
+			format_text("[", buffer, capacity, length);
+			format_type(table, record->element, buffer, capacity, length);
+			format_text("]", buffer, capacity, length);
+		} break;
+
+		case primec_type_kind_vector:
+		{
+			char count[32] = {0};
+			(void)snprintf(count, sizeof(count), " x %lu>", record->count);
+			format_text("<", buffer, capacity, length);
+			format_type(table, record->element, buffer, capacity, length);
+			format_text(count, buffer, capacity, length);
+		} break;
+
+		case primec_type_kind_func:
+		{
+			const primec_type_t* const params = primec_type_table_get_list(table, type);
+			format_text("func(", buffer, capacity, length);
+
+			for (uint32_t index = 0; index < record->list.count; ++index)
+			{
+				if (index > 0) { format_text(", ", buffer, capacity, length); }
+				format_type(table, params[index], buffer, capacity, length);
+			}
+
+			if (record->flags & primec_type_flag_variadic)
+			{
+				format_text(record->list.count > 0 ? ", ..." : "...", buffer, capacity, length);
+			}
+
+			format_text(")", buffer, capacity, length);
+
+			if (record->element != primec_type_void)
+			{
+				format_text(" -> ", buffer, capacity, length);
+				format_type(table, record->element, buffer, capacity, length);
+			}
+		} break;
+
+		default:
+		{
+			format_text(record->name != NULL ? record->name : "<anonymous>", buffer, capacity, length);
+		} break;
+	}
+}
+
+static void format_text(
+	const char* const text,
+	char* const buffer,
+	const uint64_t capacity,
+	uint64_t* const length)
+{
+	for (const char* symbol = text; *symbol != 0 && *length + 1 < capacity; ++symbol)
+	{
+		buffer[(*length)++] = *symbol;
+	}
+}
@@ -66,6 +66,17 @@ void primec_utils_memcpy(
 	(void)memcpy((void*)destination, (const void*)source, length);
 }
 
+int32_t primec_utils_memcmp(
+	const void* const left,
+	const void* const right,
+	const uint64_t length)
+{
+	primec_debug_assert(left != NULL);
+	primec_debug_assert(right != NULL);
+	primec_debug_assert(length > 0);
+	return memcmp((const void*)left, (const void*)right, length);
+}
+
 char* primec_utils_strdup(
 	const char* const string)
 {
@@ -112,3 +123,21 @@ void* primec_utils_bsearch(
 {
 	return bsearch(key, base, members_count, member_size, compare);
 }
+
+uint64_t primec_utils_hash(
+	const void* const data,
+	const uint64_t length)
+{
+	primec_debug_assert(data != NULL || 0 == length);
+
+	// NOTE: FNV-1a hash.
+	const uint8_t* const bytes = (const uint8_t*)data;
+	uint64_t hash = UINT64_C(14695981039346656037);
+
+	for (uint64_t index = 0; index < length; ++index)
+	{
+		hash = (hash ^ bytes[index]) * UINT64_C(1099511628211);
+	}
+
+	return hash;
+}
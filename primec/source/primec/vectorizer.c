@@ -0,0 +1,1206 @@
+
+/**
+ * @file vectorizer.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/vectorizer.h>
+
+#include <primec/debug.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+
+#include <stddef.h>
+
+// NOTE: Vectors are 16 bytes wide (sse2), and the loops are limited to this
+//       many reductions, accessed bases, overlap checks of the bases, and
+//       lengths of the bounds checks.
+#define vector_size 16
+#define max_reductions 8
+#define max_accesses 16
+#define max_checks 8
+#define max_lengths 8
+
+#define no_block UINT32_MAX
+
+/**
+ * @brief Role of a value of the loop in the vector loop.
+ */
+typedef enum
+{
+	kind_none,
+	kind_invariant,		// same in every iteration, hoisted in front of the loop
+	kind_index,			// the counter, or its widening conversion
+	kind_address,		// address of the element at the counter
+	kind_vector,		// computed lane by lane
+	kind_reduction,		// phi of a reduction
+	kind_step,			// increment of the counter
+	kind_check,			// bounds check of the counter against an invariant length
+} kind_e;
+
+typedef struct
+{
+	primec_ir_value_t phi;
+	primec_ir_value_t init;
+	primec_ir_value_t next;
+	primec_ir_op_e op;
+} reduction_s;
+
+typedef struct
+{
+	primec_ir_value_t base;
+	bool is_store;
+} access_s;
+
+typedef struct
+{
+	primec_ir_block_t preheader;
+	primec_ir_block_t header;
+	primec_ir_block_t body;
+
+	primec_ir_value_t index;
+	primec_ir_value_t init;
+	primec_ir_value_t limit;
+	primec_ir_value_t step;
+	primec_ir_value_t condition;
+
+	uint32_t lane_size;
+	uint32_t lanes;
+
+	reduction_s reductions[max_reductions];
+	uint32_t reductions_count;
+	access_s accesses[max_accesses];
+	uint32_t accesses_count;
+	primec_ir_value_t lengths[max_lengths];
+	uint32_t lengths_count;
+} loop_s;
+
+typedef struct
+{
+	primec_type_table_s* types;
+	primec_ir_func_s* func;
+	primec_cfg_s cfg;
+
+	primec_ir_block_t* blocks;		// block of every value
+	uint32_t* uses;					// uses of every value
+	primec_ir_value_t* roots;		// slot or aggregate parameter, that the address is derived from
+	bool* is_escaped;				// address of the root is passed on
+	bool* is_written;				// memory of the root is written by the loop
+	uint8_t* kinds;
+} vectorizer_s;
+
+static bool vectorize_loop(
+	primec_type_table_s* const types,
+	primec_ir_func_s* const func,
+	primec_ir_block_t** const done,
+	uint32_t* const done_count);
+
+static void find_roots(
+	vectorizer_s* const vectorizer);
+
+static void count_use(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static void mark_escaped(
+	void* const context,
+	primec_ir_value_t* const operand);
+
+static bool match_loop(
+	vectorizer_s* const vectorizer,
+	const primec_ir_block_t header,
+	loop_s* const loop);
+
+static bool match_shape(
+	const vectorizer_s* const vectorizer,
+	const primec_ir_block_t header,
+	loop_s* const loop);
+
+static bool match_condition(
+	const vectorizer_s* const vectorizer,
+	loop_s* const loop);
+
+static bool match_phis(
+	vectorizer_s* const vectorizer,
+	loop_s* const loop);
+
+static bool classify(
+	vectorizer_s* const vectorizer,
+	loop_s* const loop,
+	const primec_ir_value_t value);
+
+static bool is_hoistable(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value);
+
+static bool is_invariant(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value);
+
+static bool is_lane_operand(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value);
+
+static bool use_lane(
+	loop_s* const loop,
+	const primec_type_t type);
+
+static bool add_access(
+	const vectorizer_s* const vectorizer,
+	loop_s* const loop,
+	const primec_ir_value_t base,
+	const bool is_store);
+
+static bool is_same_base(
+	const vectorizer_s* const vectorizer,
+	const primec_ir_value_t left,
+	const primec_ir_value_t right);
+
+static uint32_t count_checks(
+	const loop_s* const loop);
+
+static void transform(
+	vectorizer_s* const vectorizer,
+	const loop_s* const loop);
+
+static primec_ir_value_t add_const(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_type_t type,
+	const uint64_t value);
+
+static void append(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static uint32_t get_lane_size(
+	const primec_type_t type);
+
+static primec_type_t get_unsigned(
+	const primec_type_t type);
+
+static uint64_t get_mask(
+	const uint32_t size);
+
+void primec_vectorizer_run(
+	primec_ir_program_s* const program)
+{
+	primec_debug_assert(program != NULL);
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		primec_ir_func_s* const func = program->funcs.data[index];
+		if ((func->flags & primec_ir_func_flag_extern) || 0 == func->blocks.count) { continue; }
+
+		// NOTE: Every transformed header is remembered, so the remainder loop is
+		//       not vectorized again, and the function is analyzed anew after
+		//       every transformation.
+		primec_ir_block_t* done = NULL;
+		uint32_t done_count = 0;
+		while (vectorize_loop(program->types, func, &done, &done_count)) { }
+		primec_utils_free(done);
+	}
+}
+
+static bool vectorize_loop(
+	primec_type_table_s* const types,
+	primec_ir_func_s* const func,
+	primec_ir_block_t** const done,
+	uint32_t* const done_count)
+{
+	vectorizer_s vectorizer = { .types = types, .func = func };
+	primec_cfg_build(&vectorizer.cfg, func);
+
+	const uint32_t values_count = func->instructions.count;
+	vectorizer.blocks = primec_utils_malloc(values_count * sizeof(primec_ir_block_t));
+	vectorizer.uses = primec_utils_malloc(values_count * sizeof(uint32_t));
+	vectorizer.roots = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	vectorizer.is_escaped = primec_utils_malloc(values_count * sizeof(bool));
+	vectorizer.is_written = primec_utils_malloc(values_count * sizeof(bool));
+	vectorizer.kinds = primec_utils_malloc(values_count * sizeof(uint8_t));
+	primec_utils_memset(vectorizer.uses, 0, values_count * sizeof(uint32_t));
+	primec_utils_memset(vectorizer.roots, 0, values_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(vectorizer.is_escaped, 0, values_count * sizeof(bool));
+	primec_utils_memset(vectorizer.kinds, 0, values_count * sizeof(uint8_t));
+
+	for (primec_ir_value_t value = 0; value < values_count; ++value)
+	{
+		vectorizer.blocks[value] = no_block;
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			vectorizer.blocks[value] = block;
+			primec_ir_func_visit_operands(func, value, count_use, &vectorizer);
+		}
+	}
+
+	find_roots(&vectorizer);
+	bool is_transformed = false;
+
+	for (uint32_t position = 0; position < vectorizer.cfg.order_count && !is_transformed; ++position)
+	{
+		const primec_ir_block_t header = vectorizer.cfg.order[position];
+		bool is_done = false;
+
+		for (uint32_t index = 0; index < *done_count && !is_done; ++index)
+		{
+			is_done = (*done)[index] == header;
+		}
+
+		loop_s loop = {0};
+		if (is_done || !match_loop(&vectorizer, header, &loop)) { continue; }
+
+		transform(&vectorizer, &loop);
+		*done = primec_utils_realloc(*done, (*done_count + 1) * sizeof(primec_ir_block_t));
+		(*done)[(*done_count)++] = header;
+		is_transformed = true;
+	}
+
+	primec_utils_free(vectorizer.blocks);
+	primec_utils_free(vectorizer.uses);
+	primec_utils_free(vectorizer.roots);
+	primec_utils_free(vectorizer.is_escaped);
+	primec_utils_free(vectorizer.is_written);
+	primec_utils_free(vectorizer.kinds);
+	primec_cfg_destroy(&vectorizer.cfg);
+	return is_transformed;
+}
+
+static void find_roots(
+	vectorizer_s* const vectorizer)
+{
+	primec_ir_func_s* const func = vectorizer->func;
+	const primec_type_table_s* const types = vectorizer->types;
+	const primec_type_t* const params = primec_type_table_get_list(types, func->type);
+	const uint32_t hidden = (func->flags & primec_ir_func_flag_sret) ? 1 : 0;
+
+	// NOTE: Memory of the slots and of the aggregate arguments is reached only
+	//       through their own addresses, unless the addresses are passed on.
+	for (uint32_t position = 0; position < vectorizer->cfg.order_count; ++position)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[vectorizer->cfg.order[position]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			switch ((primec_ir_op_e)instruction->op)
+			{
+				case primec_ir_op_slot:
+				{
+					vectorizer->roots[value] = value;
+				} break;
+
+				case primec_ir_op_param:
+				{
+					if (instruction->a < hidden) { break; }
+					if (!primec_ir_is_aggregate(types, params[instruction->a - hidden])) { break; }
+					vectorizer->roots[value] = value;
+				} break;
+
+				case primec_ir_op_offset:
+				case primec_ir_op_field:
+				case primec_ir_op_element:
+				{
+					vectorizer->roots[value] = vectorizer->roots[instruction->a];
+				} break;
+
+				default:
+				{
+				} break;
+			}
+		}
+	}
+
+	for (primec_ir_block_t block = 0; block < func->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+
+			switch ((primec_ir_op_e)instruction->op)
+			{
+				case primec_ir_op_load:
+				case primec_ir_op_offset:
+				case primec_ir_op_field:
+				case primec_ir_op_copy:
+				case primec_ir_op_zero:
+				{
+				} break;
+
+				case primec_ir_op_element:
+				case primec_ir_op_store:
+				{
+					mark_escaped(vectorizer, &instruction->b);
+				} break;
+
+				default:
+				{
+					primec_ir_func_visit_operands(func, value, mark_escaped, vectorizer);
+				} break;
+			}
+		}
+	}
+}
+
+static void count_use(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	vectorizer_s* const vectorizer = context;
+	++vectorizer->uses[*operand];
+}
+
+static void mark_escaped(
+	void* const context,
+	primec_ir_value_t* const operand)
+{
+	vectorizer_s* const vectorizer = context;
+	const primec_ir_value_t root = vectorizer->roots[*operand];
+	if (root != primec_ir_null) { vectorizer->is_escaped[root] = true; }
+}
+
+static bool match_loop(
+	vectorizer_s* const vectorizer,
+	const primec_ir_block_t header,
+	loop_s* const loop)
+{
+	primec_ir_func_s* const func = vectorizer->func;
+	if (!match_shape(vectorizer, header, loop)) { return false; }
+	if (!match_condition(vectorizer, loop)) { return false; }
+
+	const primec_ir_block_t blocks[2] = { loop->header, loop->body };
+	primec_utils_memset(vectorizer->is_written, 0, func->instructions.count * sizeof(bool));
+
+	for (uint32_t block = 0; block < 2; ++block)
+	{
+		const primec_ir_block_s* const record = &func->blocks.data[blocks[block]];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+			vectorizer->kinds[value] = kind_none;
+
+			if (primec_ir_op_store == instruction->op || primec_ir_op_copy == instruction->op || primec_ir_op_zero == instruction->op)
+			{
+				vectorizer->is_written[vectorizer->roots[instruction->a]] = true;
+			}
+		}
+	}
+
+	if (!match_phis(vectorizer, loop)) { return false; }
+
+	// NOTE: The header computes nothing, but the invariants, the condition and
+	//       the branch, while every instruction of the body must have a role.
+	const primec_ir_block_s* const header_record = &func->blocks.data[loop->header];
+
+	for (uint32_t index = 0; index < header_record->instructions.count - 1; ++index)
+	{
+		const primec_ir_value_t value = header_record->instructions.data[index];
+		const primec_ir_op_e op = primec_ir_func_get(func, value)->op;
+		if (primec_ir_op_phi == op || value == loop->condition) { continue; }
+		if (!is_hoistable(vectorizer, loop, value)) { return false; }
+		vectorizer->kinds[value] = kind_invariant;
+	}
+
+	const primec_ir_block_s* const body_record = &func->blocks.data[loop->body];
+
+	for (uint32_t index = 0; index < body_record->instructions.count - 1; ++index)
+	{
+		if (!classify(vectorizer, loop, body_record->instructions.data[index])) { return false; }
+	}
+
+	if (0 == loop->accesses_count) { return false; }
+	return count_checks(loop) <= max_checks;
+}
+
+static bool match_shape(
+	const vectorizer_s* const vectorizer,
+	const primec_ir_block_t header,
+	loop_s* const loop)
+{
+	const primec_ir_func_s* const func = vectorizer->func;
+	const primec_cfg_s* const cfg = &vectorizer->cfg;
+	if (0 == header) { return false; }
+
+	// NOTE: The header is entered from the preheader and from the body, which
+	//       only the header enters, and which jumps back to it.
+	const uint32_t start = cfg->predecessors_starts[header];
+	if (cfg->predecessors_starts[header + 1] - start != 2) { return false; }
+	loop->header = header;
+	loop->preheader = no_block;
+	loop->body = no_block;
+
+	for (uint32_t index = start; index < start + 2; ++index)
+	{
+		const primec_ir_block_t predecessor = cfg->predecessors[index];
+		if (primec_cfg_dominates(cfg, header, predecessor)) { loop->body = predecessor; }
+		else { loop->preheader = predecessor; }
+	}
+
+	if (no_block == loop->preheader || no_block == loop->body || loop->body == header) { return false; }
+	if (cfg->predecessors_starts[loop->body + 1] - cfg->predecessors_starts[loop->body] != 1) { return false; }
+
+	const primec_ir_block_s* const body = &func->blocks.data[loop->body];
+	const primec_ir_instruction_s* const jump = primec_ir_func_get(func, body->instructions.data[body->instructions.count - 1]);
+	if (jump->op != primec_ir_op_jump || jump->a != header) { return false; }
+
+	const primec_ir_block_s* const record = &func->blocks.data[header];
+	const primec_ir_instruction_s* const branch = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+	if (branch->op != primec_ir_op_branch) { return false; }
+
+	uint32_t count = 0;
+	const uint32_t* const targets = primec_ir_func_get_list(func, branch->b, &count);
+	primec_debug_assert(2 == count);
+	if (targets[0] == targets[1] || (targets[0] != loop->body && targets[1] != loop->body)) { return false; }
+	loop->condition = branch->a;
+	return true;
+}
+
+static bool match_condition(
+	const vectorizer_s* const vectorizer,
+	loop_s* const loop)
+{
+	const primec_ir_func_s* const func = vectorizer->func;
+	const primec_ir_block_s* const record = &func->blocks.data[loop->header];
+	const primec_ir_instruction_s* const branch = primec_ir_func_get(func, record->instructions.data[record->instructions.count - 1]);
+	const primec_ir_instruction_s* const condition = primec_ir_func_get(func, loop->condition);
+	if (vectorizer->blocks[loop->condition] != loop->header || vectorizer->uses[loop->condition] != 1) { return false; }
+
+	uint32_t count = 0;
+	const uint32_t* const targets = primec_ir_func_get_list(func, branch->b, &count);
+	primec_ir_op_e op = condition->op;
+
+	// NOTE: The loop must continue while the counter is below the limit, so the
+	//       condition is flipped, if the branch leaves the loop when it holds.
+	if (targets[0] != loop->body)
+	{
+		switch (op)
+		{
+			case primec_ir_op_lt: { op = primec_ir_op_ge; } break;
+			case primec_ir_op_le: { op = primec_ir_op_gt; } break;
+			case primec_ir_op_gt: { op = primec_ir_op_le; } break;
+			case primec_ir_op_ge: { op = primec_ir_op_lt; } break;
+			default: { return false; } break;
+		}
+	}
+
+	switch (op)
+	{
+		case primec_ir_op_lt:
+		{
+			loop->index = condition->a;
+			loop->limit = condition->b;
+		} break;
+
+		case primec_ir_op_gt:
+		{
+			loop->index = condition->b;
+			loop->limit = condition->a;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+
+	const primec_ir_instruction_s* const index = primec_ir_func_get(func, loop->index);
+	if (index->op != primec_ir_op_phi || vectorizer->blocks[loop->index] != loop->header) { return false; }
+	return primec_type_is_integer(vectorizer->types, index->type);
+}
+
+static bool match_phis(
+	vectorizer_s* const vectorizer,
+	loop_s* const loop)
+{
+	const primec_ir_func_s* const func = vectorizer->func;
+	const primec_ir_block_s* const record = &func->blocks.data[loop->header];
+
+	for (uint32_t position = 0; position < record->instructions.count; ++position)
+	{
+		const primec_ir_value_t value = record->instructions.data[position];
+		const primec_ir_instruction_s* const phi = primec_ir_func_get(func, value);
+		if (phi->op != primec_ir_op_phi) { break; }
+
+		uint32_t count = 0;
+		const uint32_t* const incoming = primec_ir_func_get_list(func, phi->a, &count);
+		primec_ir_value_t init = primec_ir_null;
+		primec_ir_value_t next = primec_ir_null;
+
+		for (uint32_t index = 0; index < count; index += 2)
+		{
+			if (incoming[index] == loop->preheader) { init = incoming[index + 1]; }
+			if (incoming[index] == loop->body) { next = incoming[index + 1]; }
+		}
+
+		if (count != 4 || primec_ir_null == init || primec_ir_null == next) { return false; }
+
+		const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, next);
+		if (vectorizer->blocks[next] != loop->body || vectorizer->uses[next] != 1) { return false; }
+		const primec_ir_value_t other = instruction->a == value ? instruction->b : instruction->a;
+		if (instruction->a != value && instruction->b != value) { return false; }
+
+		if (value == loop->index)
+		{
+			const primec_ir_instruction_s* const step = primec_ir_func_get(func, other);
+			if (instruction->op != primec_ir_op_add || step->op != primec_ir_op_const) { return false; }
+			if (primec_ir_get_const(step).uval != 1) { return false; }
+			loop->init = init;
+			loop->step = next;
+			vectorizer->kinds[value] = kind_index;
+			vectorizer->kinds[next] = kind_step;
+			continue;
+		}
+
+		// NOTE: Only the integer reductions are reordered, as the floating point
+		//       ones would round differently.
+		if (!primec_type_is_integer(vectorizer->types, phi->type) || loop->reductions_count >= max_reductions) { return false; }
+
+		switch ((primec_ir_op_e)instruction->op)
+		{
+			case primec_ir_op_add:
+			case primec_ir_op_and:
+			case primec_ir_op_or:
+			case primec_ir_op_xor:
+			{
+			} break;
+
+			default:
+			{
+				return false;
+			} break;
+		}
+
+		if (!use_lane(loop, phi->type)) { return false; }
+		loop->reductions[loop->reductions_count++] = (reduction_s) { .phi = value, .init = init, .next = next, .op = instruction->op };
+		vectorizer->kinds[value] = kind_reduction;
+	}
+
+	return loop->step != primec_ir_null;
+}
+
+static bool classify(
+	vectorizer_s* const vectorizer,
+	loop_s* const loop,
+	const primec_ir_value_t value)
+{
+	const primec_ir_func_s* const func = vectorizer->func;
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(func, value);
+	uint8_t* const kinds = vectorizer->kinds;
+
+	if (value == loop->step)
+	{
+		return true;
+	}
+
+	for (uint32_t index = 0; index < loop->reductions_count; ++index)
+	{
+		if (loop->reductions[index].next != value) { continue; }
+		const reduction_s* const reduction = &loop->reductions[index];
+		const primec_ir_value_t other = instruction->a == reduction->phi ? instruction->b : instruction->a;
+		if (other == reduction->phi || !is_lane_operand(vectorizer, loop, other)) { return false; }
+		kinds[value] = kind_vector;
+		return true;
+	}
+
+	if (is_hoistable(vectorizer, loop, value))
+	{
+		kinds[value] = kind_invariant;
+		return true;
+	}
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_convert:
+		{
+			// NOTE: Narrowing conversions of the counter could wrap around between
+			//       the lanes, so only the widening ones are followed.
+			const primec_type_t type = primec_ir_func_get(func, instruction->a)->type;
+			if (kinds[instruction->a] != kind_index || !primec_type_is_integer(vectorizer->types, instruction->type)) { return false; }
+			if (get_lane_size(instruction->type) < get_lane_size(type)) { return false; }
+			kinds[value] = kind_index;
+		} break;
+
+		case primec_ir_op_element:
+		{
+			if (!is_invariant(vectorizer, loop, instruction->a) || kinds[instruction->b] != kind_index) { return false; }
+			kinds[value] = kind_address;
+		} break;
+
+		case primec_ir_op_check:
+		{
+			// NOTE: The checks cannot fail in the vector loop, if the guard finds
+			//       the limit within the lengths, and otherwise the scalar loop
+			//       traps, where it always did. Unsigned counters are required,
+			//       so the checked indices are the counters themselves.
+			const primec_type_t type = primec_ir_func_get(func, loop->index)->type;
+			if (kinds[instruction->a] != kind_index || primec_type_is_signed(vectorizer->types, type)) { return false; }
+			if (!is_invariant(vectorizer, loop, instruction->b)) { return false; }
+			bool is_known = false;
+
+			for (uint32_t index = 0; index < loop->lengths_count && !is_known; ++index)
+			{
+				is_known = loop->lengths[index] == instruction->b;
+			}
+
+			if (!is_known && loop->lengths_count >= max_lengths) { return false; }
+			if (!is_known) { loop->lengths[loop->lengths_count++] = instruction->b; }
+			kinds[value] = kind_check;
+		} break;
+
+		case primec_ir_op_load:
+		{
+			if (kinds[instruction->a] != kind_address || !use_lane(loop, instruction->type)) { return false; }
+			if (!add_access(vectorizer, loop, primec_ir_func_get(func, instruction->a)->a, false)) { return false; }
+			kinds[value] = kind_vector;
+		} break;
+
+		case primec_ir_op_store:
+		{
+			if (kinds[instruction->a] != kind_address || !use_lane(loop, instruction->type)) { return false; }
+			if (!is_lane_operand(vectorizer, loop, instruction->b)) { return false; }
+			if (!add_access(vectorizer, loop, primec_ir_func_get(func, instruction->a)->a, true)) { return false; }
+			kinds[value] = kind_vector;
+		} break;
+
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_div:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		{
+			// NOTE: Sse2 has no packed integer divisions, and multiplies the
+			//       16 bit lanes only.
+			const primec_ir_op_e op = instruction->op;
+			const bool is_float = primec_type_is_float(vectorizer->types, instruction->type);
+			const uint32_t size = get_lane_size(instruction->type);
+
+			if (is_float && (primec_ir_op_and == op || primec_ir_op_or == op || primec_ir_op_xor == op)) { return false; }
+			if (!is_float && (primec_ir_op_div == op || (primec_ir_op_mul == op && size != 2))) { return false; }
+			if (!use_lane(loop, instruction->type)) { return false; }
+			if (!is_lane_operand(vectorizer, loop, instruction->a) || !is_lane_operand(vectorizer, loop, instruction->b)) { return false; }
+			if (kinds[instruction->a] != kind_vector && kinds[instruction->b] != kind_vector) { return false; }
+			kinds[value] = kind_vector;
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+
+	return true;
+}
+
+static bool is_hoistable(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = primec_ir_func_get(vectorizer->func, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_const:
+		case primec_ir_op_param:
+		case primec_ir_op_slot:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		{
+			return true;
+		} break;
+
+		case primec_ir_op_offset:
+		case primec_ir_op_field:
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		case primec_ir_op_convert:
+		{
+			return is_invariant(vectorizer, loop, instruction->a);
+		} break;
+
+		case primec_ir_op_element:
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		case primec_ir_op_shl:
+		case primec_ir_op_shr:
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			return is_invariant(vectorizer, loop, instruction->a) && is_invariant(vectorizer, loop, instruction->b);
+		} break;
+
+		case primec_ir_op_load:
+		{
+			// NOTE: Only the memory, that the loop cannot write, is loaded once.
+			const primec_ir_value_t root = vectorizer->roots[instruction->a];
+			if (primec_ir_null == root || vectorizer->is_escaped[root] || vectorizer->is_written[root]) { return false; }
+			return is_invariant(vectorizer, loop, instruction->a);
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static bool is_invariant(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value)
+{
+	const primec_ir_block_t block = vectorizer->blocks[value];
+	if (block != loop->header && block != loop->body) { return true; }
+	return kind_invariant == vectorizer->kinds[value];
+}
+
+static bool is_lane_operand(
+	const vectorizer_s* const vectorizer,
+	const loop_s* const loop,
+	const primec_ir_value_t value)
+{
+	const uint8_t kind = vectorizer->kinds[value];
+	if (kind_vector == kind) { return true; }
+	if (kind_reduction == kind) { return false; }
+	return is_invariant(vectorizer, loop, value);
+}
+
+static bool use_lane(
+	loop_s* const loop,
+	const primec_type_t type)
+{
+	const uint32_t size = get_lane_size(type);
+	if (0 == size) { return false; }
+
+	if (0 == loop->lane_size)
+	{
+		loop->lane_size = size;
+		loop->lanes = vector_size / size;
+	}
+
+	return loop->lane_size == size;
+}
+
+static bool add_access(
+	const vectorizer_s* const vectorizer,
+	loop_s* const loop,
+	const primec_ir_value_t base,
+	const bool is_store)
+{
+	for (uint32_t index = 0; index < loop->accesses_count; ++index)
+	{
+		if (!is_same_base(vectorizer, loop->accesses[index].base, base)) { continue; }
+		loop->accesses[index].is_store |= is_store;
+		return true;
+	}
+
+	if (loop->accesses_count >= max_accesses) { return false; }
+	loop->accesses[loop->accesses_count++] = (access_s) { .base = base, .is_store = is_store };
+	return true;
+}
+
+static bool is_same_base(
+	const vectorizer_s* const vectorizer,
+	const primec_ir_value_t left,
+	const primec_ir_value_t right)
+{
+	// NOTE: Bases are invariant, so the loads of the same address (of the data
+	//       pointer of the same slice) give the same base.
+	if (left == right) { return true; }
+	const primec_ir_instruction_s* const left_instruction = primec_ir_func_get(vectorizer->func, left);
+	const primec_ir_instruction_s* const right_instruction = primec_ir_func_get(vectorizer->func, right);
+	return primec_ir_op_load == left_instruction->op && primec_ir_op_load == right_instruction->op &&
+		left_instruction->a == right_instruction->a;
+}
+
+static uint32_t count_checks(
+	const loop_s* const loop)
+{
+	uint32_t count = 0;
+
+	for (uint32_t left = 0; left < loop->accesses_count; ++left)
+	{
+		for (uint32_t right = left + 1; right < loop->accesses_count; ++right)
+		{
+			if (loop->accesses[left].is_store || loop->accesses[right].is_store) { ++count; }
+		}
+	}
+
+	return count;
+}
+
+static void transform(
+	vectorizer_s* const vectorizer,
+	const loop_s* const loop)
+{
+	primec_ir_func_s* const func = vectorizer->func;
+	primec_type_table_s* const types = vectorizer->types;
+	const uint32_t values_count = func->instructions.count;
+	const uint8_t* const kinds = vectorizer->kinds;
+
+	const primec_ir_block_t guard = primec_ir_func_add_block(func);
+	const primec_ir_block_t vector = primec_ir_func_add_block(func);
+	const primec_ir_block_t merge = primec_ir_func_add_block(func);
+
+	// NOTE: The invariants move to the guard, which runs once in front of the
+	//       loop, and dominates everything the header dominated.
+	const primec_ir_block_t blocks[2] = { loop->header, loop->body };
+
+	for (uint32_t block = 0; block < 2; ++block)
+	{
+		uint32_t kept = 0;
+
+		for (uint32_t index = 0; index < func->blocks.data[blocks[block]].instructions.count; ++index)
+		{
+			const primec_ir_value_t value = func->blocks.data[blocks[block]].instructions.data[index];
+			if (kind_invariant == kinds[value]) { append(func, guard, value); }
+			else { func->blocks.data[blocks[block]].instructions.data[kept++] = value; }
+		}
+
+		func->blocks.data[blocks[block]].instructions.count = kept;
+	}
+
+	// NOTE: The vector loop runs, while at least a whole vector of the elements
+	//       is left, and the stored memory does not overlap the other accessed
+	//       memory within a vector (equal bases access the same elements in the
+	//       same order, as the scalar loop does).
+	const primec_type_t type = primec_ir_func_get(func, loop->index)->type;
+	const primec_type_t unsigned_type = get_unsigned(type);
+	const uint32_t size = get_lane_size(type);
+	const uint32_t bytes = loop->lanes * loop->lane_size;
+
+	primec_ir_value_t ok = primec_ir_func_add(func, guard, primec_ir_op_lt, primec_type_bool, loop->init, loop->limit);
+	primec_ir_value_t trips = primec_ir_func_add(func, guard, primec_ir_op_sub, type, loop->limit, loop->init);
+	if (type != unsigned_type) { trips = primec_ir_func_add(func, guard, primec_ir_op_convert, unsigned_type, trips, 0); }
+	const primec_ir_value_t lanes = add_const(func, guard, unsigned_type, loop->lanes);
+	const primec_ir_value_t mask = add_const(func, guard, unsigned_type, ~(uint64_t)(loop->lanes - 1) & get_mask(size));
+	primec_ir_value_t whole = primec_ir_func_add(func, guard, primec_ir_op_and, unsigned_type, trips, mask);
+	if (type != unsigned_type) { whole = primec_ir_func_add(func, guard, primec_ir_op_convert, type, whole, 0); }
+	const primec_ir_value_t end = primec_ir_func_add(func, guard, primec_ir_op_add, type, loop->init, whole);
+	const primec_ir_value_t is_enough = primec_ir_func_add(func, guard, primec_ir_op_ge, primec_type_bool, trips, lanes);
+	ok = primec_ir_func_add(func, guard, primec_ir_op_and, primec_type_bool, ok, is_enough);
+
+	for (uint32_t index = 0; index < loop->lengths_count; ++index)
+	{
+		const primec_ir_value_t length = loop->lengths[index];
+		const primec_type_t length_type = primec_ir_func_get(func, length)->type;
+		primec_ir_value_t limit = loop->limit;
+		if (length_type != type) { limit = primec_ir_func_add(func, guard, primec_ir_op_convert, length_type, limit, 0); }
+		const primec_ir_value_t is_within = primec_ir_func_add(func, guard, primec_ir_op_le, primec_type_bool, limit, length);
+		ok = primec_ir_func_add(func, guard, primec_ir_op_and, primec_type_bool, ok, is_within);
+	}
+
+	for (uint32_t left = 0; left < loop->accesses_count; ++left)
+	{
+		for (uint32_t right = left + 1; right < loop->accesses_count; ++right)
+		{
+			if (!loop->accesses[left].is_store && !loop->accesses[right].is_store) { continue; }
+			const primec_ir_value_t a = loop->accesses[left].base;
+			const primec_ir_value_t b = loop->accesses[right].base;
+			const primec_ir_value_t a_end = primec_ir_func_add(func, guard, primec_ir_op_offset, primec_ir_func_get(func, a)->type, a, bytes);
+			const primec_ir_value_t b_end = primec_ir_func_add(func, guard, primec_ir_op_offset, primec_ir_func_get(func, b)->type, b, bytes);
+			const primec_ir_value_t is_equal = primec_ir_func_add(func, guard, primec_ir_op_eq, primec_type_bool, a, b);
+			const primec_ir_value_t is_below = primec_ir_func_add(func, guard, primec_ir_op_le, primec_type_bool, a_end, b);
+			const primec_ir_value_t is_above = primec_ir_func_add(func, guard, primec_ir_op_le, primec_type_bool, b_end, a);
+			primec_ir_value_t is_disjoint = primec_ir_func_add(func, guard, primec_ir_op_or, primec_type_bool, is_below, is_above);
+			is_disjoint = primec_ir_func_add(func, guard, primec_ir_op_or, primec_type_bool, is_equal, is_disjoint);
+			ok = primec_ir_func_add(func, guard, primec_ir_op_and, primec_type_bool, ok, is_disjoint);
+		}
+	}
+
+	// NOTE: The invariant operands of the lanes are splatted once, and the
+	//       reductions start from the identities of their ops.
+	primec_ir_value_t* const map = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	primec_ir_value_t* const splats = primec_utils_malloc(values_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(map, 0, values_count * sizeof(primec_ir_value_t));
+	primec_utils_memset(splats, 0, values_count * sizeof(primec_ir_value_t));
+	primec_ir_value_t identities[max_reductions] = {0};
+	primec_ir_value_t results[max_reductions] = {0};
+	const primec_ir_block_s* body = &func->blocks.data[loop->body];
+
+	for (uint32_t index = 0; index + 1 < body->instructions.count; ++index)
+	{
+		const primec_ir_value_t value = body->instructions.data[index];
+		const primec_ir_instruction_s instruction = *primec_ir_func_get(func, value);
+		if (kinds[value] != kind_vector) { continue; }
+		const uint32_t operands[2] = { primec_ir_op_store == instruction.op ? primec_ir_null : instruction.a, instruction.b };
+
+		for (uint32_t operand = 0; operand < 2; ++operand)
+		{
+			const primec_ir_value_t lane = operands[operand];
+			if (primec_ir_null == lane || primec_ir_op_load == instruction.op) { continue; }
+			if (kinds[lane] == kind_vector || kinds[lane] == kind_reduction || splats[lane] != primec_ir_null) { continue; }
+			const primec_type_t vector_type = primec_type_table_get_vector(types, primec_ir_func_get(func, lane)->type, loop->lanes);
+			splats[lane] = primec_ir_func_add(func, guard, primec_ir_op_splat, vector_type, lane, 0);
+		}
+
+		body = &func->blocks.data[loop->body];
+	}
+
+	for (uint32_t index = 0; index < loop->reductions_count; ++index)
+	{
+		const reduction_s* const reduction = &loop->reductions[index];
+		const primec_type_t lane_type = primec_ir_func_get(func, reduction->phi)->type;
+		const uint64_t identity = primec_ir_op_and == reduction->op ?
+			(primec_type_is_signed(types, lane_type) ? UINT64_MAX : get_mask(get_lane_size(lane_type))) : 0;
+		const primec_ir_value_t scalar = add_const(func, guard, lane_type, identity);
+		identities[index] = primec_ir_func_add(func, guard, primec_ir_op_splat,
+			primec_type_table_get_vector(types, lane_type, loop->lanes), scalar, 0);
+	}
+
+	const primec_ir_value_t width = add_const(func, guard, type, loop->lanes);
+	const uint32_t guard_targets[2] = { vector, loop->header };
+	primec_ir_func_add(func, guard, primec_ir_op_branch, primec_type_void, ok, primec_ir_func_add_list(func, guard_targets, 2));
+
+	// NOTE: The vector loop repeats the body for a whole vector of the counters
+	//       at once, with the phis completed once the body is copied.
+	const primec_ir_value_t counter = primec_ir_func_add(func, vector, primec_ir_op_phi, type, 0, 0);
+	map[loop->index] = counter;
+
+	for (uint32_t index = 0; index < loop->reductions_count; ++index)
+	{
+		const primec_type_t lane_type = primec_ir_func_get(func, loop->reductions[index].phi)->type;
+		map[loop->reductions[index].phi] = primec_ir_func_add(func, vector, primec_ir_op_phi,
+			primec_type_table_get_vector(types, lane_type, loop->lanes), 0, 0);
+	}
+
+	for (uint32_t index = 0; index + 1 < func->blocks.data[loop->body].instructions.count; ++index)
+	{
+		const primec_ir_value_t value = func->blocks.data[loop->body].instructions.data[index];
+		const primec_ir_instruction_s instruction = *primec_ir_func_get(func, value);
+
+		switch (kinds[value])
+		{
+			case kind_index:
+			{
+				map[value] = primec_ir_func_add(func, vector, primec_ir_op_convert, instruction.type, map[instruction.a], 0);
+			} break;
+
+			case kind_address:
+			{
+				map[value] = primec_ir_func_add(func, vector, primec_ir_op_element, instruction.type, instruction.a, map[instruction.b]);
+			} break;
+
+			case kind_vector:
+			{
+				const primec_type_t vector_type = primec_type_table_get_vector(types, instruction.type, loop->lanes);
+				const primec_ir_value_t a = kinds[instruction.a] == kind_vector || kinds[instruction.a] == kind_reduction ? map[instruction.a] : splats[instruction.a];
+				const primec_ir_value_t b = kinds[instruction.b] == kind_vector || kinds[instruction.b] == kind_reduction ? map[instruction.b] : splats[instruction.b];
+
+				switch ((primec_ir_op_e)instruction.op)
+				{
+					case primec_ir_op_load:
+					{
+						map[value] = primec_ir_func_add(func, vector, primec_ir_op_load, vector_type, map[instruction.a], 0);
+					} break;
+
+					case primec_ir_op_store:
+					{
+						map[value] = primec_ir_func_add(func, vector, primec_ir_op_store, vector_type, map[instruction.a], b);
+					} break;
+
+					default:
+					{
+						map[value] = primec_ir_func_add(func, vector, instruction.op, vector_type, a, b);
+					} break;
+				}
+			} break;
+
+			default:
+			{
+			} break;
+		}
+	}
+
+	const primec_ir_value_t next = primec_ir_func_add(func, vector, primec_ir_op_add, type, counter, width);
+	const primec_ir_value_t is_looping = primec_ir_func_add(func, vector, primec_ir_op_ne, primec_type_bool, next, end);
+	const uint32_t vector_targets[2] = { vector, merge };
+	primec_ir_func_add(func, vector, primec_ir_op_branch, primec_type_void, is_looping, primec_ir_func_add_list(func, vector_targets, 2));
+
+	const uint32_t counter_incoming[4] = { guard, loop->init, vector, next };
+	primec_ir_func_get(func, counter)->a = primec_ir_func_add_list(func, counter_incoming, 4);
+
+	for (uint32_t index = 0; index < loop->reductions_count; ++index)
+	{
+		const reduction_s* const reduction = &loop->reductions[index];
+		const uint32_t incoming[4] = { guard, identities[index], vector, map[reduction->next] };
+		primec_ir_func_get(func, map[reduction->phi])->a = primec_ir_func_add_list(func, incoming, 4);
+
+		// NOTE: The lanes are combined after the vector loop, and the remainder
+		//       continues from the combined value.
+		const primec_type_t lane_type = primec_ir_func_get(func, reduction->phi)->type;
+		const primec_ir_value_t lanes_value = primec_ir_func_add(func, merge, primec_ir_op_reduce, lane_type, map[reduction->next], reduction->op);
+		results[index] = primec_ir_func_add(func, merge, reduction->op, lane_type, reduction->init, lanes_value);
+	}
+
+	primec_ir_func_add(func, merge, primec_ir_op_jump, primec_type_void, loop->header, 0);
+
+	// NOTE: The header is now entered from the guard and from the merge, with
+	//       the counter and the reductions continuing, where the vectors ended.
+	const primec_ir_block_s* const header = &func->blocks.data[loop->header];
+
+	for (uint32_t position = 0; position < header->instructions.count; ++position)
+	{
+		const primec_ir_value_t value = header->instructions.data[position];
+		primec_ir_instruction_s* const phi = primec_ir_func_get(func, value);
+		if (phi->op != primec_ir_op_phi) { break; }
+
+		uint32_t count = 0;
+		const uint32_t* const list = primec_ir_func_get_list(func, phi->a, &count);
+		uint32_t incoming[6] = {0};
+		primec_debug_assert(4 == count);
+
+		for (uint32_t index = 0; index < count; ++index)
+		{
+			incoming[index] = 0 == index % 2 && list[index] == loop->preheader ? guard : list[index];
+		}
+
+		incoming[4] = merge;
+		incoming[5] = end;
+
+		for (uint32_t index = 0; index < loop->reductions_count; ++index)
+		{
+			if (loop->reductions[index].phi == value) { incoming[5] = results[index]; }
+		}
+
+		phi->a = primec_ir_func_add_list(func, incoming, 6);
+	}
+
+	// NOTE: The preheader enters the guard instead of the header.
+	const primec_ir_block_s* const preheader = &func->blocks.data[loop->preheader];
+	primec_ir_instruction_s* const terminator = primec_ir_func_get(func, preheader->instructions.data[preheader->instructions.count - 1]);
+
+	if (primec_ir_op_jump == terminator->op)
+	{
+		terminator->a = guard;
+	}
+	else
+	{
+		uint32_t count = 0;
+		uint32_t* const targets = primec_ir_func_get_list(func, terminator->b, &count);
+
+		for (uint32_t index = 0; index < count; ++index)
+		{
+			if (targets[index] == loop->header) { targets[index] = guard; }
+		}
+	}
+
+	primec_utils_free(map);
+	primec_utils_free(splats);
+}
+
+static primec_ir_value_t add_const(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_type_t type,
+	const uint64_t value)
+{
+	return primec_ir_func_add_const(func, block, type, (primec_const_value_s) { .uval = value });
+}
+
+static void append(
+	primec_ir_func_s* const func,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	primec_ir_block_s* const record = &func->blocks.data[block];
+
+	if (record->instructions.count >= record->instructions.capacity)
+	{
+		record->instructions.capacity = record->instructions.capacity > 0 ? record->instructions.capacity * 2 : 8;
+		record->instructions.data = primec_utils_realloc(record->instructions.data, record->instructions.capacity * sizeof(primec_ir_value_t));
+	}
+
+	record->instructions.data[record->instructions.count++] = value;
+}
+
+static uint32_t get_lane_size(
+	const primec_type_t type)
+{
+	switch (type)
+	{
+		case primec_type_i8:
+		case primec_type_u8:
+		{
+			return 1;
+		} break;
+
+		case primec_type_i16:
+		case primec_type_u16:
+		{
+			return 2;
+		} break;
+
+		case primec_type_i32:
+		case primec_type_u32:
+		case primec_type_f32:
+		{
+			return 4;
+		} break;
+
+		case primec_type_i64:
+		case primec_type_u64:
+		case primec_type_f64:
+		{
+			return 8;
+		} break;
+
+		default:
+		{
+			return 0;
+		} break;
+	}
+}
+
+static primec_type_t get_unsigned(
+	const primec_type_t type)
+{
+	switch (type)
+	{
+		case primec_type_i8: { return primec_type_u8; } break;
+		case primec_type_i16: { return primec_type_u16; } break;
+		case primec_type_i32: { return primec_type_u32; } break;
+		case primec_type_i64: { return primec_type_u64; } break;
+		default: { return type; } break;
+	}
+}
+
+static uint64_t get_mask(
+	const uint32_t size)
+{
+	return size >= 8 ? UINT64_MAX : ((uint64_t)1 << (size * 8)) - 1;
+}
@@ -0,0 +1,606 @@
+
+/**
+ * @file vm.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/vm.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+#define registers_capacity (UINT64_C(1) << 23)
+#define memory_capacity (UINT64_C(64) << 20)
+#define frames_capacity (UINT64_C(1) << 20)
+
+#define native_stack_arguments 8
+#define native_gprs 6
+#define native_xmms 8
+
+typedef struct
+{
+	const primec_bytecode_func_s* func;
+	const primec_bytecode_instruction_s* ip;	// the call instruction
+	uint64_t* registers;
+	uint8_t* memory;
+} frame_s;
+
+// NOTE: External functions are called through variadic prototypes, so all the
+//       integer registers, all the vector registers (with the count in al, as
+//       the variadic callees expect) and the stack arguments are passed, and
+//       the callees use the ones they take.
+typedef uint64_t (*native_int_f)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, ...);
+typedef double (*native_f64_f)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, ...);
+typedef float (*native_f32_f)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, ...);
+
+static bool execute(
+	const primec_bytecode_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status);
+
+static uint64_t call_native(
+	void* const address,
+	const uint64_t* const registers,
+	const uint32_t* const list);
+
+static float get_f32(
+	const uint64_t bits);
+
+static double get_f64(
+	const uint64_t bits);
+
+static uint64_t from_f32(
+	const float value);
+
+static uint64_t from_f64(
+	const double value);
+
+static bool truncate_float(
+	const double value,
+	const uint32_t shift,
+	const bool is_signed,
+	uint64_t* const result);
+
+bool primec_vm_run(
+	const primec_bytecode_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(entry < module->funcs_count);
+	primec_debug_assert(status != NULL);
+
+	if (!execute(module, entry, status))
+	{
+		return false;
+	}
+
+	// NOTE: The output buffered by the runtime is written out, as the _start of
+	//       the executables does.
+	int32_t flush_status = 0;
+	return UINT32_MAX == module->program->flush || execute(module, module->program->flush, &flush_status);
+}
+
+static bool execute(
+	const primec_bytecode_module_s* const module,
+	const uint32_t entry,
+	int32_t* const status)
+{
+	uint64_t* const registers_stack = primec_utils_malloc(registers_capacity * sizeof(uint64_t));
+	uint8_t* const memory_stack = primec_utils_malloc(memory_capacity);
+	frame_s* const frames = primec_utils_malloc(frames_capacity * sizeof(frame_s));
+	uint64_t frames_count = 0;
+
+	const primec_bytecode_func_s* func = &module->funcs[entry];
+	const primec_bytecode_func_s* const funcs_end = module->funcs + module->funcs_count;
+	uint64_t* r = registers_stack;
+	uint8_t* memory = memory_stack;
+	const primec_bytecode_instruction_s* ip = func->code.data;
+	const primec_bytecode_func_s* callee = NULL;
+	const uint32_t* list = NULL;
+	const char* error = NULL;
+	bool is_returned = false;
+
+	if (func->registers_count > registers_capacity || func->frame_size > memory_capacity)
+	{
+		error = "stack overflow";
+		goto finish;
+	}
+
+	primec_utils_memset(r, 0, func->registers_count * sizeof(uint64_t));
+
+	// NOTE: The dispatch jumps from every handler to the next one through the
+	//       table of the label addresses (a gnu extension).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+	static const void* const labels[primec_bytecode_ops_count] =
+	{
+		[primec_bytecode_op_const] = &&op_const,
+		[primec_bytecode_op_move] = &&op_move,
+		[primec_bytecode_op_frame] = &&op_frame,
+		[primec_bytecode_op_addi] = &&op_addi,
+		[primec_bytecode_op_muli] = &&op_muli,
+		[primec_bytecode_op_load8] = &&op_load8,
+		[primec_bytecode_op_load16] = &&op_load16,
+		[primec_bytecode_op_load32] = &&op_load32,
+		[primec_bytecode_op_load64] = &&op_load64,
+		[primec_bytecode_op_store8] = &&op_store8,
+		[primec_bytecode_op_store16] = &&op_store16,
+		[primec_bytecode_op_store32] = &&op_store32,
+		[primec_bytecode_op_store64] = &&op_store64,
+		[primec_bytecode_op_copy] = &&op_copy,
+		[primec_bytecode_op_zero] = &&op_zero,
+		[primec_bytecode_op_add] = &&op_add,
+		[primec_bytecode_op_sub] = &&op_sub,
+		[primec_bytecode_op_mul] = &&op_mul,
+		[primec_bytecode_op_sdiv] = &&op_sdiv,
+		[primec_bytecode_op_udiv] = &&op_udiv,
+		[primec_bytecode_op_srem] = &&op_srem,
+		[primec_bytecode_op_urem] = &&op_urem,
+		[primec_bytecode_op_and] = &&op_and,
+		[primec_bytecode_op_or] = &&op_or,
+		[primec_bytecode_op_xor] = &&op_xor,
+		[primec_bytecode_op_shl] = &&op_shl,
+		[primec_bytecode_op_sshr] = &&op_sshr,
+		[primec_bytecode_op_ushr] = &&op_ushr,
+		[primec_bytecode_op_neg] = &&op_neg,
+		[primec_bytecode_op_not] = &&op_not,
+		[primec_bytecode_op_extend] = &&op_extend,
+		[primec_bytecode_op_eq] = &&op_eq,
+		[primec_bytecode_op_ne] = &&op_ne,
+		[primec_bytecode_op_slt] = &&op_slt,
+		[primec_bytecode_op_sle] = &&op_sle,
+		[primec_bytecode_op_ult] = &&op_ult,
+		[primec_bytecode_op_ule] = &&op_ule,
+		[primec_bytecode_op_fadd32] = &&op_fadd32,
+		[primec_bytecode_op_fsub32] = &&op_fsub32,
+		[primec_bytecode_op_fmul32] = &&op_fmul32,
+		[primec_bytecode_op_fdiv32] = &&op_fdiv32,
+		[primec_bytecode_op_fneg32] = &&op_fneg32,
+		[primec_bytecode_op_feq32] = &&op_feq32,
+		[primec_bytecode_op_fne32] = &&op_fne32,
+		[primec_bytecode_op_flt32] = &&op_flt32,
+		[primec_bytecode_op_fle32] = &&op_fle32,
+		[primec_bytecode_op_fadd64] = &&op_fadd64,
+		[primec_bytecode_op_fsub64] = &&op_fsub64,
+		[primec_bytecode_op_fmul64] = &&op_fmul64,
+		[primec_bytecode_op_fdiv64] = &&op_fdiv64,
+		[primec_bytecode_op_fneg64] = &&op_fneg64,
+		[primec_bytecode_op_feq64] = &&op_feq64,
+		[primec_bytecode_op_fne64] = &&op_fne64,
+		[primec_bytecode_op_flt64] = &&op_flt64,
+		[primec_bytecode_op_fle64] = &&op_fle64,
+		[primec_bytecode_op_s2f32] = &&op_s2f32,
+		[primec_bytecode_op_u2f32] = &&op_u2f32,
+		[primec_bytecode_op_s2f64] = &&op_s2f64,
+		[primec_bytecode_op_u2f64] = &&op_u2f64,
+		[primec_bytecode_op_f32s] = &&op_f32s,
+		[primec_bytecode_op_f32u] = &&op_f32u,
+		[primec_bytecode_op_f64s] = &&op_f64s,
+		[primec_bytecode_op_f64u] = &&op_f64u,
+		[primec_bytecode_op_f32f64] = &&op_f32f64,
+		[primec_bytecode_op_f64f32] = &&op_f64f32,
+		[primec_bytecode_op_call] = &&op_call,
+		[primec_bytecode_op_call_indirect] = &&op_call_indirect,
+		[primec_bytecode_op_tail_call] = &&op_tail_call,
+		[primec_bytecode_op_tail_call_indirect] = &&op_tail_call_indirect,
+		[primec_bytecode_op_jump] = &&op_jump,
+		[primec_bytecode_op_branch] = &&op_branch,
+		[primec_bytecode_op_check] = &&op_check,
+		[primec_bytecode_op_ret] = &&op_ret,
+		[primec_bytecode_op_trap] = &&op_trap
+	};
+
+#define dispatch() goto *labels[ip->op]
+#define next() do { ++ip; dispatch(); } while (0)
+#define normalize(_value) (ip->is_signed                                          \
+	? (uint64_t)((int64_t)((uint64_t)(_value) << ip->shift) >> ip->shift)      \
+	: ((uint64_t)(_value) << ip->shift) >> ip->shift)
+#define shift_mask (0 == ip->shift ? 63u : 31u)
+
+	dispatch();
+
+op_const: { r[ip->a] = (uint64_t)ip->b | ((uint64_t)ip->c << 32); next(); }
+op_move: { r[ip->a] = r[ip->b]; next(); }
+op_frame: { r[ip->a] = (uint64_t)(uintptr_t)(memory + ip->b); next(); }
+op_addi: { r[ip->a] = r[ip->b] + ip->c; next(); }
+op_muli: { r[ip->a] = r[ip->b] * ip->c; next(); }
+
+op_load8:
+{
+	const uint8_t value = *(const uint8_t*)(uintptr_t)r[ip->b];
+	r[ip->a] = ip->is_signed ? (uint64_t)(int64_t)(int8_t)value : value;
+	next();
+}
+
+op_load16:
+{
+	uint16_t value = 0;
+	primec_utils_memcpy(&value, (const void*)(uintptr_t)r[ip->b], sizeof(value));
+	r[ip->a] = ip->is_signed ? (uint64_t)(int64_t)(int16_t)value : value;
+	next();
+}
+
+op_load32:
+{
+	uint32_t value = 0;
+	primec_utils_memcpy(&value, (const void*)(uintptr_t)r[ip->b], sizeof(value));
+	r[ip->a] = ip->is_signed ? (uint64_t)(int64_t)(int32_t)value : value;
+	next();
+}
+
+op_load64: { primec_utils_memcpy(&r[ip->a], (const void*)(uintptr_t)r[ip->b], sizeof(uint64_t)); next(); }
+op_store8: { *(uint8_t*)(uintptr_t)r[ip->a] = (uint8_t)r[ip->b]; next(); }
+op_store16: { const uint16_t value = (uint16_t)r[ip->b]; primec_utils_memcpy((void*)(uintptr_t)r[ip->a], &value, sizeof(value)); next(); }
+op_store32: { const uint32_t value = (uint32_t)r[ip->b]; primec_utils_memcpy((void*)(uintptr_t)r[ip->a], &value, sizeof(value)); next(); }
+op_store64: { primec_utils_memcpy((void*)(uintptr_t)r[ip->a], &r[ip->b], sizeof(uint64_t)); next(); }
+op_copy: { primec_utils_memcpy((void*)(uintptr_t)r[ip->a], (const void*)(uintptr_t)r[ip->b], ip->c); next(); }
+op_zero: { primec_utils_memset((void*)(uintptr_t)r[ip->a], 0, ip->c); next(); }
+
+op_add: { r[ip->a] = normalize(r[ip->b] + r[ip->c]); next(); }
+op_sub: { r[ip->a] = normalize(r[ip->b] - r[ip->c]); next(); }
+op_mul: { r[ip->a] = normalize(r[ip->b] * r[ip->c]); next(); }
+
+op_sdiv:
+{
+	if (0 == r[ip->c]) { error = "division by zero"; goto finish; }
+	const int64_t left = (int64_t)r[ip->b];
+	const int64_t right = (int64_t)r[ip->c];
+	if (-1 == right && INT64_MIN >> ip->shift == left) { error = "integer overflow"; goto finish; }
+	r[ip->a] = normalize((uint64_t)(left / right));
+	next();
+}
+
+op_udiv: { if (0 == r[ip->c]) { error = "division by zero"; goto finish; } r[ip->a] = normalize(r[ip->b] / r[ip->c]); next(); }
+
+op_srem:
+{
+	if (0 == r[ip->c]) { error = "division by zero"; goto finish; }
+	const int64_t left = (int64_t)r[ip->b];
+	const int64_t right = (int64_t)r[ip->c];
+	if (-1 == right && INT64_MIN >> ip->shift == left) { error = "integer overflow"; goto finish; }
+	r[ip->a] = normalize((uint64_t)(left % right));
+	next();
+}
+
+op_urem: { if (0 == r[ip->c]) { error = "division by zero"; goto finish; } r[ip->a] = normalize(r[ip->b] % r[ip->c]); next(); }
+op_and: { r[ip->a] = normalize(r[ip->b] & r[ip->c]); next(); }
+op_or: { r[ip->a] = normalize(r[ip->b] | r[ip->c]); next(); }
+op_xor: { r[ip->a] = normalize(r[ip->b] ^ r[ip->c]); next(); }
+op_shl: { r[ip->a] = normalize(r[ip->b] << (r[ip->c] & shift_mask)); next(); }
+op_sshr: { r[ip->a] = normalize((uint64_t)((int64_t)r[ip->b] >> (r[ip->c] & shift_mask))); next(); }
+op_ushr: { r[ip->a] = normalize(r[ip->b] >> (r[ip->c] & shift_mask)); next(); }
+op_neg: { r[ip->a] = normalize(0 - r[ip->b]); next(); }
+op_not: { r[ip->a] = normalize(~r[ip->b]); next(); }
+op_extend: { r[ip->a] = normalize(r[ip->b]); next(); }
+
+op_eq: { r[ip->a] = r[ip->b] == r[ip->c]; next(); }
+op_ne: { r[ip->a] = r[ip->b] != r[ip->c]; next(); }
+op_slt: { r[ip->a] = (int64_t)r[ip->b] < (int64_t)r[ip->c]; next(); }
+op_sle: { r[ip->a] = (int64_t)r[ip->b] <= (int64_t)r[ip->c]; next(); }
+op_ult: { r[ip->a] = r[ip->b] < r[ip->c]; next(); }
+op_ule: { r[ip->a] = r[ip->b] <= r[ip->c]; next(); }
+
+op_fadd32: { r[ip->a] = from_f32(get_f32(r[ip->b]) + get_f32(r[ip->c])); next(); }
+op_fsub32: { r[ip->a] = from_f32(get_f32(r[ip->b]) - get_f32(r[ip->c])); next(); }
+op_fmul32: { r[ip->a] = from_f32(get_f32(r[ip->b]) * get_f32(r[ip->c])); next(); }
+op_fdiv32: { r[ip->a] = from_f32(get_f32(r[ip->b]) / get_f32(r[ip->c])); next(); }
+op_fneg32: { r[ip->a] = from_f32(-get_f32(r[ip->b])); next(); }
+op_feq32: { r[ip->a] = get_f32(r[ip->b]) == get_f32(r[ip->c]); next(); }
+op_fne32: { r[ip->a] = get_f32(r[ip->b]) != get_f32(r[ip->c]); next(); }
+op_flt32: { r[ip->a] = get_f32(r[ip->b]) < get_f32(r[ip->c]); next(); }
+op_fle32: { r[ip->a] = get_f32(r[ip->b]) <= get_f32(r[ip->c]); next(); }
+op_fadd64: { r[ip->a] = from_f64(get_f64(r[ip->b]) + get_f64(r[ip->c])); next(); }
+op_fsub64: { r[ip->a] = from_f64(get_f64(r[ip->b]) - get_f64(r[ip->c])); next(); }
+op_fmul64: { r[ip->a] = from_f64(get_f64(r[ip->b]) * get_f64(r[ip->c])); next(); }
+op_fdiv64: { r[ip->a] = from_f64(get_f64(r[ip->b]) / get_f64(r[ip->c])); next(); }
+op_fneg64: { r[ip->a] = from_f64(-get_f64(r[ip->b])); next(); }
+op_feq64: { r[ip->a] = get_f64(r[ip->b]) == get_f64(r[ip->c]); next(); }
+op_fne64: { r[ip->a] = get_f64(r[ip->b]) != get_f64(r[ip->c]); next(); }
+op_flt64: { r[ip->a] = get_f64(r[ip->b]) < get_f64(r[ip->c]); next(); }
+op_fle64: { r[ip->a] = get_f64(r[ip->b]) <= get_f64(r[ip->c]); next(); }
+
+op_s2f32: { r[ip->a] = from_f32((float)(int64_t)r[ip->b]); next(); }
+op_u2f32: { r[ip->a] = from_f32((float)r[ip->b]); next(); }
+op_s2f64: { r[ip->a] = from_f64((double)(int64_t)r[ip->b]); next(); }
+op_u2f64: { r[ip->a] = from_f64((double)r[ip->b]); next(); }
+op_f32s:
+op_f32u:
+{
+	if (!truncate_float((double)get_f32(r[ip->b]), ip->shift, ip->is_signed, &r[ip->a])) { error = "conversion out of range"; goto finish; }
+	next();
+}
+
+op_f64s:
+op_f64u:
+{
+	if (!truncate_float(get_f64(r[ip->b]), ip->shift, ip->is_signed, &r[ip->a])) { error = "conversion out of range"; goto finish; }
+	next();
+}
+
+op_f32f64: { r[ip->a] = from_f64((double)get_f32(r[ip->b])); next(); }
+op_f64f32: { r[ip->a] = from_f32((float)get_f64(r[ip->b])); next(); }
+
+op_call:
+{
+	callee = &module->funcs[ip->b];
+	list = &func->lists.data[ip->c];
+
+	if (callee->native != NULL)
+	{
+		const uint64_t result = call_native(callee->native, r, list);
+		r[ip->a] = primec_bytecode_class_int == list[0] >> primec_bytecode_class_shift ? normalize(result) : result;
+		next();
+	}
+
+	goto call;
+}
+
+op_call_indirect:
+{
+	const uint64_t target = r[ip->b];
+	list = &func->lists.data[ip->c];
+
+	// NOTE: Addresses of the compiled functions are called by the bytecode,
+	//       and the other ones natively.
+	if (target < (uint64_t)(uintptr_t)module->funcs || target >= (uint64_t)(uintptr_t)funcs_end)
+	{
+		const uint64_t result = call_native((void*)(uintptr_t)target, r, list);
+		r[ip->a] = primec_bytecode_class_int == list[0] >> primec_bytecode_class_shift ? normalize(result) : result;
+		next();
+	}
+
+	callee = (const primec_bytecode_func_s*)(uintptr_t)target;
+	goto call;
+}
+
+call:
+{
+	uint64_t* const registers = r + func->registers_count;
+	uint8_t* const frame = memory + func->frame_size;
+
+	if (frames_count >= frames_capacity ||
+		(uint64_t)(registers + callee->registers_count - registers_stack) > registers_capacity ||
+		(uint64_t)(frame + callee->frame_size - memory_stack) > memory_capacity)
+	{
+		error = "stack overflow";
+		goto finish;
+	}
+
+	const uint32_t count = list[0] & primec_bytecode_register_mask;
+	primec_debug_assert(count == callee->params_count);
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		registers[callee->params[index]] = r[list[1 + index] & primec_bytecode_register_mask];
+	}
+
+	frames[frames_count++] = (frame_s) { .func = func, .ip = ip, .registers = r, .memory = memory };
+	func = callee;
+	r = registers;
+	memory = frame;
+	ip = callee->code.data;
+	dispatch();
+}
+
+op_tail_call:
+{
+	callee = &module->funcs[ip->b];
+	list = &func->lists.data[ip->c];
+	if (callee->native != NULL) { goto op_call; }
+	goto tail_call;
+}
+
+op_tail_call_indirect:
+{
+	const uint64_t target = r[ip->b];
+	if (target < (uint64_t)(uintptr_t)module->funcs || target >= (uint64_t)(uintptr_t)funcs_end) { goto op_call_indirect; }
+	callee = (const primec_bytecode_func_s*)(uintptr_t)target;
+	list = &func->lists.data[ip->c];
+	goto tail_call;
+}
+
+tail_call:
+{
+	// NOTE: The callee takes over the registers and the frame of the caller,
+	//       so the arguments are gathered past its registers first, as the
+	//       parameters may overwrite them.
+	const uint32_t count = list[0] & primec_bytecode_register_mask;
+	uint64_t* const arguments = r + func->registers_count;
+
+	if ((uint64_t)(arguments + count - registers_stack) > registers_capacity ||
+		(uint64_t)(r + callee->registers_count - registers_stack) > registers_capacity ||
+		(uint64_t)(memory + callee->frame_size - memory_stack) > memory_capacity)
+	{
+		error = "stack overflow";
+		goto finish;
+	}
+
+	primec_debug_assert(count == callee->params_count);
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		arguments[index] = r[list[1 + index] & primec_bytecode_register_mask];
+	}
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		r[callee->params[index]] = arguments[index];
+	}
+
+	func = callee;
+	ip = callee->code.data;
+	dispatch();
+}
+
+op_jump: { ip = func->code.data + ip->b; dispatch(); }
+op_branch: { ip = func->code.data + (r[ip->a] ? ip->b : ip->c); dispatch(); }
+op_check: { if (r[ip->a] >= r[ip->b]) { error = "index out of bounds"; goto finish; } next(); }
+
+op_ret:
+{
+	const uint64_t value = r[ip->a];
+
+	if (0 == frames_count)
+	{
+		*status = primec_type_void == primec_type_table_get(module->program->types, module->program->funcs.data[entry]->type)->element
+			? 0 : (int32_t)value;
+		is_returned = true;
+		goto finish;
+	}
+
+	const frame_s* const caller = &frames[--frames_count];
+	func = caller->func;
+	ip = caller->ip;
+	r = caller->registers;
+	memory = caller->memory;
+	r[ip->a] = value;
+	next();
+}
+
+op_trap: { error = "unreachable code reached"; goto finish; }
+
+#undef dispatch
+#undef next
+#undef normalize
+#undef shift_mask
+#pragma GCC diagnostic pop
+
+finish:
+	if (error != NULL)
+	{
+		primec_logger_error("runtime error in `%s`: %s.", func->name, error);
+	}
+
+	primec_utils_free(registers_stack);
+	primec_utils_free(memory_stack);
+	primec_utils_free(frames);
+	return is_returned;
+}
+
+static uint64_t call_native(
+	void* const address,
+	const uint64_t* const registers,
+	const uint32_t* const list)
+{
+	uint64_t gprs[native_gprs] = {0};
+	double xmms[native_xmms] = {0};
+	uint64_t stack[native_stack_arguments] = {0};
+	uint32_t gprs_count = 0;
+	uint32_t xmms_count = 0;
+	uint32_t stack_count = 0;
+
+	// NOTE: Floats of 32 bits are passed in the low bits of the vector registers,
+	//       as the bits of the doubles, so they are not converted.
+	const uint32_t count = list[0] & primec_bytecode_register_mask;
+
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		const uint32_t class = list[1 + index] >> primec_bytecode_class_shift;
+		const uint64_t value = registers[list[1 + index] & primec_bytecode_register_mask];
+
+		if (primec_bytecode_class_int == class && gprs_count < native_gprs) { gprs[gprs_count++] = value; }
+		else if (class != primec_bytecode_class_int && xmms_count < native_xmms) { xmms[xmms_count++] = get_f64(value); }
+		else { primec_debug_assert(stack_count < native_stack_arguments); stack[stack_count++] = value; }
+	}
+
+	switch ((primec_bytecode_class_e)(list[0] >> primec_bytecode_class_shift))
+	{
+		case primec_bytecode_class_f64:
+		{
+			native_f64_f function = NULL;
+			primec_utils_memcpy(&function, &address, sizeof(function));
+			return from_f64(function(gprs[0], gprs[1], gprs[2], gprs[3], gprs[4], gprs[5],
+				xmms[0], xmms[1], xmms[2], xmms[3], xmms[4], xmms[5], xmms[6], xmms[7],
+				stack[0], stack[1], stack[2], stack[3], stack[4], stack[5], stack[6], stack[7]));
+		} break;
+
+		case primec_bytecode_class_f32:
+		{
+			native_f32_f function = NULL;
+			primec_utils_memcpy(&function, &address, sizeof(function));
+			return from_f32(function(gprs[0], gprs[1], gprs[2], gprs[3], gprs[4], gprs[5],
+				xmms[0], xmms[1], xmms[2], xmms[3], xmms[4], xmms[5], xmms[6], xmms[7],
+				stack[0], stack[1], stack[2], stack[3], stack[4], stack[5], stack[6], stack[7]));
+		} break;
+
+		default:
+		{
+			native_int_f function = NULL;
+			primec_utils_memcpy(&function, &address, sizeof(function));
+			return function(gprs[0], gprs[1], gprs[2], gprs[3], gprs[4], gprs[5],
+				xmms[0], xmms[1], xmms[2], xmms[3], xmms[4], xmms[5], xmms[6], xmms[7],
+				stack[0], stack[1], stack[2], stack[3], stack[4], stack[5], stack[6], stack[7]);
+		} break;
+	}
+}
+
+static float get_f32(
+	const uint64_t bits)
+{
+	const uint32_t narrow = (uint32_t)bits;
+	float value = 0;
+	primec_utils_memcpy(&value, &narrow, sizeof(value));
+	return value;
+}
+
+static double get_f64(
+	const uint64_t bits)
+{
+	double value = 0;
+	primec_utils_memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static uint64_t from_f32(
+	const float value)
+{
+	uint32_t bits = 0;
+	primec_utils_memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static uint64_t from_f64(
+	const double value)
+{
+	uint64_t bits = 0;
+	primec_utils_memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static bool truncate_float(
+	const double value,
+	const uint32_t shift,
+	const bool is_signed,
+	uint64_t* const result)
+{
+	// NOTE: The floats are truncated toward zero, so the ones, whose integral
+	//       parts fit the integer type, are converted, while the others (and
+	//       the nans) are the runtime errors, like in the native code.
+	const uint32_t width = 64 - shift;
+
+	if (is_signed)
+	{
+		// NOTE: The smallest integer minus one is not a double for 64 bits, so
+		//       it rounds to the smallest integer, which is compared apart.
+		const double limit = (double)(UINT64_C(1) << (width - 1));
+		if (!(value < limit && (value > -limit - 1.0 || value == -limit))) { return false; }
+		*result = (uint64_t)(int64_t)value;
+		return true;
+	}
+
+	const double limit = 64 == width ? 18446744073709551616.0 : (double)(UINT64_C(1) << width);
+	if (!(value > -1.0 && value < limit)) { return false; }
+	*result = (uint64_t)value;
+	return true;
+}
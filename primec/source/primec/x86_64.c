@@ -0,0 +1,3230 @@
+
+/**
+ * @file x86_64.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/x86_64.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+#include <primec/cfg.h>
+#include <primec/layout.h>
+#include <primec/regalloc.h>
+#include <primec/string_pool.h>
+#include <primec/x86_64_encoder.h>
+#include <primec/elf.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+
+// NOTE: The first stack argument is above the saved frame pointer and the
+//       return address.
+#define stack_arguments_offset 16
+
+// NOTE: Aggregates up to this size are copied and cleared by the moves of
+//       their words, the bigger ones by the string instructions.
+#define inline_copy_limit 64
+
+#define args_gprs_count 6
+#define args_xmms_count 8
+
+typedef struct
+{
+	const char* name;
+	uint32_t flags;
+} op_info_s;
+
+static const op_info_s g_ops[] =
+{
+	[primec_x86_64_op_label] = { "label", 0 },
+	[primec_x86_64_op_prologue] = { "prologue", 0 },
+	[primec_x86_64_op_mov] = { "mov", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_movzx] = { "movzx", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_movsx] = { "movsx", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_lea] = { "lea", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_add] = { "add", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_sub] = { "sub", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_and] = { "and", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_or] = { "or", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_xor] = { "xor", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_cmp] = { "cmp", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_test] = { "test", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_imul] = { "imul", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_neg] = { "neg", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_not] = { "not", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_shl] = { "shl", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_shr] = { "shr", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_sar] = { "sar", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_cqo] = { "cqo", 0 },
+	[primec_x86_64_op_div] = { "div", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_idiv] = { "idiv", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_setcc] = { "set", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_jmp] = { "jmp", 0 },
+	[primec_x86_64_op_jcc] = { "j", 0 },
+	[primec_x86_64_op_call] = { "call", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_ret] = { "ret", 0 },
+	[primec_x86_64_op_tail] = { "jmp", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_ud2] = { "ud2", 0 },
+	[primec_x86_64_op_rep_movsb] = { "rep movsb", 0 },
+	[primec_x86_64_op_rep_stosb] = { "rep stosb", 0 },
+	[primec_x86_64_op_movf] = { "movs", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_movq] = { "movq", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_zerof] = { "xorps", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_addf] = { "adds", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_subf] = { "subs", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_mulf] = { "muls", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_divf] = { "divs", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_ucomif] = { "ucomis", primec_x86_64_op_flag_reads },
+	[primec_x86_64_op_cvtsi2f] = { "cvtsi2s", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_cvtf2si] = { "cvtts", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_cvtf2f] = { "cvts", primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_addp] = { "addp", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_subp] = { "subp", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_mulp] = { "mulp", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_divp] = { "divp", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_padd] = { "padd", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_psub] = { "psub", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_pmullw] = { "pmullw", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_pand] = { "pand", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_por] = { "por", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_pxor] = { "pxor", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_psrldq] = { "psrldq", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes },
+	[primec_x86_64_op_punpcklqdq] = { "punpcklqdq", primec_x86_64_op_flag_reads | primec_x86_64_op_flag_writes }
+};
+
+_Static_assert(
+	(sizeof(g_ops) / sizeof(g_ops[0])) == primec_x86_64_ops_count,
+	"g_ops is not in sync with primec_x86_64_op_e enum!"
+);
+
+static const char* const g_conds[] =
+{
+	[primec_x86_64_cond_o] = "o",
+	[primec_x86_64_cond_no] = "no",
+	[primec_x86_64_cond_b] = "b",
+	[primec_x86_64_cond_ae] = "ae",
+	[primec_x86_64_cond_e] = "e",
+	[primec_x86_64_cond_ne] = "ne",
+	[primec_x86_64_cond_be] = "be",
+	[primec_x86_64_cond_a] = "a",
+	[primec_x86_64_cond_s] = "s",
+	[primec_x86_64_cond_ns] = "ns",
+	[primec_x86_64_cond_p] = "p",
+	[primec_x86_64_cond_np] = "np",
+	[primec_x86_64_cond_l] = "l",
+	[primec_x86_64_cond_ge] = "ge",
+	[primec_x86_64_cond_le] = "le",
+	[primec_x86_64_cond_g] = "g"
+};
+
+_Static_assert(
+	(sizeof(g_conds) / sizeof(g_conds[0])) == primec_x86_64_conds_count,
+	"g_conds is not in sync with primec_x86_64_condition_e enum!"
+);
+
+static const char* const g_gprs[4][16] =
+{
+	{ "al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil", "r8b", "r9b", "r10b", "r11b", "r12b", "r13b", "r14b", "r15b" },
+	{ "ax", "cx", "dx", "bx", "sp", "bp", "si", "di", "r8w", "r9w", "r10w", "r11w", "r12w", "r13w", "r14w", "r15w" },
+	{ "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi", "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d" },
+	{ "rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15" }
+};
+
+static const uint32_t g_args_gprs[args_gprs_count] =
+{
+	primec_x86_64_reg_rdi, primec_x86_64_reg_rsi, primec_x86_64_reg_rdx,
+	primec_x86_64_reg_rcx, primec_x86_64_reg_r8, primec_x86_64_reg_r9
+};
+
+// NOTE: Registers, that are not preserved by the calls.
+static const uint32_t g_clobbers_mask =
+	1u << primec_x86_64_reg_rax | 1u << primec_x86_64_reg_rcx | 1u << primec_x86_64_reg_rdx |
+	1u << primec_x86_64_reg_rsi | 1u << primec_x86_64_reg_rdi | 1u << primec_x86_64_reg_r8 |
+	1u << primec_x86_64_reg_r9 | 1u << primec_x86_64_reg_r10 | 1u << primec_x86_64_reg_r11 | 0xffff0000u;
+
+typedef struct
+{
+	uint32_t reg;	// machine register, or UINT32_MAX if passed on the stack
+	uint32_t stack;	// index of the stack argument
+} location_s;
+
+typedef enum
+{
+	parity_none,
+	parity_clear,	// the condition holds only if the parity flag is clear (ordered equality)
+	parity_set,		// the condition holds also if the parity flag is set (unordered inequality)
+} parity_e;
+
+typedef struct
+{
+	primec_x86_64_condition_e cond;
+	parity_e parity;
+} compare_s;
+
+typedef struct
+{
+	const primec_ir_program_s* program;
+	const primec_type_table_s* types;
+	const primec_ir_func_s* ir;
+	primec_x86_64_func_s* func;
+	uint32_t* vregs;
+	uint32_t* slots;
+	uint32_t* uses;
+	bool* fused;
+	location_s* params;
+	uint32_t params_count;
+	uint32_t trap;
+} selector_s;
+
+typedef struct
+{
+	primec_x86_64_module_s* module;
+	uint32_t index;
+} generate_task_s;
+
+typedef struct
+{
+	const char** data;
+	uint32_t capacity;
+	uint32_t count;
+} names_s;
+
+static void generate_task(
+	void* const context);
+
+static void select_func(
+	primec_x86_64_func_s* const func,
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const ir);
+
+static void prepare(
+	selector_s* const selector);
+
+static void count_uses(
+	selector_s* const selector,
+	const primec_ir_instruction_s* const instruction);
+
+static void assign_params(
+	selector_s* const selector);
+
+static bool defines_register(
+	const selector_s* const selector,
+	const primec_ir_value_t value);
+
+static bool is_frame_address(
+	const selector_s* const selector,
+	const primec_ir_value_t value);
+
+static bool is_folded(
+	const selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_block(
+	selector_s* const selector,
+	const primec_ir_block_t block);
+
+static void select_instruction(
+	selector_s* const selector,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static void select_param(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_load(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_store(
+	selector_s* const selector,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value);
+
+static void select_copy(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_zero(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_element(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_arithmetic(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_division(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_shift(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_unary(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_comparison(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_convert(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_vector_arithmetic(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_splat(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_reduce(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static bool is_sibling_call(
+	const selector_s* const selector,
+	const primec_ir_block_s* const record,
+	const uint32_t index);
+
+static void select_call(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const bool is_sibling);
+
+static void select_check(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_ret(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static void select_branch(
+	selector_s* const selector,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value);
+
+static uint32_t select_edge(
+	selector_s* const selector,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to,
+	uint32_t* const pending);
+
+static void select_phi_moves(
+	selector_s* const selector,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to);
+
+static compare_s select_compare(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static bool has_phis(
+	const selector_s* const selector,
+	const primec_ir_block_t block);
+
+static primec_x86_64_instruction_s* emit(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const uint32_t size);
+
+static void emit_binary(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const uint32_t size,
+	const primec_x86_64_operand_s destination,
+	const primec_x86_64_operand_s source);
+
+static void emit_move(
+	selector_s* const selector,
+	const uint32_t destination,
+	const uint32_t source);
+
+static void emit_extend(
+	selector_s* const selector,
+	const uint32_t destination,
+	const uint32_t source,
+	const uint32_t from,
+	const uint32_t to,
+	const bool is_signed);
+
+static void emit_label(
+	selector_s* const selector,
+	const uint32_t block);
+
+static void emit_jump(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const primec_x86_64_condition_e cond,
+	const uint32_t block);
+
+static uint32_t new_vreg(
+	selector_s* const selector,
+	const primec_x86_64_class_e class);
+
+static uint32_t new_block(
+	selector_s* const selector);
+
+static uint32_t get_trap(
+	selector_s* const selector);
+
+static primec_x86_64_operand_s get_address(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static primec_x86_64_operand_s get_source(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size);
+
+static uint32_t get_register(
+	selector_s* const selector,
+	const primec_ir_value_t value);
+
+static uint32_t get_extended(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size);
+
+static bool get_immediate(
+	const selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size,
+	int64_t* const immediate);
+
+static const primec_ir_instruction_s* get_instruction(
+	const selector_s* const selector,
+	const primec_ir_value_t value);
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static primec_type_t get_pointee(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static bool is_float(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static bool is_vector(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static bool is_signed(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type);
+
+static uint64_t get_float_bits(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const primec_const_value_s value);
+
+static primec_x86_64_operand_s reg_operand(
+	const uint32_t reg);
+
+static primec_x86_64_operand_s imm_operand(
+	const int64_t value);
+
+static primec_x86_64_operand_s mem_operand(
+	const uint32_t base,
+	const int64_t displacement);
+
+static primec_x86_64_operand_s rip_operand(
+	const primec_x86_64_symbol_kind_e kind,
+	const uint32_t symbol);
+
+static void finalize_func(
+	primec_x86_64_func_s* const func);
+
+static void assign_names(
+	primec_x86_64_module_s* const module);
+
+static const char* claim_name(
+	names_s* const names,
+	const char* const name);
+
+static void write_start(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	FILE* const file);
+
+static void write_func(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_func_s* const func,
+	FILE* const file);
+
+static void write_instruction(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_func_s* const func,
+	const primec_x86_64_instruction_s* const instruction,
+	FILE* const file);
+
+static void write_operand(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_operand_s* const operand,
+	const uint32_t size,
+	const bool has_size,
+	FILE* const file);
+
+static void write_global(
+	const primec_x86_64_module_s* const module,
+	const uint32_t index,
+	FILE* const file);
+
+static void write_strings(
+	const primec_ir_program_s* const program,
+	FILE* const file);
+
+static const char* get_reg_name(
+	const uint32_t reg,
+	const uint32_t size);
+
+uint32_t primec_x86_64_op_get_flags(
+	const primec_x86_64_op_e op)
+{
+	primec_debug_assert(op < primec_x86_64_ops_count);
+	return g_ops[op].flags;
+}
+
+primec_x86_64_module_s* primec_x86_64_generate(
+	const primec_ir_program_s* const program,
+	primec_thread_pool_s* const pool)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(pool != NULL);
+
+	primec_x86_64_module_s* const module = primec_utils_malloc(sizeof(primec_x86_64_module_s));
+	const uint32_t funcs_count = program->funcs.count;
+
+	*module = (primec_x86_64_module_s)
+	{
+		.program = program,
+		.funcs = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(primec_x86_64_func_s)),
+		.func_names = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(char*)),
+		.global_names = primec_utils_malloc((program->globals.count > 0 ? program->globals.count : 1) * sizeof(char*))
+	};
+
+	primec_utils_memset(module->funcs, 0, (funcs_count > 0 ? funcs_count : 1) * sizeof(primec_x86_64_func_s));
+	assign_names(module);
+
+	generate_task_s* const tasks = primec_utils_malloc((funcs_count > 0 ? funcs_count : 1) * sizeof(generate_task_s));
+	primec_thread_pool_group_s group = {0};
+
+	for (uint32_t index = 0; index < funcs_count; ++index)
+	{
+		module->funcs[index].index = index;
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+
+		tasks[index] = (generate_task_s) { .module = module, .index = index };
+		primec_thread_pool_submit(pool, &group, generate_task, &tasks[index]);
+	}
+
+	primec_thread_pool_wait(pool, &group);
+	primec_utils_free(tasks);
+	return module;
+}
+
+void primec_x86_64_destroy(
+	primec_x86_64_module_s* const module)
+{
+	primec_debug_assert(module != NULL);
+
+	for (uint32_t index = 0; index < module->program->funcs.count; ++index)
+	{
+		primec_utils_free(module->funcs[index].code.data);
+		primec_utils_free(module->funcs[index].vregs.data);
+		primec_utils_free(module->funcs[index].bytes.data);
+		primec_utils_free(module->funcs[index].relocations.data);
+		primec_utils_free(module->func_names[index]);
+	}
+
+	for (uint32_t index = 0; index < module->program->globals.count; ++index)
+	{
+		primec_utils_free(module->global_names[index]);
+	}
+
+	primec_utils_free(module->funcs);
+	primec_utils_free(module->func_names);
+	primec_utils_free(module->global_names);
+	primec_utils_free(module);
+}
+
+uint32_t primec_x86_64_find_entry(
+	const primec_ir_program_s* const program,
+	const char* const entry)
+{
+	primec_debug_assert(program != NULL);
+	primec_debug_assert(entry != NULL);
+
+	// NOTE: Functions are declared in the order of the modules, so the roots
+	//       come last.
+	for (uint32_t index = program->funcs.count; index > 0; --index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index - 1];
+		if (func->flags & (primec_ir_func_flag_extern | primec_ir_func_flag_lambda)) { continue; }
+		if (0 == primec_utils_strcmp(func->name, entry)) { return index - 1; }
+	}
+
+	return UINT32_MAX;
+}
+
+bool primec_x86_64_calls_externs(
+	const primec_x86_64_module_s* const module)
+{
+	primec_debug_assert(module != NULL);
+	const primec_ir_program_s* const program = module->program;
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_x86_64_func_s* const func = &module->funcs[index];
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+
+		for (uint32_t relocation = 0; relocation < func->relocations.count; ++relocation)
+		{
+			const primec_x86_64_relocation_s* const record = &func->relocations.data[relocation];
+			// NOTE: The syscall of the runtime is a stub of the module itself.
+			if (record->symbol_kind != primec_x86_64_symbol_func || record->symbol == program->syscall) { continue; }
+			if (program->funcs.data[record->symbol]->flags & primec_ir_func_flag_extern) { return true; }
+		}
+	}
+
+	return false;
+}
+
+void primec_x86_64_write_assembly(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	FILE* const file)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(file != NULL);
+	const primec_ir_program_s* const program = module->program;
+	primec_debug_assert(UINT32_MAX == entry || entry < program->funcs.count);
+
+	(void)fprintf(file, "\t.intel_syntax noprefix\n\t.text\n");
+
+	if (entry != UINT32_MAX)
+	{
+		write_start(module, entry, file);
+	}
+
+	if (program->syscall != UINT32_MAX)
+	{
+		const char* const name = module->func_names[program->syscall];
+		(void)fprintf(file, "\t.p2align 4\n\t.type %s, @function\n%s:\n", name, name);
+		(void)fprintf(file, "\tmov rax, rdi\n\tmov rdi, rsi\n\tmov rsi, rdx\n\tmov rdx, rcx\n");
+		(void)fprintf(file, "\tmov r10, r8\n\tmov r8, r9\n\tmov r9, qword ptr [rsp+8]\n\tsyscall\n\tret\n");
+	}
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		if (program->funcs.data[index]->flags & primec_ir_func_flag_extern) { continue; }
+		write_func(module, &module->funcs[index], file);
+	}
+
+	if (program->globals.count > 0)
+	{
+		(void)fprintf(file, "\t.data\n");
+	}
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		write_global(module, index, file);
+	}
+
+	if (program->strings.count > 0)
+	{
+		write_strings(program, file);
+	}
+
+	(void)fprintf(file, "\t.section .note.GNU-stack,\"\",@progbits\n");
+}
+
+bool primec_x86_64_link(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	const char* const output)
+{
+	primec_debug_assert(module != NULL);
+	primec_debug_assert(output != NULL);
+
+	return primec_elf_write_executable(module, entry, output);
+}
+
+static void generate_task(
+	void* const context)
+{
+	const generate_task_s* const task = (const generate_task_s*)context;
+	primec_x86_64_func_s* const func = &task->module->funcs[task->index];
+	const primec_ir_program_s* const program = task->module->program;
+
+	select_func(func, program, primec_ir_program_get_func(program, task->index));
+	primec_regalloc_run(func);
+	finalize_func(func);
+	primec_x86_64_encode(func);
+}
+
+static void select_func(
+	primec_x86_64_func_s* const func,
+	const primec_ir_program_s* const program,
+	const primec_ir_func_s* const ir)
+{
+	const uint32_t count = ir->instructions.count;
+
+	selector_s selector =
+	{
+		.program = program,
+		.types = program->types,
+		.ir = ir,
+		.func = func,
+		.vregs = primec_utils_malloc(count * sizeof(uint32_t)),
+		.slots = primec_utils_malloc(count * sizeof(uint32_t)),
+		.uses = primec_utils_malloc(count * sizeof(uint32_t)),
+		.fused = primec_utils_malloc(count * sizeof(bool)),
+		.trap = UINT32_MAX
+	};
+
+	primec_utils_memset(selector.vregs, 0, count * sizeof(uint32_t));
+	primec_utils_memset(selector.slots, 0, count * sizeof(uint32_t));
+	primec_utils_memset(selector.uses, 0, count * sizeof(uint32_t));
+	primec_utils_memset(selector.fused, 0, count * sizeof(bool));
+
+	func->blocks_count = ir->blocks.count;
+	assign_params(&selector);
+	prepare(&selector);
+
+	(void)emit(&selector, primec_x86_64_op_prologue, 8);
+
+	// NOTE: The parameters are moved out of their registers before anything
+	//       else, so no instruction can clobber them first.
+	if (ir->blocks.count > 0)
+	{
+		const primec_ir_block_s* const entry = &ir->blocks.data[0];
+
+		for (uint32_t index = 0; index < entry->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = entry->instructions.data[index];
+			if (primec_ir_op_param == get_instruction(&selector, value)->op) { select_param(&selector, value); }
+		}
+	}
+
+	// NOTE: Blocks are laid out in the reverse post order, so the positions of
+	//       the register allocator follow the control flow and the loop bodies
+	//       stay together. Unreachable blocks are left out.
+	primec_cfg_s cfg = {0};
+	primec_cfg_build(&cfg, ir);
+
+	for (uint32_t position = 0; position < cfg.order_count; ++position)
+	{
+		select_block(&selector, cfg.order[position]);
+	}
+
+	primec_cfg_destroy(&cfg);
+
+	if (selector.trap != UINT32_MAX)
+	{
+		emit_label(&selector, selector.trap);
+		(void)emit(&selector, primec_x86_64_op_ud2, 8);
+	}
+
+	primec_utils_free(selector.vregs);
+	primec_utils_free(selector.slots);
+	primec_utils_free(selector.uses);
+	primec_utils_free(selector.fused);
+	primec_utils_free(selector.params);
+}
+
+static void prepare(
+	selector_s* const selector)
+{
+	const primec_ir_func_s* const ir = selector->ir;
+	uint32_t frame = 0;
+
+	for (primec_ir_block_t block = 0; block < ir->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &ir->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+			count_uses(selector, instruction);
+
+			if (primec_ir_op_slot == instruction->op)
+			{
+				const primec_layout_s layout = primec_layout_get(selector->types, get_pointee(selector->types, instruction->type));
+				frame = (uint32_t)((frame + layout.size + layout.alignment - 1) / layout.alignment * layout.alignment);
+				selector->slots[value] = frame;
+			}
+		}
+	}
+
+	selector->func->frame_size = frame;
+
+	// NOTE: Comparisons, that are used only by the branches, set the flags
+	//       right before the jumps.
+	for (primec_ir_block_t block = 0; block < ir->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &ir->blocks.data[block];
+		if (0 == record->instructions.count) { continue; }
+
+		const primec_ir_instruction_s* const last = get_instruction(selector, record->instructions.data[record->instructions.count - 1]);
+		if (last->op != primec_ir_op_branch || 1 != selector->uses[last->a]) { continue; }
+
+		const primec_ir_op_e op = (primec_ir_op_e)get_instruction(selector, last->a)->op;
+		selector->fused[last->a] = op >= primec_ir_op_eq && op <= primec_ir_op_ge;
+	}
+
+	for (primec_ir_block_t block = 0; block < ir->blocks.count; ++block)
+	{
+		const primec_ir_block_s* const record = &ir->blocks.data[block];
+
+		for (uint32_t index = 0; index < record->instructions.count; ++index)
+		{
+			const primec_ir_value_t value = record->instructions.data[index];
+			if (!defines_register(selector, value)) { continue; }
+
+			const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+			const bool is_xmm = is_float(selector->types, instruction->type) || is_vector(selector->types, instruction->type);
+			selector->vregs[value] = new_vreg(selector, is_xmm ? primec_x86_64_class_xmm : primec_x86_64_class_gpr);
+		}
+	}
+}
+
+static void count_uses(
+	selector_s* const selector,
+	const primec_ir_instruction_s* const instruction)
+{
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_load:
+		case primec_ir_op_zero:
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		case primec_ir_op_convert:
+		case primec_ir_op_splat:
+		case primec_ir_op_reduce:
+		case primec_ir_op_branch:
+		case primec_ir_op_call_indirect:
+		{
+			++selector->uses[instruction->a];
+		} break;
+
+		case primec_ir_op_ret:
+		{
+			if (instruction->a != primec_ir_null) { ++selector->uses[instruction->a]; }
+		} break;
+
+		case primec_ir_op_store:
+		case primec_ir_op_copy:
+		case primec_ir_op_element:
+		case primec_ir_op_check:
+		{
+			++selector->uses[instruction->a];
+			++selector->uses[instruction->b];
+		} break;
+
+		case primec_ir_op_phi:
+		{
+			uint32_t count = 0;
+			const uint32_t* const incoming = primec_ir_func_get_list(selector->ir, instruction->a, &count);
+			for (uint32_t index = 1; index < count; index += 2) { ++selector->uses[incoming[index]]; }
+		} break;
+
+		default:
+		{
+			if (instruction->op >= primec_ir_op_add && instruction->op <= primec_ir_op_ge)
+			{
+				++selector->uses[instruction->a];
+				++selector->uses[instruction->b];
+			}
+		} break;
+	}
+
+	if (primec_ir_op_call == instruction->op || primec_ir_op_call_indirect == instruction->op)
+	{
+		uint32_t count = 0;
+		const uint32_t* const arguments = primec_ir_func_get_list(selector->ir, instruction->b, &count);
+		for (uint32_t index = 0; index < count; ++index) { ++selector->uses[arguments[index]]; }
+	}
+}
+
+static void assign_params(
+	selector_s* const selector)
+{
+	const primec_type_table_s* const types = selector->types;
+	const primec_ir_func_s* const ir = selector->ir;
+	const primec_type_s* const record = primec_type_table_get(types, ir->type);
+	const primec_type_t* const params = primec_type_table_get_list(types, ir->type);
+	const bool is_sret = 0 != (ir->flags & primec_ir_func_flag_sret);
+
+	selector->params_count = record->list.count + (is_sret ? 1 : 0);
+	selector->params = primec_utils_malloc((selector->params_count > 0 ? selector->params_count : 1) * sizeof(location_s));
+
+	uint32_t gprs = 0;
+	uint32_t xmms = 0;
+	uint32_t stack = 0;
+
+	for (uint32_t index = 0; index < selector->params_count; ++index)
+	{
+		const bool is_xmm = index >= (is_sret ? 1u : 0u) && is_float(types, params[index - (is_sret ? 1u : 0u)]);
+		location_s* const location = &selector->params[index];
+
+		if (is_xmm && xmms < args_xmms_count)
+		{
+			*location = (location_s) { .reg = primec_x86_64_reg_xmm0 + xmms++, .stack = 0 };
+		}
+		else if (!is_xmm && gprs < args_gprs_count)
+		{
+			*location = (location_s) { .reg = g_args_gprs[gprs++], .stack = 0 };
+		}
+		else
+		{
+			*location = (location_s) { .reg = UINT32_MAX, .stack = stack++ };
+		}
+	}
+}
+
+static bool defines_register(
+	const selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_param:
+		case primec_ir_op_load:
+		case primec_ir_op_convert:
+		case primec_ir_op_splat:
+		case primec_ir_op_reduce:
+		case primec_ir_op_phi:
+		{
+			return true;
+		} break;
+
+		case primec_ir_op_call:
+		case primec_ir_op_call_indirect:
+		{
+			return instruction->type != primec_type_void;
+		} break;
+
+		case primec_ir_op_element:
+		{
+			return !is_folded(selector, value);
+		} break;
+
+		default:
+		{
+			if (instruction->op >= primec_ir_op_eq && instruction->op <= primec_ir_op_ge)
+			{
+				return !selector->fused[value];
+			}
+
+			return instruction->op >= primec_ir_op_add && instruction->op <= primec_ir_op_shr;
+		} break;
+	}
+}
+
+static bool is_frame_address(
+	const selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_slot:
+		{
+			return true;
+		} break;
+
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		{
+			return is_frame_address(selector, instruction->a);
+		} break;
+
+		case primec_ir_op_element:
+		{
+			return primec_ir_op_const == get_instruction(selector, instruction->b)->op && is_frame_address(selector, instruction->a);
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static bool is_folded(
+	const selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_slot:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		{
+			return true;
+		} break;
+
+		case primec_ir_op_element:
+		{
+			// NOTE: Elements of the frame arrays are addressed by their indices
+			//       directly, the other ones are computed once.
+			if (primec_ir_op_const == get_instruction(selector, instruction->b)->op) { return true; }
+			const uint32_t size = (uint32_t)primec_layout_get(selector->types, get_pointee(selector->types, instruction->type)).size;
+			return is_frame_address(selector, instruction->a) && (1 == size || 2 == size || 4 == size || 8 == size);
+		} break;
+
+		default:
+		{
+			return false;
+		} break;
+	}
+}
+
+static void select_block(
+	selector_s* const selector,
+	const primec_ir_block_t block)
+{
+	const primec_ir_block_s* const record = &selector->ir->blocks.data[block];
+	emit_label(selector, block);
+
+	for (uint32_t index = 0; index < record->instructions.count; ++index)
+	{
+		// NOTE: Sibling calls jump to their callees, that return straight to the
+		//       caller of the function, so the returns after them are skipped.
+		if (is_sibling_call(selector, record, index))
+		{
+			select_call(selector, record->instructions.data[index], true);
+			break;
+		}
+
+		select_instruction(selector, block, record->instructions.data[index]);
+	}
+}
+
+static void select_instruction(
+	selector_s* const selector,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_nop:
+		case primec_ir_op_const:
+		case primec_ir_op_param:
+		case primec_ir_op_slot:
+		case primec_ir_op_global:
+		case primec_ir_op_func:
+		case primec_ir_op_string:
+		case primec_ir_op_field:
+		case primec_ir_op_offset:
+		case primec_ir_op_phi:
+		{
+			// NOTE: Constants and addresses are folded into their uses, and the
+			//       phis are defined by the moves at the ends of their predecessors.
+		} break;
+
+		case primec_ir_op_load: { select_load(selector, value); } break;
+		case primec_ir_op_store: { select_store(selector, instruction->a, instruction->b); } break;
+		case primec_ir_op_copy: { select_copy(selector, value); } break;
+		case primec_ir_op_zero: { select_zero(selector, value); } break;
+
+		case primec_ir_op_element:
+		{
+			if (!is_folded(selector, value)) { select_element(selector, value); }
+		} break;
+
+		case primec_ir_op_add:
+		case primec_ir_op_sub:
+		case primec_ir_op_mul:
+		case primec_ir_op_and:
+		case primec_ir_op_or:
+		case primec_ir_op_xor:
+		{
+			select_arithmetic(selector, value);
+		} break;
+
+		case primec_ir_op_div:
+		case primec_ir_op_rem:
+		{
+			if (is_float(selector->types, instruction->type)) { select_arithmetic(selector, value); }
+			else { select_division(selector, value); }
+		} break;
+
+		case primec_ir_op_shl:
+		case primec_ir_op_shr:
+		{
+			select_shift(selector, value);
+		} break;
+
+		case primec_ir_op_neg:
+		case primec_ir_op_not:
+		{
+			select_unary(selector, value);
+		} break;
+
+		case primec_ir_op_eq:
+		case primec_ir_op_ne:
+		case primec_ir_op_lt:
+		case primec_ir_op_le:
+		case primec_ir_op_gt:
+		case primec_ir_op_ge:
+		{
+			if (!selector->fused[value]) { select_comparison(selector, value); }
+		} break;
+
+		case primec_ir_op_convert: { select_convert(selector, value); } break;
+		case primec_ir_op_splat: { select_splat(selector, value); } break;
+		case primec_ir_op_reduce: { select_reduce(selector, value); } break;
+
+		case primec_ir_op_call:
+		case primec_ir_op_call_indirect:
+		{
+			select_call(selector, value, false);
+		} break;
+
+		case primec_ir_op_check: { select_check(selector, value); } break;
+
+		case primec_ir_op_jump:
+		{
+			select_phi_moves(selector, block, instruction->a);
+			emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, instruction->a);
+		} break;
+
+		case primec_ir_op_branch: { select_branch(selector, block, value); } break;
+		case primec_ir_op_ret: { select_ret(selector, value); } break;
+		case primec_ir_op_unreachable: { (void)emit(selector, primec_x86_64_op_ud2, 8); } break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unknown ir op.");
+		} break;
+	}
+}
+
+static void select_param(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	primec_debug_assert(instruction->a < selector->params_count);
+	const location_s location = selector->params[instruction->a];
+	const uint32_t destination = selector->vregs[value];
+
+	if (location.reg != UINT32_MAX)
+	{
+		emit_move(selector, destination, location.reg);
+		return;
+	}
+
+	const primec_x86_64_operand_s source = mem_operand(primec_x86_64_reg_rbp, stack_arguments_offset + 8 * (int64_t)location.stack);
+
+	if (is_float(selector->types, instruction->type))
+	{
+		emit_binary(selector, primec_x86_64_op_movf, get_size(selector->types, instruction->type), reg_operand(destination), source);
+	}
+	else
+	{
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(destination), source);
+	}
+}
+
+static void select_load(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const primec_x86_64_operand_s destination = reg_operand(selector->vregs[value]);
+	const primec_x86_64_operand_s source = get_address(selector, instruction->a);
+
+	if (is_float(selector->types, instruction->type) || is_vector(selector->types, instruction->type))
+	{
+		emit_binary(selector, primec_x86_64_op_movf, size, destination, source);
+	}
+	else if (size < 4)
+	{
+		// NOTE: Narrow loads are zero extended, to not depend on the previous
+		//       value of the register.
+		emit_binary(selector, primec_x86_64_op_movzx, 4, destination, source);
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)size;
+	}
+	else
+	{
+		emit_binary(selector, primec_x86_64_op_mov, size, destination, source);
+	}
+}
+
+static void select_store(
+	selector_s* const selector,
+	const primec_ir_value_t address,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const primec_x86_64_operand_s destination = get_address(selector, address);
+
+	if (is_vector(selector->types, instruction->type))
+	{
+		emit_binary(selector, primec_x86_64_op_movf, size, destination, reg_operand(get_register(selector, value)));
+		return;
+	}
+
+	if (!is_float(selector->types, instruction->type))
+	{
+		emit_binary(selector, primec_x86_64_op_mov, size, destination, get_source(selector, value, size));
+		return;
+	}
+
+	// NOTE: Float constants are stored by their bits.
+	if (primec_ir_op_const == instruction->op)
+	{
+		const uint64_t bits = get_float_bits(selector->types, instruction->type, primec_ir_get_const(instruction));
+
+		if (4 == size || (int64_t)bits == (int64_t)(int32_t)bits)
+		{
+			emit_binary(selector, primec_x86_64_op_mov, size, destination, imm_operand(4 == size ? (int64_t)(int32_t)bits : (int64_t)bits));
+			return;
+		}
+	}
+
+	emit_binary(selector, primec_x86_64_op_movf, size, destination, reg_operand(get_register(selector, value)));
+}
+
+static void select_copy(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint64_t size = primec_layout_get(selector->types, instruction->type).size;
+	if (0 == size) { return; }
+
+	primec_x86_64_operand_s destination = get_address(selector, instruction->a);
+	primec_x86_64_operand_s source = get_address(selector, instruction->b);
+
+	if (size > inline_copy_limit)
+	{
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(primec_x86_64_reg_rdi), destination);
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(primec_x86_64_reg_rsi), source);
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(primec_x86_64_reg_rcx), imm_operand((int64_t)size));
+
+		primec_x86_64_instruction_s* const copy = emit(selector, primec_x86_64_op_rep_movsb, 1);
+		copy->uses = 1u << primec_x86_64_reg_rdi | 1u << primec_x86_64_reg_rsi | 1u << primec_x86_64_reg_rcx;
+		copy->defs = copy->uses;
+		return;
+	}
+
+	for (uint64_t offset = 0; offset < size;)
+	{
+		const uint32_t chunk = size - offset >= 8 ? 8 : size - offset >= 4 ? 4 : size - offset >= 2 ? 2 : 1;
+		const uint32_t temporary = new_vreg(selector, primec_x86_64_class_gpr);
+
+		emit_binary(selector, primec_x86_64_op_mov, chunk, reg_operand(temporary), source);
+		emit_binary(selector, primec_x86_64_op_mov, chunk, destination, reg_operand(temporary));
+
+		source.value += chunk;
+		destination.value += chunk;
+		offset += chunk;
+	}
+}
+
+static void select_zero(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint64_t size = primec_layout_get(selector->types, instruction->type).size;
+	if (0 == size) { return; }
+
+	primec_x86_64_operand_s destination = get_address(selector, instruction->a);
+
+	if (size > inline_copy_limit)
+	{
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(primec_x86_64_reg_rdi), destination);
+		emit_binary(selector, primec_x86_64_op_mov, 4, reg_operand(primec_x86_64_reg_rax), imm_operand(0));
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(primec_x86_64_reg_rcx), imm_operand((int64_t)size));
+
+		primec_x86_64_instruction_s* const clear = emit(selector, primec_x86_64_op_rep_stosb, 1);
+		clear->uses = 1u << primec_x86_64_reg_rdi | 1u << primec_x86_64_reg_rax | 1u << primec_x86_64_reg_rcx;
+		clear->defs = 1u << primec_x86_64_reg_rdi | 1u << primec_x86_64_reg_rcx;
+		return;
+	}
+
+	for (uint64_t offset = 0; offset < size;)
+	{
+		const uint32_t chunk = size - offset >= 8 ? 8 : size - offset >= 4 ? 4 : size - offset >= 2 ? 2 : 1;
+		emit_binary(selector, primec_x86_64_op_mov, chunk, destination, imm_operand(0));
+		destination.value += chunk;
+		offset += chunk;
+	}
+}
+
+static void select_element(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint64_t size = primec_layout_get(selector->types, get_pointee(selector->types, instruction->type)).size;
+	const uint32_t destination = selector->vregs[value];
+	const uint32_t index = get_extended(selector, instruction->b, 8);
+
+	primec_x86_64_operand_s base = get_address(selector, instruction->a);
+
+	if (base.reg >= primec_x86_64_vregs_start && 0 == base.scale && 0 == base.value)
+	{
+		base = reg_operand(base.reg);
+	}
+	else
+	{
+		const uint32_t address = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(address), base);
+		base = reg_operand(address);
+	}
+
+	if (1 == size || 2 == size || 4 == size || 8 == size)
+	{
+		primec_x86_64_operand_s address = mem_operand(base.reg, 0);
+		address.index = index;
+		address.scale = (uint8_t)size;
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(destination), address);
+		return;
+	}
+
+	emit_move(selector, destination, index);
+	emit_binary(selector, primec_x86_64_op_imul, 8, reg_operand(destination), imm_operand((int64_t)size));
+	emit_binary(selector, primec_x86_64_op_add, 8, reg_operand(destination), base);
+}
+
+static void select_arithmetic(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t destination = selector->vregs[value];
+	const uint32_t size = get_size(selector->types, instruction->type);
+
+	if (is_vector(selector->types, instruction->type))
+	{
+		select_vector_arithmetic(selector, value);
+		return;
+	}
+
+	if (is_float(selector->types, instruction->type))
+	{
+		primec_x86_64_op_e op = primec_x86_64_op_addf;
+
+		switch ((primec_ir_op_e)instruction->op)
+		{
+			case primec_ir_op_add: { op = primec_x86_64_op_addf; } break;
+			case primec_ir_op_sub: { op = primec_x86_64_op_subf; } break;
+			case primec_ir_op_mul: { op = primec_x86_64_op_mulf; } break;
+			case primec_ir_op_div: { op = primec_x86_64_op_divf; } break;
+			default: { primec_logger_panic("internal failure -- invalid float operation."); } break;
+		}
+
+		emit_move(selector, destination, get_register(selector, instruction->a));
+		emit_binary(selector, op, size, reg_operand(destination), reg_operand(get_register(selector, instruction->b)));
+		return;
+	}
+
+	primec_x86_64_op_e op = primec_x86_64_op_add;
+	bool is_commutative = true;
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_add: { op = primec_x86_64_op_add; } break;
+		case primec_ir_op_sub: { op = primec_x86_64_op_sub; is_commutative = false; } break;
+		case primec_ir_op_mul: { op = primec_x86_64_op_imul; } break;
+		case primec_ir_op_and: { op = primec_x86_64_op_and; } break;
+		case primec_ir_op_or: { op = primec_x86_64_op_or; } break;
+		case primec_ir_op_xor: { op = primec_x86_64_op_xor; } break;
+		default: { primec_logger_panic("internal failure -- invalid integer operation."); } break;
+	}
+
+	// NOTE: The upper bits of the narrow integers are not defined, so their
+	//       operations are done on the whole 32 bit registers.
+	const uint32_t width = size < 4 ? 4 : size;
+	primec_ir_value_t left = instruction->a;
+	primec_ir_value_t right = instruction->b;
+	int64_t immediate = 0;
+
+	if (is_commutative && get_immediate(selector, left, width, &immediate) && !get_immediate(selector, right, width, &immediate))
+	{
+		left = instruction->b;
+		right = instruction->a;
+	}
+
+	emit_move(selector, destination, get_register(selector, left));
+	emit_binary(selector, op, width, reg_operand(destination), get_source(selector, right, width));
+}
+
+static void select_division(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const uint32_t width = size < 4 ? 4 : size;
+	const bool is_signed_division = is_signed(selector->types, instruction->type);
+
+	const uint32_t dividend = get_extended(selector, instruction->a, width);
+	const uint32_t divisor = get_extended(selector, instruction->b, width);
+
+	emit_binary(selector, primec_x86_64_op_mov, width, reg_operand(primec_x86_64_reg_rax), reg_operand(dividend));
+
+	if (is_signed_division)
+	{
+		primec_x86_64_instruction_s* const extend = emit(selector, primec_x86_64_op_cqo, width);
+		extend->uses = 1u << primec_x86_64_reg_rax;
+		extend->defs = 1u << primec_x86_64_reg_rdx;
+	}
+	else
+	{
+		emit_binary(selector, primec_x86_64_op_mov, 4, reg_operand(primec_x86_64_reg_rdx), imm_operand(0));
+	}
+
+	primec_x86_64_instruction_s* const divide = emit(selector, is_signed_division ? primec_x86_64_op_idiv : primec_x86_64_op_div, width);
+	divide->operands[0] = reg_operand(divisor);
+	divide->uses = 1u << primec_x86_64_reg_rax | 1u << primec_x86_64_reg_rdx;
+	divide->defs = divide->uses;
+
+	const bool is_division = primec_ir_op_div == instruction->op;
+	emit_move(selector, selector->vregs[value], is_division ? primec_x86_64_reg_rax : primec_x86_64_reg_rdx);
+
+	// NOTE: The signed divisions of the minimal value by minus one fault in
+	//       the idiv itself, except for the narrow integers divided in 32 bits,
+	//       whose quotients are checked to fit their width instead. The check
+	//       ends the block, and the machine registers never live across the
+	//       blocks, so the results are moved out of rax and rdx before it.
+	if (is_signed_division && size < 4)
+	{
+		uint32_t quotient = selector->vregs[value];
+
+		if (!is_division)
+		{
+			quotient = new_vreg(selector, primec_x86_64_class_gpr);
+			emit_move(selector, quotient, primec_x86_64_reg_rax);
+		}
+
+		const uint32_t extended = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_extend(selector, extended, quotient, size, 4, true);
+		emit_binary(selector, primec_x86_64_op_cmp, 4, reg_operand(extended), reg_operand(quotient));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ne, get_trap(selector));
+	}
+}
+
+static void select_shift(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const uint32_t width = size < 4 ? 4 : size;
+	const uint32_t destination = selector->vregs[value];
+
+	primec_x86_64_op_e op = primec_x86_64_op_shl;
+
+	if (primec_ir_op_shr == instruction->op)
+	{
+		op = is_signed(selector->types, instruction->type) ? primec_x86_64_op_sar : primec_x86_64_op_shr;
+		emit_move(selector, destination, get_extended(selector, instruction->a, width));
+	}
+	else
+	{
+		emit_move(selector, destination, get_register(selector, instruction->a));
+	}
+
+	int64_t count = 0;
+
+	if (get_immediate(selector, instruction->b, 1, &count))
+	{
+		emit_binary(selector, op, width, reg_operand(destination), imm_operand(count & (8 * width - 1)));
+		return;
+	}
+
+	emit_binary(selector, primec_x86_64_op_mov, 4, reg_operand(primec_x86_64_reg_rcx), reg_operand(get_register(selector, instruction->b)));
+	emit_binary(selector, op, width, reg_operand(destination), reg_operand(primec_x86_64_reg_rcx));
+}
+
+static void select_unary(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const uint32_t destination = selector->vregs[value];
+
+	if (is_float(selector->types, instruction->type))
+	{
+		// NOTE: Floats are negated by flipping their sign bits.
+		const uint32_t bits = new_vreg(selector, primec_x86_64_class_gpr);
+		const uint32_t mask = new_vreg(selector, primec_x86_64_class_gpr);
+
+		emit_binary(selector, primec_x86_64_op_movq, size, reg_operand(bits), reg_operand(get_register(selector, instruction->a)));
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(mask), imm_operand(4 == size ? (int64_t)0x80000000 : INT64_MIN));
+		emit_binary(selector, primec_x86_64_op_xor, 8, reg_operand(bits), reg_operand(mask));
+		emit_binary(selector, primec_x86_64_op_movq, size, reg_operand(destination), reg_operand(bits));
+		return;
+	}
+
+	emit_move(selector, destination, get_register(selector, instruction->a));
+	primec_x86_64_instruction_s* const unary = emit(selector, primec_ir_op_neg == instruction->op
+		? primec_x86_64_op_neg : primec_x86_64_op_not, size < 4 ? 4 : size);
+	unary->operands[0] = reg_operand(destination);
+}
+
+static void select_comparison(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const uint32_t destination = selector->vregs[value];
+	const compare_s compare = select_compare(selector, value);
+
+	primec_x86_64_instruction_s* set = emit(selector, primec_x86_64_op_setcc, 1);
+	set->operands[0] = reg_operand(destination);
+	set->cond = (uint8_t)compare.cond;
+
+	if (compare.parity != parity_none)
+	{
+		const uint32_t parity = new_vreg(selector, primec_x86_64_class_gpr);
+		set = emit(selector, primec_x86_64_op_setcc, 1);
+		set->operands[0] = reg_operand(parity);
+		set->cond = (uint8_t)(parity_clear == compare.parity ? primec_x86_64_cond_np : primec_x86_64_cond_p);
+
+		emit_binary(selector, parity_clear == compare.parity ? primec_x86_64_op_and : primec_x86_64_op_or, 1,
+			reg_operand(destination), reg_operand(parity));
+	}
+}
+
+static void select_convert(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const primec_type_t from = get_instruction(selector, instruction->a)->type;
+	const primec_type_t to = instruction->type;
+	const uint32_t from_size = get_size(selector->types, from);
+	const uint32_t to_size = get_size(selector->types, to);
+	const uint32_t destination = selector->vregs[value];
+	const bool is_from_float = is_float(selector->types, from);
+	const bool is_to_float = is_float(selector->types, to);
+
+	if (is_from_float && is_to_float)
+	{
+		if (from_size == to_size)
+		{
+			emit_move(selector, destination, get_register(selector, instruction->a));
+			return;
+		}
+
+		emit_binary(selector, primec_x86_64_op_cvtf2f, to_size, reg_operand(destination), reg_operand(get_register(selector, instruction->a)));
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)from_size;
+		return;
+	}
+
+	if (is_from_float && (to_size < 8 || is_signed(selector->types, to)))
+	{
+		// NOTE: The floats out of the ranges of the integers (and the nans) trap.
+		//       The narrow integers are converted through the 32 bit ones, and
+		//       the 32 bit ones through the 64 bit ones, whose results are checked
+		//       to fit, as the conversions out of range give the smallest ones.
+		const bool is_to_signed = is_signed(selector->types, to);
+		const uint32_t source = get_register(selector, instruction->a);
+		const uint32_t width = to_size < 4 ? 4 : 8;
+
+		emit_binary(selector, primec_x86_64_op_cvtf2si, width, reg_operand(destination), reg_operand(source));
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)from_size;
+
+		if (to_size < 8)
+		{
+			const uint32_t extended = new_vreg(selector, primec_x86_64_class_gpr);
+			emit_extend(selector, extended, destination, to_size, width, is_to_signed);
+			emit_binary(selector, primec_x86_64_op_cmp, width, reg_operand(extended), reg_operand(destination));
+			emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ne, get_trap(selector));
+			return;
+		}
+
+		// NOTE: The smallest 64 bit integer (the only one, that overflows when
+		//       one is subtracted) is valid only for the float of the same value.
+		const uint32_t smallest = new_block(selector);
+		const uint32_t done = new_block(selector);
+		const uint32_t limit = new_vreg(selector, primec_x86_64_class_xmm);
+		const uint32_t bits = new_vreg(selector, primec_x86_64_class_gpr);
+
+		emit_binary(selector, primec_x86_64_op_cmp, 8, reg_operand(destination), imm_operand(1));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_o, smallest);
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, done);
+
+		emit_label(selector, smallest);
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(bits), imm_operand(4 == from_size ? 0xdf000000 : (int64_t)UINT64_C(0xc3e0000000000000)));
+		emit_binary(selector, primec_x86_64_op_movq, from_size, reg_operand(limit), reg_operand(bits));
+		emit_binary(selector, primec_x86_64_op_ucomif, from_size, reg_operand(source), reg_operand(limit));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ne, get_trap(selector));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_p, get_trap(selector));
+		emit_label(selector, done);
+		return;
+	}
+
+	if (is_from_float)
+	{
+		// NOTE: Floats from 2^63 up are converted after subtracting 2^63, which
+		//       is added back by setting the top bit. The negative results are
+		//       the floats out of the range (or the nans), which trap.
+		const uint32_t source = get_register(selector, instruction->a);
+		const uint32_t limit = new_vreg(selector, primec_x86_64_class_xmm);
+		const uint32_t bits = new_vreg(selector, primec_x86_64_class_gpr);
+		const uint32_t large = new_block(selector);
+		const uint32_t done = new_block(selector);
+
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(bits), imm_operand(4 == from_size ? 0x5f000000 : 0x43e0000000000000));
+		emit_binary(selector, primec_x86_64_op_movq, from_size, reg_operand(limit), reg_operand(bits));
+		emit_binary(selector, primec_x86_64_op_ucomif, from_size, reg_operand(source), reg_operand(limit));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ae, large);
+		emit_binary(selector, primec_x86_64_op_cvtf2si, 8, reg_operand(destination), reg_operand(source));
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)from_size;
+		emit_binary(selector, primec_x86_64_op_test, 8, reg_operand(destination), reg_operand(destination));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_s, get_trap(selector));
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, done);
+
+		emit_label(selector, large);
+		const uint32_t reduced = new_vreg(selector, primec_x86_64_class_xmm);
+		const uint32_t mask = new_vreg(selector, primec_x86_64_class_gpr);
+
+		emit_move(selector, reduced, source);
+		emit_binary(selector, primec_x86_64_op_subf, from_size, reg_operand(reduced), reg_operand(limit));
+		emit_binary(selector, primec_x86_64_op_cvtf2si, 8, reg_operand(destination), reg_operand(reduced));
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)from_size;
+		emit_binary(selector, primec_x86_64_op_test, 8, reg_operand(destination), reg_operand(destination));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_s, get_trap(selector));
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(mask), imm_operand(INT64_MIN));
+		emit_binary(selector, primec_x86_64_op_xor, 8, reg_operand(destination), reg_operand(mask));
+		emit_label(selector, done);
+		return;
+	}
+
+	if (!is_to_float)
+	{
+		if (to_size <= from_size)
+		{
+			emit_move(selector, destination, get_register(selector, instruction->a));
+			return;
+		}
+
+		emit_extend(selector, destination, get_register(selector, instruction->a), from_size, to_size, is_signed(selector->types, from));
+		return;
+	}
+
+	if (is_signed(selector->types, from) || from_size < 4)
+	{
+		const uint32_t source = get_extended(selector, instruction->a, 4);
+		emit_binary(selector, primec_x86_64_op_cvtsi2f, to_size, reg_operand(destination), reg_operand(source));
+		selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)(from_size < 4 ? 4 : from_size);
+		return;
+	}
+
+	const uint32_t source = get_extended(selector, instruction->a, 8);
+
+	if (4 == from_size)
+	{
+		emit_binary(selector, primec_x86_64_op_cvtsi2f, to_size, reg_operand(destination), reg_operand(source));
+		selector->func->code.data[selector->func->code.count - 1].source_size = 8;
+		return;
+	}
+
+	// NOTE: Unsigned 64 bit integers with the top bit set are halved (keeping
+	//       their lowest bit for the rounding), converted and doubled.
+	const uint32_t large = new_block(selector);
+	const uint32_t done = new_block(selector);
+
+	emit_binary(selector, primec_x86_64_op_test, 8, reg_operand(source), reg_operand(source));
+	emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_s, large);
+	emit_binary(selector, primec_x86_64_op_cvtsi2f, to_size, reg_operand(destination), reg_operand(source));
+	selector->func->code.data[selector->func->code.count - 1].source_size = 8;
+	emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, done);
+
+	emit_label(selector, large);
+	const uint32_t half = new_vreg(selector, primec_x86_64_class_gpr);
+	const uint32_t low = new_vreg(selector, primec_x86_64_class_gpr);
+
+	emit_move(selector, half, source);
+	emit_binary(selector, primec_x86_64_op_shr, 8, reg_operand(half), imm_operand(1));
+	emit_move(selector, low, source);
+	emit_binary(selector, primec_x86_64_op_and, 8, reg_operand(low), imm_operand(1));
+	emit_binary(selector, primec_x86_64_op_or, 8, reg_operand(half), reg_operand(low));
+	emit_binary(selector, primec_x86_64_op_cvtsi2f, to_size, reg_operand(destination), reg_operand(half));
+	selector->func->code.data[selector->func->code.count - 1].source_size = 8;
+	emit_binary(selector, primec_x86_64_op_addf, to_size, reg_operand(destination), reg_operand(destination));
+	emit_label(selector, done);
+}
+
+static void select_vector_arithmetic(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const primec_type_t lane = get_pointee(selector->types, instruction->type);
+	const uint32_t lane_size = get_size(selector->types, lane);
+	const bool is_float_lanes = is_float(selector->types, lane);
+	primec_x86_64_op_e op = primec_x86_64_op_padd;
+
+	// NOTE: Only the operations of sse2 are made by the vectorizer, so the
+	//       multiplications of the integers take the 16 bit lanes only.
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_add: { op = is_float_lanes ? primec_x86_64_op_addp : primec_x86_64_op_padd; } break;
+		case primec_ir_op_sub: { op = is_float_lanes ? primec_x86_64_op_subp : primec_x86_64_op_psub; } break;
+		case primec_ir_op_mul: { op = is_float_lanes ? primec_x86_64_op_mulp : primec_x86_64_op_pmullw; } break;
+		case primec_ir_op_div: { op = primec_x86_64_op_divp; } break;
+		case primec_ir_op_and: { op = primec_x86_64_op_pand; } break;
+		case primec_ir_op_or: { op = primec_x86_64_op_por; } break;
+		case primec_ir_op_xor: { op = primec_x86_64_op_pxor; } break;
+		default: { primec_logger_panic("internal failure -- invalid vector operation."); } break;
+	}
+
+	primec_debug_assert(primec_x86_64_op_pmullw != op || 2 == lane_size);
+	primec_debug_assert(primec_x86_64_op_divp != op || is_float_lanes);
+
+	const uint32_t destination = selector->vregs[value];
+	emit_move(selector, destination, get_register(selector, instruction->a));
+	emit_binary(selector, op, lane_size, reg_operand(destination), reg_operand(get_register(selector, instruction->b)));
+}
+
+static void select_splat(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const primec_type_t type = get_instruction(selector, instruction->a)->type;
+	const uint32_t size = get_size(selector->types, type);
+	const uint32_t destination = selector->vregs[value];
+	const uint32_t source = get_register(selector, instruction->a);
+	uint32_t bits = source;
+
+	// NOTE: The lane is repeated over the 64 bits of a general purpose register
+	//       by its multiplication, and the low half of the vector is repeated
+	//       into its high half.
+	if (is_float(selector->types, type))
+	{
+		bits = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_binary(selector, primec_x86_64_op_movq, size, reg_operand(bits), reg_operand(source));
+	}
+	else if (size < 8)
+	{
+		bits = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_extend(selector, bits, source, size, 8, false);
+	}
+
+	if (size < 8)
+	{
+		const uint64_t pattern = 1 == size ? UINT64_C(0x0101010101010101) : 2 == size ? UINT64_C(0x0001000100010001) : UINT64_C(0x0000000100000001);
+		const uint32_t multiplier = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(multiplier), imm_operand((int64_t)pattern));
+		emit_binary(selector, primec_x86_64_op_imul, 8, reg_operand(bits), reg_operand(multiplier));
+	}
+
+	emit_binary(selector, primec_x86_64_op_movq, 8, reg_operand(destination), reg_operand(bits));
+	emit_binary(selector, primec_x86_64_op_punpcklqdq, 8, reg_operand(destination), reg_operand(destination));
+}
+
+static void select_reduce(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t size = get_size(selector->types, instruction->type);
+	const bool is_float_lanes = is_float(selector->types, instruction->type);
+	primec_x86_64_op_e op = primec_x86_64_op_padd;
+
+	switch ((primec_ir_op_e)instruction->b)
+	{
+		case primec_ir_op_add: { op = is_float_lanes ? primec_x86_64_op_addp : primec_x86_64_op_padd; } break;
+		case primec_ir_op_and: { op = primec_x86_64_op_pand; } break;
+		case primec_ir_op_or: { op = primec_x86_64_op_por; } break;
+		case primec_ir_op_xor: { op = primec_x86_64_op_pxor; } break;
+		default: { primec_logger_panic("internal failure -- invalid reduction."); } break;
+	}
+
+	// NOTE: The upper half of the lanes is combined with the lower half, until
+	//       the first lane holds all of them.
+	const uint32_t vector = new_vreg(selector, primec_x86_64_class_xmm);
+	emit_move(selector, vector, get_register(selector, instruction->a));
+
+	for (uint32_t shift = 8; shift >= size; shift /= 2)
+	{
+		const uint32_t upper = new_vreg(selector, primec_x86_64_class_xmm);
+		emit_move(selector, upper, vector);
+		emit_binary(selector, primec_x86_64_op_psrldq, 8, reg_operand(upper), imm_operand(shift));
+		emit_binary(selector, op, size, reg_operand(vector), reg_operand(upper));
+	}
+
+	const uint32_t destination = selector->vregs[value];
+
+	if (is_float_lanes)
+	{
+		emit_move(selector, destination, vector);
+		return;
+	}
+
+	emit_binary(selector, primec_x86_64_op_movq, size < 8 ? 4 : 8, reg_operand(destination), reg_operand(vector));
+}
+
+static bool is_sibling_call(
+	const selector_s* const selector,
+	const primec_ir_block_s* const record,
+	const uint32_t index)
+{
+	const primec_ir_value_t value = record->instructions.data[index];
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	if (!(instruction->flags & primec_ir_instruction_flag_tail) || index + 2 != record->instructions.count) { return false; }
+
+	const primec_ir_instruction_s* const ret = get_instruction(selector, record->instructions.data[index + 1]);
+	if (ret->op != primec_ir_op_ret || (ret->a != value && ret->a != primec_ir_null)) { return false; }
+
+	// NOTE: The frame is torn down before the jump, so the arguments have to
+	//       fit in the registers.
+	uint32_t count = 0;
+	const uint32_t* const arguments = primec_ir_func_get_list(selector->ir, instruction->b, &count);
+	uint32_t gprs = 0;
+	uint32_t xmms = 0;
+
+	for (uint32_t argument = 0; argument < count; ++argument)
+	{
+		if (is_float(selector->types, get_instruction(selector, arguments[argument])->type)) { ++xmms; }
+		else { ++gprs; }
+	}
+
+	return gprs <= args_gprs_count && xmms <= args_xmms_count;
+}
+
+static void select_call(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const bool is_sibling)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const primec_type_table_s* const types = selector->types;
+
+	primec_type_t func_type = primec_type_void;
+	uint32_t target = UINT32_MAX;
+
+	if (primec_ir_op_call == instruction->op)
+	{
+		func_type = selector->program->funcs.data[instruction->a]->type;
+	}
+	else
+	{
+		func_type = get_instruction(selector, instruction->a)->type;
+		const primec_type_s* const record = primec_type_table_get(types, func_type);
+
+		if (record->kind != primec_type_kind_func)
+		{
+			func_type = record->element;
+		}
+
+		target = get_register(selector, instruction->a);
+	}
+
+	uint32_t count = 0;
+	const uint32_t* const arguments = primec_ir_func_get_list(selector->ir, instruction->b, &count);
+
+	uint32_t gprs = 0;
+	uint32_t xmms = 0;
+	uint32_t stack = 0;
+	uint32_t uses = 0;
+
+	// NOTE: The stack arguments are stored first, as their values may need the
+	//       registers, that are already assigned to the other arguments.
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		gprs = 0;
+		xmms = 0;
+		stack = 0;
+
+		for (uint32_t index = 0; index < count; ++index)
+		{
+			const primec_ir_value_t argument = arguments[index];
+			const primec_type_t type = get_instruction(selector, argument)->type;
+			const bool is_xmm = is_float(types, type);
+			const uint32_t size = get_size(types, type);
+			uint32_t reg = UINT32_MAX;
+
+			if (is_xmm && xmms < args_xmms_count) { reg = primec_x86_64_reg_xmm0 + xmms++; }
+			else if (!is_xmm && gprs < args_gprs_count) { reg = g_args_gprs[gprs++]; }
+
+			if (UINT32_MAX == reg)
+			{
+				const primec_x86_64_operand_s slot = mem_operand(primec_x86_64_reg_rsp, 8 * (int64_t)stack++);
+
+				if (0 == pass && is_xmm)
+				{
+					emit_binary(selector, primec_x86_64_op_movf, size, slot, reg_operand(get_register(selector, argument)));
+				}
+				else if (0 == pass)
+				{
+					emit_binary(selector, primec_x86_64_op_mov, 8, slot, reg_operand(get_extended(selector, argument, 4)));
+				}
+
+				continue;
+			}
+
+			if (0 == pass) { continue; }
+			uses |= 1u << reg;
+
+			if (is_xmm)
+			{
+				emit_move(selector, reg, get_register(selector, argument));
+				continue;
+			}
+
+			// NOTE: Narrow integers are extended to 32 bits, as the C compilers
+			//       expect them to be.
+			int64_t immediate = 0;
+			const primec_ir_instruction_s* const defining = get_instruction(selector, argument);
+
+			if (get_immediate(selector, argument, 8, &immediate))
+			{
+				emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(reg), imm_operand(immediate));
+			}
+			else if (is_folded(selector, argument) && defining->op != primec_ir_op_element)
+			{
+				emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(reg), get_address(selector, argument));
+			}
+			else if (size < 4)
+			{
+				emit_extend(selector, reg, get_register(selector, argument), size, 4, is_signed(types, type));
+			}
+			else
+			{
+				emit_move(selector, reg, get_register(selector, argument));
+			}
+		}
+	}
+
+	if (8 * stack > selector->func->outgoing_size)
+	{
+		selector->func->outgoing_size = 8 * stack;
+	}
+
+	// NOTE: Variadic callees get the count of the vector registers in al.
+	if (primec_type_table_get(types, func_type)->flags & primec_type_flag_variadic)
+	{
+		emit_binary(selector, primec_x86_64_op_mov, 4, reg_operand(primec_x86_64_reg_rax), imm_operand(xmms));
+		uses |= 1u << primec_x86_64_reg_rax;
+	}
+
+	// NOTE: The callee of a sibling call is moved to r11, as the teardown may
+	//       restore the register, that holds it.
+	if (is_sibling && target != UINT32_MAX)
+	{
+		emit_move(selector, primec_x86_64_reg_r11, target);
+		target = primec_x86_64_reg_r11;
+		uses |= 1u << primec_x86_64_reg_r11;
+	}
+
+	primec_x86_64_instruction_s* const call = emit(selector, is_sibling ? primec_x86_64_op_tail : primec_x86_64_op_call, 8);
+	call->uses = uses;
+	call->defs = is_sibling ? 0 : g_clobbers_mask;
+
+	if (UINT32_MAX == target)
+	{
+		call->operands[0] = (primec_x86_64_operand_s)
+		{
+			.kind = primec_x86_64_operand_symbol,
+			.symbol_kind = primec_x86_64_symbol_func,
+			.symbol = instruction->a
+		};
+	}
+	else
+	{
+		call->operands[0] = reg_operand(target);
+	}
+
+	if (!is_sibling && instruction->type != primec_type_void)
+	{
+		emit_move(selector, selector->vregs[value], is_float(types, instruction->type)
+			? primec_x86_64_reg_xmm0 : primec_x86_64_reg_rax);
+	}
+}
+
+static void select_check(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const uint32_t trap = get_trap(selector);
+	int64_t immediate = 0;
+
+	if (get_immediate(selector, instruction->a, 8, &immediate) && !get_immediate(selector, instruction->b, 8, &immediate))
+	{
+		emit_binary(selector, primec_x86_64_op_cmp, 8, reg_operand(get_register(selector, instruction->b)), imm_operand(immediate));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_be, trap);
+		return;
+	}
+
+	emit_binary(selector, primec_x86_64_op_cmp, 8, reg_operand(get_register(selector, instruction->a)), get_source(selector, instruction->b, 8));
+	emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ae, trap);
+}
+
+static void select_ret(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	uint32_t uses = 0;
+
+	if (instruction->a != primec_ir_null)
+	{
+		const primec_type_t type = get_instruction(selector, instruction->a)->type;
+		const uint32_t reg = is_float(selector->types, type) ? primec_x86_64_reg_xmm0 : primec_x86_64_reg_rax;
+		int64_t immediate = 0;
+
+		if (get_immediate(selector, instruction->a, 8, &immediate))
+		{
+			emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(reg), imm_operand(immediate));
+		}
+		else
+		{
+			emit_move(selector, reg, get_register(selector, instruction->a));
+		}
+
+		uses = 1u << reg;
+	}
+
+	primec_x86_64_instruction_s* const ret = emit(selector, primec_x86_64_op_ret, 8);
+	ret->uses = uses;
+}
+
+static void select_branch(
+	selector_s* const selector,
+	const primec_ir_block_t block,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	uint32_t count = 0;
+	const uint32_t* const targets = primec_ir_func_get_list(selector->ir, instruction->b, &count);
+	primec_debug_assert(2 == count);
+
+	uint32_t pending[2] = { UINT32_MAX, UINT32_MAX };
+	const uint32_t then_block = select_edge(selector, block, targets[0], &pending[0]);
+	const uint32_t else_block = select_edge(selector, block, targets[1], &pending[1]);
+
+	const primec_ir_instruction_s* const condition = get_instruction(selector, instruction->a);
+
+	if (primec_ir_op_const == condition->op)
+	{
+		const bool is_true = 0 != primec_ir_get_const(condition).uval;
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, is_true ? then_block : else_block);
+	}
+	else if (selector->fused[instruction->a])
+	{
+		const compare_s compare = select_compare(selector, instruction->a);
+
+		if (parity_clear == compare.parity)
+		{
+			emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_p, else_block);
+		}
+		else if (parity_set == compare.parity)
+		{
+			emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_p, then_block);
+		}
+
+		emit_jump(selector, primec_x86_64_op_jcc, compare.cond, then_block);
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, else_block);
+	}
+	else
+	{
+		const uint32_t reg = get_register(selector, instruction->a);
+		emit_binary(selector, primec_x86_64_op_test, 1, reg_operand(reg), reg_operand(reg));
+		emit_jump(selector, primec_x86_64_op_jcc, primec_x86_64_cond_ne, then_block);
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, else_block);
+	}
+
+	// NOTE: The moves of the phis on the edges of the branches are placed into
+	//       separate blocks, so they are done only when the edges are taken.
+	for (uint32_t index = 0; index < 2; ++index)
+	{
+		if (UINT32_MAX == pending[index]) { continue; }
+
+		emit_label(selector, pending[index]);
+		select_phi_moves(selector, block, targets[index]);
+		emit_jump(selector, primec_x86_64_op_jmp, primec_x86_64_cond_o, targets[index]);
+	}
+}
+
+static uint32_t select_edge(
+	selector_s* const selector,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to,
+	uint32_t* const pending)
+{
+	(void)from;
+
+	if (!has_phis(selector, to))
+	{
+		return to;
+	}
+
+	*pending = new_block(selector);
+	return *pending;
+}
+
+static void select_phi_moves(
+	selector_s* const selector,
+	const primec_ir_block_t from,
+	const primec_ir_block_t to)
+{
+	const primec_ir_block_s* const record = &selector->ir->blocks.data[to];
+	uint32_t phis_count = 0;
+
+	while (phis_count < record->instructions.count &&
+		primec_ir_op_phi == get_instruction(selector, record->instructions.data[phis_count])->op)
+	{
+		++phis_count;
+	}
+
+	if (0 == phis_count) { return; }
+
+	// NOTE: The incoming values are copied to the temporaries first, so the
+	//       phis, that use each other, see their previous values.
+	uint32_t* const temporaries = primec_utils_malloc(phis_count * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index < phis_count; ++index)
+	{
+		const primec_ir_value_t phi = record->instructions.data[index];
+		uint32_t count = 0;
+		const uint32_t* const incoming = primec_ir_func_get_list(selector->ir, get_instruction(selector, phi)->a, &count);
+		primec_ir_value_t source = primec_ir_null;
+
+		for (uint32_t pair = 0; pair + 1 < count; pair += 2)
+		{
+			if (incoming[pair] == from) { source = incoming[pair + 1]; break; }
+		}
+
+		primec_debug_assert(source != primec_ir_null);
+		const uint32_t reg = get_register(selector, source);
+
+		if (1 == phis_count)
+		{
+			emit_move(selector, selector->vregs[phi], reg);
+			primec_utils_free(temporaries);
+			return;
+		}
+
+		temporaries[index] = new_vreg(selector, selector->func->vregs.data[selector->vregs[phi] - primec_x86_64_vregs_start]);
+		emit_move(selector, temporaries[index], reg);
+	}
+
+	for (uint32_t index = 0; index < phis_count; ++index)
+	{
+		emit_move(selector, selector->vregs[record->instructions.data[index]], temporaries[index]);
+	}
+
+	primec_utils_free(temporaries);
+}
+
+static compare_s select_compare(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+	const primec_type_t type = get_instruction(selector, instruction->a)->type;
+	const uint32_t size = get_size(selector->types, type);
+	primec_ir_op_e op = (primec_ir_op_e)instruction->op;
+
+	if (is_float(selector->types, type))
+	{
+		// NOTE: The below and below or equal conditions are true for unordered
+		//       operands, so the operands of these comparisons are swapped.
+		const bool is_swapped = primec_ir_op_lt == op || primec_ir_op_le == op;
+		const uint32_t left = get_register(selector, is_swapped ? instruction->b : instruction->a);
+		const uint32_t right = get_register(selector, is_swapped ? instruction->a : instruction->b);
+		emit_binary(selector, primec_x86_64_op_ucomif, size, reg_operand(left), reg_operand(right));
+
+		switch (op)
+		{
+			case primec_ir_op_eq: { return (compare_s) { .cond = primec_x86_64_cond_e, .parity = parity_clear }; } break;
+			case primec_ir_op_ne: { return (compare_s) { .cond = primec_x86_64_cond_ne, .parity = parity_set }; } break;
+			case primec_ir_op_lt:
+			case primec_ir_op_gt: { return (compare_s) { .cond = primec_x86_64_cond_a, .parity = parity_none }; } break;
+			default: { return (compare_s) { .cond = primec_x86_64_cond_ae, .parity = parity_none }; } break;
+		}
+	}
+
+	primec_ir_value_t left = instruction->a;
+	primec_ir_value_t right = instruction->b;
+	int64_t immediate = 0;
+
+	if (get_immediate(selector, left, size, &immediate) && !get_immediate(selector, right, size, &immediate))
+	{
+		left = instruction->b;
+		right = instruction->a;
+
+		switch (op)
+		{
+			case primec_ir_op_lt: { op = primec_ir_op_gt; } break;
+			case primec_ir_op_le: { op = primec_ir_op_ge; } break;
+			case primec_ir_op_gt: { op = primec_ir_op_lt; } break;
+			case primec_ir_op_ge: { op = primec_ir_op_le; } break;
+			default: { } break;
+		}
+	}
+
+	emit_binary(selector, primec_x86_64_op_cmp, size, reg_operand(get_register(selector, left)), get_source(selector, right, size));
+	const bool is_signed_comparison = is_signed(selector->types, type);
+
+	switch (op)
+	{
+		case primec_ir_op_eq: { return (compare_s) { .cond = primec_x86_64_cond_e, .parity = parity_none }; } break;
+		case primec_ir_op_ne: { return (compare_s) { .cond = primec_x86_64_cond_ne, .parity = parity_none }; } break;
+		case primec_ir_op_lt: { return (compare_s) { .cond = is_signed_comparison ? primec_x86_64_cond_l : primec_x86_64_cond_b, .parity = parity_none }; } break;
+		case primec_ir_op_le: { return (compare_s) { .cond = is_signed_comparison ? primec_x86_64_cond_le : primec_x86_64_cond_be, .parity = parity_none }; } break;
+		case primec_ir_op_gt: { return (compare_s) { .cond = is_signed_comparison ? primec_x86_64_cond_g : primec_x86_64_cond_a, .parity = parity_none }; } break;
+		default: { return (compare_s) { .cond = is_signed_comparison ? primec_x86_64_cond_ge : primec_x86_64_cond_ae, .parity = parity_none }; } break;
+	}
+}
+
+static bool has_phis(
+	const selector_s* const selector,
+	const primec_ir_block_t block)
+{
+	const primec_ir_block_s* const record = &selector->ir->blocks.data[block];
+	return record->instructions.count > 0 && primec_ir_op_phi == get_instruction(selector, record->instructions.data[0])->op;
+}
+
+static primec_x86_64_instruction_s* emit(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const uint32_t size)
+{
+	primec_x86_64_func_s* const func = selector->func;
+
+	if (func->code.count >= func->code.capacity)
+	{
+		func->code.capacity = func->code.capacity > 0 ? func->code.capacity * 2 : 64;
+		func->code.data = primec_utils_realloc(func->code.data, func->code.capacity * sizeof(primec_x86_64_instruction_s));
+	}
+
+	primec_x86_64_instruction_s* const instruction = &func->code.data[func->code.count++];
+	primec_utils_memset(instruction, 0, sizeof(primec_x86_64_instruction_s));
+	instruction->op = (uint8_t)op;
+	instruction->size = (uint8_t)size;
+	return instruction;
+}
+
+static void emit_binary(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const uint32_t size,
+	const primec_x86_64_operand_s destination,
+	const primec_x86_64_operand_s source)
+{
+	primec_x86_64_instruction_s* const instruction = emit(selector, op, size);
+	instruction->operands[0] = destination;
+	instruction->operands[1] = source;
+}
+
+static void emit_move(
+	selector_s* const selector,
+	const uint32_t destination,
+	const uint32_t source)
+{
+	const bool is_xmm = destination >= primec_x86_64_vregs_start
+		? primec_x86_64_class_xmm == selector->func->vregs.data[destination - primec_x86_64_vregs_start]
+		: destination >= primec_x86_64_reg_xmm0;
+
+	emit_binary(selector, is_xmm ? primec_x86_64_op_movf : primec_x86_64_op_mov, 8, reg_operand(destination), reg_operand(source));
+}
+
+static void emit_extend(
+	selector_s* const selector,
+	const uint32_t destination,
+	const uint32_t source,
+	const uint32_t from,
+	const uint32_t to,
+	const bool is_signed_source)
+{
+	// NOTE: Zero extension of 32 bit registers is done by their plain moves.
+	const bool is_plain_move = 4 == from && !is_signed_source;
+	const primec_x86_64_op_e op = is_signed_source ? primec_x86_64_op_movsx : primec_x86_64_op_movzx;
+	const uint32_t width = is_plain_move ? 4 : (to < 4 ? 4 : to);
+
+	emit_binary(selector, is_plain_move ? primec_x86_64_op_mov : op, width, reg_operand(destination), reg_operand(source));
+	selector->func->code.data[selector->func->code.count - 1].source_size = (uint8_t)from;
+}
+
+static void emit_label(
+	selector_s* const selector,
+	const uint32_t block)
+{
+	primec_x86_64_instruction_s* const label = emit(selector, primec_x86_64_op_label, 8);
+	label->operands[0] = (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_block, .value = block };
+}
+
+static void emit_jump(
+	selector_s* const selector,
+	const primec_x86_64_op_e op,
+	const primec_x86_64_condition_e cond,
+	const uint32_t block)
+{
+	primec_x86_64_instruction_s* const jump = emit(selector, op, 8);
+	jump->cond = (uint8_t)cond;
+	jump->operands[0] = (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_block, .value = block };
+}
+
+static uint32_t new_vreg(
+	selector_s* const selector,
+	const primec_x86_64_class_e class)
+{
+	primec_x86_64_func_s* const func = selector->func;
+
+	if (func->vregs.count >= func->vregs.capacity)
+	{
+		func->vregs.capacity = func->vregs.capacity > 0 ? func->vregs.capacity * 2 : 64;
+		func->vregs.data = primec_utils_realloc(func->vregs.data, func->vregs.capacity * sizeof(uint8_t));
+	}
+
+	func->vregs.data[func->vregs.count] = (uint8_t)class;
+	return primec_x86_64_vregs_start + func->vregs.count++;
+}
+
+static uint32_t new_block(
+	selector_s* const selector)
+{
+	return selector->func->blocks_count++;
+}
+
+static uint32_t get_trap(
+	selector_s* const selector)
+{
+	if (UINT32_MAX == selector->trap)
+	{
+		selector->trap = new_block(selector);
+	}
+
+	return selector->trap;
+}
+
+static primec_x86_64_operand_s get_address(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	switch ((primec_ir_op_e)instruction->op)
+	{
+		case primec_ir_op_slot:
+		{
+			return mem_operand(primec_x86_64_reg_rbp, -(int64_t)selector->slots[value]);
+		} break;
+
+		case primec_ir_op_global: { return rip_operand(primec_x86_64_symbol_global, instruction->a); } break;
+		case primec_ir_op_func: { return rip_operand(primec_x86_64_symbol_func, instruction->a); } break;
+		case primec_ir_op_string: { return rip_operand(primec_x86_64_symbol_string, instruction->a); } break;
+
+		case primec_ir_op_field:
+		{
+			const primec_type_t type = get_pointee(selector->types, get_instruction(selector, instruction->a)->type);
+			primec_x86_64_operand_s address = get_address(selector, instruction->a);
+			address.value += (int64_t)primec_layout_get_field_offset(selector->types, type, instruction->b);
+			return address;
+		} break;
+
+		case primec_ir_op_offset:
+		{
+			primec_x86_64_operand_s address = get_address(selector, instruction->a);
+			address.value += (int64_t)instruction->b;
+			return address;
+		} break;
+
+		case primec_ir_op_element:
+		{
+			if (!is_folded(selector, value)) { break; }
+			const uint64_t size = primec_layout_get(selector->types, get_pointee(selector->types, instruction->type)).size;
+			const primec_ir_instruction_s* const index = get_instruction(selector, instruction->b);
+			primec_x86_64_operand_s address = get_address(selector, instruction->a);
+
+			if (primec_ir_op_const == index->op)
+			{
+				address.value += primec_ir_get_const(index).ival * (int64_t)size;
+				return address;
+			}
+
+			address.index = get_extended(selector, instruction->b, 8);
+			address.scale = (uint8_t)size;
+			return address;
+		} break;
+
+		default:
+		{
+		} break;
+	}
+
+	return mem_operand(get_register(selector, value), 0);
+}
+
+static primec_x86_64_operand_s get_source(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size)
+{
+	int64_t immediate = 0;
+
+	if (get_immediate(selector, value, size, &immediate))
+	{
+		return imm_operand(immediate);
+	}
+
+	return reg_operand(get_register(selector, value));
+}
+
+static uint32_t get_register(
+	selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	if (selector->vregs[value] != 0)
+	{
+		return selector->vregs[value];
+	}
+
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	if (primec_ir_op_const == instruction->op)
+	{
+		const primec_const_value_s constant = primec_ir_get_const(instruction);
+
+		if (is_float(selector->types, instruction->type))
+		{
+			const uint32_t reg = new_vreg(selector, primec_x86_64_class_xmm);
+			const uint32_t size = get_size(selector->types, instruction->type);
+			const uint64_t bits = get_float_bits(selector->types, instruction->type, constant);
+
+			if (0 == bits)
+			{
+				primec_x86_64_instruction_s* const zero = emit(selector, primec_x86_64_op_zerof, size);
+				zero->operands[0] = reg_operand(reg);
+				return reg;
+			}
+
+			const uint32_t temporary = new_vreg(selector, primec_x86_64_class_gpr);
+			emit_binary(selector, primec_x86_64_op_mov, 8, reg_operand(temporary), imm_operand((int64_t)bits));
+			emit_binary(selector, primec_x86_64_op_movq, size, reg_operand(reg), reg_operand(temporary));
+			return reg;
+		}
+
+		const uint32_t reg = new_vreg(selector, primec_x86_64_class_gpr);
+		const uint32_t size = get_size(selector->types, instruction->type);
+		const int64_t bits = size < 8 ? (int64_t)(int32_t)(uint32_t)constant.uval : constant.ival;
+
+		// NOTE: Moves of the 32 bit registers clear their upper halves.
+		emit_binary(selector, primec_x86_64_op_mov, (bits >= 0 && bits <= UINT32_MAX) ? 4 : 8, reg_operand(reg), imm_operand(bits));
+		return reg;
+	}
+
+	if (is_folded(selector, value))
+	{
+		const uint32_t reg = new_vreg(selector, primec_x86_64_class_gpr);
+		emit_binary(selector, primec_x86_64_op_lea, 8, reg_operand(reg), get_address(selector, value));
+		return reg;
+	}
+
+	primec_logger_panic("internal failure -- value %u has no register.", value);
+	return 0;
+}
+
+static uint32_t get_extended(
+	selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size)
+{
+	const primec_type_t type = get_instruction(selector, value)->type;
+	const uint32_t from = get_size(selector->types, type);
+	int64_t immediate = 0;
+
+	if (from >= size || get_immediate(selector, value, 8, &immediate))
+	{
+		return get_register(selector, value);
+	}
+
+	const uint32_t reg = new_vreg(selector, primec_x86_64_class_gpr);
+	emit_extend(selector, reg, get_register(selector, value), from, size, is_signed(selector->types, type));
+	return reg;
+}
+
+static bool get_immediate(
+	const selector_s* const selector,
+	const primec_ir_value_t value,
+	const uint32_t size,
+	int64_t* const immediate)
+{
+	const primec_ir_instruction_s* const instruction = get_instruction(selector, value);
+
+	if (instruction->op != primec_ir_op_const || is_float(selector->types, instruction->type))
+	{
+		return false;
+	}
+
+	const primec_const_value_s constant = primec_ir_get_const(instruction);
+	const uint32_t type_size = get_size(selector->types, instruction->type);
+
+	// NOTE: Immediates are sign extended 32 bit values at most, the narrow
+	//       operations see only their low bits.
+	int64_t bits = constant.ival;
+
+	switch (size < type_size ? size : type_size)
+	{
+		case 1: { bits = (int8_t)(uint8_t)constant.uval; } break;
+		case 2: { bits = (int16_t)(uint16_t)constant.uval; } break;
+		case 4: { bits = (int32_t)(uint32_t)constant.uval; } break;
+		default: { } break;
+	}
+
+	// NOTE: Narrow unsigned constants are widened by their zero extension.
+	if (type_size < size && !is_signed(selector->types, instruction->type))
+	{
+		bits = (int64_t)(constant.uval & ((UINT64_C(1) << (8 * type_size)) - 1));
+	}
+
+	if (bits < INT32_MIN || bits > INT32_MAX)
+	{
+		return false;
+	}
+
+	*immediate = bits;
+	return true;
+}
+
+static const primec_ir_instruction_s* get_instruction(
+	const selector_s* const selector,
+	const primec_ir_value_t value)
+{
+	return primec_ir_func_get(selector->ir, value);
+}
+
+static primec_type_t get_scalar(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	const primec_type_s* const record = primec_type_table_get(types, type);
+	return primec_type_kind_enum == record->kind ? record->element : type;
+}
+
+static primec_type_t get_pointee(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_table_get(types, type)->element;
+}
+
+static bool is_float(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_is_float(types, get_scalar(types, type));
+}
+
+static bool is_vector(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_kind_vector == primec_type_table_get(types, type)->kind;
+}
+
+static bool is_signed(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	return primec_type_is_signed(types, get_scalar(types, type));
+}
+
+static uint32_t get_size(
+	const primec_type_table_s* const types,
+	const primec_type_t type)
+{
+	// NOTE: Aggregates are handled by their addresses, and the vectors by the
+	//       whole xmm registers.
+	if (is_vector(types, type)) { return 16; }
+	const uint64_t size = primec_layout_get(types, type).size;
+	return size > 8 ? 8 : 0 == size ? 1 : (uint32_t)size;
+}
+
+static uint64_t get_float_bits(
+	const primec_type_table_s* const types,
+	const primec_type_t type,
+	const primec_const_value_s value)
+{
+	if (4 == get_size(types, type))
+	{
+		const float narrow = (float)value.fval;
+		uint32_t bits = 0;
+		primec_utils_memcpy(&bits, &narrow, sizeof(bits));
+		return bits;
+	}
+
+	return value.uval;
+}
+
+static primec_x86_64_operand_s reg_operand(
+	const uint32_t reg)
+{
+	return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = reg };
+}
+
+static primec_x86_64_operand_s imm_operand(
+	const int64_t value)
+{
+	return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_imm, .value = value };
+}
+
+static primec_x86_64_operand_s mem_operand(
+	const uint32_t base,
+	const int64_t displacement)
+{
+	return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_mem, .reg = base, .value = displacement };
+}
+
+static primec_x86_64_operand_s rip_operand(
+	const primec_x86_64_symbol_kind_e kind,
+	const uint32_t symbol)
+{
+	return (primec_x86_64_operand_s)
+	{
+		.kind = primec_x86_64_operand_mem,
+		.symbol_kind = (uint8_t)kind,
+		.reg = primec_x86_64_reg_rip,
+		.symbol = symbol
+	};
+}
+
+static void finalize_func(
+	primec_x86_64_func_s* const func)
+{
+	// NOTE: Callee-saved registers are saved below the slots and the spills.
+	uint32_t saved_count = 0;
+	for (uint32_t reg = 0; reg < 16; ++reg) { if (func->saved & (1u << reg)) { ++saved_count; } }
+	func->saved_offset = (func->frame_size + 7) / 8 * 8;
+	func->frame_size = (func->saved_offset + 8 * saved_count + func->outgoing_size + 15) / 16 * 16;
+
+	uint32_t count = 0;
+
+	for (uint32_t index = 0; index < func->code.count; ++index)
+	{
+		primec_x86_64_instruction_s* const instruction = &func->code.data[index];
+		const primec_x86_64_instruction_s* const next = index + 1 < func->code.count ? &func->code.data[index + 1] : NULL;
+
+		// NOTE: Moves of registers to themselves are left by the allocator.
+		if ((primec_x86_64_op_mov == instruction->op || primec_x86_64_op_movf == instruction->op) && 8 == instruction->size &&
+			primec_x86_64_operand_reg == instruction->operands[0].kind && primec_x86_64_operand_reg == instruction->operands[1].kind &&
+			instruction->operands[0].reg == instruction->operands[1].reg)
+		{
+			continue;
+		}
+
+		// NOTE: Jumps to the next blocks fall through, and the conditional
+		//       jumps over the unconditional ones are inverted.
+		if (primec_x86_64_op_jmp == instruction->op && next != NULL && primec_x86_64_op_label == next->op &&
+			next->operands[0].value == instruction->operands[0].value)
+		{
+			continue;
+		}
+
+		if (primec_x86_64_op_jcc == instruction->op && next != NULL && primec_x86_64_op_jmp == next->op &&
+			index + 2 < func->code.count && primec_x86_64_op_label == func->code.data[index + 2].op &&
+			func->code.data[index + 2].operands[0].value == instruction->operands[0].value)
+		{
+			primec_x86_64_instruction_s inverted = *next;
+			inverted.op = primec_x86_64_op_jcc;
+			inverted.cond = (uint8_t)(instruction->cond ^ 1);
+			func->code.data[count++] = inverted;
+			++index;
+			continue;
+		}
+
+		func->code.data[count++] = *instruction;
+	}
+
+	func->code.count = count;
+}
+
+static void assign_names(
+	primec_x86_64_module_s* const module)
+{
+	const primec_ir_program_s* const program = module->program;
+
+	names_s names =
+	{
+		.capacity = 64,
+		.count = 0
+	};
+
+	while (names.capacity < 2 * (program->funcs.count + program->globals.count + 2))
+	{
+		names.capacity *= 2;
+	}
+
+	names.data = primec_utils_malloc(names.capacity * sizeof(const char*));
+	primec_utils_memset(names.data, 0, names.capacity * sizeof(const char*));
+
+	(void)claim_name(&names, "_start");
+	(void)claim_name(&names, "exit");
+
+	// NOTE: External functions keep their names, the other symbols are renamed
+	//       when their names are already taken.
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (!(func->flags & primec_ir_func_flag_extern)) { continue; }
+
+		module->func_names[index] = primec_utils_strdup(func->name);
+		(void)claim_name(&names, module->func_names[index]);
+	}
+
+	char buffer[512] = {0};
+
+	for (uint32_t index = 0; index < program->funcs.count; ++index)
+	{
+		const primec_ir_func_s* const func = program->funcs.data[index];
+		if (func->flags & primec_ir_func_flag_extern) { continue; }
+
+		if (claim_name(&names, func->name) != NULL)
+		{
+			module->func_names[index] = primec_utils_strdup(func->name);
+			continue;
+		}
+
+		(void)snprintf(buffer, sizeof(buffer), "%s.%u", func->name, index);
+		module->func_names[index] = primec_utils_strdup(buffer);
+		(void)claim_name(&names, module->func_names[index]);
+	}
+
+	for (uint32_t index = 0; index < program->globals.count; ++index)
+	{
+		const primec_ir_global_s* const global = &program->globals.data[index];
+
+		if (claim_name(&names, global->name) != NULL)
+		{
+			module->global_names[index] = primec_utils_strdup(global->name);
+			continue;
+		}
+
+		(void)snprintf(buffer, sizeof(buffer), "%s.g%u", global->name, index);
+		module->global_names[index] = primec_utils_strdup(buffer);
+		(void)claim_name(&names, module->global_names[index]);
+	}
+
+	primec_utils_free(names.data);
+}
+
+static const char* claim_name(
+	names_s* const names,
+	const char* const name)
+{
+	uint64_t slot = primec_utils_hash(name, strlen(name)) & (names->capacity - 1);
+
+	while (names->data[slot] != NULL)
+	{
+		if (0 == primec_utils_strcmp(names->data[slot], name)) { return NULL; }
+		slot = (slot + 1) & (names->capacity - 1);
+	}
+
+	names->data[slot] = name;
+	++names->count;
+	return name;
+}
+
+static void write_start(
+	const primec_x86_64_module_s* const module,
+	const uint32_t entry,
+	FILE* const file)
+{
+	const primec_ir_program_s* const program = module->program;
+	const primec_ir_func_s* const main_func = program->funcs.data[entry];
+	const bool returns_value = primec_type_table_get(program->types, main_func->type)->element != primec_type_void;
+
+	(void)fprintf(file, "\t.globl _start\n\t.type _start, @function\n_start:\n");
+	(void)fprintf(file, "\txor ebp, ebp\n\tcall %s\n", module->func_names[entry]);
+
+	if (program->flush != UINT32_MAX)
+	{
+		(void)fprintf(file, "\t%s\n\tcall %s\n", returns_value ? "mov ebx, eax" : "xor ebx, ebx", module->func_names[program->flush]);
+		(void)fprintf(file, "\tmov edi, ebx\n");
+	}
+	else
+	{
+		(void)fprintf(file, "\t%s\n", returns_value ? "mov edi, eax" : "xor edi, edi");
+	}
+
+	// NOTE: Only the programs calling the C library exit by it, so its streams
+	//       are flushed, the others exit by the system call.
+	if (primec_x86_64_calls_externs(module))
+	{
+		(void)fprintf(file, "\tcall exit\n\tud2\n");
+	}
+	else
+	{
+		(void)fprintf(file, "\tmov eax, 60\n\tsyscall\n\tud2\n");
+	}
+}
+
+static void write_func(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_func_s* const func,
+	FILE* const file)
+{
+	const char* const name = module->func_names[func->index];
+
+	// NOTE: Like in the objects, the functions are global symbols, except for
+	//       the lambdas.
+	if (!(module->program->funcs.data[func->index]->flags & primec_ir_func_flag_lambda))
+	{
+		(void)fprintf(file, "\t.globl %s\n", name);
+	}
+
+	(void)fprintf(file, "\t.p2align 4\n\t.type %s, @function\n%s:\n", name, name);
+
+	for (uint32_t index = 0; index < func->code.count; ++index)
+	{
+		write_instruction(module, func, &func->code.data[index], file);
+	}
+
+	(void)fprintf(file, "\t.size %s, .-%s\n", name, name);
+}
+
+static void write_instruction(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_func_s* const func,
+	const primec_x86_64_instruction_s* const instruction,
+	FILE* const file)
+{
+	const primec_x86_64_operand_s* const destination = &instruction->operands[0];
+	const primec_x86_64_operand_s* const source = &instruction->operands[1];
+	const uint32_t size = instruction->size;
+	const char* const suffix = 4 == size ? "s" : "d";
+
+	const uint32_t saved_offset = func->saved_offset;
+
+	switch ((primec_x86_64_op_e)instruction->op)
+	{
+		case primec_x86_64_op_label:
+		{
+			(void)fprintf(file, ".L%u_%" PRId64 ":\n", func->index, destination->value);
+		} break;
+
+		case primec_x86_64_op_prologue:
+		{
+			(void)fprintf(file, "\tpush rbp\n\tmov rbp, rsp\n");
+			if (func->frame_size > 0) { (void)fprintf(file, "\tsub rsp, %u\n", func->frame_size); }
+
+			for (uint32_t reg = 0, slot = 0; reg < 16; ++reg)
+			{
+				if (!(func->saved & (1u << reg))) { continue; }
+				(void)fprintf(file, "\tmov QWORD PTR [rbp-%u], %s\n", saved_offset + 8 * ++slot, g_gprs[3][reg]);
+			}
+		} break;
+
+		case primec_x86_64_op_ret:
+		case primec_x86_64_op_tail:
+		{
+			for (uint32_t reg = 0, slot = 0; reg < 16; ++reg)
+			{
+				if (!(func->saved & (1u << reg))) { continue; }
+				(void)fprintf(file, "\tmov %s, QWORD PTR [rbp-%u]\n", g_gprs[3][reg], saved_offset + 8 * ++slot);
+			}
+
+			if (primec_x86_64_op_ret == instruction->op)
+			{
+				(void)fprintf(file, "\tleave\n\tret\n");
+			}
+			else if (primec_x86_64_operand_symbol == destination->kind)
+			{
+				(void)fprintf(file, "\tleave\n\tjmp %s\n", module->func_names[destination->symbol]);
+			}
+			else
+			{
+				(void)fprintf(file, "\tleave\n\tjmp ");
+				write_operand(module, destination, 8, false, file);
+				(void)fprintf(file, "\n");
+			}
+		} break;
+
+		case primec_x86_64_op_jmp:
+		case primec_x86_64_op_jcc:
+		{
+			(void)fprintf(file, "\t%s%s .L%u_%" PRId64 "\n", g_ops[instruction->op].name,
+				primec_x86_64_op_jcc == instruction->op ? g_conds[instruction->cond] : "", func->index, destination->value);
+		} break;
+
+		case primec_x86_64_op_setcc:
+		{
+			(void)fprintf(file, "\tset%s %s\n", g_conds[instruction->cond], get_reg_name(destination->reg, 1));
+		} break;
+
+		case primec_x86_64_op_call:
+		{
+			(void)fprintf(file, "\tcall ");
+
+			if (primec_x86_64_operand_symbol == destination->kind)
+			{
+				(void)fprintf(file, "%s\n", module->func_names[destination->symbol]);
+			}
+			else
+			{
+				write_operand(module, destination, 8, false, file);
+				(void)fprintf(file, "\n");
+			}
+		} break;
+
+		case primec_x86_64_op_cqo:
+		{
+			(void)fprintf(file, "\t%s\n", 8 == size ? "cqo" : "cdq");
+		} break;
+
+		case primec_x86_64_op_ud2:
+		case primec_x86_64_op_rep_movsb:
+		case primec_x86_64_op_rep_stosb:
+		{
+			(void)fprintf(file, "\t%s\n", g_ops[instruction->op].name);
+		} break;
+
+		case primec_x86_64_op_div:
+		case primec_x86_64_op_idiv:
+		case primec_x86_64_op_neg:
+		case primec_x86_64_op_not:
+		{
+			(void)fprintf(file, "\t%s ", g_ops[instruction->op].name);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_zerof:
+		{
+			(void)fprintf(file, "\txorps %s, %s\n", get_reg_name(destination->reg, 16), get_reg_name(destination->reg, 16));
+		} break;
+
+		case primec_x86_64_op_movzx:
+		case primec_x86_64_op_movsx:
+		{
+			const bool is_dword = 4 == instruction->source_size;
+			(void)fprintf(file, "\t%s ", is_dword ? "movsxd" : g_ops[instruction->op].name);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, instruction->source_size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_movf:
+		{
+			// NOTE: Whole registers are moved, to not depend on their previous
+			//       values.
+			const bool is_registers = primec_x86_64_operand_reg == destination->kind && primec_x86_64_operand_reg == source->kind;
+			(void)fprintf(file, "\t%s ", is_registers ? "movaps" : 4 == size ? "movss" : 8 == size ? "movsd" : "movups");
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_movq:
+		{
+			(void)fprintf(file, "\t%s ", 4 == size ? "movd" : "movq");
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_addf:
+		case primec_x86_64_op_subf:
+		case primec_x86_64_op_mulf:
+		case primec_x86_64_op_divf:
+		case primec_x86_64_op_ucomif:
+		{
+			(void)fprintf(file, "\t%s%s ", g_ops[instruction->op].name, suffix);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_cvtsi2f:
+		{
+			(void)fprintf(file, "\tcvtsi2s%s ", suffix);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, instruction->source_size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_cvtf2si:
+		{
+			(void)fprintf(file, "\tcvtts%s2si ", 4 == instruction->source_size ? "s" : "d");
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, instruction->source_size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_cvtf2f:
+		{
+			(void)fprintf(file, "\tcvts%s2s%s ", 4 == instruction->source_size ? "s" : "d", suffix);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, instruction->source_size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_imul:
+		{
+			(void)fprintf(file, "\timul ");
+			write_operand(module, destination, size, true, file);
+
+			if (primec_x86_64_operand_imm == source->kind)
+			{
+				(void)fprintf(file, ", ");
+				write_operand(module, destination, size, true, file);
+			}
+
+			(void)fprintf(file, ", ");
+			write_operand(module, source, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_shl:
+		case primec_x86_64_op_shr:
+		case primec_x86_64_op_sar:
+		{
+			(void)fprintf(file, "\t%s ", g_ops[instruction->op].name);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, primec_x86_64_operand_reg == source->kind ? 1 : size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_addp:
+		case primec_x86_64_op_subp:
+		case primec_x86_64_op_mulp:
+		case primec_x86_64_op_divp:
+		case primec_x86_64_op_padd:
+		case primec_x86_64_op_psub:
+		case primec_x86_64_op_pmullw:
+		case primec_x86_64_op_pand:
+		case primec_x86_64_op_por:
+		case primec_x86_64_op_pxor:
+		case primec_x86_64_op_psrldq:
+		case primec_x86_64_op_punpcklqdq:
+		{
+			// NOTE: Packed operations read the whole registers (and memory).
+			static const char* const lanes[] = { "", "b", "w", "", "d", "", "", "", "q" };
+			const bool is_float_lanes = instruction->op >= primec_x86_64_op_addp && instruction->op <= primec_x86_64_op_divp;
+			const bool is_integer_lanes = primec_x86_64_op_padd == instruction->op || primec_x86_64_op_psub == instruction->op;
+			(void)fprintf(file, "\t%s%s ", g_ops[instruction->op].name, is_float_lanes ? suffix : is_integer_lanes ? lanes[size] : "");
+			write_operand(module, destination, 16, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, 16, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		case primec_x86_64_op_lea:
+		{
+			(void)fprintf(file, "\tlea ");
+			write_operand(module, destination, 8, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, 8, false, file);
+			(void)fprintf(file, "\n");
+		} break;
+
+		default:
+		{
+			(void)fprintf(file, "\t%s ", g_ops[instruction->op].name);
+			write_operand(module, destination, size, true, file);
+			(void)fprintf(file, ", ");
+			write_operand(module, source, size, true, file);
+			(void)fprintf(file, "\n");
+		} break;
+	}
+}
+
+static void write_operand(
+	const primec_x86_64_module_s* const module,
+	const primec_x86_64_operand_s* const operand,
+	const uint32_t size,
+	const bool has_size,
+	FILE* const file)
+{
+	switch ((primec_x86_64_operand_kind_e)operand->kind)
+	{
+		case primec_x86_64_operand_reg:
+		{
+			(void)fprintf(file, "%s", get_reg_name(operand->reg, size));
+		} break;
+
+		case primec_x86_64_operand_imm:
+		{
+			(void)fprintf(file, "%" PRId64, operand->value);
+		} break;
+
+		case primec_x86_64_operand_mem:
+		{
+			static const char* const prefixes[] = { "", "BYTE PTR ", "WORD PTR ", "", "DWORD PTR ", "", "", "", "QWORD PTR " };
+			if (has_size && size <= 8) { (void)fprintf(file, "%s", prefixes[size]); }
+			if (has_size && 16 == size) { (void)fprintf(file, "XMMWORD PTR "); }
+
+			if (primec_x86_64_reg_rip == operand->reg)
+			{
+				switch ((primec_x86_64_symbol_kind_e)operand->symbol_kind)
+				{
+					case primec_x86_64_symbol_func: { (void)fprintf(file, "[rip+%s", module->func_names[operand->symbol]); } break;
+					case primec_x86_64_symbol_global: { (void)fprintf(file, "[rip+%s", module->global_names[operand->symbol]); } break;
+					case primec_x86_64_symbol_string: { (void)fprintf(file, "[rip+.Lstr%u", operand->symbol); } break;
+				}
+			}
+			else
+			{
+				(void)fprintf(file, "[%s", g_gprs[3][operand->reg]);
+			}
+
+			if (operand->scale != 0) { (void)fprintf(file, "+%s*%u", g_gprs[3][operand->index], operand->scale); }
+			if (operand->value != 0) { (void)fprintf(file, "%+" PRId64, operand->value); }
+			(void)fprintf(file, "]");
+		} break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- invalid machine operand.");
+		} break;
+	}
+}
+
+static void write_global(
+	const primec_x86_64_module_s* const module,
+	const uint32_t index,
+	FILE* const file)
+{
+	const primec_ir_global_s* const global = &module->program->globals.data[index];
+	const primec_type_table_s* const types = module->program->types;
+	const primec_layout_s layout = primec_layout_get(types, global->type);
+	const char* const name = module->global_names[index];
+
+	(void)fprintf(file, "\t.globl %s\n", name);
+	(void)fprintf(file, "\t.p2align %u\n\t.type %s, @object\n\t.size %s, %" PRIu64 "\n%s:\n",
+		8 == layout.alignment ? 3 : 4 == layout.alignment ? 2 : 2 == layout.alignment ? 1 : 0, name, name, layout.size, name);
+
+	switch ((primec_ir_global_init_e)global->init)
+	{
+		case primec_ir_global_init_zero:
+		{
+			(void)fprintf(file, "\t.zero %" PRIu64 "\n", layout.size > 0 ? layout.size : 1);
+		} break;
+
+		case primec_ir_global_init_const:
+		{
+			static const char* const directives[] = { "", ".byte", ".short", "", ".long", "", "", "", ".quad" };
+			const uint64_t bits = is_float(types, global->type) ? get_float_bits(types, global->type, global->value) : global->value.uval;
+			const uint64_t mask = layout.size >= 8 ? UINT64_MAX : (UINT64_C(1) << (8 * layout.size)) - 1;
+			(void)fprintf(file, "\t%s %" PRIu64 "\n", directives[layout.size], bits & mask);
+		} break;
+
+		case primec_ir_global_init_string:
+		{
+			(void)fprintf(file, "\t.quad .Lstr%u\n", global->string);
+
+			if (layout.size > 8)
+			{
+				(void)fprintf(file, "\t.quad %" PRIu64 "\n", module->program->strings.data[global->string].length);
+			}
+		} break;
+	}
+}
+
+static void write_strings(
+	const primec_ir_program_s* const program,
+	FILE* const file)
+{
+	// NOTE: The pool is written as a single block, and the labels of the strings
+	//       are set to their offsets in it.
+	primec_string_pool_s pool = primec_string_pool_from_program(program);
+	(void)fprintf(file, "\t.section .rodata\n.Lstrings:\n");
+
+	for (uint64_t offset = 0; offset < pool.size; offset += 16)
+	{
+		(void)fprintf(file, "\t.byte ");
+
+		for (uint64_t byte = offset; byte < offset + 16 && byte < pool.size; ++byte)
+		{
+			(void)fprintf(file, "%s%u", byte > offset ? "," : "", (uint8_t)pool.data[byte]);
+		}
+
+		(void)fprintf(file, "\n");
+	}
+
+	for (uint32_t index = 0; index < program->strings.count; ++index)
+	{
+		(void)fprintf(file, "\t.set .Lstr%u, .Lstrings + %" PRIu64 "\n", index, pool.offsets[index]);
+	}
+
+	primec_string_pool_destroy(&pool);
+}
+
+static const char* get_reg_name(
+	const uint32_t reg,
+	const uint32_t size)
+{
+	static const char* const xmms[] =
+	{
+		"xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+		"xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15"
+	};
+
+	primec_debug_assert(reg < primec_x86_64_regs_count);
+
+	if (reg >= primec_x86_64_reg_xmm0)
+	{
+		return xmms[reg - primec_x86_64_reg_xmm0];
+	}
+
+	switch (size)
+	{
+		case 1: { return g_gprs[0][reg]; } break;
+		case 2: { return g_gprs[1][reg]; } break;
+		case 4: { return g_gprs[2][reg]; } break;
+		default: { return g_gprs[3][reg]; } break;
+	}
+}
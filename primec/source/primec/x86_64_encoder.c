@@ -0,0 +1,802 @@
+
+/**
+ * @file x86_64_encoder.c
+ * 
+ * @copyright This file is part of the "Prime" project and is distributed under
+ * "Prime GPLv1" license.
+ * 
+ * @author joba14
+ * 
+ * @date 2026-10-18
+ */
+
+#include <primec/x86_64_encoder.h>
+
+#include <primec/debug.h>
+#include <primec/logger.h>
+#include <primec/utils.h>
+
+#include <stddef.h>
+
+#define long_jump_size 5
+#define long_jcc_size 6
+#define short_jump_size 2
+
+typedef struct
+{
+	uint32_t offset;	// offset of the jump instruction
+	uint32_t block;
+	uint8_t cond;
+	bool is_conditional;
+	bool is_short;
+} jump_s;
+
+typedef struct
+{
+	primec_x86_64_func_s* func;
+	uint32_t* labels;
+
+	struct
+	{
+		jump_s* data;
+		uint32_t capacity;
+		uint32_t count;
+	} jumps;
+} encoder_s;
+
+static void encode_instruction(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction);
+
+static void encode_mov(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction);
+
+static void encode_alu(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction,
+	const uint32_t extension);
+
+static void encode_frame(
+	encoder_s* const encoder,
+	const bool is_prologue);
+
+static void encode_jump(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction);
+
+static void relax_jumps(
+	encoder_s* const encoder);
+
+static void emit_op(
+	encoder_s* const encoder,
+	const uint8_t prefix,
+	const bool is_wide,
+	const bool is_byte,
+	const uint32_t opcode,
+	const uint32_t reg,
+	const primec_x86_64_operand_s* const rm,
+	const uint32_t immediate_size);
+
+static void emit_byte(
+	encoder_s* const encoder,
+	const uint8_t byte);
+
+static void emit_immediate(
+	encoder_s* const encoder,
+	const int64_t value,
+	const uint32_t size);
+
+static void add_relocation(
+	encoder_s* const encoder,
+	const primec_x86_64_relocation_s relocation);
+
+static uint32_t get_hardware(
+	const uint32_t reg);
+
+static bool is_byte_register(
+	const uint32_t reg);
+
+static bool fits_byte(
+	const int64_t value);
+
+static primec_x86_64_operand_s make_reg(
+	const uint32_t reg);
+
+static primec_x86_64_operand_s make_frame(
+	const int64_t displacement);
+
+void primec_x86_64_encode(
+	primec_x86_64_func_s* const func)
+{
+	primec_debug_assert(func != NULL);
+
+	encoder_s encoder =
+	{
+		.func = func,
+		.labels = primec_utils_malloc((func->blocks_count > 0 ? func->blocks_count : 1) * sizeof(uint32_t))
+	};
+
+	primec_utils_memset(encoder.labels, 0, (func->blocks_count > 0 ? func->blocks_count : 1) * sizeof(uint32_t));
+
+	func->bytes.count = 0;
+	func->relocations.count = 0;
+
+	for (uint32_t index = 0; index < func->code.count; ++index)
+	{
+		encode_instruction(&encoder, &func->code.data[index]);
+	}
+
+	relax_jumps(&encoder);
+
+	primec_utils_free(encoder.labels);
+	primec_utils_free(encoder.jumps.data);
+}
+
+static void encode_instruction(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction)
+{
+	const primec_x86_64_operand_s* const destination = &instruction->operands[0];
+	const primec_x86_64_operand_s* const source = &instruction->operands[1];
+	const uint32_t size = instruction->size;
+	const bool is_wide = 8 == size;
+	const uint8_t prefix = 2 == size ? 0x66 : 0;
+	const uint8_t float_prefix = 4 == size ? 0xf3 : 0xf2;
+
+	switch ((primec_x86_64_op_e)instruction->op)
+	{
+		case primec_x86_64_op_label:
+		{
+			encoder->labels[destination->value] = encoder->func->bytes.count;
+		} break;
+
+		case primec_x86_64_op_prologue: { encode_frame(encoder, true); } break;
+		case primec_x86_64_op_ret:
+		{
+			encode_frame(encoder, false);
+			emit_byte(encoder, 0xc3);
+		} break;
+
+		case primec_x86_64_op_tail:
+		{
+			encode_frame(encoder, false);
+
+			if (primec_x86_64_operand_symbol == destination->kind)
+			{
+				emit_byte(encoder, 0xe9);
+				add_relocation(encoder, (primec_x86_64_relocation_s)
+				{
+					.offset = encoder->func->bytes.count,
+					.type = primec_x86_64_relocation_plt32,
+					.symbol_kind = destination->symbol_kind,
+					.symbol = destination->symbol,
+					.addend = -4
+				});
+				emit_immediate(encoder, 0, 4);
+				break;
+			}
+
+			emit_op(encoder, 0, false, false, 0xff, 4, destination, 0);
+		} break;
+
+		case primec_x86_64_op_mov: { encode_mov(encoder, instruction); } break;
+
+		case primec_x86_64_op_movzx:
+		case primec_x86_64_op_movsx:
+		{
+			if (4 == instruction->source_size)
+			{
+				emit_op(encoder, 0, true, false, 0x63, get_hardware(destination->reg), source, 0);
+				break;
+			}
+
+			const bool is_signed = primec_x86_64_op_movsx == instruction->op;
+			const uint32_t opcode = 1 == instruction->source_size ? (is_signed ? 0x0fbe : 0x0fb6) : (is_signed ? 0x0fbf : 0x0fb7);
+			emit_op(encoder, prefix, is_wide, 1 == instruction->source_size, opcode, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_lea:
+		{
+			emit_op(encoder, 0, true, false, 0x8d, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_add: { encode_alu(encoder, instruction, 0); } break;
+		case primec_x86_64_op_or: { encode_alu(encoder, instruction, 1); } break;
+		case primec_x86_64_op_and: { encode_alu(encoder, instruction, 4); } break;
+		case primec_x86_64_op_sub: { encode_alu(encoder, instruction, 5); } break;
+		case primec_x86_64_op_xor: { encode_alu(encoder, instruction, 6); } break;
+		case primec_x86_64_op_cmp: { encode_alu(encoder, instruction, 7); } break;
+
+		case primec_x86_64_op_test:
+		{
+			if (primec_x86_64_operand_imm == source->kind)
+			{
+				emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0xf6 : 0xf7, 0, destination, 1 == size ? 1 : 2 == size ? 2 : 4);
+				emit_immediate(encoder, source->value, 1 == size ? 1 : 2 == size ? 2 : 4);
+				break;
+			}
+
+			emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0x84 : 0x85, get_hardware(source->reg), destination, 0);
+		} break;
+
+		case primec_x86_64_op_imul:
+		{
+			if (primec_x86_64_operand_imm == source->kind)
+			{
+				const bool is_short = fits_byte(source->value);
+				const uint32_t immediate_size = is_short ? 1 : 2 == size ? 2 : 4;
+				emit_op(encoder, prefix, is_wide, false, is_short ? 0x6b : 0x69, get_hardware(destination->reg), destination, immediate_size);
+				emit_immediate(encoder, source->value, immediate_size);
+				break;
+			}
+
+			emit_op(encoder, prefix, is_wide, false, 0x0faf, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_neg:
+		case primec_x86_64_op_not:
+		case primec_x86_64_op_div:
+		case primec_x86_64_op_idiv:
+		{
+			const uint32_t extension =
+				primec_x86_64_op_neg == instruction->op ? 3 :
+				primec_x86_64_op_not == instruction->op ? 2 :
+				primec_x86_64_op_div == instruction->op ? 6 : 7;
+			emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0xf6 : 0xf7, extension, destination, 0);
+		} break;
+
+		case primec_x86_64_op_shl:
+		case primec_x86_64_op_shr:
+		case primec_x86_64_op_sar:
+		{
+			const uint32_t extension = primec_x86_64_op_shl == instruction->op ? 4 : primec_x86_64_op_shr == instruction->op ? 5 : 7;
+
+			if (primec_x86_64_operand_imm == source->kind)
+			{
+				emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0xc0 : 0xc1, extension, destination, 1);
+				emit_immediate(encoder, source->value, 1);
+				break;
+			}
+
+			primec_debug_assert(primec_x86_64_reg_rcx == source->reg);
+			emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0xd2 : 0xd3, extension, destination, 0);
+		} break;
+
+		case primec_x86_64_op_cqo:
+		{
+			if (is_wide) { emit_byte(encoder, 0x48); }
+			emit_byte(encoder, 0x99);
+		} break;
+
+		case primec_x86_64_op_setcc:
+		{
+			emit_op(encoder, 0, false, true, 0x0f90u + instruction->cond, 0, destination, 0);
+		} break;
+
+		case primec_x86_64_op_jmp:
+		case primec_x86_64_op_jcc:
+		{
+			encode_jump(encoder, instruction);
+		} break;
+
+		case primec_x86_64_op_call:
+		{
+			if (primec_x86_64_operand_symbol == destination->kind)
+			{
+				emit_byte(encoder, 0xe8);
+				add_relocation(encoder, (primec_x86_64_relocation_s)
+				{
+					.offset = encoder->func->bytes.count,
+					.type = primec_x86_64_relocation_plt32,
+					.symbol_kind = destination->symbol_kind,
+					.symbol = destination->symbol,
+					.addend = -4
+				});
+				emit_immediate(encoder, 0, 4);
+				break;
+			}
+
+			emit_op(encoder, 0, false, false, 0xff, 2, destination, 0);
+		} break;
+
+		case primec_x86_64_op_ud2:
+		{
+			emit_byte(encoder, 0x0f);
+			emit_byte(encoder, 0x0b);
+		} break;
+
+		case primec_x86_64_op_rep_movsb:
+		case primec_x86_64_op_rep_stosb:
+		{
+			emit_byte(encoder, 0xf3);
+			emit_byte(encoder, primec_x86_64_op_rep_movsb == instruction->op ? 0xa4 : 0xaa);
+		} break;
+
+		case primec_x86_64_op_movf:
+		{
+			if (primec_x86_64_operand_reg == destination->kind && primec_x86_64_operand_reg == source->kind)
+			{
+				emit_op(encoder, 0, false, false, 0x0f28, get_hardware(destination->reg), source, 0);
+			}
+			else if (primec_x86_64_operand_reg == destination->kind)
+			{
+				emit_op(encoder, 16 == size ? 0 : float_prefix, false, false, 0x0f10, get_hardware(destination->reg), source, 0);
+			}
+			else
+			{
+				emit_op(encoder, 16 == size ? 0 : float_prefix, false, false, 0x0f11, get_hardware(source->reg), destination, 0);
+			}
+		} break;
+
+		case primec_x86_64_op_movq:
+		{
+			// NOTE: The xmm register is always in the reg field.
+			if (destination->reg >= primec_x86_64_reg_xmm0)
+			{
+				emit_op(encoder, 0x66, is_wide, false, 0x0f6e, get_hardware(destination->reg), source, 0);
+			}
+			else
+			{
+				emit_op(encoder, 0x66, is_wide, false, 0x0f7e, get_hardware(source->reg), destination, 0);
+			}
+		} break;
+
+		case primec_x86_64_op_zerof:
+		{
+			emit_op(encoder, 0, false, false, 0x0f57, get_hardware(destination->reg), destination, 0);
+		} break;
+
+		case primec_x86_64_op_addf:
+		case primec_x86_64_op_subf:
+		case primec_x86_64_op_mulf:
+		case primec_x86_64_op_divf:
+		{
+			const uint32_t opcode =
+				primec_x86_64_op_addf == instruction->op ? 0x0f58 :
+				primec_x86_64_op_subf == instruction->op ? 0x0f5c :
+				primec_x86_64_op_mulf == instruction->op ? 0x0f59 : 0x0f5e;
+			emit_op(encoder, float_prefix, false, false, opcode, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_ucomif:
+		{
+			emit_op(encoder, 4 == size ? 0 : 0x66, false, false, 0x0f2e, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_cvtsi2f:
+		{
+			emit_op(encoder, float_prefix, 8 == instruction->source_size, false, 0x0f2a, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_cvtf2si:
+		{
+			emit_op(encoder, 4 == instruction->source_size ? 0xf3 : 0xf2, is_wide, false, 0x0f2c, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_cvtf2f:
+		{
+			emit_op(encoder, 4 == instruction->source_size ? 0xf3 : 0xf2, false, false, 0x0f5a, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_addp:
+		case primec_x86_64_op_subp:
+		case primec_x86_64_op_mulp:
+		case primec_x86_64_op_divp:
+		{
+			const uint32_t opcode =
+				primec_x86_64_op_addp == instruction->op ? 0x0f58 :
+				primec_x86_64_op_subp == instruction->op ? 0x0f5c :
+				primec_x86_64_op_mulp == instruction->op ? 0x0f59 : 0x0f5e;
+			emit_op(encoder, 4 == size ? 0 : 0x66, false, false, opcode, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_padd:
+		case primec_x86_64_op_psub:
+		{
+			static const uint8_t adds[] = { 0, 0xfc, 0xfd, 0, 0xfe, 0, 0, 0, 0xd4 };
+			static const uint8_t subs[] = { 0, 0xf8, 0xf9, 0, 0xfa, 0, 0, 0, 0xfb };
+			const uint8_t opcode = primec_x86_64_op_padd == instruction->op ? adds[size] : subs[size];
+			emit_op(encoder, 0x66, false, false, 0x0f00u | opcode, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_pmullw:
+		case primec_x86_64_op_pand:
+		case primec_x86_64_op_por:
+		case primec_x86_64_op_pxor:
+		case primec_x86_64_op_punpcklqdq:
+		{
+			const uint32_t opcode =
+				primec_x86_64_op_pmullw == instruction->op ? 0x0fd5 :
+				primec_x86_64_op_pand == instruction->op ? 0x0fdb :
+				primec_x86_64_op_por == instruction->op ? 0x0feb :
+				primec_x86_64_op_pxor == instruction->op ? 0x0fef : 0x0f6c;
+			emit_op(encoder, 0x66, false, false, opcode, get_hardware(destination->reg), source, 0);
+		} break;
+
+		case primec_x86_64_op_psrldq:
+		{
+			emit_op(encoder, 0x66, false, false, 0x0f73, 3, destination, 1);
+			emit_immediate(encoder, source->value, 1);
+		} break;
+
+		default:
+		{
+			primec_logger_panic("internal failure -- unknown machine op.");
+		} break;
+	}
+}
+
+static void encode_mov(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction)
+{
+	const primec_x86_64_operand_s* const destination = &instruction->operands[0];
+	const primec_x86_64_operand_s* const source = &instruction->operands[1];
+	const uint32_t size = instruction->size;
+	const bool is_wide = 8 == size;
+	const uint8_t prefix = 2 == size ? 0x66 : 0;
+
+	if (primec_x86_64_operand_imm == source->kind)
+	{
+		const int64_t value = source->value;
+
+		if (primec_x86_64_operand_reg == destination->kind && (4 == size || (is_wide && (value < INT32_MIN || value > INT32_MAX))))
+		{
+			// NOTE: The short form with the register in the opcode, which takes
+			//       all 64 bits of the immediate when needed.
+			const uint32_t reg = get_hardware(destination->reg);
+			if (is_wide || reg >= 8) { emit_byte(encoder, (uint8_t)(0x40 | (is_wide ? 0x08 : 0) | (reg >> 3))); }
+			emit_byte(encoder, (uint8_t)(0xb8 + (reg & 7)));
+			emit_immediate(encoder, value, is_wide ? 8 : 4);
+			return;
+		}
+
+		const uint32_t immediate_size = 1 == size ? 1 : 2 == size ? 2 : 4;
+		emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0xc6 : 0xc7, 0, destination, immediate_size);
+		emit_immediate(encoder, value, immediate_size);
+		return;
+	}
+
+	if (primec_x86_64_operand_reg == source->kind)
+	{
+		emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0x88 : 0x89, get_hardware(source->reg), destination, 0);
+		return;
+	}
+
+	emit_op(encoder, prefix, is_wide, 1 == size, 1 == size ? 0x8a : 0x8b, get_hardware(destination->reg), source, 0);
+}
+
+static void encode_alu(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction,
+	const uint32_t extension)
+{
+	const primec_x86_64_operand_s* const destination = &instruction->operands[0];
+	const primec_x86_64_operand_s* const source = &instruction->operands[1];
+	const uint32_t size = instruction->size;
+	const bool is_wide = 8 == size;
+	const uint8_t prefix = 2 == size ? 0x66 : 0;
+
+	if (primec_x86_64_operand_imm == source->kind)
+	{
+		if (1 == size)
+		{
+			emit_op(encoder, prefix, false, true, 0x80, extension, destination, 1);
+			emit_immediate(encoder, source->value, 1);
+		}
+		else if (fits_byte(source->value))
+		{
+			emit_op(encoder, prefix, is_wide, false, 0x83, extension, destination, 1);
+			emit_immediate(encoder, source->value, 1);
+		}
+		else
+		{
+			emit_op(encoder, prefix, is_wide, false, 0x81, extension, destination, 2 == size ? 2 : 4);
+			emit_immediate(encoder, source->value, 2 == size ? 2 : 4);
+		}
+
+		return;
+	}
+
+	const uint32_t base = extension << 3;
+
+	if (primec_x86_64_operand_reg == source->kind)
+	{
+		emit_op(encoder, prefix, is_wide, 1 == size, base | (1 == size ? 0 : 1), get_hardware(source->reg), destination, 0);
+		return;
+	}
+
+	emit_op(encoder, prefix, is_wide, 1 == size, base | (1 == size ? 2 : 3), get_hardware(destination->reg), source, 0);
+}
+
+static void encode_frame(
+	encoder_s* const encoder,
+	const bool is_prologue)
+{
+	const primec_x86_64_func_s* const func = encoder->func;
+
+	if (is_prologue)
+	{
+		static const uint8_t setup[] = { 0x55, 0x48, 0x89, 0xe5 };
+		for (uint32_t index = 0; index < sizeof(setup); ++index) { emit_byte(encoder, setup[index]); }
+
+		if (func->frame_size > 0)
+		{
+			const primec_x86_64_operand_s stack = make_reg(primec_x86_64_reg_rsp);
+			const bool is_short = fits_byte(func->frame_size);
+			emit_op(encoder, 0, true, false, is_short ? 0x83 : 0x81, 5, &stack, is_short ? 1 : 4);
+			emit_immediate(encoder, func->frame_size, is_short ? 1 : 4);
+		}
+	}
+
+	// NOTE: The callee-saved registers are stored and loaded at the same slots
+	//       as in the written assembly.
+	for (uint32_t reg = 0, slot = 0; reg < 16; ++reg)
+	{
+		if (!(func->saved & (1u << reg))) { continue; }
+		const primec_x86_64_operand_s memory = make_frame(-(int64_t)(func->saved_offset + 8 * ++slot));
+		emit_op(encoder, 0, true, false, is_prologue ? 0x89 : 0x8b, reg, &memory, 0);
+	}
+
+	if (!is_prologue) { emit_byte(encoder, 0xc9); }
+}
+
+static void encode_jump(
+	encoder_s* const encoder,
+	const primec_x86_64_instruction_s* const instruction)
+{
+	if (encoder->jumps.count >= encoder->jumps.capacity)
+	{
+		encoder->jumps.capacity = encoder->jumps.capacity > 0 ? encoder->jumps.capacity * 2 : 32;
+		encoder->jumps.data = primec_utils_realloc(encoder->jumps.data, encoder->jumps.capacity * sizeof(jump_s));
+	}
+
+	const bool is_conditional = primec_x86_64_op_jcc == instruction->op;
+
+	encoder->jumps.data[encoder->jumps.count++] = (jump_s)
+	{
+		.offset = encoder->func->bytes.count,
+		.block = (uint32_t)instruction->operands[0].value,
+		.cond = instruction->cond,
+		.is_conditional = is_conditional,
+		.is_short = false
+	};
+
+	// NOTE: The displacement is written once the labels are known.
+	const uint32_t size = is_conditional ? long_jcc_size : long_jump_size;
+	for (uint32_t index = 0; index < size; ++index) { emit_byte(encoder, 0); }
+}
+
+static void relax_jumps(
+	encoder_s* const encoder)
+{
+	primec_x86_64_func_s* const func = encoder->func;
+
+	// NOTE: Shortening of jumps only brings their targets closer, so the jumps,
+	//       that reach their targets with the long sizes, reach them shortened.
+	for (uint32_t index = 0; index < encoder->jumps.count; ++index)
+	{
+		jump_s* const jump = &encoder->jumps.data[index];
+		const int64_t distance = (int64_t)encoder->labels[jump->block] - ((int64_t)jump->offset + short_jump_size);
+		jump->is_short = fits_byte(distance);
+	}
+
+	// NOTE: The bytes are compacted in place, shifting everything after the
+	//       shortened jumps, including the labels and the relocations.
+	uint8_t* const bytes = func->bytes.data;
+	const uint32_t count = func->bytes.count;
+	uint32_t removed = 0;
+	uint32_t read = 0;
+	uint32_t write = 0;
+	uint32_t relocation = 0;
+
+	uint32_t* const shifts = primec_utils_malloc((encoder->jumps.count + 1) * sizeof(uint32_t));
+
+	for (uint32_t index = 0; index <= encoder->jumps.count; ++index)
+	{
+		const uint32_t end = index < encoder->jumps.count ? encoder->jumps.data[index].offset : count;
+
+		for (; relocation < func->relocations.count && func->relocations.data[relocation].offset < end; ++relocation)
+		{
+			func->relocations.data[relocation].offset -= removed;
+		}
+
+		while (read < end) { bytes[write++] = bytes[read++]; }
+		shifts[index] = removed;
+		if (index == encoder->jumps.count) { break; }
+
+		const jump_s* const jump = &encoder->jumps.data[index];
+		const uint32_t size = jump->is_conditional ? long_jcc_size : long_jump_size;
+		read += size;
+		write += jump->is_short ? short_jump_size : size;
+		removed += jump->is_short ? size - short_jump_size : 0;
+	}
+
+	func->bytes.count = write;
+
+	// NOTE: The labels are shifted by the jumps before them, found by the
+	//       binary search over the original offsets of the jumps.
+	for (uint32_t block = 0; block < func->blocks_count; ++block)
+	{
+		uint32_t low = 0;
+		uint32_t high = encoder->jumps.count;
+
+		while (low < high)
+		{
+			const uint32_t middle = low + (high - low) / 2;
+			if (encoder->jumps.data[middle].offset < encoder->labels[block]) { low = middle + 1; }
+			else { high = middle; }
+		}
+
+		encoder->labels[block] -= shifts[low];
+	}
+
+	for (uint32_t index = 0; index < encoder->jumps.count; ++index)
+	{
+		const jump_s* const jump = &encoder->jumps.data[index];
+		const uint32_t offset = jump->offset - shifts[index];
+		const uint32_t size = jump->is_short ? short_jump_size : jump->is_conditional ? long_jcc_size : long_jump_size;
+		const int64_t displacement = (int64_t)encoder->labels[jump->block] - (int64_t)(offset + size);
+		uint8_t* const target = &bytes[offset];
+
+		if (jump->is_short)
+		{
+			primec_debug_assert(fits_byte(displacement));
+			target[0] = jump->is_conditional ? (uint8_t)(0x70 + jump->cond) : 0xeb;
+			target[1] = (uint8_t)(int8_t)displacement;
+			continue;
+		}
+
+		uint32_t position = 0;
+		if (jump->is_conditional) { target[position++] = 0x0f; target[position++] = (uint8_t)(0x80 + jump->cond); }
+		else { target[position++] = 0xe9; }
+
+		const uint32_t value = (uint32_t)(int32_t)displacement;
+		for (uint32_t byte = 0; byte < 4; ++byte) { target[position++] = (uint8_t)(value >> (8 * byte)); }
+	}
+
+	primec_utils_free(shifts);
+}
+
+static void emit_op(
+	encoder_s* const encoder,
+	const uint8_t prefix,
+	const bool is_wide,
+	const bool is_byte,
+	const uint32_t opcode,
+	const uint32_t reg,
+	const primec_x86_64_operand_s* const rm,
+	const uint32_t immediate_size)
+{
+	const bool is_register = primec_x86_64_operand_reg == rm->kind;
+	const bool is_rip = !is_register && primec_x86_64_reg_rip == rm->reg;
+	const bool has_index = !is_register && rm->scale != 0;
+	const uint32_t base = is_register || !is_rip ? get_hardware(rm->reg) : 0;
+	const uint32_t index = has_index ? get_hardware(rm->index) : 0;
+
+	// NOTE: The byte registers spl, bpl, sil and dil need the rex prefix, in
+	//       place of the high byte registers.
+	const uint8_t rex = (uint8_t)(0x40 | (is_wide ? 0x08 : 0) | ((reg >> 3) << 2) | ((index >> 3) << 1) | (base >> 3));
+	const bool needs_rex = rex != 0x40 || (is_byte && (is_byte_register(reg) || (is_register && is_byte_register(base))));
+
+	if (prefix != 0) { emit_byte(encoder, prefix); }
+	if (needs_rex) { emit_byte(encoder, rex); }
+	if (opcode > 0xffff) { emit_byte(encoder, (uint8_t)(opcode >> 16)); }
+	if (opcode > 0xff) { emit_byte(encoder, (uint8_t)(opcode >> 8)); }
+	emit_byte(encoder, (uint8_t)opcode);
+
+	const uint8_t field = (uint8_t)((reg & 7) << 3);
+
+	if (is_register)
+	{
+		emit_byte(encoder, (uint8_t)(0xc0 | field | (base & 7)));
+		return;
+	}
+
+	if (is_rip)
+	{
+		emit_byte(encoder, (uint8_t)(0x05 | field));
+		add_relocation(encoder, (primec_x86_64_relocation_s)
+		{
+			.offset = encoder->func->bytes.count,
+			.type = primec_x86_64_relocation_pc32,
+			.symbol_kind = rm->symbol_kind,
+			.symbol = rm->symbol,
+			.addend = rm->value - 4 - (int64_t)immediate_size
+		});
+		emit_immediate(encoder, 0, 4);
+		return;
+	}
+
+	// NOTE: Bases rbp and r13 always take a displacement, and the bases rsp and
+	//       r12 always take the sib byte.
+	const int64_t displacement = rm->value;
+	const uint8_t mode = (0 == displacement && (base & 7) != 5) ? 0x00 : fits_byte(displacement) ? 0x40 : 0x80;
+
+	if (has_index || 4 == (base & 7))
+	{
+		const uint8_t scale = 8 == rm->scale ? 3 : 4 == rm->scale ? 2 : 2 == rm->scale ? 1 : 0;
+		emit_byte(encoder, (uint8_t)(mode | field | 4));
+		emit_byte(encoder, (uint8_t)((scale << 6) | ((has_index ? index & 7 : 4) << 3) | (base & 7)));
+	}
+	else
+	{
+		emit_byte(encoder, (uint8_t)(mode | field | (base & 7)));
+	}
+
+	if (0x40 == mode) { emit_immediate(encoder, displacement, 1); }
+	else if (0x80 == mode) { emit_immediate(encoder, displacement, 4); }
+}
+
+static void emit_byte(
+	encoder_s* const encoder,
+	const uint8_t byte)
+{
+	primec_x86_64_func_s* const func = encoder->func;
+
+	if (func->bytes.count >= func->bytes.capacity)
+	{
+		func->bytes.capacity = func->bytes.capacity > 0 ? func->bytes.capacity * 2 : 256;
+		func->bytes.data = primec_utils_realloc(func->bytes.data, func->bytes.capacity);
+	}
+
+	func->bytes.data[func->bytes.count++] = byte;
+}
+
+static void emit_immediate(
+	encoder_s* const encoder,
+	const int64_t value,
+	const uint32_t size)
+{
+	for (uint32_t byte = 0; byte < size; ++byte)
+	{
+		emit_byte(encoder, (uint8_t)((uint64_t)value >> (8 * byte)));
+	}
+}
+
+static void add_relocation(
+	encoder_s* const encoder,
+	const primec_x86_64_relocation_s relocation)
+{
+	primec_x86_64_func_s* const func = encoder->func;
+
+	if (func->relocations.count >= func->relocations.capacity)
+	{
+		func->relocations.capacity = func->relocations.capacity > 0 ? func->relocations.capacity * 2 : 16;
+		func->relocations.data = primec_utils_realloc(func->relocations.data, func->relocations.capacity * sizeof(primec_x86_64_relocation_s));
+	}
+
+	func->relocations.data[func->relocations.count++] = relocation;
+}
+
+static uint32_t get_hardware(
+	const uint32_t reg)
+{
+	primec_debug_assert(reg < primec_x86_64_regs_count);
+	return reg >= primec_x86_64_reg_xmm0 ? reg - primec_x86_64_reg_xmm0 : reg;
+}
+
+static bool is_byte_register(
+	const uint32_t reg)
+{
+	return reg >= primec_x86_64_reg_rsp && reg <= primec_x86_64_reg_rdi;
+}
+
+static bool fits_byte(
+	const int64_t value)
+{
+	return value >= INT8_MIN && value <= INT8_MAX;
+}
+
+static primec_x86_64_operand_s make_reg(
+	const uint32_t reg)
+{
+	return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_reg, .reg = reg };
+}
+
+static primec_x86_64_operand_s make_frame(
+	const int64_t displacement)
+{
+	return (primec_x86_64_operand_s) { .kind = primec_x86_64_operand_mem, .reg = primec_x86_64_reg_rbp, .value = displacement };
+}